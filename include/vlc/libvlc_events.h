@@ -143,6 +143,20 @@ enum libvlc_event_e {
      * case of a \ref libvlc_media_discoverer_t) or parsed (preparser).
      */
     libvlc_MediaListEndReached,
+    /**
+     * A contiguous range of \link #libvlc_media_t media items\endlink was
+     * added to a \link #libvlc_media_list_t media list\endlink by a bulk
+     * operation, which sends this single event instead of per-item ones.
+     * \version LibVLC 4.0.0 or later
+     */
+    libvlc_MediaListItemsAdded,
+    /**
+     * A contiguous range of \link #libvlc_media_t media items\endlink was
+     * deleted from a \link #libvlc_media_list_t media list\endlink by a bulk
+     * operation, which sends this single event instead of per-item ones.
+     * \version LibVLC 4.0.0 or later
+     */
+    libvlc_MediaListItemsDeleted,
 
     /**
      * \deprecated No longer used.
@@ -297,6 +311,16 @@ typedef struct libvlc_event_t
             libvlc_media_t * item;
             int index;
         } media_list_will_delete_item;
+        struct
+        {
+            int index;
+            int count;
+        } media_list_items_added;
+        struct
+        {
+            int index;
+            int count;
+        } media_list_items_deleted;
 
         /* media list player */
         struct
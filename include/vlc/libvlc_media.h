@@ -705,6 +705,61 @@ libvlc_media_parse_with_options( libvlc_media_t *p_md,
 LIBVLC_API void
 libvlc_media_parse_stop( libvlc_media_t *p_md );
 
+/**
+ * Callback prototype invoked once every media of a batch submitted with
+ * libvlc_media_parse_batch() has reached a final parsed status.
+ *
+ * \param opaque private pointer passed to libvlc_media_parse_batch() [IN]
+ * \param medias array of the batched media descriptor objects [IN]
+ * \param statuses final parsed status of each media, same indexing as \p
+ * medias [IN]
+ * \param count number of medias in the batch [IN]
+ * \version LibVLC 4.0.0 or later
+ */
+typedef void (*libvlc_media_parse_batch_cb)( void *opaque,
+                                libvlc_media_t *const *medias,
+                                const libvlc_media_parsed_status_t *statuses,
+                                size_t count );
+
+/**
+ * Parse a batch of medias asynchronously with options.
+ *
+ * The whole batch is queued at once on the preparser thread pool and a single
+ * callback reports the final status of every media, which is much cheaper
+ * than submitting thousands of medias individually with
+ * libvlc_media_parse_with_options() and collecting one
+ * libvlc_MediaParsedChanged event each.
+ *
+ * Medias pointing to the same MRL are parsed only once: the duplicates are
+ * reported with the status of the parse they were folded into, without
+ * updating their own meta data. A media whose parsing was already requested
+ * is not requested again and is reported with its parsed status at
+ * submission time. Per-media libvlc_MediaParsedChanged events are still sent
+ * for the medias actually parsed by the batch.
+ *
+ * The callback is invoked from a parsing thread, or from the calling thread
+ * if no media needed parsing. The medias are retained for the duration of
+ * the batch. A batch cannot be cancelled as a whole, but
+ * libvlc_media_parse_stop() still applies to its individual medias.
+ *
+ * \see libvlc_media_parse_with_options
+ *
+ * \param medias array of media descriptor objects to parse
+ * \param count number of medias in the array
+ * \param parse_flag parse options, applied to the whole batch
+ * \param timeout per-media parse timeout, see
+ * libvlc_media_parse_with_options()
+ * \param parsed_cb callback invoked once the whole batch is done
+ * \param opaque private pointer for the callback
+ * \return -1 in case of error (the callback will not be invoked), 0 otherwise
+ * \version LibVLC 4.0.0 or later
+ */
+LIBVLC_API int
+libvlc_media_parse_batch( libvlc_media_t *const *medias, size_t count,
+                          libvlc_media_parse_flag_t parse_flag, int timeout,
+                          libvlc_media_parse_batch_cb parsed_cb,
+                          void *opaque );
+
 /**
  * Get Parsed status for media descriptor object.
  *
@@ -120,6 +120,46 @@ libvlc_media_list_insert_media( libvlc_media_list_t *p_ml,
 LIBVLC_API int
 libvlc_media_list_remove_index( libvlc_media_list_t *p_ml, int i_pos );
 
+/**
+ * Insert an array of media instances in media list on a position
+ * The libvlc_media_list_lock should be held upon entering this function.
+ *
+ * Unlike repeated libvlc_media_list_insert_media() calls, a single
+ * libvlc_MediaListItemsAdded event covering the whole range is sent instead
+ * of one pair of per-item events per media.
+ *
+ * \param p_ml a media list instance
+ * \param pp_md array of media instances
+ * \param i_count number of media instances in the array
+ * \param i_pos position in array where to insert, or -1 to append
+ * \return 0 on success, -1 if the media list is read-only or the position is
+ * out of bounds
+ * \version LibVLC 4.0.0 or later
+ */
+LIBVLC_API int
+libvlc_media_list_insert_media_array( libvlc_media_list_t *p_ml,
+                                      libvlc_media_t *const *pp_md,
+                                      size_t i_count, int i_pos );
+
+/**
+ * Remove a range of media instances from media list
+ * The libvlc_media_list_lock should be held upon entering this function.
+ *
+ * Unlike repeated libvlc_media_list_remove_index() calls, a single
+ * libvlc_MediaListItemsDeleted event covering the whole range is sent
+ * instead of one pair of per-item events per media.
+ *
+ * \param p_ml a media list instance
+ * \param i_pos position in array of the first item to remove
+ * \param i_count number of items to remove
+ * \return 0 on success, -1 if the list is read-only or the range is out of
+ * bounds
+ * \version LibVLC 4.0.0 or later
+ */
+LIBVLC_API int
+libvlc_media_list_remove_index_range( libvlc_media_list_t *p_ml, int i_pos,
+                                      size_t i_count );
+
 /**
  * Get count on media list items
  * The libvlc_media_list_lock should be held upon entering this function.
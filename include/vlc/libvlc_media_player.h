@@ -897,6 +897,43 @@ LIBVLC_API int libvlc_media_player_set_time( libvlc_media_player_t *p_mi,
  */
 LIBVLC_API float libvlc_media_player_get_position( libvlc_media_player_t *p_mi );
 
+/**
+ * Consistent snapshot of playback progress and input statistics.
+ *
+ * \version LibVLC 4.0.0 or later
+ */
+typedef struct libvlc_media_player_stats_snapshot_t
+{
+    libvlc_time_t i_time;       /**< movie time (in ms), or -1 */
+    libvlc_time_t i_length;     /**< movie length (in ms), or -1 */
+    float f_position;           /**< movie position between 0.0 and 1.0 */
+    float f_cache;              /**< buffering fill between 0.0 and 1.0 */
+    libvlc_media_stats_t stats; /**< input statistics, see libvlc_media_get_stats() */
+} libvlc_media_player_stats_snapshot_t;
+
+/**
+ * Get a consistent snapshot of playback progress and input statistics.
+ *
+ * Unlike libvlc_media_player_get_time(), libvlc_media_player_get_position()
+ * and libvlc_media_get_stats(), this never takes any lock and never blocks on
+ * input state transitions: the player publishes the snapshot from its event
+ * thread and this call merely copies the last published version. It is safe
+ * and cheap to poll from timing-sensitive threads, or across a large number
+ * of players.
+ *
+ * The snapshot is refreshed at the input statistics rate (about once per
+ * second) and on position, length and buffering events; for finer-grained
+ * change notification, use the libvlc_MediaPlayer*Changed events instead.
+ *
+ * \param p_mi the Media Player
+ * \param p_snapshot structure filled with the last published snapshot [OUT]
+ * \retval true snapshot available
+ * \retval false nothing published yet (no media has been played)
+ * \version LibVLC 4.0.0 or later
+ */
+LIBVLC_API int libvlc_media_player_get_stats_snapshot( libvlc_media_player_t *p_mi,
+                                                       libvlc_media_player_stats_snapshot_t *p_snapshot );
+
 /**
  * Set movie position as percentage between 0.0 and 1.0.
  * This has no effect if playback is not enabled.
@@ -1505,6 +1542,26 @@ int libvlc_video_take_snapshot( libvlc_media_player_t *p_mi, unsigned num,
                                 const char *psz_filepath, unsigned int i_width,
                                 unsigned int i_height );
 
+/**
+ * Save the recent per-frame timing records of a video output to a file.
+ *
+ * The video output keeps a ring of timing records for the last few hundred
+ * frames (decode completion, render, display time and deadline delta,
+ * including dropped frames). This function writes them in the Chrome
+ * trace-event JSON format, which chrome://tracing and compatible viewers
+ * can display, and may be called at any time without disturbing playback.
+ *
+ * \param p_mi media player instance
+ * \param num number of video output (typically 0 for the first/only one)
+ * \param psz_filepath the path of the file to save the trace into
+ * \return 0 on success, -1 if the video was not found or the file could
+ * not be written
+ * \version LibVLC 4.0.0 and later
+ */
+LIBVLC_API
+int libvlc_video_save_frame_trace( libvlc_media_player_t *p_mi, unsigned num,
+                                   const char *psz_filepath );
+
 /**
  * Enable or disable deinterlace filter
  *
@@ -2173,6 +2230,38 @@ LIBVLC_API int libvlc_media_player_get_role(libvlc_media_player_t *p_mi);
 LIBVLC_API int libvlc_media_player_set_role(libvlc_media_player_t *p_mi,
                                             unsigned role);
 
+/**
+ * Per-elementary-stream statistics snapshot.
+ *
+ * \see libvlc_media_player_get_es_stats
+ * \version LibVLC 4.0.0 and later.
+ */
+typedef struct libvlc_es_stats_t
+{
+    int i_id;                   /**< elementary stream identifier */
+    libvlc_track_type_t i_type; /**< track type */
+    uint64_t i_demux_bytes;     /**< bytes sent by the demuxer */
+    float f_demux_bitrate;      /**< demux rate, in bytes per microsecond */
+    uint64_t i_discontinuities; /**< discontinuities seen on the track */
+    size_t i_fifo_bytes;        /**< current decoder fifo depth in bytes */
+} libvlc_es_stats_t;
+
+/**
+ * Gets a statistics snapshot for every elementary stream of the current
+ * input: per-track demux byte count and bitrate, discontinuity count and
+ * decoder fifo depth. Rates are computed when this function is called.
+ *
+ * \version LibVLC 4.0.0 and later.
+ *
+ * \param p_mi media player
+ * \param pp_stats snapshot array, to be freed with libvlc_free() [OUT]
+ * \return the number of elementary streams in the snapshot, 0 if there is
+ *         no input or on error
+ */
+LIBVLC_API size_t
+libvlc_media_player_get_es_stats(libvlc_media_player_t *p_mi,
+                                 libvlc_es_stats_t **pp_stats);
+
 /** @} audio */
 
 /** @} media_player */
@@ -254,6 +254,16 @@ typedef enum vlc_action_id {
 VLC_API vlc_action_id_t
 vlc_actions_get_id(const char *psz_key_name);
 
+/**
+ * Triggers an action directly from its (preresolved) identifier,
+ * bypassing any key press or action name lookup.
+ * ACTIONID_NONE is ignored, so the result of vlc_actions_get_id() can
+ * be passed straight through.
+ */
+VLC_API void
+vlc_actions_do(vlc_object_t *p_obj, vlc_action_id_t id);
+#define vlc_actions_do(a, b) vlc_actions_do(VLC_OBJECT(a), b)
+
 /**
  * Get keycodes from a action key name and vlc configuration
  * \return The number of keycodes for this action, or 0 in case of an error.
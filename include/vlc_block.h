@@ -162,6 +162,17 @@ VLC_API block_t *block_Init(block_t *block,
  */
 VLC_API block_t *block_Alloc(size_t size) VLC_USED VLC_MALLOC;
 
+/**
+ * Returns a snapshot of the process-wide block accounting.
+ *
+ * @param count number of live blocks [OUT]
+ * @param bytes total buffer bytes held by live blocks [OUT]
+ * @param peak_bytes highest byte count observed so far [OUT]
+ */
+VLC_API void block_AllocationStats(size_t *restrict count,
+                                   size_t *restrict bytes,
+                                   size_t *restrict peak_bytes);
+
 VLC_API block_t *block_TryRealloc(block_t *, ssize_t pre, size_t body) VLC_USED;
 
 /**
@@ -447,6 +458,22 @@ static inline block_t *block_ChainGather( block_t *p_list )
  */
 VLC_API block_fifo_t *block_FifoNew(void) VLC_USED VLC_MALLOC;
 
+/**
+ * Creates a FIFO queue of blocks optimized for a single producer thread and
+ * a single consumer thread.
+ *
+ * block_FifoPut() and block_FifoGet() then use a lock-free ring buffer and
+ * only take the FIFO lock to put the consumer to sleep or wake it up, falling
+ * back to the locked queue when the ring overflows.
+ *
+ * @warning At most one thread may queue blocks and at most one (other) thread
+ * may dequeue blocks. The low-level locked FIFO functions (vlc_fifo_Lock()
+ * and associates) must not be used on such a FIFO.
+ *
+ * @return the FIFO or NULL on memory error
+ */
+VLC_API block_fifo_t *block_FifoNewSPSC(void) VLC_USED VLC_MALLOC;
+
 /**
  * Destroys a FIFO created by block_FifoNew().
  *
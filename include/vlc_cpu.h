@@ -189,4 +189,44 @@ VLC_API unsigned vlc_CPU(void);
 
 # endif
 
+/**
+ * CPU-optimized kernel variant.
+ *
+ * Entry of a dispatch table for a function with CPU-specific optimized
+ * implementations. See vlc_CPU_kernel().
+ */
+struct vlc_cpu_kernel
+{
+    const char *name; /**< Variant name, e.g. "sse2" ("c" for plain C) */
+    unsigned cpu; /**< Required CPU capabilities (VLC_CPU_* flags) */
+    void (*func)(void); /**< Kernel entry point */
+};
+
+/**
+ * Defines one entry of a vlc_cpu_kernel dispatch table.
+ */
+# define VLC_CPU_KERNEL(name, cpu, func) \
+    { (name), (cpu), (void (*)(void))(func) }
+
+/**
+ * Resolves a CPU-optimized kernel.
+ *
+ * Selects the most specific usable variant from a dispatch table. The table
+ * must be ordered from the plain C fallback (first entry, no capability
+ * requirements) up to the most CPU-specific implementation; the last entry
+ * whose capability requirements are all met wins. Resolution is meant to
+ * happen once, when the calling component initializes, not in a per-sample
+ * or per-pixel loop.
+ *
+ * The VLC_KERNEL environment variable can name a variant to force instead,
+ * e.g. to benchmark one variant against another.
+ *
+ * \param tab table of kernel variants, by increasing specificity
+ * \param count number of table entries
+ * \return the entry point of the selected variant, to be cast back to the
+ * actual kernel prototype
+ */
+VLC_API void (*vlc_CPU_kernel(const struct vlc_cpu_kernel *tab,
+                              size_t count))(void) VLC_USED;
+
 #endif /* !VLC_CPU_H */
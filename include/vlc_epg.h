@@ -116,5 +116,11 @@ VLC_API void vlc_epg_SetCurrent(vlc_epg_t *p_epg, int64_t i_start);
  */
 VLC_API vlc_epg_t * vlc_epg_Duplicate(const vlc_epg_t *p_src);
 
+/**
+ * Replaces the content of \p p_dst with the one of \p p_src,
+ * duplicating only the events which actually changed.
+ */
+VLC_API void vlc_epg_Update(vlc_epg_t *p_dst, const vlc_epg_t *p_src);
+
 #endif
 
@@ -24,6 +24,8 @@
 #ifndef VLC_ES_OUT_H
 #define VLC_ES_OUT_H 1
 
+#include <vlc_block.h>
+
 /**
  * \defgroup es_out ES output
  * \ingroup input
@@ -90,6 +92,9 @@ enum es_out_query_e
      * XXX You SHALL call ES_OUT_RESET_PCR before any other es_out_Control/Send calls. */
     ES_OUT_GET_EMPTY,       /* arg1=bool*   res=cannot fail */
 
+    /* Per-ES demux statistics snapshot, rates computed at read time */
+    ES_OUT_GET_ES_STATS, /* arg1=input_es_stats_t ** (free by caller), arg2=size_t * res=can fail */
+
     /* Set global meta data (The vlc_meta_t is not modified nor released) */
     ES_OUT_SET_META, /* arg1=const vlc_meta_t * */
 
@@ -130,6 +135,10 @@ struct es_out_callbacks
     void         (*del)(es_out_t *, es_out_id_t *);
     int          (*control)(es_out_t *, int query, va_list);
     void         (*destroy)(es_out_t *);
+    /** Optional: sends a whole block chain to one ES in a single call,
+     * amortizing locking and clock checks. May be NULL, in which case
+     * es_out_SendBatch() falls back to one send() call per block. */
+    int          (*send_batch)(es_out_t *, es_out_id_t *, block_t *);
 };
 
 struct es_out_t
@@ -154,6 +163,36 @@ static inline int es_out_Send( es_out_t *out, es_out_id_t *id,
     return out->cbs->send( out, id, p_block );
 }
 
+/**
+ * Sends a chain of blocks to a single elementary stream.
+ *
+ * Unlike repeated es_out_Send() calls, the whole chain is handed over at
+ * once, so that the ES output can amortize its internal locking and clock
+ * bookkeeping over the batch. On error, any blocks not yet consumed are
+ * released.
+ */
+static inline int es_out_SendBatch( es_out_t *out, es_out_id_t *id,
+                                    block_t *p_chain )
+{
+    if( out->cbs->send_batch != NULL )
+        return out->cbs->send_batch( out, id, p_chain );
+
+    while( p_chain != NULL )
+    {
+        block_t *p_next = p_chain->p_next;
+        p_chain->p_next = NULL;
+
+        int ret = out->cbs->send( out, id, p_chain );
+        if( ret != VLC_SUCCESS )
+        {
+            block_ChainRelease( p_next );
+            return ret;
+        }
+        p_chain = p_next;
+    }
+    return VLC_SUCCESS;
+}
+
 static inline int es_out_vaControl( es_out_t *out, int i_query, va_list args )
 {
     return out->cbs->control( out, i_query, args );
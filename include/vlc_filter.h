@@ -80,6 +80,15 @@ struct filter_t
     es_format_t         fmt_out;
     bool                b_allow_fmt_out_change;
 
+    /**
+     * The filter module can process a picture fully in place: every output
+     * pixel only depends on input pixels it has not overwritten yet. When
+     * set and the input and output video formats are identical,
+     * filter_NewPicture() may return the input picture itself instead of a
+     * new buffer, provided the input is not referenced anywhere else.
+     */
+    bool                b_allow_in_place;
+
     /* Name of the "video filter" shortcut that is requested, can be NULL */
     const char *        psz_name;
     /* Filter configuration */
@@ -427,6 +436,32 @@ VLC_API picture_t *filter_chain_VideoFilter(filter_chain_t *chain,
  */
 VLC_API void filter_chain_VideoFlush( filter_chain_t * );
 
+/**
+ * Starts pipelined execution of a video filter chain.
+ *
+ * Each filter of the chain gets its own worker thread, connected to the next
+ * stage by a one-picture queue, so that the chain throughput approaches the
+ * speed of its slowest filter instead of the sum of all of them.
+ *
+ * In this mode filter_chain_VideoFilter() queues the input picture and
+ * returns an earlier completed picture (or NULL while the pipeline fills up),
+ * so pictures come out a few calls later than they went in. The chain must
+ * not be modified, and filter_chain_MouseFilter() must not be used, until
+ * filter_chain_PipelineStop() is called.
+ *
+ * \param chain a non-empty video filter chain
+ * \return VLC_SUCCESS or an error code (the chain then runs sequentially)
+ */
+VLC_API int filter_chain_PipelineStart( filter_chain_t *chain );
+
+/**
+ * Stops pipelined execution of a video filter chain.
+ *
+ * Joins the worker threads and discards in-flight pictures. The chain then
+ * runs sequentially again. No-op if pipelined execution is not enabled.
+ */
+VLC_API void filter_chain_PipelineStop( filter_chain_t *chain );
+
 /**
  * Generate subpictures from a chain of subpicture source "filters".
  *
@@ -482,6 +482,19 @@ typedef void (*input_thread_events_cb)( input_thread_t *input,
                                         const struct vlc_input_event *event,
                                         void *userdata);
 
+/**
+ * Per-ES demux statistics snapshot (\see INPUT_GET_ES_STATS)
+ */
+typedef struct input_es_stats_t
+{
+    int i_id;                        /**< ES identifier */
+    enum es_format_category_e i_cat; /**< ES category */
+    uint64_t i_demux_bytes;          /**< bytes sent by the demuxer */
+    float f_demux_bitrate;           /**< demux byte rate, computed at read */
+    uint64_t i_discontinuities;      /**< discontinuity blocks seen */
+    size_t i_fifo_bytes;             /**< current decoder fifo depth */
+} input_es_stats_t;
+
 /**
  * Input queries
  */
@@ -542,6 +555,7 @@ enum input_query_e
     INPUT_GET_AOUT,         /* arg1=audio_output_t **              res=can fail */
     INPUT_GET_VOUTS,        /* arg1=vout_thread_t ***, size_t *        res=can fail */
     INPUT_GET_ES_OBJECTS,   /* arg1=int id, vlc_object_t **dec, vout_thread_t **, audio_output_t ** */
+    INPUT_GET_ES_STATS,     /* arg1=input_es_stats_t ** (free by caller), arg2=size_t *  res=can fail */
 
     /* Renderers */
     INPUT_SET_RENDERER,     /* arg1=vlc_renderer_item_t* */
@@ -377,7 +377,10 @@ typedef enum input_item_meta_request_option_t
     META_REQUEST_OPTION_SCOPE_LOCAL   = 0x01,
     META_REQUEST_OPTION_SCOPE_NETWORK = 0x02,
     META_REQUEST_OPTION_SCOPE_ANY     = 0x03,
-    META_REQUEST_OPTION_DO_INTERACT   = 0x04
+    META_REQUEST_OPTION_DO_INTERACT   = 0x04,
+    /** Process the request before already queued ones, e.g. for items the
+     * user is currently looking at */
+    META_REQUEST_OPTION_PRIORITY      = 0x08
 } input_item_meta_request_option_t;
 
 /* status of the on_preparse_ended() callback */
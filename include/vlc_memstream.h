@@ -33,6 +33,7 @@ struct vlc_memstream
     };
     char *ptr;
     size_t length;
+    size_t capacity; /* Internal to the heap-based implementation */
 };
 
 VLC_API
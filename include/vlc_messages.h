@@ -84,8 +84,15 @@ VLC_API void vlc_vaLog(vlc_object_t *obj, int prio, const char *module,
     msg_Generic(p_this, VLC_MSG_ERR, __VA_ARGS__)
 #define msg_Warn(p_this, ...) \
     msg_Generic(p_this, VLC_MSG_WARN, __VA_ARGS__)
-#define msg_Dbg(p_this, ...) \
+/* Debug messages can be compiled out altogether (define VLC_NO_MSG_DBG),
+ * e.g. for very constrained targets where even the runtime verbosity
+ * check is too much. */
+#ifdef VLC_NO_MSG_DBG
+# define msg_Dbg(p_this, ...) ((void)(p_this))
+#else
+# define msg_Dbg(p_this, ...) \
     msg_Generic(p_this, VLC_MSG_DBG, __VA_ARGS__)
+#endif
 
 extern const char vlc_module_name[];
 
@@ -170,6 +170,11 @@ VLC_API ssize_t net_Read( vlc_object_t *p_this, int fd, void *p_data, size_t i_d
 #define net_Read(a,b,c,d) net_Read(VLC_OBJECT(a),b,c,d)
 VLC_API ssize_t net_Write( vlc_object_t *p_this, int fd, const void *p_data, size_t i_data );
 #define net_Write(a,b,c,d) net_Write(VLC_OBJECT(a),b,c,d)
+
+struct iovec;
+VLC_API ssize_t net_Writev( vlc_object_t *p_this, int fd,
+                            const struct iovec *iov, unsigned count );
+#define net_Writev(a,b,c,d) net_Writev(VLC_OBJECT(a),b,c,d)
 VLC_API char * net_Gets( vlc_object_t *p_this, int fd );
 #define net_Gets(a,b) net_Gets(VLC_OBJECT(a),b)
 
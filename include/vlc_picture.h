@@ -160,6 +160,20 @@ VLC_API picture_t *picture_Hold( picture_t *p_picture );
  */
 VLC_API void picture_Release( picture_t *p_picture );
 
+/**
+ * Returns a snapshot of the process-wide picture accounting.
+ *
+ * Only pictures owning their plane buffers (picture_NewFromFormat())
+ * contribute to the byte counters.
+ *
+ * @param count number of live pictures [OUT]
+ * @param bytes total plane buffer bytes held by live pictures [OUT]
+ * @param peak_bytes highest byte count observed so far [OUT]
+ */
+VLC_API void picture_AllocationStats( size_t *restrict count,
+                                      size_t *restrict bytes,
+                                      size_t *restrict peak_bytes );
+
 /**
  * This function will copy all picture dynamic properties.
  */
@@ -219,6 +233,23 @@ VLC_API picture_t *picture_Clone(picture_t *pic);
  */
 VLC_API int picture_Export( vlc_object_t *p_obj, block_t **pp_image, video_format_t *p_fmt, picture_t *p_picture, vlc_fourcc_t i_format, int i_override_width, int i_override_height );
 
+/**
+ * This function will export a batch of pictures to encoded bitstreams.
+ *
+ * It behaves like picture_Export() applied to each picture, but shares one
+ * encoder and conversion chain across the whole batch, which in particular
+ * amortizes the readback setup when the pictures reference hardware
+ * surfaces. The pictures should come from the same source so that they share
+ * formats and dimensions.
+ *
+ * pp_images must hold i_count entries. Entries for pictures which could not
+ * be exported are set to NULL. p_fmt can be NULL, otherwise it is set with
+ * the format used for the first exported picture.
+ *
+ * \return the number of pictures successfully exported.
+ */
+VLC_API unsigned picture_ExportBatch( vlc_object_t *p_obj, block_t **pp_images, video_format_t *p_fmt, picture_t *const *pp_pictures, unsigned i_count, vlc_fourcc_t i_format, int i_override_width, int i_override_height );
+
 /**
  * This function will setup all fields of a picture_t without allocating any
  * memory.
@@ -34,7 +34,12 @@
 /**
  * Picture fifo handle
  *
- * It is thread safe (push/pop).
+ * It is a lock-free single-producer/single-consumer queue: one thread may
+ * call picture_fifo_Push() while another thread calls picture_fifo_Pop(),
+ * picture_fifo_Peek(), picture_fifo_Flush() and picture_fifo_OffsetDate(),
+ * without any locking. Only picture_fifo_IsEmpty() may be called from any
+ * thread. Concurrent calls from more than one thread on either side are
+ * not supported.
  */
 typedef struct picture_fifo_t picture_fifo_t;
 
@@ -66,6 +71,14 @@ VLC_API picture_t * picture_fifo_Pop( picture_fifo_t * ) VLC_USED;
  */
 VLC_API picture_t * picture_fifo_Peek( picture_fifo_t * ) VLC_USED;
 
+/**
+ * It returns whether the fifo is currently empty.
+ *
+ * Unlike the other functions, it may be called from any thread; the answer
+ * is naturally stale if the producer or consumer is running concurrently.
+ */
+VLC_API bool picture_fifo_IsEmpty( picture_fifo_t * ) VLC_USED;
+
 /**
  * It saves a picture_t into the fifo.
  */
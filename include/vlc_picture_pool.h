@@ -87,6 +87,10 @@ VLC_API picture_pool_t * picture_pool_New(unsigned count,
  * This is a convenience wrapper for picture_NewFromFormat() and
  * picture_pool_New().
  *
+ * Unlike picture_pool_New(), such a pool may allocate further pictures on
+ * demand (up to twice the initial count) when all pictures are in use, rather
+ * than blocking in picture_pool_Wait().
+ *
  * @param fmt video format of pictures to allocate from the heap
  * @param count number of pictures to allocate
  *
@@ -161,6 +165,16 @@ void picture_pool_Cancel( picture_pool_t *, bool canceled );
  */
 bool picture_pool_OwnsPic( picture_pool_t *, picture_t *);
 
+/**
+ * Tests if all pictures of the pool meet an alignment constraint
+ *
+ * Checks that the base address and the pitch of every plane of every
+ * picture in the pool are multiples of the given alignment, which must be
+ * a power of two. Pictures allocated by the core always satisfy 64 bytes;
+ * pools built from externally allocated buffers may not.
+ */
+bool picture_pool_IsAligned( const picture_pool_t *, unsigned align );
+
 /**
  * Reserves pictures from a pool and creates a new pool with those.
  *
@@ -126,6 +126,8 @@ struct playlist_item_t
     playlist_item_t      **pp_children; /**< Children nodes/items */
     playlist_item_t       *p_parent;    /**< Item parent */
     int                    i_children;  /**< Number of children, -1 if not a node */
+    int                    i_pindex;    /**< Index within the parent node,
+                                             maintained by the playlist core */
     unsigned               i_nb_played; /**< Times played */
 
     int                    i_id;        /**< Playlist item specific id */
@@ -187,8 +187,22 @@ static inline int sout_MuxControl( sout_mux_t *p_mux, int i_query, ... )
 
 enum sout_stream_query_e {
     SOUT_STREAM_EMPTY,    /* arg1=bool *,       res=can fail (assume true) */
+    SOUT_STREAM_GET_STATS,/* arg1=sout_stream_stats_t *, res=can fail */
 };
 
+/**
+ * Performance counters of one stream output chain stage.
+ * Collected when the "sout-stats" option is enabled; the query is answered
+ * by the stage closest to the queried module (walk p_next for the others).
+ */
+typedef struct sout_stream_stats_t
+{
+    uint64_t   i_sent_blocks;   /**< blocks handed to this stage */
+    uint64_t   i_sent_bytes;    /**< payload bytes handed to this stage */
+    vlc_tick_t i_busy_duration; /**< cumulated time spent inside the stage */
+    size_t     i_queue_depth;   /**< pending blocks (with "sout-threaded") */
+} sout_stream_stats_t;
+
 struct sout_stream_t
 {
     struct vlc_common_members obj;
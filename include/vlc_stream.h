@@ -232,6 +232,25 @@ VLC_USED;
  */
 VLC_API ssize_t vlc_stream_Peek(stream_t *, const uint8_t **, size_t) VLC_USED;
 
+/**
+ * Peeks at data from a byte stream without copying.
+ *
+ * This function buffers for the requested number of bytes, waiting if
+ * necessary. Then it returns the stream buffer as a block, so that the caller
+ * can parse the data in place without copying it first. Like
+ * vlc_stream_Peek(), this function does not modify the stream read offset.
+ *
+ * \note
+ * The block is owned by the stream. It remains valid only until the next
+ * read/peek or seek operation on the same stream, and must not be modified
+ * nor released by the caller.
+ *
+ * \param len number of bytes to peek
+ * \return a block of at least len bytes (shorter if the end-of-stream is
+ * reached), or NULL on error.
+ */
+VLC_API const block_t *vlc_stream_PeekBlock(stream_t *, size_t len) VLC_USED;
+
 /**
  * Reads a data block from a byte stream.
  *
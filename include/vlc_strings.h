@@ -144,6 +144,9 @@ VLC_API char *vlc_strfinput( input_thread_t *, input_item_t *, const char * );
 static inline char *str_format( input_thread_t *input, input_item_t *item,
                                 const char *fmt )
 {
+    if( strchr( fmt, '%' ) == NULL ) /* no time conversion in the format */
+        return vlc_strfinput( input, item, fmt );
+
     char *s1 = vlc_strftime( fmt );
     char *s2 = vlc_strfinput( input, item, s1 );
     free( s1 );
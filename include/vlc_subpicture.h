@@ -101,6 +101,16 @@ struct vlc_spu_highlight_t
  */
 VLC_API subpicture_region_t * subpicture_region_New( const video_format_t *p_fmt );
 
+/**
+ * This function will create a new subpicture region showing the given
+ * picture, without allocating a pixel buffer of its own. A new reference
+ * to the picture is acquired.
+ *
+ * You must use subpicture_region_Delete to destroy it.
+ */
+VLC_API subpicture_region_t * subpicture_region_ForPicture( const video_format_t *p_fmt,
+                                                            picture_t *p_pic );
+
 /**
  * This function will destroy a subpicture region allocated by
  * subpicture_region_New.
@@ -543,6 +543,49 @@ VLC_API int vlc_cond_timedwait(vlc_cond_t *cond, vlc_mutex_t *mutex,
 
 int vlc_cond_timedwait_daytime(vlc_cond_t *, vlc_mutex_t *, time_t);
 
+/**
+ * \defgroup lockprofile Lock contention profiling
+ *
+ * When the build is configured with --enable-lock-profiling, the
+ * vlc_mutex_lock(), vlc_mutex_unlock() and vlc_cond_wait() call sites are
+ * redirected to profiled variants recording per-call-site acquisition
+ * counts, contended acquisitions, wait times and hold times into
+ * per-thread tables (no atomic operation on the hot path). The tables are
+ * merged when threads exit and the aggregate is printed to the standard
+ * error stream by vlc_lock_profile_Dump(), which the core calls on
+ * instance cleanup. Without the option, the profiled variants are still
+ * compiled (the symbols are part of the core ABI) but never called.
+ *
+ * Known limits: vlc_cond_timedwait() and cancellation cleanup unlocks are
+ * not redirected, and the hold time of a mutex spans any condition waits
+ * performed under it.
+ * @{
+ */
+
+/** Profiled variant of vlc_mutex_lock(); file must be a string literal. */
+VLC_API void vlc_mutex_lock_profiled(vlc_mutex_t *, const char *file,
+                                     unsigned line);
+
+/** Profiled variant of vlc_mutex_unlock(). */
+VLC_API void vlc_mutex_unlock_profiled(vlc_mutex_t *);
+
+/** Profiled variant of vlc_cond_wait(); file must be a string literal. */
+VLC_API void vlc_cond_wait_profiled(vlc_cond_t *, vlc_mutex_t *,
+                                    const char *file, unsigned line);
+
+/** Prints the merged lock profile to the standard error stream. */
+VLC_API void vlc_lock_profile_Dump(void);
+
+#ifdef ENABLE_LOCK_PROFILING
+/* The thread primitive implementation files #undef these after inclusion. */
+# define vlc_mutex_lock(m)   vlc_mutex_lock_profiled((m), __FILE__, __LINE__)
+# define vlc_mutex_unlock(m) vlc_mutex_unlock_profiled(m)
+# define vlc_cond_wait(c, m) vlc_cond_wait_profiled((c), (m), \
+                                                    __FILE__, __LINE__)
+#endif
+
+/** @} */
+
 /**
  * Initializes a semaphore.
  *
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * vlc_tracer.h: low-overhead event tracing
+ *****************************************************************************
+ * Copyright (C) 2018 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_TRACER_H_
+#define VLC_TRACER_H_
+
+/**
+ * \defgroup tracer Tracing
+ * \ingroup os
+ * \brief Low-overhead trace points
+ *
+ * Unlike the \ref messages log, trace points are meant for production
+ * timing investigations in hot paths: each point records a fixed-size
+ * (timestamp, thread, subsystem, key, value) tuple into a per-thread
+ * buffer, and the buffers are flushed in batches to a sink selected at
+ * run time through the VLC_TRACE environment variable (a file path, "-"
+ * for the standard error stream, "fd://n" for an inherited file
+ * descriptor, or "ring" for an in-memory ring dumped on exit).
+ *
+ * Trace points compile to nothing unless the build is configured with
+ * --enable-trace, and to a single atomic flag check when tracing is
+ * compiled in but not enabled at run time.
+ *
+ * @{
+ * \file
+ * Tracing functions
+ */
+
+/**
+ * Records one trace point event.
+ *
+ * The subsystem and key strings are stored by address and not copied:
+ * they must be string literals (or otherwise outlive the process).
+ *
+ * Use the vlc_trace_point() macro rather than calling this directly, so
+ * that the call sites vanish from builds without tracing support.
+ */
+VLC_API void vlc_tracer_Trace(const char *subsystem, const char *key,
+                              int64_t value);
+
+#ifdef ENABLE_TRACE
+# define vlc_trace_point(subsystem, key, value) \
+     vlc_tracer_Trace((subsystem), (key), (int64_t)(value))
+#else
+# define vlc_trace_point(subsystem, key, value) ((void)0)
+#endif
+
+/**
+ * @}
+ */
+#endif
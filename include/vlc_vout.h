@@ -96,6 +96,22 @@ VLC_API int vout_GetSnapshot( vout_thread_t *p_vout,
                               video_format_t *p_fmt,
                               const char *psz_format, vlc_tick_t i_timeout );
 
+/**
+ * This function saves the recent per-frame timing records of a vout
+ * (decode completion, prepare, display and deadline delta) to a file in
+ * the Chrome trace-event JSON format, suitable for chrome://tracing and
+ * compatible viewers.
+ *
+ * The records are kept in a fixed-size ring, so only the last few hundred
+ * frames are available; the function can be called at any time without
+ * disturbing the video output.
+ *
+ * \param p_vout the vout to trace
+ * \param psz_path the path of the file to write
+ * \return VLC_SUCCESS on success, an error code otherwise
+ */
+VLC_API int vout_SaveFrameTrace( vout_thread_t *p_vout, const char *psz_path );
+
 VLC_API void vout_ChangeAspectRatio( vout_thread_t *p_vout,
                                      unsigned int i_num, unsigned int i_den );
 
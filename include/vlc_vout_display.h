@@ -184,6 +184,9 @@ enum {
 
     /* VR navigation */
     VOUT_DISPLAY_EVENT_VIEWPOINT_MOVED,
+
+    /* Display refresh, see vout_display_SendEventVsync() */
+    VOUT_DISPLAY_EVENT_VSYNC,
 };
 
 /**
@@ -364,6 +367,15 @@ static inline void vout_display_SendEventViewpointMoved(vout_display_t *vd,
 {
     vout_display_SendEvent(vd, VOUT_DISPLAY_EVENT_VIEWPOINT_MOVED, vp);
 }
+/**
+ * It reports the time of a display vertical blank (or the closest
+ * approximation the module has, e.g. the return from a blocking buffer
+ * swap). The core uses it to schedule pictures on vblank boundaries.
+ */
+static inline void vout_display_SendEventVsync(vout_display_t *vd, vlc_tick_t date)
+{
+    vout_display_SendEvent(vd, VOUT_DISPLAY_EVENT_VSYNC, date);
+}
 
 /**
  * Asks for a new window of a given type.
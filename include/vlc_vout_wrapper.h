@@ -78,6 +78,14 @@ vout_display_t *vout_NewDisplay( vout_thread_t *, const video_format_t *,
  * It destroy a vout managed display.
  */
 void vout_DeleteDisplay(vout_display_t *, vout_display_state_t *);
+
+/**
+ * It predicts the display vertical blank nearest to the given date, from
+ * the vblank timing reported by the display module
+ * (VOUT_DISPLAY_EVENT_VSYNC). It returns VLC_TICK_INVALID when the
+ * display does not report vblanks.
+ */
+vlc_tick_t vout_display_AlignVsync(vout_display_t *, vlc_tick_t date);
 bool vout_IsDisplayFiltered(vout_display_t *);
 picture_t * vout_FilterDisplay(vout_display_t *, picture_t *);
 void vout_FilterFlush(vout_display_t *);
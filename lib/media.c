@@ -310,31 +310,35 @@ static void send_parsed_changed( libvlc_media_t *p_md,
 /**************************************************************************
  * input_item_preparse_ended (Private) (vlc event Callback)
  **************************************************************************/
-static void input_item_preparse_ended(input_item_t *item,
-                                      enum input_item_preparse_status status,
-                                      void *user_data)
+static libvlc_media_parsed_status_t
+preparse_status_to_parsed_status( enum input_item_preparse_status status )
 {
-    VLC_UNUSED(item);
-    libvlc_media_t * p_md = user_data;
-    libvlc_media_parsed_status_t new_status;
-
     switch( status )
     {
         case ITEM_PREPARSE_SKIPPED:
-            new_status = libvlc_media_parsed_status_skipped;
-            break;
+            return libvlc_media_parsed_status_skipped;
         case ITEM_PREPARSE_FAILED:
-            new_status = libvlc_media_parsed_status_failed;
-            break;
+            return libvlc_media_parsed_status_failed;
         case ITEM_PREPARSE_TIMEOUT:
-            new_status = libvlc_media_parsed_status_timeout;
-            break;
+            return libvlc_media_parsed_status_timeout;
         case ITEM_PREPARSE_DONE:
-            new_status = libvlc_media_parsed_status_done;
-            break;
+            return libvlc_media_parsed_status_done;
         default:
-            return;
+            return 0;
     }
+}
+
+static void input_item_preparse_ended(input_item_t *item,
+                                      enum input_item_preparse_status status,
+                                      void *user_data)
+{
+    VLC_UNUSED(item);
+    libvlc_media_t * p_md = user_data;
+    libvlc_media_parsed_status_t new_status =
+        preparse_status_to_parsed_status( status );
+
+    if( new_status == 0 )
+        return;
     send_parsed_changed( p_md, new_status );
 }
 
@@ -860,6 +864,235 @@ libvlc_media_parse_stop( libvlc_media_t *media )
     libvlc_MetadataCancel( media->p_libvlc_instance->p_libvlc_int, media );
 }
 
+/**************************************************************************
+ * Parse a batch of medias through the preparser pool.
+ **************************************************************************/
+struct media_parse_batch;
+
+struct media_parse_batch_entry
+{
+    struct media_parse_batch *batch;
+    size_t index;
+};
+
+struct media_parse_batch
+{
+    libvlc_media_parse_batch_cb pf_parsed;
+    void *p_opaque;
+    size_t i_count;
+    libvlc_media_t **pp_medias;
+    libvlc_media_parsed_status_t *p_statuses;
+    size_t *p_dup_of; /* index this entry was folded into, or its own */
+    struct media_parse_batch_entry *p_entries;
+
+    vlc_mutex_t lock;
+    size_t i_pending; /* submitted parses + 1 while still submitting */
+};
+
+static void media_parse_batch_done( struct media_parse_batch *batch )
+{
+    /* Duplicated MRLs inherit the status of the parse they folded into */
+    for( size_t i = 0; i < batch->i_count; i++ )
+        if( batch->p_dup_of[i] != i )
+            batch->p_statuses[i] = batch->p_statuses[batch->p_dup_of[i]];
+
+    batch->pf_parsed( batch->p_opaque, batch->pp_medias, batch->p_statuses,
+                      batch->i_count );
+
+    for( size_t i = 0; i < batch->i_count; i++ )
+        libvlc_media_release( batch->pp_medias[i] );
+    vlc_mutex_destroy( &batch->lock );
+    free( batch->p_entries );
+    free( batch->p_dup_of );
+    free( batch->p_statuses );
+    free( batch->pp_medias );
+    free( batch );
+}
+
+static void media_parse_batch_record( struct media_parse_batch *batch,
+                                      size_t index,
+                                      libvlc_media_parsed_status_t status )
+{
+    bool done;
+
+    vlc_mutex_lock( &batch->lock );
+    batch->p_statuses[index] = status;
+    done = ( --batch->i_pending == 0 );
+    vlc_mutex_unlock( &batch->lock );
+
+    if( done )
+        media_parse_batch_done( batch );
+}
+
+static void batch_preparse_ended( input_item_t *item,
+                                  enum input_item_preparse_status status,
+                                  void *user_data )
+{
+    struct media_parse_batch_entry *entry = user_data;
+    struct media_parse_batch *batch = entry->batch;
+    libvlc_media_parsed_status_t new_status =
+        preparse_status_to_parsed_status( status );
+
+    VLC_UNUSED(item);
+
+    /* Keep the normal per-media event flow */
+    if( new_status != 0 )
+        send_parsed_changed( batch->pp_medias[entry->index], new_status );
+
+    media_parse_batch_record( batch, entry->index, new_status );
+}
+
+static void batch_subtree_added( input_item_t *item, input_item_node_t *node,
+                                 void *user_data )
+{
+    struct media_parse_batch_entry *entry = user_data;
+
+    input_item_subtree_added( item, node,
+                              entry->batch->pp_medias[entry->index] );
+}
+
+static const input_preparser_callbacks_t batch_preparser_callbacks = {
+    .on_preparse_ended = batch_preparse_ended,
+    .on_subtree_added = batch_subtree_added,
+};
+
+int
+libvlc_media_parse_batch( libvlc_media_t *const *medias, size_t count,
+                          libvlc_media_parse_flag_t parse_flag, int timeout,
+                          libvlc_media_parse_batch_cb parsed_cb, void *opaque )
+{
+    if( count == 0 || parsed_cb == NULL )
+        return -1;
+
+    struct media_parse_batch *batch = malloc( sizeof (*batch) );
+    char **uris = vlc_alloc( count, sizeof (*uris) );
+    if( batch != NULL )
+    {
+        batch->pp_medias = vlc_alloc( count, sizeof (*batch->pp_medias) );
+        batch->p_statuses = calloc( count, sizeof (*batch->p_statuses) );
+        batch->p_dup_of = vlc_alloc( count, sizeof (*batch->p_dup_of) );
+        batch->p_entries = vlc_alloc( count, sizeof (*batch->p_entries) );
+    }
+    if( batch == NULL || uris == NULL || batch->pp_medias == NULL
+     || batch->p_statuses == NULL || batch->p_dup_of == NULL
+     || batch->p_entries == NULL )
+    {
+        free( uris );
+        if( batch != NULL )
+        {
+            free( batch->p_entries );
+            free( batch->p_dup_of );
+            free( batch->p_statuses );
+            free( batch->pp_medias );
+            free( batch );
+        }
+        return -1;
+    }
+
+    batch->pf_parsed = parsed_cb;
+    batch->p_opaque = opaque;
+    batch->i_count = count;
+    vlc_mutex_init( &batch->lock );
+    batch->i_pending = 1; /* guard until every media is submitted */
+
+    libvlc_int_t *libvlc = medias[0]->p_libvlc_instance->p_libvlc_int;
+    input_item_meta_request_option_t parse_scope =
+        META_REQUEST_OPTION_SCOPE_LOCAL;
+    if( parse_flag & libvlc_media_parse_network )
+        parse_scope |= META_REQUEST_OPTION_SCOPE_NETWORK;
+    if( parse_flag & libvlc_media_do_interact )
+        parse_scope |= META_REQUEST_OPTION_DO_INTERACT;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        libvlc_media_t *media = medias[i];
+
+        libvlc_media_retain( media );
+        batch->pp_medias[i] = media;
+        batch->p_dup_of[i] = i;
+        batch->p_entries[i].batch = batch;
+        batch->p_entries[i].index = i;
+        uris[i] = input_item_GetURI( media->p_input_item );
+    }
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        libvlc_media_t *media = medias[i];
+        input_item_t *item = media->p_input_item;
+        bool needed;
+
+        /* Fold identical MRLs already in flight within this batch */
+        size_t dup = i;
+        for( size_t j = 0; j < i && uris[i] != NULL; j++ )
+        {
+            if( batch->p_dup_of[j] == j && uris[j] != NULL
+             && !strcmp( uris[i], uris[j] ) )
+            {
+                dup = j;
+                break;
+            }
+        }
+        if( dup != i )
+        {
+            batch->p_dup_of[i] = dup;
+            continue;
+        }
+
+        vlc_mutex_lock( &media->parsed_lock );
+        needed = !media->has_asked_preparse;
+        media->has_asked_preparse = true;
+        if( needed )
+            media->is_parsed = false;
+        vlc_mutex_unlock( &media->parsed_lock );
+
+        if( !needed )
+        {   /* Already parsed or queued by other means: report the status at
+             * submission time rather than requesting a redundant parse */
+            batch->p_statuses[i] = libvlc_media_get_parsed_status( media );
+            continue;
+        }
+
+        if( ( parse_flag & libvlc_media_fetch_network )
+         && libvlc_ArtRequest( libvlc, item,
+                               META_REQUEST_OPTION_SCOPE_NETWORK,
+                               NULL, NULL ) != VLC_SUCCESS )
+        {
+            batch->p_statuses[i] = libvlc_media_parsed_status_failed;
+            continue;
+        }
+
+        vlc_mutex_lock( &batch->lock );
+        batch->i_pending++;
+        vlc_mutex_unlock( &batch->lock );
+
+        if( libvlc_MetadataRequest( libvlc, item, parse_scope,
+                                    &batch_preparser_callbacks,
+                                    &batch->p_entries[i], timeout,
+                                    media ) != VLC_SUCCESS )
+        {
+            vlc_mutex_lock( &batch->lock );
+            batch->i_pending--;
+            batch->p_statuses[i] = libvlc_media_parsed_status_failed;
+            vlc_mutex_unlock( &batch->lock );
+        }
+    }
+
+    for( size_t i = 0; i < count; i++ )
+        free( uris[i] );
+    free( uris );
+
+    /* Drop the submission guard; runs the completion callback right away if
+     * nothing needed parsing or everything already finished */
+    bool done;
+    vlc_mutex_lock( &batch->lock );
+    done = ( --batch->i_pending == 0 );
+    vlc_mutex_unlock( &batch->lock );
+    if( done )
+        media_parse_batch_done( batch );
+
+    return 0;
+}
+
 /**************************************************************************
  * Get parsed status for media object.
  **************************************************************************/
@@ -48,6 +48,75 @@ typedef enum EventPlaceInTime {
  * Private functions
  */
 
+/**************************************************************************
+ *       media-to-index lookup table (private)
+ *
+ * Sorted by media pointer then by index, rebuilt lazily on the first
+ * libvlc_media_list_index_of_item() after a mutation.
+ **************************************************************************/
+struct media_list_lookup
+{
+    libvlc_media_t *p_md;
+    int index;
+};
+
+static inline void lookup_invalidate( libvlc_media_list_t *p_mlist )
+{
+    p_mlist->b_lookup_dirty = true;
+}
+
+static int lookup_compare( const void *a, const void *b )
+{
+    const struct media_list_lookup *la = a, *lb = b;
+
+    if( la->p_md != lb->p_md )
+        return ( (uintptr_t)la->p_md > (uintptr_t)lb->p_md ) ? 1 : -1;
+    return la->index - lb->index;
+}
+
+static bool lookup_rebuild( libvlc_media_list_t *p_mlist )
+{
+    size_t count = vlc_array_count( &p_mlist->items );
+    struct media_list_lookup *p_lookup =
+        realloc( p_mlist->p_lookup, count * sizeof (*p_lookup) );
+
+    if( count > 0 && unlikely(p_lookup == NULL) )
+        return false;
+    p_mlist->p_lookup = p_lookup;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        p_lookup[i].p_md = vlc_array_item_at_index( &p_mlist->items, i );
+        p_lookup[i].index = i;
+    }
+    qsort( p_lookup, count, sizeof (*p_lookup), lookup_compare );
+
+    p_mlist->b_lookup_dirty = false;
+    return true;
+}
+
+static int lookup_find( libvlc_media_list_t *p_mlist,
+                        const libvlc_media_t *p_md )
+{
+    const struct media_list_lookup *p_lookup = p_mlist->p_lookup;
+    size_t lo = 0, hi = vlc_array_count( &p_mlist->items );
+
+    /* Lower bound, so duplicated medias resolve to their first index */
+    while( lo < hi )
+    {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if( (uintptr_t)p_lookup[mid].p_md < (uintptr_t)p_md )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if( lo < vlc_array_count( &p_mlist->items )
+     && p_lookup[lo].p_md == p_md )
+        return p_lookup[lo].index;
+    return -1;
+}
+
 
 
 /**************************************************************************
@@ -168,6 +237,8 @@ libvlc_media_list_new( libvlc_instance_t * p_inst )
 
     vlc_array_init( &p_mlist->items );
     assert( p_mlist->items.i_count == 0 );
+    p_mlist->p_lookup = NULL;
+    p_mlist->b_lookup_dirty = true;
     p_mlist->i_refcount = 1;
     p_mlist->p_md = NULL;
     p_mlist->p_internal_md = NULL;
@@ -206,6 +277,7 @@ void libvlc_media_list_release( libvlc_media_list_t * p_mlist )
     vlc_mutex_destroy( &p_mlist->object_lock );
     vlc_mutex_destroy( &p_mlist->refcount_lock );
     vlc_array_clear( &p_mlist->items );
+    free( p_mlist->p_lookup );
 
     libvlc_release( p_mlist->p_libvlc_instance );
     free( p_mlist );
@@ -337,6 +409,7 @@ void libvlc_media_list_internal_add_media( libvlc_media_list_t * p_mlist,
     notify_item_addition( p_mlist, p_md, vlc_array_count( &p_mlist->items ),
                           EventWillHappen );
     vlc_array_append_or_abort( &p_mlist->items, p_md );
+    lookup_invalidate( p_mlist );
     notify_item_addition( p_mlist, p_md, vlc_array_count( &p_mlist->items )-1,
                           EventDidHappen );
 }
@@ -365,6 +438,7 @@ void libvlc_media_list_internal_insert_media( libvlc_media_list_t * p_mlist,
 
     notify_item_addition( p_mlist, p_md, index, EventWillHappen );
     vlc_array_insert_or_abort( &p_mlist->items, p_md, index );
+    lookup_invalidate( p_mlist );
     notify_item_addition( p_mlist, p_md, index, EventDidHappen );
 }
 
@@ -397,12 +471,121 @@ int libvlc_media_list_internal_remove_index( libvlc_media_list_t * p_mlist,
 
     notify_item_deletion( p_mlist, p_md, index, EventWillHappen );
     vlc_array_remove( &p_mlist->items, index );
+    lookup_invalidate( p_mlist );
     notify_item_deletion( p_mlist, p_md, index, EventDidHappen );
 
     libvlc_media_release( p_md );
     return 0;
 }
 
+/**************************************************************************
+ *       libvlc_media_list_insert_media_array (Public)
+ *
+ * Lock should be held when entering.
+ **************************************************************************/
+int libvlc_media_list_insert_media_array( libvlc_media_list_t * p_mlist,
+                                          libvlc_media_t *const * pp_md,
+                                          size_t i_count, int index )
+{
+    size_t count = vlc_array_count( &p_mlist->items );
+    libvlc_event_t event;
+
+    if( !mlist_is_writable(p_mlist) )
+        return -1;
+    if( index == -1 )
+        index = count;
+    if( (size_t) index > count )
+    {
+        libvlc_printerr( "Index out of bounds" );
+        return -1;
+    }
+    if( i_count == 0 )
+        return 0;
+
+    /* Open the whole range at once instead of shifting the tail once per
+     * inserted media */
+    void **pp = realloc( p_mlist->items.pp_elems,
+                         sizeof( void * ) * (count + i_count) );
+    if( unlikely(pp == NULL) )
+    {
+        libvlc_printerr( "Not enough memory" );
+        return -1;
+    }
+    p_mlist->items.pp_elems = pp;
+
+    size_t tail = count - index;
+    if( tail > 0 )
+        memmove( pp + index + i_count, pp + index, sizeof( void * ) * tail );
+
+    for( size_t i = 0; i < i_count; i++ )
+    {
+        libvlc_media_retain( pp_md[i] );
+        pp[index + i] = pp_md[i];
+    }
+    p_mlist->items.i_count = count + i_count;
+    lookup_invalidate( p_mlist );
+
+    /* A single event covers the whole range */
+    event.type = libvlc_MediaListItemsAdded;
+    event.u.media_list_items_added.index = index;
+    event.u.media_list_items_added.count = i_count;
+    libvlc_event_send( &p_mlist->event_manager, &event );
+    return 0;
+}
+
+/**************************************************************************
+ *       libvlc_media_list_remove_index_range (Public)
+ *
+ * Lock should be held when entering.
+ **************************************************************************/
+int libvlc_media_list_remove_index_range( libvlc_media_list_t * p_mlist,
+                                          int index, size_t i_count )
+{
+    size_t count = vlc_array_count( &p_mlist->items );
+    libvlc_event_t event;
+
+    if( !mlist_is_writable(p_mlist) )
+        return -1;
+    if( index < 0 || (size_t) index > count || i_count > count - index )
+    {
+        libvlc_printerr( "Index out of bounds" );
+        return -1;
+    }
+    if( i_count == 0 )
+        return 0;
+
+    void **pp = p_mlist->items.pp_elems;
+
+    for( size_t i = 0; i < i_count; i++ )
+        libvlc_media_release( pp[index + i] );
+
+    size_t tail = count - index - i_count;
+    if( tail > 0 )
+        memmove( pp + index, pp + index + i_count,
+                 sizeof( void * ) * tail );
+    p_mlist->items.i_count = count - i_count;
+
+    if( p_mlist->items.i_count > 0 )
+    {
+        pp = realloc( pp, sizeof( void * ) * p_mlist->items.i_count );
+        if( likely(pp != NULL) )
+            p_mlist->items.pp_elems = pp;
+    }
+    else
+    {
+        free( pp );
+        p_mlist->items.pp_elems = NULL;
+    }
+    lookup_invalidate( p_mlist );
+
+    /* A single event covers the whole range */
+    event.type = libvlc_MediaListItemsDeleted;
+    event.u.media_list_items_deleted.index = index;
+    event.u.media_list_items_deleted.count = i_count;
+    libvlc_event_send( &p_mlist->event_manager, &event );
+    return 0;
+}
+
 /**************************************************************************
  *       libvlc_media_list_item_at_index (Public)
  *
@@ -434,7 +617,13 @@ libvlc_media_list_item_at_index( libvlc_media_list_t * p_mlist,
 int libvlc_media_list_index_of_item( libvlc_media_list_t * p_mlist,
                                      libvlc_media_t * p_searched_md )
 {
-    int idx = vlc_array_index_of_item( &p_mlist->items, p_searched_md );
+    int idx;
+
+    if( !p_mlist->b_lookup_dirty || lookup_rebuild( p_mlist ) )
+        idx = lookup_find( p_mlist, p_searched_md );
+    else /* could not allocate the lookup table */
+        idx = vlc_array_index_of_item( &p_mlist->items, p_searched_md );
+
     if( idx == -1 )
         libvlc_printerr( "Media not found" );
 
@@ -46,6 +46,12 @@ struct libvlc_media_list_t
     libvlc_media_t * p_internal_md; /* media set from media.c */
     vlc_array_t                items;
 
+    /* Lazily rebuilt media-to-index lookup table, so that
+     * libvlc_media_list_index_of_item() does not linear-scan large lists.
+     * Invalidated by every mutation of items. */
+    struct media_list_lookup *p_lookup;
+    bool                  b_lookup_dirty;
+
     /* This indicates if this media list is read-only
      * from a user point of view */
     bool                  b_read_only;
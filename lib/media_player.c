@@ -289,6 +289,56 @@ input_scrambled_changed( vlc_object_t * p_this, char const * psz_cmd,
     return VLC_SUCCESS;
 }
 
+/* Publish the progress/statistics snapshot read wait-free by
+ * libvlc_media_player_get_stats_snapshot(). Only ever called from the input
+ * "intf-event" callback, so writes never race each other; readers detect a
+ * write in progress from the odd sequence number and retry. */
+static void
+snapshot_publish( libvlc_media_player_t *p_mi, input_thread_t *p_input )
+{
+    libvlc_media_player_stats_snapshot_t snap;
+
+    snap.i_time = from_mtime(var_GetInteger( p_input, "time" ));
+    snap.i_length = from_mtime(var_GetInteger( p_input, "length" ));
+    snap.f_position = var_GetFloat( p_input, "position" );
+    snap.f_cache = var_GetFloat( p_input, "cache" );
+
+    memset( &snap.stats, 0, sizeof (snap.stats) );
+
+    input_item_t *p_item = input_GetItem( p_input );
+    vlc_mutex_lock( &p_item->lock );
+    input_stats_t *p_itm_stats = p_item->p_stats;
+    if( p_itm_stats != NULL )
+    {
+        snap.stats.i_read_bytes = p_itm_stats->i_read_bytes;
+        snap.stats.f_input_bitrate = p_itm_stats->f_input_bitrate;
+
+        snap.stats.i_demux_read_bytes = p_itm_stats->i_demux_read_bytes;
+        snap.stats.f_demux_bitrate = p_itm_stats->f_demux_bitrate;
+        snap.stats.i_demux_corrupted = p_itm_stats->i_demux_corrupted;
+        snap.stats.i_demux_discontinuity = p_itm_stats->i_demux_discontinuity;
+
+        snap.stats.i_decoded_video = p_itm_stats->i_decoded_video;
+        snap.stats.i_decoded_audio = p_itm_stats->i_decoded_audio;
+
+        snap.stats.i_displayed_pictures = p_itm_stats->i_displayed_pictures;
+        snap.stats.i_lost_pictures = p_itm_stats->i_lost_pictures;
+
+        snap.stats.i_played_abuffers = p_itm_stats->i_played_abuffers;
+        snap.stats.i_lost_abuffers = p_itm_stats->i_lost_abuffers;
+    }
+    vlc_mutex_unlock( &p_item->lock );
+
+    unsigned seq = atomic_load_explicit( &p_mi->snapshot.seq,
+                                         memory_order_relaxed );
+    atomic_store_explicit( &p_mi->snapshot.seq, seq + 1,
+                           memory_order_relaxed );
+    atomic_thread_fence( memory_order_release );
+    p_mi->snapshot.data = snap;
+    atomic_store_explicit( &p_mi->snapshot.seq, seq + 2,
+                           memory_order_release );
+}
+
 static int
 input_event_changed( vlc_object_t * p_this, char const * psz_cmd,
                      vlc_value_t oldval, vlc_value_t newval,
@@ -301,6 +351,12 @@ input_event_changed( vlc_object_t * p_this, char const * psz_cmd,
 
     assert( !strcmp( psz_cmd, "intf-event" ) );
 
+    if( newval.i_int == INPUT_EVENT_POSITION ||
+        newval.i_int == INPUT_EVENT_LENGTH ||
+        newval.i_int == INPUT_EVENT_CACHE ||
+        newval.i_int == INPUT_EVENT_STATISTICS )
+        snapshot_publish( p_mi, p_input );
+
     if( newval.i_int == INPUT_EVENT_STATE )
     {
         libvlc_state_t libvlc_state;
@@ -759,6 +815,9 @@ libvlc_media_player_new( libvlc_instance_t *instance )
 
     vlc_viewpoint_init(&mp->viewpoint);
 
+    atomic_init(&mp->snapshot.seq, 0);
+    memset(&mp->snapshot.data, 0, sizeof (mp->snapshot.data));
+
     var_Create (mp, "viewpoint", VLC_VAR_ADDRESS);
     var_SetAddress( mp, "viewpoint", &mp->viewpoint );
     vlc_mutex_init (&mp->input.lock);
@@ -1432,6 +1491,29 @@ float libvlc_media_player_get_position( libvlc_media_player_t *p_mi )
     return f_position;
 }
 
+int libvlc_media_player_get_stats_snapshot( libvlc_media_player_t *p_mi,
+                             libvlc_media_player_stats_snapshot_t *p_snapshot )
+{
+    unsigned seq;
+
+    do
+    {
+        seq = atomic_load_explicit( &p_mi->snapshot.seq,
+                                    memory_order_acquire );
+        if( seq == 0 )
+            return false; /* nothing published yet */
+        if( seq & 1 )
+            continue; /* write in progress */
+
+        *p_snapshot = p_mi->snapshot.data;
+        atomic_thread_fence( memory_order_acquire );
+    }
+    while( atomic_load_explicit( &p_mi->snapshot.seq,
+                                 memory_order_relaxed ) != seq );
+
+    return true;
+}
+
 void libvlc_media_player_set_chapter( libvlc_media_player_t *p_mi,
                                       int chapter )
 {
@@ -2027,6 +2109,53 @@ int libvlc_media_player_set_role(libvlc_media_player_t *mp, unsigned role)
     return 0;
 }
 
+size_t libvlc_media_player_get_es_stats(libvlc_media_player_t *p_mi,
+                                        libvlc_es_stats_t **pp_stats)
+{
+    *pp_stats = NULL;
+
+    input_thread_t *p_input_thread = libvlc_get_input_thread(p_mi);
+    if (p_input_thread == NULL)
+        return 0;
+
+    input_es_stats_t *p_es;
+    size_t i_count;
+    int i_ret = input_Control(p_input_thread, INPUT_GET_ES_STATS,
+                              &p_es, &i_count);
+    vlc_object_release(p_input_thread);
+    if (i_ret != VLC_SUCCESS)
+        return 0;
+
+    libvlc_es_stats_t *p_stats = vlc_alloc(i_count, sizeof (*p_stats));
+    if (i_count > 0 && p_stats == NULL)
+    {
+        free(p_es);
+        return 0;
+    }
+
+    for (size_t i = 0; i < i_count; i++)
+    {
+        libvlc_es_stats_t *st = &p_stats[i];
+
+        st->i_id = p_es[i].i_id;
+        switch (p_es[i].i_cat)
+        {
+            case AUDIO_ES: st->i_type = libvlc_track_audio; break;
+            case VIDEO_ES: st->i_type = libvlc_track_video; break;
+            case SPU_ES:   st->i_type = libvlc_track_text;  break;
+            default:       st->i_type = libvlc_track_unknown; break;
+        }
+        st->i_demux_bytes = p_es[i].i_demux_bytes;
+        st->f_demux_bitrate = p_es[i].f_demux_bitrate;
+        st->i_discontinuities = p_es[i].i_discontinuities;
+        st->i_fifo_bytes = p_es[i].i_fifo_bytes;
+    }
+    free(p_es);
+
+    *pp_stats = p_stats;
+    return i_count;
+}
+
 int libvlc_media_player_get_role(libvlc_media_player_t *mp)
 {
     int ret = -1;
@@ -29,6 +29,8 @@
 # include "config.h"
 #endif
 
+#include <stdatomic.h>
+
 #include <vlc/vlc.h>
 #include <vlc/libvlc_media.h>
 #include <vlc_input.h>
@@ -57,6 +59,15 @@ struct libvlc_media_player_t
     libvlc_state_t state;
     vlc_viewpoint_t viewpoint;
     int selected_es[3];
+
+    /* Seqlock-published copy of playback progress and input statistics, so
+     * that libvlc_media_player_get_stats_snapshot() never blocks on input
+     * internals. Written only from the input "intf-event" callback. */
+    struct
+    {
+        atomic_uint seq; /* odd while a write is in progress */
+        libvlc_media_player_stats_snapshot_t data;
+    } snapshot;
 };
 
 /* Media player - audio, video */
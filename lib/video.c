@@ -169,6 +169,21 @@ libvlc_video_take_snapshot( libvlc_media_player_t *p_mi, unsigned num,
     return 0;
 }
 
+int
+libvlc_video_save_frame_trace( libvlc_media_player_t *p_mi, unsigned num,
+                               const char *psz_filepath )
+{
+    assert( psz_filepath );
+
+    vout_thread_t *p_vout = GetVout (p_mi, num);
+    if (p_vout == NULL)
+        return -1;
+
+    int ret = vout_SaveFrameTrace( p_vout, psz_filepath );
+    vlc_object_release( p_vout );
+    return ret == VLC_SUCCESS ? 0 : -1;
+}
+
 int libvlc_video_get_size( libvlc_media_player_t *p_mi, unsigned num,
                            unsigned *restrict px, unsigned *restrict py )
 {
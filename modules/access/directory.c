@@ -120,48 +120,98 @@ int DirRead (stream_t *access, input_item_node_t *node)
     struct vlc_readdir_helper rdh;
     vlc_readdir_helper_init(&rdh, access, node);
 
-    while (ret == VLC_SUCCESS && (entry = vlc_readdir(sys->dir)) != NULL)
+    while (ret == VLC_SUCCESS)
     {
-        struct stat st;
-        int type;
-
-#ifdef HAVE_OPENAT
-        if (fstatat(dirfd(sys->dir), entry, &st, 0))
-            continue;
-#else
-        char path[PATH_MAX];
+        int type = -1;
+
+#if !defined(_WIN32) && !defined(__OS2__) && defined(DT_DIR)
+        /* vlc_opendir() is plain opendir() here, so the directory entry and
+         * its d_type are reachable. Most file systems report the entry type
+         * inline, which spares a stat() per entry - on network mounts that
+         * is one round trip per file. DT_UNKNOWN and symbolic links still
+         * fall back to stat() below. */
+        struct dirent *ent = readdir(sys->dir);
+        if (ent == NULL)
+            break;
+        entry = ent->d_name;
 
-        if (snprintf(path, PATH_MAX, "%s"DIR_SEP"%s", access->psz_filepath,
-                     entry) >= PATH_MAX || vlc_stat(path, &st))
-            continue;
-#endif
-        switch (st.st_mode & S_IFMT)
+        switch (ent->d_type)
         {
-            case S_IFBLK:
+            case DT_BLK:
                 if (!special_files)
                     continue;
                 type = ITEM_TYPE_DISC;
                 break;
-            case S_IFCHR:
+            case DT_CHR:
                 if (!special_files)
                     continue;
                 type = ITEM_TYPE_CARD;
                 break;
-            case S_IFIFO:
+            case DT_FIFO:
                 if (!special_files)
                     continue;
                 type = ITEM_TYPE_STREAM;
                 break;
-            case S_IFREG:
+            case DT_REG:
                 type = ITEM_TYPE_FILE;
                 break;
-            case S_IFDIR:
+            case DT_DIR:
                 type = ITEM_TYPE_DIRECTORY;
                 break;
-            /* S_IFLNK cannot occur while following symbolic links */
-            /* S_IFSOCK cannot be opened with open()/openat() */
-            default:
-                continue; /* ignore */
+            case DT_SOCK:
+                continue; /* cannot be opened with open()/openat() */
+            default: /* DT_UNKNOWN, DT_LNK: ask stat() */
+                break;
+        }
+#else
+        entry = vlc_readdir(sys->dir);
+        if (entry == NULL)
+            break;
+#endif
+
+        if (type < 0)
+        {
+            struct stat st;
+
+#ifdef HAVE_OPENAT
+            if (fstatat(dirfd(sys->dir), entry, &st, 0))
+                continue;
+#else
+            char path[PATH_MAX];
+
+            if (snprintf(path, PATH_MAX, "%s"DIR_SEP"%s",
+                         access->psz_filepath, entry) >= PATH_MAX
+             || vlc_stat(path, &st))
+                continue;
+#endif
+            switch (st.st_mode & S_IFMT)
+            {
+                case S_IFBLK:
+                    if (!special_files)
+                        continue;
+                    type = ITEM_TYPE_DISC;
+                    break;
+                case S_IFCHR:
+                    if (!special_files)
+                        continue;
+                    type = ITEM_TYPE_CARD;
+                    break;
+                case S_IFIFO:
+                    if (!special_files)
+                        continue;
+                    type = ITEM_TYPE_STREAM;
+                    break;
+                case S_IFREG:
+                    type = ITEM_TYPE_FILE;
+                    break;
+                case S_IFDIR:
+                    type = ITEM_TYPE_DIRECTORY;
+                    break;
+                /* S_IFLNK cannot occur while following symbolic links */
+                /* S_IFSOCK cannot be opened with open()/openat() */
+                default:
+                    continue; /* ignore */
+            }
         }
 
         /* Create an input item for the current entry */
@@ -64,11 +64,39 @@
 #include <vlc_url.h>
 #include <vlc_interrupt.h>
 
+#ifdef HAVE_LIBURING
+# include <poll.h>
+# include <liburing.h>
+# include <vlc_block.h>
+
+/* Number of readahead requests kept in flight */
+# define FILE_URING_DEPTH 8
+/* Size of each readahead request */
+# define FILE_URING_CHUNK (1 << 17)
+
+struct uring_req
+{
+    block_t *block;
+    uint64_t offset;
+    bool pending; /* submitted, completion not reaped yet */
+    bool done; /* completion reaped, block ready for delivery */
+    ssize_t res;
+};
+#endif
+
 typedef struct
 {
     int fd;
 
     bool b_pace_control;
+#ifdef HAVE_LIBURING
+    bool b_uring;
+    bool uring_eof; /* readahead caught up with the end of file */
+    unsigned uring_head; /* oldest request in flight */
+    uint64_t uring_offset; /* file offset of the next request to submit */
+    struct uring_req uring_req[FILE_URING_DEPTH];
+    struct io_uring uring;
+#endif
 } access_sys_t;
 
 #if !defined (_WIN32) && !defined (__OS2__)
@@ -132,6 +160,184 @@ static int FileSeek (stream_t *, uint64_t);
 static int NoSeek (stream_t *, uint64_t);
 static int FileControl (stream_t *, int, va_list);
 
+#ifdef HAVE_LIBURING
+/*
+ * Asynchronous read path: a queue of FILE_URING_DEPTH read requests at
+ * sequential file offsets is kept in flight through io_uring, and their
+ * completions are delivered in order as blocks. This gives deep readahead
+ * without a dedicated reader thread per input.
+ */
+
+/** Marks all reaped completions in the request queue, without waiting. */
+static void UringReap (access_sys_t *p_sys)
+{
+    struct io_uring_cqe *cqe;
+
+    while (io_uring_peek_cqe (&p_sys->uring, &cqe) == 0)
+    {
+        struct uring_req *req = io_uring_cqe_get_data (cqe);
+
+        req->pending = false;
+        req->done = true;
+        req->res = cqe->res;
+        io_uring_cqe_seen (&p_sys->uring, cqe);
+    }
+}
+
+/** Fills the request queue with readahead requests. */
+static void UringSubmit (access_sys_t *p_sys)
+{
+    unsigned queued = 0;
+
+    for (unsigned i = 0; i < FILE_URING_DEPTH && !p_sys->uring_eof; i++)
+    {
+        struct uring_req *req =
+            &p_sys->uring_req[(p_sys->uring_head + i) % FILE_URING_DEPTH];
+
+        if (req->pending || req->done)
+            continue;
+
+        block_t *block = block_Alloc (FILE_URING_CHUNK);
+        if (unlikely(block == NULL))
+            break;
+
+        struct io_uring_sqe *sqe = io_uring_get_sqe (&p_sys->uring);
+        if (unlikely(sqe == NULL))
+        {
+            block_Release (block);
+            break;
+        }
+
+        io_uring_prep_read (sqe, p_sys->fd, block->p_buffer,
+                            FILE_URING_CHUNK, p_sys->uring_offset);
+        io_uring_sqe_set_data (sqe, req);
+        req->block = block;
+        req->offset = p_sys->uring_offset;
+        req->pending = true;
+        p_sys->uring_offset += FILE_URING_CHUNK;
+        queued++;
+    }
+
+    if (queued > 0)
+        io_uring_submit (&p_sys->uring);
+}
+
+/** Waits out all requests in flight and discards their data. */
+static void UringFlush (access_sys_t *p_sys)
+{
+    for (unsigned i = 0; i < FILE_URING_DEPTH; i++)
+    {
+        struct uring_req *req = &p_sys->uring_req[i];
+
+        while (req->pending)
+        {
+            struct io_uring_cqe *cqe;
+            int ret = io_uring_wait_cqe (&p_sys->uring, &cqe);
+
+            if (ret != 0)
+            {
+                if (ret == -EINTR)
+                    continue;
+                /* Cannot reap: the kernel still owns the buffer. */
+                req->block = NULL;
+                break;
+            }
+
+            struct uring_req *creq = io_uring_cqe_get_data (cqe);
+
+            creq->pending = false;
+            creq->done = true;
+            creq->res = cqe->res;
+            io_uring_cqe_seen (&p_sys->uring, cqe);
+        }
+
+        if (req->block != NULL)
+            block_Release (req->block);
+        req->block = NULL;
+        req->pending = req->done = false;
+    }
+    p_sys->uring_head = 0;
+}
+
+static block_t *UringBlock (stream_t *p_access, bool *restrict eof)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+    struct uring_req *req = &p_sys->uring_req[p_sys->uring_head];
+
+    UringSubmit (p_sys);
+
+    if (!req->pending && !req->done)
+    {   /* Nothing in flight: either the readahead reached the end of file,
+         * or a block could not be allocated (spurious NULL). */
+        *eof = p_sys->uring_eof;
+        return NULL;
+    }
+
+    for (;;)
+    {
+        UringReap (p_sys);
+        if (req->done)
+            break;
+
+        struct pollfd ufd = { .fd = p_sys->uring.ring_fd, .events = POLLIN };
+
+        if (vlc_poll_i11e (&ufd, 1, -1) < 0)
+            return NULL; /* interrupted */
+    }
+
+    block_t *block = req->block;
+    ssize_t val = req->res;
+
+    req->block = NULL;
+    req->done = false;
+    p_sys->uring_head = (p_sys->uring_head + 1) % FILE_URING_DEPTH;
+
+    if (val < 0)
+    {
+        block_Release (block);
+        if (val == -EINTR || val == -EAGAIN)
+        {   /* Requests past this one leave a gap: restart after it. */
+            UringFlush (p_sys);
+            p_sys->uring_offset = req->offset;
+            return NULL;
+        }
+
+        msg_Err (p_access, "read error: %s", vlc_strerror_c(-val));
+        *eof = true;
+        return NULL;
+    }
+
+    if (val == 0)
+    {
+        block_Release (block);
+        p_sys->uring_eof = true;
+        *eof = true;
+        return NULL;
+    }
+
+    block->i_buffer = val;
+    if ((size_t)val < FILE_URING_CHUNK)
+    {   /* Short read, presumably the end of file: requests in flight past
+         * this one leave a gap, so restart readahead after it. The file may
+         * still be growing, so do not latch the end of file yet. */
+        UringFlush (p_sys);
+        p_sys->uring_offset = req->offset + val;
+    }
+
+    return block;
+}
+
+static int UringSeek (stream_t *p_access, uint64_t i_pos)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    UringFlush (p_sys);
+    p_sys->uring_offset = i_pos;
+    p_sys->uring_eof = false;
+    return VLC_SUCCESS;
+}
+#endif /* HAVE_LIBURING */
+
 /*****************************************************************************
  * FileOpen: open the file
  *****************************************************************************/
@@ -213,12 +419,32 @@ int FileOpen( vlc_object_t *p_this )
     p_access->pf_control = FileControl;
     p_access->p_sys = p_sys;
     p_sys->fd = fd;
+#ifdef HAVE_LIBURING
+    p_sys->b_uring = false;
+#endif
 
     if (S_ISREG (st.st_mode) || S_ISBLK (st.st_mode))
     {
         p_access->pf_seek = FileSeek;
         p_sys->b_pace_control = true;
 
+#ifdef HAVE_LIBURING
+        p_sys->b_uring = S_ISREG (st.st_mode)
+            && io_uring_queue_init (FILE_URING_DEPTH, &p_sys->uring, 0) == 0;
+        if (p_sys->b_uring)
+        {
+            memset (p_sys->uring_req, 0, sizeof (p_sys->uring_req));
+            p_sys->uring_eof = false;
+            p_sys->uring_head = 0;
+            p_sys->uring_offset = 0;
+            p_access->pf_read = NULL;
+            p_access->pf_block = UringBlock;
+            p_access->pf_seek = UringSeek;
+            msg_Dbg (p_access, "using io_uring (%u requests in flight)",
+                     FILE_URING_DEPTH);
+        }
+#endif
+
         /* Demuxers will need the beginning of the file for probing. */
         posix_fadvise (fd, 0, 4096, POSIX_FADV_WILLNEED);
         /* In most cases, we only read the file once. */
@@ -253,7 +479,7 @@ void FileClose (vlc_object_t * p_this)
 {
     stream_t     *p_access = (stream_t*)p_this;
 
-    if (p_access->pf_read == NULL)
+    if (p_access->pf_readdir != NULL)
     {
         DirClose (p_this);
         return;
@@ -261,6 +487,13 @@ void FileClose (vlc_object_t * p_this)
 
     access_sys_t *p_sys = p_access->p_sys;
 
+#ifdef HAVE_LIBURING
+    if (p_sys->b_uring)
+    {
+        UringFlush (p_sys);
+        io_uring_queue_exit (&p_sys->uring);
+    }
+#endif
     vlc_close (p_sys->fd);
 }
 
@@ -299,6 +299,9 @@ vlc_module_begin()
         change_volatile()
     add_bool("http-forward-cookies", true, N_("Cookies forwarding"),
              N_("Forward cookies across HTTP redirections."), true)
+    add_bool("http-conn-share", false, N_("Connection sharing"),
+             N_("Reuse HTTP(S) connections and TLS sessions "
+                "across inputs."), true)
     add_string("http-referrer", NULL, N_("Referrer"),
                N_("Provide the referral URL, i.e. HTTP \"Referer\" (sic)."),
                true)
@@ -25,6 +25,7 @@
 #include <assert.h>
 #include <vlc_common.h>
 #include <vlc_network.h>
+#include <vlc_strings.h>
 #include <vlc_tls.h>
 #include <vlc_url.h>
 #include "transport.h"
@@ -98,8 +99,196 @@ struct vlc_http_mgr
     vlc_tls_creds_t *creds;
     struct vlc_http_cookie_jar_t *jar;
     struct vlc_http_conn *conn;
+    char *host; /**< Origin host name of the connection (or NULL) */
+    unsigned port; /**< Origin port number of the connection */
+    bool https; /**< Whether the connection is encrypted */
+    bool share; /**< Whether to share connections across managers */
 };
 
+/*
+ * Optional process-wide connection pool
+ *
+ * With the "http-conn-share" option, a manager donates its idle connection to
+ * a process-wide pool on destruction, and adopts a pooled connection to the
+ * same origin instead of opening a new one. Playlist-driven use cases thus
+ * skip the TCP and TLS handshakes when consecutive items point to the same
+ * origin. X.509 credentials are likewise shared, so the TLS back-end can
+ * resume sessions across items. The pool is flushed when the last sharing
+ * manager goes away, lest connections outlive the use of the plugin.
+ */
+
+#define VLC_HTTP_POOL_SIZE 8 /* Maximum pooled connections */
+#define VLC_HTTP_POOL_TTL VLC_TICK_FROM_SEC(60) /* Pooled connection lifetime */
+
+struct vlc_http_pool_conn
+{
+    struct vlc_http_pool_conn *next;
+    char *host;
+    unsigned port;
+    bool https;
+    vlc_tick_t date; /**< Time of donation */
+    struct vlc_http_conn *conn;
+};
+
+static vlc_mutex_t vlc_http_pool_lock = VLC_STATIC_MUTEX;
+static struct vlc_http_pool_conn *vlc_http_pool = NULL;
+static unsigned vlc_http_pool_count = 0;
+static unsigned vlc_http_pool_users = 0;
+static vlc_tls_creds_t *vlc_http_pool_creds = NULL;
+static unsigned vlc_http_pool_creds_refs = 0;
+
+/** Acquires the shared TLS credentials. The pool lock must be held. */
+static vlc_tls_creds_t *vlc_http_creds_hold(vlc_object_t *obj)
+{
+    if (vlc_http_pool_creds == NULL)
+    {
+        /* The credentials can outlive obj: parent them to the root object. */
+        vlc_http_pool_creds =
+            vlc_tls_ClientCreate(VLC_OBJECT(obj->obj.libvlc));
+        if (vlc_http_pool_creds == NULL)
+            return NULL;
+    }
+    vlc_http_pool_creds_refs++;
+    return vlc_http_pool_creds;
+}
+
+/** Releases the shared TLS credentials. The pool lock must be held. */
+static void vlc_http_creds_release(void)
+{
+    assert(vlc_http_pool_creds_refs > 0);
+    if (--vlc_http_pool_creds_refs == 0)
+    {
+        vlc_tls_Delete(vlc_http_pool_creds);
+        vlc_http_pool_creds = NULL;
+    }
+}
+
+/**
+ * Unlinks expired and excess pool entries.
+ *
+ * The pool lock must be held. The returned entries must be disposed of with
+ * vlc_http_pool_dispose() after the lock is released.
+ */
+static struct vlc_http_pool_conn *vlc_http_pool_trim(vlc_tick_t now)
+{
+    struct vlc_http_pool_conn *doomed = NULL;
+    struct vlc_http_pool_conn **pp = &vlc_http_pool;
+    unsigned count = 0;
+
+    while (*pp != NULL)
+    {
+        struct vlc_http_pool_conn *e = *pp;
+
+        if (count >= VLC_HTTP_POOL_SIZE || (now - e->date) > VLC_HTTP_POOL_TTL)
+        {
+            *pp = e->next;
+            e->next = doomed;
+            doomed = e;
+        }
+        else
+        {
+            count++;
+            pp = &e->next;
+        }
+    }
+    vlc_http_pool_count = count;
+    return doomed;
+}
+
+/** Destroys unlinked pool entries. The pool lock must NOT be held. */
+static void vlc_http_pool_dispose(struct vlc_http_pool_conn *list)
+{
+    unsigned https = 0;
+
+    if (list == NULL)
+        return;
+
+    for (struct vlc_http_pool_conn *e = list, *next; e != NULL; e = next)
+    {
+        next = e->next;
+        https += e->https;
+        vlc_http_conn_release(e->conn);
+        free(e->host);
+        free(e);
+    }
+
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    while (https-- > 0)
+        vlc_http_creds_release();
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+}
+
+/** Adopts a pooled connection to the given origin, if any. */
+static struct vlc_http_conn *vlc_http_pool_take(const char *host,
+                                                unsigned port, bool https)
+{
+    struct vlc_http_conn *conn = NULL;
+    struct vlc_http_pool_conn *doomed;
+
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    doomed = vlc_http_pool_trim(vlc_tick_now());
+
+    for (struct vlc_http_pool_conn **pp = &vlc_http_pool;
+         *pp != NULL;
+         pp = &(*pp)->next)
+    {
+        struct vlc_http_pool_conn *e = *pp;
+
+        if (e->https == https && e->port == port
+         && !vlc_ascii_strcasecmp(e->host, host))
+        {
+            *pp = e->next;
+            vlc_http_pool_count--;
+            conn = e->conn;
+            if (e->https)
+                /* The adopting manager holds its own credentials reference */
+                vlc_http_creds_release();
+            free(e->host);
+            free(e);
+            break;
+        }
+    }
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+
+    vlc_http_pool_dispose(doomed);
+    return conn;
+}
+
+/** Donates an idle connection to the pool. */
+static int vlc_http_pool_donate(const char *host, unsigned port, bool https,
+                                struct vlc_http_conn *conn)
+{
+    struct vlc_http_pool_conn *doomed;
+    struct vlc_http_pool_conn *e = malloc(sizeof (*e));
+
+    if (unlikely(e == NULL))
+        return -1;
+
+    e->host = strdup(host);
+    if (unlikely(e->host == NULL))
+    {
+        free(e);
+        return -1;
+    }
+    e->port = port;
+    e->https = https;
+    e->date = vlc_tick_now();
+    e->conn = conn;
+
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    if (https)
+        /* The donating manager still holds a reference at this point */
+        vlc_http_pool_creds_refs++;
+    e->next = vlc_http_pool;
+    vlc_http_pool = e;
+    vlc_http_pool_count++;
+    doomed = vlc_http_pool_trim(e->date);
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+
+    vlc_http_pool_dispose(doomed);
+    return 0;
+}
+
 static struct vlc_http_conn *vlc_http_mgr_find(struct vlc_http_mgr *mgr,
                                                const char *host, unsigned port)
 {
@@ -112,10 +301,35 @@ static void vlc_http_mgr_release(struct vlc_http_mgr *mgr,
 {
     assert(mgr->conn == conn);
     mgr->conn = NULL;
+    free(mgr->host);
+    mgr->host = NULL;
 
     vlc_http_conn_release(conn);
 }
 
+/** Records the connection and the origin it serves */
+static void vlc_http_mgr_attach(struct vlc_http_mgr *mgr,
+                                struct vlc_http_conn *conn,
+                                const char *host, unsigned port, bool https)
+{
+    assert(mgr->conn == NULL);
+    mgr->conn = conn;
+    mgr->host = strdup(host); /* on failure, the connection is not donatable */
+    mgr->port = port;
+    mgr->https = https;
+}
+
+/**
+ * Context for new connections.
+ *
+ * Shared connections can outlive the manager and its parent object, so they
+ * log through the root object instead.
+ */
+static vlc_object_t *vlc_http_mgr_context(struct vlc_http_mgr *mgr)
+{
+    return mgr->share ? VLC_OBJECT(mgr->obj->obj.libvlc) : mgr->obj;
+}
+
 static
 struct vlc_http_msg *vlc_http_mgr_reuse(struct vlc_http_mgr *mgr,
                                         const char *host, unsigned port,
@@ -154,7 +368,14 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
 
     if (mgr->creds == NULL)
     {   /* First TLS connection: load x509 credentials */
-        mgr->creds = vlc_tls_ClientCreate(mgr->obj);
+        if (mgr->share)
+        {
+            vlc_mutex_lock(&vlc_http_pool_lock);
+            mgr->creds = vlc_http_creds_hold(mgr->obj);
+            vlc_mutex_unlock(&vlc_http_pool_lock);
+        }
+        else
+            mgr->creds = vlc_tls_ClientCreate(mgr->obj);
         if (mgr->creds == NULL)
             return NULL;
     }
@@ -164,6 +385,20 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
     if (resp != NULL)
         return resp; /* existing connection reused */
 
+    if (mgr->share && mgr->conn == NULL)
+    {
+        struct vlc_http_conn *pooled = vlc_http_pool_take(host, port, true);
+        if (pooled != NULL)
+        {
+            vlc_http_dbg(mgr->obj, "reusing pooled connection to %s", host);
+            vlc_http_mgr_attach(mgr, pooled, host, port, true);
+            resp = vlc_http_mgr_reuse(mgr, host, port, req);
+            if (resp != NULL)
+                return resp;
+            /* Stale pooled connection (already released): connect anew */
+        }
+    }
+
     char *proxy = vlc_http_proxy_find(host, port, true);
     if (proxy != NULL)
     {
@@ -187,9 +422,9 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
      * NOTE: We do not enforce TLS version 1.2 for HTTP 2.0 explicitly.
      */
     if (http2)
-        conn = vlc_h2_conn_create(mgr->obj, tls);
+        conn = vlc_h2_conn_create(vlc_http_mgr_context(mgr), tls);
     else
-        conn = vlc_h1_conn_create(mgr->obj, tls, false);
+        conn = vlc_h1_conn_create(vlc_http_mgr_context(mgr), tls, false);
 
     if (unlikely(conn == NULL))
     {
@@ -197,7 +432,7 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
         return NULL;
     }
 
-    mgr->conn = conn;
+    vlc_http_mgr_attach(mgr, conn, host, port, true);
 
     return vlc_http_mgr_reuse(mgr, host, port, req);
 }
@@ -213,6 +448,20 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
     if (resp != NULL)
         return resp;
 
+    if (mgr->share && mgr->conn == NULL)
+    {
+        struct vlc_http_conn *pooled = vlc_http_pool_take(host, port, false);
+        if (pooled != NULL)
+        {
+            vlc_http_dbg(mgr->obj, "reusing pooled connection to %s", host);
+            vlc_http_mgr_attach(mgr, pooled, host, port, false);
+            resp = vlc_http_mgr_reuse(mgr, host, port, req);
+            if (resp != NULL)
+                return resp;
+            /* Stale pooled connection (already released): connect anew */
+        }
+    }
+
     struct vlc_http_conn *conn;
     struct vlc_http_stream *stream;
 
@@ -225,7 +474,7 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
         free(proxy);
 
         if (url.psz_host != NULL)
-            stream = vlc_h1_request(mgr->obj, url.psz_host,
+            stream = vlc_h1_request(vlc_http_mgr_context(mgr), url.psz_host,
                                     url.i_port ? url.i_port : 80, true, req,
                                     true, &conn);
         else
@@ -234,8 +483,8 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
         vlc_UrlClean(&url);
     }
     else
-        stream = vlc_h1_request(mgr->obj, host, port ? port : 80, false, req,
-                                true, &conn);
+        stream = vlc_h1_request(vlc_http_mgr_context(mgr), host,
+                                port ? port : 80, false, req, true, &conn);
 
     if (stream == NULL)
         return NULL;
@@ -247,7 +496,7 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
         return NULL;
     }
 
-    mgr->conn = conn;
+    vlc_http_mgr_attach(mgr, conn, host, port, false);
     return resp;
 }
 
@@ -274,14 +523,61 @@ struct vlc_http_mgr *vlc_http_mgr_create(vlc_object_t *obj,
     mgr->creds = NULL;
     mgr->jar = jar;
     mgr->conn = NULL;
+    mgr->host = NULL;
+    mgr->port = 0;
+    mgr->https = false;
+    mgr->share = var_InheritBool(obj, "http-conn-share");
+
+    if (mgr->share)
+    {
+        vlc_mutex_lock(&vlc_http_pool_lock);
+        vlc_http_pool_users++;
+        vlc_mutex_unlock(&vlc_http_pool_lock);
+    }
     return mgr;
 }
 
 void vlc_http_mgr_destroy(struct vlc_http_mgr *mgr)
 {
     if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
+    {
+        if (mgr->share && mgr->host != NULL
+         && vlc_http_pool_donate(mgr->host, mgr->port, mgr->https,
+                                 mgr->conn) == 0)
+        {
+            mgr->conn = NULL;
+            free(mgr->host);
+            mgr->host = NULL;
+        }
+        else
+            vlc_http_mgr_release(mgr, mgr->conn);
+    }
+
     if (mgr->creds != NULL)
-        vlc_tls_Delete(mgr->creds);
+    {
+        if (mgr->share)
+        {
+            vlc_mutex_lock(&vlc_http_pool_lock);
+            vlc_http_creds_release();
+            vlc_mutex_unlock(&vlc_http_pool_lock);
+        }
+        else
+            vlc_tls_Delete(mgr->creds);
+    }
+
+    if (mgr->share)
+    {   /* Flush the pool along with its last user */
+        struct vlc_http_pool_conn *doomed = NULL;
+
+        vlc_mutex_lock(&vlc_http_pool_lock);
+        if (--vlc_http_pool_users == 0)
+        {
+            doomed = vlc_http_pool;
+            vlc_http_pool = NULL;
+            vlc_http_pool_count = 0;
+        }
+        vlc_mutex_unlock(&vlc_http_pool_lock);
+        vlc_http_pool_dispose(doomed);
+    }
     free(mgr);
 }
@@ -56,6 +56,11 @@ struct vlc_h2_conn
     uint32_t next_id; /**< Next free stream identifier */
     bool released; /**< Connection released by owner */
 
+    vlc_tick_t rtt; /**< Smoothed round-trip time (zero if unknown) */
+    vlc_tick_t rtt_date; /**< Time of last completed round-trip probe */
+    vlc_tick_t ping_date; /**< Time of round-trip probe in flight (or
+                               VLC_TICK_INVALID if none) */
+
     vlc_mutex_t lock; /**< State machine lock */
     vlc_thread_t thread; /**< Receive thread */
 };
@@ -77,6 +82,9 @@ struct vlc_h2_stream
     struct vlc_http_msg *recv_hdr; /**< Latest received headers (or NULL) */
 
     size_t recv_cwnd; /**< Free space in receive congestion window */
+    size_t recv_wnd; /**< Receive congestion window size */
+    uint64_t recv_rate_bytes; /**< Bytes delivered since the last resizing */
+    vlc_tick_t recv_rate_date; /**< Time of the last window resizing */
     struct vlc_h2_frame *recv_head; /**< Earliest pending received buffer */
     struct vlc_h2_frame **recv_tailp; /**< Tail of receive queue */
     vlc_cond_t recv_wait;
@@ -95,6 +103,28 @@ static int vlc_h2_conn_queue_prio(struct vlc_h2_conn *conn,
     return vlc_h2_output_send_prio(conn->out, f);
 }
 
+/**
+ * Samples the connection round-trip time.
+ *
+ * Sends a PING frame carrying the current time stamp, unless a probe is
+ * already in flight or the estimate is fresh enough. The matching PING
+ * acknowledgement updates the smoothed estimate (vlc_h2_pong()).
+ *
+ * @note The connection lock must be held.
+ */
+static void vlc_h2_rtt_probe(struct vlc_h2_conn *conn)
+{
+    vlc_tick_t now = vlc_tick_now();
+
+    if (conn->ping_date != VLC_TICK_INVALID)
+        return; /* probe in flight */
+    if (conn->rtt != 0 && (now - conn->rtt_date) < CLOCK_FREQ)
+        return; /* recent estimate */
+
+    if (vlc_h2_conn_queue_prio(conn, vlc_h2_frame_ping(now)) == 0)
+        conn->ping_date = now;
+}
+
 
 /* Stream callbacks */
 
@@ -302,9 +332,38 @@ static block_t *vlc_h2_stream_read(struct vlc_http_stream *stream)
         s->recv_tailp = &s->recv_head;
     }
 
+    size_t datalen;
+    vlc_h2_frame_data_get(f, &datalen);
+
+    /* Auto-tune the receive window to twice the amount of data delivered per
+     * round-trip time (as TCP receive buffer auto-tuning does), so that a
+     * single stream is not window-limited on long fat paths. The window never
+     * shrinks; it is bounded by VLC_H2_MAX_WINDOW. */
+    vlc_h2_rtt_probe(conn);
+    s->recv_rate_bytes += datalen;
+
+    vlc_tick_t rtt = conn->rtt;
+    vlc_tick_t now = vlc_tick_now();
+
+    if (s->recv_rate_date == VLC_TICK_INVALID)
+        s->recv_rate_date = now;
+    else if (rtt != 0 && (now - s->recv_rate_date) >= rtt)
+    {
+        uint64_t wnd = 2 * ((s->recv_rate_bytes * rtt)
+                            / (now - s->recv_rate_date));
+
+        if (wnd > VLC_H2_MAX_WINDOW)
+            wnd = VLC_H2_MAX_WINDOW;
+        if (wnd > s->recv_wnd)
+            s->recv_wnd = wnd;
+
+        s->recv_rate_bytes = 0;
+        s->recv_rate_date = now;
+    }
+
     /* Credit the receive window if missing credit exceeds 50%. */
-    uint_fast32_t credit = VLC_H2_INIT_WINDOW - s->recv_cwnd;
-    if (credit >= (VLC_H2_INIT_WINDOW / 2)
+    uint_fast32_t credit = s->recv_wnd - s->recv_cwnd;
+    if (credit >= (s->recv_wnd / 2)
      && !vlc_h2_conn_queue(conn, vlc_h2_frame_window_update(s->id, credit)))
         s->recv_cwnd += credit;
 
@@ -412,6 +471,9 @@ static struct vlc_http_stream *vlc_h2_stream_open(struct vlc_http_conn *c,
     s->recv_err = 0;
     s->recv_hdr = NULL;
     s->recv_cwnd = VLC_H2_INIT_WINDOW;
+    s->recv_wnd = VLC_H2_INIT_WINDOW;
+    s->recv_rate_bytes = 0;
+    s->recv_rate_date = VLC_TICK_INVALID;
     s->recv_head = NULL;
     s->recv_tailp = &s->recv_head;
     vlc_cond_init(&s->recv_wait);
@@ -475,6 +537,24 @@ static int vlc_h2_ping(void *ctx, uint_fast64_t opaque)
     return vlc_h2_conn_queue_prio(conn, vlc_h2_frame_pong(opaque));
 }
 
+/** Reports a ping acknowledged by HTTP/2 peer */
+static int vlc_h2_pong(void *ctx, uint_fast64_t opaque)
+{
+    struct vlc_h2_conn *conn = ctx;
+    vlc_tick_t now = vlc_tick_now();
+
+    if (conn->ping_date == VLC_TICK_INVALID
+     || (vlc_tick_t)opaque != conn->ping_date)
+        return 0; /* not a round-trip probe of ours */
+
+    vlc_tick_t rtt = now - conn->ping_date;
+
+    conn->rtt = (conn->rtt != 0) ? (conn->rtt * 7 + rtt) / 8 : rtt;
+    conn->rtt_date = now;
+    conn->ping_date = VLC_TICK_INVALID;
+    return 0;
+}
+
 /** Reports a local HTTP/2 connection failure */
 static void vlc_h2_error(void *ctx, uint_fast32_t code)
 {
@@ -531,6 +611,7 @@ static const struct vlc_h2_parser_cbs vlc_h2_parser_callbacks =
     vlc_h2_setting,
     vlc_h2_settings_done,
     vlc_h2_ping,
+    vlc_h2_pong,
     vlc_h2_error,
     vlc_h2_reset,
     vlc_h2_window_status,
@@ -729,6 +810,9 @@ struct vlc_http_conn *vlc_h2_conn_create(void *ctx, struct vlc_tls *tls)
     conn->streams = NULL;
     conn->next_id = 1; /* TODO: server side */
     conn->released = false;
+    conn->rtt = 0;
+    conn->rtt_date = VLC_TICK_INVALID;
+    conn->ping_date = VLC_TICK_INVALID;
 
     if (unlikely(conn->out == NULL))
         goto error;
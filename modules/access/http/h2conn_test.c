@@ -70,9 +70,10 @@ static void conn_expect(uint_fast8_t wanted)
         assert(val == 9);
         assert(hdr[0] == 0);
 
-        /* Check type. We do not currently validate WINDOW_UPDATE. */
+        /* Check type. We do not currently validate WINDOW_UPDATE, nor PING
+         * round-trip time probes. */
         got = hdr[3];
-        assert(wanted == got || WINDOW_UPDATE == got);
+        assert(wanted == got || WINDOW_UPDATE == got || PING == got);
 
         len = (hdr[1] << 8) | hdr[2];
         if (len > 0)
@@ -88,6 +88,7 @@ const char *vlc_h2_setting_name(uint_fast16_t);
 #define VLC_H2_MAX_HEADER_TABLE   4096 /* Header (compression) table size */
 #define VLC_H2_MAX_STREAMS           0 /* Concurrent peer-initiated streams */
 #define VLC_H2_INIT_WINDOW     1048575 /* Initial congestion window size */
+#define VLC_H2_MAX_WINDOW     67108863 /* Maximum (auto-tuned) window size */
 #define VLC_H2_MAX_FRAME       1048576 /* Frame size */
 #define VLC_H2_MAX_HEADER_LIST   65536 /* Header (decompressed) list size */
 
@@ -102,6 +103,7 @@ struct vlc_h2_parser_cbs
     void (*setting)(void *ctx, uint_fast16_t id, uint_fast32_t value);
     int  (*settings_done)(void *ctx);
     int  (*ping)(void *ctx, uint_fast64_t opaque);
+    int  (*pong)(void *ctx, uint_fast64_t opaque);
     void (*error)(void *ctx, uint_fast32_t code);
     int  (*reset)(void *ctx, uint_fast32_t last_seq, uint_fast32_t code);
     void (*window_status)(void *ctx, uint32_t *rcwd);
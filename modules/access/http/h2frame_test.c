@@ -105,6 +105,18 @@ static int vlc_h2_ping(void *ctx, uint_fast64_t opaque)
     return 0;
 }
 
+#define PONG_VALUE UINT64_C(42)
+
+static unsigned pongs;
+
+static int vlc_h2_pong(void *ctx, uint_fast64_t opaque)
+{
+    assert(ctx == CTX);
+    assert(opaque == PONG_VALUE);
+    pongs++;
+    return 0;
+}
+
 static uint_fast32_t remote_error;
 
 static void vlc_h2_error(void *ctx, uint_fast32_t code)
@@ -312,6 +324,7 @@ static const struct vlc_h2_parser_cbs vlc_h2_frame_test_callbacks =
     vlc_h2_setting,
     vlc_h2_settings_done,
     vlc_h2_ping,
+    vlc_h2_pong,
     vlc_h2_error,
     vlc_h2_reset,
     vlc_h2_window_status,
@@ -330,7 +343,7 @@ static unsigned test_seq(void *ctx, ...)
     unsigned i;
 
     settings = settings_acked = 0;
-    pings = 0;
+    pings = pongs = 0;
     remote_error = -1;
     stream_header_tables = stream_blocks = stream_ends = 0;
 
@@ -408,9 +421,10 @@ int main(void)
     ret = test_seq(CTX, NULL);
     assert(ret == 0);
 
-    ret = test_seq(CTX, ping(), vlc_h2_frame_pong(42), ping(), NULL);
+    ret = test_seq(CTX, ping(), vlc_h2_frame_pong(PONG_VALUE), ping(), NULL);
     assert(ret == 3);
     assert(pings == 2);
+    assert(pongs == 1);
     assert(stream_header_tables == 0);
     assert(stream_blocks == 0);
     assert(stream_ends == 0);
@@ -37,6 +37,8 @@
 #include "h2output.h"
 
 #define VLC_H2_MAX_QUEUE (1u << 24)
+/** Maximum number of frames coalesced into a single send */
+#define VLC_H2_MAX_BATCH 16u
 
 struct vlc_h2_queue
 {
@@ -122,25 +124,41 @@ int vlc_h2_output_send(struct vlc_h2_output *out, struct vlc_h2_frame *f)
     return vlc_h2_output_queue(out, &out->queue, f);
 }
 
-/** Dequeues one outgoing HTTP/2. */
+/** Pops up to *room frames off the head of a queue. */
+static struct vlc_h2_frame *vlc_h2_queue_pop(struct vlc_h2_queue *q,
+                                             unsigned *restrict room,
+                                             size_t *restrict lenp)
+{
+    struct vlc_h2_frame *first = q->first;
+    struct vlc_h2_frame **lastp = &q->first;
+
+    while (*lastp != NULL && *room > 0)
+    {
+        *lenp += vlc_h2_frame_size(*lastp);
+        (*room)--;
+        lastp = &(*lastp)->next;
+    }
+
+    struct vlc_h2_frame *rem = *lastp;
+
+    *lastp = NULL;
+    q->first = rem;
+    if (rem == NULL)
+        q->last = &q->first;
+    return first;
+}
+
+/** Dequeues a batch of consecutive outgoing HTTP/2 frames. */
 static struct vlc_h2_frame *vlc_h2_output_dequeue(struct vlc_h2_output *out)
 {
-    struct vlc_h2_queue *q;
-    struct vlc_h2_frame *frame;
-    size_t len;
+    struct vlc_h2_frame *first;
+    unsigned room = VLC_H2_MAX_BATCH;
+    size_t len = 0;
 
     vlc_mutex_lock(&out->lock);
 
-    for (;;)
+    while (out->prio.first == NULL && out->queue.first == NULL)
     {
-        q = &out->prio;
-        if (q->first != NULL)
-            break;
-
-        q = &out->queue;
-        if (q->first != NULL)
-            break;
-
         if (unlikely(out->closing))
         {
             vlc_mutex_unlock(&out->lock);
@@ -152,23 +170,24 @@ static struct vlc_h2_frame *vlc_h2_output_dequeue(struct vlc_h2_output *out)
         vlc_restorecancel(canc);
     }
 
-    frame = q->first;
-    q->first = frame->next;
-    if (frame->next == NULL)
+    /* Coalesce consecutive frames into one batch, priority queue first, so
+     * that small control frames (SETTINGS, PING, WINDOW_UPDATE) share a
+     * single TLS record and TCP segment with whatever else is pending. */
+    first = vlc_h2_queue_pop(&out->prio, &room, &len);
+    if (room > 0)
     {
-        assert(q->last == &frame->next);
-        q->last = &q->first;
+        struct vlc_h2_frame **tailp = &first;
+
+        while (*tailp != NULL)
+            tailp = &(*tailp)->next;
+        *tailp = vlc_h2_queue_pop(&out->queue, &room, &len);
     }
-    assert(q->last != &frame->next);
 
-    len = vlc_h2_frame_size(frame);
     assert(out->size >= len);
     out->size -= len;
 
     vlc_mutex_unlock(&out->lock);
-
-    frame->next = NULL;
-    return frame;
+    return first;
 }
 
 static void vlc_h2_output_flush_unlocked(struct vlc_h2_output *out)
@@ -190,29 +209,38 @@ static void vlc_h2_output_flush_unlocked(struct vlc_h2_output *out)
  * @note This may be a cancellation point.
  * The caller is responsible for serializing writes on a given connection.
  */
-static ssize_t vlc_https_send(vlc_tls_t *tls, const void *buf, size_t len)
+static ssize_t vlc_https_sendv(vlc_tls_t *tls, struct iovec *iov,
+                               unsigned iovlen)
 {
     struct pollfd ufd;
-    struct iovec iov;
     size_t count = 0;
 
     ufd.fd = vlc_tls_GetFD(tls);
     ufd.events = POLLOUT;
-    iov.iov_base = (void *)buf;
-    iov.iov_len = len;
 
-    while (count < len)
+    while (iovlen > 0)
     {
         int canc = vlc_savecancel();
-        ssize_t val = tls->ops->writev(tls, &iov, 1);
+        ssize_t val = tls->ops->writev(tls, iov, iovlen);
 
         vlc_restorecancel(canc);
 
         if (val > 0)
         {
-            iov.iov_base = (char *)iov.iov_base + val;
-            iov.iov_len -= val;
             count += val;
+
+            while (iovlen > 0 && (size_t)val >= iov->iov_len)
+            {
+                val -= iov->iov_len;
+                iov++;
+                iovlen--;
+            }
+
+            if (iovlen > 0)
+            {
+                iov->iov_base = (char *)iov->iov_base + val;
+                iov->iov_len -= val;
+            }
             continue;
         }
 
@@ -228,11 +256,28 @@ static ssize_t vlc_https_send(vlc_tls_t *tls, const void *buf, size_t len)
     return count;
 }
 
+static ssize_t vlc_https_send(vlc_tls_t *tls, const void *buf, size_t len)
+{
+    struct iovec iov = { .iov_base = (void *)buf, .iov_len = len, };
+
+    return vlc_https_sendv(tls, &iov, 1);
+}
+
+static void vlc_h2_frame_chain_free(void *data)
+{
+    for (struct vlc_h2_frame *f = data, *next; f != NULL; f = next)
+    {
+        next = f->next;
+        free(f);
+    }
+}
+
 /**
- * Sends one HTTP/2 frame through TLS.
+ * Sends a chain of HTTP/2 frames through TLS.
  *
- * This function sends a whole HTTP/2 frame through a TLS session, then
- * releases the memory used by the frame.
+ * This function sends a batch of whole HTTP/2 frames through a TLS session
+ * with a single (vectored) write if possible, then releases the memory used
+ * by the frames.
  *
  * The caller must "own" the write side of the TLS session.
  *
@@ -242,13 +287,24 @@ static ssize_t vlc_https_send(vlc_tls_t *tls, const void *buf, size_t len)
  */
 static int vlc_h2_frame_send(struct vlc_tls *tls, struct vlc_h2_frame *f)
 {
-    size_t len = vlc_h2_frame_size(f);
+    struct iovec iov[VLC_H2_MAX_BATCH];
+    unsigned count = 0;
+    size_t len = 0;
     ssize_t val;
 
-    vlc_cleanup_push(free, f);
-    val = vlc_https_send(tls, f->data, len);
+    for (struct vlc_h2_frame *n = f; n != NULL; n = n->next)
+    {
+        assert(count < VLC_H2_MAX_BATCH);
+        iov[count].iov_base = n->data;
+        iov[count].iov_len = vlc_h2_frame_size(n);
+        len += iov[count].iov_len;
+        count++;
+    }
+
+    vlc_cleanup_push(vlc_h2_frame_chain_free, f);
+    val = vlc_https_sendv(tls, iov, count);
     vlc_cleanup_pop();
-    free(f);
+    vlc_h2_frame_chain_free(f);
 
     return ((size_t)val == len) ? 0 : -1;
 }
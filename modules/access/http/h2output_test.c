@@ -50,37 +50,51 @@ static int fd_callback(vlc_tls_t *tls)
 static ssize_t send_callback(vlc_tls_t *tls, const struct iovec *iov,
                              unsigned count)
 {
-    assert(count == 1);
-    assert(tls->ops->writev == send_callback);
+    size_t total = 0;
 
-    const uint8_t *p = iov->iov_base;
-    size_t len = iov->iov_len;
+    assert(count >= 1);
+    assert(tls->ops->writev == send_callback);
 
-    if (expect_hello)
+    for (unsigned i = 0; i < count; i++)
     {
-        assert(len >= 24);
-        assert(!memcmp(p, "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", 24));
+        const uint8_t *p = iov[i].iov_base;
+        size_t len = iov[i].iov_len;
 
-        expect_hello = false;
-        vlc_sem_post(&rx);
+        if (expect_hello)
+        {
+            assert(len >= 24);
+            assert(!memcmp(p, "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n", 24));
 
-        if (len == 24)
-            return send_failure ? -1 : (ssize_t)len;
+            expect_hello = false;
+            vlc_sem_post(&rx);
 
-        p += 24;
-        len -= 24;
-    }
+            if (send_failure)
+                return -1;
+
+            total += 24;
+            if (len == 24)
+                continue;
 
-    assert(len == 9 + 1);
-    assert(p[9] == counter);
+            p += 24;
+            len -= 24;
+        }
+
+        assert(len == 9 + 1);
+        assert(p[9] == counter);
+
+        if (send_failure)
+        {
+            errno = EIO;
+            vlc_sem_post(&rx);
+            return total ? (ssize_t)total : -1;
+        }
 
-    if (send_failure)
-        errno = EIO;
-    else
         counter++;
-    vlc_sem_post(&rx);
+        vlc_sem_post(&rx);
+        total += len;
+    }
 
-    return send_failure ? -1 : (ssize_t)len;
+    return total;
 }
 
 static const struct vlc_tls_operations fake_ops =
@@ -59,6 +59,10 @@ static void Close( vlc_object_t * );
 #define BUFFER_TEXT N_("Receive buffer")
 #define BUFFER_LONGTEXT N_("UDP receive buffer size (bytes)" )
 #define TIMEOUT_TEXT N_("UDP Source timeout (sec)")
+#define BUSYPOLL_TEXT N_("Busy-poll budget (µs)")
+#define BUSYPOLL_LONGTEXT N_("Time in microseconds the kernel may poll " \
+    "the network device queue for new datagrams before sleeping " \
+    "(0 = disabled). This lowers receive latency at the cost of CPU time.")
 
 vlc_module_begin ()
     set_shortname( N_("UDP" ) )
@@ -69,6 +73,7 @@ vlc_module_begin ()
     add_obsolete_integer( "server-port" ) /* since 2.0.0 */
     add_obsolete_integer( "udp-buffer" ) /* since 3.0.0 */
     add_integer( "udp-timeout", -1, TIMEOUT_TEXT, NULL, true )
+    add_integer( "udp-busy-poll", 0, BUSYPOLL_TEXT, BUSYPOLL_LONGTEXT, true )
 
     set_capability( "access", 0 )
     add_shortcut( "udp", "udpstream", "udp4", "udp6" )
@@ -76,11 +81,21 @@ vlc_module_begin ()
     set_callbacks( Open, Close )
 vlc_module_end ()
 
+#ifdef HAVE_RECVMMSG
+/** Maximum number of datagrams received per system call */
+# define UDP_BATCH_SIZE 32
+#endif
+
 typedef struct
 {
     int fd;
     int timeout;
     size_t mtu;
+#ifdef HAVE_RECVMMSG
+    block_t *queue; /*< Datagrams received ahead by the last batch */
+    block_t **queue_end;
+    block_t *batch[UDP_BATCH_SIZE]; /*< Preallocated receive blocks */
+#endif
 } access_sys_t;
 
 /*****************************************************************************
@@ -174,6 +189,20 @@ static int Open( vlc_object_t *p_this )
     if( sys->timeout > 0)
         sys->timeout *= 1000;
 
+#ifdef SO_BUSY_POLL
+    int64_t busy = var_InheritInteger( p_access, "udp-busy-poll" );
+    if( busy > 0 )
+        setsockopt( sys->fd, SOL_SOCKET, SO_BUSY_POLL,
+                    &(int){ busy }, sizeof (int) );
+#endif
+
+#ifdef HAVE_RECVMMSG
+    sys->queue = NULL;
+    sys->queue_end = &sys->queue;
+    for( size_t i = 0; i < UDP_BATCH_SIZE; i++ )
+        sys->batch[i] = NULL;
+#endif
+
     return VLC_SUCCESS;
 }
 
@@ -185,6 +214,12 @@ static void Close( vlc_object_t *p_this )
     stream_t     *p_access = (stream_t*)p_this;
     access_sys_t *sys = p_access->p_sys;
 
+#ifdef HAVE_RECVMMSG
+    block_ChainRelease( sys->queue );
+    for( size_t i = 0; i < UDP_BATCH_SIZE; i++ )
+        if( sys->batch[i] != NULL )
+            block_Release( sys->batch[i] );
+#endif
     net_Close( sys->fd );
 }
 
@@ -219,10 +254,115 @@ static int Control( stream_t *p_access, int i_query, va_list args )
 /*****************************************************************************
  * BlockUDP:
  *****************************************************************************/
+#ifdef HAVE_RECVMMSG
+/** Pops one datagram off the head of the receive queue. */
+static block_t *BlockPop(access_sys_t *sys)
+{
+    block_t *pkt = sys->queue;
+
+    if (pkt != NULL)
+    {
+        sys->queue = pkt->p_next;
+        if (sys->queue == NULL)
+            sys->queue_end = &sys->queue;
+        pkt->p_next = NULL;
+    }
+    return pkt;
+}
+#endif
+
 static block_t *BlockUDP(stream_t *access, bool *restrict eof)
 {
     access_sys_t *sys = access->p_sys;
 
+#ifdef HAVE_RECVMMSG
+    block_t *pkt = BlockPop(sys);
+    if (pkt != NULL)
+        return pkt;
+#endif
+
+    struct pollfd ufd[1];
+
+    ufd[0].fd = sys->fd;
+    ufd[0].events = POLLIN;
+
+    switch (vlc_poll_i11e(ufd, 1, sys->timeout))
+    {
+        case 0:
+            msg_Err(access, "receive time-out");
+            *eof = true;
+            /* fall through */
+        case -1:
+            return NULL;
+     }
+
+#ifdef HAVE_RECVMMSG
+    struct mmsghdr msgs[UDP_BATCH_SIZE];
+    struct iovec iovecs[UDP_BATCH_SIZE];
+    unsigned n = 0;
+
+    while (n < UDP_BATCH_SIZE)
+    {
+        if (sys->batch[n] == NULL)
+        {
+            sys->batch[n] = block_Alloc(sys->mtu);
+            if (unlikely(sys->batch[n] == NULL))
+                break;
+        }
+
+        iovecs[n].iov_base = sys->batch[n]->p_buffer;
+        iovecs[n].iov_len = sys->mtu;
+        memset(&msgs[n], 0, sizeof (msgs[n]));
+        msgs[n].msg_hdr.msg_iov = &iovecs[n];
+        msgs[n].msg_hdr.msg_iovlen = 1;
+        n++;
+    }
+
+    if (unlikely(n == 0))
+    {   /* OOM - dequeue and discard one packet */
+        char dummy;
+        recv(sys->fd, &dummy, 1, 0);
+        return NULL;
+    }
+
+    int ret = recvmmsg(sys->fd, msgs, n, MSG_WAITFORONE | MSG_TRUNC, NULL);
+    if (ret <= 0)
+        return NULL;
+
+    bool trunc = false;
+
+    for (int i = 0; i < ret; i++)
+    {
+        pkt = sys->batch[i];
+        sys->batch[i] = NULL;
+
+        if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+        {
+            msg_Err(access, "%u bytes packet truncated (MTU was %zu)",
+                    msgs[i].msg_len, sys->mtu);
+            pkt->i_flags |= BLOCK_FLAG_CORRUPTED;
+            sys->mtu = msgs[i].msg_len;
+            trunc = true;
+        }
+        else
+            pkt->i_buffer = msgs[i].msg_len;
+
+        pkt->p_next = NULL;
+        *sys->queue_end = pkt;
+        sys->queue_end = &pkt->p_next;
+    }
+
+    if (unlikely(trunc))
+        /* Drop preallocated blocks too small for the new MTU */
+        for (unsigned i = 0; i < UDP_BATCH_SIZE; i++)
+            if (sys->batch[i] != NULL)
+            {
+                block_Release(sys->batch[i]);
+                sys->batch[i] = NULL;
+            }
+
+    return BlockPop(sys);
+#else
     block_t *pkt = block_Alloc(sys->mtu);
     if (unlikely(pkt == NULL))
     {   /* OOM - dequeue and discard one packet */
@@ -238,30 +378,11 @@ static block_t *BlockUDP(stream_t *access, bool *restrict eof)
     struct msghdr msg = {
         .msg_iov = &iov,
         .msg_iovlen = 1,
-#ifdef __linux__
-        .msg_flags = MSG_TRUNC,
-#endif
     };
 
-    struct pollfd ufd[1];
-
-    ufd[0].fd = sys->fd;
-    ufd[0].events = POLLIN;
-
-    switch (vlc_poll_i11e(ufd, 1, sys->timeout))
-    {
-        case 0:
-            msg_Err(access, "receive time-out");
-            *eof = true;
-            /* fall through */
-        case -1:
-            goto skip;
-     }
-
     ssize_t len = recvmsg(sys->fd, &msg, 0);
     if (len < 0)
     {
-skip:
         block_Release(pkt);
         return NULL;
     }
@@ -279,4 +400,5 @@ skip:
         pkt->i_buffer = len;
 
     return pkt;
+#endif
 }
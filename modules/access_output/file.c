@@ -32,6 +32,7 @@
 
 #include <assert.h>
 #include <signal.h>
+#include <stdatomic.h>
 #include <sys/types.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -109,6 +110,156 @@ static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
     return i_write;
 }
 
+typedef struct
+{
+    int          fd;
+    block_fifo_t *fifo; /* single-producer/single-consumer, so the locked
+                           FIFO API must not be used on it */
+    vlc_thread_t thread;
+    size_t       i_buffer_max;
+    atomic_size_t i_queued_bytes; /* queued but not yet written */
+    uint64_t     i_dropped_blocks;
+    uint64_t     i_dropped_bytes;
+} sout_access_out_sys_t;
+
+/* Drains the fifo on a dedicated thread so that storage stalls never
+ * block the sout pipeline. A zero-sized block is the termination
+ * marker pushed by Close(). */
+static void *ThreadWrite( void *data )
+{
+    sout_access_out_t *p_access = data;
+    sout_access_out_sys_t *p_sys = p_access->p_sys;
+
+    for( ;; )
+    {
+        block_t *p_buffer = block_FifoGet( p_sys->fifo );
+
+        /* write() must never see a zero count: it would return 0 with a
+         * stale errno and be mistaken for an error */
+        if( p_buffer->i_buffer == 0 && p_buffer->p_next == NULL )
+        {   /* termination marker pushed by Close() */
+            block_Release( p_buffer );
+            break;
+        }
+
+        size_t i_bytes = 0;
+        for( const block_t *b = p_buffer; b != NULL; b = b->p_next )
+            i_bytes += b->i_buffer;
+
+        block_cleanup_push( p_buffer );
+        int canc = vlc_savecancel();
+        while( p_buffer )
+        {
+            if( p_buffer->i_buffer == 0 )
+            {
+                block_t *p_next = p_buffer->p_next;
+                block_Release( p_buffer );
+                p_buffer = p_next;
+                continue;
+            }
+
+            ssize_t val = write( p_sys->fd, p_buffer->p_buffer,
+                                 p_buffer->i_buffer );
+            if( val <= 0 )
+            {
+                if( errno == EINTR )
+                    continue;
+                msg_Err( p_access, "cannot write: %s",
+                         vlc_strerror_c(errno) );
+                block_ChainRelease( p_buffer );
+                break;
+            }
+
+            if( (size_t)val >= p_buffer->i_buffer )
+            {
+                block_t *p_next = p_buffer->p_next;
+                block_Release( p_buffer );
+                p_buffer = p_next;
+            }
+            else
+            {
+                p_buffer->p_buffer += val;
+                p_buffer->i_buffer -= val;
+            }
+        }
+        vlc_restorecancel( canc );
+        vlc_cleanup_pop();
+
+        atomic_fetch_sub_explicit( &p_sys->i_queued_bytes, i_bytes,
+                                   memory_order_relaxed );
+    }
+    return NULL;
+}
+
+static ssize_t WriteAsync( sout_access_out_t *p_access, block_t *p_buffer )
+{
+    sout_access_out_sys_t *p_sys = p_access->p_sys;
+    size_t i_size = 0;
+
+    for( const block_t *b = p_buffer; b != NULL; b = b->p_next )
+        i_size += b->i_buffer;
+
+    if( atomic_load_explicit( &p_sys->i_queued_bytes, memory_order_relaxed )
+        + i_size > p_sys->i_buffer_max )
+    {
+        /* The disk cannot keep up. Dropping here is the only policy
+         * that does not stall the live pipeline. */
+        if( p_sys->i_dropped_blocks == 0 )
+            msg_Warn( p_access, "storage too slow, dropping blocks" );
+        p_sys->i_dropped_blocks++;
+        p_sys->i_dropped_bytes += i_size;
+        block_ChainRelease( p_buffer );
+    }
+    else
+    {
+        atomic_fetch_add_explicit( &p_sys->i_queued_bytes, i_size,
+                                   memory_order_relaxed );
+        block_FifoPut( p_sys->fifo, p_buffer );
+    }
+    return i_size;
+}
+
+static ssize_t ReadAsync( sout_access_out_t *p_access, block_t *p_buffer )
+{
+    sout_access_out_sys_t *p_sys = p_access->p_sys;
+    ssize_t val;
+
+    do
+        val = read( p_sys->fd, p_buffer->p_buffer, p_buffer->i_buffer );
+    while (val == -1 && errno == EINTR);
+    return val;
+}
+
+static int OpenAsync( sout_access_out_t *p_access, int fd )
+{
+    sout_access_out_sys_t *p_sys = malloc( sizeof (*p_sys) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+    p_sys->fd = fd;
+    p_sys->i_buffer_max =
+        var_GetInteger( p_access, SOUT_CFG_PREFIX "async-buffer-size" );
+    p_sys->i_dropped_blocks = 0;
+    p_sys->i_dropped_bytes = 0;
+    atomic_init( &p_sys->i_queued_bytes, 0 );
+    p_sys->fifo = block_FifoNewSPSC();
+    if( unlikely(p_sys->fifo == NULL) )
+    {
+        free( p_sys );
+        return VLC_ENOMEM;
+    }
+
+    p_access->p_sys = p_sys;
+    if( vlc_clone( &p_sys->thread, ThreadWrite, p_access,
+                   VLC_THREAD_PRIORITY_OUTPUT ) )
+    {
+        block_FifoRelease( p_sys->fifo );
+        free( p_sys );
+        return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
 static ssize_t WritePipe(sout_access_out_t *access, block_t *block)
 {
     int fd = (intptr_t)access->p_sys;
@@ -218,6 +369,8 @@ static int Control( sout_access_out_t *p_access, int i_query, va_list args )
 
 static const char *const ppsz_sout_options[] = {
     "append",
+    "async",
+    "async-buffer-size",
     "format",
     "overwrite",
 #ifdef O_SYNC
@@ -331,6 +484,15 @@ static int Open( vlc_object_t *p_this )
     {
         p_access->pf_write = Write;
         p_access->pf_seek  = Seek;
+
+        if (var_GetBool (p_access, SOUT_CFG_PREFIX"async")
+         && OpenAsync (p_access, fd) == VLC_SUCCESS)
+        {
+            p_access->pf_read  = ReadAsync;
+            p_access->pf_write = WriteAsync;
+            /* Seeking behind the writer thread would be incoherent */
+            p_access->pf_seek  = NULL;
+        }
     }
 #ifdef S_ISSOCK
     else if (S_ISSOCK(st.st_mode))
@@ -361,7 +523,31 @@ static void Close( vlc_object_t * p_this )
 {
     sout_access_out_t *p_access = (sout_access_out_t*)p_this;
 
-    vlc_close( (intptr_t)p_access->p_sys );
+    if( p_access->pf_write == WriteAsync )
+    {
+        sout_access_out_sys_t *p_sys = p_access->p_sys;
+        block_t *p_eof = block_Alloc( 0 );
+
+        if( likely(p_eof != NULL) )
+        {   /* Flush pending blocks, then terminate the writer thread */
+            block_FifoPut( p_sys->fifo, p_eof );
+            vlc_join( p_sys->thread, NULL );
+        }
+        else
+        {   /* Out of memory: pending blocks are lost */
+            vlc_cancel( p_sys->thread );
+            vlc_join( p_sys->thread, NULL );
+        }
+        if( p_sys->i_dropped_bytes > 0 )
+            msg_Warn( p_access, "dropped %"PRIu64" chains (%"PRIu64" bytes) "
+                      "on storage overflow",
+                      p_sys->i_dropped_blocks, p_sys->i_dropped_bytes );
+        block_FifoRelease( p_sys->fifo );
+        vlc_close( p_sys->fd );
+        free( p_sys );
+    }
+    else
+        vlc_close( (intptr_t)p_access->p_sys );
 
     msg_Dbg( p_access, "file access output closed" );
 }
@@ -377,6 +563,14 @@ static void Close( vlc_object_t * p_this )
     "on the file path")
 #define SYNC_TEXT N_("Synchronous writing")
 #define SYNC_LONGTEXT N_( "Open the file with synchronous writing.")
+#define ASYNC_TEXT N_("Asynchronous writing")
+#define ASYNC_LONGTEXT N_( "Write to the file from a dedicated thread so " \
+    "that storage stalls do not block the streaming pipeline. Disables " \
+    "seeking, so only streamable formats can be recorded this way.")
+#define ASYNC_BUFSIZE_TEXT N_("Asynchronous write buffer size")
+#define ASYNC_BUFSIZE_LONGTEXT N_( "Maximum number of bytes queued to the " \
+    "writer thread. Further blocks are dropped (and accounted) until the " \
+    "storage catches up.")
 
 vlc_module_begin ()
     set_description( N_("File stream output") )
@@ -391,6 +585,11 @@ vlc_module_begin ()
               true )
     add_bool( SOUT_CFG_PREFIX "format", false, FORMAT_TEXT, FORMAT_LONGTEXT,
               true )
+    add_bool( SOUT_CFG_PREFIX "async", false, ASYNC_TEXT, ASYNC_LONGTEXT,
+              true )
+    add_integer( SOUT_CFG_PREFIX "async-buffer-size", 32 * 1024 * 1024,
+                 ASYNC_BUFSIZE_TEXT, ASYNC_BUFSIZE_LONGTEXT, true )
+        change_integer_range( 1 << 20, 1 << 30 )
 #ifdef O_SYNC
     add_bool( SOUT_CFG_PREFIX "sync", false, SYNC_TEXT,SYNC_LONGTEXT,
               false )
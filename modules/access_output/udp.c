@@ -39,6 +39,11 @@
 
 #include <vlc_sout.h>
 #include <vlc_block.h>
+#include <vlc_interrupt.h>
+
+#ifdef HAVE_SYS_UIO_H
+#   include <sys/uio.h>
+#endif
 
 #ifdef _WIN32
 #   include <winsock2.h>
@@ -51,6 +56,11 @@
 
 #define MAX_EMPTY_BLOCKS 200
 
+/** Marks the last block of a datagram in the send FIFO */
+#define UDP_BLOCK_FLAG_DGRAM_END (1 << BLOCK_FLAG_PRIVATE_SHIFT)
+/** Maximum number of blocks gathered into a single datagram */
+#define UDP_IOV_MAX 64
+
 /*****************************************************************************
  * Module descriptor
  *****************************************************************************/
@@ -116,7 +126,10 @@ typedef struct
     size_t        i_mtu;
 
     block_fifo_t *p_fifo;
-    block_t      *p_buffer;
+    block_t      *p_buffer; /*< Chain of blocks for the pending datagram */
+    block_t      *p_buffer_last;
+    size_t        i_buffer_size; /*< Byte size of the pending datagram */
+    unsigned      i_buffer_count; /*< Number of blocks in it */
 
     vlc_thread_t  thread;
 } sout_access_out_sys_t;
@@ -209,6 +222,9 @@ static int Open( vlc_object_t *p_this )
     p_sys->b_mtu_warning = false;
     p_sys->p_fifo = block_FifoNew();
     p_sys->p_buffer = NULL;
+    p_sys->p_buffer_last = NULL;
+    p_sys->i_buffer_size = 0;
+    p_sys->i_buffer_count = 0;
 
     if( vlc_clone( &p_sys->thread, ThreadWrite, p_access,
                            VLC_THREAD_PRIORITY_HIGHEST ) )
@@ -238,7 +254,7 @@ static void Close( vlc_object_t * p_this )
     vlc_join( p_sys->thread, NULL );
     block_FifoRelease( p_sys->p_fifo );
 
-    if( p_sys->p_buffer ) block_Release( p_sys->p_buffer );
+    block_ChainRelease( p_sys->p_buffer );
 
     net_Close( p_sys->i_handle );
     free( p_sys );
@@ -261,8 +277,52 @@ static int Control( sout_access_out_t *p_access, int i_query, va_list args )
 }
 
 /*****************************************************************************
- * Write: standard write on a file descriptor.
+ * Write: gather blocks into MTU-sized datagrams.
  *****************************************************************************/
+static void DatagramFlush( sout_access_out_t *p_access, vlc_tick_t now )
+{
+    sout_access_out_sys_t *p_sys = p_access->p_sys;
+
+    if( p_sys->p_buffer == NULL )
+        return;
+
+    if( p_sys->p_buffer->i_dts + p_sys->i_caching < now )
+    {
+        msg_Dbg( p_access, "late packet for UDP input (%"PRId64 ")",
+                 now - p_sys->p_buffer->i_dts - p_sys->i_caching );
+    }
+
+    p_sys->p_buffer_last->i_flags |= UDP_BLOCK_FLAG_DGRAM_END;
+    block_FifoPut( p_sys->p_fifo, p_sys->p_buffer );
+    p_sys->p_buffer = NULL;
+    p_sys->p_buffer_last = NULL;
+    p_sys->i_buffer_size = 0;
+    p_sys->i_buffer_count = 0;
+}
+
+static void DatagramAppend( sout_access_out_t *p_access, block_t *p_block )
+{
+    sout_access_out_sys_t *p_sys = p_access->p_sys;
+
+    p_block->p_next = NULL;
+
+    if( p_sys->p_buffer == NULL )
+        p_sys->p_buffer = p_block;
+    else
+    {
+        if( p_block->i_flags & BLOCK_FLAG_CLOCK )
+        {
+            if( p_sys->p_buffer->i_flags & BLOCK_FLAG_CLOCK )
+                msg_Warn( p_access, "putting two PCRs at once" );
+            p_sys->p_buffer->i_flags |= BLOCK_FLAG_CLOCK;
+        }
+        p_sys->p_buffer_last->p_next = p_block;
+    }
+    p_sys->p_buffer_last = p_block;
+    p_sys->i_buffer_size += p_block->i_buffer;
+    p_sys->i_buffer_count++;
+}
+
 static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
 {
     sout_access_out_sys_t *p_sys = p_access->p_sys;
@@ -270,10 +330,12 @@ static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
 
     while( p_buffer )
     {
-        block_t *p_next;
-        int i_packets = 0;
+        block_t *p_next = p_buffer->p_next;
         vlc_tick_t now = vlc_tick_now();
 
+        p_buffer->p_next = NULL;
+        i_len += p_buffer->i_buffer;
+
         if( !p_sys->b_mtu_warning && p_buffer->i_buffer > p_sys->i_mtu )
         {
             msg_Warn( p_access, "packet size > MTU, you should probably "
@@ -281,65 +343,39 @@ static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
             p_sys->b_mtu_warning = true;
         }
 
-        /* Check if there is enough space in the buffer */
-        if( p_sys->p_buffer &&
-            p_sys->p_buffer->i_buffer + p_buffer->i_buffer > p_sys->i_mtu )
-        {
-            if( p_sys->p_buffer->i_dts + p_sys->i_caching < now )
-            {
-                msg_Dbg( p_access, "late packet for UDP input (%"PRId64 ")",
-                         now - p_sys->p_buffer->i_dts
-                          - p_sys->i_caching );
-            }
-            block_FifoPut( p_sys->p_fifo, p_sys->p_buffer );
-            p_sys->p_buffer = NULL;
-        }
-
-        i_len += p_buffer->i_buffer;
-        while( p_buffer->i_buffer )
-        {
-            size_t i_payload_size = p_sys->i_mtu;
-            size_t i_write = __MIN( p_buffer->i_buffer, i_payload_size );
-
-            i_packets++;
+        /* Flush if the block does not fit in the pending datagram */
+        if( p_sys->i_buffer_size + p_buffer->i_buffer > p_sys->i_mtu
+         || p_sys->i_buffer_count >= UDP_IOV_MAX )
+            DatagramFlush( p_access, now );
 
-            if( !p_sys->p_buffer )
+        if( p_buffer->i_buffer > p_sys->i_mtu )
+        {   /* Slice an oversized block into MTU-sized datagrams */
+            while( p_buffer->i_buffer > 0 )
             {
-                p_sys->p_buffer = block_Alloc( p_sys->i_mtu );
-                if( !p_sys->p_buffer ) break;
-                p_sys->p_buffer->i_dts = p_buffer->i_dts;
-                p_sys->p_buffer->i_buffer = 0;
-            }
+                size_t i_write = __MIN( p_buffer->i_buffer, p_sys->i_mtu );
+                block_t *p_split = block_Alloc( i_write );
 
-            memcpy( p_sys->p_buffer->p_buffer + p_sys->p_buffer->i_buffer,
-                    p_buffer->p_buffer, i_write );
+                if( unlikely(p_split == NULL) )
+                    break;
 
-            p_sys->p_buffer->i_buffer += i_write;
-            p_buffer->p_buffer += i_write;
-            p_buffer->i_buffer -= i_write;
-            if ( p_buffer->i_flags & BLOCK_FLAG_CLOCK )
-            {
-                if ( p_sys->p_buffer->i_flags & BLOCK_FLAG_CLOCK )
-                    msg_Warn( p_access, "putting two PCRs at once" );
-                p_sys->p_buffer->i_flags |= BLOCK_FLAG_CLOCK;
-            }
+                memcpy( p_split->p_buffer, p_buffer->p_buffer, i_write );
+                p_split->i_dts = p_buffer->i_dts;
+                p_split->i_flags = p_buffer->i_flags & BLOCK_FLAG_CLOCK;
+                p_buffer->p_buffer += i_write;
+                p_buffer->i_buffer -= i_write;
 
-            if( p_sys->p_buffer->i_buffer == p_sys->i_mtu || i_packets > 1 )
-            {
-                /* Flush */
-                if( p_sys->p_buffer->i_dts + p_sys->i_caching < now )
-                {
-                    msg_Dbg( p_access, "late packet for udp input (%"PRId64 ")",
-                             vlc_tick_now() - p_sys->p_buffer->i_dts
-                              - p_sys->i_caching );
-                }
-                block_FifoPut( p_sys->p_fifo, p_sys->p_buffer );
-                p_sys->p_buffer = NULL;
+                DatagramAppend( p_access, p_split );
+                DatagramFlush( p_access, now );
             }
+            block_Release( p_buffer );
+        }
+        else
+        {
+            DatagramAppend( p_access, p_buffer );
+            if( p_sys->i_buffer_size >= p_sys->i_mtu )
+                DatagramFlush( p_access, now );
         }
 
-        p_next = p_buffer->p_next;
-        block_Release( p_buffer );
         p_buffer = p_next;
     }
 
@@ -349,6 +385,11 @@ static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
 /*****************************************************************************
  * ThreadWrite: Write a packet on the network at the good time.
  *****************************************************************************/
+static void ChainRelease( void *data )
+{
+    block_ChainRelease( data );
+}
+
 static void* ThreadWrite( void *data )
 {
     sout_access_out_t *p_access = data;
@@ -362,7 +403,19 @@ static void* ThreadWrite( void *data )
     for (;;)
     {
         block_t *p_pk = block_FifoGet( p_sys->p_fifo );
+        block_t *p_last = p_pk;
         vlc_tick_t    i_date, i_sent;
+        bool b_drop = false;
+
+        vlc_cleanup_push( ChainRelease, p_pk );
+
+        /* Gather the remaining blocks of the datagram. The FIFO only ever
+         * holds whole datagrams, so this cannot block. */
+        while( !(p_last->i_flags & UDP_BLOCK_FLAG_DGRAM_END) )
+        {
+            p_last->p_next = block_FifoGet( p_sys->p_fifo );
+            p_last = p_last->p_next;
+        }
 
         i_date = p_sys->i_caching + p_pk->i_dts;
         if( i_date_last > 0 )
@@ -373,11 +426,8 @@ static void* ThreadWrite( void *data )
                     msg_Dbg( p_access, "mmh, hole (%"PRId64" > 2s) -> drop",
                              i_date - i_date_last );
 
-                block_Release( p_pk );
-
-                i_date_last = i_date;
                 i_dropped_packets++;
-                continue;
+                b_drop = true;
             }
             else if( i_date - i_date_last < VLC_TICK_FROM_MS(-1) )
             {
@@ -387,33 +437,45 @@ static void* ThreadWrite( void *data )
             }
         }
 
-        block_cleanup_push( p_pk );
-        i_to_send--;
-        if( !i_to_send || (p_pk->i_flags & BLOCK_FLAG_CLOCK) )
+        if( !b_drop )
         {
-            vlc_tick_wait( i_date );
-            i_to_send = i_group;
-        }
-        if ( send( p_sys->i_handle, p_pk->p_buffer, p_pk->i_buffer, 0 ) == -1 )
-            msg_Warn( p_access, "send error: %s", vlc_strerror_c(errno) );
-        vlc_cleanup_pop();
+            struct iovec iov[UDP_IOV_MAX];
+            unsigned i_iov = 0;
 
-        if( i_dropped_packets )
-        {
-            msg_Dbg( p_access, "dropped %i packets", i_dropped_packets );
-            i_dropped_packets = 0;
-        }
+            for( block_t *p = p_pk; p != NULL; p = p->p_next )
+            {
+                iov[i_iov].iov_base = p->p_buffer;
+                iov[i_iov].iov_len = p->i_buffer;
+                i_iov++;
+            }
+
+            i_to_send--;
+            if( !i_to_send || (p_pk->i_flags & BLOCK_FLAG_CLOCK) )
+            {
+                vlc_tick_wait( i_date );
+                i_to_send = i_group;
+            }
+            if ( vlc_writev_i11e( p_sys->i_handle, iov, i_iov ) == -1 )
+                msg_Warn( p_access, "send error: %s", vlc_strerror_c(errno) );
+
+            if( i_dropped_packets )
+            {
+                msg_Dbg( p_access, "dropped %i packets", i_dropped_packets );
+                i_dropped_packets = 0;
+            }
 
 #if 1
-        i_sent = vlc_tick_now();
-        if ( i_sent > i_date + VLC_TICK_FROM_MS(20) )
-        {
-            msg_Dbg( p_access, "packet has been sent too late (%"PRId64 ")",
-                     i_sent - i_date );
-        }
+            i_sent = vlc_tick_now();
+            if ( i_sent > i_date + VLC_TICK_FROM_MS(20) )
+            {
+                msg_Dbg( p_access, "packet has been sent too late (%"PRId64 ")",
+                         i_sent - i_date );
+            }
 #endif
+        }
 
-        block_Release( p_pk );
+        vlc_cleanup_pop();
+        block_ChainRelease( p_pk );
 
         i_date_last = i_date;
     }
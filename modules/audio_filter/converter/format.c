@@ -39,6 +39,14 @@
 #include <vlc_aout.h>
 #include <vlc_block.h>
 #include <vlc_filter.h>
+#include <vlc_cpu.h>
+
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+# include <immintrin.h>
+#endif
 
 /*****************************************************************************
  * Module descriptor
@@ -439,6 +447,237 @@ static block_t *Fl64toS32(filter_t *filter, block_t *b)
 }
 
 
+/*** Vectorized variants of the hottest conversions ***
+ * These behave exactly like their scalar counterparts (same rounding, same
+ * saturation) and fall back on them for the trailing samples. */
+
+#ifdef HAVE_SSE2_INTRINSICS
+__attribute__ ((__target__ ("sse2")))
+static block_t *S16toFl32_SSE2(filter_t *filter, block_t *bsrc)
+{
+    block_t *bdst = block_Alloc(bsrc->i_buffer * 2);
+    if (unlikely(bdst == NULL))
+        goto out;
+
+    block_CopyProperties(bdst, bsrc);
+    const int16_t *src = (int16_t *)bsrc->p_buffer;
+    float         *dst = (float *)bdst->p_buffer;
+    size_t         n = bsrc->i_buffer / 2;
+    const __m128  scale = _mm_set1_ps(1.f / 32768.f);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (n >= 8)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)src);
+        /* Sign-extend the 16-bit lanes to 32 bits */
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(zero, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(zero, s), 16);
+
+        _mm_storeu_ps(dst,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        src += 8;
+        dst += 8;
+        n -= 8;
+    }
+    while (n-- > 0)
+        *dst++ = (float)*src++ / 32768.f;
+out:
+    block_Release(bsrc);
+    VLC_UNUSED(filter);
+    return bdst;
+}
+
+__attribute__ ((__target__ ("sse2")))
+static block_t *Fl32toS16_SSE2(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    const float *src = (float *)b->p_buffer;
+    int16_t     *dst = (int16_t *)b->p_buffer;
+    size_t       n = b->i_buffer / 4;
+    const __m128 scale = _mm_set1_ps(32768.f);
+
+    while (n >= 8)
+    {
+        /* cvtps rounds to nearest and packs saturates, like the scalar
+         * rounding and clipping */
+        __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src), scale));
+        __m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + 4),
+                                                scale));
+
+        _mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+        src += 8;
+        dst += 8;
+        n -= 8;
+    }
+    while (n-- > 0)
+    {   /* Same rounding as the vector body (and Fl32toS16()) */
+        union { float f; int32_t i; } u;
+        u.f = *src++ + 384.f;
+        if (u.i > 0x43c07fff)
+            *dst++ = 32767;
+        else if (u.i < 0x43bf8000)
+            *dst++ = -32768;
+        else
+            *dst++ = u.i - 0x43c00000;
+    }
+    b->i_buffer /= 2;
+    return b;
+}
+
+__attribute__ ((__target__ ("sse2")))
+static block_t *S16toS32_SSE2(filter_t *filter, block_t *bsrc)
+{
+    block_t *bdst = block_Alloc(bsrc->i_buffer * 2);
+    if (unlikely(bdst == NULL))
+        goto out;
+
+    block_CopyProperties(bdst, bsrc);
+    const int16_t *src = (int16_t *)bsrc->p_buffer;
+    int32_t       *dst = (int32_t *)bdst->p_buffer;
+    size_t         n = bsrc->i_buffer / 2;
+    const __m128i  zero = _mm_setzero_si128();
+
+    while (n >= 8)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)src);
+
+        /* Unpacking into the high half amounts to a left shift by 16 */
+        _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(zero, s));
+        _mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi16(zero, s));
+        src += 8;
+        dst += 8;
+        n -= 8;
+    }
+    while (n-- > 0)
+        *dst++ = *src++ << 16;
+out:
+    block_Release(bsrc);
+    VLC_UNUSED(filter);
+    return bdst;
+}
+
+__attribute__ ((__target__ ("sse2")))
+static block_t *S32toS16_SSE2(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    const int32_t *src = (int32_t *)b->p_buffer;
+    int16_t       *dst = (int16_t *)b->p_buffer;
+    size_t         n = b->i_buffer / 4;
+
+    while (n >= 8)
+    {
+        __m128i lo = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)src),
+                                    16);
+        __m128i hi = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)src + 1),
+                                    16);
+
+        _mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+        src += 8;
+        dst += 8;
+        n -= 8;
+    }
+    while (n-- > 0)
+        *dst++ = (*src++) >> 16;
+    b->i_buffer /= 2;
+    return b;
+}
+
+__attribute__ ((__target__ ("sse2")))
+static block_t *S32toFl32_SSE2(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    const int32_t *src = (int32_t *)b->p_buffer;
+    float         *dst = (float *)b->p_buffer;
+    size_t         n = b->i_buffer / 4;
+    const __m128   scale = _mm_set1_ps(1.f / 2147483648.f);
+
+    while (n >= 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)src);
+
+        _mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(s), scale));
+        src += 4;
+        dst += 4;
+        n -= 4;
+    }
+    while (n-- > 0)
+        *dst++ = (float)(*src++) / 2147483648.f;
+    return b;
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#ifdef HAVE_AVX2_INTRINSICS
+__attribute__ ((__target__ ("avx2")))
+static block_t *S16toFl32_AVX2(filter_t *filter, block_t *bsrc)
+{
+    block_t *bdst = block_Alloc(bsrc->i_buffer * 2);
+    if (unlikely(bdst == NULL))
+        goto out;
+
+    block_CopyProperties(bdst, bsrc);
+    const int16_t *src = (int16_t *)bsrc->p_buffer;
+    float         *dst = (float *)bdst->p_buffer;
+    size_t         n = bsrc->i_buffer / 2;
+    const __m256   scale = _mm256_set1_ps(1.f / 32768.f);
+
+    while (n >= 8)
+    {
+        __m256i s = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128((const __m128i *)src));
+
+        _mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_cvtepi32_ps(s), scale));
+        src += 8;
+        dst += 8;
+        n -= 8;
+    }
+    while (n-- > 0)
+        *dst++ = (float)*src++ / 32768.f;
+out:
+    block_Release(bsrc);
+    VLC_UNUSED(filter);
+    return bdst;
+}
+
+__attribute__ ((__target__ ("avx2")))
+static block_t *Fl32toS16_AVX2(filter_t *filter, block_t *b)
+{
+    VLC_UNUSED(filter);
+    const float *src = (float *)b->p_buffer;
+    int16_t     *dst = (int16_t *)b->p_buffer;
+    size_t       n = b->i_buffer / 4;
+    const __m256 scale = _mm256_set1_ps(32768.f);
+
+    while (n >= 16)
+    {
+        __m256i lo = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src),
+                                                      scale));
+        __m256i hi = _mm256_cvtps_epi32(
+            _mm256_mul_ps(_mm256_loadu_ps(src + 8), scale));
+        /* packs interleaves the 128-bit lanes, put them back in order */
+        __m256i s = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi),
+                                             _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_si256((__m256i *)dst, s);
+        src += 16;
+        dst += 16;
+        n -= 16;
+    }
+    while (n-- > 0)
+    {   /* Same rounding as the vector body (and Fl32toS16()) */
+        union { float f; int32_t i; } u;
+        u.f = *src++ + 384.f;
+        if (u.i > 0x43c07fff)
+            *dst++ = 32767;
+        else if (u.i < 0x43bf8000)
+            *dst++ = -32768;
+        else
+            *dst++ = u.i - 0x43c00000;
+    }
+    b->i_buffer /= 2;
+    return b;
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
 /* */
 /* */
 static const struct {
@@ -476,6 +715,28 @@ static const struct {
 
 static cvt_t FindConversion(vlc_fourcc_t src, vlc_fourcc_t dst)
 {
+#ifdef HAVE_AVX2_INTRINSICS
+    if (vlc_CPU_AVX2()) {
+        if (src == VLC_CODEC_S16N && dst == VLC_CODEC_FL32)
+            return S16toFl32_AVX2;
+        if (src == VLC_CODEC_FL32 && dst == VLC_CODEC_S16N)
+            return Fl32toS16_AVX2;
+    }
+#endif
+#ifdef HAVE_SSE2_INTRINSICS
+    if (vlc_CPU_SSE2()) {
+        if (src == VLC_CODEC_S16N && dst == VLC_CODEC_FL32)
+            return S16toFl32_SSE2;
+        if (src == VLC_CODEC_FL32 && dst == VLC_CODEC_S16N)
+            return Fl32toS16_SSE2;
+        if (src == VLC_CODEC_S16N && dst == VLC_CODEC_S32N)
+            return S16toS32_SSE2;
+        if (src == VLC_CODEC_S32N && dst == VLC_CODEC_S16N)
+            return S32toS16_SSE2;
+        if (src == VLC_CODEC_S32N && dst == VLC_CODEC_FL32)
+            return S32toFl32_SSE2;
+    }
+#endif
     for (int i = 0; cvt_directs[i].convert; i++) {
         if (cvt_directs[i].src == src &&
             cvt_directs[i].dst == dst)
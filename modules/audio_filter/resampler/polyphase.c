@@ -0,0 +1,502 @@
+/*****************************************************************************
+ * polyphase.c : polyphase FIR resampler
+ *****************************************************************************
+ * Copyright (C) 2018 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Preamble:
+ *
+ * Classic polyphase sample rate converter: a Kaiser-windowed sinc prototype
+ * low-pass filter is sampled into a bank of short FIR phases at module open,
+ * so that the per-sample work boils down to one table lookup and two short
+ * dot products (the fractional phase is interpolated linearly between
+ * adjacent rows of the bank). This handles the small rate adjustments of the
+ * audio output drift correction without rebuilding the bank.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+#include <assert.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_aout.h>
+#include <vlc_filter.h>
+#include <vlc_cpu.h>
+
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+# include <immintrin.h>
+#endif
+
+#define POLY_TAPS    16 /**< FIR length of each phase */
+#define POLY_PHASES 128 /**< Number of fractional phases in the bank */
+
+/** Minimum channels count before per-channel worker threads pay off */
+#define POLY_THREADS_CHANNELS 6
+
+/*****************************************************************************
+ * Local prototypes
+ *****************************************************************************/
+static int  Open (vlc_object_t *);
+static int  OpenResampler (vlc_object_t *);
+static void Close (vlc_object_t *);
+
+vlc_module_begin ()
+    set_shortname (N_("Polyphase resampler"))
+    set_description (N_("Polyphase FIR audio resampler"))
+    set_category (CAT_AUDIO)
+    set_subcategory (SUBCAT_AUDIO_RESAMPLER)
+    set_capability ("audio converter", 30)
+    set_callbacks (Open, Close)
+
+    add_submodule ()
+    set_capability ("audio resampler", 30)
+    set_callbacks (OpenResampler, Close)
+vlc_module_end ()
+
+/**
+ * Computes the two dot products of the input window against consecutive
+ * phase rows (c and c + POLY_TAPS) and blends them by the fractional phase.
+ */
+typedef float (*dot_pair_cb) (const float *, const float *, float);
+
+typedef struct
+{
+    filter_t *filter;
+    unsigned channel;
+    vlc_thread_t thread;
+    vlc_sem_t wake;
+    vlc_sem_t done;
+} poly_worker_t;
+
+typedef struct
+{
+    float *bank; /**< (POLY_PHASES + 1) rows of POLY_TAPS coefficients */
+    dot_pair_cb dot;
+
+    uint64_t pos; /**< Input read position, in 32.32 fixed point samples */
+    bool first;
+
+    unsigned channels;
+    float *hist; /**< POLY_TAPS - 1 trailing samples of each channel */
+    float *buf; /**< Per-channel contiguous work buffers */
+    size_t buf_stride; /**< Allocated samples per channel in buf */
+
+    /* Per-buffer job, shared with the workers */
+    const float *in;
+    float *out;
+    size_t nin;
+    size_t nout;
+    uint64_t step; /**< Input samples per output sample, in 32.32 */
+
+    poly_worker_t *workers; /**< One per channel, or NULL if serial */
+    bool closing;
+} filter_sys_t;
+
+/*****************************************************************************
+ * Filter bank setup
+ *****************************************************************************/
+static double BesselI0 (double x)
+{
+    double sum = 1., term = 1.;
+
+    for (unsigned k = 1; k < 24; k++)
+    {
+        term *= (x * x * 0.25) / (k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static void BuildBank (float *bank, double cutoff)
+{
+    const double beta = 8.6; /* Kaiser parameter, ~84 dB stop band */
+    const double i0beta = BesselI0 (beta);
+    const double center = (POLY_TAPS - 1) / 2.;
+    const double half = POLY_TAPS / 2.;
+
+    for (unsigned p = 0; p <= POLY_PHASES; p++)
+    {
+        float *row = bank + p * POLY_TAPS;
+        double frac = (double)p / POLY_PHASES;
+        double sum = 0.;
+
+        for (unsigned k = 0; k < POLY_TAPS; k++)
+        {
+            double x = k - center - frac;
+            double r = x / half;
+            double w = (fabs (r) < 1.)
+                     ? BesselI0 (beta * sqrt (1. - r * r)) / i0beta : 0.;
+            double s = (x != 0.) ? sin (M_PI * cutoff * x) / (M_PI * x)
+                                 : cutoff;
+
+            row[k] = w * s;
+            sum += row[k];
+        }
+        /* Normalize each phase to unity DC gain */
+        for (unsigned k = 0; k < POLY_TAPS; k++)
+            row[k] /= sum;
+    }
+}
+
+/*****************************************************************************
+ * Dot product kernels
+ *****************************************************************************/
+static float DotPair (const float *buf, const float *c, float mu)
+{
+    float d0 = 0.f, d1 = 0.f;
+
+    for (unsigned k = 0; k < POLY_TAPS; k++)
+    {
+        d0 += c[k] * buf[k];
+        d1 += c[k + POLY_TAPS] * buf[k];
+    }
+    return d0 + mu * (d1 - d0);
+}
+
+#ifdef HAVE_SSE2_INTRINSICS
+__attribute__ ((__target__ ("sse2")))
+static float DotPair_SSE2 (const float *buf, const float *c, float mu)
+{
+    __m128 a0 = _mm_setzero_ps (), a1 = _mm_setzero_ps ();
+
+    for (unsigned k = 0; k < POLY_TAPS; k += 4)
+    {
+        const __m128 b = _mm_loadu_ps (buf + k);
+
+        a0 = _mm_add_ps (a0, _mm_mul_ps (b, _mm_loadu_ps (c + k)));
+        a1 = _mm_add_ps (a1, _mm_mul_ps (b, _mm_loadu_ps (c + k + POLY_TAPS)));
+    }
+    /* Horizontal sums of both accumulators at once */
+    __m128 t = _mm_add_ps (_mm_unpacklo_ps (a0, a1),
+                           _mm_unpackhi_ps (a0, a1));
+    t = _mm_add_ps (t, _mm_movehl_ps (t, t));
+
+    float d0 = _mm_cvtss_f32 (t);
+    float d1 = _mm_cvtss_f32 (_mm_shuffle_ps (t, t, 1));
+    return d0 + mu * (d1 - d0);
+}
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+__attribute__ ((__target__ ("avx2")))
+static float DotPair_AVX2 (const float *buf, const float *c, float mu)
+{
+    const __m256 b0 = _mm256_loadu_ps (buf);
+    const __m256 b1 = _mm256_loadu_ps (buf + 8);
+    __m256 a0 = _mm256_add_ps (_mm256_mul_ps (b0, _mm256_loadu_ps (c)),
+                               _mm256_mul_ps (b1, _mm256_loadu_ps (c + 8)));
+    __m256 a1 = _mm256_add_ps (
+        _mm256_mul_ps (b0, _mm256_loadu_ps (c + POLY_TAPS)),
+        _mm256_mul_ps (b1, _mm256_loadu_ps (c + POLY_TAPS + 8)));
+
+    __m128 s0 = _mm_add_ps (_mm256_castps256_ps128 (a0),
+                            _mm256_extractf128_ps (a0, 1));
+    __m128 s1 = _mm_add_ps (_mm256_castps256_ps128 (a1),
+                            _mm256_extractf128_ps (a1, 1));
+    __m128 t = _mm_add_ps (_mm_unpacklo_ps (s0, s1),
+                           _mm_unpackhi_ps (s0, s1));
+    t = _mm_add_ps (t, _mm_movehl_ps (t, t));
+
+    float d0 = _mm_cvtss_f32 (t);
+    float d1 = _mm_cvtss_f32 (_mm_shuffle_ps (t, t, 1));
+    return d0 + mu * (d1 - d0);
+}
+#endif
+
+/*****************************************************************************
+ * Resampling
+ *****************************************************************************/
+
+/**
+ * Resamples one channel. De-interleaves the input behind POLY_TAPS - 1
+ * samples of history, runs the phase dot products, interleaves the result
+ * and saves the new history. Safe to run concurrently for distinct channels.
+ */
+static void ResampleChannel (filter_t *filter, unsigned channel)
+{
+    filter_sys_t *sys = filter->p_sys;
+    const unsigned channels = sys->channels;
+    float *hist = sys->hist + channel * (POLY_TAPS - 1);
+    float *buf = sys->buf + channel * sys->buf_stride;
+    const float *in = sys->in + channel;
+    float *out = sys->out + channel;
+
+    memcpy (buf, hist, (POLY_TAPS - 1) * sizeof (*buf));
+    for (size_t i = 0; i < sys->nin; i++)
+        buf[POLY_TAPS - 1 + i] = in[i * channels];
+
+    uint64_t pos = sys->pos;
+
+    for (size_t n = 0; n < sys->nout; n++)
+    {
+        size_t i = pos >> 32;
+        uint64_t phase = (uint64_t)(uint32_t)pos * POLY_PHASES;
+        float mu = (float)(uint32_t)phase / 4294967296.f;
+        const float *c = sys->bank + (phase >> 32) * POLY_TAPS;
+
+        out[n * channels] = sys->dot (buf + i, c, mu);
+        pos += sys->step;
+    }
+
+    memcpy (hist, buf + sys->nin, (POLY_TAPS - 1) * sizeof (*hist));
+}
+
+static void *Worker (void *data)
+{
+    poly_worker_t *worker = data;
+    filter_sys_t *sys = worker->filter->p_sys;
+
+    for (;;)
+    {
+        vlc_sem_wait (&worker->wake);
+        if (sys->closing)
+            break;
+        ResampleChannel (worker->filter, worker->channel);
+        vlc_sem_post (&worker->done);
+    }
+    return NULL;
+}
+
+static block_t *Resample (filter_t *filter, block_t *in)
+{
+    filter_sys_t *sys = filter->p_sys;
+    const size_t framesize = filter->fmt_out.audio.i_bytes_per_frame;
+    const unsigned irate = filter->fmt_in.audio.i_rate;
+    const unsigned orate = filter->fmt_out.audio.i_rate;
+    block_t *out = NULL;
+
+    if (in->i_flags & BLOCK_FLAG_DISCONTINUITY)
+        sys->first = true;
+    if (sys->first)
+    {   /* Start from silent history */
+        memset (sys->hist, 0,
+                sys->channels * (POLY_TAPS - 1) * sizeof (*sys->hist));
+        sys->pos = 0;
+        sys->first = false;
+    }
+
+    const size_t nin = in->i_nb_samples;
+    if (nin == 0)
+        goto error;
+
+    size_t stride = POLY_TAPS - 1 + nin;
+    if (stride > sys->buf_stride)
+    {
+        float *buf = vlc_alloc (sys->channels * stride, sizeof (*buf));
+        if (unlikely(buf == NULL))
+            goto error;
+        free (sys->buf);
+        sys->buf = buf;
+        sys->buf_stride = stride;
+    }
+
+    /* The drift corrector nudges the nominal input rate by a few Hertz;
+     * this only moves the stepping, the filter bank stays valid. */
+    sys->step = (((uint64_t)irate) << 32) / orate;
+
+    /* Largest output count such that every FIR window fits in the buffer:
+     * the last window starts at most at (nin - 1) + history. */
+    const uint64_t limit = ((uint64_t)nin) << 32;
+    sys->nout = (sys->pos < limit)
+              ? (size_t)((limit - 1 - sys->pos) / sys->step + 1) : 0;
+    sys->nin = nin;
+    sys->in = (float *)in->p_buffer;
+
+    if (sys->nout > 0)
+    {
+        out = block_Alloc (sys->nout * framesize);
+        if (unlikely(out == NULL))
+        {
+            sys->nout = 0;
+            goto error;
+        }
+        sys->out = (float *)out->p_buffer;
+    }
+
+    if (sys->workers != NULL)
+    {
+        for (unsigned c = 0; c < sys->channels; c++)
+            vlc_sem_post (&sys->workers[c].wake);
+        for (unsigned c = 0; c < sys->channels; c++)
+            vlc_sem_wait (&sys->workers[c].done);
+    }
+    else
+        for (unsigned c = 0; c < sys->channels; c++)
+            ResampleChannel (filter, c);
+
+    /* Rebase the read position onto the saved history */
+    sys->pos += sys->nout * sys->step;
+    assert (sys->pos >= limit);
+    sys->pos -= limit;
+
+    if (out != NULL)
+    {
+        out->i_nb_samples = sys->nout;
+        out->i_pts = in->i_pts;
+        out->i_length = sys->nout * CLOCK_FREQ / orate;
+    }
+error:
+    block_Release (in);
+    return out;
+}
+
+static void Flush (filter_t *filter)
+{
+    filter_sys_t *sys = filter->p_sys;
+
+    sys->first = true;
+}
+
+/*****************************************************************************
+ * Open/Close
+ *****************************************************************************/
+static int Open (vlc_object_t *obj)
+{
+    filter_t *filter = (filter_t *)obj;
+
+    /* Will change rate */
+    if (filter->fmt_in.audio.i_rate == filter->fmt_out.audio.i_rate)
+        return VLC_EGENERIC;
+    return OpenResampler (obj);
+}
+
+static int OpenResampler (vlc_object_t *obj)
+{
+    filter_t *filter = (filter_t *)obj;
+
+    /* Only float->float */
+    if (filter->fmt_in.audio.i_format != VLC_CODEC_FL32
+     || filter->fmt_out.audio.i_format != VLC_CODEC_FL32
+    /* No channels remapping */
+     || filter->fmt_in.audio.i_channels != filter->fmt_out.audio.i_channels)
+        return VLC_EGENERIC;
+
+    filter_sys_t *sys = malloc (sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
+    sys->channels = filter->fmt_in.audio.i_channels;
+    sys->bank = vlc_alloc ((POLY_PHASES + 1) * POLY_TAPS,
+                           sizeof (*sys->bank));
+    sys->hist = vlc_alloc (sys->channels * (POLY_TAPS - 1),
+                           sizeof (*sys->hist));
+    if (sys->bank == NULL || sys->hist == NULL)
+    {
+        free (sys->hist);
+        free (sys->bank);
+        free (sys);
+        return VLC_ENOMEM;
+    }
+
+    double ratio = (double)filter->fmt_out.audio.i_rate
+                 / (double)filter->fmt_in.audio.i_rate;
+    BuildBank (sys->bank, 0.9 * (ratio < 1. ? ratio : 1.));
+
+    sys->dot = DotPair;
+#ifdef HAVE_SSE2_INTRINSICS
+    if (vlc_CPU_SSE2 ())
+        sys->dot = DotPair_SSE2;
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+    if (vlc_CPU_AVX2 ())
+        sys->dot = DotPair_AVX2;
+#endif
+
+    sys->pos = 0;
+    sys->first = true;
+    sys->buf = NULL;
+    sys->buf_stride = 0;
+    sys->workers = NULL;
+    sys->closing = false;
+
+    if (sys->channels >= POLY_THREADS_CHANNELS)
+    {
+        sys->workers = vlc_alloc (sys->channels, sizeof (*sys->workers));
+        if (sys->workers != NULL)
+        {
+            unsigned c;
+            for (c = 0; c < sys->channels; c++)
+            {
+                poly_worker_t *worker = sys->workers + c;
+
+                worker->filter = filter;
+                worker->channel = c;
+                vlc_sem_init (&worker->wake, 0);
+                vlc_sem_init (&worker->done, 0);
+            }
+            filter->p_sys = sys;
+            for (c = 0; c < sys->channels; c++)
+                if (vlc_clone (&sys->workers[c].thread, Worker,
+                               sys->workers + c, VLC_THREAD_PRIORITY_AUDIO))
+                    break;
+            if (c < sys->channels)
+            {   /* Cannot spawn every worker: fall back to serial operation */
+                sys->closing = true;
+                for (unsigned i = 0; i < c; i++)
+                {
+                    vlc_sem_post (&sys->workers[i].wake);
+                    vlc_join (sys->workers[i].thread, NULL);
+                }
+                for (unsigned i = 0; i < sys->channels; i++)
+                {
+                    vlc_sem_destroy (&sys->workers[i].wake);
+                    vlc_sem_destroy (&sys->workers[i].done);
+                }
+                free (sys->workers);
+                sys->workers = NULL;
+                sys->closing = false;
+            }
+        }
+    }
+
+    filter->p_sys = sys;
+    filter->pf_audio_filter = Resample;
+    filter->pf_flush = Flush;
+    return VLC_SUCCESS;
+}
+
+static void Close (vlc_object_t *obj)
+{
+    filter_t *filter = (filter_t *)obj;
+    filter_sys_t *sys = filter->p_sys;
+
+    if (sys->workers != NULL)
+    {
+        sys->closing = true;
+        for (unsigned c = 0; c < sys->channels; c++)
+            vlc_sem_post (&sys->workers[c].wake);
+        for (unsigned c = 0; c < sys->channels; c++)
+        {
+            vlc_join (sys->workers[c].thread, NULL);
+            vlc_sem_destroy (&sys->workers[c].wake);
+            vlc_sem_destroy (&sys->workers[c].done);
+        }
+        free (sys->workers);
+    }
+    free (sys->buf);
+    free (sys->hist);
+    free (sys->bank);
+    free (sys);
+}
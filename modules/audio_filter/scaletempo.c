@@ -34,6 +34,14 @@
 #include <vlc_atomic.h>
 #include <vlc_filter.h>
 #include <vlc_modules.h>
+#include <vlc_cpu.h>
+
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+# include <immintrin.h>
+#endif
 
 #include <string.h> /* for memset */
 #include <limits.h> /* form INT_MIN */
@@ -174,6 +182,87 @@ static unsigned best_overlap_offset_float( filter_t *p_filter )
     return best_off * p->bytes_per_frame;
 }
 
+#ifdef HAVE_SSE2_INTRINSICS
+__attribute__ ((__target__ ("sse2")))
+static unsigned best_overlap_offset_float_sse2( filter_t *p_filter )
+{
+    filter_sys_t *p = p_filter->p_sys;
+    const unsigned n = p->samples_overlap - p->samples_per_frame;
+    float *pw  = p->table_window;
+    float *po  = (float *)p->buf_overlap + p->samples_per_frame;
+    float *ppc = p->buf_pre_corr;
+    float best_corr = INT_MIN;
+    unsigned best_off = 0;
+    unsigned i, off;
+
+    for( i = 0; i < n; i++ )
+        ppc[i] = pw[i] * po[i];
+
+    float *search_start = (float *)p->buf_queue + p->samples_per_frame;
+    for( off = 0; off < p->frames_search; off++ ) {
+      __m128 acc = _mm_setzero_ps();
+      float corr;
+      for( i = 0; i + 4 <= n; i += 4 )
+        acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( ppc + i ),
+                                           _mm_loadu_ps( search_start + i ) ) );
+      acc = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) );
+      acc = _mm_add_ss( acc, _mm_shuffle_ps( acc, acc, 1 ) );
+      corr = _mm_cvtss_f32( acc );
+      for( ; i < n; i++ )
+        corr += ppc[i] * search_start[i];
+      if( corr > best_corr ) {
+        best_corr = corr;
+        best_off  = off;
+      }
+      search_start += p->samples_per_frame;
+    }
+
+    return best_off * p->bytes_per_frame;
+}
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+__attribute__ ((__target__ ("avx2")))
+static unsigned best_overlap_offset_float_avx2( filter_t *p_filter )
+{
+    filter_sys_t *p = p_filter->p_sys;
+    const unsigned n = p->samples_overlap - p->samples_per_frame;
+    float *pw  = p->table_window;
+    float *po  = (float *)p->buf_overlap + p->samples_per_frame;
+    float *ppc = p->buf_pre_corr;
+    float best_corr = INT_MIN;
+    unsigned best_off = 0;
+    unsigned i, off;
+
+    for( i = 0; i < n; i++ )
+        ppc[i] = pw[i] * po[i];
+
+    float *search_start = (float *)p->buf_queue + p->samples_per_frame;
+    for( off = 0; off < p->frames_search; off++ ) {
+      __m256 acc = _mm256_setzero_ps();
+      float corr;
+      for( i = 0; i + 8 <= n; i += 8 )
+        acc = _mm256_add_ps( acc,
+                             _mm256_mul_ps( _mm256_loadu_ps( ppc + i ),
+                                        _mm256_loadu_ps( search_start + i ) ) );
+      __m128 s = _mm_add_ps( _mm256_castps256_ps128( acc ),
+                             _mm256_extractf128_ps( acc, 1 ) );
+      s = _mm_add_ps( s, _mm_movehl_ps( s, s ) );
+      s = _mm_add_ss( s, _mm_shuffle_ps( s, s, 1 ) );
+      corr = _mm_cvtss_f32( s );
+      for( ; i < n; i++ )
+        corr += ppc[i] * search_start[i];
+      if( corr > best_corr ) {
+        best_corr = corr;
+        best_off  = off;
+      }
+      search_start += p->samples_per_frame;
+    }
+
+    return best_off * p->bytes_per_frame;
+}
+#endif
+
 /*****************************************************************************
  * output_overlap: blend end of previous stride with beginning of current stride
  *****************************************************************************/
@@ -362,6 +451,14 @@ static int reinit_buffers( filter_t *p_filter )
                 *pw++ = v;
         }
         p->best_overlap_offset = best_overlap_offset_float;
+#ifdef HAVE_SSE2_INTRINSICS
+        if( vlc_CPU_SSE2() )
+            p->best_overlap_offset = best_overlap_offset_float_sse2;
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+        if( vlc_CPU_AVX2() )
+            p->best_overlap_offset = best_overlap_offset_float_avx2;
+#endif
     }
 
     unsigned new_size = ( p->frames_search + frames_stride + frames_overlap ) * p->bytes_per_frame;
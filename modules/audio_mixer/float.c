@@ -34,6 +34,14 @@
 #include <vlc_plugin.h>
 #include <vlc_aout.h>
 #include <vlc_aout_volume.h>
+#include <vlc_cpu.h>
+
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+# include <immintrin.h>
+#endif
 
 /*****************************************************************************
  * Local prototypes
@@ -67,6 +75,48 @@ static void FilterFL32( audio_volume_t *p_volume, block_t *p_buffer,
     (void) p_volume;
 }
 
+#ifdef HAVE_SSE2_INTRINSICS
+__attribute__ ((__target__ ("sse2")))
+static void FilterFL32_SSE2( audio_volume_t *p_volume, block_t *p_buffer,
+                             float f_multiplier )
+{
+    if( f_multiplier == 1.f )
+        return; /* nothing to do */
+
+    float *p = (float *)p_buffer->p_buffer;
+    size_t i = p_buffer->i_buffer / sizeof(*p);
+    const __m128 m = _mm_set1_ps( f_multiplier );
+
+    for( ; i >= 4; i -= 4, p += 4 )
+        _mm_storeu_ps( p, _mm_mul_ps( _mm_loadu_ps( p ), m ) );
+    while( i-- > 0 )
+        *(p++) *= f_multiplier;
+
+    (void) p_volume;
+}
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+__attribute__ ((__target__ ("avx")))
+static void FilterFL32_AVX( audio_volume_t *p_volume, block_t *p_buffer,
+                            float f_multiplier )
+{
+    if( f_multiplier == 1.f )
+        return; /* nothing to do */
+
+    float *p = (float *)p_buffer->p_buffer;
+    size_t i = p_buffer->i_buffer / sizeof(*p);
+    const __m256 m = _mm256_set1_ps( f_multiplier );
+
+    for( ; i >= 8; i -= 8, p += 8 )
+        _mm256_storeu_ps( p, _mm256_mul_ps( _mm256_loadu_ps( p ), m ) );
+    while( i-- > 0 )
+        *(p++) *= f_multiplier;
+
+    (void) p_volume;
+}
+#endif
+
 static void FilterFL64( audio_volume_t *p_volume, block_t *p_buffer,
                         float f_multiplier )
 {
@@ -92,6 +142,14 @@ static int Create( vlc_object_t *p_this )
     {
         case VLC_CODEC_FL32:
             p_volume->amplify = FilterFL32;
+#ifdef HAVE_SSE2_INTRINSICS
+            if( vlc_CPU_SSE2() )
+                p_volume->amplify = FilterFL32_SSE2;
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+            if( vlc_CPU_AVX() )
+                p_volume->amplify = FilterFL32_AVX;
+#endif
             break;
         case VLC_CODEC_FL64:
             p_volume->amplify = FilterFL64;
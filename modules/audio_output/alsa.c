@@ -45,6 +45,7 @@ typedef struct
     snd_pcm_t *pcm;
     unsigned rate; /**< Sample rate */
     vlc_fourcc_t format; /**< Sample format */
+    bool mmap; /**< Direct (memory-mapped) access mode */
     uint8_t chans_table[AOUT_CHAN_MAX]; /**< Channels order table */
     uint8_t chans_to_reorder; /**< Number of channels to reorder */
 
@@ -83,6 +84,21 @@ static const char *const channels_text[] = {
     N_("Surround 5.0"), N_("Surround 5.1"), N_("Surround 7.1"),
 };
 
+#define MMAP_TEXT N_("Direct hardware access")
+#define MMAP_LONGTEXT N_( \
+    "Write samples into the hardware ring buffer using memory-mapped " \
+    "access instead of the read/write transfer, when the device supports " \
+    "it. This saves an intermediate copy of every audio buffer.")
+
+#define PERIOD_TIME_TEXT N_("Period time (in microseconds)")
+#define PERIOD_TIME_LONGTEXT N_( \
+    "Requested hardware period duration. Smaller periods reduce latency " \
+    "at the cost of more frequent wake-ups. 0 selects the default.")
+
+#define BUFFER_TIME_TEXT N_("Buffer time (in microseconds)")
+#define BUFFER_TIME_LONGTEXT N_( \
+    "Requested hardware ring buffer duration. 0 selects the default.")
+
 #define PASSTHROUGH_TEXT N_("Audio passthrough mode")
 static const int passthrough_modes[] = {
     PASSTHROUGH_NONE, PASSTHROUGH_SPDIF, PASSTHROUGH_HDMI,
@@ -105,6 +121,13 @@ vlc_module_begin ()
     add_integer("alsa-passthrough", PASSTHROUGH_NONE, PASSTHROUGH_TEXT,
                 PASSTHROUGH_TEXT, false)
         change_integer_list(passthrough_modes, passthrough_modes_text)
+    add_bool ("alsa-mmap", false, MMAP_TEXT, MMAP_LONGTEXT, true)
+    add_integer ("alsa-period-time", 0, PERIOD_TIME_TEXT,
+                 PERIOD_TIME_LONGTEXT, true)
+        change_integer_range (0, CLOCK_FREQ)
+    add_integer ("alsa-buffer-time", 0, BUFFER_TIME_TEXT,
+                 BUFFER_TIME_LONGTEXT, true)
+        change_integer_range (0, 10 * CLOCK_FREQ)
     add_sw_gain ()
     set_capability( "audio output", 150 )
     set_callbacks( Open, Close )
@@ -446,12 +469,26 @@ static int Start (audio_output_t *aout, audio_sample_format_t *restrict fmt)
         goto error;
     }
 
-    val = snd_pcm_hw_params_set_access (pcm, hw,
-                                        SND_PCM_ACCESS_RW_INTERLEAVED);
-    if (val)
+    sys->mmap = false;
+    if (var_InheritBool (aout, "alsa-mmap"))
     {
-        msg_Err (aout, "cannot set access mode: %s", snd_strerror (val));
-        goto error;
+        val = snd_pcm_hw_params_set_access (pcm, hw,
+                                            SND_PCM_ACCESS_MMAP_INTERLEAVED);
+        if (val)
+            msg_Warn (aout, "cannot set direct access mode: %s",
+                      snd_strerror (val));
+        else
+            sys->mmap = true;
+    }
+    if (!sys->mmap)
+    {
+        val = snd_pcm_hw_params_set_access (pcm, hw,
+                                            SND_PCM_ACCESS_RW_INTERLEAVED);
+        if (val)
+        {
+            msg_Err (aout, "cannot set access mode: %s", snd_strerror (val));
+            goto error;
+        }
     }
 
     /* Set sample format */
@@ -523,7 +560,9 @@ static int Start (audio_output_t *aout, audio_sample_format_t *restrict fmt)
     sys->rate = fmt->i_rate;
 
 #if 1 /* work-around for period-long latency outputs (e.g. PulseAudio): */
-    param = AOUT_MIN_PREPARE_TIME;
+    param = var_InheritInteger (aout, "alsa-period-time");
+    if (param == 0)
+        param = AOUT_MIN_PREPARE_TIME;
     val = snd_pcm_hw_params_set_period_time_near (pcm, hw, &param, NULL);
     if (val)
     {
@@ -532,7 +571,9 @@ static int Start (audio_output_t *aout, audio_sample_format_t *restrict fmt)
     }
 #endif
     /* Set buffer size */
-    param = AOUT_MAX_ADVANCE_TIME;
+    param = var_InheritInteger (aout, "alsa-buffer-time");
+    if (param == 0)
+        param = AOUT_MAX_ADVANCE_TIME;
     val = snd_pcm_hw_params_set_buffer_time_near (pcm, hw, &param, NULL);
     if (val)
     {
@@ -664,7 +705,12 @@ static void Play(audio_output_t *aout, block_t *block, vlc_tick_t date)
     {
         snd_pcm_sframes_t frames;
 
-        frames = snd_pcm_writei (pcm, block->p_buffer, block->i_nb_samples);
+        if (sys->mmap)
+            frames = snd_pcm_mmap_writei (pcm, block->p_buffer,
+                                          block->i_nb_samples);
+        else
+            frames = snd_pcm_writei (pcm, block->p_buffer,
+                                     block->i_nb_samples);
         if (frames >= 0)
         {
             size_t bytes = snd_pcm_frames_to_bytes (pcm, frames);
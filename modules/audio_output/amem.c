@@ -49,6 +49,12 @@ vlc_module_begin ()
                  N_("Channels count"), N_("Channels count"), false)
         change_integer_range (1, AOUT_CHAN_MAX)
         change_private()
+    add_integer ("amem-batch", 0,
+                 N_("Batch size"),
+                 N_("Number of samples to accumulate before the play "
+                    "callback is invoked (0 to deliver buffers as they are "
+                    "produced)."), true)
+        change_integer_range (0, 1 << 20)
 
 vlc_module_end ()
 
@@ -79,6 +85,14 @@ typedef struct
     bool mute;
     bool ready;
     vlc_mutex_t lock;
+
+    /* Sample aggregation, see amem-batch */
+    unsigned batch; /**< Samples per delivery (0: no aggregation) */
+    unsigned frame_size;
+    unsigned out_rate;
+    unsigned char *pending;
+    unsigned pending_count; /**< Accumulated samples in pending */
+    vlc_tick_t pending_pts; /**< Time stamp of the first pending sample */
 } aout_sys_t;
 
 static void Play(audio_output_t *aout, block_t *block, vlc_tick_t date)
@@ -86,7 +100,50 @@ static void Play(audio_output_t *aout, block_t *block, vlc_tick_t date)
     aout_sys_t *sys = aout->sys;
 
     vlc_mutex_lock(&sys->lock);
-    sys->play(sys->opaque, block->p_buffer, block->i_nb_samples, date);
+    if (sys->batch == 0)
+    {   /* Deliver buffers as they come */
+        sys->play(sys->opaque, block->p_buffer, block->i_nb_samples, date);
+        vlc_mutex_unlock(&sys->lock);
+        block_Release (block);
+        return;
+    }
+
+    const unsigned char *data = block->p_buffer;
+    unsigned count = block->i_nb_samples;
+    const vlc_tick_t length = (vlc_tick_t)sys->batch * CLOCK_FREQ
+                            / sys->out_rate;
+
+    if (sys->pending_count == 0)
+        sys->pending_pts = date;
+
+    while (count > 0)
+    {
+        if (sys->pending_count == 0 && count >= sys->batch)
+        {   /* Full batch straight from the block, no copy */
+            sys->play(sys->opaque, data, sys->batch, sys->pending_pts);
+            data += sys->batch * sys->frame_size;
+            count -= sys->batch;
+            sys->pending_pts += length;
+            continue;
+        }
+
+        unsigned n = sys->batch - sys->pending_count;
+        if (n > count)
+            n = count;
+        memcpy(sys->pending + sys->pending_count * sys->frame_size,
+               data, n * sys->frame_size);
+        sys->pending_count += n;
+        data += n * sys->frame_size;
+        count -= n;
+
+        if (sys->pending_count == sys->batch)
+        {
+            sys->play(sys->opaque, sys->pending, sys->batch,
+                      sys->pending_pts);
+            sys->pending_pts += length;
+            sys->pending_count = 0;
+        }
+    }
     vlc_mutex_unlock(&sys->lock);
     block_Release (block);
 }
@@ -109,12 +166,17 @@ static void Flush (audio_output_t *aout, bool wait)
     aout_sys_t *sys = aout->sys;
     void (*cb) (void *) = wait ? sys->drain : sys->flush;
 
+    vlc_mutex_lock(&sys->lock);
+    if (sys->pending_count > 0)
+    {   /* Drain the partial batch, or discard it on flush */
+        if (wait)
+            sys->play(sys->opaque, sys->pending, sys->pending_count,
+                      sys->pending_pts);
+        sys->pending_count = 0;
+    }
     if (cb != NULL)
-    {
-        vlc_mutex_lock(&sys->lock);
         cb (sys->opaque);
-        vlc_mutex_unlock(&sys->lock);
-    }
+    vlc_mutex_unlock(&sys->lock);
 }
 
 static int VolumeSet (audio_output_t *aout, float vol)
@@ -181,6 +243,9 @@ static void Stop (audio_output_t *aout)
         sys->cleanup (sys->opaque);
 
     sys->ready = false;
+    free (sys->pending);
+    sys->pending = NULL;
+    sys->batch = 0;
     vlc_mutex_unlock(&sys->lock);
 }
 
@@ -264,6 +329,17 @@ static int Start (audio_output_t *aout, audio_sample_format_t *fmt)
 
     fmt->i_format = VLC_CODEC_S16N;
     fmt->channel_type = AUDIO_CHANNEL_TYPE_BITMAP;
+
+    sys->frame_size = 2 * channels;
+    sys->out_rate = fmt->i_rate;
+    sys->batch = var_InheritInteger (aout, "amem-batch");
+    sys->pending_count = 0;
+    if (sys->batch > 0)
+    {
+        sys->pending = malloc ((size_t)sys->batch * sys->frame_size);
+        if (unlikely(sys->pending == NULL))
+            sys->batch = 0; /* Fall back to unaggregated delivery */
+    }
     return VLC_SUCCESS;
 }
 
@@ -298,6 +374,9 @@ static int Open (vlc_object_t *obj)
     sys->volume = 1.;
     sys->mute = false;
     sys->ready = false;
+    sys->batch = 0;
+    sys->pending = NULL;
+    sys->pending_count = 0;
     vlc_mutex_init(&sys->lock);
 
     if (sys->play == NULL)
@@ -332,5 +411,6 @@ static void Close (vlc_object_t *obj)
     aout_sys_t *sys = aout->sys;
 
     vlc_mutex_destroy(&sys->lock);
+    free (sys->pending);
     free (sys);
 }
@@ -164,6 +164,10 @@ static int Start( audio_output_t *p_aout, audio_sample_format_t *restrict fmt )
         return VLC_EGENERIC;
     }
 
+    /* Coalesce the many small sample buffers into larger writes */
+    if( p_sys->p_file != stdout )
+        setvbuf( p_sys->p_file, NULL, _IOFBF, 256 * 1024 );
+
     p_aout->time_get = aout_TimeGetDefault;
     p_aout->play = Play;
     p_aout->pause = Pause;
@@ -459,30 +459,6 @@ static int TimeGet(audio_output_t *aout, vlc_tick_t *restrict delay)
     return ret;
 }
 
-/* Memory free callback. The block_t address is in front of the data. */
-static void data_free(void *data)
-{
-    block_t **pp = data, *block;
-
-    memcpy(&block, pp - 1, sizeof (block));
-    block_Release(block);
-}
-
-static void *data_convert(block_t **pp)
-{
-    block_t *block = *pp;
-    /* In most cases, there is enough head room, and this is really cheap: */
-    block = block_Realloc(block, sizeof (block), block->i_buffer);
-    *pp = block;
-    if (unlikely(block == NULL))
-        return NULL;
-
-    memcpy(block->p_buffer, &block, sizeof (block));
-    block->p_buffer += sizeof (block);
-    block->i_buffer -= sizeof (block);
-    return block->p_buffer;
-}
-
 /**
  * Queue one audio frame to the playback stream
  */
@@ -490,11 +466,7 @@ static void Play(audio_output_t *aout, block_t *block, vlc_tick_t date)
 {
     aout_sys_t *sys = aout->sys;
     pa_stream *s = sys->stream;
-
-    const void *ptr = data_convert(&block);
-    if (unlikely(ptr == NULL))
-        return;
-
+    const uint8_t *data = block->p_buffer;
     size_t len = block->i_buffer;
 
     /* Note: The core already holds the output FIFO lock at this point.
@@ -520,12 +492,31 @@ static void Play(audio_output_t *aout, block_t *block, vlc_tick_t date)
     }
 #endif
 
-    if (pa_stream_write(s, ptr, len, data_free, 0, PA_SEEK_RELATIVE) < 0) {
-        vlc_pa_error(aout, "cannot write", sys->context);
-        block_Release(block);
+    while (len > 0) {
+        void *ptr;
+        size_t room = (size_t)-1;
+
+        /* Write into memory shared with the server, instead of having the
+         * library copy our buffer into its memory pool behind our back. */
+        if (pa_stream_begin_write(s, &ptr, &room) < 0) {
+            vlc_pa_error(aout, "cannot begin write", sys->context);
+            break;
+        }
+        if (room > len)
+            room = len;
+        memcpy(ptr, data, room);
+
+        if (pa_stream_write(s, ptr, room, NULL, 0, PA_SEEK_RELATIVE) < 0) {
+            vlc_pa_error(aout, "cannot write", sys->context);
+            pa_stream_cancel_write(s);
+            break;
+        }
+        data += room;
+        len -= room;
     }
 
     pa_threaded_mainloop_unlock(sys->mainloop);
+    block_Release(block);
 }
 
 /**
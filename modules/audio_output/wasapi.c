@@ -68,6 +68,13 @@ DEFINE_GUID(_KSDATAFORMAT_SUBTYPE_IEC61937_DOLBY_MLP,
             0x000c, 0x0cea, 0x0010, 0x80, 0x00,
             0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71);
 
+#ifdef __IAudioClient3_INTERFACE_DEFINED__
+/* 7ed4ee07-8e67-4cd4-8c1a-2b7a5987ad42 */
+DEFINE_GUID(_IID_IAudioClient3,
+            0x7ed4ee07, 0x8e67, 0x4cd4, 0x8c, 0x1a,
+            0x2b, 0x7a, 0x59, 0x87, 0xad, 0x42);
+#endif
+
 static BOOL CALLBACK InitFreq(INIT_ONCE *once, void *param, void **context)
 {
     (void) once; (void) context;
@@ -90,6 +97,7 @@ static msftime_t GetQPC(void)
 typedef struct aout_stream_sys
 {
     IAudioClient *client;
+    HANDLE event; /**< Buffer-ready event (low-latency mode), or NULL */
 
     uint8_t chans_table[AOUT_CHAN_MAX];
     uint8_t chans_to_reorder;
@@ -201,8 +209,12 @@ static HRESULT Play(aout_stream_t *s, block_t *block)
         if (block->i_nb_samples == 0)
             break; /* done */
 
-        /* Out of buffer space, sleep */
-        vlc_tick_sleep(sys->frames * VLC_TICK_FROM_MS(500) / sys->rate);
+        /* Out of buffer space, wait for the engine to release a period or,
+         * in timer-driven mode, nap for half a buffer */
+        if (sys->event != NULL)
+            WaitForSingleObject(sys->event, 2000);
+        else
+            vlc_tick_sleep(sys->frames * VLC_TICK_FROM_MS(500) / sys->rate);
     }
     IAudioRenderClient_Release(render);
 out:
@@ -468,6 +480,7 @@ static HRESULT Start(aout_stream_t *s, audio_sample_format_t *restrict pfmt,
     if (unlikely(sys == NULL))
         return E_OUTOFMEMORY;
     sys->client = NULL;
+    sys->event = NULL;
 
     /* Configure audio stream */
     WAVEFORMATEXTENSIBLE_IEC61937 wf_iec61937;
@@ -588,8 +601,54 @@ static HRESULT Start(aout_stream_t *s, audio_sample_format_t *restrict pfmt,
     sys->block_align = pwf->nBlockAlign;
     sys->rate = pwf->nSamplesPerSec;
 
-    hr = IAudioClient_Initialize(sys->client, shared_mode, 0, buffer_duration,
-                                 0, pwf, sid);
+    DWORD flags = 0;
+    if (shared_mode == AUDCLNT_SHAREMODE_SHARED && AOUT_FMT_LINEAR(&fmt)
+     && var_InheritBool(s->obj.parent, "wasapi-low-latency"))
+    {
+        sys->event = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (likely(sys->event != NULL))
+        {   /* Event-driven engine wake-ups and a small buffer */
+            flags |= AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
+            buffer_duration = MSFTIME_FROM_MS(40);
+        }
+    }
+
+    hr = E_FAIL;
+#ifdef __IAudioClient3_INTERFACE_DEFINED__
+    if (flags & AUDCLNT_STREAMFLAGS_EVENTCALLBACK)
+    {   /* Negotiate the smallest period the engine supports */
+        IAudioClient3 *client3;
+
+        if (SUCCEEDED(IAudioClient_QueryInterface(sys->client,
+                                                  &_IID_IAudioClient3, &pv)))
+        {
+            UINT32 defp, fundp, minp, maxp;
+
+            client3 = pv;
+            if (SUCCEEDED(IAudioClient3_GetSharedModeEnginePeriod(client3,
+                                            pwf, &defp, &fundp, &minp, &maxp)))
+            {
+                hr = IAudioClient3_InitializeSharedAudioStream(client3, flags,
+                                                               minp, pwf, sid);
+                if (SUCCEEDED(hr))
+                    msg_Dbg(s, "engine period  : %"PRIu32" frames", minp);
+            }
+            IAudioClient3_Release(client3);
+        }
+    }
+#endif
+    if (FAILED(hr))
+        hr = IAudioClient_Initialize(sys->client, shared_mode, flags,
+                                     buffer_duration, 0, pwf, sid);
+    if (FAILED(hr) && (flags & AUDCLNT_STREAMFLAGS_EVENTCALLBACK))
+    {   /* Some render paths refuse event-driven mode: try timer-driven */
+        msg_Warn(s, "cannot initialize in event-driven mode (error 0x%lx)",
+                 hr);
+        CloseHandle(sys->event);
+        sys->event = NULL;
+        hr = IAudioClient_Initialize(sys->client, shared_mode, 0,
+                                     buffer_duration, 0, pwf, sid);
+    }
     CoTaskMemFree(pwf_closest);
     if (FAILED(hr))
     {
@@ -597,6 +656,16 @@ static HRESULT Start(aout_stream_t *s, audio_sample_format_t *restrict pfmt,
         goto error;
     }
 
+    if (sys->event != NULL)
+    {
+        hr = IAudioClient_SetEventHandle(sys->client, sys->event);
+        if (FAILED(hr))
+        {
+            msg_Err(s, "cannot set event handle (error 0x%lx)", hr);
+            goto error;
+        }
+    }
+
     hr = IAudioClient_GetBufferSize(sys->client, &sys->frames);
     if (FAILED(hr))
     {
@@ -625,6 +694,8 @@ static HRESULT Start(aout_stream_t *s, audio_sample_format_t *restrict pfmt,
     return S_OK;
 error:
     CoTaskMemFree(pwf_mix);
+    if (sys->event != NULL)
+        CloseHandle(sys->event);
     if (sys->client != NULL)
         IAudioClient_Release(sys->client);
     free(sys);
@@ -637,15 +708,25 @@ static void Stop(aout_stream_t *s)
 
     IAudioClient_Stop(sys->client); /* should not be needed */
     IAudioClient_Release(sys->client);
+    if (sys->event != NULL)
+        CloseHandle(sys->event);
 
     free(sys);
 }
 
+#define LOW_LATENCY_TEXT N_("Low-latency mode")
+#define LOW_LATENCY_LONGTEXT N_( \
+    "Request event-driven buffering and the smallest period the audio " \
+    "engine supports. This reduces the output latency at the cost of more " \
+    "frequent wake-ups.")
+
 vlc_module_begin()
     set_shortname("WASAPI")
     set_description(N_("Windows Audio Session API output"))
     set_capability("aout stream", 50)
     set_category(CAT_AUDIO)
     set_subcategory(SUBCAT_AUDIO_AOUT)
+    add_bool("wasapi-low-latency", false,
+             LOW_LATENCY_TEXT, LOW_LATENCY_LONGTEXT, true)
     set_callbacks(Start, Stop)
 vlc_module_end()
@@ -66,6 +66,14 @@ typedef struct
     int     pi_extraction[AOUT_CHAN_MAX];
     int     i_previous_channels;
     uint64_t i_previous_layout;
+
+    /* Aggregation of decoded frames into larger output buffers */
+    vlc_tick_t i_batch_duration;
+    block_t  *p_batch;
+    block_t **pp_batch_last;
+    unsigned  i_batch_samples;
+    unsigned  i_batch_rate;
+    unsigned  i_batch_bytes_per_frame;
 } decoder_sys_t;
 
 #define BLOCK_FLAG_PRIVATE_REALLOCATED (1 << BLOCK_FLAG_PRIVATE_SHIFT)
@@ -207,6 +215,8 @@ void EndAudioDec( vlc_object_t *obj )
     decoder_sys_t *sys = p_dec->p_sys;
     AVCodecContext *ctx = sys->p_context;
 
+    if( sys->p_batch )
+        block_ChainRelease( sys->p_batch );
     avcodec_free_context( &ctx );
     free( sys );
 }
@@ -252,6 +262,14 @@ int InitAudioDec( vlc_object_t *obj )
     p_sys->i_previous_channels = 0;
     p_sys->i_previous_layout = 0;
 
+    p_sys->i_batch_duration =
+        VLC_TICK_FROM_MS( var_InheritInteger( p_dec, "avcodec-audio-batch" ) );
+    p_sys->p_batch = NULL;
+    p_sys->pp_batch_last = &p_sys->p_batch;
+    p_sys->i_batch_samples = 0;
+    p_sys->i_batch_rate = 0;
+    p_sys->i_batch_bytes_per_frame = 0;
+
     /* */
     /* Try to set as much information as possible but do not trust it */
     SetupOutputFormat( p_dec, false );
@@ -286,11 +304,83 @@ static void Flush( decoder_t *p_dec )
         avcodec_flush_buffers( ctx );
     date_Set( &p_sys->end_date, VLC_TICK_INVALID );
 
+    if( p_sys->p_batch )
+    {
+        block_ChainRelease( p_sys->p_batch );
+        p_sys->p_batch = NULL;
+        p_sys->pp_batch_last = &p_sys->p_batch;
+        p_sys->i_batch_samples = 0;
+    }
+
     if( ctx->codec_id == AV_CODEC_ID_MP2 ||
         ctx->codec_id == AV_CODEC_ID_MP3 )
         p_sys->i_reject_count = 3;
 }
 
+/*****************************************************************************
+ * QueueBatch: send the pending aggregate downstream
+ *****************************************************************************/
+static void QueueBatch( decoder_t *p_dec )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+    block_t *p_chain = p_sys->p_batch;
+
+    if( p_chain == NULL )
+        return;
+    p_sys->p_batch = NULL;
+    p_sys->pp_batch_last = &p_sys->p_batch;
+
+    unsigned i_samples = p_sys->i_batch_samples;
+    p_sys->i_batch_samples = 0;
+
+    block_t *p_batch = block_ChainGather( p_chain );
+    if( unlikely(p_batch == NULL) )
+    {
+        block_ChainRelease( p_chain );
+        return;
+    }
+    p_batch->i_nb_samples = i_samples;
+
+    decoder_QueueAudio( p_dec, p_batch );
+}
+
+/*****************************************************************************
+ * QueueOrBatch: queue one decoded frame, or append it to the aggregate
+ *****************************************************************************/
+static void QueueOrBatch( decoder_t *p_dec, block_t *p_block )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+
+    if( p_sys->i_batch_duration == 0 )
+    {
+        decoder_QueueAudio( p_dec, p_block );
+        return;
+    }
+
+    /* An output format change restarts the aout: never mix formats within
+     * one aggregate */
+    if( p_sys->p_batch != NULL &&
+        ( p_sys->i_batch_rate != p_dec->fmt_out.audio.i_rate ||
+          p_sys->i_batch_bytes_per_frame !=
+              p_dec->fmt_out.audio.i_bytes_per_frame ) )
+        QueueBatch( p_dec );
+
+    if( p_sys->p_batch == NULL )
+    {
+        p_sys->i_batch_rate = p_dec->fmt_out.audio.i_rate;
+        p_sys->i_batch_bytes_per_frame = p_dec->fmt_out.audio.i_bytes_per_frame;
+    }
+
+    block_ChainLastAppend( &p_sys->pp_batch_last, p_block );
+    p_sys->i_batch_samples += p_block->i_nb_samples;
+
+    /* The gathered block takes the PTS of its first frame and the summed
+     * lengths, so the timestamp bookkeeping is done once per aggregate */
+    if( (vlc_tick_t)p_sys->i_batch_samples * CLOCK_FREQ >=
+        p_sys->i_batch_duration * p_sys->i_batch_rate )
+        QueueBatch( p_dec );
+}
+
 /*****************************************************************************
  * DecodeBlock: Called to decode one frame
  *****************************************************************************/
@@ -336,6 +426,7 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
 
         if( p_block->i_flags & BLOCK_FLAG_DISCONTINUITY )
         {
+            QueueBatch( p_dec );
             date_Set( &p_sys->end_date, VLC_TICK_INVALID );
         }
 
@@ -430,7 +521,7 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
                 p_converted->i_length = date_Increment( &p_sys->end_date,
                                                       p_converted->i_nb_samples ) - p_converted->i_pts;
 
-                decoder_QueueAudio( p_dec, p_converted );
+                QueueOrBatch( p_dec, p_converted );
             }
 
             /* Prepare new frame */
@@ -447,6 +538,9 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
         }
     };
 
+    if( pp_block == NULL ) /* Drained */
+        QueueBatch( p_dec );
+
     return VLCDEC_SUCCESS;
 
 end:
@@ -137,6 +137,9 @@ vlc_module_begin ()
     add_obsolete_integer( "ffmpeg-threads" ) /* removed since 2.1.0 */
     add_integer( "avcodec-threads", 0, THREADS_TEXT, THREADS_LONGTEXT, true );
 #endif
+    add_integer( "avcodec-audio-batch", 0, AUDIO_BATCH_TEXT,
+                 AUDIO_BATCH_LONGTEXT, true )
+        change_integer_range( 0, 1000 )
     add_string( "avcodec-options", NULL, AV_OPTIONS_TEXT, AV_OPTIONS_LONGTEXT, true )
 
 
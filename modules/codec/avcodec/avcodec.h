@@ -116,6 +116,12 @@ int ffmpeg_OpenCodec( decoder_t *p_dec, AVCodecContext *, const AVCodec * );
 #define THREADS_TEXT N_( "Threads" )
 #define THREADS_LONGTEXT N_( "Number of threads used for decoding, 0 meaning auto" )
 
+#define AUDIO_BATCH_TEXT N_( "Audio frame batching (ms)" )
+#define AUDIO_BATCH_LONGTEXT N_( "Aggregate decoded audio frames into output " \
+    "buffers of at least this duration. This lowers the per-buffer overhead " \
+    "with codecs producing many small frames, at the cost of latency. " \
+    "0 disables aggregation." )
+
 /*
  * Encoder options
  */
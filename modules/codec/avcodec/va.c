@@ -88,6 +88,71 @@ vlc_fourcc_t vlc_va_GetChroma(enum PixelFormat hwfmt, enum PixelFormat swfmt)
     }
 }
 
+/* Probing every brand of hardware acceleration on a host without the
+ * matching device costs up to a few hundred milliseconds per input open.
+ * Remember the combinations which failed so later opens go straight to
+ * software decoding. Entries expire so a device appearing (or recovering
+ * from a reset) gets probed again eventually. */
+#define VA_PROBE_CACHE_SIZE 8
+#define VA_PROBE_CACHE_TTL  VLC_TICK_FROM_SEC(60)
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct va_probe_entry
+    {
+        enum PixelFormat pix_fmt;
+        enum AVCodecID codec;
+        int profile;
+        int width, height; /* coded size, rounded up to 64 pixels */
+        vlc_tick_t date;
+    } entry[VA_PROBE_CACHE_SIZE];
+    unsigned next;
+} va_probe_cache = { VLC_STATIC_MUTEX, { { 0, 0, 0, 0, 0, 0 } }, 0 };
+
+static void va_probe_KeyInit(struct va_probe_entry *key,
+                             const AVCodecContext *avctx,
+                             enum PixelFormat pix_fmt)
+{
+    key->pix_fmt = pix_fmt;
+    key->codec = avctx->codec_id;
+    key->profile = avctx->profile;
+    key->width = (avctx->coded_width + 63) & ~63;
+    key->height = (avctx->coded_height + 63) & ~63;
+    key->date = 0;
+}
+
+static bool va_probe_CacheHasFailed(const struct va_probe_entry *key)
+{
+    bool failed = false;
+
+    vlc_mutex_lock(&va_probe_cache.lock);
+    for (unsigned i = 0; i < VA_PROBE_CACHE_SIZE; i++)
+    {
+        const struct va_probe_entry *entry = &va_probe_cache.entry[i];
+        if (entry->date != 0
+         && entry->pix_fmt == key->pix_fmt && entry->codec == key->codec
+         && entry->profile == key->profile
+         && entry->width == key->width && entry->height == key->height)
+        {
+            failed = vlc_tick_now() - entry->date < VA_PROBE_CACHE_TTL;
+            break;
+        }
+    }
+    vlc_mutex_unlock(&va_probe_cache.lock);
+    return failed;
+}
+
+static void va_probe_CacheAddFailure(const struct va_probe_entry *key)
+{
+    vlc_mutex_lock(&va_probe_cache.lock);
+    struct va_probe_entry *entry = &va_probe_cache.entry[va_probe_cache.next];
+    va_probe_cache.next = (va_probe_cache.next + 1) % VA_PROBE_CACHE_SIZE;
+    *entry = *key;
+    entry->date = vlc_tick_now();
+    vlc_mutex_unlock(&va_probe_cache.lock);
+}
+
 static int vlc_va_Start(void *func, va_list ap)
 {
     vlc_va_t *va = va_arg(ap, vlc_va_t *);
@@ -114,11 +179,29 @@ vlc_va_t *vlc_va_New(vlc_object_t *obj, AVCodecContext *avctx,
                      enum PixelFormat pix_fmt, const es_format_t *fmt,
                      void *p_sys)
 {
+    char *modlist = var_InheritString(obj, "avcodec-hw");
+
+    /* Only rely on the cache with the default module selection: an explicit
+     * list changes what a failed probe means. */
+    struct va_probe_entry key;
+    bool use_cache = modlist == NULL || !strcasecmp(modlist, "any");
+    if (use_cache)
+    {
+        va_probe_KeyInit(&key, avctx, pix_fmt);
+        if (va_probe_CacheHasFailed(&key))
+        {
+            msg_Dbg(obj, "skipping probe, this acceleration recently failed");
+            free(modlist);
+            return NULL;
+        }
+    }
+
     vlc_va_t *va = vlc_object_create(obj, sizeof (*va));
     if (unlikely(va == NULL))
+    {
+        free(modlist);
         return NULL;
-
-    char *modlist = var_InheritString(obj, "avcodec-hw");
+    }
 
     va->module = vlc_module_load(va, "hw decoder", modlist, true,
                                  vlc_va_Start, va, avctx, pix_fmt, fmt, p_sys);
@@ -127,6 +210,8 @@ vlc_va_t *vlc_va_New(vlc_object_t *obj, AVCodecContext *avctx,
     {
         vlc_object_release(va);
         va = NULL;
+        if (use_cache)
+            va_probe_CacheAddFailure(&key);
     }
     return va;
 }
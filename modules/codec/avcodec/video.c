@@ -1071,22 +1071,16 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
                 b_drained = true;
             }
 
+            bool b_palette_attached = false;
             if( !p_sys->palette_sent )
             {
                 uint8_t *pal = av_packet_new_side_data(&pkt, AV_PKT_DATA_PALETTE, AVPALETTE_SIZE);
                 if (pal) {
                     memcpy(pal, p_dec->fmt_in.video.p_palette->palette, AVPALETTE_SIZE);
-                    p_sys->palette_sent = true;
+                    b_palette_attached = true;
                 }
             }
 
-            /* Make sure we don't reuse the same timestamps twice */
-            if( p_block )
-            {
-                p_block->i_pts =
-                p_block->i_dts = VLC_TICK_INVALID;
-            }
-
             int ret = avcodec_send_packet(p_context, &pkt);
             if( ret != 0 && ret != AVERROR(EAGAIN) )
             {
@@ -1099,19 +1093,34 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
                 break;
             }
 
-            struct frame_info_s *p_frame_info = &p_sys->frame_info[p_context->reordered_opaque % FRAME_INFO_DEPTH];
-            p_frame_info->b_eos = p_block && (p_block->i_flags & BLOCK_FLAG_END_OF_SEQUENCE);
-            p_frame_info->b_display = b_need_output_picture;
+            if( ret == 0 )
+            {
+                struct frame_info_s *p_frame_info = &p_sys->frame_info[p_context->reordered_opaque % FRAME_INFO_DEPTH];
+                p_frame_info->b_eos = p_block && (p_block->i_flags & BLOCK_FLAG_END_OF_SEQUENCE);
+                p_frame_info->b_display = b_need_output_picture;
 
-            p_context->reordered_opaque++;
-            i_used = ret != AVERROR(EAGAIN) ? pkt.size : 0;
-            av_packet_unref( &pkt );
+                p_context->reordered_opaque++;
+                i_used = pkt.size;
+                if( b_palette_attached )
+                    p_sys->palette_sent = true;
 
-            if( p_frame_info->b_eos && !b_drained )
-            {
-                 avcodec_send_packet( p_context, NULL );
-                 b_drained = true;
+                /* Make sure we don't reuse the same timestamps twice */
+                if( p_block )
+                {
+                    p_block->i_pts =
+                    p_block->i_dts = VLC_TICK_INVALID;
+                }
+
+                if( p_frame_info->b_eos && !b_drained )
+                {
+                     avcodec_send_packet( p_context, NULL );
+                     b_drained = true;
+                }
             }
+            /* else the input queue is full: fall through to frame retrieval
+             * to make room, the packet is resubmitted with its timestamps
+             * and bookkeeping untouched on the next iteration */
+            av_packet_unref( &pkt );
         }
 
         AVFrame *frame = av_frame_alloc();
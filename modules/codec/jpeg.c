@@ -522,6 +522,33 @@ static int DecodeBlock(decoder_t *p_dec, block_t *p_block)
 
     p_sys->p_jpeg.out_color_space = JCS_RGB;
 
+    /* The owner may hint at the size it actually needs (e.g. the image
+     * handler producing a thumbnail): decode at the smallest IDCT scale
+     * still covering the hint rather than at full resolution */
+    int i_hint_width = var_GetInteger(p_dec, "image-hint-width");
+    int i_hint_height = var_GetInteger(p_dec, "image-hint-height");
+    if (i_hint_width > 0 && i_hint_height > 0 &&
+        (JDIMENSION)i_hint_width < p_sys->p_jpeg.image_width &&
+        (JDIMENSION)i_hint_height < p_sys->p_jpeg.image_height)
+    {
+        for (unsigned num = 1; num < 8; num++)
+        {
+            if (p_sys->p_jpeg.image_width * num >=
+                    (JDIMENSION)i_hint_width * 8 &&
+                p_sys->p_jpeg.image_height * num >=
+                    (JDIMENSION)i_hint_height * 8)
+            {
+                p_sys->p_jpeg.scale_num = num;
+                p_sys->p_jpeg.scale_denom = 8;
+                msg_Dbg(p_dec, "decoding %ux%u at scale %u/8 for %dx%d hint",
+                        (unsigned)p_sys->p_jpeg.image_width,
+                        (unsigned)p_sys->p_jpeg.image_height,
+                        num, i_hint_width, i_hint_height);
+                break;
+            }
+        }
+    }
+
     jpeg_start_decompress(&p_sys->p_jpeg);
 
     /* Set output properties */
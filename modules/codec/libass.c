@@ -84,6 +84,7 @@ typedef struct
     ASS_Library    *p_library;
     ASS_Renderer   *p_renderer;
     video_format_t fmt;
+    double         f_ar; /* aspect ratio the renderer is configured with */
 
     /* */
     ASS_Track      *p_track;
@@ -147,6 +148,7 @@ static int Create( vlc_object_t *p_this )
     vlc_mutex_init( &p_sys->lock );
     p_sys->i_refcount = 1;
     memset( &p_sys->fmt, 0, sizeof(p_sys->fmt) );
+    p_sys->f_ar = 0.;
     p_sys->i_max_stop = VLC_TICK_INVALID;
     p_sys->p_library  = NULL;
     p_sys->p_renderer = NULL;
@@ -428,13 +430,29 @@ static int SubpictureValidate( subpicture_t *p_subpic,
     fmt.i_bits_per_pixel = 0;
     fmt.i_x_offset       = 0;
     fmt.i_y_offset       = 0;
+    bool b_fmt_changed = false;
     if( b_fmt_src || b_fmt_dst )
     {
-        ass_set_frame_size( p_sys->p_renderer, fmt.i_visible_width, fmt.i_visible_height );
         const double src_ratio = (double)p_fmt_src->i_visible_width / p_fmt_src->i_visible_height;
         const double dst_ratio = (double)p_fmt_dst->i_visible_width / p_fmt_dst->i_visible_height;
-        ass_set_aspect_ratio( p_sys->p_renderer, dst_ratio / src_ratio, 1 );
-        p_sys->fmt = fmt;
+        const double f_ar = dst_ratio / src_ratio;
+
+        /* The spu core flags a format update on every new subpicture, not
+         * only when the values differ. Only reconfigure the renderer, and
+         * thus invalidate, when the geometry actually changed, so that the
+         * detect_change fast path below stays effective across frames. */
+        if( fmt.i_width != p_sys->fmt.i_width ||
+            fmt.i_height != p_sys->fmt.i_height ||
+            fmt.i_visible_width != p_sys->fmt.i_visible_width ||
+            fmt.i_visible_height != p_sys->fmt.i_visible_height ||
+            f_ar != p_sys->f_ar )
+        {
+            ass_set_frame_size( p_sys->p_renderer, fmt.i_visible_width, fmt.i_visible_height );
+            ass_set_aspect_ratio( p_sys->p_renderer, f_ar, 1 );
+            p_sys->fmt = fmt;
+            p_sys->f_ar = f_ar;
+            b_fmt_changed = true;
+        }
     }
 
     /* */
@@ -443,7 +461,7 @@ static int SubpictureValidate( subpicture_t *p_subpic,
     ASS_Image *p_img = ass_render_frame( p_sys->p_renderer, p_sys->p_track,
                                          i_stream_date/1000, &i_changed );
 
-    if( !i_changed && !b_fmt_src && !b_fmt_dst &&
+    if( !i_changed && !b_fmt_changed &&
         (p_img != NULL) == (p_subpic->p_region != NULL) )
     {
         vlc_mutex_unlock( &p_sys->lock );
@@ -75,7 +75,7 @@
 #define DBUS_INSTANCE_ID_PREFIX "instance"
 
 #define SEEK_THRESHOLD 1000 /* µsec */
-#define EVENTS_DELAY INT64_C(100000) /* 100 ms */
+#define EVENTS_DELAY_DEFAULT 50 /* ms */
 
 /*****************************************************************************
  * Local prototypes.
@@ -133,12 +133,19 @@ static void DispatchDBusMessages( intf_thread_t *p_intf );
 /*****************************************************************************
  * Module descriptor
  *****************************************************************************/
+#define EVENT_DELAY_TEXT N_("Event delay (ms)")
+#define EVENT_DELAY_LONGTEXT N_("Property changes are accumulated and " \
+    "emitted as merged PropertiesChanged signals at most once per this " \
+    "interval." )
+
 vlc_module_begin ()
     set_shortname( N_("DBus"))
     set_category( CAT_INTERFACE )
     set_description( N_("D-Bus control interface") )
     set_capability( "interface", 0 )
     set_callbacks( Open, Close )
+    add_integer( "dbus-event-delay", EVENTS_DELAY_DEFAULT,
+                 EVENT_DELAY_TEXT, EVENT_DELAY_LONGTEXT, true )
 vlc_module_end ()
 
 /*****************************************************************************
@@ -161,6 +168,8 @@ static int Open( vlc_object_t *p_this )
     DBusConnection  *p_conn;
     p_sys->i_player_caps   = PLAYER_CAPS_NONE;
     p_sys->i_playing_state = PLAYBACK_STATE_INVALID;
+    p_sys->i_events_delay  = VLC_TICK_FROM_MS(
+        __MAX( 0, var_InheritInteger( p_intf, "dbus-event-delay" ) ) );
 
     if( vlc_pipe( p_sys->p_pipe_fds ) )
     {
@@ -815,6 +824,11 @@ static void *Run( void *data )
          */
         vlc_mutex_lock( &p_intf->p_sys->lock );
 
+        /* A lost connection means nobody is listening anymore: the
+         * property emitters all bail out on b_dead */
+        if( unlikely(!dbus_connection_get_is_connected( p_sys->p_conn )) )
+            p_sys->b_dead = true;
+
         process_timeouts(p_intf);
 
         /* Get the list of watches to process */
@@ -833,9 +847,9 @@ static void *Run( void *data )
         {
             vlc_tick_t now = vlc_tick_now();
             if( events_last_date == VLC_TICK_INVALID
-             || now - events_last_date > EVENTS_DELAY )
+             || now - events_last_date > p_sys->i_events_delay )
             {
-                /* Send events every EVENTS_DELAY */
+                /* Send events at most once per dbus-event-delay */
                 events_last_date = now;
                 events_poll_timeout = -1;
 
@@ -851,7 +865,8 @@ static void *Run( void *data )
             {
                 /* Request poll to wake up in order to send these events after
                  * some delay */
-                events_poll_timeout = ( EVENTS_DELAY - ( now - events_last_date ) ) / 1000;
+                events_poll_timeout = ( p_sys->i_events_delay
+                                      - ( now - events_last_date ) ) / 1000;
             }
         }
         else /* No events: clear timeout */
@@ -97,6 +97,7 @@ struct intf_sys_t
     dbus_int32_t    i_playing_state;
     bool            b_can_play;
     bool            b_dead;
+    vlc_tick_t      i_events_delay;
     vlc_array_t     events;
     vlc_array_t     timeouts;
     vlc_array_t     watches;
@@ -197,7 +197,7 @@ static void Process( intf_thread_t *p_intf )
             {
                 vlc_action_id_t i_key = vlc_actions_get_id( c );
                 if( i_key )
-                    var_SetInteger( p_intf->obj.libvlc, "key-action", i_key );
+                    vlc_actions_do( p_intf, i_key );
                 else
                     msg_Err( p_intf, "Unknown hotkey '%s'", c );
             }
@@ -48,6 +48,9 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef HAVE_POLL
+# include <poll.h>
+#endif
 
 #include <vlc_network.h>
 #include <vlc_url.h>
@@ -117,13 +120,27 @@ static int VolumeChanged( vlc_object_t *, char const *,
 static int InputEvent( vlc_object_t *, char const *,
                        vlc_value_t, vlc_value_t, void * );
 
+/* One connected control client (socket mode) */
+struct rc_client
+{
+    int fd;
+    int i_size;
+    char buffer[ MAX_LINE_LENGTH + 1 ];
+};
+
 struct intf_sys_t
 {
     int *pi_socket_listen;
-    int i_socket;
+    int i_socket; /* msg_rc() reply target: a client fd, or -1 */
     char *psz_unix_path;
     vlc_thread_t thread;
 
+    /* connected clients, owned by the rc thread; the lock only protects
+     * the array against concurrent walks from the status callbacks */
+    vlc_mutex_t       client_lock;
+    struct rc_client  **pp_clients;
+    int               i_clients;
+
     /* status changes */
     vlc_mutex_t       status_lock;
     int               i_last_state;
@@ -140,16 +157,30 @@ struct intf_sys_t
 VLC_FORMAT(2, 3)
 static void msg_rc( intf_thread_t *p_intf, const char *psz_fmt, ... )
 {
+    intf_sys_t *p_sys = p_intf->p_sys;
     va_list args;
     char fmt_eol[strlen (psz_fmt) + 3];
 
     snprintf (fmt_eol, sizeof (fmt_eol), "%s\r\n", psz_fmt);
     va_start( args, psz_fmt );
 
-    if( p_intf->p_sys->i_socket == -1 )
+    if( p_sys->i_socket != -1 )
+        net_vaPrintf( p_intf, p_sys->i_socket, fmt_eol, args );
+    else if( p_sys->pi_socket_listen == NULL )
         utf8_vfprintf( stdout, fmt_eol, args );
     else
-        net_vaPrintf( p_intf, p_intf->p_sys->i_socket, fmt_eol, args );
+    {   /* Status messages go to every connected client */
+        vlc_mutex_lock( &p_sys->client_lock );
+        for( int i = 0; i < p_sys->i_clients; i++ )
+        {
+            va_list copy;
+
+            va_copy( copy, args );
+            net_vaPrintf( p_intf, p_sys->pp_clients[i]->fd, fmt_eol, copy );
+            va_end( copy );
+        }
+        vlc_mutex_unlock( &p_sys->client_lock );
+    }
     va_end( args );
 }
 #define msg_rc( ... ) msg_rc( p_intf, __VA_ARGS__ )
@@ -346,6 +377,8 @@ static int Activate( vlc_object_t *p_this )
     p_sys->pi_socket_listen = pi_socket;
     p_sys->i_socket = -1;
     p_sys->psz_unix_path = psz_unix_path;
+    vlc_mutex_init( &p_sys->client_lock );
+    TAB_INIT( p_sys->i_clients, p_sys->pp_clients );
     vlc_mutex_init( &p_sys->status_lock );
     p_sys->i_last_state = PLAYLIST_STOPPED;
     p_sys->b_input_buffering = false;
@@ -392,8 +425,12 @@ static void Deactivate( vlc_object_t *p_this )
     }
 
     net_ListenClose( p_sys->pi_socket_listen );
-    if( p_sys->i_socket != -1 )
-        net_Close( p_sys->i_socket );
+    for( int i = 0; i < p_sys->i_clients; i++ )
+    {
+        net_Close( p_sys->pp_clients[i]->fd );
+        free( p_sys->pp_clients[i] );
+    }
+    TAB_CLEAN( p_sys->i_clients, p_sys->pp_clients );
     if( p_sys->psz_unix_path != NULL )
     {
 #if defined(AF_LOCAL) && !defined(_WIN32)
@@ -402,6 +439,7 @@ static void Deactivate( vlc_object_t *p_this )
         free( p_sys->psz_unix_path );
     }
     vlc_mutex_destroy( &p_sys->status_lock );
+    vlc_mutex_destroy( &p_sys->client_lock );
     free( p_sys );
 }
 
@@ -473,309 +511,460 @@ static void RegisterCallbacks( intf_thread_t *p_intf )
 }
 
 /*****************************************************************************
- * Run: rc thread
- *****************************************************************************
- * This part of the interface is in a separate thread so that we can call
- * exec() from within it without annoying the rest of the program.
+ * UpdateStatus: report input changes to the client(s)
  *****************************************************************************/
-static void *Run( void *data )
+static void UpdateStatus( intf_thread_t *p_intf, bool b_showpos,
+                          int *pi_oldpos )
 {
-    intf_thread_t *p_intf = data;
     intf_sys_t *p_sys = p_intf->p_sys;
 
-    char p_buffer[ MAX_LINE_LENGTH + 1 ];
-    bool b_showpos = var_InheritBool( p_intf, "rc-show-pos" );
-
-    int  i_size = 0;
-    int  i_oldpos = 0;
-    int  i_newpos;
-    int  canc = vlc_savecancel( );
-
-    p_buffer[0] = 0;
-
-#if defined(_WIN32) && !VLC_WINSTORE_APP
-    /* Get the file descriptor of the console input */
-    p_intf->p_sys->hConsoleIn = GetStdHandle(STD_INPUT_HANDLE);
-    if( p_intf->p_sys->hConsoleIn == INVALID_HANDLE_VALUE )
+    /* Manage the input part */
+    if( p_sys->p_input == NULL )
     {
-        msg_Err( p_intf, "couldn't find user input handle" );
-        return NULL;
-    }
-#endif
-
-    /* Register commands that will be cleaned up upon object destruction */
-    RegisterCallbacks( p_intf );
+        p_sys->p_input = playlist_CurrentInput( p_sys->p_playlist );
+        /* New input has been registered */
+        if( p_sys->p_input )
+        {
+            char *psz_uri = input_item_GetURI( input_GetItem( p_sys->p_input ) );
+            msg_rc( STATUS_CHANGE "( new input: %s )", psz_uri );
+            free( psz_uri );
 
-    /* status callbacks */
+            var_AddCallback( p_sys->p_input, "intf-event", InputEvent, p_intf );
+        }
+    }
 
-    for( ;; )
+    int state;
+    if( p_sys->p_input != NULL
+     && ((state = var_GetInteger( p_sys->p_input, "state")) == ERROR_S
+      || state == END_S) )
     {
-        char *psz_cmd, *psz_arg;
-        bool b_complete;
+        var_DelCallback( p_sys->p_input, "intf-event", InputEvent, p_intf );
+        vlc_object_release( p_sys->p_input );
+        p_sys->p_input = NULL;
 
-        vlc_restorecancel( canc );
+        p_sys->i_last_state = PLAYLIST_STOPPED;
+        msg_rc( STATUS_CHANGE "( stop state: 0 )" );
+    }
 
-        if( p_sys->pi_socket_listen != NULL && p_sys->i_socket == -1 )
-        {
-            p_sys->i_socket =
-                net_Accept( p_intf, p_sys->pi_socket_listen );
-            if( p_sys->i_socket == -1 ) continue;
-        }
+    if( p_sys->p_input != NULL )
+    {
+        playlist_t *p_playlist = p_sys->p_playlist;
 
-        b_complete = ReadCommand( p_intf, p_buffer, &i_size );
-        canc = vlc_savecancel( );
+        PL_LOCK;
+        int status = playlist_Status( p_playlist );
+        PL_UNLOCK;
 
-        /* Manage the input part */
-        if( p_sys->p_input == NULL )
+        if( p_sys->i_last_state != status )
         {
-            p_sys->p_input = playlist_CurrentInput( p_sys->p_playlist );
-            /* New input has been registered */
-            if( p_sys->p_input )
+            if( status == PLAYLIST_STOPPED )
             {
-                char *psz_uri = input_item_GetURI( input_GetItem( p_sys->p_input ) );
-                msg_rc( STATUS_CHANGE "( new input: %s )", psz_uri );
-                free( psz_uri );
-
-                var_AddCallback( p_sys->p_input, "intf-event", InputEvent, p_intf );
+                p_sys->i_last_state = PLAYLIST_STOPPED;
+                msg_rc( STATUS_CHANGE "( stop state: 5 )" );
+            }
+            else if( status == PLAYLIST_RUNNING )
+            {
+                p_sys->i_last_state = PLAYLIST_RUNNING;
+                msg_rc( STATUS_CHANGE "( play state: 3 )" );
+            }
+            else if( status == PLAYLIST_PAUSED )
+            {
+                p_sys->i_last_state = PLAYLIST_PAUSED;
+                msg_rc( STATUS_CHANGE "( pause state: 4 )" );
             }
         }
+    }
 
-        int state;
-        if( p_sys->p_input != NULL
-         && ((state = var_GetInteger( p_sys->p_input, "state")) == ERROR_S
-          || state == END_S) )
+    if( p_sys->p_input && b_showpos )
+    {
+        int i_newpos = 100 * var_GetFloat( p_sys->p_input, "position" );
+        if( *pi_oldpos != i_newpos )
         {
-            var_DelCallback( p_sys->p_input, "intf-event", InputEvent, p_intf );
-            vlc_object_release( p_sys->p_input );
-            p_sys->p_input = NULL;
-
-            p_sys->i_last_state = PLAYLIST_STOPPED;
-            msg_rc( STATUS_CHANGE "( stop state: 0 )" );
+            *pi_oldpos = i_newpos;
+            msg_rc( "pos: %d%%", i_newpos );
         }
+    }
+}
 
-        if( p_sys->p_input != NULL )
-        {
-            playlist_t *p_playlist = p_sys->p_playlist;
-
-            PL_LOCK;
-            int status = playlist_Status( p_playlist );
-            PL_UNLOCK;
+/*****************************************************************************
+ * ProcessLine: parse and execute one complete command line
+ *****************************************************************************/
+static void ProcessLine( intf_thread_t *p_intf, char *p_buffer )
+{
+    intf_sys_t *p_sys = p_intf->p_sys;
+    char *psz_cmd, *psz_arg;
 
-            if( p_sys->i_last_state != status )
-            {
-                if( status == PLAYLIST_STOPPED )
-                {
-                    p_sys->i_last_state = PLAYLIST_STOPPED;
-                    msg_rc( STATUS_CHANGE "( stop state: 5 )" );
-                }
-                else if( status == PLAYLIST_RUNNING )
-                {
-                    p_sys->i_last_state = PLAYLIST_RUNNING;
-                    msg_rc( STATUS_CHANGE "( play state: 3 )" );
-                }
-                else if( status == PLAYLIST_PAUSED )
-                {
-                    p_sys->i_last_state = PLAYLIST_PAUSED;
-                    msg_rc( STATUS_CHANGE "( pause state: 4 )" );
-                }
-            }
-        }
+    /* Skip heading spaces */
+    psz_cmd = p_buffer;
+    while( *psz_cmd == ' ' )
+    {
+        psz_cmd++;
+    }
 
-        if( p_sys->p_input && b_showpos )
+    /* Split psz_cmd at the first space and make sure that
+     * psz_arg is valid */
+    psz_arg = strchr( psz_cmd, ' ' );
+    if( psz_arg )
+    {
+        *psz_arg++ = 0;
+        while( *psz_arg == ' ' )
         {
-            i_newpos = 100 * var_GetFloat( p_sys->p_input, "position" );
-            if( i_oldpos != i_newpos )
-            {
-                i_oldpos = i_newpos;
-                msg_rc( "pos: %d%%", i_newpos );
-            }
+            psz_arg++;
         }
+    }
+    else
+    {
+        psz_arg = (char*)"";
+    }
 
-        /* Is there something to do? */
-        if( !b_complete ) continue;
+    /* If the user typed a registered local command, try it */
+    if( var_Type( p_intf, psz_cmd ) & VLC_VAR_ISCOMMAND )
+    {
+        int i_ret = VLC_SUCCESS;
 
-        /* Skip heading spaces */
-        psz_cmd = p_buffer;
-        while( *psz_cmd == ' ' )
-        {
-            psz_cmd++;
-        }
+        if ((var_Type( p_intf, psz_cmd) & VLC_VAR_CLASS) == VLC_VAR_VOID)
+            var_TriggerCallback( p_intf, psz_cmd );
+        else
+            i_ret = var_SetString( p_intf, psz_cmd, psz_arg );
+        msg_rc( "%s: returned %i (%s)",
+                psz_cmd, i_ret, vlc_error( i_ret ) );
+    }
+    /* Or maybe it's a global command */
+    else if( var_Type( p_intf->obj.libvlc, psz_cmd ) & VLC_VAR_ISCOMMAND )
+    {
+        int i_ret = VLC_SUCCESS;
 
-        /* Split psz_cmd at the first space and make sure that
-         * psz_arg is valid */
-        psz_arg = strchr( psz_cmd, ' ' );
-        if( psz_arg )
-        {
-            *psz_arg++ = 0;
-            while( *psz_arg == ' ' )
-            {
-                psz_arg++;
-            }
-        }
+        /* FIXME: it's a global command, but we should pass the
+         * local object as an argument, not p_intf->obj.libvlc. */
+        if ((var_Type( p_intf->obj.libvlc, psz_cmd) & VLC_VAR_CLASS) == VLC_VAR_VOID)
+            var_TriggerCallback( p_intf, psz_cmd );
         else
+            i_ret = var_SetString( p_intf->obj.libvlc, psz_cmd, psz_arg );
+        if( i_ret != 0 )
         {
-            psz_arg = (char*)"";
+            msg_rc( "%s: returned %i (%s)",
+                     psz_cmd, i_ret, vlc_error( i_ret ) );
         }
-
-        /* If the user typed a registered local command, try it */
-        if( var_Type( p_intf, psz_cmd ) & VLC_VAR_ISCOMMAND )
+    }
+    else if( !strcmp( psz_cmd, "logout" ) )
+    {
+        /* Close connection */
+        if( p_sys->i_socket != -1 )
         {
-            int i_ret = VLC_SUCCESS;
-
-            if ((var_Type( p_intf, psz_cmd) & VLC_VAR_CLASS) == VLC_VAR_VOID)
-                var_TriggerCallback( p_intf, psz_cmd );
-            else
-                i_ret = var_SetString( p_intf, psz_cmd, psz_arg );
-            msg_rc( "%s: returned %i (%s)",
-                    psz_cmd, i_ret, vlc_error( i_ret ) );
+            net_Close( p_sys->i_socket );
+            p_sys->i_socket = -1;
         }
-        /* Or maybe it's a global command */
-        else if( var_Type( p_intf->obj.libvlc, psz_cmd ) & VLC_VAR_ISCOMMAND )
+    }
+    else if( !strcmp( psz_cmd, "info" ) )
+    {
+        if( p_sys->p_input )
         {
-            int i_ret = VLC_SUCCESS;
-
-            /* FIXME: it's a global command, but we should pass the
-             * local object as an argument, not p_intf->obj.libvlc. */
-            if ((var_Type( p_intf->obj.libvlc, psz_cmd) & VLC_VAR_CLASS) == VLC_VAR_VOID)
-                var_TriggerCallback( p_intf, psz_cmd );
-            else
-                i_ret = var_SetString( p_intf->obj.libvlc, psz_cmd, psz_arg );
-            if( i_ret != 0 )
+            int i;
+            vlc_mutex_lock( &input_GetItem(p_sys->p_input)->lock );
+            for ( i = 0; i < input_GetItem(p_sys->p_input)->i_categories; i++ )
             {
-                msg_rc( "%s: returned %i (%s)",
-                         psz_cmd, i_ret, vlc_error( i_ret ) );
+                info_category_t *p_category = input_GetItem(p_sys->p_input)
+                                                    ->pp_categories[i];
+                info_t *p_info;
+
+                msg_rc( "+----[ %s ]", p_category->psz_name );
+                msg_rc( "| " );
+                info_foreach(p_info, &p_category->infos)
+                    msg_rc( "| %s: %s", p_info->psz_name,
+                            p_info->psz_value );
+                msg_rc( "| " );
             }
+            msg_rc( "+----[ end of stream info ]" );
+            vlc_mutex_unlock( &input_GetItem(p_sys->p_input)->lock );
         }
-        else if( !strcmp( psz_cmd, "logout" ) )
+        else
         {
-            /* Close connection */
-            if( p_sys->i_socket != -1 )
-            {
-                net_Close( p_sys->i_socket );
-                p_sys->i_socket = -1;
-            }
+            msg_rc( "no input" );
         }
-        else if( !strcmp( psz_cmd, "info" ) )
+    }
+    else if( !strcmp( psz_cmd, "is_playing" ) )
+    {
+        if( p_sys->p_input == NULL )
         {
-            if( p_sys->p_input )
-            {
-                int i;
-                vlc_mutex_lock( &input_GetItem(p_sys->p_input)->lock );
-                for ( i = 0; i < input_GetItem(p_sys->p_input)->i_categories; i++ )
-                {
-                    info_category_t *p_category = input_GetItem(p_sys->p_input)
-                                                        ->pp_categories[i];
-                    info_t *p_info;
-
-                    msg_rc( "+----[ %s ]", p_category->psz_name );
-                    msg_rc( "| " );
-                    info_foreach(p_info, &p_category->infos)
-                        msg_rc( "| %s: %s", p_info->psz_name,
-                                p_info->psz_value );
-                    msg_rc( "| " );
-                }
-                msg_rc( "+----[ end of stream info ]" );
-                vlc_mutex_unlock( &input_GetItem(p_sys->p_input)->lock );
-            }
-            else
-            {
-                msg_rc( "no input" );
-            }
+            msg_rc( "0" );
         }
-        else if( !strcmp( psz_cmd, "is_playing" ) )
+        else
         {
-            if( p_sys->p_input == NULL )
-            {
-                msg_rc( "0" );
-            }
-            else
-            {
-                msg_rc( "1" );
-            }
+            msg_rc( "1" );
         }
-        else if( !strcmp( psz_cmd, "get_time" ) )
+    }
+    else if( !strcmp( psz_cmd, "get_time" ) )
+    {
+        int64_t t = 0;
+        if( p_sys->p_input != NULL )
+            t = var_GetInteger( p_sys->p_input, "time" ) / CLOCK_FREQ;
+        msg_rc( "%"PRIu64, t );
+    }
+    else if( !strcmp( psz_cmd, "get_length" ) )
+    {
+        int64_t l = 0;
+        if( p_sys->p_input != NULL )
+            l = var_GetInteger( p_sys->p_input, "length" ) / CLOCK_FREQ;
+        msg_rc( "%"PRIu64, l );
+    }
+    else if( !strcmp( psz_cmd, "get_title" ) )
+    {
+        if( p_sys->p_input == NULL )
         {
-            int64_t t = 0;
-            if( p_sys->p_input != NULL )
-                t = var_GetInteger( p_sys->p_input, "time" ) / CLOCK_FREQ;
-            msg_rc( "%"PRIu64, t );
+            msg_rc("%s", "");
         }
-        else if( !strcmp( psz_cmd, "get_length" ) )
+        else
         {
-            int64_t l = 0;
-            if( p_sys->p_input != NULL )
-                l = var_GetInteger( p_sys->p_input, "length" ) / CLOCK_FREQ;
-            msg_rc( "%"PRIu64, l );
+            msg_rc( "%s", input_GetItem(p_sys->p_input)->psz_name );
         }
-        else if( !strcmp( psz_cmd, "get_title" ) )
+    }
+    else if( !strcmp( psz_cmd, "longhelp" ) || !strncmp( psz_cmd, "h", 1 )
+             || !strncmp( psz_cmd, "H", 1 ) || !strncmp( psz_cmd, "?", 1 ) )
+    {
+        Help( p_intf );
+    }
+    else if( !strcmp( psz_cmd, "key" ) || !strcmp( psz_cmd, "hotkey" ) )
+    {
+        vlc_actions_do( p_intf, vlc_actions_get_id( psz_arg ) );
+    }
+    else switch( psz_cmd[0] )
+    {
+    case 'f':
+    case 'F':
+    {
+        bool fs;
+
+        if( !strncasecmp( psz_arg, "on", 2 ) )
+            var_SetBool( p_sys->p_playlist, "fullscreen", fs = true );
+        else if( !strncasecmp( psz_arg, "off", 3 ) )
+            var_SetBool( p_sys->p_playlist, "fullscreen", fs = false );
+        else
+            fs = var_ToggleBool( p_sys->p_playlist, "fullscreen" );
+
+        if( p_sys->p_input != NULL )
         {
-            if( p_sys->p_input == NULL )
-            {
-                msg_rc("%s", "");
-            }
-            else
+            vout_thread_t *p_vout = input_GetVout( p_sys->p_input );
+            if( p_vout )
             {
-                msg_rc( "%s", input_GetItem(p_sys->p_input)->psz_name );
+                var_SetBool( p_vout, "fullscreen", fs );
+                vlc_object_release( p_vout );
             }
         }
-        else if( !strcmp( psz_cmd, "longhelp" ) || !strncmp( psz_cmd, "h", 1 )
-                 || !strncmp( psz_cmd, "H", 1 ) || !strncmp( psz_cmd, "?", 1 ) )
+        break;
+    }
+    case 's':
+    case 'S':
+        ;
+        break;
+
+    case '\0':
+        /* Ignore empty lines */
+        break;
+
+    default:
+        msg_rc(_("Unknown command `%s'. Type `help' for help."), psz_cmd);
+        break;
+    }
+}
+
+/*****************************************************************************
+ * Client handling (socket mode)
+ *****************************************************************************/
+static void ClientClose( intf_thread_t *p_intf, struct rc_client *p_client )
+{
+    intf_sys_t *p_sys = p_intf->p_sys;
+
+    vlc_mutex_lock( &p_sys->client_lock );
+    TAB_REMOVE( p_sys->i_clients, p_sys->pp_clients, p_client );
+    vlc_mutex_unlock( &p_sys->client_lock );
+
+    if( p_client->fd != -1 )
+        net_Close( p_client->fd );
+    free( p_client );
+}
+
+static void ClientRead( intf_thread_t *p_intf, struct rc_client *p_client )
+{
+    intf_sys_t *p_sys = p_intf->p_sys;
+
+    ssize_t val = recv( p_client->fd, p_client->buffer + p_client->i_size,
+                        MAX_LINE_LENGTH - p_client->i_size, 0 );
+    if( val <= 0 )
+    {   /* Connection closed (or error) */
+        ClientClose( p_intf, p_client );
+        return;
+    }
+    p_client->i_size += val;
+    p_client->buffer[p_client->i_size] = '\0';
+
+    /* Dispatch all complete lines */
+    size_t i_len;
+    while( (i_len = strcspn( p_client->buffer, "\r\n" ))
+               < (size_t)p_client->i_size
+        || p_client->i_size == MAX_LINE_LENGTH )
+    {
+        /* An overlong line is truncated and processed as-is */
+        bool b_truncated = ( i_len == (size_t)p_client->i_size );
+
+        p_client->buffer[i_len] = '\0';
+
+        /* Replies go to the issuing client only */
+        p_sys->i_socket = p_client->fd;
+        ProcessLine( p_intf, p_client->buffer );
+        bool b_closed = ( p_sys->i_socket == -1 ); /* "logout" */
+        p_sys->i_socket = -1;
+
+        if( b_closed )
         {
-            Help( p_intf );
+            p_client->fd = -1;
+            ClientClose( p_intf, p_client );
+            return;
         }
-        else if( !strcmp( psz_cmd, "key" ) || !strcmp( psz_cmd, "hotkey" ) )
+
+        size_t i_consumed = b_truncated ? i_len : i_len + 1;
+        memmove( p_client->buffer, p_client->buffer + i_consumed,
+                 p_client->i_size - i_consumed + 1 );
+        p_client->i_size -= i_consumed;
+    }
+}
+
+/*****************************************************************************
+ * RunServer: event loop serving all control connections
+ *****************************************************************************/
+static void RunServer( intf_thread_t *p_intf, bool b_showpos )
+{
+    intf_sys_t *p_sys = p_intf->p_sys;
+    int i_oldpos = 0;
+    int i_listen = 0;
+    int canc = vlc_savecancel( );
+
+    while( p_sys->pi_socket_listen[i_listen] != -1 )
+        i_listen++;
+
+    for( ;; )
+    {
+        int i_clients = p_sys->i_clients;
+        struct pollfd fds[i_listen + i_clients];
+
+        for( int i = 0; i < i_listen; i++ )
         {
-            var_SetInteger( p_intf->obj.libvlc, "key-action",
-                            vlc_actions_get_id( psz_arg ) );
+            fds[i].fd = p_sys->pi_socket_listen[i];
+            fds[i].events = POLLIN;
+            fds[i].revents = 0;
         }
-        else switch( psz_cmd[0] )
+        for( int i = 0; i < i_clients; i++ )
         {
-        case 'f':
-        case 'F':
+            fds[i_listen + i].fd = p_sys->pp_clients[i]->fd;
+            fds[i_listen + i].events = POLLIN;
+            fds[i_listen + i].revents = 0;
+        }
+
+        /* Wake up regularly to report status changes */
+        vlc_restorecancel( canc );
+        int val = poll( fds, i_listen + i_clients, 500 );
+        canc = vlc_savecancel( );
+
+        if( val == -1 )
+            continue;
+
+        /* Serve the clients backward: a closed connection shifts only
+         * entries we have already visited */
+        for( int i = i_clients - 1; i >= 0; i-- )
+            if( fds[i_listen + i].revents )
+                ClientRead( p_intf, p_sys->pp_clients[i] );
+
+        for( int i = 0; i < i_listen; i++ )
         {
-            bool fs;
+            if( !(fds[i].revents & POLLIN) )
+                continue;
 
-            if( !strncasecmp( psz_arg, "on", 2 ) )
-                var_SetBool( p_sys->p_playlist, "fullscreen", fs = true );
-            else if( !strncasecmp( psz_arg, "off", 3 ) )
-                var_SetBool( p_sys->p_playlist, "fullscreen", fs = false );
-            else
-                fs = var_ToggleBool( p_sys->p_playlist, "fullscreen" );
+            int fd = net_AcceptSingle( VLC_OBJECT(p_intf), fds[i].fd );
+            if( fd == -1 )
+                continue;
 
-            if( p_sys->p_input != NULL )
+            struct rc_client *p_client = malloc( sizeof( *p_client ) );
+            if( unlikely(p_client == NULL) )
             {
-                vout_thread_t *p_vout = input_GetVout( p_sys->p_input );
-                if( p_vout )
-                {
-                    var_SetBool( p_vout, "fullscreen", fs );
-                    vlc_object_release( p_vout );
-                }
+                net_Close( fd );
+                continue;
             }
-            break;
+            p_client->fd = fd;
+            p_client->i_size = 0;
+            p_client->buffer[0] = '\0';
+
+            vlc_mutex_lock( &p_sys->client_lock );
+            TAB_APPEND( p_sys->i_clients, p_sys->pp_clients, p_client );
+            vlc_mutex_unlock( &p_sys->client_lock );
         }
-        case 's':
-        case 'S':
-            ;
-            break;
 
-        case '\0':
-            /* Ignore empty lines */
-            break;
+        UpdateStatus( p_intf, b_showpos, &i_oldpos );
+    }
+}
 
-        default:
-            msg_rc(_("Unknown command `%s'. Type `help' for help."), psz_cmd);
-            break;
-        }
+/*****************************************************************************
+ * RunConsole: read commands from the standard input
+ *****************************************************************************/
+static void RunConsole( intf_thread_t *p_intf, bool b_showpos )
+{
+    intf_sys_t *p_sys = p_intf->p_sys;
+    char p_buffer[ MAX_LINE_LENGTH + 1 ];
+    int  i_size = 0;
+    int  i_oldpos = 0;
+    int  canc = vlc_savecancel( );
+
+    p_buffer[0] = 0;
+    VLC_UNUSED(p_sys);
+
+#if defined(_WIN32) && !VLC_WINSTORE_APP
+    /* Get the file descriptor of the console input */
+    p_sys->hConsoleIn = GetStdHandle(STD_INPUT_HANDLE);
+    if( p_sys->hConsoleIn == INVALID_HANDLE_VALUE )
+    {
+        msg_Err( p_intf, "couldn't find user input handle" );
+        vlc_restorecancel( canc );
+        return;
+    }
+#endif
+
+    for( ;; )
+    {
+        vlc_restorecancel( canc );
+        bool b_complete = ReadCommand( p_intf, p_buffer, &i_size );
+        canc = vlc_savecancel( );
+
+        UpdateStatus( p_intf, b_showpos, &i_oldpos );
+
+        /* Is there something to do? */
+        if( !b_complete ) continue;
+
+        ProcessLine( p_intf, p_buffer );
 
         /* Command processed */
         i_size = 0; p_buffer[0] = 0;
     }
+}
 
-    msg_rc( STATUS_CHANGE "( stop state: 0 )" );
-    msg_rc( STATUS_CHANGE "( quit )" );
+/*****************************************************************************
+ * Run: rc thread
+ *****************************************************************************
+ * This part of the interface is in a separate thread so that we can call
+ * exec() from within it without annoying the rest of the program.
+ *****************************************************************************/
+static void *Run( void *data )
+{
+    intf_thread_t *p_intf = data;
+    intf_sys_t *p_sys = p_intf->p_sys;
 
-    vlc_restorecancel( canc );
+    bool b_showpos = var_InheritBool( p_intf, "rc-show-pos" );
+    int canc = vlc_savecancel( );
 
+    /* Register commands that will be cleaned up upon object destruction */
+    RegisterCallbacks( p_intf );
+
+    vlc_restorecancel( canc );
+    if( p_sys->pi_socket_listen != NULL )
+        RunServer( p_intf, b_showpos );
+    else
+        RunConsole( p_intf, b_showpos );
     return NULL;
 }
 
@@ -998,7 +1187,7 @@ static int Input( vlc_object_t *p_this, char const *psz_cmd,
         }
         else
         {
-            var_SetInteger( p_intf->obj.libvlc, "key-action", ACTIONID_JUMP_FORWARD_EXTRASHORT );
+            vlc_actions_do( p_intf, ACTIONID_JUMP_FORWARD_EXTRASHORT );
         }
         i_error = VLC_SUCCESS;
     }
@@ -1012,7 +1201,7 @@ static int Input( vlc_object_t *p_this, char const *psz_cmd,
         }
         else
         {
-            var_SetInteger( p_intf->obj.libvlc, "key-action", ACTIONID_JUMP_BACKWARD_EXTRASHORT );
+            vlc_actions_do( p_intf, ACTIONID_JUMP_BACKWARD_EXTRASHORT );
         }
         i_error = VLC_SUCCESS;
     }
@@ -1827,36 +2016,19 @@ static bool ReadWin32( intf_thread_t *p_intf, unsigned char *p_buffer, int *pi_s
 bool ReadCommand( intf_thread_t *p_intf, char *p_buffer, int *pi_size )
 {
 #if defined(_WIN32) && !VLC_WINSTORE_APP
-    if( p_intf->p_sys->i_socket == -1 && !p_intf->p_sys->b_quiet )
+    if( !p_intf->p_sys->b_quiet )
         return ReadWin32( p_intf, (unsigned char*)p_buffer, pi_size );
-    else if( p_intf->p_sys->i_socket == -1 )
-    {
-        vlc_tick_sleep( INTF_IDLE_SLEEP );
-        return false;
-    }
-#endif
 
+    vlc_tick_sleep( INTF_IDLE_SLEEP );
+    return false;
+#else
     while( *pi_size < MAX_LINE_LENGTH )
     {
-        if( p_intf->p_sys->i_socket == -1 )
-        {
-            if( read( 0/*STDIN_FILENO*/, p_buffer + *pi_size, 1 ) <= 0 )
-            {   /* Standard input closed: exit */
-                libvlc_Quit( p_intf->obj.libvlc );
-                p_buffer[*pi_size] = 0;
-                return true;
-            }
-        }
-        else
-        {   /* Connection closed */
-            if( net_Read( p_intf, p_intf->p_sys->i_socket, p_buffer + *pi_size,
-                          1 ) <= 0 )
-            {
-                net_Close( p_intf->p_sys->i_socket );
-                p_intf->p_sys->i_socket = -1;
-                p_buffer[*pi_size] = 0;
-                return true;
-            }
+        if( read( 0/*STDIN_FILENO*/, p_buffer + *pi_size, 1 ) <= 0 )
+        {   /* Standard input closed: exit */
+            libvlc_Quit( p_intf->obj.libvlc );
+            p_buffer[*pi_size] = 0;
+            return true;
         }
 
         if( p_buffer[ *pi_size ] == '\r' || p_buffer[ *pi_size ] == '\n' )
@@ -1873,6 +2045,7 @@ bool ReadCommand( intf_thread_t *p_intf, char *p_buffer, int *pi_size )
     }
 
     return false;
+#endif
 }
 
 /*****************************************************************************
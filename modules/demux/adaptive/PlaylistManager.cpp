@@ -36,6 +36,7 @@
 #include "logic/AlwaysLowestAdaptationLogic.hpp"
 #include "logic/PredictiveAdaptationLogic.hpp"
 #include "logic/NearOptimalAdaptationLogic.hpp"
+#include "logic/DeliveryRateAdaptationLogic.hpp"
 #include "tools/Debug.hpp"
 #include <vlc_stream.h>
 #include <vlc_demux.h>
@@ -755,6 +756,16 @@ AbstractAdaptationLogic *PlaylistManager::createLogic(AbstractAdaptationLogic::L
             if(predictivelogic)
                 conn->setDownloadRateObserver(predictivelogic);
             logic = predictivelogic;
+            break;
+        }
+        case AbstractAdaptationLogic::DeliveryRate:
+        {
+            DeliveryRateAdaptationLogic *deliverylogic =
+                    new (std::nothrow) DeliveryRateAdaptationLogic(VLC_OBJECT(p_demux));
+            if(deliverylogic)
+                conn->setDownloadRateObserver(deliverylogic);
+            logic = deliverylogic;
+            break;
         }
 
         default:
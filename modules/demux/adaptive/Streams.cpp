@@ -487,14 +487,27 @@ block_t * AbstractStream::readNextBlock()
         return NULL;
     }
 
+    bool b_drained = false;
     if (currentChunk->isEmpty())
     {
         delete currentChunk;
         currentChunk = NULL;
+        b_drained = true;
     }
 
     block = checkBlock(block, b_segment_head_chunk);
 
+    if(b_drained && !discontinuity && !needrestart)
+    {
+        /* Request the next segment now instead of on the next call: its
+           source is scheduled for download on creation, so the round trip
+           overlaps demuxing of the data just delivered rather than stalling
+           the demuxer at every segment boundary. */
+        currentChunk = segmentTracker->getNextChunk(!fakeesout->restarting(), connManager);
+        if(currentChunk == NULL)
+            eof = true;
+    }
+
     return block;
 }
 
@@ -215,7 +215,10 @@ block_t * HTTPChunkSource::read(size_t readsize)
         if((size_t)ret < readsize)
             eof = true;
         if(ret && time)
+        {
             connManager->updateDownloadRate(sourceid, p_block->i_buffer, time);
+            connManager->updateDeliveryRate(sourceid, p_block->i_buffer, time, 0);
+        }
     }
 
     return p_block;
@@ -293,6 +296,7 @@ HTTPChunkBufferedSource::HTTPChunkBufferedSource(const std::string& url, Abstrac
     eof = false;
     held = false;
     downloadstart = 0;
+    requeststart = 0;
 }
 
 HTTPChunkBufferedSource::~HTTPChunkBufferedSource()
@@ -339,6 +343,8 @@ void HTTPChunkBufferedSource::release()
 void HTTPChunkBufferedSource::bufferize(size_t readsize)
 {
     vlc_mutex_lock(&lock);
+    if(!requeststart)
+        requeststart = vlc_tick_now();
     if(!prepare())
     {
         done = true;
@@ -348,6 +354,13 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         return;
     }
 
+    /* started on the first payload read: the request can be issued ahead
+       of time while another source is drained, and that queueing time is
+       not transfer time */
+    const bool b_firstread = (downloadstart == 0);
+    if(b_firstread)
+        downloadstart = vlc_tick_now();
+
     if(readsize < HTTPChunkSource::CHUNK_SIZE)
         readsize = HTTPChunkSource::CHUNK_SIZE;
 
@@ -369,7 +382,10 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         vlc_tick_t time;
     } rate = {0,0};
 
+    vlc_tick_t readstart = vlc_tick_now();
     ssize_t ret = connection->read(p_block->p_buffer, readsize);
+    vlc_tick_t readtime = vlc_tick_now() - readstart;
+    vlc_tick_t latency = 0;
     if(ret <= 0)
     {
         block_Release(p_block);
@@ -384,6 +400,8 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
     {
         p_block->i_buffer = (size_t) ret;
         vlc_mutex_locker locker( &lock );
+        if(b_firstread)
+            latency = vlc_tick_now() - requeststart;
         buffered += p_block->i_buffer;
         block_ChainLastAppend(&pp_tail, p_block);
         if((size_t) ret < readsize)
@@ -395,6 +413,9 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         }
     }
 
+    if(ret > 0)
+        connManager->updateDeliveryRate(sourceid, (size_t) ret, readtime, latency);
+
     if(rate.size && rate.time)
     {
         connManager->updateDownloadRate(sourceid, rate.size, rate.time);
@@ -403,14 +424,26 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
     vlc_cond_signal(&avail);
 }
 
-bool HTTPChunkBufferedSource::prepare()
+void HTTPChunkBufferedSource::startRequest()
 {
-    if(!prepared)
+    vlc_mutex_lock(&lock);
+    if(!done && !prepared)
     {
-        downloadstart = vlc_tick_now();
-        return HTTPChunkSource::prepare();
+        requeststart = vlc_tick_now();
+        if(!prepare())
+        {
+            done = true;
+            eof = true;
+            vlc_cond_signal(&avail);
+        }
     }
-    return true;
+    vlc_mutex_unlock(&lock);
+}
+
+bool HTTPChunkBufferedSource::isPrepared() const
+{
+    vlc_mutex_locker locker( &lock );
+    return prepared;
 }
 
 bool HTTPChunkBufferedSource::hasMoreData() const
@@ -461,7 +494,28 @@ block_t * HTTPChunkBufferedSource::read(size_t readsize)
         vlc_cond_wait(&avail, &lock);
 
     block_t *p_block = NULL;
-    if(!readsize || !buffered || !(p_block = block_Alloc(readsize)) )
+    if(!readsize || !buffered)
+    {
+        eof = true;
+        return NULL;
+    }
+
+    if(p_head->i_buffer == readsize)
+    {
+        /* The head block matches the request: hand it over zero-copy.
+           The copying path below is only needed to aggregate across
+           buffered block boundaries. */
+        p_block = p_head;
+        p_head = p_head->p_next;
+        if(p_head == NULL)
+            pp_tail = &p_head;
+        p_block->p_next = NULL;
+        consumed += readsize;
+        buffered -= readsize;
+        return p_block;
+    }
+
+    if(!(p_block = block_Alloc(readsize)))
     {
         eof = true;
         return NULL;
@@ -127,7 +127,8 @@ namespace adaptive
                 void               release();
 
             protected:
-                virtual bool       prepare(); /* reimpl */
+                void               startRequest();
+                bool               isPrepared() const;
                 void               bufferize(size_t);
                 bool               isDone() const;
 
@@ -138,6 +139,7 @@ namespace adaptive
                 bool                done;
                 bool                eof;
                 vlc_tick_t          downloadstart;
+                vlc_tick_t          requeststart;
                 vlc_cond_t          avail;
                 bool                held;
         };
@@ -106,6 +106,21 @@ void Downloader::Run()
 
         if(!chunks.empty())
         {
+            /* Issue the requests of the first few queued sources before
+             * draining the front one: their data then accumulates on the
+             * other connections in parallel and the following segment does
+             * not cost an idle round trip. The scheduling order gives the
+             * priority: playing segment first, then next, then prefetch. */
+            unsigned i_inflight = 0;
+            std::list<HTTPChunkBufferedSource *>::iterator it;
+            for(it = chunks.begin();
+                it != chunks.end() && i_inflight < MAX_INFLIGHT; ++it)
+            {
+                if(!(*it)->isPrepared())
+                    (*it)->startRequest();
+                i_inflight++;
+            }
+
             HTTPChunkBufferedSource *source = chunks.front();
             DownloadSource(source);
             if(source->isDone())
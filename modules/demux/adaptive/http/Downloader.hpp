@@ -41,6 +41,9 @@ namespace adaptive
                 void cancel(HTTPChunkBufferedSource *);
 
             private:
+                /* sources whose request is issued before they reach the
+                   front of the queue */
+                static const unsigned MAX_INFLIGHT = 3;
                 static void * downloaderThread(void *);
                 void Run();
                 void DownloadSource(HTTPChunkBufferedSource *);
@@ -53,6 +53,13 @@ void AbstractConnectionManager::updateDownloadRate(const adaptive::ID &sourceid,
         rateObserver->updateDownloadRate(sourceid, size, time);
 }
 
+void AbstractConnectionManager::updateDeliveryRate(const adaptive::ID &sourceid, size_t size,
+                                                   vlc_tick_t time, vlc_tick_t latency)
+{
+    if(rateObserver)
+        rateObserver->updateDeliveryRate(sourceid, size, time, latency);
+}
+
 void AbstractConnectionManager::setDownloadRateObserver(IDownloadRateObserver *obs)
 {
     rateObserver = obs;
@@ -54,6 +54,8 @@ namespace adaptive
                 virtual void cancel(AbstractChunkSource *) = 0;
 
                 virtual void updateDownloadRate(const ID &, size_t, vlc_tick_t); /* impl */
+                virtual void updateDeliveryRate(const ID &, size_t, vlc_tick_t,
+                                                vlc_tick_t); /* reimpl */
                 void setDownloadRateObserver(IDownloadRateObserver *);
 
             protected:
@@ -0,0 +1,346 @@
+/*
+ * ABRSimulator.cpp: offline adaptation logic simulator
+ *****************************************************************************
+ * Copyright (C) 2018 VideoLabs, VideoLAN and VLC Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*
+ * Replays scripted bandwidth traces against the adaptation logic
+ * implementations, without any network or demux machinery. Each simulated
+ * segment download is fed back through updateDownloadRate() and the tracker
+ * events the logics normally receive from SegmentTracker, and playback is
+ * modelled with a simple buffer drain, yielding per-logic stall time, switch
+ * counts and average selected bitrate. Built-in traces assert basic
+ * invariants so CI flags gross ABR regressions; extra traces can be passed
+ * as files of "<offset ms> <bits per second>" lines.
+ */
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "AbstractAdaptationLogic.h"
+#include "AlwaysBestAdaptationLogic.h"
+#include "AlwaysLowestAdaptationLogic.hpp"
+#include "RateBasedAdaptationLogic.h"
+#include "NearOptimalAdaptationLogic.hpp"
+#include "PredictiveAdaptationLogic.hpp"
+#include "../playlist/AbstractPlaylist.hpp"
+#include "../playlist/BasePeriod.h"
+#include "../playlist/BaseAdaptationSet.h"
+#include "../playlist/BaseRepresentation.h"
+#include "../SegmentTracker.hpp"
+#include "../ID.hpp"
+
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+
+using namespace adaptive;
+using namespace adaptive::logic;
+using namespace adaptive::playlist;
+
+namespace
+{
+    class SimulatedPlaylist : public AbstractPlaylist
+    {
+        public:
+            SimulatedPlaylist() : AbstractPlaylist(NULL) {}
+            virtual bool isLive() const { return false; }
+            virtual void debug() {}
+    };
+
+    struct TraceStep
+    {
+        vlc_tick_t start;
+        unsigned   bps;
+    };
+
+    struct SimResult
+    {
+        SimResult() : startup(0), stall(0), switches(0), segments(0),
+                      bits(0) {}
+        vlc_tick_t startup;
+        vlc_tick_t stall;
+        unsigned   switches;
+        unsigned   segments;
+        uint64_t   bits;
+    };
+}
+
+#define SEGMENT_DURATION VLC_TICK_FROM_SEC(4)
+#define BUFFER_MINIMUM   VLC_TICK_FROM_SEC(6)
+#define BUFFER_TARGET    VLC_TICK_FROM_SEC(30)
+
+static const uint64_t ladder[] =
+    { 128000, 400000, 1000000, 2500000, 5000000, 8000000 };
+
+static unsigned traceBandwidth(const std::vector<TraceStep> &trace,
+                               vlc_tick_t now)
+{
+    unsigned bps = trace.front().bps;
+    for(size_t i = 0; i < trace.size() && trace[i].start <= now; i++)
+        bps = trace[i].bps;
+    return bps;
+}
+
+static void simulate(AbstractAdaptationLogic *logic, BaseAdaptationSet *set,
+                     const std::vector<TraceStep> &trace, vlc_tick_t duration,
+                     SimResult &res)
+{
+    const ID &id = set->getID();
+    vlc_tick_t now = 0;
+    vlc_tick_t buffered = 0;
+    BaseRepresentation *current = NULL;
+
+    logic->trackerEvent(SegmentTrackerEvent(id, true));
+
+    while(now < duration)
+    {
+        BaseRepresentation *next = logic->getNextRepresentation(set, current);
+        if(next == NULL)
+            next = current;
+        assert(next);
+        if(next != current)
+        {
+            logic->trackerEvent(SegmentTrackerEvent(current, next));
+            if(current)
+                res.switches++;
+            current = next;
+        }
+
+        /* Download one segment worth of payload over the scripted network,
+         * integrating the trace in 100ms slices */
+        const uint64_t need = current->getBandwidth()
+                            * SEC_FROM_VLC_TICK(SEGMENT_DURATION) / 8;
+        uint64_t got = 0;
+        vlc_tick_t dltime = 0;
+        while(got < need)
+        {
+            const unsigned bps = traceBandwidth(trace, now + dltime);
+            got += (uint64_t)bps / 8 / 10; /* bytes per 100ms */
+            dltime += VLC_TICK_FROM_MS(100);
+        }
+        logic->updateDownloadRate(id, need, dltime);
+
+        /* Playback drains the buffer while downloading; an empty buffer
+         * before the first segment is startup delay, not a stall */
+        now += dltime;
+        if(res.segments == 0)
+            res.startup = dltime;
+        else if(buffered < dltime)
+        {
+            res.stall += dltime - buffered;
+            buffered = 0;
+        }
+        else
+            buffered -= dltime;
+        buffered += SEGMENT_DURATION;
+
+        logic->trackerEvent(SegmentTrackerEvent(id, BUFFER_MINIMUM, buffered,
+                                                BUFFER_TARGET));
+        logic->trackerEvent(SegmentTrackerEvent(id, SEGMENT_DURATION));
+
+        res.segments++;
+        res.bits += current->getBandwidth()
+                  * SEC_FROM_VLC_TICK(SEGMENT_DURATION);
+
+        /* Throttle to the buffer target, playing back meanwhile */
+        if(buffered > BUFFER_TARGET)
+        {
+            now += buffered - BUFFER_TARGET;
+            buffered = BUFFER_TARGET;
+        }
+    }
+
+    logic->trackerEvent(SegmentTrackerEvent(id, false));
+}
+
+static AbstractAdaptationLogic *createLogic(AbstractAdaptationLogic::LogicType type)
+{
+    switch(type)
+    {
+        case AbstractAdaptationLogic::AlwaysBest:
+            return new AlwaysBestAdaptationLogic();
+        case AbstractAdaptationLogic::AlwaysLowest:
+            return new AlwaysLowestAdaptationLogic();
+        case AbstractAdaptationLogic::RateBased:
+            return new RateBasedAdaptationLogic(NULL);
+        case AbstractAdaptationLogic::NearOptimal:
+            return new NearOptimalAdaptationLogic();
+        case AbstractAdaptationLogic::Predictive:
+            return new PredictiveAdaptationLogic(NULL);
+        default:
+            return NULL;
+    }
+}
+
+static const struct
+{
+    const char *name;
+    AbstractAdaptationLogic::LogicType type;
+} logics[] = {
+    { "alwayslowest", AbstractAdaptationLogic::AlwaysLowest },
+    { "alwaysbest",   AbstractAdaptationLogic::AlwaysBest },
+    { "ratebased",    AbstractAdaptationLogic::RateBased },
+    { "nearoptimal",  AbstractAdaptationLogic::NearOptimal },
+    { "predictive",   AbstractAdaptationLogic::Predictive },
+};
+
+static int runTrace(const char *name, const std::vector<TraceStep> &trace,
+                    vlc_tick_t duration, bool assertions)
+{
+    int failures = 0;
+
+    for(size_t i = 0; i < ARRAY_SIZE(logics); i++)
+    {
+        SimulatedPlaylist playlist;
+        BasePeriod *period = new BasePeriod(&playlist);
+        playlist.addPeriod(period);
+        BaseAdaptationSet *set = new BaseAdaptationSet(period);
+        set->setID(ID(1));
+        period->addAdaptationSet(set);
+        for(size_t j = 0; j < ARRAY_SIZE(ladder); j++)
+        {
+            BaseRepresentation *rep = new BaseRepresentation(set);
+            rep->setBandwidth(ladder[j]);
+            set->addRepresentation(rep);
+        }
+
+        AbstractAdaptationLogic *logic = createLogic(logics[i].type);
+        assert(logic);
+
+        SimResult res;
+        simulate(logic, set, trace, duration, res);
+        delete logic;
+
+        const uint64_t meankbps = (res.segments > 0) ? res.bits / 1000
+            / (res.segments * SEC_FROM_VLC_TICK(SEGMENT_DURATION)) : 0;
+
+        printf("abr: %-12s %-12s: startup %5" PRId64 " ms, stall %6" PRId64
+               " ms, %2u switch(es), mean %5" PRIu64 " kbps\n",
+               logics[i].name, name, MS_FROM_VLC_TICK(res.startup),
+               MS_FROM_VLC_TICK(res.stall), res.switches, meankbps);
+
+        if(assertions)
+        {
+            if(logics[i].type == AbstractAdaptationLogic::AlwaysLowest &&
+               (res.switches != 0 || meankbps != ladder[0] / 1000))
+            {
+                fprintf(stderr, "abr: FAIL %s did not stick to lowest\n",
+                        logics[i].name);
+                failures++;
+            }
+            if(logics[i].type == AbstractAdaptationLogic::AlwaysBest &&
+               (res.switches != 0 ||
+                meankbps != ladder[ARRAY_SIZE(ladder) - 1] / 1000))
+            {
+                fprintf(stderr, "abr: FAIL %s did not stick to highest\n",
+                        logics[i].name);
+                failures++;
+            }
+            /* On a steady link faster than the top rendition, no logic may
+             * stall once playback has started */
+            if(trace.size() == 1 &&
+               trace.front().bps > ladder[ARRAY_SIZE(ladder) - 1] &&
+               res.stall != 0)
+            {
+                fprintf(stderr, "abr: FAIL %s stalled on a steady link\n",
+                        logics[i].name);
+                failures++;
+            }
+        }
+    }
+
+    return failures;
+}
+
+static bool loadTrace(const char *path, std::vector<TraceStep> &trace)
+{
+    FILE *stream = fopen(path, "rt");
+    if(stream == NULL)
+    {
+        fprintf(stderr, "abr: cannot open trace %s\n", path);
+        return false;
+    }
+
+    unsigned long ms;
+    unsigned bps;
+    while(fscanf(stream, "%lu %u", &ms, &bps) == 2)
+    {
+        TraceStep step = { VLC_TICK_FROM_MS((vlc_tick_t)ms), bps };
+        trace.push_back(step);
+    }
+    fclose(stream);
+
+    if(trace.empty() || trace.front().start != 0)
+    {
+        fprintf(stderr, "abr: invalid trace %s "
+                "(expected \"<offset ms> <bps>\" lines from offset 0)\n", path);
+        trace.clear();
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int failures = 0;
+
+    /* Steady link faster than the top rendition */
+    std::vector<TraceStep> steady;
+    TraceStep full = { 0, 10000000 };
+    steady.push_back(full);
+    failures += runTrace("steady", steady, VLC_TICK_FROM_SEC(120), true);
+
+    /* Capacity step down and back up */
+    std::vector<TraceStep> stepped;
+    TraceStep up = { 0, 6000000 };
+    TraceStep down = { VLC_TICK_FROM_SEC(40), 1200000 };
+    TraceStep back = { VLC_TICK_FROM_SEC(80), 6000000 };
+    stepped.push_back(up);
+    stepped.push_back(down);
+    stepped.push_back(back);
+    failures += runTrace("step", stepped, VLC_TICK_FROM_SEC(120), true);
+
+    /* Square wave oscillation, 10s half-period */
+    std::vector<TraceStep> oscillation;
+    for(unsigned i = 0; i < 12; i++)
+    {
+        TraceStep step = { VLC_TICK_FROM_SEC(10) * i,
+                           (i & 1) ? 900000u : 4000000u };
+        oscillation.push_back(step);
+    }
+    failures += runTrace("oscillation", oscillation, VLC_TICK_FROM_SEC(120),
+                         true);
+
+    /* Captured traces given on the command line are replayed for reporting
+     * only: there is no universally right answer on a real capture */
+    for(int i = 1; i < argc; i++)
+    {
+        std::vector<TraceStep> trace;
+        if(!loadTrace(argv[i], trace))
+        {
+            failures++;
+            continue;
+        }
+        vlc_tick_t duration = trace.back().start + VLC_TICK_FROM_SEC(30);
+        runTrace(argv[i], trace, duration, false);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+/*
+ * DeliveryRateAdaptationLogic.cpp
+ *****************************************************************************
+ * Copyright (C) 2019 - VideoLAN Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "DeliveryRateAdaptationLogic.hpp"
+#include "Representationselectors.hpp"
+
+#include "../playlist/BaseRepresentation.h"
+#include "../playlist/BaseAdaptationSet.h"
+#include "../tools/Debug.hpp"
+
+using namespace adaptive::logic;
+using namespace adaptive;
+
+/* samples are kept in the max filter for this long */
+static const vlc_tick_t RATE_WINDOW_LENGTH  = VLC_TICK_FROM_SEC(10);
+/* the min-RTT estimate expires after this long */
+static const vlc_tick_t RTT_WINDOW_LENGTH   = VLC_TICK_FROM_SEC(30);
+/* floor for the sampling interval when the RTT is tiny or unknown */
+static const vlc_tick_t MIN_SAMPLE_INTERVAL = VLC_TICK_FROM_MS(50);
+
+DeliveryRateAdaptationLogic::DeliveryRateAdaptationLogic(vlc_object_t *p_obj_) :
+                             AbstractAdaptationLogic()
+{
+    minRTT = 0;
+    minRTTCapture = 0;
+    pendingBytes = 0;
+    pendingTime = 0;
+    usedBps = 0;
+    p_obj = p_obj_;
+    vlc_mutex_init(&lock);
+}
+
+DeliveryRateAdaptationLogic::~DeliveryRateAdaptationLogic()
+{
+    vlc_mutex_destroy(&lock);
+}
+
+BaseRepresentation *DeliveryRateAdaptationLogic::getNextRepresentation(BaseAdaptationSet *adaptSet, BaseRepresentation *currep)
+{
+    if(adaptSet == NULL)
+        return NULL;
+
+    vlc_mutex_lock(&lock);
+    size_t maxBps = 0;
+    std::list<RateSample>::const_iterator it;
+    for(it = window.begin(); it != window.end(); ++it)
+        if((*it).bps > maxBps)
+            maxBps = (*it).bps;
+    size_t availBps = maxBps - maxBps / 8; /* headroom on the max estimate */
+    availBps += (currep) ? currep->getBandwidth() : 0;
+    size_t used = usedBps;
+    vlc_mutex_unlock(&lock);
+
+    if(availBps > used)
+        availBps -= used;
+    else
+        availBps = 0;
+
+    RepresentationSelector selector(maxwidth, maxheight);
+    BaseRepresentation *rep = selector.select(adaptSet, availBps);
+    if ( rep == NULL )
+    {
+        rep = selector.select(adaptSet);
+        if ( rep == NULL )
+            return NULL;
+    }
+
+    return rep;
+}
+
+void DeliveryRateAdaptationLogic::updateDeliveryRate(const ID &, size_t size,
+                                                     vlc_tick_t time, vlc_tick_t latency)
+{
+    if(unlikely(time == 0))
+        return;
+
+    vlc_mutex_lock(&lock);
+    const vlc_tick_t now = vlc_tick_now();
+
+    if(latency > 0 &&
+       (minRTT == 0 || latency < minRTT ||
+        now - minRTTCapture > RTT_WINDOW_LENGTH))
+    {
+        minRTT = latency;
+        minRTTCapture = now;
+    }
+
+    /* Aggregate reads until they span at least one round trip: rates
+     * measured below that granularity only tell how fast the kernel
+     * buffer was drained, not what the path delivers */
+    pendingBytes += size;
+    pendingTime += time;
+
+    vlc_tick_t interval = (minRTT > MIN_SAMPLE_INTERVAL) ? minRTT
+                                                         : MIN_SAMPLE_INTERVAL;
+    if(pendingTime < interval)
+    {
+        vlc_mutex_unlock(&lock);
+        return;
+    }
+
+    RateSample sample;
+    sample.when = now;
+    sample.bps = CLOCK_FREQ * pendingBytes * 8 / pendingTime;
+    pendingBytes = 0;
+    pendingTime = 0;
+
+    window.push_back(sample);
+    while(!window.empty() && now - window.front().when > RATE_WINDOW_LENGTH)
+        window.pop_front();
+
+    BwDebug(msg_Dbg(p_obj, "delivery sample %zu KiB/s minrtt %" PRId64 "ms "
+                           "(%zu in window)",
+                    sample.bps / 8000, MS_FROM_VLC_TICK(minRTT), window.size()));
+    vlc_mutex_unlock(&lock);
+}
+
+void DeliveryRateAdaptationLogic::trackerEvent(const SegmentTrackerEvent &event)
+{
+    if(event.type == SegmentTrackerEvent::SWITCHING)
+    {
+        vlc_mutex_lock(&lock);
+        if(event.u.switching.prev)
+            usedBps -= event.u.switching.prev->getBandwidth();
+        if(event.u.switching.next)
+            usedBps += event.u.switching.next->getBandwidth();
+
+        BwDebug(msg_Info(p_obj, "New bandwidth usage %zu KiB/s",
+                        (usedBps / 8000)));
+        vlc_mutex_unlock(&lock);
+    }
+}
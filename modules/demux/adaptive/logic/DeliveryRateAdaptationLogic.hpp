@@ -0,0 +1,69 @@
+/*
+ * DeliveryRateAdaptationLogic.hpp
+ *****************************************************************************
+ * Copyright (C) 2019 - VideoLAN Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef DELIVERYRATEADAPTATIONLOGIC_HPP
+#define DELIVERYRATEADAPTATIONLOGIC_HPP
+
+#include "AbstractAdaptationLogic.h"
+
+#include <list>
+
+namespace adaptive
+{
+    namespace logic
+    {
+        /* BBR style estimator: instead of smoothing whole segment download
+         * rates, it aggregates the per-read delivery samples over at least
+         * one round trip and keeps the windowed maximum, so short segments
+         * and competing streams no longer drag the estimate down */
+        class DeliveryRateAdaptationLogic : public AbstractAdaptationLogic
+        {
+            public:
+                DeliveryRateAdaptationLogic     (vlc_object_t *);
+                virtual ~DeliveryRateAdaptationLogic();
+
+                BaseRepresentation *getNextRepresentation(BaseAdaptationSet *, BaseRepresentation *);
+                virtual void updateDeliveryRate(const ID &, size_t,
+                                                vlc_tick_t, vlc_tick_t); /* reimpl */
+                virtual void trackerEvent(const SegmentTrackerEvent &); /* reimpl */
+
+            private:
+                struct RateSample
+                {
+                    vlc_tick_t when;
+                    size_t     bps;
+                };
+                std::list<RateSample>   window; /* delivery rate max filter */
+
+                vlc_tick_t              minRTT;
+                vlc_tick_t              minRTTCapture;
+
+                /* reads aggregated into the pending sample */
+                size_t                  pendingBytes;
+                vlc_tick_t              pendingTime;
+
+                size_t                  usedBps;
+                vlc_object_t *          p_obj;
+                vlc_mutex_t             lock;
+        };
+    }
+}
+
+#endif /* DELIVERYRATEADAPTATIONLOGIC_HPP */
@@ -35,6 +35,12 @@ namespace adaptive
     {
         public:
             virtual void updateDownloadRate(const ID &, size_t, vlc_tick_t) = 0;
+            /* Fine grained per-read delivery sample: bytes, read interval
+               and, on the first payload read only, the request to first
+               byte latency. Estimators without sub-segment feedback can
+               rely on the default. */
+            virtual void updateDeliveryRate(const ID &, size_t, vlc_tick_t,
+                                            vlc_tick_t) {}
             virtual ~IDownloadRateObserver(){}
     };
 }
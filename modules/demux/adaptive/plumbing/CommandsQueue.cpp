@@ -29,6 +29,7 @@
 #include <vlc_meta.h>
 #include <algorithm>
 #include <set>
+#include <cstddef>
 
 using namespace adaptive;
 
@@ -181,38 +182,164 @@ void EsOutMetaCommand::Execute( es_out_t *out )
     es_out_Control( out, ES_OUT_SET_GROUP_META, group, p_meta );
 }
 
+/*
+ * Commands arena
+ */
+
+/* Chunks are uniform so any command class fits any free chunk */
+static const size_t COMMAND_STORAGE_SIZE =
+    __MAX( sizeof (EsOutSendCommand),
+    __MAX( sizeof (EsOutDelCommand),
+    __MAX( sizeof (EsOutAddCommand),
+    __MAX( sizeof (EsOutControlPCRCommand),
+    __MAX( sizeof (EsOutDestroyCommand),
+    __MAX( sizeof (EsOutControlResetPCRCommand),
+           sizeof (EsOutMetaCommand) ) ) ) ) ) );
+static const unsigned COMMANDS_PER_SLAB = 256;
+
+struct CommandsArena::chunk
+{
+    union
+    {
+        CommandsArena *p_owner; /* of the live command, NULL when unpooled */
+        chunk *p_next;          /* freelist link while unused */
+        max_align_t align;
+    };
+    unsigned char storage[COMMAND_STORAGE_SIZE];
+};
+
+CommandsArena::CommandsArena()
+{
+    freelist = NULL;
+    vlc_mutex_init( &lock );
+}
+
+CommandsArena::~CommandsArena()
+{
+    /* The queue aborts before deleting its factory, so every command
+       has been released by now */
+    std::list<chunk *>::iterator it;
+    for( it = slabs.begin(); it != slabs.end(); ++it )
+        free( *it );
+    vlc_mutex_destroy( &lock );
+}
+
+void * CommandsArena::alloc( size_t i_size )
+{
+    if( unlikely(i_size > COMMAND_STORAGE_SIZE) )
+        return allocUnpooled( i_size );
+
+    vlc_mutex_lock( &lock );
+    if( freelist == NULL )
+    {
+        chunk *slab = static_cast<chunk *>(
+            malloc( COMMANDS_PER_SLAB * sizeof (chunk) ) );
+        if( unlikely(slab == NULL) )
+        {
+            vlc_mutex_unlock( &lock );
+            return NULL;
+        }
+        slabs.push_back( slab );
+        for( unsigned i = 0; i < COMMANDS_PER_SLAB; i++ )
+        {
+            slab[i].p_next = freelist;
+            freelist = &slab[i];
+        }
+    }
+    chunk *p_chunk = freelist;
+    freelist = p_chunk->p_next;
+    vlc_mutex_unlock( &lock );
+
+    p_chunk->p_owner = this;
+    return p_chunk->storage;
+}
+
+void * CommandsArena::allocUnpooled( size_t i_size )
+{
+    chunk *p_chunk = static_cast<chunk *>(
+        malloc( offsetof(chunk, storage) + i_size ) );
+    if( unlikely(p_chunk == NULL) )
+        return NULL;
+    p_chunk->p_owner = NULL;
+    return p_chunk->storage;
+}
+
+void CommandsArena::release( void *p_storage )
+{
+    chunk *p_chunk = reinterpret_cast<chunk *>(
+        static_cast<unsigned char *>( p_storage ) - offsetof(chunk, storage) );
+    CommandsArena *arena = p_chunk->p_owner;
+    if( arena == NULL )
+    {
+        free( p_chunk );
+        return;
+    }
+    vlc_mutex_lock( &arena->lock );
+    p_chunk->p_next = arena->freelist;
+    arena->freelist = p_chunk;
+    vlc_mutex_unlock( &arena->lock );
+}
+
+void * AbstractCommand::operator new( size_t i_size, CommandsArena &arena ) throw()
+{
+    return arena.alloc( i_size );
+}
+
+void * AbstractCommand::operator new( size_t i_size, const std::nothrow_t & ) throw()
+{
+    return CommandsArena::allocUnpooled( i_size );
+}
+
+void AbstractCommand::operator delete( void *p_storage )
+{
+    if( p_storage )
+        CommandsArena::release( p_storage );
+}
+
+void AbstractCommand::operator delete( void *p_storage, CommandsArena & )
+{
+    if( p_storage )
+        CommandsArena::release( p_storage );
+}
+
+void AbstractCommand::operator delete( void *p_storage, const std::nothrow_t & )
+{
+    if( p_storage )
+        CommandsArena::release( p_storage );
+}
+
 /*
  * Commands Default Factory
  */
 
 EsOutSendCommand * CommandsFactory::createEsOutSendCommand( FakeESOutID *id, block_t *p_block ) const
 {
-    return new (std::nothrow) EsOutSendCommand( id, p_block );
+    return new (arena) EsOutSendCommand( id, p_block );
 }
 
 EsOutDelCommand * CommandsFactory::createEsOutDelCommand( FakeESOutID *id ) const
 {
-    return new (std::nothrow) EsOutDelCommand( id );
+    return new (arena) EsOutDelCommand( id );
 }
 
 EsOutAddCommand * CommandsFactory::createEsOutAddCommand( FakeESOutID *id ) const
 {
-    return new (std::nothrow) EsOutAddCommand( id );
+    return new (arena) EsOutAddCommand( id );
 }
 
 EsOutControlPCRCommand * CommandsFactory::createEsOutControlPCRCommand( int group, vlc_tick_t pcr ) const
 {
-    return new (std::nothrow) EsOutControlPCRCommand( group, pcr );
+    return new (arena) EsOutControlPCRCommand( group, pcr );
 }
 
 EsOutDestroyCommand * CommandsFactory::createEsOutDestroyCommand() const
 {
-    return new (std::nothrow) EsOutDestroyCommand();
+    return new (arena) EsOutDestroyCommand();
 }
 
 EsOutControlResetPCRCommand * CommandsFactory::creatEsOutControlResetPCRCommand() const
 {
-    return new (std::nothrow) EsOutControlResetPCRCommand();
+    return new (arena) EsOutControlResetPCRCommand();
 }
 
 EsOutMetaCommand * CommandsFactory::createEsOutMetaCommand( int group, const vlc_meta_t *p_meta ) const
@@ -221,7 +348,7 @@ EsOutMetaCommand * CommandsFactory::createEsOutMetaCommand( int group, const vlc
     if( p_dup )
     {
         vlc_meta_Merge( p_dup, p_meta );
-        return new (std::nothrow) EsOutMetaCommand( group, p_dup );
+        return new (arena) EsOutMetaCommand( group, p_dup );
     }
     return NULL;
 }
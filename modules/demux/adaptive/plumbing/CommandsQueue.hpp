@@ -25,11 +25,13 @@
 
 #include <atomic>
 #include <list>
+#include <new>
 
 namespace adaptive
 {
     class FakeESOut;
     class FakeESOutID;
+    class CommandsArena;
 
     class AbstractCommand
     {
@@ -39,6 +41,13 @@ namespace adaptive
             virtual void Execute( es_out_t * ) = 0;
             virtual vlc_tick_t getTime() const;
             int getType() const;
+            /* Commands are carved from the factory's arena; both forms
+               return NULL on failure */
+            static void * operator new( size_t, CommandsArena & ) throw();
+            static void * operator new( size_t, const std::nothrow_t & ) throw();
+            static void operator delete( void * );
+            static void operator delete( void *, CommandsArena & );
+            static void operator delete( void *, const std::nothrow_t & );
 
         protected:
             AbstractCommand( int );
@@ -133,6 +142,26 @@ namespace adaptive
             vlc_meta_t *p_meta;
     };
 
+    /* Arena allocating the commands from slab-sized batches of reusable
+       fixed-size chunks, as scheduling runs per-sample and must not hammer
+       the heap allocator */
+    class CommandsArena
+    {
+        friend class AbstractCommand;
+        public:
+            CommandsArena();
+            ~CommandsArena();
+
+        private:
+            struct chunk;
+            void * alloc( size_t );
+            static void * allocUnpooled( size_t );
+            static void release( void * );
+            chunk *freelist;
+            std::list<chunk *> slabs;
+            vlc_mutex_t lock;
+    };
+
     /* Factory so we can alter behaviour and filter on execution */
     class CommandsFactory
     {
@@ -145,6 +174,9 @@ namespace adaptive
             virtual EsOutControlResetPCRCommand * creatEsOutControlResetPCRCommand() const;
             virtual EsOutDestroyCommand * createEsOutDestroyCommand() const;
             virtual EsOutMetaCommand * createEsOutMetaCommand( int, const vlc_meta_t * ) const;
+
+        protected:
+            mutable CommandsArena arena;
     };
 
     /* Queuing for doing all the stuff in order */
@@ -90,8 +90,14 @@ bool FakeESOutID::isCompatible( const FakeESOutID *p_other ) const
                     return false;
             }
 
-            return es_format_IsSimilar( &p_other->fmt, &fmt ) &&
-                   !p_other->fmt.i_extra && !fmt.i_extra;
+            /* Matching init data gets the decoder restarted in the same
+               state, so switching back to a rendition reuses its ES */
+            if(fmt.i_extra != p_other->fmt.i_extra ||
+               (fmt.i_extra &&
+                memcmp(fmt.p_extra, p_other->fmt.p_extra, fmt.i_extra)))
+                return false;
+
+            return es_format_IsSimilar( &p_other->fmt, &fmt );
     }
 }
 
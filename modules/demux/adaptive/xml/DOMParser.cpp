@@ -162,11 +162,7 @@ void    DOMParser::addAttributesToNode      (Node *node)
     const char *attrName;
 
     while((attrName = xml_ReaderNextAttr(this->vlc_reader, &attrValue)) != NULL)
-    {
-        std::string key     = attrName;
-        std::string value   = attrValue;
-        node->addAttribute(key, value);
-    }
+        node->addAttribute(attrName, attrValue);
 }
 void    DOMParser::print                    (Node *node, int offset)
 {
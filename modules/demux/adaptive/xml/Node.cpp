@@ -64,28 +64,39 @@ void                                Node::setName               (const std::stri
 
 bool                                Node::hasAttribute        (const std::string& name) const
 {
-    if(this->attributes.find(name) != this->attributes.end())
-        return true;
+    Attributes::const_iterator it;
+    for(it = this->attributes.begin(); it != this->attributes.end(); ++it)
+        if(it->first == name)
+            return true;
 
     return false;
 }
 const std::string&                  Node::getAttributeValue     (const std::string& key) const
 {
-    std::map<std::string, std::string>::const_iterator  it = this->attributes.find( key );
+    Attributes::const_iterator it;
+    for(it = this->attributes.begin(); it != this->attributes.end(); ++it)
+        if(it->first == key)
+            return it->second;
 
-    if ( it != this->attributes.end() )
-        return it->second;
     return EmptyString;
 }
 
 void                                Node::addAttribute          ( const std::string& key, const std::string& value)
 {
-    this->attributes[key] = value;
+    Attributes::iterator it;
+    for(it = this->attributes.begin(); it != this->attributes.end(); ++it)
+        if(it->first == key)
+        {
+            it->second = value;
+            return;
+        }
+
+    this->attributes.push_back(std::make_pair(key, value));
 }
 std::vector<std::string>            Node::getAttributeKeys      () const
 {
     std::vector<std::string> keys;
-    std::map<std::string, std::string>::const_iterator it;
+    Attributes::const_iterator it;
 
     for(it = this->attributes.begin(); it != this->attributes.end(); ++it)
     {
@@ -104,7 +115,7 @@ void Node::setText(const std::string &text)
     this->text = text;
 }
 
-const std::map<std::string,std::string>&   Node::getAttributes         () const
+const Node::Attributes&                    Node::getAttributes         () const
 {
     return this->attributes;
 }
@@ -27,7 +27,7 @@
 
 #include <vector>
 #include <string>
-#include <map>
+#include <utility>
 
 namespace adaptive
 {
@@ -36,6 +36,11 @@ namespace adaptive
         class Node
         {
             public:
+                /* Elements have few attributes, a flat array beats a
+                 * tree of per-node allocations on large manifests */
+                typedef std::vector<std::pair<std::string, std::string> >
+                        Attributes;
+
                 Node            ();
                 virtual ~Node   ();
 
@@ -49,7 +54,7 @@ namespace adaptive
                 std::vector<std::string>            getAttributeKeys    () const;
                 const std::string&                  getText             () const;
                 void                                setText( const std::string &text );
-                const std::map<std::string, std::string>& getAttributes () const;
+                const Attributes&                   getAttributes       () const;
                 int                                 getType() const;
                 void                                setType( int type );
                 std::vector<std::string>            toString(int) const;
@@ -57,7 +62,7 @@ namespace adaptive
             private:
                 static const std::string            EmptyString;
                 std::vector<Node *>                 subNodes;
-                std::map<std::string, std::string>  attributes;
+                Attributes                          attributes;
                 std::string                         name;
                 std::string                         text;
                 int                                 type;
@@ -89,45 +89,32 @@ MPD * IsoffMainParser::parse()
 
 void    IsoffMainParser::parseMPDAttributes   (MPD *mpd, xml::Node *node)
 {
-    const std::map<std::string, std::string> & attr = node->getAttributes();
+    const Node::Attributes & attrs = node->getAttributes();
 
-    std::map<std::string, std::string>::const_iterator it;
-
-    it = attr.find("mediaPresentationDuration");
-    if(it != attr.end())
-        mpd->duration.Set(IsoTime(it->second) * CLOCK_FREQ);
-
-    it = attr.find("minBufferTime");
-    if(it != attr.end())
-        mpd->setMinBuffering(IsoTime(it->second) * CLOCK_FREQ);
-
-    it = attr.find("minimumUpdatePeriod");
-    if(it != attr.end())
+    Node::Attributes::const_iterator it;
+    for(it = attrs.begin(); it != attrs.end(); ++it)
     {
-        vlc_tick_t minupdate = IsoTime(it->second) * CLOCK_FREQ;
-        if(minupdate > 0)
-            mpd->minUpdatePeriod.Set(minupdate);
-    }
-
-    it = attr.find("maxSegmentDuration");
-    if(it != attr.end())
-        mpd->maxSegmentDuration.Set(IsoTime(it->second) * CLOCK_FREQ);
-
-    it = attr.find("type");
-    if(it != attr.end())
-        mpd->setType(it->second);
-
-    it = attr.find("availabilityStartTime");
-    if(it != attr.end())
-        mpd->availabilityStartTime.Set(UTCTime(it->second).time());
-
-    it = attr.find("timeShiftBufferDepth");
-        if(it != attr.end())
+        if(it->first == "mediaPresentationDuration")
+            mpd->duration.Set(IsoTime(it->second) * CLOCK_FREQ);
+        else if(it->first == "minBufferTime")
+            mpd->setMinBuffering(IsoTime(it->second) * CLOCK_FREQ);
+        else if(it->first == "minimumUpdatePeriod")
+        {
+            vlc_tick_t minupdate = IsoTime(it->second) * CLOCK_FREQ;
+            if(minupdate > 0)
+                mpd->minUpdatePeriod.Set(minupdate);
+        }
+        else if(it->first == "maxSegmentDuration")
+            mpd->maxSegmentDuration.Set(IsoTime(it->second) * CLOCK_FREQ);
+        else if(it->first == "type")
+            mpd->setType(it->second);
+        else if(it->first == "availabilityStartTime")
+            mpd->availabilityStartTime.Set(UTCTime(it->second).time());
+        else if(it->first == "timeShiftBufferDepth")
             mpd->timeShiftBufferDepth.Set(IsoTime(it->second) * CLOCK_FREQ);
-
-    it = attr.find("suggestedPresentationDelay");
-    if(it != attr.end())
-        mpd->suggestedPresentationDelay.Set(IsoTime(it->second) * CLOCK_FREQ);
+        else if(it->first == "suggestedPresentationDelay")
+            mpd->suggestedPresentationDelay.Set(IsoTime(it->second) * CLOCK_FREQ);
+    }
 }
 
 void IsoffMainParser::parsePeriods(MPD *mpd, Node *root)
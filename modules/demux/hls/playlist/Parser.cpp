@@ -194,6 +194,19 @@ void M3U8Parser::parseSegments(vlc_object_t *, Representation *rep, const std::l
 {
     SegmentList *segmentList = new (std::nothrow) SegmentList(rep);
 
+    /* Live refreshes only append: segments at or below the last known
+       sequence number are walked for running context (durations, keys,
+       byteranges) but no object is created for them, so a refresh costs
+       the new segments and not the whole DVR window */
+    uint64_t lowestUnknownSequence = 0;
+    if(rep->b_loaded)
+    {
+        std::vector<ISegment *> knownSegments;
+        rep->getSegments(SegmentInformation::INFOTYPE_MEDIA, knownSegments);
+        if(!knownSegments.empty())
+            lowestUnknownSequence = knownSegments.back()->getSequenceNumber() + 1;
+    }
+
     rep->setTimescale(100);
     rep->b_loaded = true;
 
@@ -236,13 +249,7 @@ void M3U8Parser::parseSegments(vlc_object_t *, Representation *rep, const std::l
                     break;
                 }
 
-                HLSSegment *segment = new (std::nothrow) HLSSegment(rep, sequenceNumber++);
-                if(!segment)
-                    break;
-
-                segment->setSourceUrl(uritag->getValue().value);
-                if((unsigned)rep->getStreamFormat() == StreamFormat::UNKNOWN)
-                    setFormatFromExtension(rep, uritag->getValue().value);
+                const uint64_t segmentNumber = sequenceNumber++;
 
                 /* Need to use EXTXTARGETDURATION as default as some can't properly set segment one */
                 double duration = rep->targetDuration;
@@ -254,6 +261,38 @@ void M3U8Parser::parseSegments(vlc_object_t *, Representation *rep, const std::l
                     ctx_extinf = NULL;
                 }
                 const vlc_tick_t nzDuration = vlc_tick_from_sec( duration );
+
+                std::pair<std::size_t,std::size_t> range(0, 0);
+                bool b_byterange = (ctx_byterange != NULL);
+                if(ctx_byterange)
+                {
+                    range = ctx_byterange->getValue().getByteRange();
+                    if(range.first == 0) /* first == size, second = offset */
+                        range.first = prevbyterangeoffset;
+                    prevbyterangeoffset = range.first + range.second;
+                    ctx_byterange = NULL;
+                }
+
+                if(segmentNumber < lowestUnknownSequence)
+                {
+                    /* already known from a previous refresh: only the
+                       running context above has to move forward */
+                    nzStartTime += nzDuration;
+                    totalduration += nzDuration;
+                    if(absReferenceTime != VLC_TICK_INVALID)
+                        absReferenceTime += nzDuration;
+                    discontinuity = false;
+                    break;
+                }
+
+                HLSSegment *segment = new (std::nothrow) HLSSegment(rep, segmentNumber);
+                if(!segment)
+                    break;
+
+                segment->setSourceUrl(uritag->getValue().value);
+                if((unsigned)rep->getStreamFormat() == StreamFormat::UNKNOWN)
+                    setFormatFromExtension(rep, uritag->getValue().value);
+
                 segment->duration.Set(duration * (uint64_t) rep->getTimescale());
                 segment->startTime.Set(rep->getTimescale().ToScaled(nzStartTime));
                 nzStartTime += nzDuration;
@@ -266,15 +305,8 @@ void M3U8Parser::parseSegments(vlc_object_t *, Representation *rep, const std::l
 
                 segmentList->addSegment(segment);
 
-                if(ctx_byterange)
-                {
-                    std::pair<std::size_t,std::size_t> range = ctx_byterange->getValue().getByteRange();
-                    if(range.first == 0) /* first == size, second = offset */
-                        range.first = prevbyterangeoffset;
-                    prevbyterangeoffset = range.first + range.second;
+                if(b_byterange)
                     segment->setByteRange(range.first, prevbyterangeoffset - 1);
-                    ctx_byterange = NULL;
-                }
 
                 if(discontinuity)
                 {
@@ -363,6 +395,17 @@ void M3U8Parser::parseSegments(vlc_object_t *, Representation *rep, const std::l
             }
             break;
 
+            case AttributesTag::EXTXSKIP:
+            {
+                /* delta update playlist: the skipped segments are all
+                   known from a previous refresh, just move the counter */
+                const AttributesTag *skiptag = static_cast<const AttributesTag *>(tag);
+                const Attribute *skipped = skiptag->getAttributeByName("SKIPPED-SEGMENTS");
+                if(skipped)
+                    sequenceNumber += skipped->decimal();
+            }
+            break;
+
             case Tag::EXTXDISCONTINUITY:
                 discontinuity  = true;
                 break;
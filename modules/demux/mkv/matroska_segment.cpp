@@ -68,6 +68,9 @@ matroska_segment_c::matroska_segment_c( demux_sys_t & demuxer, EbmlStream & estr
 
 matroska_segment_c::~matroska_segment_c()
 {
+    if( b_preloaded && var_InheritBool( &sys.demuxer, "mkv-index-cache" ) )
+        _seeker.save_index( *this );
+
     free( psz_writing_application );
     free( psz_muxing_application );
     free( psz_segment_filename );
@@ -686,6 +689,9 @@ bool matroska_segment_c::Preload( )
 
     b_preloaded = true;
 
+    if( var_InheritBool( &sys.demuxer, "mkv-index-cache" ) )
+        _seeker.load_index( *this );
+
     if( cluster )
         EnsureDuration();
 
@@ -29,6 +29,10 @@
 #include "util.hpp"
 #include "stream_io_callback.hpp"
 
+#include <vlc_fs.h>
+#include <vlc_configuration.h>
+
+#include <cstdio>
 #include <sstream>
 #include <limits>
 
@@ -520,4 +524,272 @@ SegmentSeeker::mkv_jump_to( matroska_segment_c& ms, fptr_t fpos )
         ms.es.I_O().setFilePointer( fpos );
 }
 
+/* ------------------------------------------------------------------
+ * Sidecar index cache
+ *
+ * The discovered index is persisted in the user cache directory, in a
+ * file named after the segment UID, and merged back on the next open so
+ * that cue-less files only ever pay the cluster scan once. The format is
+ * native-endian, in the same spirit as the plugins cache: the file is
+ * only ever read back by the host that wrote it.
+ * ------------------------------------------------------------------ */
+
+namespace {
+
+const uint8_t  INDEX_CACHE_MAGIC[4] = { 'M', 'K', 'V', 'I' };
+const uint32_t INDEX_CACHE_VERSION = 1;
+const uint32_t INDEX_CACHE_MAX_ENTRIES = 1 << 24;
+
+template<class T> bool cache_write( FILE *f, T const& v )
+{
+    return fwrite( &v, sizeof v, 1, f ) == 1;
+}
+
+template<class T> bool cache_read( FILE *f, T& v )
+{
+    return fread( &v, sizeof v, 1, f ) == 1;
+}
+
+char * index_cache_path( KaxSegmentUID *p_uid )
+{
+    if( p_uid == NULL || p_uid->GetBuffer() == NULL ||
+        p_uid->GetSize() == 0 || p_uid->GetSize() > 64 )
+        return NULL;
+
+    char *psz_cachedir = config_GetUserDir( VLC_CACHE_DIR );
+    if( unlikely(psz_cachedir == NULL) )
+        return NULL;
+
+    char psz_uid[64 * 2 + 1];
+    for( size_t i = 0; i < p_uid->GetSize(); i++ )
+        sprintf( &psz_uid[2 * i], "%02x", p_uid->GetBuffer()[i] );
+
+    char *psz_dir;
+    if( asprintf( &psz_dir, "%s" DIR_SEP "mkvindex", psz_cachedir ) == -1 )
+        psz_dir = NULL;
+    free( psz_cachedir );
+    if( psz_dir == NULL )
+        return NULL;
+    vlc_mkdir( psz_dir, 0700 );
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s" DIR_SEP "%s.idx", psz_dir, psz_uid ) == -1 )
+        psz_path = NULL;
+    free( psz_dir );
+    return psz_path;
+}
+
+} // namespace
+
+size_t
+SegmentSeeker::count_trusted_seekpoints() const
+{
+    size_t count = 0;
+
+    for( tracks_seekpoints_t::const_iterator it = _tracks_seekpoints.begin();
+         it != _tracks_seekpoints.end(); ++it )
+    {
+        for( seekpoints_t::const_iterator sp = it->second.begin();
+             sp != it->second.end(); ++sp )
+        {
+            if( sp->trust_level >= Seekpoint::TRUSTED )
+                ++count;
+        }
+    }
+
+    return count;
+}
+
+bool
+SegmentSeeker::load_index( matroska_segment_c& ms )
+{
+    demux_t *p_demux = &ms.sys.demuxer;
+    char *psz_path = index_cache_path( ms.p_segment_uid );
+
+    if( psz_path == NULL )
+        return false;
+
+    FILE *f = vlc_fopen( psz_path, "rb" );
+    free( psz_path );
+    if( f == NULL )
+        return false;
+
+    bool b_ok = false;
+    bool b_fail = false;
+    uint8_t magic[4];
+    uint32_t version, count;
+
+    do {
+        if( fread( magic, sizeof magic, 1, f ) != 1 ||
+            memcmp( magic, INDEX_CACHE_MAGIC, sizeof magic ) ||
+            !cache_read( f, version ) || version != INDEX_CACHE_VERSION )
+            break;
+
+        /* searched ranges */
+        if( !cache_read( f, count ) || count > INDEX_CACHE_MAX_ENTRIES )
+            break;
+        while( count-- )
+        {
+            fptr_t start, end;
+            if( ( b_fail = !cache_read( f, start ) || !cache_read( f, end ) ) )
+                break;
+            mark_range_as_searched( Range( start, end ) );
+        }
+        if( b_fail )
+            break;
+
+        /* cluster positions */
+        if( !cache_read( f, count ) || count > INDEX_CACHE_MAX_ENTRIES )
+            break;
+        while( count-- )
+        {
+            fptr_t fpos;
+            if( ( b_fail = !cache_read( f, fpos ) ) )
+                break;
+            add_cluster_position( fpos );
+        }
+        if( b_fail )
+            break;
+
+        /* clusters */
+        if( !cache_read( f, count ) || count > INDEX_CACHE_MAX_ENTRIES )
+            break;
+        while( count-- )
+        {
+            Cluster cinfo;
+            if( ( b_fail = !cache_read( f, cinfo.fpos ) ||
+                           !cache_read( f, cinfo.pts ) ||
+                           !cache_read( f, cinfo.duration ) ||
+                           !cache_read( f, cinfo.size ) ) )
+                break;
+            _clusters.insert( cluster_map_t::value_type( cinfo.pts, cinfo ) );
+        }
+        if( b_fail )
+            break;
+
+        /* per-track seekpoints */
+        uint32_t tracks;
+        if( !cache_read( f, tracks ) || tracks > INDEX_CACHE_MAX_ENTRIES )
+            break;
+        while( tracks-- && !b_fail )
+        {
+            uint32_t track_id;
+            if( ( b_fail = !cache_read( f, track_id ) ||
+                           !cache_read( f, count ) ||
+                           count > INDEX_CACHE_MAX_ENTRIES ) )
+                break;
+            while( count-- )
+            {
+                fptr_t fpos;
+                vlc_tick_t pts;
+                if( ( b_fail = !cache_read( f, fpos ) || !cache_read( f, pts ) ) )
+                    break;
+                add_seekpoint( track_id, Seekpoint( fpos, pts ) );
+                ++_index_points_loaded;
+            }
+        }
+        b_ok = !b_fail;
+    } while( 0 );
+
+    fclose( f );
+
+    if( b_ok )
+        msg_Dbg( p_demux, "loaded %zu seekpoints from the index cache",
+                 _index_points_loaded );
+    else
+        /* whatever was merged before the failure remains valid */
+        msg_Warn( p_demux, "index cache truncated or invalid, ignoring" );
+
+    return b_ok;
+}
+
+void
+SegmentSeeker::save_index( matroska_segment_c& ms )
+{
+    demux_t *p_demux = &ms.sys.demuxer;
+
+    size_t i_points = count_trusted_seekpoints();
+    if( i_points == 0 || i_points == _index_points_loaded )
+        return; /* nothing new worth saving */
+
+    char *psz_path = index_cache_path( ms.p_segment_uid );
+    if( psz_path == NULL )
+        return;
+
+    char *psz_tmp;
+    if( asprintf( &psz_tmp, "%s.tmp", psz_path ) == -1 )
+    {
+        free( psz_path );
+        return;
+    }
+
+    FILE *f = vlc_fopen( psz_tmp, "wb" );
+    bool b_ok = f != NULL;
+
+    if( b_ok )
+    {
+        b_ok = fwrite( INDEX_CACHE_MAGIC, sizeof INDEX_CACHE_MAGIC, 1, f ) == 1
+            && cache_write( f, INDEX_CACHE_VERSION );
+
+        b_ok = b_ok &&
+            cache_write( f, static_cast<uint32_t>( _ranges_searched.size() ) );
+        for( ranges_t::const_iterator it = _ranges_searched.begin();
+             b_ok && it != _ranges_searched.end(); ++it )
+            b_ok = cache_write( f, it->start ) && cache_write( f, it->end );
+
+        b_ok = b_ok &&
+            cache_write( f, static_cast<uint32_t>( _cluster_positions.size() ) );
+        for( cluster_positions_t::const_iterator it = _cluster_positions.begin();
+             b_ok && it != _cluster_positions.end(); ++it )
+            b_ok = cache_write( f, *it );
+
+        b_ok = b_ok &&
+            cache_write( f, static_cast<uint32_t>( _clusters.size() ) );
+        for( cluster_map_t::const_iterator it = _clusters.begin();
+             b_ok && it != _clusters.end(); ++it )
+            b_ok = cache_write( f, it->second.fpos )
+                && cache_write( f, it->second.pts )
+                && cache_write( f, it->second.duration )
+                && cache_write( f, it->second.size );
+
+        b_ok = b_ok &&
+            cache_write( f, static_cast<uint32_t>( _tracks_seekpoints.size() ) );
+        for( tracks_seekpoints_t::const_iterator it = _tracks_seekpoints.begin();
+             b_ok && it != _tracks_seekpoints.end(); ++it )
+        {
+            uint32_t i_trusted = 0;
+            for( seekpoints_t::const_iterator sp = it->second.begin();
+                 sp != it->second.end(); ++sp )
+                if( sp->trust_level >= Seekpoint::TRUSTED )
+                    ++i_trusted;
+
+            b_ok = b_ok
+                && cache_write( f, static_cast<uint32_t>( it->first ) )
+                && cache_write( f, i_trusted );
+
+            for( seekpoints_t::const_iterator sp = it->second.begin();
+                 b_ok && sp != it->second.end(); ++sp )
+            {
+                if( sp->trust_level < Seekpoint::TRUSTED )
+                    continue;
+                b_ok = cache_write( f, sp->fpos ) && cache_write( f, sp->pts );
+            }
+        }
+
+        if( fclose( f ) )
+            b_ok = false;
+    }
+
+    if( b_ok && vlc_rename( psz_tmp, psz_path ) == 0 )
+        msg_Dbg( p_demux, "saved %zu seekpoints to the index cache", i_points );
+    else
+    {
+        msg_Warn( p_demux, "cannot save the index cache" );
+        vlc_unlink( psz_tmp );
+    }
+
+    free( psz_tmp );
+    free( psz_path );
+}
+
 } // namespace
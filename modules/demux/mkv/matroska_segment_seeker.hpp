@@ -120,11 +120,20 @@ class SegmentSeeker
         void mark_range_as_searched( Range );
         ranges_t get_search_areas( fptr_t start, fptr_t end ) const;
 
+        /* sidecar index cache, keyed on the segment UID (see mkv-index-cache) */
+        bool load_index( matroska_segment_c& );
+        void save_index( matroska_segment_c& );
+
     public:
         ranges_t            _ranges_searched;
         tracks_seekpoints_t _tracks_seekpoints;
         cluster_positions_t _cluster_positions;
         cluster_map_t       _clusters;
+
+    private:
+        size_t count_trusted_seekpoints() const;
+
+        size_t _index_points_loaded = 0;
 };
 
 } // namespace
@@ -77,6 +77,10 @@ vlc_module_begin ()
             N_("Preload clusters"),
             N_("Find all cluster positions by jumping cluster-to-cluster before playback"), true );
 
+    add_bool( "mkv-index-cache", false,
+            N_("Cache the seek index"),
+            N_("Save the discovered cluster/keyframe index to the cache directory, keyed on the segment UID, and reload it on the next open."), true );
+
     add_shortcut( "mka", "mkv" )
 vlc_module_end ()
 
@@ -91,22 +95,29 @@ static int  Seek   ( demux_t *, vlc_tick_t i_mk_date, double f_percent, virtual_
 /*****************************************************************************
  * Open: initializes matroska demux structures
  *****************************************************************************/
+
+/* Checks the EBML magic in place, without copying the head out of the
+ * stream buffer */
+static bool IsEbmlStream( stream_t *s )
+{
+    const block_t *p_head = vlc_stream_PeekBlock( s, 4 );
+
+    return p_head != NULL && p_head->i_buffer >= 4 &&
+           p_head->p_buffer[0] == 0x1a && p_head->p_buffer[1] == 0x45 &&
+           p_head->p_buffer[2] == 0xdf && p_head->p_buffer[3] == 0xa3;
+}
+
 static int Open( vlc_object_t * p_this )
 {
     demux_t            *p_demux = (demux_t*)p_this;
     demux_sys_t        *p_sys;
     matroska_stream_c  *p_stream;
     matroska_segment_c *p_segment;
-    const uint8_t      *p_peek;
     std::string         s_path, s_filename;
     bool                b_need_preload = false;
 
-    /* peek the begining */
-    if( vlc_stream_Peek( p_demux->s, &p_peek, 4 ) < 4 ) return VLC_EGENERIC;
-
     /* is a valid file */
-    if( p_peek[0] != 0x1a || p_peek[1] != 0x45 ||
-        p_peek[2] != 0xdf || p_peek[3] != 0xa3 ) return VLC_EGENERIC;
+    if( !IsEbmlStream( p_demux->s ) ) return VLC_EGENERIC;
 
     /* Set the demux function */
     p_demux->pf_demux   = Demux;
@@ -198,17 +209,14 @@ static int Open( vlc_object_t * p_this )
                             !strcasecmp(s_filename.c_str() + s_filename.length() - 4, ".mka"))
                         {
                             // test whether this file belongs to our family
-                            const uint8_t *p_peek;
                             bool          file_ok = false;
                             char          *psz_url = vlc_path2uri( s_filename.c_str(), "file" );
                             stream_t      *p_file_stream = vlc_stream_NewURL(
                                                             p_demux,
                                                             psz_url );
                             /* peek the begining */
-                            if( p_file_stream &&
-                                vlc_stream_Peek( p_file_stream, &p_peek, 4 ) >= 4
-                                && p_peek[0] == 0x1a && p_peek[1] == 0x45 &&
-                                p_peek[2] == 0xdf && p_peek[3] == 0xa3 ) file_ok = true;
+                            if( p_file_stream && IsEbmlStream( p_file_stream ) )
+                                file_ok = true;
 
                             if ( file_ok )
                             {
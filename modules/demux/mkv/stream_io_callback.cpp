@@ -33,6 +33,17 @@ vlc_stream_io_callback::vlc_stream_io_callback( stream_t *s_, bool b_owner_ )
                        : s( s_), b_owner( b_owner_ )
 {
     mb_eof = false;
+    mp_buffer = new uint8_t[BUFFER_SIZE];
+    mi_position = ( s != NULL ) ? vlc_stream_Tell( s ) : 0;
+    mi_window_offset = 0;
+    mi_buffer_len = 0;
+}
+
+bool vlc_stream_io_callback::Resync( uint64_t i_offset )
+{
+    if( vlc_stream_Tell( s ) == i_offset )
+        return true;
+    return vlc_stream_Seek( s, i_offset ) == 0;
 }
 
 uint32 vlc_stream_io_callback::read( void *p_buffer, size_t i_size )
@@ -40,14 +51,61 @@ uint32 vlc_stream_io_callback::read( void *p_buffer, size_t i_size )
     if( i_size <= 0 || mb_eof )
         return 0;
 
-    int i_ret = vlc_stream_Read( s, p_buffer, i_size );
-    return i_ret < 0 ? 0 : i_ret;
+    uint8_t *p_dst = static_cast<uint8_t *>( p_buffer );
+    size_t i_copied = 0;
+
+    while( i_size > 0 )
+    {
+        /* serve from the current window */
+        if( mi_position >= mi_window_offset &&
+            mi_position < mi_window_offset + mi_buffer_len )
+        {
+            size_t i_off = mi_position - mi_window_offset;
+            size_t i_copy = __MIN( mi_buffer_len - i_off, i_size );
+
+            memcpy( p_dst, &mp_buffer[i_off], i_copy );
+            mi_position += i_copy;
+            p_dst += i_copy;
+            i_size -= i_copy;
+            i_copied += i_copy;
+            continue;
+        }
+
+        if( i_size >= BUFFER_SIZE )
+        {
+            /* large (cluster payload) read: bypass the window */
+            if( !Resync( mi_position ) )
+                break;
+
+            int i_ret = vlc_stream_Read( s, p_dst, i_size );
+            if( i_ret > 0 )
+            {
+                mi_position += i_ret;
+                i_copied += i_ret;
+            }
+            break;
+        }
+
+        /* refill an aligned window covering the current position, so
+         * nearby seeks keep reading the same stream ranges */
+        uint64_t i_window =
+            mi_position & ~static_cast<uint64_t>( BUFFER_SIZE - 1 );
+        if( !Resync( i_window ) )
+            break;
+
+        int i_ret = vlc_stream_Read( s, mp_buffer, BUFFER_SIZE );
+        mi_window_offset = i_window;
+        mi_buffer_len = i_ret < 0 ? 0 : i_ret;
+        if( mi_buffer_len <= mi_position - i_window )
+            break; /* the stream ends before the position: nothing more */
+    }
+    return i_copied;
 }
 
 void vlc_stream_io_callback::setFilePointer(int64_t i_offset, seek_mode mode )
 {
     int64_t i_pos, i_size;
-    int64_t i_current = vlc_stream_Tell( s );
+    int64_t i_current = static_cast<int64_t>( getFilePointer() );
 
     switch( mode )
     {
@@ -62,29 +120,16 @@ void vlc_stream_io_callback::setFilePointer(int64_t i_offset, seek_mode mode )
             break;
     }
 
-    if(i_pos == i_current)
-    {
-        if (mb_eof)
-        {
-            // if previous setFilePointer() failed we may be back in the available data
-            i_size = stream_Size( s );
-            if ( i_size != 0 && i_pos < i_size )
-                mb_eof = vlc_stream_Seek( s, i_pos ) != VLC_SUCCESS;
-        }
-        return;
-    }
-
     if( i_pos < 0 || ( ( i_size = stream_Size( s ) ) != 0 && i_pos >= i_size ) )
     {
         mb_eof = true;
         return;
     }
 
+    /* Seeks are lazy: the stream is only repositioned when a read misses
+     * the current window, and then onto an aligned window boundary */
     mb_eof = false;
-    if( vlc_stream_Seek( s, i_pos ) )
-    {
-        mb_eof = true;
-    }
+    mi_position = i_pos;
     return;
 }
 
@@ -92,7 +137,7 @@ uint64 vlc_stream_io_callback::getFilePointer( void )
 {
     if ( s == NULL )
         return 0;
-    return vlc_stream_Tell( s );
+    return mi_position;
 }
 
 size_t vlc_stream_io_callback::write(const void *, size_t )
@@ -112,7 +157,7 @@ uint64 vlc_stream_io_callback::toRead( void )
     if( i_size <= 0 )
         return UINT64_MAX;
 
-    return static_cast<uint64>( i_size - vlc_stream_Tell( s ) );
+    return static_cast<uint64>( i_size - getFilePointer() );
 }
 
 } // namespace
@@ -43,15 +43,31 @@ namespace mkv {
 class vlc_stream_io_callback: public IOCallback
 {
   private:
+    /* EBML parsing is dominated by tiny header reads and short skips; the
+     * wrapper batches them into window-sized stream reads, aligned on the
+     * window size so that scattered seeks during cluster scans keep hitting
+     * the same windows (and the same ranges in the cache filters below) */
+    static const size_t BUFFER_SIZE = 65536;
+
     stream_t       *s;
     bool           mb_eof;
     bool           b_owner;
 
+    uint8_t        *mp_buffer;
+    uint64_t       mi_position;      /* logical file pointer; seeks are lazy
+                                        and only touch the stream on read */
+    uint64_t       mi_window_offset; /* stream offset of mp_buffer[0],
+                                        BUFFER_SIZE aligned */
+    size_t         mi_buffer_len;    /* valid bytes in mp_buffer */
+
+    bool           Resync( uint64_t i_offset );
+
   public:
     vlc_stream_io_callback( stream_t *, bool owner );
 
     virtual ~vlc_stream_io_callback()
     {
+        delete[] mp_buffer;
         if( b_owner )
             vlc_stream_Delete( s );
     }
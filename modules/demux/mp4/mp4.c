@@ -2583,18 +2583,11 @@ static int TrackCreateSamplesIndex( demux_t *p_demux,
     }
     else
     {
-        /* 2: each sample can have a different size */
+        /* 2: each sample can have a different size; the stsz table is
+         *    used in place instead of being duplicated, as one entry per
+         *    sample quickly dominates the index memory on long movies */
         p_demux_track->i_sample_size = 0;
-        p_demux_track->p_sample_size =
-            calloc( p_demux_track->i_sample_count, sizeof( uint32_t ) );
-        if( p_demux_track->p_sample_size == NULL )
-            return VLC_ENOMEM;
-
-        for( uint32_t i_sample = 0; i_sample < p_demux_track->i_sample_count; i_sample++ )
-        {
-            p_demux_track->p_sample_size[i_sample] =
-                    stsz->i_entry_size[i_sample];
-        }
+        p_demux_track->p_sample_size = stsz->i_entry_size;
     }
 
     if ( p_demux_track->i_chunk_count && p_demux_track->i_sample_size == 0 )
@@ -2632,6 +2625,25 @@ static int TrackCreateSamplesIndex( demux_t *p_demux,
 
         msg_Warn( p_demux, "STTS table of %"PRIu32" entries", stts->i_entry_count );
 
+        /* All per-chunk slices of the stts runs are carved out of a single
+         * allocation: a run split on a chunk boundary is the only source of
+         * duplicate entries, so the total is bounded by the table size plus
+         * one entry per chunk */
+        uint64_t i_entries_left = (uint64_t)stts->i_entry_count +
+                                  p_demux_track->i_chunk_count;
+        if( i_entries_left > SIZE_MAX / ( 2 * sizeof( uint32_t ) ) )
+            return VLC_EGENERIC;
+
+        p_demux_track->p_chunk_dts_runs =
+            calloc( i_entries_left, 2 * sizeof( uint32_t ) );
+        if( p_demux_track->p_chunk_dts_runs == NULL )
+        {
+            msg_Err( p_demux, "can't allocate memory for %"PRIu64" entries",
+                     i_entries_left );
+            return VLC_ENOMEM;
+        }
+        uint32_t *p_dts_alloc = p_demux_track->p_chunk_dts_runs;
+
         /* Create sample -> dts table per chunk */
         uint32_t i_index = 0;
         uint32_t i_current_index_samples_left = 0;
@@ -2656,17 +2668,17 @@ static int TrackCreateSamplesIndex( demux_t *p_demux,
             if ( i_ret == VLC_EGENERIC )
                 return i_ret;
 
-            /* allocate them */
-            ck->p_sample_count_dts = calloc( ck->i_entries_dts, sizeof( uint32_t ) );
-            ck->p_sample_delta_dts = calloc( ck->i_entries_dts, sizeof( uint32_t ) );
-            if( !ck->p_sample_count_dts || !ck->p_sample_delta_dts )
+            /* carve them out of the shared allocation */
+            if( ck->i_entries_dts > i_entries_left )
             {
-                free( ck->p_sample_count_dts );
-                free( ck->p_sample_delta_dts );
-                msg_Err( p_demux, "can't allocate memory for i_entry=%"PRIu32, ck->i_entries_dts );
+                msg_Err( p_demux, "invalid stts index: out of entries for i_chunk=%"PRIu32, i_chunk );
                 ck->i_entries_dts = 0;
-                return VLC_ENOMEM;
+                return VLC_EGENERIC;
             }
+            ck->p_sample_count_dts = p_dts_alloc;
+            ck->p_sample_delta_dts = p_dts_alloc + ck->i_entries_dts;
+            p_dts_alloc += 2 * ck->i_entries_dts;
+            i_entries_left -= ck->i_entries_dts;
 
             /* now copy */
             i_sample_count = ck->i_sample_count;
@@ -2741,6 +2753,22 @@ static int TrackCreateSamplesIndex( demux_t *p_demux,
         if( p_cslg && BOXDATA(p_cslg) )
             i_cts_shift = BOXDATA(p_cslg)->ct_to_dts_shift;
 
+        /* same single-allocation scheme as for the stts slices above */
+        uint64_t i_entries_left = (uint64_t)ctts->i_entry_count +
+                                  p_demux_track->i_chunk_count;
+        if( i_entries_left > SIZE_MAX / ( 2 * sizeof( uint32_t ) ) )
+            return VLC_EGENERIC;
+
+        p_demux_track->p_chunk_pts_runs =
+            calloc( i_entries_left, 2 * sizeof( uint32_t ) );
+        if( p_demux_track->p_chunk_pts_runs == NULL )
+        {
+            msg_Err( p_demux, "can't allocate memory for %"PRIu64" entries",
+                     i_entries_left );
+            return VLC_ENOMEM;
+        }
+        uint32_t *p_pts_alloc = p_demux_track->p_chunk_pts_runs;
+
         /* Create pts-dts table per chunk */
         uint32_t i_index = 0;
         uint32_t i_current_index_samples_left = 0;
@@ -2761,17 +2789,17 @@ static int TrackCreateSamplesIndex( demux_t *p_demux,
             if ( i_ret == VLC_EGENERIC )
                 return i_ret;
 
-            /* allocate them */
-            ck->p_sample_count_pts = calloc( ck->i_entries_pts, sizeof( uint32_t ) );
-            ck->p_sample_offset_pts = calloc( ck->i_entries_pts, sizeof( int32_t ) );
-            if( !ck->p_sample_count_pts || !ck->p_sample_offset_pts )
+            /* carve them out of the shared allocation */
+            if( ck->i_entries_pts > i_entries_left )
             {
-                free( ck->p_sample_count_pts );
-                free( ck->p_sample_offset_pts );
-                msg_Err( p_demux, "can't allocate memory for i_entry=%"PRIu32, ck->i_entries_pts );
+                msg_Err( p_demux, "invalid ctts index: out of entries for i_chunk=%"PRIu32, i_chunk );
                 ck->i_entries_pts = 0;
-                return VLC_ENOMEM;
+                return VLC_EGENERIC;
             }
+            ck->p_sample_count_pts = p_pts_alloc;
+            ck->p_sample_offset_pts = (int32_t *)( p_pts_alloc + ck->i_entries_pts );
+            p_pts_alloc += 2 * ck->i_entries_pts;
+            i_entries_left -= ck->i_entries_pts;
 
             /* now copy */
             i_sample_count = ck->i_sample_count;
@@ -3598,10 +3626,7 @@ static void MP4_TrackSetup( demux_t *p_demux, mp4_track_t *p_track,
 
 static void DestroyChunk( mp4_chunk_t *ck )
 {
-    free( ck->p_sample_count_dts );
-    free( ck->p_sample_delta_dts );
-    free( ck->p_sample_count_pts );
-    free( ck->p_sample_offset_pts );
+    /* the dts/pts run slices point into the track chunk run stores */
     free( ck->p_sample_size );
 }
 
@@ -3623,9 +3648,10 @@ static void MP4_TrackClean( es_out_t *out, mp4_track_t *p_track )
             DestroyChunk( &p_track->chunk[i_chunk] );
     }
     free( p_track->chunk );
+    free( p_track->p_chunk_dts_runs );
+    free( p_track->p_chunk_pts_runs );
 
-    if( !p_track->i_sample_size )
-        free( p_track->p_sample_size );
+    /* p_sample_size points into the stsz box data, nothing to free */
 
     if ( p_track->asfinfo.p_frame )
         block_ChainRelease( p_track->asfinfo.p_frame );
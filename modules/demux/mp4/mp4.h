@@ -117,10 +117,16 @@ typedef struct
 
     mp4_chunk_t    *chunk; /* always defined  for each chunk */
 
+    /* backing store for the per-chunk stts/ctts run slices; the chunk
+        p_sample_*_dts/pts pointers are carved out of these */
+    uint32_t       *p_chunk_dts_runs;
+    uint32_t       *p_chunk_pts_runs;
+
     /* sample size, p_sample_size defined only if i_sample_size == 0
-        else i_sample_size is size for all sample */
+        else i_sample_size is size for all sample
+        (points into the stsz box data, not owned) */
     uint32_t         i_sample_size;
-    uint32_t         *p_sample_size; /* XXX perhaps add file offset if take
+    const uint32_t   *p_sample_size; /* XXX perhaps add file offset if take
 //                                    too much time to do sumations each time*/
 
     uint32_t     i_sample_first; /* i_sample_first value
@@ -670,8 +670,15 @@ static int GenericProbe( demux_t *p_demux, int64_t *pi_offset,
     /* peek the begining
      * It is common that wav files have some sort of garbage at the begining
      * We will accept probing 0.5s of data in this case.
+     *
+     * A plain ES which is neither WAVE nor forced gives up after checking
+     * the first header (see the scan loop below), so only peek the header
+     * in that case: with several codecs probed in turn on every open, the
+     * kilobytes of slack were being pulled through the stream for nothing.
      */
-    const int i_probe = i_skip + i_check_size + 8000 + ( b_wav ? (44000/2*2*2) : 0);
+    int i_probe = i_skip + i_check_size;
+    if( b_wav || b_forced_demux )
+        i_probe += 8000 + ( b_wav ? (44000/2*2*2) : 0);
     const int i_peek = vlc_stream_Peek( p_demux->s, &p_peek, i_probe );
     if( i_peek < i_skip + i_check_size )
     {
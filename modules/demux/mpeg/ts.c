@@ -394,6 +394,9 @@ static int Open( vlc_object_t *p_this )
     p_sys->i_packet_size = i_packet_size;
     p_sys->i_packet_header_size = i_packet_header_size;
     p_sys->i_ts_read = 50;
+    p_sys->lookahead.p_first = NULL;
+    p_sys->lookahead.pp_last = &p_sys->lookahead.p_first;
+    p_sys->lookahead.i_endpos = 0;
     p_sys->csa = NULL;
     p_sys->b_start_record = false;
 
@@ -580,6 +583,9 @@ static void Close( vlc_object_t *p_this )
     /* Clear up attachments */
     vlc_dictionary_clear( &p_sys->attachments, FreeDictAttachment, NULL );
 
+    if( p_sys->lookahead.p_first )
+        block_ChainRelease( p_sys->lookahead.p_first );
+
     free( p_sys );
 }
 
@@ -1718,14 +1724,71 @@ static bool PushPESBlock( demux_t *p_demux, ts_pid_t *pid, block_t *p_pkt, bool
     return b_ret;
 }
 
+/* How many packets ReadTSPacket() slices per peek window */
+#define TS_LOOKAHEAD_COUNT 32
+/* Peek window of the resynchronization scan */
+#define TS_RESYNC_PEEK (64 * 1024)
+
 static block_t* ReadTSPacket( demux_t *p_demux )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
 
     block_t     *p_pkt;
 
-    /* Get a new TS packet */
-    if( !( p_pkt = vlc_stream_Block( p_sys->stream, p_sys->i_packet_size ) ) )
+    /* The queue is sliced at the stream read position; a seek performed
+     * elsewhere (binary search, position set) moves that position away from
+     * the end of the sliced data and makes the queue stale. */
+    if( p_sys->lookahead.p_first &&
+        vlc_stream_Tell( p_sys->stream ) != p_sys->lookahead.i_endpos )
+    {
+        block_ChainRelease( p_sys->lookahead.p_first );
+        p_sys->lookahead.p_first = NULL;
+        p_sys->lookahead.pp_last = &p_sys->lookahead.p_first;
+    }
+
+    if( p_sys->lookahead.p_first == NULL )
+    {
+        /* Slice whole, in-sync packets from a single peek window, rather
+         * than issuing one stream read per packet. Anything not starting
+         * with a sync byte is left unread for the resync path below. */
+        const uint8_t *p_peek;
+        ssize_t i_peek = vlc_stream_Peek( p_sys->stream, &p_peek,
+                                p_sys->i_packet_size * TS_LOOKAHEAD_COUNT );
+        size_t i_sliced = 0;
+
+        while( i_peek >= (ssize_t)(i_sliced + p_sys->i_packet_size) &&
+               p_peek[i_sliced + p_sys->i_packet_header_size] == 0x47 )
+        {
+            block_t *p_block = block_Alloc( p_sys->i_packet_size );
+            if( unlikely(!p_block) )
+                break;
+            memcpy( p_block->p_buffer, &p_peek[i_sliced],
+                    p_sys->i_packet_size );
+            block_ChainLastAppend( &p_sys->lookahead.pp_last, p_block );
+            i_sliced += p_sys->i_packet_size;
+        }
+
+        if( i_sliced > 0 &&
+            vlc_stream_Read( p_sys->stream, NULL, i_sliced ) != (ssize_t)i_sliced )
+        {   /* Cannot happen, the data was just peeked */
+            block_ChainRelease( p_sys->lookahead.p_first );
+            p_sys->lookahead.p_first = NULL;
+            p_sys->lookahead.pp_last = &p_sys->lookahead.p_first;
+            return NULL;
+        }
+        p_sys->lookahead.i_endpos = vlc_stream_Tell( p_sys->stream );
+    }
+
+    p_pkt = p_sys->lookahead.p_first;
+    if( p_pkt )
+    {
+        p_sys->lookahead.p_first = p_pkt->p_next;
+        if( p_sys->lookahead.p_first == NULL )
+            p_sys->lookahead.pp_last = &p_sys->lookahead.p_first;
+        p_pkt->p_next = NULL;
+    }
+    /* Get a new TS packet (short read at EOF, or leading garbage) */
+    else if( !( p_pkt = vlc_stream_Block( p_sys->stream, p_sys->i_packet_size ) ) )
     {
         int64_t size = stream_Size( p_sys->stream );
         if( size >= 0 && (uint64_t)size == vlc_stream_Tell( p_sys->stream ) )
@@ -1760,20 +1823,29 @@ static block_t* ReadTSPacket( demux_t *p_demux )
             unsigned i_skip = 0;
 
             i_peek = vlc_stream_Peek( p_sys->stream, &p_peek,
-                    p_sys->i_packet_size * 10 );
+                    TS_RESYNC_PEEK );
             if( i_peek < 0 || (unsigned)i_peek < p_sys->i_packet_size + 1 )
             {
                 msg_Dbg( p_demux, "eof ?" );
                 return NULL;
             }
 
-            while( i_skip < i_peek - p_sys->i_packet_size )
+            /* memchr() is vectorized by the C runtime, which beats the
+             * byte-wise scan over long runs of garbage */
+            const unsigned i_bound = i_peek - p_sys->i_packet_size;
+            while( i_skip < i_bound )
             {
-                if( p_peek[i_skip + p_sys->i_packet_header_size] == 0x47 &&
-                        p_peek[i_skip + p_sys->i_packet_header_size + p_sys->i_packet_size] == 0x47 )
+                const uint8_t *p_sync =
+                    memchr( &p_peek[i_skip + p_sys->i_packet_header_size],
+                            0x47, i_bound - i_skip );
+                if( p_sync == NULL )
                 {
+                    i_skip = i_bound;
                     break;
                 }
+                i_skip = (p_sync - p_peek) - p_sys->i_packet_header_size;
+                if( p_peek[i_skip + p_sys->i_packet_header_size + p_sys->i_packet_size] == 0x47 )
+                    break;
                 i_skip++;
             }
             msg_Dbg( p_demux, "skipping %d bytes of garbage", i_skip );
@@ -63,6 +63,14 @@ struct demux_sys_t
     /* how many TS packet we read at once */
     unsigned    i_ts_read;
 
+    /* TS packets sliced ahead of the demux loop (see ReadTSPacket()) */
+    struct
+    {
+        block_t  *p_first;
+        block_t **pp_last;
+        uint64_t  i_endpos; /* stream position right after the sliced data */
+    } lookahead;
+
     bool        b_cc_check;
     bool        b_ignore_time_for_positions;
 
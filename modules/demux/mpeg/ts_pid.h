@@ -93,10 +93,9 @@ struct ts_pid_list_t
     ts_pid_t **pp_all;
     int        i_all;
     int        i_all_alloc;
-    /* last recently used */
-    uint16_t   i_last_pid;
-    ts_pid_t  *p_last;
-
+    /* direct PID-indexed access to all of the above, for the per-packet
+     * path (one load, no search) */
+    ts_pid_t  *lookup[8192];
 };
 
 /* opacified pid list */
@@ -224,10 +224,12 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
     int        i_options = 0;
     bool b_cleanup = false;
     input_item_t *p_input;
+    playlist_linereader_t reader;
 
     input_item_t *p_current_input = GetCurrentItem(p_demux);
 
-    psz_line = vlc_stream_ReadLine( p_demux->s );
+    playlist_linereader_Init( &reader );
+    psz_line = playlist_ReadLine( p_demux->s, &reader );
     while( psz_line )
     {
         char *psz_parse = psz_line;
@@ -327,8 +329,7 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
  error:
 
         /* Fetch another line */
-        free( psz_line );
-        psz_line = vlc_stream_ReadLine( p_demux->s );
+        psz_line = playlist_ReadLine( p_demux->s, &reader );
         if( !psz_line ) b_cleanup = true;
 
         if( b_cleanup )
@@ -346,6 +347,7 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
             b_cleanup = false;
         }
     }
+    playlist_linereader_Clean( &reader );
     return VLC_SUCCESS; /* Needed for correct operation of go back */
 }
 
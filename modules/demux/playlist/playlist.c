@@ -197,3 +197,110 @@ char *ProcessMRL(const char *str, const char *base)
 
     return abs;
 }
+
+#define LINEREADER_PROBE 2048
+#define LINEREADER_LINE_MAX (2048*100)
+
+void playlist_linereader_Init( playlist_linereader_t *p_reader )
+{
+    memset( p_reader, 0, sizeof(*p_reader) );
+}
+
+void playlist_linereader_Clean( playlist_linereader_t *p_reader )
+{
+    free( p_reader->psz_buf );
+    free( p_reader->psz_fallback );
+}
+
+/**
+ * Reads one line from a text stream into a recycled buffer.
+ *
+ * Returns a pointer owned by the reader, valid until the next call; NULL on
+ * end of stream. UTF-16 streams are deferred to vlc_stream_ReadLine() which
+ * knows how to transcode them; the common 8-bit case costs no allocation
+ * once the buffer has grown to the longest line.
+ */
+char *playlist_ReadLine( stream_t *s, playlist_linereader_t *p_reader )
+{
+    if( p_reader->b_fallback )
+    {
+        free( p_reader->psz_fallback );
+        p_reader->psz_fallback = vlc_stream_ReadLine( s );
+        return p_reader->psz_fallback;
+    }
+
+    if( vlc_stream_Tell( s ) == 0 )
+    {
+        const uint8_t *p_peek;
+        if( vlc_stream_Peek( s, &p_peek, 2 ) >= 2
+         && ( !memcmp( p_peek, "\xFF\xFE", 2 ) ||
+              !memcmp( p_peek, "\xFE\xFF", 2 ) ) )
+        {
+            p_reader->b_fallback = true;
+            return playlist_ReadLine( s, p_reader );
+        }
+    }
+
+    size_t i_line = 0;
+    bool b_cr = false;
+
+    for( ;; )
+    {
+        const uint8_t *p_data;
+        ssize_t i_data = vlc_stream_Peek( s, &p_data, LINEREADER_PROBE );
+        if( i_data <= 0 )
+            break; /* No more data */
+
+        const uint8_t *p_eol = memchr( p_data, '\n', i_data );
+        const uint8_t *p_cr = memchr( p_data, '\r',
+                        p_eol ? (size_t)(p_eol - p_data) : (size_t)i_data );
+        if( p_cr ) /* legacy Mac line ending */
+        {
+            p_eol = p_cr;
+            b_cr = true;
+        }
+
+        size_t i_copy = p_eol ? (size_t)(p_eol - p_data) + 1 : (size_t)i_data;
+
+        if( i_line + i_copy + 1 > p_reader->i_size )
+        {
+            size_t i_size = p_reader->i_size ? p_reader->i_size : 1024;
+            while( i_size < i_line + i_copy + 1 )
+                i_size *= 2;
+            char *p_buf = realloc( p_reader->psz_buf, i_size );
+            if( p_buf == NULL )
+                return NULL;
+            p_reader->psz_buf = p_buf;
+            p_reader->i_size = i_size;
+        }
+
+        i_data = vlc_stream_Read( s, &p_reader->psz_buf[i_line], i_copy );
+        if( i_data <= 0 )
+            break; /* Hmmm */
+        i_line += i_data;
+
+        if( p_eol != NULL )
+        {
+            if( b_cr ) /* swallow a LF paired with the CR */
+            {
+                if( vlc_stream_Peek( s, &p_data, 1 ) == 1 && *p_data == '\n' )
+                    vlc_stream_Read( s, NULL, 1 );
+            }
+            break;
+        }
+
+        if( i_line >= LINEREADER_LINE_MAX )
+            break; /* line too long */
+    }
+
+    if( i_line == 0 )
+        return NULL;
+
+    /* Remove trailing LF/CR */
+    while( i_line > 0 && ( p_reader->psz_buf[i_line - 1] == '\n' ||
+                           p_reader->psz_buf[i_line - 1] == '\r' ) )
+        i_line--;
+    p_reader->psz_buf[i_line] = '\0';
+
+    return p_reader->psz_buf;
+}
@@ -25,6 +25,22 @@
 
 char *ProcessMRL( const char *, const char * );
 
+/* Reusable line reader for the text based importers: unlike
+ * vlc_stream_ReadLine(), the returned line lives in a buffer owned by the
+ * reader and recycled on the next call, so huge playlists do not pay one
+ * allocation per line. The line must not be freed by the caller. */
+typedef struct
+{
+    char *psz_buf;
+    size_t i_size;
+    bool b_fallback;     /* UTF-16 input, left to vlc_stream_ReadLine() */
+    char *psz_fallback;
+} playlist_linereader_t;
+
+void playlist_linereader_Init( playlist_linereader_t * );
+void playlist_linereader_Clean( playlist_linereader_t * );
+char *playlist_ReadLine( stream_t *, playlist_linereader_t * );
+
 int Import_M3U ( vlc_object_t * );
 
 int Import_RAM ( vlc_object_t * );
@@ -41,7 +41,6 @@
 #include <assert.h>
 #include <QFont>
 #include <QAction>
-#include <QStack>
 
 /*************************************************************************
  * Playlist model implementation
@@ -519,33 +518,20 @@ PLItem *PLModel::findByPLId( PLItem *root, int i_id ) const
     if( root->id() == i_id )
         return root;
 
-    /* traverse the tree (in depth first) iteratively to avoid stack overflow */
-
-    struct RemainingChildren {
-        QList<AbstractPLItem *>::const_iterator next;
-        QList<AbstractPLItem *>::const_iterator end;
-    };
-
-    QStack<RemainingChildren> stack;
-    if( root->childCount() )
-        stack.push( {root->children.cbegin(), root->children.cend()} );
-
-    while ( !stack.isEmpty() )
-    {
-        RemainingChildren &remainingChildren = stack.top();
-
-        PLItem *item = static_cast<PLItem *>( *remainingChildren.next );
-        if( item->id() == i_id )
-            return item;
+    /* The cache covers the whole tree below rootItem */
+    return plitemCache.value( i_id, NULL );
+}
 
-        if( ++remainingChildren.next == remainingChildren.end )
-            /* there are no more children at this depth level */
-            stack.pop();
+void PLModel::uncacheItem( PLItem *item )
+{
+    plitemCache.remove( item->id() );
+    uncacheChildren( item );
+}
 
-        if( item->childCount() )
-            stack.push( {item->children.cbegin(), item->children.cend()} );
-    }
-    return NULL;
+void PLModel::uncacheChildren( PLItem *item )
+{
+    foreach( AbstractPLItem *child, item->children )
+        uncacheItem( static_cast<PLItem *>( child ) );
 }
 
 PLItem *PLModel::findByInput( PLItem *root, const input_item_t *input ) const
@@ -630,9 +616,8 @@ void PLModel::processItemAppend( int i_pl_itemid, int i_pl_itemidparent )
     PLItem *nodeParentItem = findByPLId( rootItem, i_pl_itemidparent );
     if( !nodeParentItem ) return;
 
-    /* Search for an already matching children */
-    foreach( AbstractPLItem *existing, nodeParentItem->children )
-        if( existing->id() == i_pl_itemid ) return;
+    /* Search for an already matching item */
+    if( plitemCache.contains( i_pl_itemid ) ) return;
 
     /* Find the child */
     {
@@ -651,6 +636,7 @@ void PLModel::processItemAppend( int i_pl_itemid, int i_pl_itemidparent )
     /* We insert the newItem (children) inside the parent */
     beginInsertRows( index( nodeParentItem, 0 ), pos, pos );
     nodeParentItem->insertChild( newItem, pos );
+    plitemCache.insert( newItem->id(), newItem );
     endInsertRows();
     if ( newItem->inputItem() == THEMIM->currentInputItem() )
         emit currentIndexChanged( index( newItem, 0 ) );
@@ -666,6 +652,7 @@ void PLModel::rebuild( playlist_item_t *p_root )
     {
         vlc_playlist_locker pl_lock ( THEPL );
 
+        plitemCache.clear();
         if( rootItem ) rootItem->clearChildren();
         if( p_root ) // Can be NULL
         {
@@ -673,6 +660,7 @@ void PLModel::rebuild( playlist_item_t *p_root )
             rootItem = new PLItem( p_root );
         }
         assert( rootItem );
+        plitemCache.insert( rootItem->id(), rootItem );
         /* Recreate from root */
         updateChildren( rootItem );
     }
@@ -712,6 +700,8 @@ void PLModel::removeItem( PLItem *item )
 {
     if( !item ) return;
 
+    uncacheItem( item );
+
     if( item->parent() ) {
         int i = item->parent()->indexOf( item );
         beginRemoveRows( index( static_cast<PLItem*>(item->parent()), 0), i, i );
@@ -743,6 +733,7 @@ void PLModel::updateChildren( playlist_item_t *p_node, PLItem *root )
         if( p_node->pp_children[i]->i_flags & PLAYLIST_DBL_FLAG ) continue;
         PLItem *newItem =  new PLItem( p_node->pp_children[i], root );
         root->appendChild( newItem );
+        plitemCache.insert( newItem->id(), newItem );
         if( p_node->pp_children[i]->i_children != -1 )
             updateChildren( p_node->pp_children[i], newItem );
     }
@@ -827,6 +818,7 @@ void PLModel::sort( QModelIndex caller, QModelIndex rootIndex, const int column,
     if( count )
     {
         beginRemoveRows( qIndex, 0, count - 1 );
+        uncacheChildren( item );
         item->clearChildren();
         endRemoveRows( );
     }
@@ -881,6 +873,7 @@ void PLModel::filter( const QString& search_text, const QModelIndex & idx, bool
             PLItem *searchRoot = getItem( idx );
 
             beginRemoveRows( idx, 0, searchRoot->childCount() - 1 );
+            uncacheChildren( searchRoot );
             searchRoot->clearChildren();
             endRemoveRows();
 
@@ -36,6 +36,7 @@
 
 #include <QObject>
 #include <QEvent>
+#include <QHash>
 #include <QSignalMapper>
 #include <QMimeData>
 #include <QAbstractItemModel>
@@ -144,6 +145,12 @@ private:
     PLItem *findByPLId( PLItem *, int i_plitemid ) const;
     PLItem *findByInput( PLItem *, const input_item_t * ) const;
     PLItem *findByInputLocked( PLItem *, const input_item_t * ) const;
+    /* Playlist id to item cache covering the whole current tree, so that
+     * core playlist events do not walk the model on every update. Any
+     * method deleting items must drop them from the cache first. */
+    void uncacheItem( PLItem * );
+    void uncacheChildren( PLItem * );
+    QHash<int, PLItem *> plitemCache;
     enum pl_nodetype
     {
         ROOTTYPE_CURRENT_PLAYING,
@@ -51,6 +51,11 @@ int VLCModelSubInterface::columnFromMeta( int meta_col )
 VLCModel::VLCModel( intf_thread_t *_p_intf, QObject *parent )
     : QAbstractItemModel( parent ), VLCModelSubInterface(), p_intf(_p_intf)
 {
+    /* The default 10MB pixmap cache holds a few dozen covers only, and
+     * evicts constantly while scrolling large grid views */
+    if( QPixmapCache::cacheLimit() < 32 * 1024 )
+        QPixmapCache::setCacheLimit( 32 * 1024 );
+
     /* Icons initialization */
 #define ADD_ICON(type, x) icons[ITEM_TYPE_##type] = QIcon( x )
     ADD_ICON( UNKNOWN , QPixmap( type_unknown_xpm ) );
@@ -89,7 +94,11 @@ QPixmap VLCModel::getArtPixmap( const QModelIndex & index, const QSize & size )
         {
             QImageReader reader( artUrl );
             reader.setDecideFormatFromContent( true );
-            artPix = QPixmap::fromImageReader( &reader ).scaled( size );
+            /* Decode directly at display size: the JPEG reader downscales
+             * while decoding, much cheaper than decoding the full cover
+             * and rescaling the result */
+            reader.setScaledSize( size );
+            artPix = QPixmap::fromImageReader( &reader );
             if ( artPix.isNull() == false )
             {
                 QPixmapCache::insert( key, artPix );
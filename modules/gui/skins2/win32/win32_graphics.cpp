@@ -49,6 +49,8 @@ Win32Graphics::Win32Graphics( intf_thread_t *pIntf, int width, int height ):
 
     // Create the mask
     m_mask = CreateRectRgn( 0, 0, 0, 0 );
+    m_appliedMask = CreateRectRgn( 0, 0, 0, 0 );
+    m_appliedWindow = NULL;
 }
 
 
@@ -56,6 +58,7 @@ Win32Graphics::~Win32Graphics()
 {
     DeleteDC( m_hDC );
     DeleteObject( m_mask );
+    DeleteObject( m_appliedMask );
 }
 
 
@@ -316,11 +319,20 @@ void Win32Graphics::applyMaskToWindow( OSWindow &rWindow )
     // Get window handle
     HWND hWnd = ((Win32Window&)rWindow).getHandle();
 
+    // Partial refreshes rebuild the mask without necessarily changing it;
+    // skip SetWindowRgn() (and the full redraw it forces) in that case
+    if( hWnd == m_appliedWindow && EqualRgn( m_mask, m_appliedMask ) )
+        return;
+
     // Apply the mask
     // We need to copy the mask, because SetWindowRgn modifies it in our back
     HRGN mask = CreateRectRgn( 0, 0, 0, 0 );
     CombineRgn( mask, m_mask, NULL, RGN_COPY );
     SetWindowRgn( hWnd, mask, TRUE );
+
+    // Remember the shape last given to this window
+    CombineRgn( m_appliedMask, m_mask, NULL, RGN_COPY );
+    m_appliedWindow = hWnd;
 }
 
 
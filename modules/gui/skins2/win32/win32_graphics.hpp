@@ -93,6 +93,12 @@ private:
     /// Transparency mask
     HRGN m_mask;
 
+    /// Mask last applied to a window, to skip redundant SetWindowRgn()
+    HRGN m_appliedMask;
+
+    /// Window the mask was last applied to
+    HWND m_appliedWindow;
+
     /// Add a segment in a region
     void addSegmentInRegion( HRGN &rMask, int start, int end, int line );
 
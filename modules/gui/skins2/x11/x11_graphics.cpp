@@ -58,6 +58,8 @@ X11Graphics::X11Graphics( intf_thread_t *pIntf, X11Display &rDisplay,
 
     // Create the transparency mask (everything is transparent initially)
     m_mask = XCreateRegion();
+    m_appliedMask = XCreateRegion();
+    m_appliedWindow = None;
 
     // Create a Graphics Context that does not generate GraphicsExpose events
     XGCValues xgcvalues;
@@ -70,6 +72,7 @@ X11Graphics::~X11Graphics()
 {
     XFreeGC( XDISPLAY, m_gc );
     XDestroyRegion( m_mask );
+    XDestroyRegion( m_appliedMask );
     XFreePixmap( XDISPLAY, m_pixmap );
 }
 
@@ -321,12 +324,23 @@ void X11Graphics::applyMaskToWindow( OSWindow &rWindow )
     // Get the target window
     Window win = ((X11Window&)rWindow).getDrawable();
 
+    // Partial refreshes rebuild the mask without necessarily changing it;
+    // skip the server round-trip when the applied shape is still current
+    if( win == m_appliedWindow && XEqualRegion( m_mask, m_appliedMask ) )
+        return;
+
     // ensure the window size is right
     XResizeWindow( XDISPLAY, win, m_width, m_height );
 
     // Change the shape of the window
     XShapeCombineRegion( XDISPLAY, win, ShapeBounding, 0, 0, m_mask,
                          ShapeSet );
+
+    // Remember the shape last given to this window
+    XDestroyRegion( m_appliedMask );
+    m_appliedMask = XCreateRegion();
+    XUnionRegion( m_mask, m_appliedMask, m_appliedMask );
+    m_appliedWindow = win;
 }
 
 
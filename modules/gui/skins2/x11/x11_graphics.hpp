@@ -95,6 +95,10 @@ private:
     Pixmap m_pixmap;
     /// Transparency mask
     Region m_mask;
+    /// Mask last applied to a window, to skip redundant shape updates
+    Region m_appliedMask;
+    /// Window the mask was last applied to
+    Window m_appliedWindow;
     /// Graphics context
     GC m_gc;
 
@@ -51,15 +51,25 @@
 #define CAN_PROCESSOR 0
 #endif
 
+/* number of staging textures cycled through for GPU to CPU copies, keeps the
+ * GPU from waiting on the CPU unmap of the previous frame before starting the
+ * next copyout */
+#define STAGING_RING_COUNT 2
+
 typedef struct
 {
     copy_cache_t     cache;
     union {
-        ID3D11Texture2D  *staging;
-        ID3D11Resource   *staging_resource;
+        ID3D11Texture2D  *staging[STAGING_RING_COUNT];
+        ID3D11Resource   *staging_resource[STAGING_RING_COUNT];
     };
+    unsigned         staging_idx;
     vlc_mutex_t      staging_lock;
 
+    /* readback statistics */
+    unsigned         readbacks;
+    unsigned         map_stalls;
+
 #if CAN_PROCESSOR
     union {
         ID3D11Texture2D  *procOutTexture;
@@ -144,18 +154,33 @@ error:
 static HRESULT can_map(filter_sys_t *sys, ID3D11DeviceContext *context)
 {
     D3D11_MAPPED_SUBRESOURCE lock;
-    HRESULT hr = ID3D11DeviceContext_Map(context, sys->staging_resource, 0,
+    HRESULT hr = ID3D11DeviceContext_Map(context, sys->staging_resource[0], 0,
                                          D3D11_MAP_READ, 0, &lock);
-    ID3D11DeviceContext_Unmap(context, sys->staging_resource, 0);
+    ID3D11DeviceContext_Unmap(context, sys->staging_resource[0], 0);
     return hr;
 }
 
+/* Map a staging texture for reading, counting the times the GPU copyout was
+ * not finished yet and the CPU had to wait for it */
+static HRESULT MapStagingRead(filter_sys_t *sys, ID3D11DeviceContext *context,
+                              ID3D11Resource *staging,
+                              D3D11_MAPPED_SUBRESOURCE *lock)
+{
+    sys->readbacks++;
+    HRESULT hr = ID3D11DeviceContext_Map(context, staging, 0, D3D11_MAP_READ,
+                                         D3D11_MAP_FLAG_DO_NOT_WAIT, lock);
+    if (hr != DXGI_ERROR_WAS_STILL_DRAWING)
+        return hr;
+    sys->map_stalls++;
+    return ID3D11DeviceContext_Map(context, staging, 0, D3D11_MAP_READ, 0, lock);
+}
+
 static int assert_staging(filter_t *p_filter, picture_sys_t *p_sys)
 {
     filter_sys_t *sys = p_filter->p_sys;
     HRESULT hr;
 
-    if (sys->staging)
+    if (sys->staging[0])
         goto ok;
 
     D3D11_TEXTURE2D_DESC texDesc;
@@ -171,8 +196,8 @@ static int assert_staging(filter_t *p_filter, picture_sys_t *p_sys)
 
     d3d11_device_t d3d_dev = { .d3dcontext = p_sys->context };
     ID3D11DeviceContext_GetDevice(d3d_dev.d3dcontext, &d3d_dev.d3ddevice);
-    sys->staging = NULL;
-    hr = ID3D11Device_CreateTexture2D( d3d_dev.d3ddevice, &texDesc, NULL, &sys->staging);
+    sys->staging[0] = NULL;
+    hr = ID3D11Device_CreateTexture2D( d3d_dev.d3ddevice, &texDesc, NULL, &sys->staging[0]);
     /* test if mapping the texture works ref #18746 */
     if (SUCCEEDED(hr) && FAILED(hr = can_map(sys, p_sys->context)))
         msg_Dbg(p_filter, "can't map default staging texture (hr=0x%0lx)", hr);
@@ -186,7 +211,7 @@ static int assert_staging(filter_t *p_filter, picture_sys_t *p_sys)
         {
             DXGI_FORMAT srcFormat = texDesc.Format;
             texDesc.Format = new_fmt->formatTexture;
-            hr = ID3D11Device_CreateTexture2D( d3d_dev.d3ddevice, &texDesc, NULL, &sys->staging);
+            hr = ID3D11Device_CreateTexture2D( d3d_dev.d3ddevice, &texDesc, NULL, &sys->staging[0]);
             if (SUCCEEDED(hr))
             {
                 texDesc.Usage = D3D11_USAGE_DEFAULT;
@@ -199,8 +224,8 @@ static int assert_staging(filter_t *p_filter, picture_sys_t *p_sys)
                     if (SetupProcessor(p_filter, &d3d_dev, srcFormat, new_fmt->formatTexture))
                     {
                         ID3D11Texture2D_Release(sys->procOutTexture);
-                        ID3D11Texture2D_Release(sys->staging);
-                        sys->staging = NULL;
+                        ID3D11Texture2D_Release(sys->staging[0]);
+                        sys->staging[0] = NULL;
                         hr = E_FAIL;
                     }
                     else
@@ -209,13 +234,33 @@ static int assert_staging(filter_t *p_filter, picture_sys_t *p_sys)
                 else
                 {
                     msg_Dbg(p_filter, "can't create intermediate texture (hr=0x%0lx)", hr);
-                    ID3D11Texture2D_Release(sys->staging);
-                    sys->staging = NULL;
+                    ID3D11Texture2D_Release(sys->staging[0]);
+                    sys->staging[0] = NULL;
                 }
             }
         }
     }
 #endif
+    if (SUCCEEDED(hr))
+    {
+        /* fill the rest of the staging ring with the same description as the
+         * texture that was proven to be mappable */
+        D3D11_TEXTURE2D_DESC stagingDesc;
+        ID3D11Texture2D_GetDesc(sys->staging[0], &stagingDesc);
+        for (size_t i = 1; i < ARRAY_SIZE(sys->staging); i++)
+        {
+            hr = ID3D11Device_CreateTexture2D( d3d_dev.d3ddevice, &stagingDesc, NULL, &sys->staging[i]);
+            if (FAILED(hr))
+            {
+                while (i != 0)
+                {
+                    ID3D11Texture2D_Release(sys->staging[--i]);
+                    sys->staging[i] = NULL;
+                }
+                break;
+            }
+        }
+    }
     ID3D11Device_Release(d3d_dev.d3ddevice);
     if (FAILED(hr)) {
         msg_Err(p_filter, "Failed to create a %s staging texture to extract surface pixels (hr=0x%0lx)", DxgiFormatToStr(texDesc.Format), hr );
@@ -246,6 +291,9 @@ static void D3D11_YUY2(filter_t *p_filter, picture_t *src, picture_t *dst)
         vlc_mutex_unlock(&sys->staging_lock);
         return;
     }
+    ID3D11Texture2D *staging = sys->staging[sys->staging_idx];
+    ID3D11Resource *staging_resource = sys->staging_resource[sys->staging_idx];
+    sys->staging_idx = (sys->staging_idx + 1) % STAGING_RING_COUNT;
 
     UINT srcSlice;
     D3D11_VIDEO_DECODER_OUTPUT_VIEW_DESC viewDesc;
@@ -285,14 +333,13 @@ static void D3D11_YUY2(filter_t *p_filter, picture_t *src, picture_t *dst)
         srcSlice = 0;
     }
 #endif
-    ID3D11DeviceContext_CopySubresourceRegion(p_sys->context, sys->staging_resource,
+    ID3D11DeviceContext_CopySubresourceRegion(p_sys->context, staging_resource,
                                               0, 0, 0, 0,
                                               srcResource,
                                               srcSlice,
                                               NULL);
 
-    HRESULT hr = ID3D11DeviceContext_Map(p_sys->context, sys->staging_resource,
-                                         0, D3D11_MAP_READ, 0, &lock);
+    HRESULT hr = MapStagingRead(sys, p_sys->context, staging_resource, &lock);
     if (FAILED(hr)) {
         msg_Err(p_filter, "Failed to map source surface. (hr=0x%0lx)", hr);
         vlc_mutex_unlock(&sys->staging_lock);
@@ -302,7 +349,7 @@ static void D3D11_YUY2(filter_t *p_filter, picture_t *src, picture_t *dst)
     if (dst->format.i_chroma == VLC_CODEC_I420)
         picture_SwapUV( dst );
 
-    ID3D11Texture2D_GetDesc(sys->staging, &desc);
+    ID3D11Texture2D_GetDesc(staging, &desc);
 
     if (desc.Format == DXGI_FORMAT_YUY2) {
         size_t chroma_pitch = (lock.RowPitch / 2);
@@ -350,7 +397,7 @@ static void D3D11_YUY2(filter_t *p_filter, picture_t *src, picture_t *dst)
         picture_SwapUV( dst );
 
     /* */
-    ID3D11DeviceContext_Unmap(p_sys->context, sys->staging_resource, 0);
+    ID3D11DeviceContext_Unmap(p_sys->context, staging_resource, 0);
     vlc_mutex_unlock(&sys->staging_lock);
 }
 
@@ -375,6 +422,9 @@ static void D3D11_NV12(filter_t *p_filter, picture_t *src, picture_t *dst)
         vlc_mutex_unlock(&sys->staging_lock);
         return;
     }
+    ID3D11Texture2D *staging = sys->staging[sys->staging_idx];
+    ID3D11Resource *staging_resource = sys->staging_resource[sys->staging_idx];
+    sys->staging_idx = (sys->staging_idx + 1) % STAGING_RING_COUNT;
 
     UINT srcSlice;
     if (!p_sys->decoder)
@@ -413,21 +463,20 @@ static void D3D11_NV12(filter_t *p_filter, picture_t *src, picture_t *dst)
         srcSlice = 0;
     }
 #endif
-    ID3D11DeviceContext_CopySubresourceRegion(p_sys->context, sys->staging_resource,
+    ID3D11DeviceContext_CopySubresourceRegion(p_sys->context, staging_resource,
                                               0, 0, 0, 0,
                                               srcResource,
                                               srcSlice,
                                               NULL);
 
-    HRESULT hr = ID3D11DeviceContext_Map(p_sys->context, sys->staging_resource,
-                                         0, D3D11_MAP_READ, 0, &lock);
+    HRESULT hr = MapStagingRead(sys, p_sys->context, staging_resource, &lock);
     if (FAILED(hr)) {
         msg_Err(p_filter, "Failed to map source surface. (hr=0x%0lx)", hr);
         vlc_mutex_unlock(&sys->staging_lock);
         return;
     }
 
-    ID3D11Texture2D_GetDesc(sys->staging, &desc);
+    ID3D11Texture2D_GetDesc(staging, &desc);
 
     if (desc.Format == DXGI_FORMAT_NV12 || desc.Format == DXGI_FORMAT_P010) {
         const uint8_t *plane[2] = {
@@ -446,7 +495,7 @@ static void D3D11_NV12(filter_t *p_filter, picture_t *src, picture_t *dst)
     }
 
     /* */
-    ID3D11DeviceContext_Unmap(p_sys->context, sys->staging_resource, 0);
+    ID3D11DeviceContext_Unmap(p_sys->context, staging_resource, 0);
     vlc_mutex_unlock(&sys->staging_lock);
 }
 
@@ -465,22 +514,24 @@ static void D3D11_RGBA(filter_t *p_filter, picture_t *src, picture_t *dst)
         vlc_mutex_unlock(&sys->staging_lock);
         return;
     }
+    ID3D11Texture2D *staging = sys->staging[sys->staging_idx];
+    ID3D11Resource *staging_resource = sys->staging_resource[sys->staging_idx];
+    sys->staging_idx = (sys->staging_idx + 1) % STAGING_RING_COUNT;
 
-    ID3D11DeviceContext_CopySubresourceRegion(p_sys->context, sys->staging_resource,
+    ID3D11DeviceContext_CopySubresourceRegion(p_sys->context, staging_resource,
                                               0, 0, 0, 0,
                                               p_sys->resource[KNOWN_DXGI_INDEX],
                                               p_sys->slice_index,
                                               NULL);
 
-    HRESULT hr = ID3D11DeviceContext_Map(p_sys->context, sys->staging_resource,
-                                         0, D3D11_MAP_READ, 0, &lock);
+    HRESULT hr = MapStagingRead(sys, p_sys->context, staging_resource, &lock);
     if (FAILED(hr)) {
         msg_Err(p_filter, "Failed to map source surface. (hr=0x%0lx)", hr);
         vlc_mutex_unlock(&sys->staging_lock);
         return;
     }
 
-    ID3D11Texture2D_GetDesc(sys->staging, &desc);
+    ID3D11Texture2D_GetDesc(staging, &desc);
 
     plane_t src_planes  = dst->p[0];
     src_planes.i_lines  = desc.Height;
@@ -489,8 +540,7 @@ static void D3D11_RGBA(filter_t *p_filter, picture_t *src, picture_t *dst)
     plane_CopyPixels( dst->p, &src_planes );
 
     /* */
-    ID3D11DeviceContext_Unmap(p_sys->context,
-                              p_sys->resource[KNOWN_DXGI_INDEX], p_sys->slice_index);
+    ID3D11DeviceContext_Unmap(p_sys->context, staging_resource, 0);
     vlc_mutex_unlock(&sys->staging_lock);
 }
 
@@ -836,10 +886,14 @@ void D3D11CloseConverter( vlc_object_t *obj )
         ID3D11Texture2D_Release(p_sys->procOutTexture);
     D3D11_ReleaseProcessor( &p_sys->d3d_proc );
 #endif
+    if (p_sys->readbacks > 0)
+        msg_Dbg(p_filter, "%u readbacks, %u waited for the GPU copyout",
+                p_sys->readbacks, p_sys->map_stalls);
     CopyCleanCache(&p_sys->cache);
     vlc_mutex_destroy(&p_sys->staging_lock);
-    if (p_sys->staging)
-        ID3D11Texture2D_Release(p_sys->staging);
+    for (size_t i = 0; i < ARRAY_SIZE(p_sys->staging); i++)
+        if (p_sys->staging[i])
+            ID3D11Texture2D_Release(p_sys->staging[i]);
     D3D11_FilterReleaseInstance(&p_sys->d3d_dev);
     D3D11_Destroy(&p_sys->hd3d);
 }
@@ -0,0 +1,450 @@
+/*****************************************************************************
+ * converter.c: MMAL-based opaque to CPU picture converter for Raspberry Pi
+ *****************************************************************************
+ * Copyright © 2018 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdatomic.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+
+#include "mmal_picture.h"
+
+#include <bcm_host.h>
+#include <interface/mmal/mmal.h>
+#include <interface/mmal/util/mmal_util.h>
+#include <interface/mmal/util/mmal_default_components.h>
+
+/* The ISP block converts between VideoCore opaque frames and regular
+ * host-visible formats without touching the ARM side. */
+#define MMAL_COMPONENT_ISP "vc.ril.isp"
+
+#define CONVERTER_BUFFERS 2
+#define CONVERTER_TIMEOUT_MS 2000
+
+static int Open(filter_t *filter);
+static void Close(filter_t *filter);
+
+vlc_module_begin()
+    set_shortname(N_("MMAL converter"))
+    set_description(N_("MMAL-based GPU to CPU picture converter"))
+    set_capability("video converter", 10)
+    set_category(CAT_VIDEO)
+    set_subcategory(SUBCAT_VIDEO_VFILTER)
+    set_callbacks(Open, Close)
+vlc_module_end()
+
+typedef struct
+{
+    MMAL_COMPONENT_T *component;
+    MMAL_PORT_T *input;
+    MMAL_PORT_T *output;
+
+    /* empty headers replicating the source opaque buffers, so a picture
+     * which is simultaneously owned by the vout can still be converted */
+    MMAL_POOL_T *input_pool;
+    /* empty headers pointing into the destination picture planes */
+    MMAL_POOL_T *output_pool;
+    MMAL_QUEUE_T *converted;
+
+    /* plane layout the output format was committed with */
+    int out_pitch;
+    int out_lines;
+
+    vlc_sem_t sem;
+    atomic_int input_in_transit;
+    atomic_int output_in_transit;
+} filter_sys_t;
+
+static void control_port_cb(MMAL_PORT_T *port, MMAL_BUFFER_HEADER_T *buffer)
+{
+    filter_t *filter = (filter_t *)port->userdata;
+    MMAL_STATUS_T status;
+
+    if (buffer->cmd == MMAL_EVENT_ERROR) {
+        status = *(uint32_t *)buffer->data;
+        msg_Err(filter, "MMAL error %"PRIx32" \"%s\"", status,
+                mmal_status_to_string(status));
+    }
+
+    mmal_buffer_header_release(buffer);
+}
+
+static void input_port_cb(MMAL_PORT_T *port, MMAL_BUFFER_HEADER_T *buffer)
+{
+    filter_t *filter = (filter_t *)port->userdata;
+    filter_sys_t *sys = filter->p_sys;
+    picture_t *picture = (picture_t *)buffer->user_data;
+
+    buffer->user_data = NULL;
+    mmal_buffer_header_release(buffer);
+    if (picture)
+        picture_Release(picture);
+
+    atomic_fetch_sub(&sys->input_in_transit, 1);
+    vlc_sem_post(&sys->sem);
+}
+
+static void output_port_cb(MMAL_PORT_T *port, MMAL_BUFFER_HEADER_T *buffer)
+{
+    filter_t *filter = (filter_t *)port->userdata;
+    filter_sys_t *sys = filter->p_sys;
+
+    if (buffer->cmd == 0) {
+        mmal_queue_put(sys->converted, buffer);
+    } else {
+        if (buffer->cmd == MMAL_EVENT_FORMAT_CHANGED)
+            msg_Warn(filter, "MMAL_EVENT_FORMAT_CHANGED seen but not handled");
+        mmal_buffer_header_release(buffer);
+    }
+
+    atomic_fetch_sub(&sys->output_in_transit, 1);
+    vlc_sem_post(&sys->sem);
+}
+
+/* The ISP writes the destination planes as one contiguous buffer with the
+ * committed pitch, which is how the core allocates I420 pictures. Refuse
+ * pictures coming from pools with another layout. */
+static bool check_dst_layout(filter_t *filter, picture_t *pic)
+{
+    filter_sys_t *sys = filter->p_sys;
+
+    if (pic->p[0].i_pitch != sys->out_pitch ||
+        pic->p[0].i_lines != sys->out_lines)
+    {
+        msg_Err(filter, "unexpected plane layout %dx%d (wanted %dx%d)",
+                pic->p[0].i_pitch, pic->p[0].i_lines,
+                sys->out_pitch, sys->out_lines);
+        return false;
+    }
+
+    for (int i = 1; i < pic->i_planes; i++)
+        if (pic->p[i].p_pixels != pic->p[i - 1].p_pixels +
+                pic->p[i - 1].i_pitch * pic->p[i - 1].i_lines)
+        {
+            msg_Err(filter, "non contiguous planes are not supported");
+            return false;
+        }
+
+    return true;
+}
+
+static void flush(filter_t *filter);
+
+static picture_t *convert(filter_t *filter, picture_t *src)
+{
+    filter_sys_t *sys = filter->p_sys;
+    MMAL_BUFFER_HEADER_T *in_buffer, *out_buffer;
+    MMAL_STATUS_T status;
+
+    picture_t *dst = filter_NewPicture(filter);
+    if (!dst)
+        goto drop;
+
+    if (!check_dst_layout(filter, dst))
+        goto drop;
+
+    /* Give the component somewhere to write before feeding the input */
+    out_buffer = mmal_queue_get(sys->output_pool->queue);
+    if (!out_buffer)
+        goto drop;
+    out_buffer->user_data = NULL;
+    out_buffer->cmd = 0;
+    out_buffer->data = dst->p[0].p_pixels;
+    out_buffer->alloc_size = sys->output->buffer_size;
+    out_buffer->length = 0;
+
+    status = mmal_port_send_buffer(sys->output, out_buffer);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to send buffer to output port (status=%"PRIx32" %s)",
+                status, mmal_status_to_string(status));
+        mmal_buffer_header_release(out_buffer);
+        goto drop;
+    }
+    atomic_fetch_add(&sys->output_in_transit, 1);
+
+    in_buffer = mmal_queue_get(sys->input_pool->queue);
+    if (!in_buffer)
+        goto drop_flush;
+    status = mmal_buffer_header_replicate(in_buffer, src->p_sys->buffer);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to replicate input buffer (status=%"PRIx32" %s)",
+                status, mmal_status_to_string(status));
+        mmal_buffer_header_release(in_buffer);
+        goto drop_flush;
+    }
+    in_buffer->user_data = picture_Hold(src);
+    in_buffer->pts = src->date;
+    in_buffer->cmd = 0;
+
+    status = mmal_port_send_buffer(sys->input, in_buffer);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to send buffer to input port (status=%"PRIx32" %s)",
+                status, mmal_status_to_string(status));
+        picture_Release(src);
+        in_buffer->user_data = NULL;
+        mmal_buffer_header_release(in_buffer);
+        goto drop_flush;
+    }
+    atomic_fetch_add(&sys->input_in_transit, 1);
+
+    out_buffer = mmal_queue_timedwait(sys->converted, CONVERTER_TIMEOUT_MS);
+    if (!out_buffer) {
+        msg_Err(filter, "Failed waiting for converted picture");
+        goto drop_flush;
+    }
+
+    bool converted = out_buffer->length > 0;
+    mmal_buffer_header_release(out_buffer);
+    if (!converted)
+        goto drop;
+
+    picture_CopyProperties(dst, src);
+    picture_Release(src);
+    return dst;
+
+drop_flush:
+    /* the component may still write into the destination planes, wait for
+     * the in-flight buffers before the picture can be released */
+    flush(filter);
+drop:
+    if (dst)
+        picture_Release(dst);
+    picture_Release(src);
+    return NULL;
+}
+
+static void flush(filter_t *filter)
+{
+    filter_sys_t *sys = filter->p_sys;
+    MMAL_BUFFER_HEADER_T *buffer;
+
+    mmal_port_flush(sys->output);
+    mmal_port_flush(sys->input);
+
+    while (atomic_load(&sys->input_in_transit) ||
+            atomic_load(&sys->output_in_transit))
+        vlc_sem_wait(&sys->sem);
+
+    while ((buffer = mmal_queue_get(sys->converted)))
+        mmal_buffer_header_release(buffer);
+}
+
+static int Open(filter_t *filter)
+{
+    int ret = VLC_SUCCESS;
+    MMAL_STATUS_T status;
+    filter_sys_t *sys;
+
+    if (filter->fmt_in.video.i_chroma != VLC_CODEC_MMAL_OPAQUE)
+        return VLC_EGENERIC;
+
+    if (filter->fmt_out.video.i_chroma != VLC_CODEC_I420)
+        return VLC_EGENERIC;
+
+    if (filter->fmt_in.video.i_width != filter->fmt_out.video.i_width ||
+        filter->fmt_in.video.i_height != filter->fmt_out.video.i_height)
+        return VLC_EGENERIC;
+
+    sys = calloc(1, sizeof(filter_sys_t));
+    if (!sys)
+        return VLC_ENOMEM;
+    filter->p_sys = sys;
+    vlc_sem_init(&sys->sem, 0);
+
+    bcm_host_init();
+
+    /* Probe the plane layout the core will allocate destination pictures
+     * with, the component writes into them directly */
+    picture_t *probe = picture_NewFromFormat(&filter->fmt_out.video);
+    if (!probe) {
+        ret = VLC_ENOMEM;
+        goto out;
+    }
+    sys->out_pitch = probe->p[0].i_pitch;
+    sys->out_lines = probe->p[0].i_lines;
+    picture_Release(probe);
+
+    status = mmal_component_create(MMAL_COMPONENT_ISP, &sys->component);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to create MMAL component %s (status=%"PRIx32" %s)",
+                MMAL_COMPONENT_ISP, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+
+    sys->component->control->userdata = (struct MMAL_PORT_USERDATA_T *)filter;
+    status = mmal_port_enable(sys->component->control, control_port_cb);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to enable control port %s (status=%"PRIx32" %s)",
+                sys->component->control->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+
+    sys->input = sys->component->input[0];
+    sys->input->userdata = (struct MMAL_PORT_USERDATA_T *)filter;
+    sys->input->format->encoding = MMAL_ENCODING_OPAQUE;
+    sys->input->format->es->video.width = filter->fmt_in.video.i_width;
+    sys->input->format->es->video.height = filter->fmt_in.video.i_height;
+    sys->input->format->es->video.crop.x = 0;
+    sys->input->format->es->video.crop.y = 0;
+    sys->input->format->es->video.crop.width = filter->fmt_in.video.i_width;
+    sys->input->format->es->video.crop.height = filter->fmt_in.video.i_height;
+    sys->input->format->es->video.par.num = filter->fmt_in.video.i_sar_num;
+    sys->input->format->es->video.par.den = filter->fmt_in.video.i_sar_den;
+
+    status = mmal_port_format_commit(sys->input);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to commit format for input port %s (status=%"PRIx32" %s)",
+                        sys->input->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+    sys->input->buffer_size = sys->input->buffer_size_recommended;
+    sys->input->buffer_num = __MAX(sys->input->buffer_num_recommended,
+                                   CONVERTER_BUFFERS);
+
+    MMAL_PARAMETER_BOOLEAN_T zero_copy = {
+        { MMAL_PARAMETER_ZERO_COPY, sizeof(MMAL_PARAMETER_BOOLEAN_T) },
+        1
+    };
+    status = mmal_port_parameter_set(sys->input, &zero_copy.hdr);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to set zero copy on port %s (status=%"PRIx32" %s)",
+                sys->input->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+
+    status = mmal_port_enable(sys->input, input_port_cb);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to enable input port %s (status=%"PRIx32" %s)",
+                sys->input->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+
+    sys->output = sys->component->output[0];
+    sys->output->userdata = (struct MMAL_PORT_USERDATA_T *)filter;
+    mmal_format_full_copy(sys->output->format, sys->input->format);
+    sys->output->format->encoding = MMAL_ENCODING_I420;
+    /* the committed width/height carry the destination plane layout, the
+     * crop rectangle carries the visible area */
+    sys->output->format->es->video.width = sys->out_pitch;
+    sys->output->format->es->video.height = sys->out_lines;
+    sys->output->format->es->video.crop.width = filter->fmt_out.video.i_width;
+    sys->output->format->es->video.crop.height = filter->fmt_out.video.i_height;
+
+    status = mmal_port_format_commit(sys->output);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to commit format for output port %s (status=%"PRIx32" %s)",
+                        sys->output->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+    sys->output->buffer_size = sys->out_pitch * sys->out_lines * 3 / 2;
+    sys->output->buffer_num = CONVERTER_BUFFERS;
+
+    status = mmal_port_enable(sys->output, output_port_cb);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to enable output port %s (status=%"PRIx32" %s)",
+                sys->output->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+
+    status = mmal_component_enable(sys->component);
+    if (status != MMAL_SUCCESS) {
+        msg_Err(filter, "Failed to enable component %s (status=%"PRIx32" %s)",
+                sys->component->name, status, mmal_status_to_string(status));
+        ret = VLC_EGENERIC;
+        goto out;
+    }
+
+    /* headers only, the payloads are the source opaque handles and the
+     * destination picture planes */
+    sys->input_pool = mmal_pool_create(sys->input->buffer_num, 0);
+    sys->output_pool = mmal_pool_create(sys->output->buffer_num, 0);
+    sys->converted = mmal_queue_create();
+    if (!sys->input_pool || !sys->output_pool || !sys->converted) {
+        ret = VLC_ENOMEM;
+        goto out;
+    }
+
+    filter->pf_video_filter = convert;
+    filter->pf_flush = flush;
+
+    msg_Dbg(filter, "%4.4s to %4.4s converter using %s",
+            (const char *)&filter->fmt_in.video.i_chroma,
+            (const char *)&filter->fmt_out.video.i_chroma,
+            MMAL_COMPONENT_ISP);
+
+out:
+    if (ret != VLC_SUCCESS)
+        Close(filter);
+
+    return ret;
+}
+
+static void Close(filter_t *filter)
+{
+    filter_sys_t *sys = filter->p_sys;
+    MMAL_BUFFER_HEADER_T *buffer;
+
+    if (!sys)
+        return;
+
+    if (sys->component && sys->component->control->is_enabled)
+        mmal_port_disable(sys->component->control);
+
+    if (sys->input && sys->input->is_enabled)
+        mmal_port_disable(sys->input);
+
+    if (sys->output && sys->output->is_enabled)
+        mmal_port_disable(sys->output);
+
+    if (sys->component && sys->component->is_enabled)
+        mmal_component_disable(sys->component);
+
+    if (sys->converted) {
+        while ((buffer = mmal_queue_get(sys->converted)))
+            mmal_buffer_header_release(buffer);
+        mmal_queue_destroy(sys->converted);
+    }
+
+    if (sys->input_pool)
+        mmal_pool_destroy(sys->input_pool);
+
+    if (sys->output_pool)
+        mmal_pool_destroy(sys->output_pool);
+
+    if (sys->component)
+        mmal_component_release(sys->component);
+
+    vlc_sem_destroy(&sys->sem);
+    free(sys);
+
+    bcm_host_deinit();
+}
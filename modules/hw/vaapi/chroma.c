@@ -47,6 +47,11 @@ typedef struct
 
     bool                derive_failed;
     bool                image_fallback_failed;
+    VAImage             image_fallback; /* cached vaGetImage() target */
+
+    /* readback path counters, reported on close */
+    unsigned            derive_pics;
+    unsigned            getimage_pics;
 } filter_sys_t;
 
 static int CreateFallbackImage(filter_t *filter, picture_t *src_pic,
@@ -137,7 +142,6 @@ DownloadSurface(filter_t *filter, picture_t *src_pic)
         goto ret;
     }
 
-    VAImageID image_fallback_id = VA_INVALID_ID;
     VASurfaceID surface = vlc_vaapi_PicGetSurface(src_pic);
     if (vaSyncSurface(va_dpy, surface))
         goto error;
@@ -148,24 +152,47 @@ DownloadSurface(filter_t *filter, picture_t *src_pic)
         if (filter_sys->image_fallback_failed)
             goto error;
 
-        filter_sys->derive_failed = true;
+        if (!filter_sys->derive_failed)
+        {
+            msg_Warn(filter, "vaDeriveImage not usable: "
+                     "falling back to vaGetImage readback");
+            filter_sys->derive_failed = true;
+        }
 
-        VAImage image_fallback;
-        if (CreateFallbackImage(filter, src_pic, va_dpy, &image_fallback))
+        if (filter_sys->image_fallback.image_id == VA_INVALID_ID)
         {
-            filter_sys->image_fallback_failed = true;
-            goto error;
+            /* Hold the instance so the cached image can be destroyed on
+             * close, after the last picture is gone */
+            if (filter_sys->va_inst == NULL && src_pic->p_sys != NULL)
+                filter_sys->va_inst =
+                    vlc_vaapi_PicSysHoldInstance(src_pic->p_sys,
+                                                 &filter_sys->dpy);
+            if (filter_sys->va_inst == NULL)
+            {
+                filter_sys->image_fallback_failed = true;
+                goto error;
+            }
+
+            if (CreateFallbackImage(filter, src_pic, va_dpy,
+                                    &filter_sys->image_fallback))
+            {
+                filter_sys->image_fallback_failed = true;
+                goto error;
+            }
         }
-        image_fallback_id = image_fallback.image_id;
 
         if (vaGetImage(va_dpy, surface, 0, 0, src_pic->format.i_width,
-                       src_pic->format.i_height, image_fallback_id))
+                       src_pic->format.i_height,
+                       filter_sys->image_fallback.image_id))
         {
             filter_sys->image_fallback_failed = true;
             goto error;
         }
-        src_img = image_fallback;
+        src_img = filter_sys->image_fallback;
+        filter_sys->getimage_pics++;
     }
+    else
+        filter_sys->derive_pics++;
 
     if (vlc_vaapi_MapBuffer(VLC_OBJECT(filter), va_dpy, src_img.buf, &src_buf))
         goto error;
@@ -173,7 +200,8 @@ DownloadSurface(filter_t *filter, picture_t *src_pic)
     FillPictureFromVAImage(dest, &src_img, src_buf, &filter_sys->cache);
 
     vlc_vaapi_UnmapBuffer(VLC_OBJECT(filter), va_dpy, src_img.buf);
-    vlc_vaapi_DestroyImage(VLC_OBJECT(filter), va_dpy, src_img.image_id);
+    if (src_img.image_id != filter_sys->image_fallback.image_id)
+        vlc_vaapi_DestroyImage(VLC_OBJECT(filter), va_dpy, src_img.image_id);
 
     picture_CopyProperties(dest, src_pic);
 ret:
@@ -181,9 +209,6 @@ ret:
     return dest;
 
 error:
-    if (image_fallback_id != VA_INVALID_ID)
-        vlc_vaapi_DestroyImage(VLC_OBJECT(filter), va_dpy, image_fallback_id);
-
     picture_Release(dest);
     dest = NULL;
     goto ret;
@@ -343,6 +368,7 @@ vlc_vaapi_OpenChroma(vlc_object_t *obj)
     }
     filter_sys->derive_failed = false;
     filter_sys->image_fallback_failed = false;
+    filter_sys->image_fallback.image_id = VA_INVALID_ID;
     if (is_upload)
     {
         filter_sys->va_inst = vlc_vaapi_FilterHoldInstance(filter,
@@ -402,6 +428,14 @@ vlc_vaapi_CloseChroma(vlc_object_t *obj)
     filter_t *filter = (filter_t *)obj;
     filter_sys_t *const filter_sys = filter->p_sys;
 
+    if (filter_sys->derive_pics || filter_sys->getimage_pics)
+        msg_Dbg(filter, "downloaded %u pictures via vaDeriveImage, "
+                "%u via vaGetImage readback",
+                filter_sys->derive_pics, filter_sys->getimage_pics);
+
+    if (filter_sys->image_fallback.image_id != VA_INVALID_ID)
+        vlc_vaapi_DestroyImage(obj, filter_sys->dpy,
+                               filter_sys->image_fallback.image_id);
     if (filter_sys->dest_pics)
         picture_pool_Release(filter_sys->dest_pics);
     if (filter_sys->va_inst != NULL)
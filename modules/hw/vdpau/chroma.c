@@ -58,6 +58,14 @@ typedef struct
         float saturation;
         float hue;
     } procamp;
+
+    /* Mixer state mirror, to skip redundant VDPAU round-trips */
+    bool sharpen_enabled;
+    float sharpen;
+
+    /* statistics */
+    unsigned rendered;
+    unsigned failed;
 } filter_sys_t;
 
 /** Initialize the colour space conversion matrix */
@@ -521,30 +529,43 @@ static picture_t *Render(filter_t *filter, picture_t *src, bool import)
     dst->date = sys->history[MAX_PAST].date;
     dst->b_force = sys->history[MAX_PAST].force;
 
-    /* Enable/Disable features */
-    const VdpVideoMixerFeature features[] = {
-        VDP_VIDEO_MIXER_FEATURE_SHARPNESS,
-    };
-    const VdpBool enables[] = {
-        f->sharpen != 0.f,
-    };
+    /* Enable/Disable features, only when the state actually changes: the
+     * whole pipeline runs in a single mixer render call below, so this is
+     * the only per-frame mixer reconfiguration left. */
+    bool sharpen_enable = f->sharpen != 0.f;
 
-    err = vdp_video_mixer_set_feature_enables(sys->vdp, sys->mixer,
+    if (sharpen_enable != sys->sharpen_enabled)
+    {
+        const VdpVideoMixerFeature features[] = {
+            VDP_VIDEO_MIXER_FEATURE_SHARPNESS,
+        };
+        const VdpBool enables[] = {
+            sharpen_enable,
+        };
+
+        err = vdp_video_mixer_set_feature_enables(sys->vdp, sys->mixer,
                   sizeof (features) / sizeof (features[0]), features, enables);
-    if (err != VDP_STATUS_OK)
-        msg_Err(filter, "video %s %s failure: %s", "mixer", "features",
-                vdp_get_error_string(sys->vdp, err));
+        if (err != VDP_STATUS_OK)
+            msg_Err(filter, "video %s %s failure: %s", "mixer", "features",
+                    vdp_get_error_string(sys->vdp, err));
+        else
+            sys->sharpen_enabled = sharpen_enable;
+    }
 
     /* Configure mixer depending on upstream video filters */
-    VdpVideoMixerAttribute attrs[2] = {
-        VDP_VIDEO_MIXER_ATTRIBUTE_SHARPNESS_LEVEL,
-    };
-    const void *values[2] = {
-        &f->sharpen,
-    };
-    unsigned count = 1;
+    VdpVideoMixerAttribute attrs[2];
+    const void *values[2];
+    unsigned count = 0;
     VdpCSCMatrix csc;
 
+    if (sharpen_enable && f->sharpen != sys->sharpen)
+    {
+        attrs[count] = VDP_VIDEO_MIXER_ATTRIBUTE_SHARPNESS_LEVEL;
+        values[count] = &f->sharpen;
+        count++;
+        sys->sharpen = f->sharpen;
+    }
+
     if ((sys->procamp.brightness != f->procamp.brightness
       || sys->procamp.contrast != f->procamp.contrast
       || sys->procamp.saturation != f->procamp.saturation
@@ -556,11 +577,14 @@ static picture_t *Render(filter_t *filter, picture_t *src, bool import)
         count++;
     }
 
-    err = vdp_video_mixer_set_attribute_values(sys->vdp, sys->mixer,
-                                               count, attrs, values);
-    if (err != VDP_STATUS_OK)
-        msg_Err(filter, "video %s %s failure: %s", "mixer", "attributes",
-                vdp_get_error_string(sys->vdp, err));
+    if (count > 0)
+    {
+        err = vdp_video_mixer_set_attribute_values(sys->vdp, sys->mixer,
+                                                   count, attrs, values);
+        if (err != VDP_STATUS_OK)
+            msg_Err(filter, "video %s %s failure: %s", "mixer", "attributes",
+                    vdp_get_error_string(sys->vdp, err));
+    }
 
     /* Check video orientation, allocate intermediate surface if needed */
     bool swap = false;
@@ -667,6 +691,7 @@ static picture_t *Render(filter_t *filter, picture_t *src, bool import)
                 vdp_get_error_string(sys->vdp, err));
         goto error;
     }
+    sys->rendered++;
 
     if (swap)
     {
@@ -691,6 +716,7 @@ skip:
 
     return dst;
 error:
+    sys->failed++;
     picture_Release(dst);
     dst = NULL;
     goto skip;
@@ -785,6 +811,12 @@ static int OutputOpen(vlc_object_t *obj)
     sys->procamp.saturation = 1.f;
     sys->procamp.hue = 0.f;
 
+    /* MixerCreate() leaves the sharpness feature enabled at level zero */
+    sys->sharpen_enabled = true;
+    sys->sharpen = 0.f;
+    sys->rendered = 0;
+    sys->failed = 0;
+
     filter->pf_video_filter = video_filter;
     filter->pf_flush = Flush;
     return VLC_SUCCESS;
@@ -798,6 +830,9 @@ static void OutputClose(vlc_object_t *obj)
     filter_t *filter = (filter_t *)obj;
     filter_sys_t *sys = filter->p_sys;
 
+    if (sys->rendered > 0 || sys->failed > 0)
+        msg_Dbg(filter, "mixer rendered %u pictures, %u failures",
+                sys->rendered, sys->failed);
     Flush(filter);
     vdp_video_mixer_destroy(sys->vdp, sys->mixer);
     vdp_release_x11(sys->vdp);
@@ -68,7 +68,7 @@ static void AndroidPrintMsg(void *opaque, int type, const vlc_log_t *p_item,
     free(format2);
 }
 
-static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
+static vlc_log_cb Open(vlc_object_t *obj, void **sysp, int *max_type)
 {
     int verbosity = var_InheritInteger(obj, "verbose");
 
@@ -77,6 +77,7 @@ static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
 
     verbosity += VLC_MSG_ERR;
     *sysp = (void *)(uintptr_t)verbosity;
+    *max_type = verbosity; /* let the core drop messages early */
 
     return AndroidPrintMsg;
 }
@@ -118,7 +118,7 @@ static void LogConsoleGray(void *opaque, int type, const vlc_log_t *meta,
     funlockfile(stream);
 }
 
-static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
+static vlc_log_cb Open(vlc_object_t *obj, void **sysp, int *max_type)
 {
     int verbosity = -1;
 
@@ -136,6 +136,7 @@ static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
 
     verbosity += VLC_MSG_ERR;
     *sysp = (void *)(uintptr_t)verbosity;
+    *max_type = verbosity; /* let the core drop messages early */
 
 #if defined (HAVE_ISATTY) && !defined (_WIN32)
     if (isatty(STDERR_FILENO) && var_InheritBool(obj, "color"))
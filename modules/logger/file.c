@@ -105,7 +105,7 @@ static void LogHtml(void *opaque, int type, const vlc_log_t *meta,
     funlockfile(stream);
 }
 
-static vlc_log_cb Open(vlc_object_t *obj, void **restrict sysp)
+static vlc_log_cb Open(vlc_object_t *obj, void **restrict sysp, int *max_type)
 {
     if (!var_InheritBool(obj, "file-logging"))
         return NULL;
@@ -177,6 +177,7 @@ static vlc_log_cb Open(vlc_object_t *obj, void **restrict sysp)
     fputs(header, sys->stream);
 
     *sysp = sys;
+    *max_type = verbosity; /* let the core drop messages early */
     return cb;
 }
 
@@ -64,12 +64,12 @@ static void Log(void *opaque, int type, const vlc_log_t *meta,
     (void) opaque;
 }
 
-static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
+static vlc_log_cb Open(vlc_object_t *obj, void **sysp, int *max_type)
 {
     if (!var_InheritBool(obj, "syslog"))
         return NULL;
 
-    (void) sysp;
+    (void) sysp; (void) max_type; /* the journal filters by itself */
     return Log;
 }
 
@@ -101,7 +101,7 @@ static int var_InheritFacility(vlc_object_t *obj, const char *varname)
 
 static const char default_ident[] = PACKAGE;
 
-static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
+static vlc_log_cb Open(vlc_object_t *obj, void **sysp, int *max_type)
 {
     if (!var_InheritBool(obj, "syslog"))
         return NULL;
@@ -120,6 +120,8 @@ static vlc_log_cb Open(vlc_object_t *obj, void **sysp)
     int mask = LOG_MASK(LOG_ERR) | LOG_MASK(LOG_WARNING) | LOG_MASK(LOG_INFO);
     if (var_InheritBool(obj, "syslog-debug"))
         mask |= LOG_MASK(LOG_DEBUG);
+    else
+        *max_type = VLC_MSG_WARN; /* let the core drop debug early */
 
     setlogmask(mask);
 
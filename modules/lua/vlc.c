@@ -40,6 +40,7 @@
 #include <vlc_arrays.h>
 #include <vlc_charset.h>
 #include <vlc_fs.h>
+#include <vlc_memstream.h>
 #include <vlc_services_discovery.h>
 #include <vlc_stream.h>
 
@@ -674,17 +675,133 @@ int vlclua_add_modules_path( lua_State *L, const char *psz_filename )
     return 0;
 }
 
+/*****************************************************************************
+ * Compiled chunk cache
+ *****************************************************************************/
+/* Probing a single input runs every playlist script, each in a fresh
+ * lua_State, so the same sources used to be re-read and re-compiled over
+ * and over. Cache the compiled chunks, keyed on path and modification
+ * time: subsequent states merely reload the dumped bytecode, which skips
+ * the parser entirely. */
+typedef struct vlclua_chunk
+{
+    struct vlclua_chunk *p_next;
+    char *psz_path;
+    time_t mtime;
+    void *p_data;
+    size_t i_size;
+} vlclua_chunk_t;
+
+static struct
+{
+    vlc_mutex_t lock;
+    vlclua_chunk_t *p_list;
+} chunk_cache = { .lock = VLC_STATIC_MUTEX };
+
+static vlclua_chunk_t *vlclua_chunk_find( const char *psz_path )
+{
+    vlclua_chunk_t *p_chunk;
+
+    for( p_chunk = chunk_cache.p_list; p_chunk != NULL;
+         p_chunk = p_chunk->p_next )
+        if( !strcmp( p_chunk->psz_path, psz_path ) )
+            break;
+    return p_chunk;
+}
+
+static int vlclua_chunk_dump( lua_State *L, const void *p_buf, size_t i_len,
+                              void *p_ud )
+{
+    struct vlc_memstream *ms = p_ud;
+    (void) L;
+    return vlc_memstream_write( ms, p_buf, i_len ) != i_len;
+}
+
+static int vlclua_loadfile_cached( lua_State *L, const char *psz_path )
+{
+    struct stat st;
+
+    if( vlc_stat( psz_path, &st ) )
+        return luaL_loadfile( L, psz_path );
+
+    vlc_mutex_lock( &chunk_cache.lock );
+    vlclua_chunk_t *p_chunk = vlclua_chunk_find( psz_path );
+    if( p_chunk != NULL && p_chunk->mtime == st.st_mtime )
+    {
+        int ret = luaL_loadbuffer( L, p_chunk->p_data, p_chunk->i_size,
+                                   psz_path );
+        vlc_mutex_unlock( &chunk_cache.lock );
+        return ret;
+    }
+    vlc_mutex_unlock( &chunk_cache.lock );
+
+    int ret = luaL_loadfile( L, psz_path );
+    if( ret )
+        return ret;
+
+    /* Dump the freshly compiled chunk and (re)insert it in the cache.
+     * Failing to cache is not an error: the chunk is loaded anyway. */
+    struct vlc_memstream ms;
+    vlc_memstream_open( &ms );
+#if LUA_VERSION_NUM >= 503
+    int err = lua_dump( L, vlclua_chunk_dump, &ms, 0 );
+#else
+    int err = lua_dump( L, vlclua_chunk_dump, &ms );
+#endif
+    if( vlc_memstream_close( &ms ) )
+        return 0;
+    if( err )
+    {
+        free( ms.ptr );
+        return 0;
+    }
+
+    vlc_mutex_lock( &chunk_cache.lock );
+    p_chunk = vlclua_chunk_find( psz_path );
+    if( p_chunk == NULL )
+    {
+        p_chunk = malloc( sizeof( *p_chunk ) );
+        char *psz_dup = ( p_chunk != NULL ) ? strdup( psz_path ) : NULL;
+        if( psz_dup == NULL )
+        {
+            vlc_mutex_unlock( &chunk_cache.lock );
+            free( p_chunk );
+            free( ms.ptr );
+            return 0;
+        }
+        p_chunk->psz_path = psz_dup;
+        p_chunk->p_next = chunk_cache.p_list;
+        chunk_cache.p_list = p_chunk;
+    }
+    else
+        free( p_chunk->p_data );
+
+    p_chunk->mtime = st.st_mtime;
+    p_chunk->p_data = ms.ptr;
+    p_chunk->i_size = ms.length;
+    vlc_mutex_unlock( &chunk_cache.lock );
+    return 0;
+}
+
+static int vlclua_dofile_cached( lua_State *L, const char *psz_path )
+{
+    int ret = vlclua_loadfile_cached( L, psz_path );
+    if( ret )
+        return ret;
+    return lua_pcall( L, 0, LUA_MULTRET, 0 );
+}
+
 /** Replacement for luaL_dofile, using VLC's input capabilities */
 int vlclua_dofile( vlc_object_t *p_this, lua_State *L, const char *curi )
 {
     char *uri = ToLocaleDup( curi );
     if( !strstr( uri, "://" ) ) {
-        int ret = luaL_dofile( L, uri );
+        int ret = vlclua_dofile_cached( L, uri );
         free( uri );
         return ret;
     }
     if( !strncasecmp( uri, "file://", 7 ) ) {
-        int ret = luaL_dofile( L, uri + 7 );
+        int ret = vlclua_dofile_cached( L, uri + 7 );
         free( uri );
         return ret;
     }
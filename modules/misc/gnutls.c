@@ -392,13 +392,40 @@ done:
     return 0;
 }
 
+#define GNUTLS_SESSION_CACHE_SIZE 8
+
+/* Per-host serialized session parameters for resumption. The cache is
+ * process-wide rather than per-credentials: every input (and the HTTP
+ * connection manager of each playlist item) loads its own "tls client"
+ * credentials, so a per-credentials cache would never get a hit across
+ * inputs hammering the same origin. */
+static struct
+{
+    vlc_mutex_t lock;
+    unsigned next; /*< Round-robin eviction cursor */
+    struct gnutls_cached_session
+    {
+        char *host;
+        gnutls_datum_t data;
+    } entry[GNUTLS_SESSION_CACHE_SIZE];
+} gnutls_session_cache = { VLC_STATIC_MUTEX, 0, { { NULL, { NULL, 0 } } } };
+
+/**
+ * Client-side TLS credentials private data
+ */
+typedef struct vlc_tls_client_sys
+{
+    gnutls_certificate_credentials_t x509;
+} vlc_tls_client_sys_t;
+
 static vlc_tls_t *gnutls_ClientSessionOpen(vlc_tls_creds_t *crd,
                                            vlc_tls_t *sk, const char *hostname,
                                            const char *const *alpn)
 {
+    vlc_tls_client_sys_t *sys = crd->sys;
     vlc_tls_gnutls_t *priv;
 
-    priv = gnutls_SessionOpen(crd, GNUTLS_CLIENT, crd->sys, sk, alpn);
+    priv = gnutls_SessionOpen(crd, GNUTLS_CLIENT, sys->x509, sk, alpn);
     if (priv == NULL)
         return NULL;
 
@@ -408,16 +435,86 @@ static vlc_tls_t *gnutls_ClientSessionOpen(vlc_tls_creds_t *crd,
     gnutls_dh_set_prime_bits (session, 1024);
 
     if (likely(hostname != NULL))
+    {
         /* fill Server Name Indication */
         gnutls_server_name_set (session, GNUTLS_NAME_DNS,
                                 hostname, strlen (hostname));
 
+        /* resume an earlier session to skip a handshake round-trip */
+        vlc_mutex_lock(&gnutls_session_cache.lock);
+        for (unsigned i = 0; i < GNUTLS_SESSION_CACHE_SIZE; i++)
+        {
+            struct gnutls_cached_session *e = &gnutls_session_cache.entry[i];
+
+            if (e->host != NULL && !strcasecmp(e->host, hostname))
+            {
+                gnutls_session_set_data(session, e->data.data, e->data.size);
+                break;
+            }
+        }
+        vlc_mutex_unlock(&gnutls_session_cache.lock);
+    }
+
     return &priv->tls;
 }
 
-static int gnutls_ClientHandshake(vlc_tls_creds_t *creds, vlc_tls_t *tls,
-                                  const char *host, const char *service,
-                                  char **restrict alp)
+/**
+ * Saves the session parameters for later resumption with the same host.
+ */
+static void gnutls_ClientSessionStore(vlc_tls_creds_t *crd,
+                                      gnutls_session_t session,
+                                      const char *host)
+{
+    gnutls_datum_t data;
+
+    if (host == NULL)
+        return;
+
+    if (gnutls_session_is_resumed(session))
+        msg_Dbg(crd, "TLS session resumed with %s", host);
+
+    /* Tickets may be single-use (TLS 1.3): always store the freshest data. */
+    if (gnutls_session_get_data2(session, &data))
+        return;
+    if (data.size == 0)
+    {
+        gnutls_free(data.data);
+        return;
+    }
+
+    vlc_mutex_lock(&gnutls_session_cache.lock);
+
+    unsigned i;
+    for (i = 0; i < GNUTLS_SESSION_CACHE_SIZE; i++)
+        if (gnutls_session_cache.entry[i].host != NULL
+         && !strcasecmp(gnutls_session_cache.entry[i].host, host))
+            break;
+
+    if (i == GNUTLS_SESSION_CACHE_SIZE)
+    {   /* No entry for this host yet: evict the oldest one */
+        char *dup = strdup(host);
+        if (unlikely(dup == NULL))
+        {
+            vlc_mutex_unlock(&gnutls_session_cache.lock);
+            gnutls_free(data.data);
+            return;
+        }
+
+        i = gnutls_session_cache.next;
+        gnutls_session_cache.next = (gnutls_session_cache.next + 1)
+                                  % GNUTLS_SESSION_CACHE_SIZE;
+        free(gnutls_session_cache.entry[i].host);
+        gnutls_session_cache.entry[i].host = dup;
+    }
+
+    gnutls_free(gnutls_session_cache.entry[i].data.data);
+    gnutls_session_cache.entry[i].data = data;
+    vlc_mutex_unlock(&gnutls_session_cache.lock);
+}
+
+static int gnutls_ClientCertHandshake(vlc_tls_creds_t *creds, vlc_tls_t *tls,
+                                      const char *host, const char *service,
+                                      char **restrict alp)
 {
     vlc_tls_gnutls_t *priv = (vlc_tls_gnutls_t *)tls;
 
@@ -425,8 +522,13 @@ static int gnutls_ClientHandshake(vlc_tls_creds_t *creds, vlc_tls_t *tls,
     if (val)
         return val;
 
-    /* certificates chain verification */
     gnutls_session_t session = priv->session;
+
+    if (gnutls_session_is_resumed(session))
+        /* Certificates were verified when the session was first established */
+        return 0;
+
+    /* certificates chain verification */
     unsigned status;
 
     val = gnutls_certificate_verify_peers3 (session, host, &status);
@@ -548,6 +650,18 @@ error:
     return -1;
 }
 
+static int gnutls_ClientHandshake(vlc_tls_creds_t *creds, vlc_tls_t *tls,
+                                  const char *host, const char *service,
+                                  char **restrict alp)
+{
+    vlc_tls_gnutls_t *priv = (vlc_tls_gnutls_t *)tls;
+    int val = gnutls_ClientCertHandshake(creds, tls, host, service, alp);
+
+    if (val == 0)
+        gnutls_ClientSessionStore(creds, priv->session, host);
+    return val;
+}
+
 /**
  * Initializes a client-side TLS credentials.
  */
@@ -558,11 +672,16 @@ static int OpenClient (vlc_tls_creds_t *crd)
     if (gnutls_Init (VLC_OBJECT(crd)))
         return VLC_EGENERIC;
 
+    vlc_tls_client_sys_t *sys = calloc(1, sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
     int val = gnutls_certificate_allocate_credentials (&x509);
     if (val != 0)
     {
         msg_Err (crd, "cannot allocate credentials: %s",
                  gnutls_strerror (val));
+        free (sys);
         return VLC_EGENERIC;
     }
 
@@ -592,7 +711,9 @@ static int OpenClient (vlc_tls_creds_t *crd)
     gnutls_certificate_set_verify_flags (x509,
                                          GNUTLS_VERIFY_ALLOW_X509_V1_CA_CRT);
 
-    crd->sys = x509;
+    sys->x509 = x509;
+
+    crd->sys = sys;
     crd->open = gnutls_ClientSessionOpen;
     crd->handshake = gnutls_ClientHandshake;
 
@@ -601,9 +722,10 @@ static int OpenClient (vlc_tls_creds_t *crd)
 
 static void CloseClient (vlc_tls_creds_t *crd)
 {
-    gnutls_certificate_credentials_t x509 = crd->sys;
+    vlc_tls_client_sys_t *sys = crd->sys;
 
-    gnutls_certificate_free_credentials (x509);
+    gnutls_certificate_free_credentials (sys->x509);
+    free (sys);
 }
 
 #ifdef ENABLE_SOUT
@@ -64,13 +64,16 @@ void mp4mux_trackinfo_Clear(mp4mux_trackinfo_t *p_stream)
 }
 
 
-bo_t *box_new(const char *fcc)
+bo_t *box_new_sized(const char *fcc, size_t i_capacity)
 {
     bo_t *box = malloc(sizeof(*box));
     if (!box)
         return NULL;
 
-    if(!bo_init(box, 1024))
+    if(i_capacity < 1024)
+        i_capacity = 1024;
+
+    if(!bo_init(box, i_capacity))
     {
         bo_free(box);
         return NULL;
@@ -82,6 +85,11 @@ bo_t *box_new(const char *fcc)
     return box;
 }
 
+bo_t *box_new(const char *fcc)
+{
+    return box_new_sized(fcc, 1024);
+}
+
 bo_t *box_full_new(const char *fcc, uint8_t v, uint32_t f)
 {
     bo_t *box = box_new(fcc);
@@ -78,6 +78,7 @@ bool mp4mux_trackinfo_Init( mp4mux_trackinfo_t *, unsigned, uint32_t );
 void mp4mux_trackinfo_Clear( mp4mux_trackinfo_t * );
 
 bo_t *box_new     (const char *fcc);
+bo_t *box_new_sized(const char *fcc, size_t i_capacity);
 bo_t *box_full_new(const char *fcc, uint8_t v, uint32_t f);
 void  box_fix     (bo_t *box, uint32_t);
 void  box_gather  (bo_t *box, bo_t *box2);
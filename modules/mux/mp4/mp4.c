@@ -148,6 +148,7 @@ typedef struct
     mp4_fragindex_t *p_indexentries;
     uint32_t         i_indexentriesmax;
     uint32_t         i_indexentries;
+    vlc_tick_t       i_indexinterval;
 } mp4_stream_t;
 
 typedef struct
@@ -173,6 +174,7 @@ typedef struct
     bool           b_fragmented;
     vlc_tick_t     i_written_duration;
     uint32_t       i_mfhd_sequence;
+    size_t         i_moof_size_hint;
 } sout_mux_sys_t;
 
 static void box_send(sout_mux_t *p_mux,  bo_t *box);
@@ -255,6 +257,7 @@ static int Open(vlc_object_t *p_this)
     p_sys->i_written_duration= 0;
     p_sys->i_start_dts = VLC_TICK_INVALID;
     p_sys->i_mfhd_sequence = 1;
+    p_sys->i_moof_size_hint = 0;
 
     p_mux->p_sys        = p_sys;
     p_mux->pf_control   = Control;
@@ -477,6 +480,7 @@ static int AddStream(sout_mux_t *p_mux, sout_input_t *p_input)
     p_stream->p_indexentries     = NULL;
     p_stream->i_indexentriesmax  = 0;
     p_stream->i_indexentries     = 0;
+    p_stream->i_indexinterval    = VLC_TICK_FROM_SEC(2);
 
     p_input->p_sys          = p_stream;
 
@@ -871,11 +875,25 @@ static void box_send(sout_mux_t *p_mux,  bo_t *box)
         entry->p_next = NULL;\
     } while(0)
 
+/* Maximum mfra/traf index entries kept per track, so that index memory and
+ * the closing mfra stay bounded on arbitrary long recordings */
+#define MP4_FRAG_INDEX_MAX 4096
+
 /* Creates mfra/traf index entries */
 static void AddKeyframeEntry(mp4_stream_t *p_stream, const uint64_t i_moof_pos,
                              const uint8_t i_traf, const uint32_t i_sample,
                              const vlc_tick_t i_time)
 {
+    if (p_stream->i_indexentries >= MP4_FRAG_INDEX_MAX)
+    {
+        /* Thin out: drop every other entry and space further ones
+         * twice as far apart */
+        for (uint32_t i = 1; i * 2 < p_stream->i_indexentries; i++)
+            p_stream->p_indexentries[i] = p_stream->p_indexentries[i * 2];
+        p_stream->i_indexentries = (p_stream->i_indexentries + 1) / 2;
+        p_stream->i_indexinterval *= 2;
+    }
+
     /* alloc or realloc */
     mp4_fragindex_t *p_entries = p_stream->p_indexentries;
     if (p_stream->i_indexentries >= p_stream->i_indexentriesmax)
@@ -893,7 +911,7 @@ static void AddKeyframeEntry(mp4_stream_t *p_stream, const uint64_t i_moof_pos,
     else
         i_last_entry_time = 0;
 
-    if (p_entries && i_time - i_last_entry_time >= VLC_TICK_FROM_SEC(2))
+    if (p_entries && i_time - i_last_entry_time >= p_stream->i_indexinterval)
     {
         mp4_fragindex_t *p_indexentry = &p_stream->p_indexentries[p_stream->i_indexentries];
         p_indexentry->i_time = i_time;
@@ -920,7 +938,10 @@ static bo_t *GetMoofBox(sout_mux_t *p_mux, size_t *pi_mdat_total_size,
 
     *pi_mdat_total_size = 0;
 
-    moof = box_new("moof");
+    /* Preallocate to the previous fragment's moof size: successive
+     * fragments have near identical layout, so this avoids growing the
+     * buffer sample by sample on every fragment. */
+    moof = box_new_sized("moof", p_sys->i_moof_size_hint);
     if(!moof)
         return NULL;
 
@@ -1112,6 +1133,7 @@ static bo_t *GetMoofBox(sout_mux_t *p_mux, size_t *pi_mdat_total_size,
     }
 
     box_fix(moof, bo_size(moof));
+    p_sys->i_moof_size_hint = bo_size(moof);
 
     /* do tfhd base data offset fixup */
     if (i_fixupoffset)
@@ -1788,6 +1788,9 @@ static void TSDate( sout_mux_t *p_mux, sout_buffer_chain_t *p_chain_ts,
     }
 
     /* msg_Dbg( p_mux, "real pck=%d", i_packet_count ); */
+    block_t *p_out = NULL;
+    block_t **pp_out_last = &p_out;
+
     for (int i = 0; i < i_packet_count; i++ )
     {
         block_t *p_ts = BufferChainGet( p_chain_ts );
@@ -1811,8 +1814,14 @@ static void TSDate( sout_mux_t *p_mux, sout_buffer_chain_t *p_chain_ts,
         /* latency */
         p_ts->i_dts += p_sys->i_shaping_delay * 3 / 2;
 
-        sout_AccessOutWrite( p_mux->p_access, p_ts );
+        *pp_out_last = p_ts;
+        pp_out_last = &p_ts->p_next;
     }
+
+    /* Hand the whole dated burst to the access output at once: they all
+     * iterate block chains, and this saves one call per 188 bytes. */
+    if( p_out )
+        sout_AccessOutWrite( p_mux->p_access, p_out );
 }
 
 static block_t *TSNew( sout_mux_t *p_mux, sout_input_sys_t *p_stream,
@@ -75,10 +75,7 @@ void PEStoTS( void *p_opaque, PEStoTSCallback pf_callback, block_t *p_pes,
                     p_ts->p_buffer[5] |= 0x80;
                     *pb_discontinuity = false;
                 }
-                for (int i = 6; i < 6 + i_stuffing - 2; i++ )
-                {
-                    p_ts->p_buffer[i] = 0xff;
-                }
+                memset( &p_ts->p_buffer[6], 0xff, i_stuffing - 2 );
             }
         }
         /* copy payload */
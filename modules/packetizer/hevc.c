@@ -51,12 +51,20 @@
 static int  Open (vlc_object_t *);
 static void Close(vlc_object_t *);
 
+#define SKIP_METADATA_TEXT N_("Only parse access unit boundaries")
+#define SKIP_METADATA_LONGTEXT N_("Skip SEI and slice header parsing and " \
+    "only detect access unit boundaries and keyframes. Intended for " \
+    "stream copy, where the NALs are passed through unmodified anyway.")
+
 vlc_module_begin ()
     set_category(CAT_SOUT)
     set_subcategory(SUBCAT_SOUT_PACKETIZER)
     set_description(N_("HEVC/H.265 video packetizer"))
     set_capability("packetizer", 50)
     set_callbacks(Open, Close)
+
+    add_bool( "packetizer-hevc-skip-metadata", false, SKIP_METADATA_TEXT,
+              SKIP_METADATA_LONGTEXT, true )
 vlc_module_end ()
 
 
@@ -99,6 +107,7 @@ typedef struct
     const hevc_picture_parameter_set_t  *p_active_pps;
     hevc_sei_pic_timing_t *p_timing;
     bool b_init_sequence_complete;
+    bool b_au_only;
 
     date_t dts;
     vlc_tick_t pts;
@@ -207,6 +216,10 @@ static int Open(vlc_object_t *p_this)
     p_sys->pts = VLC_TICK_INVALID;
     p_sys->b_need_ts = true;
 
+    p_sys->b_au_only = var_CreateGetBool( p_dec, "packetizer-hevc-skip-metadata" );
+    if( p_sys->b_au_only )
+        msg_Dbg( p_dec, "only parsing access unit boundaries" );
+
     /* Set callbacks */
     const uint8_t *p_extra = p_dec->fmt_in.p_extra;
     const size_t i_extra = p_dec->fmt_in.i_extra;
@@ -284,6 +297,8 @@ static void Close(vlc_object_t *p_this)
 
     cc_storage_delete( p_sys->p_ccs );
 
+    var_Destroy( p_dec, "packetizer-hevc-skip-metadata" );
+
     free(p_sys);
 }
 
@@ -651,8 +666,13 @@ static block_t *ParseVCL(decoder_t *p_dec, uint8_t i_nal_type, block_t *p_frag)
             p_outputchain = OutputQueues(p_sys, p_sys->b_init_sequence_complete);
         }
 
-        hevc_slice_segment_header_t *p_sli = hevc_decode_slice_header(p_buffer, i_buffer, true,
-                                                                      GetXPSSet, p_sys);
+        /* In access unit only mode the slice header is still decoded until
+         * the active sets are known, so the output format gets filled in,
+         * then skipped for the rest of the stream */
+        hevc_slice_segment_header_t *p_sli = NULL;
+        if(!p_sys->b_au_only || !p_sys->b_init_sequence_complete)
+            p_sli = hevc_decode_slice_header(p_buffer, i_buffer, true,
+                                             GetXPSSet, p_sys);
         if(p_sli && i_layer == 0)
         {
             hevc_sequence_parameter_set_t *p_sps;
@@ -662,7 +682,8 @@ static block_t *ParseVCL(decoder_t *p_dec, uint8_t i_nal_type, block_t *p_frag)
             ActivateSets(p_dec, p_pps, p_sps, p_vps);
         }
 
-        ParseStoredSEI( p_dec );
+        if(!p_sys->b_au_only)
+            ParseStoredSEI( p_dec );
 
         switch(i_nal_type)
         {
@@ -767,8 +788,9 @@ static block_t * ParseAUTail(decoder_t *p_dec, uint8_t i_nal_type, block_t *p_na
             break;
 
         case HEVC_NAL_SUFF_SEI:
-            HxxxParse_AnnexB_SEI( p_nalb->p_buffer, p_nalb->i_buffer,
-                                  2 /* nal header */, ParseSEICallback, p_dec );
+            if(!p_sys->b_au_only)
+                HxxxParse_AnnexB_SEI( p_nalb->p_buffer, p_nalb->i_buffer,
+                                      2 /* nal header */, ParseSEICallback, p_dec );
             break;
     }
 
@@ -180,15 +180,78 @@ static inline block_t *packetizer_Packetize( packetizer_t *p_pack, block_t **pp_
 
             /* Get the new fragment and set the pts/dts */
             block_t *p_block_bytestream = p_pack->bytestream.p_block;
+            bool b_pic_detached = false;
+
+            /* Zero copy: when the fragment is the tail of the head block and
+             * the bytes to prepend are already in place right before it (a
+             * long startcode when syncing on its last bytes), the block can
+             * be handed through with adjusted bounds instead of copied. This
+             * is the common case when the demuxer emits one NAL per block.
+             * The fragment may reach past the head block by zero bytes only,
+             * i.e. trailing_zero_8bits or the next long startcode prefix;
+             * those are left in the stream and skipped by the next sync.
+             * Only allowed with a prepend, as the AnnexB H26x users are the
+             * ones prepending and their parsers discard trailing zeroes. */
+            const size_t i_head_offset = p_pack->bytestream.i_block_offset;
+            if( i_head_offset + p_pack->i_offset >= p_block_bytestream->i_buffer &&
+                i_head_offset >= (size_t)p_pack->i_au_prepend &&
+                ( p_pack->i_au_prepend <= 0 ||
+                  !memcmp( &p_block_bytestream->p_buffer[i_head_offset
+                                                         - p_pack->i_au_prepend],
+                           p_pack->p_au_prepend, p_pack->i_au_prepend ) ) )
+            {
+                size_t i_spill = i_head_offset + p_pack->i_offset
+                               - p_block_bytestream->i_buffer;
+                bool b_spill_zero = ( i_spill == 0 )
+                                 || ( p_pack->i_au_prepend > 0 );
+                for( const block_t *b = p_block_bytestream->p_next;
+                     b != NULL && b_spill_zero && i_spill != 0; b = b->p_next )
+                {
+                    size_t i_check = __MIN( i_spill, b->i_buffer );
+                    for( size_t i = 0; i < i_check; i++ )
+                    {
+                        if( b->p_buffer[i] != 0 )
+                        {
+                            b_spill_zero = false;
+                            break;
+                        }
+                    }
+                    i_spill -= i_check;
+                }
+                if( i_spill != 0 ) /* chain exhausted before the spill end */
+                    b_spill_zero = false;
 
-            p_pic = block_Alloc( p_pack->i_offset + p_pack->i_au_prepend );
-            p_pic->i_pts = p_block_bytestream->i_pts;
-            p_pic->i_dts = p_block_bytestream->i_dts;
+                if( b_spill_zero )
+                {
+                    const size_t i_trim = i_head_offset - p_pack->i_au_prepend;
+
+                    p_pack->bytestream.p_chain = p_pack->bytestream.p_block =
+                            p_block_bytestream->p_next;
+                    if( p_pack->bytestream.p_chain == NULL )
+                        p_pack->bytestream.pp_last = &p_pack->bytestream.p_chain;
+                    p_pack->bytestream.i_total -= p_block_bytestream->i_buffer;
+                    p_pack->bytestream.i_block_offset = 0;
+
+                    p_pic = p_block_bytestream;
+                    p_pic->p_next = NULL;
+                    p_pic->p_buffer += i_trim;
+                    p_pic->i_buffer -= i_trim;
+                    p_pic->i_flags = 0; /* as block_Alloc would return */
+                    b_pic_detached = true;
+                }
+            }
 
-            block_GetBytes( &p_pack->bytestream, &p_pic->p_buffer[p_pack->i_au_prepend],
-                            p_pic->i_buffer - p_pack->i_au_prepend );
-            if( p_pack->i_au_prepend > 0 )
-                memcpy( p_pic->p_buffer, p_pack->p_au_prepend, p_pack->i_au_prepend );
+            if( !b_pic_detached )
+            {
+                p_pic = block_Alloc( p_pack->i_offset + p_pack->i_au_prepend );
+                p_pic->i_pts = p_block_bytestream->i_pts;
+                p_pic->i_dts = p_block_bytestream->i_dts;
+
+                block_GetBytes( &p_pack->bytestream, &p_pic->p_buffer[p_pack->i_au_prepend],
+                                p_pic->i_buffer - p_pack->i_au_prepend );
+                if( p_pack->i_au_prepend > 0 )
+                    memcpy( p_pic->p_buffer, p_pack->p_au_prepend, p_pack->i_au_prepend );
+            }
 
             p_pack->i_offset = 0;
 
@@ -201,7 +264,10 @@ static inline block_t *packetizer_Packetize( packetizer_t *p_pack, block_t **pp_
             else
             {
                 p_pic = p_pack->pf_parse( p_pack->p_private, &b_used_ts, p_pic );
-                if( b_used_ts )
+                /* A detached fragment left the bytestream along with its
+                 * timestamps, so there is nothing to invalidate (and the
+                 * block may already be released) */
+                if( b_used_ts && !b_pic_detached )
                 {
                     p_block_bytestream->i_dts = VLC_TICK_INVALID;
                     p_block_bytestream->i_pts = VLC_TICK_INVALID;
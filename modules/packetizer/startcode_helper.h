@@ -25,6 +25,12 @@
 #if !defined(CAN_COMPILE_SSE2) && defined(HAVE_SSE2_INTRINSICS)
    #include <emmintrin.h>
 #endif
+#ifdef HAVE_AVX2_INTRINSICS
+   #include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+   #include <arm_neon.h>
+#endif
 
 /* Looks up efficiently for an AnnexB startcode 0x00 0x00 0x01
  * by using a 4 times faster trick than single byte lookup. */
@@ -109,6 +115,112 @@ static inline const uint8_t * startcode_FindAnnexB_SSE2( const uint8_t *p, const
 
 #endif
 
+#ifdef HAVE_AVX2_INTRINSICS
+
+__attribute__ ((__target__ ("avx2")))
+static inline const uint8_t * startcode_FindAnnexB_AVX2( const uint8_t *p, const uint8_t *end )
+{
+    /* First align to 32 */
+    const uint8_t *alignedend = p + 32 - ((intptr_t)p & 31);
+    for (end -= 3; p < alignedend && p <= end; p++) {
+        if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+            return p;
+    }
+
+    if( p == end )
+        return NULL;
+
+    alignedend = end - ((intptr_t) end & 31);
+    if( alignedend > p )
+    {
+        const __m256i zeros = _mm256_setzero_si256();
+
+        /* Scan 64 bytes at once; the two zero-byte masks are merged so a
+         * block without any zero costs a single branch */
+        for( ; p + 64 <= alignedend; p += 64 )
+        {
+            __m256i v0 = _mm256_load_si256((__m256i*)p);
+            __m256i v1 = _mm256_load_si256((__m256i*)(p + 32));
+            uint32_t match0 = _mm256_movemask_epi8( _mm256_cmpeq_epi8( zeros, v0 ) );
+            uint32_t match1 = _mm256_movemask_epi8( _mm256_cmpeq_epi8( zeros, v1 ) );
+            uint64_t match = (uint64_t)match0 | ((uint64_t)match1 << 32);
+            if( match == 0 )
+                continue;
+            for( unsigned a = 0; a < 64; a += 4 )
+                if( match & (UINT64_C(0xF) << a) )
+                    TRY_MATCH(p, a);
+        }
+
+        if( p + 32 <= alignedend )
+        {
+            __m256i v = _mm256_load_si256((__m256i*)p);
+            uint32_t match = _mm256_movemask_epi8( _mm256_cmpeq_epi8( zeros, v ) );
+            if( match )
+                for( unsigned a = 0; a < 32; a += 4 )
+                    if( match & (UINT32_C(0xF) << a) )
+                        TRY_MATCH(p, a);
+            p += 32;
+        }
+    }
+
+    for (; p <= end; p++) {
+        if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+            return p;
+    }
+
+    return NULL;
+}
+
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+static inline const uint8_t * startcode_FindAnnexB_NEON( const uint8_t *p, const uint8_t *end )
+{
+    /* First align to 16 */
+    const uint8_t *alignedend = p + 16 - ((intptr_t)p & 15);
+    for (end -= 3; p < alignedend && p <= end; p++) {
+        if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+            return p;
+    }
+
+    if( p == end )
+        return NULL;
+
+    alignedend = end - ((intptr_t) end & 15);
+    if( alignedend > p )
+    {
+        const uint8x16_t zeros = vdupq_n_u8( 0 );
+        for( ; p < alignedend; p += 16 )
+        {
+            uint8x16_t eq = vceqq_u8( vld1q_u8( p ), zeros );
+            /* NEON has no movemask; narrowing each 16 bit lane by 4 packs
+             * one nibble per input byte, in order, into a 64 bit mask */
+            uint64_t match = vget_lane_u64( vreinterpret_u64_u8(
+                vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 ) ), 0 );
+            if( match == 0 )
+                continue;
+            if( match & UINT64_C(0x000000000000FFFF) )
+                TRY_MATCH(p, 0);
+            if( match & UINT64_C(0x00000000FFFF0000) )
+                TRY_MATCH(p, 4);
+            if( match & UINT64_C(0x0000FFFF00000000) )
+                TRY_MATCH(p, 8);
+            if( match & UINT64_C(0xFFFF000000000000) )
+                TRY_MATCH(p, 12);
+        }
+    }
+
+    for (; p <= end; p++) {
+        if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+            return p;
+    }
+
+    return NULL;
+}
+
+#endif
+
 /* That code is adapted from libav's ff_avc_find_startcode_internal
  * and i believe the trick originated from
  * https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord
@@ -143,11 +255,17 @@ static inline const uint8_t * startcode_FindAnnexB_Bits( const uint8_t *p, const
 #if defined(CAN_COMPILE_SSE2) || defined(HAVE_SSE2_INTRINSICS)
 static inline const uint8_t * startcode_FindAnnexB( const uint8_t *p, const uint8_t *end )
 {
+#ifdef HAVE_AVX2_INTRINSICS
+    if (vlc_CPU_AVX2())
+        return startcode_FindAnnexB_AVX2(p, end);
+#endif
     if (vlc_CPU_SSE2())
         return startcode_FindAnnexB_SSE2(p, end);
     else
         return startcode_FindAnnexB_Bits(p, end);
 }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define startcode_FindAnnexB startcode_FindAnnexB_NEON
 #else
     #define startcode_FindAnnexB startcode_FindAnnexB_Bits
 #endif
@@ -33,7 +33,7 @@
 #include <vlc_plugin.h>
 #include <vlc_stream.h>
 #include <vlc_interrupt.h>
-#include <vlc_block_helper.h>
+#include <vlc_block.h>
 
 /* TODO:
  *  - tune the 2 methods (block/stream)
@@ -42,54 +42,155 @@
  *  - ...
  */
 
-/* 
- * One linked list of data read
+/*
+ * The cache is a contiguous circular buffer. Since its size is a power of
+ * two, the physical position of stream offset o is simply (o & mask): reads
+ * and writes are at most two memcpy() calls, with no per-block list to walk.
  */
 
-/* How many tracks we have, currently only used for stream mode */
+/* Max size of our cache, must be a power of two for the ring */
 #ifdef OPTIMIZE_MEMORY
-    /* Max size of our cache 128KiB per stream */
-#   define STREAM_CACHE_SIZE  (1024*128)
+    /* 128KiB per stream */
+#   define STREAM_CACHE_SIZE  (1 << 17)
 #else
-    /* Max size of our cache 48MiB per stream */
-#   define STREAM_CACHE_SIZE  (4*12*1024*1024)
+    /* 32MiB per stream */
+#   define STREAM_CACHE_SIZE  (1 << 25)
 #endif
 
+/* Initial size of the ring; it doubles on demand up to STREAM_CACHE_SIZE */
+#define STREAM_CACHE_INITIAL_SIZE (1 << 18)
+
 /* How many data we try to prebuffer
  * XXX it should be small to avoid useless latency but big enough for
  * efficient demux probing */
 #define STREAM_CACHE_PREBUFFER_SIZE (128)
 
-/* Method: Simple, for pf_block.
- *  We get blocks and put them in the linked list.
- *  We release blocks once the total size is bigger than STREAM_CACHE_SIZE
- */
-
 typedef struct
 {
-    block_bytestream_t cache; /* bytestream chain for storing cache */
+    uint8_t  *buffer;
+    size_t    size;   /* ring size, always a power of two */
+    size_t    mask;   /* size - 1 */
+    uint64_t  start;  /* stream offset of the oldest cached byte */
+    uint64_t  offset; /* current read offset, start <= offset <= end */
+    uint64_t  end;    /* stream offset past the newest cached byte */
+
+    block_t  *pending; /* upstream data not yet copied into the ring */
 
     struct
     {
         /* Stats for calculating speed */
         uint64_t read_bytes;
         vlc_tick_t read_time;
+        /* Cache occupancy watermarks */
+        size_t low;  /* least data ahead of the reader observed */
+        size_t high; /* most data cached at once */
     } stat;
 } stream_sys_t;
 
-static int AStreamRefillBlock(stream_t *s)
+static void RingWrite(stream_sys_t *sys, uint64_t at,
+                      const uint8_t *src, size_t len)
+{
+    size_t pos = at & sys->mask;
+    size_t part = __MIN(len, sys->size - pos);
+
+    memcpy(sys->buffer + pos, src, part);
+    memcpy(sys->buffer, src + part, len - part);
+}
+
+static void RingRead(const stream_sys_t *sys, uint64_t at,
+                     uint8_t *dst, size_t len)
+{
+    size_t pos = at & sys->mask;
+    size_t part = __MIN(len, sys->size - pos);
+
+    memcpy(dst, sys->buffer + pos, part);
+    memcpy(dst + part, sys->buffer, len - part);
+}
+
+static int RingGrow(stream_sys_t *sys)
+{
+    size_t newsize = 2 * sys->size;
+    size_t newmask = newsize - 1;
+    uint8_t *buffer = malloc(newsize);
+
+    if (buffer == NULL)
+        return -1;
+
+    /* Replace every cached byte according to the new mask */
+    for (uint64_t at = sys->start; at < sys->end;)
+    {
+        size_t spos = at & sys->mask;
+        size_t slen = __MIN(sys->end - at, sys->size - spos);
+        size_t dpos = at & newmask;
+        size_t dlen = __MIN(slen, newsize - dpos);
+
+        memcpy(buffer + dpos, sys->buffer + spos, dlen);
+        memcpy(buffer + ((at + dlen) & newmask),
+               sys->buffer + spos + dlen, slen - dlen);
+        at += slen;
+    }
+
+    free(sys->buffer);
+    sys->buffer = buffer;
+    sys->size = newsize;
+    sys->mask = newmask;
+    return 0;
+}
+
+/**
+ * Copies pending upstream blocks into the ring. The ring doubles on demand
+ * up to STREAM_CACHE_SIZE, then the oldest historical (already read) data
+ * is recycled. Unread data is never discarded: whatever does not fit stays
+ * pending until the reader makes room.
+ */
+static void AStreamIngestBlocks(stream_t *s)
 {
     stream_sys_t *sys = s->p_sys;
-    size_t cache_size = sys->cache.i_total;
 
-    /* Release data */
-    if (cache_size >= STREAM_CACHE_SIZE)
+    while (sys->pending != NULL)
     {
-        block_BytestreamFlush( &sys->cache );
-        cache_size = sys->cache.i_total;
+        block_t *b = sys->pending;
+        size_t room = sys->size - (sys->end - sys->start);
+
+        if (room == 0)
+        {
+            size_t history = sys->offset - sys->start;
+
+            if (sys->size < STREAM_CACHE_SIZE && RingGrow(sys) == 0)
+                continue;
+            if (history == 0)
+                break; /* full of unread data, the reader must drain first */
+
+            /* Recycle the history, as flushing the block chain used to */
+            sys->start += history;
+            room = history;
+        }
+
+        size_t copy = __MIN(b->i_buffer, room);
+
+        RingWrite(sys, sys->end, b->p_buffer, copy);
+        sys->end += copy;
+        if ((size_t)(sys->end - sys->start) > sys->stat.high)
+            sys->stat.high = sys->end - sys->start;
+
+        b->p_buffer += copy;
+        b->i_buffer -= copy;
+        if (b->i_buffer == 0)
+        {
+            sys->pending = b->p_next;
+            b->p_next = NULL;
+            block_Release(b);
+        }
     }
-    if (cache_size >= STREAM_CACHE_SIZE &&
-        sys->cache.p_chain != *sys->cache.pp_last)
+}
+
+static int AStreamRefillBlock(stream_t *s)
+{
+    stream_sys_t *sys = s->p_sys;
+
+    /* Resume copying blocks that did not fit earlier */
+    AStreamIngestBlocks(s);
+    if (sys->end != sys->offset)
     {
         /* Enough data, don't read more */
         return VLC_SUCCESS;
@@ -115,7 +216,8 @@ static int AStreamRefillBlock(stream_t *s)
     block_ChainProperties( b, NULL, &added_bytes, NULL );
     sys->stat.read_bytes += added_bytes;
 
-    block_BytestreamPush( &sys->cache, b );
+    block_ChainAppend(&sys->pending, b);
+    AStreamIngestBlocks(s);
     return VLC_SUCCESS;
 }
 
@@ -129,7 +231,7 @@ static void AStreamPrebufferBlock(stream_t *s)
     for (;;)
     {
         const vlc_tick_t now = vlc_tick_now();
-        size_t cache_size = block_BytestreamRemaining( &sys->cache );
+        size_t cache_size = sys->end - sys->offset;
 
         if (vlc_killed() || cache_size > STREAM_CACHE_PREBUFFER_SIZE)
         {
@@ -157,7 +259,8 @@ static void AStreamPrebufferBlock(stream_t *s)
             continue;
         }
 
-        block_BytestreamPush( &sys->cache, b);
+        block_ChainAppend(&sys->pending, b);
+        AStreamIngestBlocks(s);
 
         if (first)
         {
@@ -175,7 +278,9 @@ static void AStreamControlReset(stream_t *s)
 {
     stream_sys_t *sys = s->p_sys;
 
-    block_BytestreamEmpty( &sys->cache );
+    block_ChainRelease(sys->pending);
+    sys->pending = NULL;
+    sys->start = sys->offset = sys->end = vlc_stream_Tell(s->s);
 
     /* Do the prebuffering */
     AStreamPrebufferBlock(s);
@@ -185,14 +290,20 @@ static int AStreamSeekBlock(stream_t *s, uint64_t i_pos)
 {
     stream_sys_t *sys = s->p_sys;
 
-    if( block_SkipBytes( &sys->cache, i_pos) == VLC_SUCCESS )
+    if (i_pos >= sys->start && i_pos <= sys->end)
+    {   /* Still in the ring: also serves short backward seeks from the
+         * retained history, with no upstream round trip */
+        sys->offset = i_pos;
         return VLC_SUCCESS;
+    }
 
     /* Not enought bytes, empty and seek */
     /* Do the access seek */
     if (vlc_stream_Seek(s->s, i_pos)) return VLC_EGENERIC;
 
-    block_BytestreamEmpty( &sys->cache );
+    block_ChainRelease(sys->pending);
+    sys->pending = NULL;
+    sys->start = sys->offset = sys->end = i_pos;
 
     /* Refill a block */
     if (AStreamRefillBlock(s))
@@ -204,32 +315,33 @@ static int AStreamSeekBlock(stream_t *s, uint64_t i_pos)
 static ssize_t AStreamReadBlock(stream_t *s, void *buf, size_t len)
 {
     stream_sys_t *sys = s->p_sys;
+    size_t i_current = sys->end - sys->offset;
 
-    ssize_t i_current = block_BytestreamRemaining( &sys->cache );
-    size_t i_copy = VLC_CLIP((size_t)i_current, 0, len);
+    if (i_current < sys->stat.low)
+        sys->stat.low = i_current;
 
     /**
      * we should not signal end-of-file if we have not exhausted
-     * the cache. i_copy == 0 just means that the cache currently does
+     * the cache. i_current == 0 just means that the cache currently does
      * not contain data at the offset that we want, not EOF.
      **/
-    if( i_copy == 0 )
+    if (i_current == 0)
     {
         /* Return EOF if we are unable to refill cache, most likely
          * really EOF */
-        if( AStreamRefillBlock(s) == VLC_EGENERIC )
+        if (AStreamRefillBlock(s) == VLC_EGENERIC)
+            return 0;
+
+        i_current = sys->end - sys->offset;
+        if (i_current == 0)
             return 0;
     }
 
     /* Copy data */
-    if( block_GetBytes( &sys->cache, buf, i_copy ) )
-        return -1;
-
-
-    /* If we ended up on refill, try to read refilled cache */
-    if( i_copy == 0 && sys->cache.p_chain )
-        return AStreamReadBlock( s, buf, len );
+    size_t i_copy = __MIN(len, i_current);
 
+    RingRead(sys, sys->offset, buf, i_copy);
+    sys->offset += i_copy;
     return i_copy;
 }
 
@@ -289,16 +401,33 @@ static int Open(vlc_object_t *obj)
 
     msg_Dbg(s, "Using block method for AStream*");
 
-    /* Init all fields of sys->block */
-    block_BytestreamInit( &sys->cache );
+    sys->size = STREAM_CACHE_INITIAL_SIZE;
+    if (sys->size > STREAM_CACHE_SIZE)
+        sys->size = STREAM_CACHE_SIZE;
+    sys->mask = sys->size - 1;
+    sys->buffer = malloc(sys->size);
+    if (unlikely(sys->buffer == NULL))
+    {
+        free(sys);
+        return VLC_ENOMEM;
+    }
+
+    sys->start = sys->offset = sys->end = vlc_stream_Tell(s->s);
+    sys->pending = NULL;
+    sys->stat.read_bytes = 0;
+    sys->stat.read_time = 0;
+    sys->stat.low = SIZE_MAX;
+    sys->stat.high = 0;
 
     s->p_sys = sys;
     /* Do the prebuffering */
     AStreamPrebufferBlock(s);
 
-    if (block_BytestreamRemaining( &sys->cache ) <= 0)
+    if (sys->end == sys->offset)
     {
         msg_Err(s, "cannot pre fill buffer");
+        block_ChainRelease(sys->pending);
+        free(sys->buffer);
         free(sys);
         return VLC_EGENERIC;
     }
@@ -317,7 +446,11 @@ static void Close(vlc_object_t *obj)
     stream_t *s = (stream_t *)obj;
     stream_sys_t *sys = s->p_sys;
 
-    block_BytestreamEmpty( &sys->cache );
+    msg_Dbg(s, "cache watermarks: low %zu bytes, high %zu bytes",
+            (sys->stat.low != SIZE_MAX) ? sys->stat.low : 0, sys->stat.high);
+
+    block_ChainRelease(sys->pending);
+    free(sys->buffer);
     free(sys);
 }
 
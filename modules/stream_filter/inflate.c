@@ -22,6 +22,7 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 #include <zlib.h>
@@ -29,69 +30,206 @@
 #include <vlc_common.h>
 #include <vlc_plugin.h>
 #include <vlc_stream.h>
+#include <vlc_block.h>
+#include <vlc_interrupt.h>
+
+/** Size of a decompressed block */
+#define INFLATE_CHUNK (1 << 16)
+/** Number of decompressed blocks kept ahead of the reader, so that
+ * decompression overlaps with demuxing (double buffering) */
+#define INFLATE_DEPTH 2
 
 typedef struct
 {
-    z_stream zstream;
-    bool eof;
+    vlc_thread_t thread;
+    vlc_interrupt_t *interrupt;
+    vlc_mutex_t  lock;
+    vlc_cond_t   wait_data;
+    vlc_cond_t   wait_space;
+
+    block_t     *chain;  /**< decompressed data pending read */
+    block_t    **chain_last;
+    unsigned     ready;  /**< number of blocks in the chain */
+    bool         eof;
+    bool         error;
+    bool         paused;
+
+    bool         can_pause;
+    bool         can_pace;
+    vlc_tick_t   pts_delay;
+    char        *content_type;
+
+    /* Decompression thread private state */
+    z_stream     zstream;
+    bool         src_eof;
+    bool         mid_member;
     unsigned char buffer[16384];
 } stream_sys_t;
 
-static ssize_t Read(stream_t *stream, void *buf, size_t buflen)
+/**
+ * Decompresses up to @c buflen bytes (from the decompression thread).
+ * @return -1 on error, 0 at the end of the compressed data,
+ * the number of bytes produced otherwise.
+ */
+static ssize_t Inflate(stream_t *stream, unsigned char *buf, size_t buflen)
 {
     stream_sys_t *sys = stream->p_sys;
-    ssize_t val;
+    z_stream *zs = &sys->zstream;
 
-    if (sys->eof || unlikely(buflen == 0))
-        return 0;
+    zs->next_out = buf;
+    zs->avail_out = buflen;
 
-    sys->zstream.next_out = buf;
-    sys->zstream.avail_out = buflen;
+    while (zs->avail_out > 0)
+    {
+        if (zs->avail_in == 0)
+        {
+            ssize_t val = sys->src_eof ? 0
+                        : vlc_stream_Read(stream->s, sys->buffer,
+                                          sizeof (sys->buffer));
+            if (val <= 0)
+            {
+                sys->src_eof = true;
+                if (sys->mid_member)
+                    msg_Err(stream, "unexpected end of stream");
+                break;
+            }
+            zs->next_in = sys->buffer;
+            zs->avail_in = val;
+        }
 
-    if (sys->zstream.avail_in == 0)
-        sys->zstream.next_in = sys->buffer;
+        int ret = inflate(zs, Z_SYNC_FLUSH);
+        switch (ret)
+        {
+            case Z_OK:
+                sys->mid_member = true;
+                continue;
+            case Z_STREAM_END:
+                /* Decode any further member of a multi-member file, e.g.
+                 * the output of pigz or of concatenated gzip files. */
+                sys->mid_member = false;
+                if (inflateReset(zs) == Z_OK)
+                    continue;
+                /* fall through */
+            case Z_DATA_ERROR:
+                msg_Err(stream, "corrupt stream");
+                return -1;
+            case Z_BUF_ERROR: /* inflate() wants more input */
+                continue;
+            default:
+                msg_Err(stream, "unhandled decompression error (%d)", ret);
+                return -1;
+        }
+    }
 
-    val = (sys->buffer + sizeof (sys->buffer))
-        - (sys->zstream.next_in + sys->zstream.avail_in);
+    return buflen - zs->avail_out;
+}
 
-    if (val > 0)
-    {   /* Fill input buffer if there is space left */
-        val = vlc_stream_Read(stream->s,
-                          sys->zstream.next_in + sys->zstream.avail_in, val);
-        if (val >= 0)
-            sys->zstream.avail_in += val;
-    }
+static void *Thread(void *data)
+{
+    stream_t *stream = data;
+    stream_sys_t *sys = stream->p_sys;
+    bool paused = false;
+
+    vlc_interrupt_set(sys->interrupt);
 
-    if (sys->zstream.avail_in == 0)
+    vlc_mutex_lock(&sys->lock);
+    mutex_cleanup_push(&sys->lock);
+    for (;;)
     {
-        msg_Err(stream, "unexpected end of stream");
-        return 0;
+        if (sys->paused != paused)
+        {   /* Update pause state */
+            int canc = vlc_savecancel();
+
+            paused = sys->paused;
+            vlc_mutex_unlock(&sys->lock);
+            vlc_stream_Control(stream->s, STREAM_SET_PAUSE_STATE, paused);
+            vlc_mutex_lock(&sys->lock);
+            vlc_restorecancel(canc);
+            continue;
+        }
+
+        if (paused || sys->eof || sys->error || sys->ready >= INFLATE_DEPTH)
+        {   /* Wait for space to decompress ahead into */
+            vlc_cond_wait(&sys->wait_space, &sys->lock);
+            continue;
+        }
+        vlc_mutex_unlock(&sys->lock);
+
+        int canc = vlc_savecancel();
+        block_t *block = block_Alloc(INFLATE_CHUNK);
+        ssize_t val = -1;
+
+        if (likely(block != NULL))
+            val = Inflate(stream, block->p_buffer, block->i_buffer);
+        vlc_restorecancel(canc);
+
+        vlc_mutex_lock(&sys->lock);
+        if (val > 0)
+        {
+            block->i_buffer = val;
+            *sys->chain_last = block;
+            sys->chain_last = &block->p_next;
+            sys->ready++;
+        }
+        else
+        {
+            if (block != NULL)
+                block_Release(block);
+            if (val == 0)
+                sys->eof = true;
+            else
+                sys->error = true;
+        }
+        vlc_cond_signal(&sys->wait_data);
     }
+    vlc_assert_unreachable();
+    vlc_cleanup_pop();
+    return NULL;
+}
 
-    val = inflate(&sys->zstream, Z_SYNC_FLUSH);
-    switch (val)
+static ssize_t Read(stream_t *stream, void *buf, size_t buflen)
+{
+    stream_sys_t *sys = stream->p_sys;
+    size_t copy = 0;
+
+    if (unlikely(buflen == 0))
+        return 0;
+
+    vlc_mutex_lock(&sys->lock);
+    while (sys->chain == NULL && !sys->eof && !sys->error)
     {
-        case Z_STREAM_END:
-            msg_Dbg(stream, "end of stream");
-            sys->eof = true;
-            /* fall through */
-        case Z_OK:
-            return buflen - sys->zstream.avail_out;
-        case Z_DATA_ERROR:
-            msg_Err(stream, "corrupt stream");
-            sys->eof = true;
-            return -1;
-        case Z_BUF_ERROR:
-            if (sys->zstream.next_in == sys->buffer)
-                break;
+        void *data[2];
 
-            memmove(sys->buffer, sys->zstream.next_in, sys->zstream.avail_in);
-            sys->zstream.next_in = sys->buffer;
-            return Read(stream, buf, buflen);
+        vlc_interrupt_forward_start(sys->interrupt, data);
+        vlc_cond_wait(&sys->wait_data, &sys->lock);
+        vlc_interrupt_forward_stop(data);
     }
 
-    msg_Err(stream, "unhandled decompression error (%zd)", val);
-    return -1;
+    block_t *block = sys->chain;
+    if (block != NULL)
+    {
+        copy = (block->i_buffer < buflen) ? block->i_buffer : buflen;
+        memcpy(buf, block->p_buffer, copy);
+        block->p_buffer += copy;
+        block->i_buffer -= copy;
+
+        if (block->i_buffer == 0)
+        {
+            sys->chain = block->p_next;
+            if (sys->chain == NULL)
+                sys->chain_last = &sys->chain;
+            sys->ready--;
+            block_Release(block);
+            vlc_cond_signal(&sys->wait_space);
+        }
+    }
+    else if (sys->error)
+    {
+        vlc_mutex_unlock(&sys->lock);
+        return -1;
+    }
+    vlc_mutex_unlock(&sys->lock);
+    return copy;
 }
 
 static int Seek(stream_t *stream, uint64_t offset)
@@ -102,6 +240,8 @@ static int Seek(stream_t *stream, uint64_t offset)
 
 static int Control(stream_t *stream, int query, va_list args)
 {
+    stream_sys_t *sys = stream->p_sys;
+
     switch (query)
     {
         case STREAM_CAN_SEEK:
@@ -109,14 +249,32 @@ static int Control(stream_t *stream, int query, va_list args)
             *va_arg(args, bool *) = false;
             break;
         case STREAM_CAN_PAUSE:
+            *va_arg(args, bool *) = sys->can_pause;
+            break;
         case STREAM_CAN_CONTROL_PACE:
+            *va_arg(args, bool *) = sys->can_pace;
+            break;
         case STREAM_GET_PTS_DELAY:
-        case STREAM_GET_META:
+            *va_arg(args, vlc_tick_t *) = sys->pts_delay;
+            break;
         case STREAM_GET_CONTENT_TYPE:
-        case STREAM_GET_SIGNAL:
+            if (sys->content_type == NULL)
+                return VLC_EGENERIC;
+            *va_arg(args, char **) = strdup(sys->content_type);
+            return VLC_SUCCESS;
         case STREAM_SET_PAUSE_STATE:
-            return vlc_stream_vaControl(stream->s, query, args);
+        {
+            bool paused = va_arg(args, unsigned);
+
+            vlc_mutex_lock(&sys->lock);
+            sys->paused = paused;
+            vlc_cond_signal(&sys->wait_space);
+            vlc_mutex_unlock(&sys->lock);
+            break;
+        }
         case STREAM_GET_SIZE:
+        case STREAM_GET_META:
+        case STREAM_GET_SIGNAL:
         case STREAM_GET_TITLE_INFO:
         case STREAM_GET_TITLE:
         case STREAM_GET_SEEKPOINT:
@@ -160,7 +318,6 @@ static int Open(vlc_object_t *obj)
     sys->zstream.zalloc = Z_NULL;
     sys->zstream.zfree = Z_NULL;
     sys->zstream.opaque = Z_NULL;
-    sys->eof = false;
 
     int ret = inflateInit2(&sys->zstream, bits);
     if (ret != Z_OK)
@@ -169,11 +326,51 @@ static int Open(vlc_object_t *obj)
         return (ret == Z_MEM_ERROR) ? VLC_ENOMEM : VLC_EGENERIC;
     }
 
+    sys->chain = NULL;
+    sys->chain_last = &sys->chain;
+    sys->ready = 0;
+    sys->eof = false;
+    sys->error = false;
+    sys->paused = false;
+    sys->src_eof = false;
+    sys->mid_member = false;
+
+    vlc_stream_Control(stream->s, STREAM_CAN_PAUSE, &sys->can_pause);
+    vlc_stream_Control(stream->s, STREAM_CAN_CONTROL_PACE, &sys->can_pace);
+    vlc_stream_Control(stream->s, STREAM_GET_PTS_DELAY, &sys->pts_delay);
+    if (vlc_stream_Control(stream->s, STREAM_GET_CONTENT_TYPE,
+                           &sys->content_type))
+        sys->content_type = NULL;
+
+    sys->interrupt = vlc_interrupt_create();
+    if (unlikely(sys->interrupt == NULL))
+        goto error;
+
+    vlc_mutex_init(&sys->lock);
+    vlc_cond_init(&sys->wait_data);
+    vlc_cond_init(&sys->wait_space);
+
     stream->p_sys = sys;
+
+    if (vlc_clone(&sys->thread, Thread, stream, VLC_THREAD_PRIORITY_INPUT))
+    {
+        vlc_cond_destroy(&sys->wait_space);
+        vlc_cond_destroy(&sys->wait_data);
+        vlc_mutex_destroy(&sys->lock);
+        vlc_interrupt_destroy(sys->interrupt);
+        goto error;
+    }
+
     stream->pf_read = Read;
     stream->pf_seek = Seek;
     stream->pf_control = Control;
     return VLC_SUCCESS;
+
+error:
+    inflateEnd(&sys->zstream);
+    free(sys->content_type);
+    free(sys);
+    return VLC_ENOMEM;
 }
 
 static void Close (vlc_object_t *obj)
@@ -181,7 +378,18 @@ static void Close (vlc_object_t *obj)
     stream_t *stream = (stream_t *)obj;
     stream_sys_t *sys = stream->p_sys;
 
+    vlc_cancel(sys->thread);
+    vlc_interrupt_kill(sys->interrupt);
+    vlc_join(sys->thread, NULL);
+    vlc_interrupt_destroy(sys->interrupt);
+    vlc_cond_destroy(&sys->wait_space);
+    vlc_cond_destroy(&sys->wait_data);
+    vlc_mutex_destroy(&sys->lock);
+
+    if (sys->chain != NULL)
+        block_ChainRelease(sys->chain);
     inflateEnd(&sys->zstream);
+    free(sys->content_type);
     free(sys);
 }
 
@@ -75,6 +75,12 @@ typedef struct
     char        *buffer;
     size_t       seek_threshold;
 
+    size_t       window;        /**< target readahead (bytes) */
+    vlc_tick_t   read_latency;  /**< mean upstream read round trip */
+    uint64_t     consume_rate;  /**< mean downstream consumption (bytes/s) */
+    vlc_tick_t   consume_date;  /**< start of the current rate sample */
+    uint64_t     consume_bytes; /**< bytes consumed since consume_date */
+
     struct stream_ctrl *controls;
 } stream_sys_t;
 
@@ -86,13 +92,36 @@ static ssize_t ThreadRead(stream_t *stream, void *buf, size_t length)
     vlc_mutex_unlock(&sys->lock);
     assert(length > 0);
 
+    vlc_tick_t start = vlc_tick_now();
     ssize_t val = vlc_stream_ReadPartial(stream->s, buf, length);
+    vlc_tick_t delay = vlc_tick_now() - start;
 
     vlc_mutex_lock(&sys->lock);
+    sys->read_latency = (sys->read_latency * 7 + delay) / 8;
     vlc_restorecancel(canc);
     return val;
 }
 
+/**
+ * Updates the target readahead window from the measured source latency and
+ * consumption rate. The window tracks twice the bandwidth-delay product:
+ * enough data to ride out one upstream round trip plus jitter, so
+ * high-latency sources (HTTP, NFS) fill up while low-latency ones do not
+ * hog the buffer, the I/O scheduler nor the page cache.
+ * The lock must be held.
+ */
+static void WindowUpdate(stream_sys_t *sys)
+{
+    uint64_t bdp = sys->consume_rate * sys->read_latency / CLOCK_FREQ;
+    uint64_t window = 2 * bdp;
+
+    if (window < (sys->buffer_size / 8))
+        window = sys->buffer_size / 8;
+    if (window > sys->buffer_size)
+        window = sys->buffer_size;
+    sys->window = window;
+}
+
 static int ThreadSeek(stream_t *stream, uint64_t seek_offset)
 {
     stream_sys_t *sys = stream->p_sys;
@@ -203,8 +232,12 @@ static void *Thread(void *data)
          * If it fails, assume upstream is well-behaved such that the failed
          * seek is a no-op, and continue as if seeking was not supported.
          * WARNING: Except problems with misbehaving access plug-ins. */
+        /* Skipping less than the readahead window by reading is cheaper
+         * than a seek round trip to the source. */
+        size_t seek_threshold = __MAX(sys->seek_threshold, sys->window);
+
         if (sys->can_seek
-         && history >= (sys->buffer_length + sys->seek_threshold))
+         && history >= (sys->buffer_length + seek_threshold))
         {
             if (ThreadSeek(stream, stream_offset) == 0)
             {
@@ -227,6 +260,17 @@ static void *Thread(void *data)
 
         assert(sys->buffer_size >= sys->buffer_length);
 
+        /* Readahead already available past the read pointer */
+        uint64_t ahead = 0;
+        if (sys->buffer_offset + sys->buffer_length > stream_offset)
+            ahead = sys->buffer_offset + sys->buffer_length - stream_offset;
+
+        if (ahead >= sys->window)
+        {   /* Enough readahead for the measured source latency */
+            vlc_cond_wait(&sys->wait_space, &sys->lock);
+            continue;
+        }
+
         size_t len = sys->buffer_size - sys->buffer_length;
         if (len == 0)
         {   /* Buffer is full */
@@ -341,6 +385,24 @@ static ssize_t Read(stream_t *stream, void *buf, size_t buflen)
 
     memcpy(buf, sys->buffer + offset, copy);
     sys->stream_offset += copy;
+
+    /* Measure the consumption rate, about four times per second */
+    vlc_tick_t now = vlc_tick_now();
+
+    sys->consume_bytes += copy;
+    if (sys->consume_date == VLC_TICK_INVALID)
+        sys->consume_date = now;
+    else if ((now - sys->consume_date) >= (CLOCK_FREQ / 4))
+    {
+        uint64_t rate = sys->consume_bytes * CLOCK_FREQ
+                      / (now - sys->consume_date);
+
+        sys->consume_rate = (sys->consume_rate * 3 + rate) / 4;
+        sys->consume_date = now;
+        sys->consume_bytes = 0;
+        WindowUpdate(sys);
+    }
+
     vlc_cond_signal(&sys->wait_space);
     vlc_mutex_unlock(&sys->lock);
     return copy;
@@ -473,6 +535,10 @@ static int Open(vlc_object_t *obj)
     sys->buffer_size = var_InheritInteger(obj, "prefetch-buffer-size") << 10u;
     sys->seek_threshold = var_InheritInteger(obj, "prefetch-seek-threshold");
     sys->controls = NULL;
+    sys->read_latency = 0;
+    sys->consume_rate = 0;
+    sys->consume_date = VLC_TICK_INVALID;
+    sys->consume_bytes = 0;
 
     uint64_t size = stream_Size(stream->s);
     if (size > 0)
@@ -481,6 +547,10 @@ static int Open(vlc_object_t *obj)
             sys->buffer_size = size;
     }
 
+    /* Until the source latency and consumption rate are measured, aim
+     * half-way; WindowUpdate() takes over from the first rate sample. */
+    sys->window = sys->buffer_size / 2;
+
     sys->buffer = malloc(sys->buffer_size);
     if (sys->buffer == NULL)
         goto error;
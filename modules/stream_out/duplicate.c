@@ -33,6 +33,7 @@
 #include <vlc_plugin.h>
 #include <vlc_sout.h>
 #include <vlc_block.h>
+#include <vlc_atomic.h>
 
 /*****************************************************************************
  * Module descriptor
@@ -77,6 +78,76 @@ typedef struct
 
 static bool ESSelected( const es_format_t *fmt, char *psz_select );
 
+/*****************************************************************************
+ * Shared blocks: instead of deep-copying the payload once per destination,
+ * every branch receives a refcounted read-only view of the same buffer; the
+ * original block is released along with the last view. Views carry no spare
+ * room, so any consumer that needs to grow or reshape the data goes through
+ * block_Realloc() and thereby materializes its own private copy.
+ *****************************************************************************/
+typedef struct
+{
+    atomic_uint refs;
+    block_t     *p_block;
+} dup_shared_t;
+
+typedef struct
+{
+    block_t      self;
+    dup_shared_t *p_shared;
+} dup_view_t;
+
+static void BlockShareRelease( dup_shared_t *p_shared )
+{
+    if( atomic_fetch_sub_explicit( &p_shared->refs, 1,
+                                   memory_order_release ) == 1 )
+    {
+        atomic_thread_fence( memory_order_acquire );
+        block_Release( p_shared->p_block );
+        free( p_shared );
+    }
+}
+
+static void BlockShareViewRelease( block_t *p_block )
+{
+    dup_view_t *p_view = container_of( p_block, dup_view_t, self );
+    dup_shared_t *p_shared = p_view->p_shared;
+
+    free( p_view );
+    BlockShareRelease( p_shared );
+}
+
+static const struct vlc_block_callbacks dup_view_cbs =
+{
+    BlockShareViewRelease,
+};
+
+/* Takes ownership of p_block, with one reference held by the caller */
+static dup_shared_t *BlockShareNew( block_t *p_block )
+{
+    dup_shared_t *p_shared = malloc( sizeof( *p_shared ) );
+    if( unlikely(p_shared == NULL) )
+        return NULL;
+
+    atomic_init( &p_shared->refs, 1 );
+    p_shared->p_block = p_block;
+    return p_shared;
+}
+
+static block_t *BlockShareView( dup_shared_t *p_shared )
+{
+    dup_view_t *p_view = malloc( sizeof( *p_view ) );
+    if( unlikely(p_view == NULL) )
+        return NULL;
+
+    block_Init( &p_view->self, &dup_view_cbs,
+                p_shared->p_block->p_buffer, p_shared->p_block->i_buffer );
+    block_CopyProperties( &p_view->self, p_shared->p_block );
+    p_view->p_shared = p_shared;
+    atomic_fetch_add_explicit( &p_shared->refs, 1, memory_order_relaxed );
+    return &p_view->self;
+}
+
 /*****************************************************************************
  * Open:
  *****************************************************************************/
@@ -269,31 +340,53 @@ static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
     while( p_buffer )
     {
         block_t *p_next = p_buffer->p_next;
+        dup_shared_t *p_shared = NULL;
+        int i_last = -1;
 
         p_buffer->p_next = NULL;
 
-        for( i_stream = 0; i_stream < p_sys->i_nb_streams - 1; i_stream++ )
-        {
-            p_dup_stream = p_sys->pp_streams[i_stream];
-
+        /* The last selected branch inherits the caller's reference */
+        for( i_stream = 0; i_stream < p_sys->i_nb_streams; i_stream++ )
             if( id->pp_ids[i_stream] )
-            {
-                block_t *p_dup = block_Duplicate( p_buffer );
+                i_last = i_stream;
 
-                if( p_dup )
-                    sout_StreamIdSend( p_dup_stream, id->pp_ids[i_stream], p_dup );
-            }
+        if( i_last < 0 )
+        {
+            block_Release( p_buffer );
+            p_buffer = p_next;
+            continue;
         }
 
-        if( i_stream < p_sys->i_nb_streams && id->pp_ids[i_stream] )
+        for( i_stream = 0; i_stream < i_last; i_stream++ )
         {
-            p_dup_stream = p_sys->pp_streams[i_stream];
-            sout_StreamIdSend( p_dup_stream, id->pp_ids[i_stream], p_buffer );
+            block_t *p_dup;
+
+            if( !id->pp_ids[i_stream] )
+                continue;
+
+            if( p_shared == NULL )
+                p_shared = BlockShareNew( p_buffer );
+            /* Fall back to a deep copy if the holder cannot be allocated */
+            p_dup = ( p_shared != NULL ) ? BlockShareView( p_shared )
+                                         : block_Duplicate( p_buffer );
+            if( p_dup )
+                sout_StreamIdSend( p_sys->pp_streams[i_stream],
+                                   id->pp_ids[i_stream], p_dup );
         }
-        else
+
+        p_dup_stream = p_sys->pp_streams[i_last];
+        if( p_shared != NULL )
         {
-            block_Release( p_buffer );
+            /* The original now belongs to the share holder, so the last
+             * branch gets a view like its siblings */
+            block_t *p_dup = BlockShareView( p_shared );
+
+            if( p_dup )
+                sout_StreamIdSend( p_dup_stream, id->pp_ids[i_last], p_dup );
+            BlockShareRelease( p_shared );
         }
+        else
+            sout_StreamIdSend( p_dup_stream, id->pp_ids[i_last], p_buffer );
 
         p_buffer = p_next;
     }
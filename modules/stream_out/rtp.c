@@ -1389,6 +1389,9 @@ static int  HttpCallback( httpd_file_sys_t *p_args,
 /****************************************************************************
  * RTP send
  ****************************************************************************/
+/* Maximum number of already due packets sent as one batch */
+#define RTP_BATCH_MAX 32
+
 static void* ThreadSend( void *data )
 {
 #ifdef _WIN32
@@ -1434,38 +1437,95 @@ static void* ThreadSend( void *data )
         vlc_cleanup_pop ();
 #endif
 
-        ssize_t len = out->i_buffer;
         int canc = vlc_savecancel ();
 
+        /* Harvest packets which are already due so that the whole burst
+         * gets transmitted at once. No packet is ever delayed past its
+         * deadline, so pacing and jitter are unaffected. */
+        block_t *outv[RTP_BATCH_MAX];
+        unsigned outc = 0;
+        outv[outc++] = out;
+#ifdef HAVE_SRTP
+        if( id->srtp == NULL ) /* SRTP packets are encrypted one by one */
+#endif
+        {
+            vlc_tick_t now = vlc_tick_now();
+            while( outc < RTP_BATCH_MAX )
+            {
+                vlc_fifo_Lock( id->p_fifo );
+                size_t depth = vlc_fifo_GetCount( id->p_fifo );
+                vlc_fifo_Unlock( id->p_fifo );
+
+                if( depth == 0
+                 || block_FifoShow( id->p_fifo )->i_dts + i_caching > now )
+                    break;
+                outv[outc++] = block_FifoGet( id->p_fifo );
+            }
+        }
+
         vlc_mutex_lock( &id->lock_sink );
         unsigned deadc = 0; /* How many dead sockets? */
         int deadv[id->sinkc ? id->sinkc : 1]; /* Dead sockets list */
 
         for( int i = 0; i < id->sinkc; i++ )
         {
+            unsigned sent = 0;
 #ifdef HAVE_SRTP
             if( !id->srtp ) /* FIXME: SRTCP support */
 #endif
-                SendRTCP( id->sinkv[i].rtcp, out );
+                for( unsigned j = 0; j < outc; j++ )
+                    SendRTCP( id->sinkv[i].rtcp, outv[j] );
 
-            if( send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 ) == -1
-             && net_errno != EAGAIN && net_errno != EWOULDBLOCK
-             && net_errno != ENOBUFS && net_errno != ENOMEM )
+#ifdef HAVE_SENDMMSG
+            if( outc > 1 )
             {
-                int type;
-                getsockopt( id->sinkv[i].rtp_fd, SOL_SOCKET, SO_TYPE,
-                            &type, &(socklen_t){ sizeof(type) });
-                if( type == SOCK_DGRAM )
-                    /* ICMP soft error: ignore and retry */
-                    send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 );
-                else
-                    /* Broken connection */
-                    deadv[deadc++] = id->sinkv[i].rtp_fd;
+                struct mmsghdr msgv[RTP_BATCH_MAX];
+                struct iovec iov[RTP_BATCH_MAX];
+
+                memset( msgv, 0, outc * sizeof (msgv[0]) );
+                for( unsigned j = 0; j < outc; j++ )
+                {
+                    iov[j].iov_base = outv[j]->p_buffer;
+                    iov[j].iov_len = outv[j]->i_buffer;
+                    msgv[j].msg_hdr.msg_iov = iov + j;
+                    msgv[j].msg_hdr.msg_iovlen = 1;
+                }
+
+                int val = sendmmsg( id->sinkv[i].rtp_fd, msgv, outc, 0 );
+                if( val > 0 )
+                    sent = val;
+                /* Remaining packets go through the send() path below,
+                 * which knows how to tell soft errors apart. */
+            }
+#endif
+            for( unsigned j = sent; j < outc; j++ )
+            {
+                if( send( id->sinkv[i].rtp_fd, outv[j]->p_buffer,
+                          outv[j]->i_buffer, 0 ) == -1
+                 && net_errno != EAGAIN && net_errno != EWOULDBLOCK
+                 && net_errno != ENOBUFS && net_errno != ENOMEM )
+                {
+                    int type;
+                    getsockopt( id->sinkv[i].rtp_fd, SOL_SOCKET, SO_TYPE,
+                                &type, &(socklen_t){ sizeof(type) });
+                    if( type == SOCK_DGRAM )
+                        /* ICMP soft error: ignore and retry */
+                        send( id->sinkv[i].rtp_fd, outv[j]->p_buffer,
+                              outv[j]->i_buffer, 0 );
+                    else
+                    {
+                        /* Broken connection */
+                        deadv[deadc++] = id->sinkv[i].rtp_fd;
+                        break;
+                    }
+                }
             }
         }
-        id->i_seq_sent_next = ntohs(((uint16_t *) out->p_buffer)[1]) + 1;
+        id->i_seq_sent_next =
+            ntohs(((uint16_t *) outv[outc - 1]->p_buffer)[1]) + 1;
         vlc_mutex_unlock( &id->lock_sink );
-        block_Release( out );
+        for( unsigned j = 0; j < outc; j++ )
+            block_Release( outv[j] );
 
         for( unsigned i = 0; i < deadc; i++ )
         {
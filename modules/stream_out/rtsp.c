@@ -56,6 +56,9 @@
 
 typedef struct rtsp_session_t rtsp_session_t;
 
+/* Must be a power of two; sized for a few thousand concurrent sessions */
+#define RTSP_SESSION_BUCKETS 256
+
 struct rtsp_stream_t
 {
     vlc_mutex_t     lock;
@@ -68,6 +71,11 @@ struct rtsp_stream_t
 
     int             sessionc;
     rtsp_session_t **sessionv;
+    /* sessions hashed by id, for O(1) lookup */
+    rtsp_session_t *sessionh[RTSP_SESSION_BUCKETS];
+    /* sessions ordered by last_seen, for O(1) keepalive expiry */
+    rtsp_session_t *oldest;
+    rtsp_session_t *newest;
 
     unsigned        timeout;
     vlc_timer_t     timer;
@@ -178,6 +186,9 @@ struct rtsp_session_t
     rtsp_stream_t *stream;
     uint64_t       id;
     vlc_tick_t     last_seen; /* for timeouts */
+    rtsp_session_t *hnext;    /* hash bucket chain */
+    rtsp_session_t *older;    /* sessions seen before this one */
+    rtsp_session_t *newer;    /* sessions seen after this one */
 
     /* output (id-access) */
     int            trackc;
@@ -297,49 +308,73 @@ void RtspDelId( rtsp_stream_t *rtsp, rtsp_stream_id_t *id )
 }
 
 
+static unsigned RtspSessionBucket( uint64_t id )
+{
+    return id & (RTSP_SESSION_BUCKETS - 1);
+}
+
+
+/** rtsp must be locked */
+static void RtspSessionEnqueue( rtsp_stream_t *rtsp, rtsp_session_t *session )
+{
+    session->newer = NULL;
+    session->older = rtsp->newest;
+    if (rtsp->newest != NULL)
+        rtsp->newest->newer = session;
+    else
+        rtsp->oldest = session;
+    rtsp->newest = session;
+}
+
+
+/** rtsp must be locked */
+static void RtspSessionUnqueue( rtsp_stream_t *rtsp, rtsp_session_t *session )
+{
+    if (session->older != NULL)
+        session->older->newer = session->newer;
+    else
+        rtsp->oldest = session->newer;
+    if (session->newer != NULL)
+        session->newer->older = session->older;
+    else
+        rtsp->newest = session->older;
+}
+
+
 /** rtsp must be locked */
 static void RtspUpdateTimer( rtsp_stream_t *rtsp )
 {
     if (rtsp->timeout <= 0)
         return;
 
-    vlc_tick_t timeout = 0;
-    for (int i = 0; i < rtsp->sessionc; i++)
-    {
-        if (timeout == 0 || rtsp->sessionv[i]->last_seen < timeout)
-            timeout = rtsp->sessionv[i]->last_seen;
-    }
-    if (timeout != 0)
-    {
-        timeout += vlc_tick_from_sec( rtsp->timeout );
-        vlc_timer_schedule(rtsp->timer, true, timeout, VLC_TIMER_FIRE_ONCE);
-    }
+    /* The next session to expire is necessarily the least recently seen */
+    if (rtsp->oldest != NULL)
+        vlc_timer_schedule(rtsp->timer, true,
+                           rtsp->oldest->last_seen
+                               + vlc_tick_from_sec( rtsp->timeout ),
+                           VLC_TIMER_FIRE_ONCE);
     else
-    {
         vlc_timer_disarm(rtsp->timer);
-    }
 }
 
 
 static void RtspTimeOut( void *data )
 {
     rtsp_stream_t *rtsp = data;
+    rtsp_session_t *session;
 
     vlc_mutex_lock(&rtsp->lock);
-    vlc_tick_t now = vlc_tick_now();
-    for (int i = rtsp->sessionc - 1; i >= 0; i--)
+    vlc_tick_t deadline = vlc_tick_now() - vlc_tick_from_sec( rtsp->timeout );
+    while ((session = rtsp->oldest) != NULL && session->last_seen < deadline)
     {
-        if (rtsp->sessionv[i]->last_seen + vlc_tick_from_sec( rtsp->timeout ) < now)
+        if (rtsp->vod_media != NULL)
         {
-            if (rtsp->vod_media != NULL)
-            {
-                char psz_sesbuf[17];
-                snprintf( psz_sesbuf, sizeof( psz_sesbuf ), "%"PRIx64,
-                          rtsp->sessionv[i]->id );
-                vod_stop(rtsp->vod_media, psz_sesbuf);
-            }
-            RtspClientDel(rtsp, rtsp->sessionv[i]);
+            char psz_sesbuf[17];
+            snprintf( psz_sesbuf, sizeof( psz_sesbuf ), "%"PRIx64,
+                      session->id );
+            vod_stop(rtsp->vod_media, psz_sesbuf);
         }
+        RtspClientDel(rtsp, session);
     }
     RtspUpdateTimer(rtsp);
     vlc_mutex_unlock(&rtsp->lock);
@@ -356,11 +391,18 @@ rtsp_session_t *RtspClientNew( rtsp_stream_t *rtsp )
 
     s->stream = rtsp;
     vlc_rand_bytes (&s->id, sizeof (s->id));
+    s->last_seen = vlc_tick_now();
     s->trackc = 0;
     s->trackv = NULL;
 
     TAB_APPEND( rtsp->sessionc, rtsp->sessionv, s );
 
+    rtsp_session_t **pp = &rtsp->sessionh[RtspSessionBucket( s->id )];
+    s->hnext = *pp;
+    *pp = s;
+
+    RtspSessionEnqueue( rtsp, s );
+
     return s;
 }
 
@@ -371,7 +413,6 @@ rtsp_session_t *RtspClientGet( rtsp_stream_t *rtsp, const char *name )
 {
     char *end;
     uint64_t id;
-    int i;
 
     if( name == NULL )
         return NULL;
@@ -381,11 +422,11 @@ rtsp_session_t *RtspClientGet( rtsp_stream_t *rtsp, const char *name )
     if( errno || *end )
         return NULL;
 
-    /* FIXME: use a hash/dictionary */
-    for( i = 0; i < rtsp->sessionc; i++ )
+    for( rtsp_session_t *s = rtsp->sessionh[RtspSessionBucket( id )];
+         s != NULL; s = s->hnext )
     {
-        if( rtsp->sessionv[i]->id == id )
-            return rtsp->sessionv[i];
+        if( s->id == id )
+            return s;
     }
     return NULL;
 }
@@ -398,6 +439,17 @@ void RtspClientDel( rtsp_stream_t *rtsp, rtsp_session_t *session )
     int i;
     TAB_REMOVE( rtsp->sessionc, rtsp->sessionv, session );
 
+    for( rtsp_session_t **pp = &rtsp->sessionh[RtspSessionBucket( session->id )];
+         *pp != NULL; pp = &(*pp)->hnext )
+    {
+        if( *pp == session )
+        {
+            *pp = session->hnext;
+            break;
+        }
+    }
+    RtspSessionUnqueue( rtsp, session );
+
     for( i = 0; i < session->trackc; i++ )
         RtspTrackClose( &session->trackv[i] );
 
@@ -409,11 +461,23 @@ void RtspClientDel( rtsp_stream_t *rtsp, rtsp_session_t *session )
 /** rtsp must be locked */
 static void RtspClientAlive( rtsp_session_t *session )
 {
-    if (session->stream->timeout <= 0)
+    rtsp_stream_t *rtsp = session->stream;
+
+    if (rtsp->timeout <= 0)
         return;
 
     session->last_seen = vlc_tick_now();
-    RtspUpdateTimer(session->stream);
+
+    /* Move to the most recently seen end; the timer only needs rearming
+     * when the next session to expire changes */
+    bool was_oldest = (rtsp->oldest == session);
+    if (rtsp->newest != session)
+    {
+        RtspSessionUnqueue( rtsp, session );
+        RtspSessionEnqueue( rtsp, session );
+    }
+    if (was_oldest)
+        RtspUpdateTimer(rtsp);
 }
 
 static int dup_socket(int oldfd)
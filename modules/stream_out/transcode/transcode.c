@@ -80,6 +80,11 @@
 #define VFILTER_LONGTEXT N_( \
     "Video filters will be applied to the video streams (after overlays " \
     "are applied). You can enter a colon-separated list of filters." )
+#define VFILTER_PIPELINE_TEXT N_("Pipeline video filters")
+#define VFILTER_PIPELINE_LONGTEXT N_( \
+    "Run each video filter on its own thread so consecutive pictures are " \
+    "filtered concurrently. Increases throughput with multiple filters at " \
+    "the cost of a few pictures of extra latency." )
 
 #define AENC_TEXT N_("Audio encoder")
 #define AENC_LONGTEXT N_( \
@@ -130,6 +135,14 @@
 #define POOL_TEXT N_("Picture pool size")
 #define POOL_LONGTEXT N_( "Defines how many pictures we allow to be in pool "\
     "between decoder/encoder threads when threads > 0" )
+#define PARALLEL_TEXT N_("Parallel stream processing")
+#define PARALLEL_LONGTEXT N_( \
+    "Decode, filter and encode each elementary stream on a dedicated " \
+    "thread, so that a slow video encode does not stall audio transcoding." )
+
+/* Maximum number of input blocks queued per elementary stream worker before
+ * Send() blocks, bounding memory usage and exerting back-pressure. */
+#define TRANSCODE_WORKER_DEPTH 32
 
 
 static const char *const ppsz_deinterlace_type[] =
@@ -178,6 +191,8 @@ vlc_module_begin ()
                  MAXHEIGHT_LONGTEXT, true )
     add_module_list(SOUT_CFG_PREFIX "vfilter", "video filter", NULL,
                     VFILTER_TEXT, VFILTER_LONGTEXT)
+    add_bool( SOUT_CFG_PREFIX "vfilter-pipeline", false,
+              VFILTER_PIPELINE_TEXT, VFILTER_PIPELINE_LONGTEXT, true )
 
     set_section( N_("Audio"), NULL )
     add_module(SOUT_CFG_PREFIX "aenc", "encoder", NULL,
@@ -216,16 +231,19 @@ vlc_module_begin ()
         change_integer_range( 1, 1000 )
     add_bool( SOUT_CFG_PREFIX "high-priority", false, HP_TEXT, HP_LONGTEXT,
               true )
+    add_bool( SOUT_CFG_PREFIX "parallel", false, PARALLEL_TEXT,
+              PARALLEL_LONGTEXT, true )
 
 vlc_module_end ()
 
 static const char *const ppsz_sout_options[] = {
     "venc", "vcodec", "vb",
-    "scale", "fps", "width", "height", "vfilter", "deinterlace",
+    "scale", "fps", "width", "height", "vfilter", "vfilter-pipeline",
+    "deinterlace",
     "deinterlace-module", "threads", "aenc", "acodec", "ab", "alang",
     "afilter", "samplerate", "channels", "senc", "scodec", "soverlay",
     "sfilter", "high-priority", "maxwidth", "maxheight", "pool-size",
-    NULL
+    "parallel", NULL
 };
 
 /*****************************************************************************
@@ -234,6 +252,8 @@ static const char *const ppsz_sout_options[] = {
 static void *Add( sout_stream_t *, const es_format_t * );
 static void  Del( sout_stream_t *, void * );
 static int   Send( sout_stream_t *, void *, block_t * );
+static int   WorkerSpawn( sout_stream_t *, sout_stream_id_sys_t * );
+static void  WorkerJoin( sout_stream_id_sys_t * );
 
 static void SetAudioEncoderConfig( sout_stream_t *p_stream, transcode_encoder_config_t *p_cfg )
 {
@@ -426,6 +446,9 @@ static int Open( vlc_object_t *p_this )
     else
         free( psz_string );
 
+    p_sys->vfilters_cfg.video.b_pipeline =
+        var_GetBool( p_stream, SOUT_CFG_PREFIX "vfilter-pipeline" );
+
     if( var_GetBool( p_stream, SOUT_CFG_PREFIX "deinterlace" ) )
     {
         psz_string = var_GetString( p_stream,
@@ -451,6 +474,8 @@ static int Open( vlc_object_t *p_this )
         msg_Dbg( p_stream, "codec spu=%4.4s", (char *)&p_sys->senc_cfg.i_codec );
 
     p_sys->b_soverlay = var_GetBool( p_stream, SOUT_CFG_PREFIX "soverlay" );
+    p_sys->b_parallel = var_GetBool( p_stream, SOUT_CFG_PREFIX "parallel" );
+    vlc_mutex_init( &p_sys->lock_downstream );
     /* Set default size for TEXT spu non overlay conversion / updater */
     p_sys->senc_cfg.spu.i_width = (p_sys->venc_cfg.video.i_width) ? p_sys->venc_cfg.video.i_width : 1280;
     p_sys->senc_cfg.spu.i_height = (p_sys->venc_cfg.video.i_height) ? p_sys->venc_cfg.video.i_height : 720;
@@ -480,6 +505,7 @@ static void Close( vlc_object_t * p_this )
 
     transcode_encoder_config_clean( &p_sys->senc_cfg );
 
+    vlc_mutex_destroy( &p_sys->lock_downstream );
     free( p_sys );
 }
 
@@ -526,7 +552,11 @@ static vlc_tick_t GetMasterDrift( void *cbdata )
     sout_stream_sys_t *p_sys = p_stream->p_sys;
     if( p_sys->id_master_sync )
     {
-        return p_sys->id_master_sync->i_drift;
+        /* The master may update its drift from a worker thread */
+        vlc_mutex_lock( &p_sys->id_master_sync->fifo.lock );
+        vlc_tick_t i_drift = p_sys->id_master_sync->i_drift;
+        vlc_mutex_unlock( &p_sys->id_master_sync->fifo.lock );
+        return i_drift;
     }
     return 0;
 }
@@ -567,7 +597,9 @@ static void *transcode_downstream_Add( sout_stream_t *p_stream,
     if( tmp.i_group != fmt_orig->i_group )
         tmp.i_group = fmt_orig->i_group;
 
+    vlc_mutex_lock( &p_sys->lock_downstream );
     void *downstream = sout_StreamIdAdd( p_stream->p_next, &tmp );
+    vlc_mutex_unlock( &p_sys->lock_downstream );
     es_format_Clean( &tmp );
     return downstream;
 }
@@ -655,6 +687,12 @@ static void *Add( sout_stream_t *p_stream, const es_format_t *p_fmt )
     if(!success)
         goto error;
 
+    if( p_sys->b_parallel && id->b_transcode &&
+        ( p_fmt->i_cat == AUDIO_ES || p_fmt->i_cat == VIDEO_ES ) &&
+        WorkerSpawn( p_stream, id ) )
+        msg_Warn( p_stream, "cannot spawn transcode worker thread, "
+                  "processing stream synchronously" );
+
     return id;
 
 error:
@@ -672,12 +710,14 @@ static void Del( sout_stream_t *p_stream, void *_id )
         {
         case AUDIO_ES:
             Send( p_stream, id, NULL );
+            WorkerJoin( id );
             transcode_audio_clean( id );
             if( id == p_sys->id_master_sync )
                 p_sys->id_master_sync = NULL;
             break;
         case VIDEO_ES:
             Send( p_stream, id, NULL );
+            WorkerJoin( id );
             if( id == p_sys->id_video )
                 p_sys->id_video = NULL;
             transcode_video_clean( p_stream, id );
@@ -690,28 +730,23 @@ static void Del( sout_stream_t *p_stream, void *_id )
         }
     }
 
-    if( id->downstream_id ) sout_StreamIdDel( p_stream->p_next, id->downstream_id );
+    if( id->downstream_id )
+    {
+        vlc_mutex_lock( &p_sys->lock_downstream );
+        sout_StreamIdDel( p_stream->p_next, id->downstream_id );
+        vlc_mutex_unlock( &p_sys->lock_downstream );
+    }
 
     DeleteSoutStreamID( id );
 }
 
-static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
+static int ProcessBlock( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
+                         block_t *p_buffer )
 {
-    sout_stream_id_sys_t *id = (sout_stream_id_sys_t *)_id;
+    sout_stream_sys_t *p_sys = p_stream->p_sys;
     block_t *p_out = NULL;
-
-    if( id->b_error )
-        goto error;
-
-    if( !id->b_transcode )
-    {
-        if( id->downstream_id )
-            return sout_StreamIdSend( p_stream->p_next, id->downstream_id, p_buffer );
-        else
-            goto error;
-    }
-
     int i_ret;
+
     switch( id->p_decoder->fmt_in.i_cat )
     {
     case AUDIO_ES:
@@ -727,14 +762,158 @@ static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
         break;
 
     default:
-        goto error;
+        if( p_buffer )
+            block_Release( p_buffer );
+        return VLC_EGENERIC;
     }
 
-    if( p_out &&
-        sout_StreamIdSend( p_stream->p_next, id->downstream_id, p_out ) )
-        i_ret = VLC_EGENERIC;
+    if( p_out )
+    {
+        vlc_mutex_lock( &p_sys->lock_downstream );
+        if( sout_StreamIdSend( p_stream->p_next, id->downstream_id, p_out ) )
+            i_ret = VLC_EGENERIC;
+        vlc_mutex_unlock( &p_sys->lock_downstream );
+    }
 
     return i_ret;
+}
+
+static void *WorkerThread( void *data )
+{
+    sout_stream_id_sys_t *id = data;
+    sout_stream_t *p_stream = id->worker.p_stream;
+
+    for( ;; )
+    {
+        block_t *p_block;
+
+        vlc_mutex_lock( &id->worker.lock );
+        while( id->worker.first == NULL && !id->worker.b_eof )
+            vlc_cond_wait( &id->worker.wait_data, &id->worker.lock );
+        p_block = id->worker.first;
+        if( p_block != NULL )
+        {
+            id->worker.first = p_block->p_next;
+            if( id->worker.first == NULL )
+                id->worker.last = &id->worker.first;
+            p_block->p_next = NULL;
+            id->worker.i_depth--;
+            vlc_cond_signal( &id->worker.wait_room );
+        }
+        vlc_mutex_unlock( &id->worker.lock );
+
+        /* p_block == NULL means the queue drained after EOF: flush */
+        int i_ret = ProcessBlock( p_stream, id, p_block );
+        if( i_ret != VLC_SUCCESS )
+        {
+            vlc_mutex_lock( &id->worker.lock );
+            id->worker.i_error = i_ret;
+            vlc_cond_signal( &id->worker.wait_room );
+            vlc_mutex_unlock( &id->worker.lock );
+        }
+
+        if( p_block == NULL )
+            break;
+    }
+    return NULL;
+}
+
+static int WorkerQueue( sout_stream_id_sys_t *id, block_t *p_buffer )
+{
+    int i_ret;
+
+    vlc_mutex_lock( &id->worker.lock );
+    if( p_buffer == NULL )
+    {
+        id->worker.b_eof = true;
+        vlc_cond_signal( &id->worker.wait_data );
+    }
+    else
+    {
+        while( id->worker.i_depth >= TRANSCODE_WORKER_DEPTH &&
+               id->worker.i_error == VLC_SUCCESS )
+            vlc_cond_wait( &id->worker.wait_room, &id->worker.lock );
+
+        if( id->worker.i_error != VLC_SUCCESS )
+            block_Release( p_buffer );
+        else
+        {
+            *id->worker.last = p_buffer;
+            id->worker.last = &p_buffer->p_next;
+            id->worker.i_depth++;
+            vlc_cond_signal( &id->worker.wait_data );
+        }
+    }
+    /* Worker errors are reported on the next Send(), like b_error */
+    i_ret = id->worker.i_error;
+    vlc_mutex_unlock( &id->worker.lock );
+
+    return i_ret;
+}
+
+static int WorkerSpawn( sout_stream_t *p_stream, sout_stream_id_sys_t *id )
+{
+    id->worker.p_stream = p_stream;
+    id->worker.first = NULL;
+    id->worker.last = &id->worker.first;
+    id->worker.i_depth = 0;
+    id->worker.b_eof = false;
+    id->worker.i_error = VLC_SUCCESS;
+    vlc_mutex_init( &id->worker.lock );
+    vlc_cond_init( &id->worker.wait_data );
+    vlc_cond_init( &id->worker.wait_room );
+
+    if( vlc_clone( &id->worker.thread, WorkerThread, id,
+                   VLC_THREAD_PRIORITY_OUTPUT ) )
+    {
+        vlc_cond_destroy( &id->worker.wait_room );
+        vlc_cond_destroy( &id->worker.wait_data );
+        vlc_mutex_destroy( &id->worker.lock );
+        return VLC_EGENERIC;
+    }
+    id->worker.b_running = true;
+    return VLC_SUCCESS;
+}
+
+static void WorkerJoin( sout_stream_id_sys_t *id )
+{
+    if( !id->worker.b_running )
+        return;
+
+    vlc_join( id->worker.thread, NULL );
+    id->worker.b_running = false;
+    vlc_cond_destroy( &id->worker.wait_room );
+    vlc_cond_destroy( &id->worker.wait_data );
+    vlc_mutex_destroy( &id->worker.lock );
+}
+
+static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
+{
+    sout_stream_sys_t *p_sys = p_stream->p_sys;
+    sout_stream_id_sys_t *id = (sout_stream_id_sys_t *)_id;
+
+    if( id->worker.b_running )
+        return WorkerQueue( id, p_buffer );
+
+    if( id->b_error )
+        goto error;
+
+    if( !id->b_transcode )
+    {
+        if( id->downstream_id )
+        {
+            int i_ret;
+            vlc_mutex_lock( &p_sys->lock_downstream );
+            i_ret = sout_StreamIdSend( p_stream->p_next, id->downstream_id,
+                                       p_buffer );
+            vlc_mutex_unlock( &p_sys->lock_downstream );
+            return i_ret;
+        }
+        else
+            goto error;
+    }
+
+    return ProcessBlock( p_stream, id, p_buffer );
 error:
     if( p_buffer )
         block_Release( p_buffer );
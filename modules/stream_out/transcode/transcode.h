@@ -16,6 +16,7 @@ typedef struct
             char            *psz_deinterlace;
             config_chain_t  *p_deinterlace_cfg;
             char            *psz_spu_sources;
+            bool             b_pipeline;
         } video;
     };
 } sout_filters_config_t;
@@ -61,6 +62,10 @@ typedef struct
     bool            b_master_sync;
     sout_stream_id_sys_t *id_master_sync;
 
+    /* Parallel ES processing */
+    bool            b_parallel;
+    vlc_mutex_t     lock_downstream; /**< serializes sends to p_next */
+
 } sout_stream_sys_t;
 
 struct aout_filters;
@@ -99,6 +104,23 @@ struct sout_stream_id_sys_t
         };
     } fifo;
 
+    /* Worker thread decoupling this ES from the sout Send() caller.
+     * Only used for audio/video ES when the "parallel" option is set. */
+    struct
+    {
+        bool            b_running;
+        vlc_thread_t    thread;
+        sout_stream_t   *p_stream;
+        vlc_mutex_t     lock;
+        vlc_cond_t      wait_data;
+        vlc_cond_t      wait_room;
+        block_t         *first;
+        block_t         **last;
+        size_t          i_depth;
+        bool            b_eof;
+        int             i_error;
+    } worker;
+
     union
     {
         struct
@@ -325,6 +325,58 @@ static int conversion_video_filter_append( sout_stream_id_sys_t *id,
     return VLC_SUCCESS;
 }
 
+/* A pipelined chain must not be modified, so this may only run once the
+ * converters have been appended. Start the chain carrying the user filters,
+ * which is where the expensive stages sit. */
+static void transcode_video_pipeline_start( sout_stream_t *p_stream,
+                                            sout_stream_id_sys_t *id )
+{
+    filter_chain_t *p_chain = id->p_uf_chain ? id->p_uf_chain : id->p_f_chain;
+
+    if( p_chain == NULL || filter_chain_IsEmpty( p_chain ) )
+        return;
+
+    if( filter_chain_PipelineStart( p_chain ) == VLC_SUCCESS )
+        msg_Dbg( p_stream, "video filters running pipelined" );
+    else
+        msg_Warn( p_stream, "cannot pipeline video filters, "
+                            "filtering sequentially" );
+}
+
+
+/* Probe whether the encoder can consume the decoder output chroma as is
+ * (typically an opaque hardware surface), so that pictures reach the
+ * encoder without a readback converter. Only meaningful when no filter
+ * forces software pictures anyway. */
+static void transcode_video_try_direct_input( sout_stream_t *p_stream,
+                                              sout_stream_id_sys_t *id,
+                                              const video_format_t *p_src )
+{
+    sout_stream_sys_t *p_sys = p_stream->p_sys;
+    const es_format_t *p_enc_in = transcode_encoder_format_in( id->encoder );
+
+    if( p_src->i_chroma == p_enc_in->video.i_chroma )
+        return; /* already direct */
+
+    if( id->p_filterscfg->psz_filters ||
+        id->p_filterscfg->video.psz_deinterlace ||
+        id->p_filterscfg->video.psz_spu_sources ||
+        p_sys->b_soverlay || id->p_enccfg->video.fps.num > 0 )
+        return; /* a filter will need software pictures anyway */
+
+    es_format_t wanted;
+    es_format_Init( &wanted, VIDEO_ES, 0 );
+    if( transcode_encoder_test( VLC_OBJECT(p_stream), id->p_enccfg,
+                                &id->p_decoder->fmt_in,
+                                p_src->i_chroma, &wanted ) == VLC_SUCCESS &&
+        wanted.video.i_chroma == p_src->i_chroma )
+    {
+        msg_Dbg( p_stream, "encoder consumes chroma %4.4s directly, "
+                 "skipping conversion", (char *)&p_src->i_chroma );
+        transcode_encoder_update_format_in( id->encoder, &wanted );
+    }
+    es_format_Clean( &wanted );
+}
 
 void transcode_video_clean( sout_stream_t *p_stream,
                                    sout_stream_id_sys_t *id )
@@ -479,6 +531,8 @@ int transcode_video_process( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
         {
             if( !transcode_encoder_opened(id->encoder) ) /* Configure Encoder input/output */
             {
+                transcode_video_try_direct_input( p_stream, id,
+                                        filtered_video_format( id, p_pic ) );
                 transcode_encoder_video_configure( VLC_OBJECT(p_stream),
                                                    &id->p_decoder->fmt_in.video,
                                                    &id->p_decoder->fmt_out.video,
@@ -515,6 +569,8 @@ int transcode_video_process( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
                                              (id->p_enccfg->video.fps.num > 0), id );
                 if( conversion_video_filter_append( id, p_pic ) != VLC_SUCCESS )
                     goto error;
+                if( id->p_filterscfg->video.b_pipeline )
+                    transcode_video_pipeline_start( p_stream, id );
             }
 
             /* Start missing encoder */
@@ -1422,6 +1422,9 @@ static int Create( vlc_object_t *p_this )
         p_sys->p_stroker = NULL;
     }
 
+    /* Not fatal on failure: loading then simply is not cached */
+    p_sys->p_glyph_cache = GlyphCacheNew();
+
     /* Dictionnaries for fonts and families */
     vlc_dictionary_init( &p_sys->face_map, 50 );
     vlc_dictionary_init( &p_sys->family_map, 50 );
@@ -1551,6 +1554,9 @@ static void Destroy( vlc_object_t *p_this )
     text_style_Delete( p_sys->p_default_style );
     text_style_Delete( p_sys->p_forced_style );
 
+    /* Cached glyphs, before the faces they were loaded from */
+    GlyphCacheDelete( p_sys->p_glyph_cache );
+
     /* Fonts dicts */
     vlc_dictionary_clear( &p_sys->fallback_map, FreeFamilies, p_filter );
     vlc_dictionary_clear( &p_sys->face_map, FreeFace, p_filter );
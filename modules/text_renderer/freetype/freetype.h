@@ -73,12 +73,19 @@ typedef uint32_t uni_char_t;
  * It describes the freetype specific properties of an output thread.
  *****************************************************************************/
 typedef struct vlc_family_t vlc_family_t;
+typedef struct glyph_cache_entry_t glyph_cache_entry_t;
 typedef struct
 {
     FT_Library     p_library;       /* handle to library     */
     FT_Face        p_face;          /* handle to face object */
     FT_Stroker     p_stroker;       /* handle to path stroker object */
 
+    /**
+     * Cache of loaded (and stroked) glyph outlines, see text_layout.c.
+     * NULL if allocation failed; loading then always takes the slow path.
+     */
+    glyph_cache_entry_t *p_glyph_cache;
+
     text_style_t  *p_default_style;
     text_style_t  *p_forced_style;  /* Renderer overridings */
 
@@ -1011,6 +1011,121 @@ static int ZeroNsmAdvance( paragraph_t *p_paragraph )
 #endif
 #endif
 
+/**
+ * Direct-mapped cache of loaded glyphs, keyed by face, glyph index, the
+ * synthetic style transforms applied to the slot and the stroker radius.
+ * Face pointers are valid keys as faces are cached in filter_sys_t::face_map
+ * for the lifetime of the filter, one face per (file, index, size, width)
+ * combination, so the pointer also encodes the glyph size.
+ *
+ * Entries store the glyph after loading, emboldening/obliquing and stroking,
+ * but before rasterization: FT_Glyph_To_Bitmap() depends on the subpixel pen
+ * position of the glyph within its line. Copying an outline out of the cache
+ * is much cheaper than hinting and stroking it again, which is what
+ * dominates when the same text is laid out repeatedly (tickers, karaoke).
+ */
+struct glyph_cache_entry_t
+{
+    FT_Face  p_face;
+    FT_UInt  i_index;
+    FT_Fixed i_radius; /**< stroker radius, -1 if not outlined */
+    bool     b_bold;    /**< synthetic embolden applied */
+    bool     b_oblique; /**< synthetic oblique applied */
+    FT_Glyph p_glyph;   /**< NULL if the entry is empty */
+    FT_Glyph p_outline; /**< NULL if not outlined */
+    FT_Pos   i_x_advance; /**< 26.6 slot advance values */
+    FT_Pos   i_y_advance;
+};
+
+#define GLYPH_CACHE_SIZE 512 /* must be a power of two */
+
+glyph_cache_entry_t *GlyphCacheNew( void )
+{
+    return calloc( GLYPH_CACHE_SIZE, sizeof( glyph_cache_entry_t ) );
+}
+
+void GlyphCacheDelete( glyph_cache_entry_t *p_cache )
+{
+    if( !p_cache )
+        return;
+    for( size_t i = 0; i < GLYPH_CACHE_SIZE; ++i )
+    {
+        if( p_cache[i].p_glyph )
+            FT_Done_Glyph( p_cache[i].p_glyph );
+        if( p_cache[i].p_outline )
+            FT_Done_Glyph( p_cache[i].p_outline );
+    }
+    free( p_cache );
+}
+
+static glyph_cache_entry_t *GlyphCacheSlot( glyph_cache_entry_t *p_cache,
+                                            FT_Face p_face, FT_UInt i_index,
+                                            bool b_bold, bool b_oblique,
+                                            FT_Fixed i_radius )
+{
+    uintptr_t i_hash = ( uintptr_t )p_face >> 4;
+    i_hash = i_hash * 31 + i_index;
+    i_hash = i_hash * 31 + ( uintptr_t )i_radius;
+    i_hash = i_hash * 2 + b_bold;
+    i_hash = i_hash * 2 + b_oblique;
+    return p_cache + ( i_hash & ( GLYPH_CACHE_SIZE - 1 ) );
+}
+
+static glyph_cache_entry_t *GlyphCacheFind( glyph_cache_entry_t *p_cache,
+                                            FT_Face p_face, FT_UInt i_index,
+                                            bool b_bold, bool b_oblique,
+                                            FT_Fixed i_radius )
+{
+    if( !p_cache )
+        return NULL;
+
+    glyph_cache_entry_t *p_entry =
+        GlyphCacheSlot( p_cache, p_face, i_index, b_bold, b_oblique, i_radius );
+    if( p_entry->p_glyph && p_entry->p_face == p_face
+     && p_entry->i_index == i_index && p_entry->i_radius == i_radius
+     && p_entry->b_bold == b_bold && p_entry->b_oblique == b_oblique )
+        return p_entry;
+    return NULL;
+}
+
+static void GlyphCacheStore( glyph_cache_entry_t *p_cache,
+                             FT_Face p_face, FT_UInt i_index,
+                             bool b_bold, bool b_oblique, FT_Fixed i_radius,
+                             FT_Glyph p_glyph, FT_Glyph p_outline,
+                             FT_Pos i_x_advance, FT_Pos i_y_advance )
+{
+    if( !p_cache )
+        return;
+
+    FT_Glyph p_glyph_copy;
+    if( FT_Glyph_Copy( p_glyph, &p_glyph_copy ) )
+        return;
+    FT_Glyph p_outline_copy = NULL;
+    if( p_outline && FT_Glyph_Copy( p_outline, &p_outline_copy ) )
+    {
+        FT_Done_Glyph( p_glyph_copy );
+        return;
+    }
+
+    /* Direct-mapped: evict whatever collides */
+    glyph_cache_entry_t *p_entry =
+        GlyphCacheSlot( p_cache, p_face, i_index, b_bold, b_oblique, i_radius );
+    if( p_entry->p_glyph )
+        FT_Done_Glyph( p_entry->p_glyph );
+    if( p_entry->p_outline )
+        FT_Done_Glyph( p_entry->p_outline );
+
+    p_entry->p_face = p_face;
+    p_entry->i_index = i_index;
+    p_entry->i_radius = i_radius;
+    p_entry->b_bold = b_bold;
+    p_entry->b_oblique = b_oblique;
+    p_entry->p_glyph = p_glyph_copy;
+    p_entry->p_outline = p_outline_copy;
+    p_entry->i_x_advance = i_x_advance;
+    p_entry->i_y_advance = i_y_advance;
+}
+
 /**
  * Load the glyphs of a paragraph. When shaping with HarfBuzz the glyph indices
  * have already been determined at this point, as well as the advance values.
@@ -1053,12 +1168,13 @@ static int LoadGlyphs( filter_t *p_filter, paragraph_t *p_paragraph,
         else
             p_face = p_run->p_face;
 
+        FT_Fixed i_radius = -1; /* -1: no outline requested */
         if( p_sys->p_stroker && (p_style->i_style_flags & STYLE_OUTLINE) )
         {
             double f_outline_thickness =
                 var_InheritInteger( p_filter, "freetype-outline-thickness" ) / 100.0;
             f_outline_thickness = VLC_CLIP( f_outline_thickness, 0.0, 0.5 );
-            int i_radius = ( i_live_size << 6 ) * f_outline_thickness;
+            i_radius = ( i_live_size << 6 ) * f_outline_thickness;
             FT_Stroker_Set( p_sys->p_stroker,
                             i_radius,
                             FT_STROKER_LINECAP_ROUND,
@@ -1115,41 +1231,72 @@ static int LoadGlyphs( filter_t *p_filter, paragraph_t *p_paragraph,
                     SKIP_GLYPH( p_bitmaps )
             }
 
-            if( FT_Load_Glyph( p_face, i_glyph_index,
-                               FT_LOAD_NO_BITMAP | FT_LOAD_DEFAULT )
-             && FT_Load_Glyph( p_face, i_glyph_index, FT_LOAD_DEFAULT ) )
-                SKIP_GLYPH( p_bitmaps )
+            bool b_synth_bold = ( p_style->i_style_flags & STYLE_BOLD )
+                  && !( p_face->style_flags & FT_STYLE_FLAG_BOLD );
+            bool b_synth_oblique = ( p_style->i_style_flags & STYLE_ITALIC )
+                  && !( p_face->style_flags & FT_STYLE_FLAG_ITALIC );
 
-            if( ( p_style->i_style_flags & STYLE_BOLD )
-                  && !( p_face->style_flags & FT_STYLE_FLAG_BOLD ) )
-                FT_GlyphSlot_Embolden( p_face->glyph );
-            if( ( p_style->i_style_flags & STYLE_ITALIC )
-                  && !( p_face->style_flags & FT_STYLE_FLAG_ITALIC ) )
-                FT_GlyphSlot_Oblique( p_face->glyph );
-
-            if( FT_Get_Glyph( p_face->glyph, &p_bitmaps->p_glyph ) )
-                SKIP_GLYPH( p_bitmaps )
+            glyph_cache_entry_t *p_cached =
+                GlyphCacheFind( p_sys->p_glyph_cache, p_face, i_glyph_index,
+                                b_synth_bold, b_synth_oblique, i_radius );
+            if( p_cached )
+            {
+                if( FT_Glyph_Copy( p_cached->p_glyph, &p_bitmaps->p_glyph ) )
+                    SKIP_GLYPH( p_bitmaps )
 
-#undef SKIP_GLYPH
+                if( p_cached->p_outline
+                 && FT_Glyph_Copy( p_cached->p_outline,
+                                   &p_bitmaps->p_outline ) )
+                    p_bitmaps->p_outline = 0;
 
-            if( p_sys->p_stroker && (p_style->i_style_flags & STYLE_OUTLINE) )
+                if( b_overwrite_advance )
+                {
+                    p_bitmaps->i_x_advance = p_cached->i_x_advance;
+                    p_bitmaps->i_y_advance = p_cached->i_y_advance;
+                }
+            }
+            else
             {
-                p_bitmaps->p_outline = p_bitmaps->p_glyph;
-                if( FT_Glyph_StrokeBorder( &p_bitmaps->p_outline,
-                                           p_sys->p_stroker, 0, 0 ) )
-                    p_bitmaps->p_outline = 0;
+                if( FT_Load_Glyph( p_face, i_glyph_index,
+                                   FT_LOAD_NO_BITMAP | FT_LOAD_DEFAULT )
+                 && FT_Load_Glyph( p_face, i_glyph_index, FT_LOAD_DEFAULT ) )
+                    SKIP_GLYPH( p_bitmaps )
+
+                if( b_synth_bold )
+                    FT_GlyphSlot_Embolden( p_face->glyph );
+                if( b_synth_oblique )
+                    FT_GlyphSlot_Oblique( p_face->glyph );
+
+                if( FT_Get_Glyph( p_face->glyph, &p_bitmaps->p_glyph ) )
+                    SKIP_GLYPH( p_bitmaps )
+
+                if( i_radius >= 0 )
+                {
+                    p_bitmaps->p_outline = p_bitmaps->p_glyph;
+                    if( FT_Glyph_StrokeBorder( &p_bitmaps->p_outline,
+                                               p_sys->p_stroker, 0, 0 ) )
+                        p_bitmaps->p_outline = 0;
+                }
+
+                GlyphCacheStore( p_sys->p_glyph_cache, p_face, i_glyph_index,
+                                 b_synth_bold, b_synth_oblique, i_radius,
+                                 p_bitmaps->p_glyph, p_bitmaps->p_outline,
+                                 p_face->glyph->advance.x,
+                                 p_face->glyph->advance.y );
+
+                if( b_overwrite_advance )
+                {
+                    p_bitmaps->i_x_advance = p_face->glyph->advance.x;
+                    p_bitmaps->i_y_advance = p_face->glyph->advance.y;
+                }
             }
 
+#undef SKIP_GLYPH
+
             if( p_style->i_shadow_alpha != STYLE_ALPHA_TRANSPARENT )
                 p_bitmaps->p_shadow = p_bitmaps->p_outline ?
                                       p_bitmaps->p_outline : p_bitmaps->p_glyph;
 
-            if( b_overwrite_advance )
-            {
-                p_bitmaps->i_x_advance = p_face->glyph->advance.x;
-                p_bitmaps->i_y_advance = p_face->glyph->advance.y;
-            }
-
             unsigned i_x_advance = FT_FLOOR( p_bitmaps->i_x_advance );
             if( i_x_advance > *pi_max_advance_x )
                 *pi_max_advance_x = i_x_advance;
@@ -65,6 +65,15 @@ struct line_desc_t
 void FreeLines( line_desc_t *p_lines );
 line_desc_t *NewLine( int i_count );
 
+/**
+ * Allocate the glyph cache, mapping (face, glyph index, synthetic styles,
+ * outline radius) to loaded and stroked glyph outlines so that repeated
+ * renderings of the same text skip FT_Load_Glyph() and the stroker.
+ * May return NULL, in which case glyph loading simply is not cached.
+ */
+glyph_cache_entry_t *GlyphCacheNew( void );
+void GlyphCacheDelete( glyph_cache_entry_t *p_cache );
+
 /**
  * \struct layout_ruby_t
  * \brief LayoutText parameters
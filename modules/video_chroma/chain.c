@@ -29,6 +29,8 @@
 # include "config.h"
 #endif
 
+#include <limits.h>
+
 #include <vlc_common.h>
 #include <vlc_plugin.h>
 #include <vlc_filter.h>
@@ -111,6 +113,77 @@ static const vlc_fourcc_t *get_allowed_chromas( filter_t *p_filter )
     }
 }
 
+/* Rough relative cost of going through a given middle chroma, used to rank
+ * the candidates instead of taking them in enumeration order. The weights
+ * only need to order correctly the cases the allowed lists can produce:
+ * memory traffic through the intermediate picture, a heavy penalty for a
+ * pointless YUV->RGB->YUV (or the converse) matrixing round trip, and a
+ * smaller one for truncating the bit depth in the middle. */
+static unsigned ChromaCost( const video_format_t *p_in,
+                            const video_format_t *p_out, vlc_fourcc_t i_mid )
+{
+    const vlc_chroma_description_t *p_mid =
+        vlc_fourcc_GetChromaDescription( i_mid );
+    if( unlikely(p_mid == NULL) )
+        return UINT_MAX;
+
+    /* Bytes per 16 pixels stored into, then read back from, the
+     * intermediate picture */
+    unsigned i_cost = 0;
+    for( unsigned i = 0; i < p_mid->plane_count; i++ )
+        i_cost += 16 * p_mid->p[i].w.num * p_mid->p[i].h.num
+                * p_mid->pixel_size / ( p_mid->p[i].w.den * p_mid->p[i].h.den );
+
+    const bool b_yuv_in  = vlc_fourcc_IsYUV( p_in->i_chroma );
+    const bool b_yuv_out = vlc_fourcc_IsYUV( p_out->i_chroma );
+    const bool b_yuv_mid = vlc_fourcc_IsYUV( i_mid );
+    if( b_yuv_in == b_yuv_out && b_yuv_mid != b_yuv_in )
+        i_cost += 256;
+
+    /* pixel_bits is per component for YUV but per pixel for RGB, so only
+     * compare the middle depth against endpoints of the same family */
+    const vlc_chroma_description_t *p_dsc;
+    unsigned i_bits = 0;
+    if( b_yuv_in == b_yuv_mid
+     && ( p_dsc = vlc_fourcc_GetChromaDescription( p_in->i_chroma ) ) )
+        i_bits = p_dsc->pixel_bits;
+    if( b_yuv_out == b_yuv_mid
+     && ( p_dsc = vlc_fourcc_GetChromaDescription( p_out->i_chroma ) )
+     && p_dsc->pixel_bits > i_bits )
+        i_bits = p_dsc->pixel_bits;
+    if( p_mid->pixel_bits < i_bits )
+        i_cost += 128;
+
+    return i_cost;
+}
+
+/* Copy the allowed chromas ordered by increasing estimated cost. The sort is
+ * stable so candidates the model cannot separate keep their enumeration
+ * order. */
+static size_t SortChromasByCost( filter_t *p_filter,
+                                 const vlc_fourcc_t *pi_allowed,
+                                 vlc_fourcc_t *pi_sorted, size_t i_max )
+{
+    size_t i_count = 0;
+    for( size_t i = 0; pi_allowed[i] != 0 && i_count < i_max; i++ )
+    {
+        const vlc_fourcc_t i_chroma = pi_allowed[i];
+        const unsigned i_cost = ChromaCost( &p_filter->fmt_in.video,
+                                            &p_filter->fmt_out.video, i_chroma );
+        size_t j = i_count;
+        while( j > 0 && ChromaCost( &p_filter->fmt_in.video,
+                                    &p_filter->fmt_out.video,
+                                    pi_sorted[j - 1] ) > i_cost )
+        {
+            pi_sorted[j] = pi_sorted[j - 1];
+            j--;
+        }
+        pi_sorted[j] = i_chroma;
+        i_count++;
+    }
+    return i_count;
+}
+
 typedef struct
 {
     filter_chain_t *p_chain;
@@ -325,11 +398,15 @@ static int BuildChromaChain( filter_t *p_filter )
     es_format_t fmt_mid;
     int i_ret = VLC_EGENERIC;
 
-    /* Now try chroma format list */
-    const vlc_fourcc_t *pi_allowed_chromas = get_allowed_chromas( p_filter );
-    for( int i = 0; pi_allowed_chromas[i]; i++ )
+    /* Now try chroma format list, cheapest middle man first */
+    vlc_fourcc_t pi_sorted_chromas[8];
+    const size_t i_count = SortChromasByCost( p_filter,
+                                              get_allowed_chromas( p_filter ),
+                                              pi_sorted_chromas,
+                                              ARRAY_SIZE(pi_sorted_chromas) );
+    for( size_t i = 0; i < i_count; i++ )
     {
-        const vlc_fourcc_t i_chroma = pi_allowed_chromas[i];
+        const vlc_fourcc_t i_chroma = pi_sorted_chromas[i];
         if( i_chroma == p_filter->fmt_in.i_codec ||
             i_chroma == p_filter->fmt_out.i_codec )
             continue;
@@ -349,7 +426,14 @@ static int BuildChromaChain( filter_t *p_filter )
         es_format_Clean( &fmt_mid );
 
         if( i_ret == VLC_SUCCESS )
+        {
+            msg_Dbg( p_filter, "Built chain %4.4s -> %4.4s -> %4.4s (cost %u)",
+                     (char*)&p_filter->fmt_in.i_codec, (char*)&i_chroma,
+                     (char*)&p_filter->fmt_out.i_codec,
+                     ChromaCost( &p_filter->fmt_in.video,
+                                 &p_filter->fmt_out.video, i_chroma ) );
             break;
+        }
     }
 
     return i_ret;
@@ -370,13 +454,17 @@ static int BuildFilterChain( filter_t *p_filter )
 
     filter_sys_t *p_sys = p_filter->p_sys;
 
-    /* Now try chroma format list */
-    const vlc_fourcc_t *pi_allowed_chromas = get_allowed_chromas( p_filter );
-    for( int i = 0; pi_allowed_chromas[i]; i++ )
+    /* Now try chroma format list, cheapest middle man first */
+    vlc_fourcc_t pi_sorted_chromas[8];
+    const size_t i_count = SortChromasByCost( p_filter,
+                                              get_allowed_chromas( p_filter ),
+                                              pi_sorted_chromas,
+                                              ARRAY_SIZE(pi_sorted_chromas) );
+    for( size_t i = 0; i < i_count; i++ )
     {
         filter_chain_Reset( p_sys->p_chain, &p_filter->fmt_in, &p_filter->fmt_out );
 
-        const vlc_fourcc_t i_chroma = pi_allowed_chromas[i];
+        const vlc_fourcc_t i_chroma = pi_sorted_chromas[i];
         if( i_chroma == p_filter->fmt_in.i_codec ||
             i_chroma == p_filter->fmt_out.i_codec )
             continue;
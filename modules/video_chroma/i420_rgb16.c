@@ -118,11 +118,15 @@ void I420_RGB16( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
     bool  b_hscale;                         /* horizontal scaling type */
     unsigned int i_vscale;                          /* vertical scaling type */
     unsigned int i_x, i_y;                /* horizontal and vertical indexes */
+    const unsigned i_width  = p_filter->fmt_in.video.i_x_offset
+                         + p_filter->fmt_in.video.i_visible_width;
+    const unsigned i_height = p_filter->fmt_in.video.i_y_offset
+                         + p_filter->fmt_in.video.i_visible_height;
 
     int         i_right_margin;
     int         i_rewind;
     int         i_scale_count;                       /* scale modulo counter */
-    int         i_chroma_width = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 2; /* chroma width */
+    int         i_chroma_width = i_width / 2; /* chroma width */
     uint16_t *  p_pic_start;       /* beginning of the current line for copy */
     int         i_uval, i_vval;                           /* U and V samples */
     int         i_red, i_green, i_blue;          /* U and V modified samples */
@@ -145,13 +149,13 @@ void I420_RGB16( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
                                  - ( p_filter->fmt_in.video.i_x_offset / 2 );
 
     i_right_margin = p_dest->p->i_pitch - p_dest->p->i_visible_pitch;
-    i_rewind = (-(p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width)) & 7;
+    i_rewind = (-i_width) & 7;
 
     /* Rule: when a picture of size (x1,y1) with aspect ratio r1 is rendered
      * on a picture of size (x2,y2) with aspect ratio r2, if x1 grows to x1'
      * then y1 grows to y1' = x1' * y2/x2 * r2/r1 */
-    SetOffset( (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width),
-               (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height),
+    SetOffset( i_width,
+               i_height,
                (p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width),
                (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height),
                &b_hscale, &i_vscale, p_offset_start );
@@ -161,13 +165,13 @@ void I420_RGB16( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
      */
     i_scale_count = ( i_vscale == 1 ) ?
                     (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height) :
-                    (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height);
-    for( i_y = 0; i_y < (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height); i_y++ )
+                    i_height;
+    for( i_y = 0; i_y < i_height; i_y++ )
     {
         p_pic_start = p_pic;
         p_buffer = b_hscale ? p_buffer_start : p_pic;
 
-        for ( i_x = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 8; i_x--; )
+        for ( i_x = i_width / 8; i_x--; )
         {
             CONVERT_YUV_PIXEL(2);  CONVERT_Y_PIXEL(2);
             CONVERT_YUV_PIXEL(2);  CONVERT_Y_PIXEL(2);
@@ -225,11 +229,15 @@ void I420_RGB32( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
     bool  b_hscale;                         /* horizontal scaling type */
     unsigned int i_vscale;                          /* vertical scaling type */
     unsigned int i_x, i_y;                /* horizontal and vertical indexes */
+    const unsigned i_width  = p_filter->fmt_in.video.i_x_offset
+                         + p_filter->fmt_in.video.i_visible_width;
+    const unsigned i_height = p_filter->fmt_in.video.i_y_offset
+                         + p_filter->fmt_in.video.i_visible_height;
 
     int         i_right_margin;
     int         i_rewind;
     int         i_scale_count;                       /* scale modulo counter */
-    int         i_chroma_width = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 2; /* chroma width */
+    int         i_chroma_width = i_width / 2; /* chroma width */
     uint32_t *  p_pic_start;       /* beginning of the current line for copy */
     int         i_uval, i_vval;                           /* U and V samples */
     int         i_red, i_green, i_blue;          /* U and V modified samples */
@@ -252,13 +260,13 @@ void I420_RGB32( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
                                  - ( p_filter->fmt_in.video.i_x_offset / 2 );
 
     i_right_margin = p_dest->p->i_pitch - p_dest->p->i_visible_pitch;
-    i_rewind = (-(p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width)) & 7;
+    i_rewind = (-i_width) & 7;
 
     /* Rule: when a picture of size (x1,y1) with aspect ratio r1 is rendered
      * on a picture of size (x2,y2) with aspect ratio r2, if x1 grows to x1'
      * then y1 grows to y1' = x1' * y2/x2 * r2/r1 */
-    SetOffset( (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width),
-               (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height),
+    SetOffset( i_width,
+               i_height,
                (p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width),
                (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height),
                &b_hscale, &i_vscale, p_offset_start );
@@ -268,13 +276,13 @@ void I420_RGB32( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
      */
     i_scale_count = ( i_vscale == 1 ) ?
                     (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height) :
-                    (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height);
-    for( i_y = 0; i_y < (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height); i_y++ )
+                    i_height;
+    for( i_y = 0; i_y < i_height; i_y++ )
     {
         p_pic_start = p_pic;
         p_buffer = b_hscale ? p_buffer_start : p_pic;
 
-        for ( i_x = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 8; i_x--; )
+        for ( i_x = i_width / 8; i_x--; )
         {
             CONVERT_YUV_PIXEL(4);  CONVERT_Y_PIXEL(4);
             CONVERT_YUV_PIXEL(4);  CONVERT_Y_PIXEL(4);
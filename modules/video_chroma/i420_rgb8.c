@@ -54,10 +54,14 @@ void I420_RGB8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
     bool  b_hscale;                         /* horizontal scaling type */
     int i_vscale;                                 /* vertical scaling type */
     unsigned int i_x, i_y;                /* horizontal and vertical indexes */
+    const unsigned i_width  = p_filter->fmt_in.video.i_x_offset
+                         + p_filter->fmt_in.video.i_visible_width;
+    const unsigned i_height = p_filter->fmt_in.video.i_y_offset
+                         + p_filter->fmt_in.video.i_visible_height;
     unsigned int i_real_y;                                          /* y % 4 */
     int          i_right_margin;
     int          i_scale_count;                      /* scale modulo counter */
-    unsigned int i_chroma_width = (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width) / 2;/* chroma width */
+    unsigned int i_chroma_width = i_width / 2;/* chroma width */
 
     /* Lookup table */
     uint8_t *        p_lookup = p_sys->p_base;
@@ -84,8 +88,8 @@ void I420_RGB8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
     static const int dither22[4] = {  0x6, 0x16,  0x2, 0x12 };
     static const int dither23[4] = { 0x1e,  0xe, 0x1a,  0xa };
 
-    SetOffset( (p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width),
-               (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height),
+    SetOffset( i_width,
+               i_height,
                (p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width),
                (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height),
                &b_hscale, &i_vscale, p_offset_start );
@@ -97,8 +101,8 @@ void I420_RGB8( filter_t *p_filter, picture_t *p_src, picture_t *p_dest )
      */
     i_scale_count = ( i_vscale == 1 ) ?
                     (p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height) :
-                    (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height);
-    for( i_y = 0, i_real_y = 0; i_y < (p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height); i_y++ )
+                    i_height;
+    for( i_y = 0, i_real_y = 0; i_y < i_height; i_y++ )
     {
         /* Do horizontal and vertical scaling */
         SCALE_WIDTH_DITHER( 420 );
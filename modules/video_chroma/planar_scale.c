@@ -0,0 +1,505 @@
+/*****************************************************************************
+ * planar_scale.c: native downscaler for planar/semiplanar 4:2:0 YUV
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/* Separable polyphase downscaler for the formats the decoders actually
+ * output (I420 family and NV12/NV21), meant to take the common
+ * 4K -> 1080p and 1080p -> 720p paths away from the generic swscale
+ * wrapper. All filter taps are precomputed at Open() into fixed-point
+ * tables; the horizontal and vertical passes are fused through a ring of
+ * four scaled lines, so no intermediate picture is ever written. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include <vlc_cpu.h>
+
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+# include <immintrin.h>
+#endif
+
+/****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static int  OpenScaler( vlc_object_t * );
+static void CloseScaler( vlc_object_t * );
+static picture_t *Filter( filter_t *, picture_t * );
+
+/*****************************************************************************
+ * Module descriptor
+ *****************************************************************************/
+vlc_module_begin ()
+    set_description( N_("Planar YUV downscaling filter") )
+    set_capability( "video converter", 160 )
+    set_callbacks( OpenScaler, CloseScaler )
+vlc_module_end ()
+
+/*****************************************************************************
+ * Filter tap tables
+ *****************************************************************************/
+
+#define SCALE_SHIFT 7
+#define SCALE_UNIT  (1 << SCALE_SHIFT)
+#define SCALE_TAPS  4
+
+/* One output sample: SCALE_TAPS consecutive source samples starting at
+ * i_offset, weighted with w[] summing exactly to SCALE_UNIT. */
+struct scale_tap
+{
+    int      i_offset;
+    uint16_t w[SCALE_TAPS];
+};
+
+/* A tent filter widened to the scaling ratio: plain bilinear at 1:1,
+ * converging to an area average for strong downscales, so no source
+ * sample is dropped like nearest/bilinear decimation would. */
+static struct scale_tap *BuildTaps( unsigned i_dst, unsigned i_src )
+{
+    struct scale_tap *p_taps = vlc_alloc( i_dst, sizeof( *p_taps ) );
+    if( unlikely(p_taps == NULL) )
+        return NULL;
+
+    const double f_ratio = (double)i_src / i_dst;
+    const double f_support = f_ratio > 1. ? f_ratio : 1.;
+
+    for( unsigned x = 0; x < i_dst; x++ )
+    {
+        const double f_center = ( x + 0.5 ) * f_ratio - 0.5;
+        int i_first = (int)floor( f_center ) - SCALE_TAPS / 2 + 1;
+        if( i_first < 0 )
+            i_first = 0;
+        if( i_first > (int)i_src - SCALE_TAPS )
+            i_first = i_src - SCALE_TAPS;
+
+        double w[SCALE_TAPS], f_sum = 0.;
+        for( int i = 0; i < SCALE_TAPS; i++ )
+        {
+            const double d = fabs( ( i_first + i - f_center ) / f_support );
+            w[i] = d < 1. ? 1. - d : 0.;
+            f_sum += w[i];
+        }
+        if( f_sum <= 0. ) /* cannot happen with support >= 1, be safe */
+        {
+            w[SCALE_TAPS / 2 - 1] = 1.;
+            f_sum = 1.;
+        }
+
+        p_taps[x].i_offset = i_first;
+        int i_sum = 0, i_largest = 0;
+        for( int i = 0; i < SCALE_TAPS; i++ )
+        {
+            p_taps[x].w[i] = (uint16_t)lround( w[i] * SCALE_UNIT / f_sum );
+            i_sum += p_taps[x].w[i];
+            if( p_taps[x].w[i] > p_taps[x].w[i_largest] )
+                i_largest = i;
+        }
+        /* Put the rounding residue on the largest tap */
+        p_taps[x].w[i_largest] += SCALE_UNIT - i_sum;
+    }
+    return p_taps;
+}
+
+/*****************************************************************************
+ * Scaling kernels
+ *****************************************************************************/
+
+/* Horizontal pass: source samples i_step apart (2 for one component of an
+ * interleaved NV chroma plane), output packed. */
+static void ScaleLineH( uint8_t *dst, const uint8_t *src,
+                        const struct scale_tap *taps,
+                        unsigned i_width, unsigned i_step )
+{
+    for( unsigned x = 0; x < i_width; x++ )
+    {
+        const struct scale_tap *t = &taps[x];
+        const uint8_t *s = &src[t->i_offset * i_step];
+        unsigned v = s[0]          * t->w[0] + s[i_step]     * t->w[1]
+                   + s[2 * i_step] * t->w[2] + s[3 * i_step] * t->w[3];
+        dst[x] = ( v + SCALE_UNIT / 2 ) >> SCALE_SHIFT;
+    }
+}
+
+typedef void (*vscale_fn)( uint8_t *dst, const uint8_t *const lines[SCALE_TAPS],
+                           const uint16_t w[SCALE_TAPS], unsigned i_width );
+
+static void ScaleLineV_C( uint8_t *dst, const uint8_t *const lines[SCALE_TAPS],
+                          const uint16_t w[SCALE_TAPS], unsigned i_width )
+{
+    for( unsigned x = 0; x < i_width; x++ )
+    {
+        unsigned v = lines[0][x] * w[0] + lines[1][x] * w[1]
+                   + lines[2][x] * w[2] + lines[3][x] * w[3];
+        dst[x] = ( v + SCALE_UNIT / 2 ) >> SCALE_SHIFT;
+    }
+}
+
+#ifdef HAVE_SSE2_INTRINSICS
+/* Weights sum to 128, so every 16-bit lane stays below 255 * 128 and the
+ * whole accumulation fits unsigned 16-bit. */
+__attribute__ ((__target__ ("sse2")))
+static void ScaleLineV_SSE2( uint8_t *dst,
+                             const uint8_t *const lines[SCALE_TAPS],
+                             const uint16_t w[SCALE_TAPS], unsigned i_width )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16( SCALE_UNIT / 2 );
+    unsigned x = 0;
+
+    for( ; x + 15 < i_width; x += 16 )
+    {
+        __m128i lo = round, hi = round;
+        for( int t = 0; t < SCALE_TAPS; t++ )
+        {
+            const __m128i wt = _mm_set1_epi16( w[t] );
+            const __m128i v = _mm_loadu_si128( (const __m128i *)&lines[t][x] );
+            lo = _mm_add_epi16( lo,
+                    _mm_mullo_epi16( _mm_unpacklo_epi8( v, zero ), wt ) );
+            hi = _mm_add_epi16( hi,
+                    _mm_mullo_epi16( _mm_unpackhi_epi8( v, zero ), wt ) );
+        }
+        lo = _mm_srli_epi16( lo, SCALE_SHIFT );
+        hi = _mm_srli_epi16( hi, SCALE_SHIFT );
+        _mm_storeu_si128( (__m128i *)&dst[x], _mm_packus_epi16( lo, hi ) );
+    }
+
+    if( x < i_width )
+    {
+        const uint8_t *tail[SCALE_TAPS] = {
+            &lines[0][x], &lines[1][x], &lines[2][x], &lines[3][x],
+        };
+        ScaleLineV_C( &dst[x], tail, w, i_width - x );
+    }
+}
+#endif
+
+#ifdef HAVE_AVX2_INTRINSICS
+__attribute__ ((__target__ ("avx2")))
+static void ScaleLineV_AVX2( uint8_t *dst,
+                             const uint8_t *const lines[SCALE_TAPS],
+                             const uint16_t w[SCALE_TAPS], unsigned i_width )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16( SCALE_UNIT / 2 );
+    unsigned x = 0;
+
+    for( ; x + 31 < i_width; x += 32 )
+    {
+        __m256i lo = round, hi = round;
+        for( int t = 0; t < SCALE_TAPS; t++ )
+        {
+            const __m256i wt = _mm256_set1_epi16( w[t] );
+            const __m256i v =
+                _mm256_loadu_si256( (const __m256i *)&lines[t][x] );
+            lo = _mm256_add_epi16( lo,
+                    _mm256_mullo_epi16( _mm256_unpacklo_epi8( v, zero ), wt ) );
+            hi = _mm256_add_epi16( hi,
+                    _mm256_mullo_epi16( _mm256_unpackhi_epi8( v, zero ), wt ) );
+        }
+        lo = _mm256_srli_epi16( lo, SCALE_SHIFT );
+        hi = _mm256_srli_epi16( hi, SCALE_SHIFT );
+        /* unpack/pack are per 128-bit lane, so this restores the order */
+        _mm256_storeu_si256( (__m256i *)&dst[x],
+                             _mm256_packus_epi16( lo, hi ) );
+    }
+
+    if( x < i_width )
+    {
+        const uint8_t *tail[SCALE_TAPS] = {
+            &lines[0][x], &lines[1][x], &lines[2][x], &lines[3][x],
+        };
+        ScaleLineV_C( &dst[x], tail, w, i_width - x );
+    }
+}
+#endif
+
+/* Vertical pass writing one component of an interleaved NV chroma plane */
+static void ScaleLineV_Step2( uint8_t *dst,
+                              const uint8_t *const lines[SCALE_TAPS],
+                              const uint16_t w[SCALE_TAPS], unsigned i_width )
+{
+    for( unsigned x = 0; x < i_width; x++ )
+    {
+        unsigned v = lines[0][x] * w[0] + lines[1][x] * w[1]
+                   + lines[2][x] * w[2] + lines[3][x] * w[3];
+        dst[2 * x] = ( v + SCALE_UNIT / 2 ) >> SCALE_SHIFT;
+    }
+}
+
+/*****************************************************************************
+ * Filter state
+ *****************************************************************************/
+
+/* One scaled component: a whole plane for planar formats, the U or V
+ * half of the interleaved plane for NV12/NV21. */
+struct scale_plane
+{
+    unsigned i_pic_plane; /**< picture plane index */
+    unsigned i_step;      /**< sample distance: 1 planar, 2 interleaved */
+    unsigned i_comp;      /**< byte offset inside an interleaved pair */
+
+    unsigned i_src_width, i_src_height;
+    unsigned i_dst_width, i_dst_height;
+
+    struct scale_tap *p_htaps; /**< i_dst_width entries */
+    struct scale_tap *p_vtaps; /**< i_dst_height entries */
+
+    /* Fused-pass state: ring of horizontally scaled source rows */
+    uint8_t *p_lines[SCALE_TAPS];
+    int      pi_cached[SCALE_TAPS]; /**< source row held in each slot */
+};
+
+typedef struct
+{
+    unsigned i_planes;
+    struct scale_plane plane[4];
+    vscale_fn pf_vscale; /**< packed (step 1) vertical kernel */
+} filter_sys_t;
+
+static void ScalePlane( struct scale_plane *p_plane, vscale_fn pf_vscale,
+                        const plane_t *p_src, plane_t *p_dst )
+{
+    const uint8_t *p_src_pixels = p_src->p_pixels + p_plane->i_comp;
+    uint8_t *p_dst_pixels = p_dst->p_pixels + p_plane->i_comp;
+
+    for( int i = 0; i < SCALE_TAPS; i++ )
+        p_plane->pi_cached[i] = -1;
+
+    for( unsigned y = 0; y < p_plane->i_dst_height; y++ )
+    {
+        const struct scale_tap *t = &p_plane->p_vtaps[y];
+        const uint8_t *lines[SCALE_TAPS];
+
+        for( int i = 0; i < SCALE_TAPS; i++ )
+        {
+            const int i_row = t->i_offset + i;
+            const int i_slot = i_row % SCALE_TAPS;
+            if( p_plane->pi_cached[i_slot] != i_row )
+            {
+                ScaleLineH( p_plane->p_lines[i_slot],
+                            &p_src_pixels[i_row * p_src->i_pitch],
+                            p_plane->p_htaps, p_plane->i_dst_width,
+                            p_plane->i_step );
+                p_plane->pi_cached[i_slot] = i_row;
+            }
+            lines[i] = p_plane->p_lines[i_slot];
+        }
+
+        if( p_plane->i_step == 1 )
+            pf_vscale( &p_dst_pixels[y * p_dst->i_pitch], lines, t->w,
+                       p_plane->i_dst_width );
+        else
+            ScaleLineV_Step2( &p_dst_pixels[y * p_dst->i_pitch], lines, t->w,
+                              p_plane->i_dst_width );
+    }
+}
+
+/****************************************************************************
+ * Filter: the whole thing
+ ****************************************************************************/
+static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    if( !p_pic )
+        return NULL;
+
+    picture_t *p_pic_dst = filter_NewPicture( p_filter );
+    if( !p_pic_dst )
+    {
+        picture_Release( p_pic );
+        return NULL;
+    }
+
+    for( unsigned i = 0; i < p_sys->i_planes; i++ )
+    {
+        struct scale_plane *p_plane = &p_sys->plane[i];
+        ScalePlane( p_plane, p_sys->pf_vscale,
+                    &p_pic->p[p_plane->i_pic_plane],
+                    &p_pic_dst->p[p_plane->i_pic_plane] );
+    }
+
+    picture_CopyProperties( p_pic_dst, p_pic );
+    picture_Release( p_pic );
+    return p_pic_dst;
+}
+
+/*****************************************************************************
+ * OpenScaler: probe the filter and init the tap tables
+ *****************************************************************************/
+static int InitPlane( struct scale_plane *p_plane,
+                      unsigned i_pic_plane, unsigned i_step, unsigned i_comp,
+                      unsigned i_src_width, unsigned i_src_height,
+                      unsigned i_dst_width, unsigned i_dst_height )
+{
+    p_plane->i_pic_plane = i_pic_plane;
+    p_plane->i_step = i_step;
+    p_plane->i_comp = i_comp;
+    p_plane->i_src_width  = i_src_width;
+    p_plane->i_src_height = i_src_height;
+    p_plane->i_dst_width  = i_dst_width;
+    p_plane->i_dst_height = i_dst_height;
+
+    p_plane->p_htaps = BuildTaps( i_dst_width, i_src_width );
+    p_plane->p_vtaps = BuildTaps( i_dst_height, i_src_height );
+    for( int i = 0; i < SCALE_TAPS; i++ )
+        p_plane->p_lines[i] = malloc( i_dst_width );
+
+    if( p_plane->p_htaps == NULL || p_plane->p_vtaps == NULL )
+        return VLC_ENOMEM;
+    for( int i = 0; i < SCALE_TAPS; i++ )
+        if( p_plane->p_lines[i] == NULL )
+            return VLC_ENOMEM;
+    return VLC_SUCCESS;
+}
+
+static void FreePlanes( filter_sys_t *p_sys )
+{
+    for( unsigned i = 0; i < p_sys->i_planes; i++ )
+    {
+        free( p_sys->plane[i].p_htaps );
+        free( p_sys->plane[i].p_vtaps );
+        for( int j = 0; j < SCALE_TAPS; j++ )
+            free( p_sys->plane[i].p_lines[j] );
+    }
+}
+
+static int OpenScaler( vlc_object_t *p_this )
+{
+    filter_t *p_filter = (filter_t*)p_this;
+    const video_format_t *p_src = &p_filter->fmt_in.video;
+    const video_format_t *p_dst = &p_filter->fmt_out.video;
+
+    if( p_src->i_chroma != p_dst->i_chroma ||
+        p_src->orientation != p_dst->orientation )
+        return VLC_EGENERIC;
+
+    bool b_semiplanar;
+    switch( p_src->i_chroma )
+    {
+        case VLC_CODEC_I420:
+        case VLC_CODEC_J420:
+        case VLC_CODEC_YV12:
+            b_semiplanar = false;
+            break;
+        case VLC_CODEC_NV12:
+        case VLC_CODEC_NV21:
+            b_semiplanar = true;
+            break;
+        default:
+            return VLC_EGENERIC;
+    }
+
+    /* Cropped sources would need the tap tables offset; leave them to
+     * swscale */
+    if( p_src->i_x_offset || p_src->i_y_offset ||
+        p_dst->i_x_offset || p_dst->i_y_offset )
+        return VLC_EGENERIC;
+
+    const unsigned i_src_w = p_src->i_visible_width;
+    const unsigned i_src_h = p_src->i_visible_height;
+    const unsigned i_dst_w = p_dst->i_visible_width;
+    const unsigned i_dst_h = p_dst->i_visible_height;
+
+    /* Downscaling only: the widened tent gives area-average quality there,
+     * but plain bilinear upscales would regress against swscale */
+    if( i_dst_w > i_src_w || i_dst_h > i_src_h ||
+        ( i_dst_w == i_src_w && i_dst_h == i_src_h ) )
+        return VLC_EGENERIC;
+
+    const unsigned i_src_cw = ( i_src_w + 1 ) / 2;
+    const unsigned i_src_ch = ( i_src_h + 1 ) / 2;
+    const unsigned i_dst_cw = ( i_dst_w + 1 ) / 2;
+    const unsigned i_dst_ch = ( i_dst_h + 1 ) / 2;
+
+    if( i_src_cw < SCALE_TAPS || i_src_ch < SCALE_TAPS ||
+        i_dst_cw == 0 || i_dst_ch == 0 )
+        return VLC_EGENERIC;
+
+    filter_sys_t *p_sys = p_filter->p_sys = calloc( 1, sizeof( *p_sys ) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+    int i_ret;
+    if( b_semiplanar )
+    {
+        p_sys->i_planes = 3;
+        i_ret = InitPlane( &p_sys->plane[0], 0, 1, 0,
+                           i_src_w, i_src_h, i_dst_w, i_dst_h );
+        if( i_ret == VLC_SUCCESS )
+            i_ret = InitPlane( &p_sys->plane[1], 1, 2, 0,
+                               i_src_cw, i_src_ch, i_dst_cw, i_dst_ch );
+        if( i_ret == VLC_SUCCESS )
+            i_ret = InitPlane( &p_sys->plane[2], 1, 2, 1,
+                               i_src_cw, i_src_ch, i_dst_cw, i_dst_ch );
+    }
+    else
+    {
+        p_sys->i_planes = 3;
+        i_ret = InitPlane( &p_sys->plane[0], 0, 1, 0,
+                           i_src_w, i_src_h, i_dst_w, i_dst_h );
+        if( i_ret == VLC_SUCCESS )
+            i_ret = InitPlane( &p_sys->plane[1], 1, 1, 0,
+                               i_src_cw, i_src_ch, i_dst_cw, i_dst_ch );
+        if( i_ret == VLC_SUCCESS )
+            i_ret = InitPlane( &p_sys->plane[2], 2, 1, 0,
+                               i_src_cw, i_src_ch, i_dst_cw, i_dst_ch );
+    }
+    if( i_ret != VLC_SUCCESS )
+    {
+        FreePlanes( p_sys );
+        free( p_sys );
+        return i_ret;
+    }
+
+    p_sys->pf_vscale = ScaleLineV_C;
+#ifdef HAVE_SSE2_INTRINSICS
+    if( vlc_CPU_SSE2() )
+        p_sys->pf_vscale = ScaleLineV_SSE2;
+#endif
+#ifdef HAVE_AVX2_INTRINSICS
+    if( vlc_CPU_AVX2() )
+        p_sys->pf_vscale = ScaleLineV_AVX2;
+#endif
+
+    p_filter->pf_video_filter = Filter;
+
+    msg_Dbg( p_filter, "%4.4s %ix%i -> %ix%i", (char *)&p_src->i_chroma,
+             i_src_w, i_src_h, i_dst_w, i_dst_h );
+
+    return VLC_SUCCESS;
+}
+
+static void CloseScaler( vlc_object_t *p_this )
+{
+    filter_t *p_filter = (filter_t*)p_this;
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    FreePlanes( p_sys );
+    free( p_sys );
+}
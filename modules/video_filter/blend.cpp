@@ -32,8 +32,16 @@
 #include <vlc_plugin.h>
 #include <vlc_filter.h>
 #include <vlc_picture.h>
+#include <vlc_cpu.h>
 #include "filter_picture.h"
 
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+#endif
+
 /*****************************************************************************
  * Module descriptor
  *****************************************************************************/
@@ -557,6 +565,211 @@ typedef void (*blend_function_t)(const CPicture &dst_data, const CPicture &src_d
 
 namespace {
 
+/* Specialized path for the common subtitle case: 8-bit YUVA regions blended
+ * over 8-bit 4:2:0 planar or semi-planar video. The planes being separate
+ * both sides, whole luma rows can be processed with plain 16-bit arithmetic,
+ * and the alpha plane allows skipping the (usually large) fully transparent
+ * parts of a region without touching the video at all. */
+
+class CPictureRaw : public CPicture {
+public:
+    CPictureRaw(const CPicture &cfg) : CPicture(cfg) {}
+    uint8_t *line(unsigned plane, unsigned row, unsigned deny = 1) const
+    {
+        return &picture->p[plane].p_pixels[(row / deny) * picture->p[plane].i_pitch];
+    }
+    unsigned getX() const { return x; }
+    unsigned getY() const { return y; }
+};
+
+static bool RowHasAlpha(const uint8_t *alpha, unsigned count)
+{
+    unsigned i = 0;
+    for (; i + sizeof (size_t) <= count; i += sizeof (size_t)) {
+        size_t v;
+        memcpy(&v, &alpha[i], sizeof v);
+        if (v)
+            return true;
+    }
+    for (; i < count; i++)
+        if (alpha[i])
+            return true;
+    return false;
+}
+
+typedef void (*blend_row_fn)(uint8_t *dst, const uint8_t *src,
+                             const uint8_t *alpha, unsigned count,
+                             unsigned global);
+
+static void BlendRowC(uint8_t *dst, const uint8_t *src, const uint8_t *alpha,
+                      unsigned count, unsigned global)
+{
+    for (unsigned i = 0; i < count; i++) {
+        unsigned a = div255(global * alpha[i]);
+        if (a == 0)
+            continue;
+        merge(&dst[i], src[i], a);
+    }
+}
+
+#ifdef HAVE_SSE2_INTRINSICS
+__attribute__ ((__target__ ("sse2")))
+static inline __m128i Div255SSE2(__m128i v)
+{
+    /* ((v >> 8) + v + 1) >> 8, matching div255() in 16-bit lanes */
+    v = _mm_add_epi16(_mm_srli_epi16(v, 8), v);
+    return _mm_srli_epi16(_mm_add_epi16(v, _mm_set1_epi16(1)), 8);
+}
+
+__attribute__ ((__target__ ("sse2")))
+static void BlendRowSSE2(uint8_t *dst, const uint8_t *src, const uint8_t *alpha,
+                         unsigned count, unsigned global)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(255);
+    const __m128i ga   = _mm_set1_epi16(global);
+    unsigned i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i a8 = _mm_loadu_si128((const __m128i *)&alpha[i]);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a8, zero)) == 0xFFFF)
+            continue;
+
+        __m128i s8 = _mm_loadu_si128((const __m128i *)&src[i]);
+        if (global == 255 &&
+            _mm_movemask_epi8(_mm_cmpeq_epi8(a8, _mm_set1_epi8(-1))) == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)&dst[i], s8);
+            continue;
+        }
+
+        __m128i d8 = _mm_loadu_si128((const __m128i *)&dst[i]);
+        __m128i r[2];
+        for (int h = 0; h < 2; h++) {
+            __m128i a16 = h ? _mm_unpackhi_epi8(a8, zero)
+                            : _mm_unpacklo_epi8(a8, zero);
+            __m128i s16 = h ? _mm_unpackhi_epi8(s8, zero)
+                            : _mm_unpacklo_epi8(s8, zero);
+            __m128i d16 = h ? _mm_unpackhi_epi8(d8, zero)
+                            : _mm_unpacklo_epi8(d8, zero);
+            if (global != 255)
+                a16 = Div255SSE2(_mm_mullo_epi16(a16, ga));
+            __m128i v = _mm_add_epi16(
+                _mm_mullo_epi16(_mm_sub_epi16(v255, a16), d16),
+                _mm_mullo_epi16(s16, a16));
+            r[h] = Div255SSE2(v);
+        }
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_packus_epi16(r[0], r[1]));
+    }
+
+    BlendRowC(&dst[i], &src[i], &alpha[i], count - i, global);
+}
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+static inline uint8x8_t Div255NEON(uint16x8_t v)
+{
+    v = vaddq_u16(vshrq_n_u16(v, 8), v);
+    return vshrn_n_u16(vaddq_u16(v, vdupq_n_u16(1)), 8);
+}
+
+static void BlendRowNEON(uint8_t *dst, const uint8_t *src, const uint8_t *alpha,
+                         unsigned count, unsigned global)
+{
+    const uint8x8_t ga = vdup_n_u8(global);
+    unsigned i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t a8 = vld1q_u8(&alpha[i]);
+
+        uint64x2_t nz = vreinterpretq_u64_u8(a8);
+        if ((vgetq_lane_u64(nz, 0) | vgetq_lane_u64(nz, 1)) == 0)
+            continue;
+
+        if (global != 255) {
+            a8 = vcombine_u8(Div255NEON(vmull_u8(vget_low_u8(a8), ga)),
+                             Div255NEON(vmull_u8(vget_high_u8(a8), ga)));
+        }
+        uint8x16_t na8 = vmvnq_u8(a8); /* 255 - a */
+        uint8x16_t s8 = vld1q_u8(&src[i]);
+        uint8x16_t d8 = vld1q_u8(&dst[i]);
+
+        uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(na8), vget_low_u8(d8)),
+                                 vget_low_u8(a8), vget_low_u8(s8));
+        uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(na8), vget_high_u8(d8)),
+                                 vget_high_u8(a8), vget_high_u8(s8));
+        vst1q_u8(&dst[i], vcombine_u8(Div255NEON(lo), Div255NEON(hi)));
+    }
+
+    BlendRowC(&dst[i], &src[i], &alpha[i], count - i, global);
+}
+#endif
+
+static blend_row_fn BlendRowFunction(void)
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return BlendRowNEON;
+#else
+# ifdef HAVE_SSE2_INTRINSICS
+    if (vlc_CPU_SSE2())
+        return BlendRowSSE2;
+# endif
+    return BlendRowC;
+#endif
+}
+
+template <bool semiplanar, bool swap_uv>
+static void BlendYUVAOverP420(const CPicture &dst_data, const CPicture &src_data,
+                              unsigned width, unsigned height, int alpha)
+{
+    CPictureRaw dst(dst_data);
+    CPictureRaw src(src_data);
+    const blend_row_fn blend_row = BlendRowFunction();
+    const unsigned X = dst.getX(), Y = dst.getY();
+    const unsigned SX = src.getX(), SY = src.getY();
+    const unsigned ga = alpha;
+
+    for (unsigned dy = 0; dy < height; dy++) {
+        const uint8_t *sA = src.line(3, SY + dy) + SX;
+        if (!RowHasAlpha(sA, width))
+            continue;
+
+        blend_row(dst.line(0, Y + dy) + X, src.line(0, SY + dy) + SX,
+                  sA, width, ga);
+
+        /* Chroma is merged from the chroma-aligned pixels only, with their
+         * own alpha, as the generic path does */
+        if (((Y + dy) & 1) == 0) {
+            const uint8_t *sU = src.line(1, SY + dy) + SX;
+            const uint8_t *sV = src.line(2, SY + dy) + SX;
+            uint8_t *dU, *dV;
+            unsigned step;
+            if (semiplanar) {
+                uint8_t *duv = dst.line(1, Y + dy, 2);
+                dU = duv + (swap_uv ? 1 : 0);
+                dV = duv + (swap_uv ? 0 : 1);
+                step = 2;
+            } else {
+                dU = dst.line(swap_uv ? 2 : 1, Y + dy, 2);
+                dV = dst.line(swap_uv ? 1 : 2, Y + dy, 2);
+                step = 1;
+            }
+            for (unsigned dx = X & 1; dx < width; dx += 2) {
+                unsigned a = div255(ga * sA[dx]);
+                if (a == 0)
+                    continue;
+                const unsigned ci = (X + dx) / 2 * step;
+                merge(&dU[ci], sU[dx], a);
+                merge(&dV[ci], sV[dx], a);
+            }
+        }
+    }
+}
+
+} // namespace
+
+namespace {
+
 static const struct {
     vlc_fourcc_t     dst;
     vlc_fourcc_t     src;
@@ -627,6 +840,14 @@ static const struct {
     YUV(VLC_CODEC_YVYU,     CPictureYVYU,     convertNone),
     YUV(VLC_CODEC_VYUY,     CPictureVYUY,     convertNone),
 
+    /* Specialized subtitle paths, overriding the generic entries above
+     * (the last matching entry wins) */
+    { VLC_CODEC_I420, VLC_CODEC_YUVA, BlendYUVAOverP420<false, false> },
+    { VLC_CODEC_J420, VLC_CODEC_YUVA, BlendYUVAOverP420<false, false> },
+    { VLC_CODEC_YV12, VLC_CODEC_YUVA, BlendYUVAOverP420<false, true>  },
+    { VLC_CODEC_NV12, VLC_CODEC_YUVA, BlendYUVAOverP420<true,  false> },
+    { VLC_CODEC_NV21, VLC_CODEC_YUVA, BlendYUVAOverP420<true,  true>  },
+
 #undef RGB
 #undef YUV
 };
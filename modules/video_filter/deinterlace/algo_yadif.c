@@ -47,6 +47,199 @@
    Necessary preprocessor macros are defined in common.h. */
 #include "yadif.h"
 
+/*****************************************************************************
+ * Worker pool
+ *****************************************************************************
+ * Output rows only depend on the (read-only) history pictures, so the row
+ * loop can be split into horizontal bands rendered concurrently. The pool is
+ * created lazily on the first rendered frame and runs fork/join within
+ * RenderYadif(): no extra buffering is involved, so threading adds no frame
+ * of delay.
+ *****************************************************************************/
+
+/* Keep the bands tall enough that the per-frame wakeup cost stays noise */
+#define YADIF_MAX_THREADS    8
+#define YADIF_MIN_BAND_LINES 64
+
+typedef void (*yadif_line_fn)( uint8_t *dst, uint8_t *prev, uint8_t *cur,
+                               uint8_t *next, int w, int prefs, int mrefs,
+                               int parity, int mode );
+
+struct yadif_job
+{
+    picture_t       *p_dst;
+    const picture_t *p_prev;
+    const picture_t *p_cur;
+    const picture_t *p_next;
+    yadif_line_fn    pf_line;
+    int              i_field;
+    int              i_parity;
+};
+
+struct yadif_pool
+{
+    unsigned i_threads; /**< parts, including the calling thread */
+    bool     b_exit;
+
+    struct yadif_job job; /**< current frame, set before waking the workers */
+    vlc_sem_t done;
+
+    struct yadif_worker
+    {
+        struct yadif_pool *p_pool;
+        unsigned     i_part;
+        vlc_sem_t    wake;
+        vlc_thread_t thread;
+    } workers[];
+};
+
+/**
+ * Renders one horizontal band (part/parts) of every plane of a frame.
+ * With parts == 1 this is the whole single-threaded render loop.
+ */
+static void YadifRenderBand( const struct yadif_job *p_job,
+                             unsigned i_part, unsigned i_parts )
+{
+    picture_t *p_dst = p_job->p_dst;
+
+    for( int n = 0; n < p_dst->i_planes; n++ )
+    {
+        const plane_t *prevp = &p_job->p_prev->p[n];
+        const plane_t *curp  = &p_job->p_cur->p[n];
+        const plane_t *nextp = &p_job->p_next->p[n];
+        plane_t *dstp        = &p_dst->p[n];
+
+        /* Rows 1 .. i_visible_lines - 2; first and last are duplicated from
+           their neighbour by whichever band renders that neighbour. */
+        const int i_rows = dstp->i_visible_lines - 2;
+        if( i_rows <= 0 )
+            continue;
+        const int y_start = 1 + (int)( (int64_t)i_rows * i_part / i_parts );
+        const int y_end   = 1 + (int)( (int64_t)i_rows * (i_part + 1) / i_parts );
+
+        for( int y = y_start; y < y_end; y++ )
+        {
+            if( (y % 2) == p_job->i_field  ||  p_job->i_parity == 2 )
+            {
+                memcpy( &dstp->p_pixels[y * dstp->i_pitch],
+                            &curp->p_pixels[y * curp->i_pitch], dstp->i_visible_pitch );
+            }
+            else
+            {
+                int mode;
+                /* Spatial checks only when enough data */
+                mode = (y >= 2 && y < dstp->i_visible_lines - 2) ? 0 : 2;
+
+                assert( prevp->i_pitch == curp->i_pitch && curp->i_pitch == nextp->i_pitch );
+                p_job->pf_line( &dstp->p_pixels[y * dstp->i_pitch],
+                                &prevp->p_pixels[y * prevp->i_pitch],
+                                &curp->p_pixels[y * curp->i_pitch],
+                                &nextp->p_pixels[y * nextp->i_pitch],
+                                dstp->i_visible_pitch,
+                                y < dstp->i_visible_lines - 2  ? curp->i_pitch : -curp->i_pitch,
+                                y  - 1  ?  -curp->i_pitch : curp->i_pitch,
+                                p_job->i_parity,
+                                mode );
+            }
+
+            /* We duplicate the first and last lines */
+            if( y == 1 )
+                memcpy(&dstp->p_pixels[(y-1) * dstp->i_pitch],
+                           &dstp->p_pixels[ y    * dstp->i_pitch],
+                           dstp->i_pitch);
+            else if( y == dstp->i_visible_lines - 2 )
+                memcpy(&dstp->p_pixels[(y+1) * dstp->i_pitch],
+                           &dstp->p_pixels[ y    * dstp->i_pitch],
+                           dstp->i_pitch);
+        }
+    }
+}
+
+static void *YadifWorkerThread( void *p_data )
+{
+    struct yadif_worker *p_worker = p_data;
+    struct yadif_pool *p_pool = p_worker->p_pool;
+
+    for( ;; )
+    {
+        vlc_sem_wait( &p_worker->wake );
+        if( p_pool->b_exit )
+            break;
+        YadifRenderBand( &p_pool->job, p_worker->i_part, p_pool->i_threads );
+        vlc_sem_post( &p_pool->done );
+    }
+    return NULL;
+}
+
+/**
+ * Returns the worker pool, creating it on the first call.
+ * May return NULL (no memory, or not worth threading): the caller then
+ * renders inline.
+ */
+static struct yadif_pool *YadifGetPool( filter_t *p_filter, int i_visible_lines )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    if( p_sys->p_yadif_pool != NULL )
+        return p_sys->p_yadif_pool;
+
+    unsigned i_threads = __MIN( vlc_GetCPUCount(), YADIF_MAX_THREADS );
+    if( i_visible_lines / YADIF_MIN_BAND_LINES < (int)i_threads )
+        i_threads = __MAX( i_visible_lines / YADIF_MIN_BAND_LINES, 1 );
+
+    struct yadif_pool *p_pool =
+        malloc( sizeof( *p_pool )
+                + (i_threads - 1) * sizeof( struct yadif_worker ) );
+    if( unlikely(p_pool == NULL) )
+        return NULL;
+
+    p_pool->b_exit = false;
+    vlc_sem_init( &p_pool->done, 0 );
+
+    unsigned i_spawned = 0;
+    for( ; i_spawned < i_threads - 1; i_spawned++ )
+    {
+        struct yadif_worker *p_worker = &p_pool->workers[i_spawned];
+        p_worker->p_pool = p_pool;
+        p_worker->i_part = i_spawned;
+        vlc_sem_init( &p_worker->wake, 0 );
+        if( vlc_clone( &p_worker->thread, YadifWorkerThread, p_worker,
+                       VLC_THREAD_PRIORITY_VIDEO ) )
+        {
+            vlc_sem_destroy( &p_worker->wake );
+            break;
+        }
+    }
+    p_pool->i_threads = i_spawned + 1;
+
+    if( i_spawned > 0 )
+        msg_Dbg( p_filter, "yadif: using %u threads", p_pool->i_threads );
+
+    p_sys->p_yadif_pool = p_pool;
+    return p_pool;
+}
+
+void YadifReleaseThreads( filter_t *p_filter )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    struct yadif_pool *p_pool = p_sys->p_yadif_pool;
+
+    if( p_pool == NULL )
+        return;
+
+    p_pool->b_exit = true;
+    for( unsigned i = 0; i < p_pool->i_threads - 1; i++ )
+        vlc_sem_post( &p_pool->workers[i].wake );
+    for( unsigned i = 0; i < p_pool->i_threads - 1; i++ )
+    {
+        vlc_join( p_pool->workers[i].thread, NULL );
+        vlc_sem_destroy( &p_pool->workers[i].wake );
+    }
+    vlc_sem_destroy( &p_pool->done );
+    free( p_pool );
+    p_sys->p_yadif_pool = NULL;
+}
+
 int RenderYadifSingle( filter_t *p_filter, picture_t *p_dst, picture_t *p_src )
 {
     return RenderYadif( p_filter, p_dst, p_src, 0, 0 );
@@ -133,49 +326,30 @@ int RenderYadif( filter_t *p_filter, picture_t *p_dst, picture_t *p_src,
         if( p_sys->chroma->pixel_size == 2 )
             filter = yadif_filter_line_c_16bit;
 
-        for( int n = 0; n < p_dst->i_planes; n++ )
-        {
-            const plane_t *prevp = &p_prev->p[n];
-            const plane_t *curp  = &p_cur->p[n];
-            const plane_t *nextp = &p_next->p[n];
-            plane_t *dstp        = &p_dst->p[n];
+        const struct yadif_job job = {
+            .p_dst    = p_dst,
+            .p_prev   = p_prev,
+            .p_cur    = p_cur,
+            .p_next   = p_next,
+            .pf_line  = filter,
+            .i_field  = i_field,
+            .i_parity = yadif_parity,
+        };
 
-            for( int y = 1; y < dstp->i_visible_lines - 1; y++ )
-            {
-                if( (y % 2) == i_field  ||  yadif_parity == 2 )
-                {
-                    memcpy( &dstp->p_pixels[y * dstp->i_pitch],
-                                &curp->p_pixels[y * curp->i_pitch], dstp->i_visible_pitch );
-                }
-                else
-                {
-                    int mode;
-                    /* Spatial checks only when enough data */
-                    mode = (y >= 2 && y < dstp->i_visible_lines - 2) ? 0 : 2;
-
-                    assert( prevp->i_pitch == curp->i_pitch && curp->i_pitch == nextp->i_pitch );
-                    filter( &dstp->p_pixels[y * dstp->i_pitch],
-                            &prevp->p_pixels[y * prevp->i_pitch],
-                            &curp->p_pixels[y * curp->i_pitch],
-                            &nextp->p_pixels[y * nextp->i_pitch],
-                            dstp->i_visible_pitch,
-                            y < dstp->i_visible_lines - 2  ? curp->i_pitch : -curp->i_pitch,
-                            y  - 1  ?  -curp->i_pitch : curp->i_pitch,
-                            yadif_parity,
-                            mode );
-                }
-
-                /* We duplicate the first and last lines */
-                if( y == 1 )
-                    memcpy(&dstp->p_pixels[(y-1) * dstp->i_pitch],
-                               &dstp->p_pixels[ y    * dstp->i_pitch],
-                               dstp->i_pitch);
-                else if( y == dstp->i_visible_lines - 2 )
-                    memcpy(&dstp->p_pixels[(y+1) * dstp->i_pitch],
-                               &dstp->p_pixels[ y    * dstp->i_pitch],
-                               dstp->i_pitch);
-            }
+        struct yadif_pool *p_pool =
+            YadifGetPool( p_filter, p_dst->p[0].i_visible_lines );
+        if( p_pool != NULL && p_pool->i_threads > 1 )
+        {
+            p_pool->job = job;
+            for( unsigned i = 0; i < p_pool->i_threads - 1; i++ )
+                vlc_sem_post( &p_pool->workers[i].wake );
+            /* Render the last band on the calling thread */
+            YadifRenderBand( &job, p_pool->i_threads - 1, p_pool->i_threads );
+            for( unsigned i = 0; i < p_pool->i_threads - 1; i++ )
+                vlc_sem_wait( &p_pool->done );
         }
+        else
+            YadifRenderBand( &job, 0, 1 );
 
         p_sys->context.i_frame_offset = 1; /* p_cur will be rendered at next frame, too */
 
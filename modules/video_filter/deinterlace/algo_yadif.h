@@ -35,6 +35,10 @@
 struct filter_t;
 struct picture_t;
 
+/** Yadif worker thread pool, created lazily on the first rendered frame.
+    Defined in algo_yadif.c. */
+struct yadif_pool;
+
 /*****************************************************************************
  * Functions
  *****************************************************************************/
@@ -91,4 +95,14 @@ int RenderYadif( filter_t *p_filter, picture_t *p_dst, picture_t *p_src,
  */
 int RenderYadifSingle( filter_t *p_filter, picture_t *p_dst, picture_t *p_src );
 
+/**
+ * Stops and joins the Yadif worker threads, if any were started.
+ *
+ * Must be called from Close(). Safe to call when no pool was created
+ * (e.g. another algorithm was in use).
+ *
+ * @param p_filter The filter instance.
+ */
+void YadifReleaseThreads( filter_t *p_filter );
+
 #endif
@@ -528,6 +528,7 @@ notsupp:
         return VLC_ENOMEM;
 
     p_sys->chroma = chroma;
+    p_sys->p_yadif_pool = NULL;
 
     InitDeinterlacingContext( &p_sys->context );
 
@@ -538,54 +539,68 @@ notsupp:
 
     IVTCClearState( p_filter );
 
+    /* 16-bit variants exist for SSE2 and NEON only; AltiVec, MMXEXT and
+     * 3D Now! merges handle 8-bit samples exclusively. */
+    static const struct vlc_cpu_kernel merge8_kernels[] =
+    {
+        VLC_CPU_KERNEL( "c", 0, Merge8BitGeneric ),
 #if defined(CAN_COMPILE_C_ALTIVEC)
-    if( pixel_size == 1 && vlc_CPU_ALTIVEC() )
-        p_sys->pf_merge = MergeAltivec;
-    else
+        VLC_CPU_KERNEL( "altivec", VLC_CPU_ALTIVEC, MergeAltivec ),
 #endif
-#if defined(CAN_COMPILE_SSE2)
-    if( vlc_CPU_SSE2() )
-    {
-        p_sys->pf_merge = pixel_size == 1 ? Merge8BitSSE2 : Merge16BitSSE2;
-        p_sys->pf_end_merge = EndMMX;
-    }
-    else
+#if defined(CAN_COMPILE_3DNOW)
+        VLC_CPU_KERNEL( "3dnow", VLC_CPU_3dNOW, Merge3DNow ),
 #endif
 #if defined(CAN_COMPILE_MMXEXT)
-    if( pixel_size == 1 && vlc_CPU_MMXEXT() )
-    {
-        p_sys->pf_merge = MergeMMXEXT;
-        p_sys->pf_end_merge = EndMMX;
-    }
-    else
+        VLC_CPU_KERNEL( "mmxext", VLC_CPU_MMXEXT, MergeMMXEXT ),
 #endif
-#if defined(CAN_COMPILE_3DNOW)
-    if( pixel_size == 1 && vlc_CPU_3dNOW() )
-    {
-        p_sys->pf_merge = Merge3DNow;
-        p_sys->pf_end_merge = End3DNow;
-    }
-    else
+#if defined(CAN_COMPILE_SSE2)
+        VLC_CPU_KERNEL( "sse2", VLC_CPU_SSE2, Merge8BitSSE2 ),
 #endif
 #if defined(CAN_COMPILE_ARM)
-    if( vlc_CPU_ARM_NEON() )
-        p_sys->pf_merge = pixel_size == 1 ? merge8_arm_neon : merge16_arm_neon;
-    else
-    if( vlc_CPU_ARMv6() )
-        p_sys->pf_merge = pixel_size == 1 ? merge8_armv6 : merge16_armv6;
-    else
+        VLC_CPU_KERNEL( "armv6", VLC_CPU_ARMv6, merge8_armv6 ),
+        VLC_CPU_KERNEL( "neon", VLC_CPU_ARM_NEON, merge8_arm_neon ),
 #endif
 #if defined(CAN_COMPILE_ARM64)
-    if( vlc_CPU_ARM64_NEON() )
-        p_sys->pf_merge = pixel_size == 1 ? merge8_arm64_neon : merge16_arm64_neon;
-    else
+        VLC_CPU_KERNEL( "neon", 0, merge8_arm64_neon ),
 #endif
+    };
+    static const struct vlc_cpu_kernel merge16_kernels[] =
     {
-        p_sys->pf_merge = pixel_size == 1 ? Merge8BitGeneric : Merge16BitGeneric;
+        VLC_CPU_KERNEL( "c", 0, Merge16BitGeneric ),
+#if defined(CAN_COMPILE_SSE2)
+        VLC_CPU_KERNEL( "sse2", VLC_CPU_SSE2, Merge16BitSSE2 ),
+#endif
+#if defined(CAN_COMPILE_ARM)
+        VLC_CPU_KERNEL( "armv6", VLC_CPU_ARMv6, merge16_armv6 ),
+        VLC_CPU_KERNEL( "neon", VLC_CPU_ARM_NEON, merge16_arm_neon ),
+#endif
+#if defined(CAN_COMPILE_ARM64)
+        VLC_CPU_KERNEL( "neon", 0, merge16_arm64_neon ),
+#endif
+    };
+
+    p_sys->pf_merge = ( void (*)( void *, const void *, const void *, size_t ) )
+        ( ( pixel_size == 1 )
+        ? vlc_CPU_kernel( merge8_kernels, sizeof (merge8_kernels)
+                                          / sizeof (merge8_kernels[0]) )
+        : vlc_CPU_kernel( merge16_kernels, sizeof (merge16_kernels)
+                                           / sizeof (merge16_kernels[0]) ) );
 #if defined(__i386__) || defined(__x86_64__)
-        p_sys->pf_end_merge = NULL;
+    /* The MMX-based merges leave the FPU state dirty until EndMerge(). */
+    p_sys->pf_end_merge = NULL;
+# if defined(CAN_COMPILE_3DNOW)
+    if( p_sys->pf_merge == Merge3DNow )
+        p_sys->pf_end_merge = End3DNow;
+# endif
+# if defined(CAN_COMPILE_MMXEXT)
+    if( p_sys->pf_merge == MergeMMXEXT )
+        p_sys->pf_end_merge = EndMMX;
+# endif
+# if defined(CAN_COMPILE_SSE2)
+    if( p_sys->pf_merge == Merge8BitSSE2 || p_sys->pf_merge == Merge16BitSSE2 )
+        p_sys->pf_end_merge = EndMMX;
+# endif
 #endif
-    }
 
     /* */
     video_format_t fmt;
@@ -659,5 +674,6 @@ void Close( vlc_object_t *p_this )
     filter_t *p_filter = (filter_t*)p_this;
 
     Flush( p_filter );
+    YadifReleaseThreads( p_filter );
     free( p_filter->p_sys );
 }
@@ -78,6 +78,9 @@ typedef struct
 
     struct deinterlace_ctx   context;
 
+    /** Yadif worker threads; NULL until the first frame Yadif renders. */
+    struct yadif_pool *p_yadif_pool;
+
     /* Algorithm-specific substructures */
     union {
         phosphor_sys_t phosphor; /**< Phosphor algorithm state. */
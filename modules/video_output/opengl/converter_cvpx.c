@@ -33,14 +33,31 @@
 #include <IOSurface/IOSurface.h>
 #endif
 
+#if !TARGET_OS_IPHONE
+/* The decoder cycles through a small pool of CVPixelBuffers, each backed by
+ * the same IOSurface for its whole lifetime. Keep one set of GL textures per
+ * surface: once CGLTexImageIOSurface2D() has bound a surface to a texture,
+ * further decoder writes to that surface show up in the texture without
+ * another import, so steady-state updates reduce to a texture name lookup.
+ * The cache is sized a bit above the usual VT pool depth. */
+# define CVPX_TEX_CACHE_SIZE 10
+#endif
+
 struct priv
 {
+    picture_t *last_pic;
 #if TARGET_OS_IPHONE
     CVOpenGLESTextureCacheRef cache;
     CVOpenGLESTextureRef last_cvtexs[PICTURE_PLANE_MAX];
 #else
-    picture_t *last_pic;
     CGLContextObj gl_ctx;
+    struct cvpx_tex_cache_entry
+    {
+        IOSurfaceID surface_id;
+        GLuint textures[PICTURE_PLANE_MAX];
+    } tex_cache[CVPX_TEX_CACHE_SIZE];
+    unsigned tex_cache_count;
+    unsigned tex_cache_next;
 #endif
 };
 
@@ -56,6 +73,14 @@ tc_cvpx_update(const opengl_tex_converter_t *tc, GLuint *textures,
 
     CVPixelBufferRef pixelBuffer = cvpxpic_get_ref(pic);
 
+    if (pic == priv->last_pic)
+    {
+        /* Same frame again (refresh, pause): the textures are still valid. */
+        for (unsigned i = 0; i < tc->tex_count; ++i)
+            textures[i] = CVOpenGLESTextureGetName(priv->last_cvtexs[i]);
+        return VLC_SUCCESS;
+    }
+
     for (unsigned i = 0; i < tc->tex_count; ++i)
     {
         if (likely(priv->last_cvtexs[i]))
@@ -67,6 +92,12 @@ tc_cvpx_update(const opengl_tex_converter_t *tc, GLuint *textures,
 
     CVOpenGLESTextureCacheFlush(priv->cache, 0);
 
+    if (priv->last_pic != NULL)
+    {
+        picture_Release(priv->last_pic);
+        priv->last_pic = NULL;
+    }
+
     for (unsigned i = 0; i < tc->tex_count; ++i)
     {
         CVOpenGLESTextureRef cvtex;
@@ -92,27 +123,31 @@ tc_cvpx_update(const opengl_tex_converter_t *tc, GLuint *textures,
         priv->last_cvtexs[i] = cvtex;
     }
 
+    priv->last_pic = picture_Hold(pic);
     return VLC_SUCCESS;
 }
 
 #else
 /* IOSurface version (macos) */
-static int
-tc_cvpx_update(const opengl_tex_converter_t *tc, GLuint *textures,
-               const GLsizei *tex_width, const GLsizei *tex_height,
-               picture_t *pic, const size_t *plane_offset)
+static struct cvpx_tex_cache_entry *
+tc_cvpx_cache_import(const opengl_tex_converter_t *tc, IOSurfaceRef surface,
+                     const GLsizei *tex_width, const GLsizei *tex_height)
 {
-    (void) plane_offset;
     struct priv *priv = tc->priv;
+    struct cvpx_tex_cache_entry *entry = &priv->tex_cache[priv->tex_cache_next];
 
-    CVPixelBufferRef pixelBuffer = cvpxpic_get_ref(pic);
-
-    IOSurfaceRef surface = CVPixelBufferGetIOSurface(pixelBuffer);
+    if (entry->surface_id == 0)
+        tc->vt->GenTextures(tc->tex_count, entry->textures);
+    /* else rebind over the textures of the evicted entry */
+    entry->surface_id = 0;
 
     for (unsigned i = 0; i < tc->tex_count; ++i)
     {
-        tc->vt->ActiveTexture(GL_TEXTURE0 + i);
-        tc->vt->BindTexture(tc->tex_target, textures[i]);
+        tc->vt->BindTexture(tc->tex_target, entry->textures[i]);
+        tc->vt->TexParameteri(tc->tex_target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        tc->vt->TexParameteri(tc->tex_target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        tc->vt->TexParameteri(tc->tex_target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        tc->vt->TexParameteri(tc->tex_target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
         CGLError err =
             CGLTexImageIOSurface2D(priv->gl_ctx, tc->tex_target,
@@ -121,14 +156,59 @@ tc_cvpx_update(const opengl_tex_converter_t *tc, GLuint *textures,
                                    tc->texs[i].format,
                                    tc->texs[i].type,
                                    surface, i);
+        tc->vt->BindTexture(tc->tex_target, 0);
         if (err != kCGLNoError)
         {
+            tc->vt->DeleteTextures(tc->tex_count, entry->textures);
+            memset(entry->textures, 0, sizeof (entry->textures));
             msg_Err(tc->gl, "CGLTexImageIOSurface2D error: %u: %s", i,
                     CGLErrorString(err));
-            return VLC_EGENERIC;
+            return NULL;
+        }
+    }
+
+    entry->surface_id = IOSurfaceGetID(surface);
+    if (priv->tex_cache_count < CVPX_TEX_CACHE_SIZE)
+        priv->tex_cache_count++;
+    priv->tex_cache_next = (priv->tex_cache_next + 1) % CVPX_TEX_CACHE_SIZE;
+    return entry;
+}
+
+static int
+tc_cvpx_update(const opengl_tex_converter_t *tc, GLuint *textures,
+               const GLsizei *tex_width, const GLsizei *tex_height,
+               picture_t *pic, const size_t *plane_offset)
+{
+    (void) plane_offset;
+    struct priv *priv = tc->priv;
+
+    CVPixelBufferRef pixelBuffer = cvpxpic_get_ref(pic);
+
+    IOSurfaceRef surface = CVPixelBufferGetIOSurface(pixelBuffer);
+    IOSurfaceID surface_id = IOSurfaceGetID(surface);
+
+    struct cvpx_tex_cache_entry *entry = NULL;
+    for (unsigned i = 0; i < priv->tex_cache_count; ++i)
+        if (priv->tex_cache[i].surface_id == surface_id)
+        {
+            entry = &priv->tex_cache[i];
+            break;
         }
+
+    if (entry == NULL)
+    {
+        /* First time this surface of the decoder pool is displayed: import
+         * it. The texture then tracks the surface content, so when the
+         * decoder recycles the surface for a new frame, the bound textures
+         * are picked up from the cache without a new import. */
+        entry = tc_cvpx_cache_import(tc, surface, tex_width, tex_height);
+        if (entry == NULL)
+            return VLC_EGENERIC;
     }
 
+    for (unsigned i = 0; i < tc->tex_count; ++i)
+        textures[i] = entry->textures[i];
+
     if (priv->last_pic != pic)
     {
         if (priv->last_pic != NULL)
@@ -154,9 +234,11 @@ Close(vlc_object_t *obj)
     }
     CFRelease(priv->cache);
 #else
+    for (unsigned i = 0; i < priv->tex_cache_count; ++i)
+        tc->vt->DeleteTextures(tc->tex_count, priv->tex_cache[i].textures);
+#endif
     if (priv->last_pic != NULL)
         picture_Release(priv->last_pic);
-#endif
     free(tc->priv);
 }
 
@@ -268,9 +350,7 @@ Open(vlc_object_t *obj)
         return VLC_EGENERIC;
     }
 
-#if TARGET_OS_IPHONE
     tc->handle_texs_gen = true;
-#endif
     tc->priv              = priv;
     tc->pf_update         = tc_cvpx_update;
     tc->fshader           = fragment_shader;
@@ -46,9 +46,15 @@
 #ifndef GL_MAP_WRITE_BIT
 # define GL_MAP_WRITE_BIT 0x0002
 #endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+# define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
 #ifndef GL_MAP_FLUSH_EXPLICIT_BIT
 #define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
 #endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+# define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
 #ifndef GL_MAP_PERSISTENT_BIT
 # define GL_MAP_PERSISTENT_BIT 0x0040
 #endif
@@ -66,8 +72,11 @@
 #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
 # define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
 #endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+# define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
 
-#define PBO_DISPLAY_COUNT 2 /* Double buffering */
+#define PBO_DISPLAY_COUNT 3 /* Triple buffering */
 typedef struct
 {
     vlc_gl_t    *gl;
@@ -86,6 +95,8 @@ struct priv
     struct {
         picture_t *display_pics[PBO_DISPLAY_COUNT];
         size_t display_idx;
+        bool has_fences;
+        bool use_map;
     } pbo;
     struct {
         picture_t *pics[VLCGL_PICTURE_MAX];
@@ -221,13 +232,39 @@ tc_pbo_update(const opengl_tex_converter_t *tc, GLuint *textures,
     picture_sys_t *p_sys = display_pic->p_sys;
     priv->pbo.display_idx = (priv->pbo.display_idx + 1) % PBO_DISPLAY_COUNT;
 
+    /* Reclaim the buffers: with PBO_DISPLAY_COUNT uploads in flight the
+     * fence is normally long signaled, so this does not block */
+    if (p_sys->fence != NULL)
+    {
+        tc->vt->ClientWaitSync(p_sys->fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                               UINT64_C(100000000) /* 100 ms */);
+        tc->vt->DeleteSync(p_sys->fence);
+        p_sys->fence = NULL;
+    }
+
     for (int i = 0; i < pic->i_planes; i++)
     {
         GLsizeiptr size = pic->p[i].i_lines * pic->p[i].i_pitch;
         const GLvoid *data = pic->p[i].p_pixels;
         tc->vt->BindBuffer(GL_PIXEL_UNPACK_BUFFER,
                            p_sys->buffers[i]);
-        tc->vt->BufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, data);
+
+        /* Copy the plane ourselves into the (fence-guarded) buffer: unlike
+         * BufferSubData, an unsynchronized map cannot make the driver stall
+         * on, or stage a copy of, a buffer the GPU is still reading */
+        void *map = NULL;
+        if (priv->pbo.use_map)
+            map = tc->vt->MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                         GL_MAP_WRITE_BIT |
+                                         GL_MAP_INVALIDATE_RANGE_BIT |
+                                         GL_MAP_UNSYNCHRONIZED_BIT);
+        if (map != NULL)
+        {
+            memcpy(map, data, size);
+            tc->vt->UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+        else
+            tc->vt->BufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, data);
 
         tc->vt->ActiveTexture(GL_TEXTURE0 + i);
         tc->vt->BindTexture(tc->tex_target, textures[i]);
@@ -239,6 +276,9 @@ tc_pbo_update(const opengl_tex_converter_t *tc, GLuint *textures,
                               tc->texs[i].format, tc->texs[i].type, NULL);
     }
 
+    if (priv->pbo.has_fences)
+        p_sys->fence = tc->vt->FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
     /* turn off pbo */
     tc->vt->BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
@@ -623,6 +663,11 @@ opengl_tex_converter_generic_init(opengl_tex_converter_t *tc, bool allow_dr)
                 && tc->vt->BufferSubData;
             if (supports_pbo && pbo_pics_alloc(tc) == VLC_SUCCESS)
             {
+                priv->pbo.has_fences = tc->vt->FenceSync && tc->vt->DeleteSync
+                    && tc->vt->ClientWaitSync;
+                /* Unsynchronized maps are racy without fences */
+                priv->pbo.use_map = priv->pbo.has_fences
+                    && tc->vt->MapBufferRange && tc->vt->UnmapBuffer;
                 tc->pf_update  = tc_pbo_update;
                 msg_Dbg(tc->gl, "PBO support enabled");
             }
@@ -639,7 +684,13 @@ opengl_tex_converter_generic_deinit(opengl_tex_converter_t *tc)
 {
     struct priv *priv = tc->priv;
     for (size_t i = 0; i < PBO_DISPLAY_COUNT && priv->pbo.display_pics[i]; ++i)
-        picture_Release(priv->pbo.display_pics[i]);
+    {
+        picture_t *pic = priv->pbo.display_pics[i];
+        picture_sys_t *picsys = pic->p_sys;
+        if (picsys->fence != NULL)
+            tc->vt->DeleteSync(picsys->fence);
+        picture_Release(pic);
+    }
     persistent_release_gpupics(tc, true);
     free(priv->texture_temp_buf);
     free(tc->priv);
@@ -25,6 +25,7 @@
 #include "converter.h"
 #include "../../hw/vaapi/vlc_vaapi.h"
 #include <vlc_vout_window.h>
+#include <vlc_fs.h>
 
 #include <assert.h>
 
@@ -43,7 +44,6 @@
 
 #ifdef HAVE_VA_DRM
 # include <va/va_drm.h>
-# include <vlc_fs.h>
 # include <fcntl.h>
 #endif
 
@@ -51,6 +51,11 @@
 #   include <GLES2/gl2ext.h>
 #endif
 
+/* From libdrm's drm_fourcc.h, avoids a build time dependency on libdrm */
+#ifndef DRM_FORMAT_MOD_INVALID
+# define DRM_FORMAT_MOD_INVALID 0x00ffffffffffffffULL
+#endif
+
 struct priv
 {
     struct vlc_vaapi_instance *vainst;
@@ -60,9 +65,24 @@ struct priv
 
     unsigned fourcc;
     EGLint drm_fourccs[3];
+    bool has_modifiers; /* EGL_EXT_image_dma_buf_import_modifiers */
+
+#if VA_CHECK_VERSION(1, 1, 0)
+    /* Surface export entry point, latched on the first frame */
+    enum {
+        EXPORT_UNTESTED,
+        EXPORT_DRM_PRIME_2, /* vaExportSurfaceHandle(), carries modifiers */
+        EXPORT_DRM_PRIME,   /* legacy vaAcquireBufferHandle() */
+    } export_mode;
+#endif
 
     struct {
         picture_t *  pic;
+        unsigned     num_images;
+#if VA_CHECK_VERSION(1, 1, 0)
+        /* EXPORT_DRM_PRIME_2: the descriptor owns the object fds */
+        VADRMPRIMESurfaceDescriptor va_desc;
+#endif
         VAImage      va_image;
         VABufferInfo va_buffer_info;
         void *       egl_images[3];
@@ -71,17 +91,38 @@ struct priv
 
 static EGLImageKHR
 vaegl_image_create(const opengl_tex_converter_t *tc, EGLint w, EGLint h,
-                   EGLint fourcc, EGLint fd, EGLint offset, EGLint pitch)
+                   EGLint fourcc, EGLint fd, EGLint offset, EGLint pitch,
+                   uint64_t modifier)
 {
-    EGLint attribs[] = {
-        EGL_WIDTH, w,
-        EGL_HEIGHT, h,
-        EGL_LINUX_DRM_FOURCC_EXT, fourcc,
-        EGL_DMA_BUF_PLANE0_FD_EXT, fd,
-        EGL_DMA_BUF_PLANE0_OFFSET_EXT, offset,
-        EGL_DMA_BUF_PLANE0_PITCH_EXT, pitch,
-        EGL_NONE
-    };
+    EGLint attribs[17];
+    unsigned na = 0;
+
+    attribs[na++] = EGL_WIDTH;
+    attribs[na++] = w;
+    attribs[na++] = EGL_HEIGHT;
+    attribs[na++] = h;
+    attribs[na++] = EGL_LINUX_DRM_FOURCC_EXT;
+    attribs[na++] = fourcc;
+    attribs[na++] = EGL_DMA_BUF_PLANE0_FD_EXT;
+    attribs[na++] = fd;
+    attribs[na++] = EGL_DMA_BUF_PLANE0_OFFSET_EXT;
+    attribs[na++] = offset;
+    attribs[na++] = EGL_DMA_BUF_PLANE0_PITCH_EXT;
+    attribs[na++] = pitch;
+#ifdef EGL_EXT_image_dma_buf_import_modifiers
+    const struct priv *priv = tc->priv;
+    if (priv->has_modifiers && modifier != DRM_FORMAT_MOD_INVALID)
+    {
+        attribs[na++] = EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT;
+        attribs[na++] = modifier & 0xffffffff;
+        attribs[na++] = EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT;
+        attribs[na++] = modifier >> 32;
+    }
+#else
+    (void) modifier;
+#endif
+    attribs[na++] = EGL_NONE;
+    assert(na <= ARRAY_SIZE(attribs));
 
     return tc->gl->egl.createImageKHR(tc->gl, EGL_LINUX_DMA_BUF_EXT, NULL,
                                       attribs);
@@ -98,12 +139,22 @@ vaegl_release_last_pic(const opengl_tex_converter_t *tc, struct priv *priv)
 {
     vlc_object_t *o = VLC_OBJECT(tc->gl);
 
-    for (unsigned i = 0; i < priv->last.va_image.num_planes; ++i)
+    for (unsigned i = 0; i < priv->last.num_images; ++i)
         vaegl_image_destroy(tc, priv->last.egl_images[i]);
 
-    vlc_vaapi_ReleaseBufferHandle(o, priv->vadpy, priv->last.va_image.buf);
+#if VA_CHECK_VERSION(1, 1, 0)
+    if (priv->export_mode == EXPORT_DRM_PRIME_2)
+    {
+        for (uint32_t i = 0; i < priv->last.va_desc.num_objects; ++i)
+            vlc_close(priv->last.va_desc.objects[i].fd);
+    }
+    else
+#endif
+    {
+        vlc_vaapi_ReleaseBufferHandle(o, priv->vadpy, priv->last.va_image.buf);
 
-    vlc_vaapi_DestroyImage(o, priv->vadpy, priv->last.va_image.image_id);
+        vlc_vaapi_DestroyImage(o, priv->vadpy, priv->last.va_image.image_id);
+    }
 
     picture_Release(priv->last.pic);
 }
@@ -156,6 +207,63 @@ vaegl_init_fourcc(const opengl_tex_converter_t *tc, struct priv *priv,
     return VLC_SUCCESS;
 }
 
+#if VA_CHECK_VERSION(1, 1, 0)
+static int
+tc_vaegl_update_prime2(const opengl_tex_converter_t *tc, GLuint *textures,
+                       const GLsizei *tex_width, const GLsizei *tex_height,
+                       picture_t *pic)
+{
+    struct priv *priv = tc->priv;
+    VADRMPRIMESurfaceDescriptor va_desc;
+    EGLImageKHR egl_images[3] = { };
+
+    if (vaExportSurfaceHandle(priv->vadpy, vlc_vaapi_PicGetSurface(pic),
+                              VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME_2,
+                              VA_EXPORT_SURFACE_READ_ONLY |
+                              VA_EXPORT_SURFACE_SEPARATE_LAYERS,
+                              &va_desc) != VA_STATUS_SUCCESS)
+        return VLC_EGENERIC;
+
+    assert(va_desc.fourcc == priv->fourcc);
+    assert(va_desc.num_layers <= ARRAY_SIZE(egl_images));
+
+    for (unsigned i = 0; i < va_desc.num_layers; ++i)
+    {
+        unsigned obj = va_desc.layers[i].object_index[0];
+        egl_images[i] =
+            vaegl_image_create(tc, tex_width[i], tex_height[i],
+                               priv->drm_fourccs[i],
+                               va_desc.objects[obj].fd,
+                               va_desc.layers[i].offset[0],
+                               va_desc.layers[i].pitch[0],
+                               va_desc.objects[obj].drm_format_modifier);
+        if (egl_images[i] == NULL)
+            goto error;
+
+        tc->vt->BindTexture(tc->tex_target, textures[i]);
+
+        priv->glEGLImageTargetTexture2DOES(tc->tex_target, egl_images[i]);
+    }
+
+    if (priv->last.pic != NULL)
+        vaegl_release_last_pic(tc, priv);
+    priv->last.pic = picture_Hold(pic);
+    priv->last.num_images = va_desc.num_layers;
+    priv->last.va_desc = va_desc;
+    for (unsigned i = 0; i < va_desc.num_layers; ++i)
+        priv->last.egl_images[i] = egl_images[i];
+
+    return VLC_SUCCESS;
+
+error:
+    for (unsigned i = 0; i < 3 && egl_images[i] != NULL; ++i)
+        vaegl_image_destroy(tc, egl_images[i]);
+    for (uint32_t i = 0; i < va_desc.num_objects; ++i)
+        vlc_close(va_desc.objects[i].fd);
+    return VLC_EGENERIC;
+}
+#endif
+
 static int
 tc_vaegl_update(const opengl_tex_converter_t *tc, GLuint *textures,
                 const GLsizei *tex_width, const GLsizei *tex_height,
@@ -171,35 +279,61 @@ tc_vaegl_update(const opengl_tex_converter_t *tc, GLuint *textures,
 
     if (pic == priv->last.pic)
     {
-        va_image = priv->last.va_image;
-        va_buffer_info = priv->last.va_buffer_info;
-        for (unsigned i = 0; i < priv->last.va_image.num_planes; ++i)
-            egl_images[i] = priv->last.egl_images[i];
+        /* Rebind the cached EGL images, the surface was already imported */
+        for (unsigned i = 0; i < priv->last.num_images; ++i)
+        {
+            tc->vt->BindTexture(tc->tex_target, textures[i]);
+
+            priv->glEGLImageTargetTexture2DOES(tc->tex_target,
+                                               priv->last.egl_images[i]);
+        }
+        return VLC_SUCCESS;
     }
-    else
+
+#if VA_CHECK_VERSION(1, 1, 0)
+    if (priv->export_mode != EXPORT_DRM_PRIME)
     {
-        if (vlc_vaapi_DeriveImage(o, priv->vadpy, vlc_vaapi_PicGetSurface(pic),
-                                  &va_image))
-            goto error;
-        release_image = true;
+        int ret = tc_vaegl_update_prime2(tc, textures, tex_width, tex_height,
+                                         pic);
+        if (ret == VLC_SUCCESS)
+        {
+            if (priv->export_mode == EXPORT_UNTESTED)
+            {
+                msg_Dbg(o, "zero-copy import via vaExportSurfaceHandle()");
+                priv->export_mode = EXPORT_DRM_PRIME_2;
+            }
+            return VLC_SUCCESS;
+        }
+        if (priv->export_mode != EXPORT_UNTESTED)
+            return ret;
+        msg_Dbg(o, "vaExportSurfaceHandle() not usable, "
+                "falling back to vaAcquireBufferHandle()");
+        priv->export_mode = EXPORT_DRM_PRIME;
+    }
+#endif
 
-        assert(va_image.format.fourcc == priv->fourcc);
+    if (vlc_vaapi_DeriveImage(o, priv->vadpy, vlc_vaapi_PicGetSurface(pic),
+                              &va_image))
+        goto error;
+    release_image = true;
 
-        va_buffer_info = (VABufferInfo) {
-            .mem_type = VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME
-        };
-        if (vlc_vaapi_AcquireBufferHandle(o, priv->vadpy, va_image.buf,
-                                          &va_buffer_info))
-            goto error;
-        release_buffer_info = true;
-    }
+    assert(va_image.format.fourcc == priv->fourcc);
+
+    va_buffer_info = (VABufferInfo) {
+        .mem_type = VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME
+    };
+    if (vlc_vaapi_AcquireBufferHandle(o, priv->vadpy, va_image.buf,
+                                      &va_buffer_info))
+        goto error;
+    release_buffer_info = true;
 
     for (unsigned i = 0; i < va_image.num_planes; ++i)
     {
         egl_images[i] =
             vaegl_image_create(tc, tex_width[i], tex_height[i],
                                priv->drm_fourccs[i], va_buffer_info.handle,
-                               va_image.offsets[i], va_image.pitches[i]);
+                               va_image.offsets[i], va_image.pitches[i],
+                               DRM_FORMAT_MOD_INVALID);
         if (egl_images[i] == NULL)
             goto error;
 
@@ -208,16 +342,14 @@ tc_vaegl_update(const opengl_tex_converter_t *tc, GLuint *textures,
         priv->glEGLImageTargetTexture2DOES(tc->tex_target, egl_images[i]);
     }
 
-    if (pic != priv->last.pic)
-    {
-        if (priv->last.pic != NULL)
-            vaegl_release_last_pic(tc, priv);
-        priv->last.pic = picture_Hold(pic);
-        priv->last.va_image = va_image;
-        priv->last.va_buffer_info = va_buffer_info;
-        for (unsigned i = 0; i < va_image.num_planes; ++i)
-            priv->last.egl_images[i] = egl_images[i];
-    }
+    if (priv->last.pic != NULL)
+        vaegl_release_last_pic(tc, priv);
+    priv->last.pic = picture_Hold(pic);
+    priv->last.num_images = va_image.num_planes;
+    priv->last.va_image = va_image;
+    priv->last.va_buffer_info = va_buffer_info;
+    for (unsigned i = 0; i < va_image.num_planes; ++i)
+        priv->last.egl_images[i] = egl_images[i];
 
     return VLC_SUCCESS;
 
@@ -271,7 +403,8 @@ tc_vaegl_get_pool(const opengl_tex_converter_t *tc, unsigned requested_count)
         EGLint h = (va_image.height * tc->texs[i].h.num) / tc->texs[i].h.den;
         EGLImageKHR egl_image =
             vaegl_image_create(tc, w, h, priv->drm_fourccs[i], va_buffer_info.handle,
-                               va_image.offsets[i], va_image.pitches[i]);
+                               va_image.offsets[i], va_image.pitches[i],
+                               DRM_FORMAT_MOD_INVALID);
         if (egl_image == NULL)
         {
             msg_Warn(o, "Can't create Image KHR: kernel too old ?");
@@ -418,6 +551,11 @@ Open(vlc_object_t *obj)
         goto error;
     priv->fourcc = 0;
     priv->vainst = NULL;
+    priv->has_modifiers =
+        vlc_gl_StrHasToken(eglexts, "EGL_EXT_image_dma_buf_import_modifiers");
+#if VA_CHECK_VERSION(1, 1, 0)
+    priv->export_mode = EXPORT_UNTESTED;
+#endif
 
     int va_fourcc;
     int vlc_sw_chroma;
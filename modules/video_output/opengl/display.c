@@ -213,6 +213,9 @@ static void PictureDisplay (vout_display_t *vd, picture_t *pic, subpicture_t *su
     {
         vout_display_opengl_Display (sys->vgl, &vd->source);
         vlc_gl_ReleaseCurrent (sys->gl);
+        /* The buffer swap returns around the vertical blank when the
+         * EGL/GLX swap interval is on */
+        vout_display_SendEventVsync (vd, vlc_tick_now ());
     }
 
     picture_Release (pic);
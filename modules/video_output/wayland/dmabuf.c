@@ -0,0 +1,490 @@
+/**
+ * @file dmabuf.c
+ * @brief Wayland Linux dmabuf video output module for VLC media player
+ */
+/*****************************************************************************
+ * Copyright © 2018 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <wayland-client.h>
+#include "linux-dmabuf-unstable-v1-client-protocol.h"
+#include "viewporter-client-protocol.h"
+
+#include <va/va_drm.h>
+#include <va/va_drmcommon.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_vout_display.h>
+#include <vlc_picture_pool.h>
+
+#include "../../hw/vaapi/vlc_vaapi.h"
+
+/* No explicit format modifier is conveyed by vaAcquireBufferHandle(), so the
+ * planes are submitted with the implicit (driver-defined) modifier. */
+#define DMABUF_MOD_INVALID_HI UINT32_C(0x00ffffff)
+#define DMABUF_MOD_INVALID_LO UINT32_C(0xffffffff)
+
+/**
+ * A dmabuf-backed compositor buffer wrapping one VA surface.
+ *
+ * The buffer holds a picture reference, and with it the DRM PRIME handle of
+ * the surface, until the compositor signals wl_buffer.release.
+ */
+struct dmabuf_buffer
+{
+    vout_display_t *vd;
+    picture_t *pic; /* held until the compositor releases the buffer */
+    VAImage image;
+    struct wl_buffer *buf;
+    struct dmabuf_buffer *next;
+};
+
+struct vout_display_sys_t
+{
+    vout_window_t *embed; /* VLC window */
+    struct wl_event_queue *eventq;
+    struct zwp_linux_dmabuf_v1 *dmabuf;
+    struct wp_viewporter *viewporter;
+    struct wp_viewport *viewport;
+
+    struct vlc_vaapi_instance *vainst;
+    VADisplay vadpy;
+    VASurfaceID *va_surface_ids;
+    picture_pool_t *pool; /* picture pool */
+
+    uint32_t drm_format;
+    bool format_supported;
+    bool use_buffer_transform;
+    struct dmabuf_buffer *buffers; /* buffers owned by the compositor */
+};
+
+static void DmabufBufferDelete(vout_display_t *vd, struct dmabuf_buffer *db)
+{
+    vout_display_sys_t *sys = vd->sys;
+    struct dmabuf_buffer **pp = &sys->buffers;
+
+    while (*pp != db)
+    {
+        assert(*pp != NULL);
+        pp = &(*pp)->next;
+    }
+    *pp = db->next;
+
+    wl_buffer_destroy(db->buf);
+    vlc_vaapi_ReleaseBufferHandle(VLC_OBJECT(vd), sys->vadpy, db->image.buf);
+    vlc_vaapi_DestroyImage(VLC_OBJECT(vd), sys->vadpy, db->image.image_id);
+    picture_Release(db->pic);
+    free(db);
+}
+
+static void buffer_release_cb(void *data, struct wl_buffer *buffer)
+{
+    struct dmabuf_buffer *db = data;
+
+    assert(db->buf == buffer); (void) buffer;
+    DmabufBufferDelete(db->vd, db);
+}
+
+static const struct wl_buffer_listener buffer_cbs =
+{
+    buffer_release_cb,
+};
+
+static struct dmabuf_buffer *DmabufBufferNew(vout_display_t *vd,
+                                             picture_t *pic)
+{
+    vout_display_sys_t *sys = vd->sys;
+    vlc_object_t *o = VLC_OBJECT(vd);
+
+    struct dmabuf_buffer *db = malloc(sizeof (*db));
+    if (unlikely(db == NULL))
+        return NULL;
+
+    if (vlc_vaapi_DeriveImage(o, sys->vadpy, vlc_vaapi_PicGetSurface(pic),
+                              &db->image))
+    {
+        free(db);
+        return NULL;
+    }
+
+    assert(db->image.format.fourcc == sys->drm_format);
+
+    VABufferInfo buffer_info = {
+        .mem_type = VA_SURFACE_ATTRIB_MEM_TYPE_DRM_PRIME
+    };
+    if (vlc_vaapi_AcquireBufferHandle(o, sys->vadpy, db->image.buf,
+                                      &buffer_info))
+    {
+        vlc_vaapi_DestroyImage(o, sys->vadpy, db->image.image_id);
+        free(db);
+        return NULL;
+    }
+
+    struct zwp_linux_buffer_params_v1 *params =
+        zwp_linux_dmabuf_v1_create_params(sys->dmabuf);
+
+    for (unsigned i = 0; i < db->image.num_planes; i++)
+        zwp_linux_buffer_params_v1_add(params, buffer_info.handle, i,
+                                       db->image.offsets[i],
+                                       db->image.pitches[i],
+                                       DMABUF_MOD_INVALID_HI,
+                                       DMABUF_MOD_INVALID_LO);
+
+    db->buf = zwp_linux_buffer_params_v1_create_immed(params, db->image.width,
+                                                      db->image.height,
+                                                      sys->drm_format, 0);
+    zwp_linux_buffer_params_v1_destroy(params);
+
+    db->vd = vd;
+    db->pic = picture_Hold(pic);
+    db->next = sys->buffers;
+    sys->buffers = db;
+    wl_buffer_add_listener(db->buf, &buffer_cbs, db);
+    return db;
+}
+
+static picture_pool_t *Pool(vout_display_t *vd, unsigned req)
+{
+    vout_display_sys_t *sys = vd->sys;
+
+    if (sys->pool == NULL)
+        sys->pool = vlc_vaapi_PoolNew(VLC_OBJECT(vd), sys->vainst, sys->vadpy,
+                                      req, &sys->va_surface_ids, &vd->fmt,
+                                      true);
+    return sys->pool;
+}
+
+static void Prepare(vout_display_t *vd, picture_t *pic, subpicture_t *subpic,
+                    vlc_tick_t date)
+{
+    VLC_UNUSED(date);
+    vout_display_sys_t *sys = vd->sys;
+    struct wl_display *display = sys->embed->display.wl;
+    struct wl_surface *surface = sys->embed->handle.wl;
+
+    struct dmabuf_buffer *db = DmabufBufferNew(vd, pic);
+    if (db == NULL)
+        return; /* the previous frame remains on the surface */
+
+    wl_surface_attach(surface, db->buf, 0, 0);
+    wl_surface_damage(surface, 0, 0,
+                      vd->cfg->display.width, vd->cfg->display.height);
+    wl_display_flush(display);
+
+    (void) subpic;
+}
+
+static void Display(vout_display_t *vd, picture_t *pic, subpicture_t *subpic)
+{
+    vout_display_sys_t *sys = vd->sys;
+    struct wl_display *display = sys->embed->display.wl;
+    struct wl_surface *surface = sys->embed->handle.wl;
+
+    wl_surface_commit(surface);
+    wl_display_roundtrip_queue(display, sys->eventq);
+
+    (void) pic; (void) subpic;
+}
+
+static void ResizeViewport(vout_display_t *vd, const vout_display_cfg_t *cfg)
+{
+    vout_display_sys_t *sys = vd->sys;
+    video_format_t fmt;
+    vout_display_place_t place;
+
+    video_format_ApplyRotation(&fmt, &vd->source);
+    vout_display_PlacePicture(&place, &vd->source, cfg, false);
+
+    wp_viewport_set_source(sys->viewport,
+                           wl_fixed_from_int(fmt.i_x_offset),
+                           wl_fixed_from_int(fmt.i_y_offset),
+                           wl_fixed_from_int(fmt.i_visible_width),
+                           wl_fixed_from_int(fmt.i_visible_height));
+    wp_viewport_set_destination(sys->viewport, place.width, place.height);
+}
+
+static int Control(vout_display_t *vd, int query, va_list ap)
+{
+    switch (query)
+    {
+        case VOUT_DISPLAY_CHANGE_DISPLAY_SIZE:
+        case VOUT_DISPLAY_CHANGE_DISPLAY_FILLED:
+        case VOUT_DISPLAY_CHANGE_ZOOM:
+        case VOUT_DISPLAY_CHANGE_SOURCE_ASPECT:
+        case VOUT_DISPLAY_CHANGE_SOURCE_CROP:
+        {
+            const vout_display_cfg_t *cfg;
+
+            if (query == VOUT_DISPLAY_CHANGE_SOURCE_ASPECT
+             || query == VOUT_DISPLAY_CHANGE_SOURCE_CROP)
+                cfg = vd->cfg;
+            else
+                cfg = va_arg(ap, const vout_display_cfg_t *);
+
+            ResizeViewport(vd, cfg);
+            break;
+        }
+        default:
+             msg_Err(vd, "unknown request %d", query);
+             return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+static void dmabuf_format_cb(void *data, struct zwp_linux_dmabuf_v1 *dmabuf,
+                             uint32_t format)
+{
+    vout_display_t *vd = data;
+    vout_display_sys_t *sys = vd->sys;
+    char str[4];
+
+    memcpy(str, &format, sizeof (str));
+    msg_Dbg(vd, "format %.4s (0x%08"PRIx32")", str, format);
+
+    if (format == sys->drm_format)
+        sys->format_supported = true;
+    (void) dmabuf;
+}
+
+static void dmabuf_modifier_cb(void *data, struct zwp_linux_dmabuf_v1 *dmabuf,
+                               uint32_t format, uint32_t mod_hi,
+                               uint32_t mod_lo)
+{
+    (void) data; (void) dmabuf; (void) format;
+    (void) mod_hi; (void) mod_lo;
+}
+
+static const struct zwp_linux_dmabuf_v1_listener dmabuf_cbs =
+{
+    dmabuf_format_cb,
+    dmabuf_modifier_cb,
+};
+
+static void registry_global_cb(void *data, struct wl_registry *registry,
+                               uint32_t name, const char *iface, uint32_t vers)
+{
+    vout_display_t *vd = data;
+    vout_display_sys_t *sys = vd->sys;
+
+    msg_Dbg(vd, "global %3"PRIu32": %s version %"PRIu32, name, iface, vers);
+
+    if (!strcmp(iface, "zwp_linux_dmabuf_v1") && vers >= 2)
+        /* Version 2 for zwp_linux_buffer_params_v1.create_immed */
+        sys->dmabuf = wl_registry_bind(registry, name,
+                                       &zwp_linux_dmabuf_v1_interface, 2);
+    else
+    if (!strcmp(iface, "wp_viewporter"))
+        sys->viewporter = wl_registry_bind(registry, name,
+                                           &wp_viewporter_interface, 1);
+    else
+    if (!strcmp(iface, "wl_compositor"))
+        sys->use_buffer_transform = vers >= 2;
+}
+
+static void registry_global_remove_cb(void *data, struct wl_registry *registry,
+                                      uint32_t name)
+{
+    vout_display_t *vd = data;
+
+    msg_Dbg(vd, "global remove %3"PRIu32, name);
+    (void) registry;
+}
+
+static const struct wl_registry_listener registry_cbs =
+{
+    registry_global_cb,
+    registry_global_remove_cb,
+};
+
+static int Open(vlc_object_t *obj)
+{
+    vout_display_t *vd = (vout_display_t *)obj;
+
+    if (!vlc_vaapi_IsChromaOpaque(vd->fmt.i_chroma))
+        return VLC_EGENERIC;
+
+    vout_display_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
+    vd->sys = sys;
+    sys->embed = NULL;
+    sys->eventq = NULL;
+    sys->dmabuf = NULL;
+    sys->viewporter = NULL;
+    sys->viewport = NULL;
+    sys->vainst = NULL;
+    sys->vadpy = NULL;
+    sys->va_surface_ids = NULL;
+    sys->pool = NULL;
+    sys->format_supported = false;
+    sys->use_buffer_transform = false;
+    sys->buffers = NULL;
+
+    /* The VA and DRM FourCC name spaces coincide for these formats. */
+    switch (vd->fmt.i_chroma)
+    {
+        case VLC_CODEC_VAAPI_420:
+            sys->drm_format = VA_FOURCC_NV12;
+            break;
+        case VLC_CODEC_VAAPI_420_10BPP:
+            sys->drm_format = VA_FOURCC_P010;
+            break;
+        default:
+            vlc_assert_unreachable();
+    }
+
+    /* Get window */
+    sys->embed = vout_display_NewWindow(vd, VOUT_WINDOW_TYPE_WAYLAND);
+    if (sys->embed == NULL)
+        goto error;
+
+    struct wl_display *display = sys->embed->display.wl;
+
+    sys->eventq = wl_display_create_queue(display);
+    if (sys->eventq == NULL)
+        goto error;
+
+    struct wl_registry *registry = wl_display_get_registry(display);
+    if (registry == NULL)
+        goto error;
+
+    wl_proxy_set_queue((struct wl_proxy *)registry, sys->eventq);
+    wl_registry_add_listener(registry, &registry_cbs, vd);
+    wl_display_roundtrip_queue(display, sys->eventq);
+    wl_registry_destroy(registry);
+
+    if (sys->dmabuf == NULL)
+    {
+        msg_Dbg(vd, "Linux dmabuf protocol not available");
+        goto error;
+    }
+
+    if (sys->viewporter == NULL)
+    {   /* Cropping and scaling happen in the compositor scan-out path. */
+        msg_Err(vd, "wp_viewporter not available");
+        goto error;
+    }
+
+    zwp_linux_dmabuf_v1_add_listener(sys->dmabuf, &dmabuf_cbs, vd);
+    wl_display_roundtrip_queue(display, sys->eventq);
+
+    if (!sys->format_supported)
+    {
+        msg_Dbg(vd, "DRM format %4.4s not supported by the compositor",
+                (const char *)&sys->drm_format);
+        goto error;
+    }
+
+    sys->vainst = vlc_vaapi_InitializeInstanceDRM(obj, vaGetDisplayDRM,
+                                                  &sys->vadpy, NULL);
+    if (sys->vainst == NULL)
+        goto error;
+
+    struct wl_surface *surface = sys->embed->handle.wl;
+    sys->viewport = wp_viewporter_get_viewport(sys->viewporter, surface);
+    if (sys->viewport == NULL)
+        goto error;
+
+    static const enum wl_output_transform transforms[8] = {
+        [ORIENT_TOP_LEFT] = WL_OUTPUT_TRANSFORM_NORMAL,
+        [ORIENT_TOP_RIGHT] = WL_OUTPUT_TRANSFORM_FLIPPED,
+        [ORIENT_BOTTOM_LEFT] = WL_OUTPUT_TRANSFORM_FLIPPED_180,
+        [ORIENT_BOTTOM_RIGHT] = WL_OUTPUT_TRANSFORM_180,
+        [ORIENT_LEFT_TOP] = WL_OUTPUT_TRANSFORM_FLIPPED_270,
+        [ORIENT_LEFT_BOTTOM] = WL_OUTPUT_TRANSFORM_90,
+        [ORIENT_RIGHT_TOP] = WL_OUTPUT_TRANSFORM_270,
+        [ORIENT_RIGHT_BOTTOM] = WL_OUTPUT_TRANSFORM_FLIPPED_90,
+    };
+
+    if (sys->use_buffer_transform)
+    {
+        wl_surface_set_buffer_transform(surface,
+                                        transforms[vd->fmt.orientation]);
+    }
+    else
+    {
+        video_format_t fmt = vd->fmt;
+        video_format_ApplyRotation(&vd->fmt, &fmt);
+    }
+
+    ResizeViewport(vd, vd->cfg);
+
+    vd->info.has_pictures_invalid = false;
+
+    vd->pool = Pool;
+    vd->prepare = Prepare;
+    vd->display = Display;
+    vd->control = Control;
+
+    return VLC_SUCCESS;
+
+error:
+    if (sys->vainst != NULL)
+        vlc_vaapi_ReleaseInstance(sys->vainst);
+    if (sys->viewporter != NULL)
+        wp_viewporter_destroy(sys->viewporter);
+    if (sys->dmabuf != NULL)
+        zwp_linux_dmabuf_v1_destroy(sys->dmabuf);
+    if (sys->eventq != NULL)
+        wl_event_queue_destroy(sys->eventq);
+    free(sys);
+    return VLC_EGENERIC;
+}
+
+static void Close(vlc_object_t *obj)
+{
+    vout_display_t *vd = (vout_display_t *)obj;
+    vout_display_sys_t *sys = vd->sys;
+    struct wl_display *display = sys->embed->display.wl;
+
+    /* Pick up pending buffer releases, then reclaim whatever the compositor
+     * still holds: the surface is going away along with its last buffer. */
+    wl_display_roundtrip_queue(display, sys->eventq);
+    while (sys->buffers != NULL)
+        DmabufBufferDelete(vd, sys->buffers);
+
+    if (sys->pool != NULL)
+        picture_pool_Release(sys->pool);
+
+    wp_viewport_destroy(sys->viewport);
+    wp_viewporter_destroy(sys->viewporter);
+    zwp_linux_dmabuf_v1_destroy(sys->dmabuf);
+    vlc_vaapi_ReleaseInstance(sys->vainst);
+    wl_display_flush(display);
+    wl_event_queue_destroy(sys->eventq);
+    free(sys);
+}
+
+vlc_module_begin()
+    set_shortname(N_("WL DMABUF"))
+    set_description(N_("Wayland dmabuf video output"))
+    set_category(CAT_VIDEO)
+    set_subcategory(SUBCAT_VIDEO_VOUT)
+    set_capability("vout display", 275)
+    set_callbacks(Open, Close)
+    add_shortcut("wl-dmabuf")
+vlc_module_end()
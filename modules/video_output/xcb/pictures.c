@@ -38,8 +38,13 @@
 
 #include <xcb/xcb.h>
 #include <xcb/shm.h>
+#ifdef XCB_SHM_ATTACH_FD
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
 
 #include <vlc_common.h>
+#include <vlc_fs.h>
 #include <vlc_vout_display.h>
 
 #include "pictures.h"
@@ -68,12 +73,96 @@ bool XCB_shm_Check (vlc_object_t *obj, xcb_connection_t *conn)
     return false;
 }
 
+#ifdef XCB_SHM_ATTACH_FD
+/**
+ * Release picture private data: unmap the file-backed memory.
+ */
+static void XCB_picture_Fd_Destroy (picture_t *pic)
+{
+    xcb_picture_buf_t *buf = (void *)pic->p_sys;
+
+    munmap (pic->p[0].p_pixels, buf->length);
+    free (buf);
+    free (pic);
+}
+
+/** Check whether the X server supports MIT-SHM file descriptor passing */
+static bool XCB_shm_HasFd (xcb_connection_t *conn)
+{
+    xcb_shm_query_version_reply_t *r =
+        xcb_shm_query_version_reply (conn, xcb_shm_query_version (conn), NULL);
+    bool ok = r != NULL
+           && (r->major_version > 1
+            || (r->major_version == 1 && r->minor_version >= 2));
+
+    free (r);
+    return ok;
+}
+
+static int XCB_picture_Fd_Alloc(vout_display_t *vd, picture_resource_t *res,
+                                size_t size, xcb_connection_t *conn,
+                                xcb_shm_seg_t segment)
+{
+    if (segment == 0 || !XCB_shm_HasFd (conn))
+        return -1;
+
+    xcb_picture_buf_t *buf = malloc (sizeof (*buf));
+    if (unlikely(buf == NULL))
+        return -1;
+
+    int fd = vlc_memfd ();
+    if (fd == -1)
+    {
+        free (buf);
+        return -1;
+    }
+
+    if (ftruncate (fd, size))
+    {
+        msg_Err (vd, "shared memory allocation error: %s",
+                 vlc_strerror_c(errno));
+        goto error;
+    }
+
+    void *mem = mmap (NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mem == MAP_FAILED)
+    {
+        msg_Err (vd, "shared memory mapping error: %s", vlc_strerror_c(errno));
+        goto error;
+    }
+
+    /* Pass the segment to X. The file descriptor is consumed by libxcb. */
+    xcb_void_cookie_t ck = xcb_shm_attach_fd_checked (conn, segment, fd, 1);
+    if (vlc_xcb_error_Check(vd, conn, "shared memory server-side error", ck))
+    {
+        munmap (mem, size);
+        free (buf);
+        return -1;
+    }
+
+    buf->segment = segment;
+    buf->length = size;
+    res->p_sys = (void *)buf;
+    res->pf_destroy = XCB_picture_Fd_Destroy;
+    res->p[0].p_pixels = mem;
+    return 0;
+
+error:
+    vlc_close (fd);
+    free (buf);
+    return -1;
+}
+#else
+# define XCB_picture_Fd_Alloc(...) (-1)
+#endif
+
 #ifdef HAVE_SYS_SHM_H
 /**
  * Release picture private data: detach the shared memory segment.
  */
 static void XCB_picture_SysV_Destroy (picture_t *pic)
 {
+    free (pic->p_sys);
     shmdt (pic->p[0].p_pixels);
     free (pic);
 }
@@ -82,12 +171,17 @@ static int XCB_picture_SysV_Alloc(vout_display_t *vd, picture_resource_t *res,
                                   size_t size, xcb_connection_t *conn,
                                   xcb_shm_seg_t segment)
 {
+    xcb_picture_buf_t *buf = malloc (sizeof (*buf));
+    if (unlikely(buf == NULL))
+        return -1;
+
     /* Allocate shared memory segment */
     int id = shmget (IPC_PRIVATE, size, IPC_CREAT | S_IRWXU);
     if (id == -1)
     {
         msg_Err (vd, "shared memory allocation error: %s",
                  vlc_strerror_c(errno));
+        free (buf);
         return -1;
     }
 
@@ -98,6 +192,7 @@ static int XCB_picture_SysV_Alloc(vout_display_t *vd, picture_resource_t *res,
         msg_Err (vd, "shared memory attachment error: %s",
                  vlc_strerror_c(errno));
         shmctl (id, IPC_RMID, 0);
+        free (buf);
         return -1;
     }
 
@@ -131,7 +226,9 @@ static int XCB_picture_SysV_Alloc(vout_display_t *vd, picture_resource_t *res,
 
     shmctl (id, IPC_RMID, NULL);
 
-    res->p_sys = (void *)(uintptr_t)segment;
+    buf->segment = segment;
+    buf->length = 0;
+    res->p_sys = (void *)buf;
     res->pf_destroy = XCB_picture_SysV_Destroy;
     res->p[0].p_pixels = shm;
     return 0;
@@ -155,6 +252,9 @@ int XCB_picture_Alloc (vout_display_t *vd, picture_resource_t *res,
                        size_t size, xcb_connection_t *conn,
                        xcb_shm_seg_t segment)
 {
+    if (XCB_picture_Fd_Alloc(vd, res, size, conn, segment) == 0)
+        return 0;
+
     if (XCB_picture_SysV_Alloc(vd, res, size, conn, segment) == 0)
         return 0;
 
@@ -175,11 +275,22 @@ picture_t *XCB_picture_NewFromResource (const video_format_t *restrict fmt,
     picture_t *pic = picture_NewFromResource (fmt, res);
     if (unlikely(pic == NULL))
     {
-        xcb_shm_seg_t seg = (uintptr_t)res->p_sys;
+        xcb_picture_buf_t *buf = (void *)res->p_sys;
 
-        if (seg != 0)
-            xcb_shm_detach (conn, seg);
-        shmdt (res->p[0].p_pixels);
+        if (buf != NULL)
+        {
+            if (buf->segment != 0)
+                xcb_shm_detach (conn, buf->segment);
+#ifdef XCB_SHM_ATTACH_FD
+            if (buf->length != 0)
+                munmap (res->p[0].p_pixels, buf->length);
+            else
+#endif
+                shmdt (res->p[0].p_pixels);
+            free (buf);
+        }
+        else
+            free (res->p[0].p_pixels);
     }
     return pic;
 }
@@ -37,7 +37,16 @@ picture_t *XCB_picture_NewFromResource (const video_format_t *,
                                         const picture_resource_t *,
                                         xcb_connection_t *);
 
+/** Shared memory picture buffer bookkeeping (see pictures.c) */
+typedef struct
+{
+    xcb_shm_seg_t segment; /**< X11 shared memory segment XID, or 0 */
+    size_t length; /**< Mapping length (FD-passed segments only) */
+} xcb_picture_buf_t;
+
 static inline xcb_shm_seg_t XCB_picture_GetSegment(const picture_t *pic)
 {
-    return (uintptr_t)pic->p_sys;
+    const xcb_picture_buf_t *buf = (const void *)pic->p_sys;
+
+    return (buf != NULL) ? buf->segment : 0;
 }
@@ -29,6 +29,10 @@
 
 #include <xcb/xcb.h>
 #include <xcb/shm.h>
+#ifdef HAVE_XCB_PRESENT
+# include <xcb/xcbext.h>
+# include <xcb/present.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_plugin.h>
@@ -71,6 +75,12 @@ struct vout_display_sys_t
     bool visible; /* whether to draw */
     uint8_t depth; /* useful bits per pixel */
 
+#ifdef HAVE_XCB_PRESENT
+    xcb_special_event_t *present_ev; /**< Present event queue, or NULL */
+    xcb_pixmap_t pixmaps[MAX_PICTURES]; /**< SHM pixmaps for presentation */
+    uint32_t serial; /**< Present request serial number */
+#endif
+
     picture_pool_t *pool; /* picture pool */
 };
 
@@ -108,6 +118,11 @@ static int Open (vlc_object_t *obj)
 
     vd->sys = sys;
     sys->pool = NULL;
+#ifdef HAVE_XCB_PRESENT
+    sys->present_ev = NULL;
+    memset (sys->pixmaps, 0, sizeof (sys->pixmaps));
+    sys->serial = 0;
+#endif
 
     /* Get window, connect to X server */
     xcb_connection_t *conn;
@@ -294,6 +309,40 @@ found_format:;
     else
         sys->seg_base = 0;
 
+#ifdef HAVE_XCB_PRESENT
+    /* With the Present extension, shared pixmaps can be presented at the
+     * next vertical blank rather than copied through PutImage whenever the
+     * server gets to it. */
+    if (sys->seg_base != 0)
+    {
+        const xcb_query_extension_reply_t *ext =
+            xcb_get_extension_data (conn, &xcb_present_id);
+
+        if (ext != NULL && ext->present)
+        {
+            xcb_present_query_version_reply_t *r =
+                xcb_present_query_version_reply (conn,
+                    xcb_present_query_version (conn,
+                        XCB_PRESENT_MAJOR_VERSION, XCB_PRESENT_MINOR_VERSION),
+                    NULL);
+
+            if (r != NULL)
+            {
+                xcb_present_event_t eid = xcb_generate_id (conn);
+
+                xcb_present_select_input (conn, eid, sys->window,
+                    XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY);
+                sys->present_ev =
+                    xcb_register_for_special_xge (conn, &xcb_present_id, eid,
+                                                  NULL);
+                free (r);
+            }
+        }
+        if (sys->present_ev != NULL)
+            msg_Dbg (vd, "using Present extension");
+    }
+#endif
+
     /* Setup vout_display_t once everything is fine */
     vd->info.has_pictures_invalid = true;
 
@@ -321,6 +370,11 @@ static void Close (vlc_object_t *obj)
 
     ResetPictures (vd);
 
+#ifdef HAVE_XCB_PRESENT
+    if (sys->present_ev != NULL)
+        xcb_unregister_for_special_event (sys->conn, sys->present_ev);
+#endif
+
     /* colormap, window and context are garbage-collected by X */
     xcb_disconnect (sys->conn);
     free (sys);
@@ -353,6 +407,7 @@ static picture_pool_t *Pool (vout_display_t *vd, unsigned requested_count)
         return NULL;
 
     assert (pic->i_planes == 1);
+    const unsigned pixel_pitch = pic->p->i_pixel_pitch;
 
     picture_resource_t res = {
         .p = {
@@ -385,8 +440,35 @@ static picture_pool_t *Pool (vout_display_t *vd, unsigned requested_count)
 
     sys->pool = picture_pool_New (count, pic_array);
     if (unlikely(sys->pool == NULL))
+    {
         while (count > 0)
             picture_Release(pic_array[--count]);
+        return NULL;
+    }
+
+#ifdef HAVE_XCB_PRESENT
+    /* The Present extension requires the pixmap and window sizes to match
+     * exactly. A shared pixmap row is always tightly packed, so this is only
+     * possible when the buffer stride equals the window width. */
+    if (sys->present_ev != NULL && sys->seg_base != 0
+     && vd->fmt.i_x_offset == 0
+     && res.p->i_pitch == (int)(place.width * pixel_pitch)
+     && res.p->i_lines >= (int)(vd->fmt.i_y_offset + place.height))
+    {
+        const uint32_t offset = vd->fmt.i_y_offset * res.p->i_pitch;
+
+        for (unsigned i = 0; i < count; i++)
+        {
+            xcb_pixmap_t pixmap = xcb_generate_id (sys->conn);
+
+            xcb_shm_create_pixmap (sys->conn, pixmap, sys->window,
+                                   place.width, place.height, sys->depth,
+                                   sys->seg_base + i, offset);
+            sys->pixmaps[i] = pixmap;
+        }
+        xcb_flush (sys->conn);
+    }
+#endif
     return sys->pool;
 }
 
@@ -403,6 +485,49 @@ static void Display (vout_display_t *vd, picture_t *pic, subpicture_t *subpictur
 
     if (!sys->visible)
         goto out;
+
+#ifdef HAVE_XCB_PRESENT
+    if (segment != 0 && sys->present_ev != NULL
+     && sys->pixmaps[segment - sys->seg_base] != 0)
+    {
+        const uint32_t serial = ++sys->serial;
+
+        ck = xcb_present_pixmap_checked (sys->conn, sys->window,
+                                         sys->pixmaps[segment - sys->seg_base],
+                                         serial, 0 /* valid */, 0 /* update */,
+                                         0, 0, XCB_NONE /* target CRTC */,
+                                         XCB_NONE, XCB_NONE /* fences */,
+                                         XCB_PRESENT_OPTION_NONE,
+                                         0 /* MSC: next field */, 0, 0,
+                                         0, NULL);
+        xcb_flush (sys->conn);
+
+        if (vlc_xcb_error_Check(vd, sys->conn, "cannot present pixmap", ck))
+            goto out;
+
+        /* Wait until the presentation completed (at the next vertical blank
+         * for an unobscured window). Like the PutImage reply below, this
+         * also throttles VLC to the X server; in addition it keeps the
+         * buffer from being overwritten while the server still reads it. */
+        for (;;)
+        {
+            xcb_present_generic_event_t *ev =
+                (xcb_present_generic_event_t *)
+                    xcb_wait_for_special_event (sys->conn, sys->present_ev);
+            if (ev == NULL)
+                break; /* connection failure */
+
+            bool done = ev->evtype == XCB_PRESENT_COMPLETE_NOTIFY
+                && ((xcb_present_complete_notify_event_t *)ev)->serial
+                                                                    == serial;
+            free (ev);
+            if (done)
+                break;
+        }
+        goto out;
+    }
+#endif
+
     if (segment != 0)
         ck = xcb_shm_put_image_checked (sys->conn, sys->window, sys->gc,
           /* real width */ pic->p->i_pitch / pic->p->i_pixel_pitch,
@@ -514,6 +639,15 @@ static void ResetPictures (vout_display_t *vd)
     if (!sys->pool)
         return;
 
+#ifdef HAVE_XCB_PRESENT
+    for (unsigned i = 0; i < MAX_PICTURES; i++)
+        if (sys->pixmaps[i] != 0)
+        {
+            xcb_free_pixmap (sys->conn, sys->pixmaps[i]);
+            sys->pixmaps[i] = 0;
+        }
+#endif
+
     if (sys->seg_base != 0)
         for (unsigned i = 0; i < MAX_PICTURES; i++)
             xcb_shm_detach (sys->conn, sys->seg_base + i);
@@ -42,6 +42,12 @@
 #include <pthread.h>
 #include <sched.h>
 
+/* The profiled lock wrappers redirect here: this file defines the plain
+ * primitives and must not call back into itself. */
+#undef vlc_mutex_lock
+#undef vlc_mutex_unlock
+#undef vlc_cond_wait
+
 /* debug */
 
 #ifndef NDEBUG
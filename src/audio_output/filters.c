@@ -344,8 +344,24 @@ static void aout_FiltersPipelineChangeViewpoint(filter_t *const *filters,
 
 #define AOUT_MAX_FILTERS 10
 
+/** How often the chain statistics are dumped to the debug log */
+#define AOUT_FILTERS_STATS_PERIOD (30 * CLOCK_FREQ)
+
+/**
+ * Per-filter accounting. Only ever touched from the thread calling
+ * aout_FiltersPlay(), i.e. the decoder thread.
+ */
+typedef struct
+{
+    uint64_t buffers; /**< Buffers processed */
+    uint64_t samples_in; /**< Samples submitted to the filter */
+    uint64_t samples_out; /**< Samples produced by the filter */
+    vlc_tick_t spent; /**< Time spent inside the filter callback */
+} aout_filter_stats_t;
+
 struct aout_filters
 {
+    vlc_object_t *obj; /**< Object the chain was created for (logging) */
     filter_t *rate_filter; /**< The filter adjusting samples count
         (either the scaletempo filter or a resampler) */
     filter_t *resampler; /**< The resampler */
@@ -354,8 +370,60 @@ struct aout_filters
     unsigned count; /**< Number of filters */
     filter_t *tab[AOUT_MAX_FILTERS]; /**< Configured user filters
         (e.g. equalization) and their conversions */
+
+    vlc_tick_t stats_deadline; /**< Next periodic statistics dump */
+    aout_filter_stats_t stats[AOUT_MAX_FILTERS]; /**< Accounting for tab */
+    aout_filter_stats_t resampler_stats;
 };
 
+/**
+ * Variant of aout_FiltersPipelinePlay() keeping track of the samples and
+ * time consumed by each filter, so that a filter hoarding latency or CPU
+ * shows up in the logs of a live system.
+ */
+static block_t *aout_FiltersPipelinePlayStats(filter_t *const *filters,
+                                              aout_filter_stats_t *stats,
+                                              unsigned count, block_t *block)
+{
+    for (unsigned i = 0; (i < count) && (block != NULL); i++)
+    {
+        filter_t *filter = filters[i];
+        aout_filter_stats_t *st = stats + i;
+        const vlc_tick_t start = vlc_tick_now ();
+
+        st->buffers++;
+        st->samples_in += block->i_nb_samples;
+        block = filter->pf_audio_filter (filter, block);
+        st->spent += vlc_tick_now () - start;
+        if (block != NULL)
+            st->samples_out += block->i_nb_samples;
+    }
+    return block;
+}
+
+static void aout_FilterDumpStats (vlc_object_t *obj, filter_t *filter,
+                                  const aout_filter_stats_t *st)
+{
+    if (st->buffers == 0)
+        return;
+    msg_Dbg (obj, "audio filter %s (%4.4s->%4.4s): %"PRIu64" buffers, "
+             "%"PRIu64" -> %"PRIu64" samples, %"PRId64" us",
+             module_get_object (filter->p_module),
+             (const char *)&filter->fmt_in.audio.i_format,
+             (const char *)&filter->fmt_out.audio.i_format,
+             st->buffers, st->samples_in, st->samples_out, st->spent);
+}
+
+static void aout_FiltersDumpStats (aout_filters_t *filters)
+{
+    for (unsigned i = 0; i < filters->count; i++)
+        aout_FilterDumpStats (filters->obj, filters->tab[i],
+                              &filters->stats[i]);
+    if (filters->resampler != NULL)
+        aout_FilterDumpStats (filters->obj, filters->resampler,
+                              &filters->resampler_stats);
+}
+
 /** Callback for visualization selection */
 static int VisualizationCallback (vlc_object_t *obj, const char *var,
                                   vlc_value_t oldval, vlc_value_t newval,
@@ -510,10 +578,14 @@ aout_filters_t *aout_FiltersNew (vlc_object_t *obj,
     if (unlikely(filters == NULL))
         return NULL;
 
+    filters->obj = obj;
     filters->rate_filter = NULL;
     filters->resampler = NULL;
     filters->resampling = 0;
     filters->count = 0;
+    filters->stats_deadline = vlc_tick_now () + AOUT_FILTERS_STATS_PERIOD;
+    memset (filters->stats, 0, sizeof (filters->stats));
+    memset (&filters->resampler_stats, 0, sizeof (filters->resampler_stats));
 
     /* Prepare format structure */
     aout_FormatPrint (obj, "input", infmt);
@@ -674,6 +746,7 @@ error:
  */
 void aout_FiltersDelete (vlc_object_t *obj, aout_filters_t *filters)
 {
+    aout_FiltersDumpStats (filters);
     if (filters->resampler != NULL)
         aout_FiltersPipelineDestroy (&filters->resampler, 1);
     aout_FiltersPipelineDestroy (filters->tab, filters->count);
@@ -715,12 +788,15 @@ block_t *aout_FiltersPlay(aout_filters_t *filters, block_t *block, float rate)
         rate_filter->fmt_in.audio.i_rate = lroundf(nominal_rate / rate);
     }
 
-    block = aout_FiltersPipelinePlay (filters->tab, filters->count, block);
+    block = aout_FiltersPipelinePlayStats (filters->tab, filters->stats,
+                                           filters->count, block);
     if (filters->resampler != NULL)
     {   /* NOTE: the resampler needs to run even if resampling is 0.
          * The decoder and output rates can still be different. */
         filters->resampler->fmt_in.audio.i_rate += filters->resampling;
-        block = aout_FiltersPipelinePlay (&filters->resampler, 1, block);
+        block = aout_FiltersPipelinePlayStats (&filters->resampler,
+                                               &filters->resampler_stats,
+                                               1, block);
         filters->resampler->fmt_in.audio.i_rate -= filters->resampling;
     }
 
@@ -729,6 +805,13 @@ block_t *aout_FiltersPlay(aout_filters_t *filters, block_t *block, float rate)
         assert (filters->rate_filter != NULL);
         filters->rate_filter->fmt_in.audio.i_rate = nominal_rate;
     }
+
+    vlc_tick_t now = vlc_tick_now ();
+    if (now >= filters->stats_deadline)
+    {
+        aout_FiltersDumpStats (filters);
+        filters->stats_deadline = now + AOUT_FILTERS_STATS_PERIOD;
+    }
     return block;
 
 drop:
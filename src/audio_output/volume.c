@@ -39,7 +39,7 @@ struct aout_volume
     audio_volume_t object;
     audio_replay_gain_t replay_gain;
     vlc_atomic_float gain_factor;
-    float output_factor;
+    vlc_atomic_float output_factor;
     module_t *module;
 };
 
@@ -58,7 +58,7 @@ aout_volume_t *aout_volume_New(vlc_object_t *parent,
     if (unlikely(vol == NULL))
         return NULL;
     vol->module = NULL;
-    vol->output_factor = 1.f;
+    vlc_atomic_init_float(&vol->output_factor, 1.f);
 
     //audio_volume_t *obj = &vol->object;
 
@@ -119,12 +119,16 @@ void aout_volume_Delete(aout_volume_t *vol)
     vlc_object_release(obj);
 }
 
+/**
+ * Sets the software volume. This can be called concurrently with
+ * aout_volume_Amplify() without blocking the decoder thread.
+ */
 void aout_volume_SetVolume(aout_volume_t *vol, float factor)
 {
     if (unlikely(vol == NULL))
         return;
 
-    vol->output_factor = factor;
+    vlc_atomic_store_float(&vol->output_factor, factor);
 }
 
 /**
@@ -135,7 +139,7 @@ int aout_volume_Amplify(aout_volume_t *vol, block_t *block)
     if (unlikely(vol == NULL) || vol->module == NULL)
         return -1;
 
-    float amp = vol->output_factor
+    float amp = vlc_atomic_load_float (&vol->output_factor)
               * vlc_atomic_load_float (&vol->gain_factor);
 
     vol->object.amplify(&vol->object, block, amp);
@@ -34,6 +34,7 @@
 #include "input_clock.h"
 #include "clock_internal.h"
 #include <assert.h>
+#include <stdatomic.h>
 
 /* TODO:
  * - clean up locking once clock code is stable
@@ -105,15 +106,21 @@
 /* */
 struct input_clock_t
 {
-    /* */
+    /* Writer lock: serializes reference/drift updates. Hot readers
+     * (input_clock_ConvertTS()) do not take it; they validate a snapshot
+     * of the state against the sequence counter below instead. */
     vlc_mutex_t lock;
 
+    /* Sequence counter for lock-free readers: odd while a writer is
+     * modifying the state. */
+    atomic_uint seq;
+
     /* Last point
      * It is used to detect unexpected stream discontinuities */
     clock_point_t last;
 
     /* Maximal timestamp returned by input_clock_ConvertTS (in system unit) */
-    vlc_tick_t i_ts_max;
+    atomic_int_fast64_t i_ts_max;
 
     /* Amount of extra buffering expressed in stream clock */
     vlc_tick_t i_buffering_duration;
@@ -149,6 +156,29 @@ static vlc_tick_t ClockSystemToStream( input_clock_t *, vlc_tick_t i_system );
 
 static vlc_tick_t ClockGetTsOffset( input_clock_t * );
 
+/*****************************************************************************
+ * Writer-side seqlock helpers
+ *****************************************************************************
+ * All state mutations happen between ClockWriteLock() and ClockWriteUnlock(),
+ * which keep the mutex for writer-writer exclusion and flip the sequence
+ * counter so that lock-free readers can detect torn snapshots.
+ *****************************************************************************/
+static void ClockWriteLock( input_clock_t *cl )
+{
+    vlc_mutex_lock( &cl->lock );
+    /* acq_rel: the acquire half keeps the protected writes from being
+     * hoisted above the (now odd) sequence number. */
+    atomic_fetch_add_explicit( &cl->seq, 1, memory_order_acq_rel );
+}
+
+static void ClockWriteUnlock( input_clock_t *cl )
+{
+    /* The release half keeps the protected writes before the (now even
+     * again) sequence number. */
+    atomic_fetch_add_explicit( &cl->seq, 1, memory_order_acq_rel );
+    vlc_mutex_unlock( &cl->lock );
+}
+
 /*****************************************************************************
  * input_clock_New: create a new clock
  *****************************************************************************/
@@ -159,13 +189,14 @@ input_clock_t *input_clock_New( int i_rate )
         return NULL;
 
     vlc_mutex_init( &cl->lock );
+    atomic_init( &cl->seq, 0 );
     cl->b_has_reference = false;
     cl->ref = clock_point_Create( VLC_TICK_INVALID, VLC_TICK_INVALID );
     cl->b_has_external_clock = false;
 
     cl->last = clock_point_Create( VLC_TICK_INVALID, VLC_TICK_INVALID );
 
-    cl->i_ts_max = VLC_TICK_INVALID;
+    atomic_init( &cl->i_ts_max, VLC_TICK_INVALID );
 
     cl->i_buffering_duration = 0;
 
@@ -209,7 +240,7 @@ void input_clock_Update( input_clock_t *cl, vlc_object_t *p_log,
 
     assert( i_ck_stream != VLC_TICK_INVALID && i_ck_system != VLC_TICK_INVALID );
 
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
 
     if( !cl->b_has_reference )
     {
@@ -224,7 +255,8 @@ void input_clock_Update( input_clock_t *cl, vlc_object_t *p_log,
          * warning from the stream control facilities (dd-edited
          * stream ?). */
         msg_Warn( p_log, "clock gap, unexpected stream discontinuity" );
-        cl->i_ts_max = VLC_TICK_INVALID;
+        atomic_store_explicit( &cl->i_ts_max, VLC_TICK_INVALID,
+                               memory_order_relaxed );
 
         /* */
         msg_Warn( p_log, "feeding synchro with a new reference point trying to recover from clock gap" );
@@ -239,8 +271,10 @@ void input_clock_Update( input_clock_t *cl, vlc_object_t *p_log,
 
         /* Feed synchro with a new reference point. */
         cl->b_has_reference = true;
+        const vlc_tick_t i_ts_max =
+            atomic_load_explicit( &cl->i_ts_max, memory_order_relaxed );
         cl->ref = clock_point_Create( i_ck_stream,
-                                      __MAX( cl->i_ts_max + CR_MEAN_PTS_GAP, i_ck_system ) );
+                                      __MAX( i_ts_max + CR_MEAN_PTS_GAP, i_ck_system ) );
         cl->b_has_external_clock = false;
     }
 
@@ -287,7 +321,7 @@ void input_clock_Update( input_clock_t *cl, vlc_object_t *p_log,
         cl->late.i_index = ( cl->late.i_index + 1 ) % INPUT_CLOCK_LATE_COUNT;
     }
 
-    vlc_mutex_unlock( &cl->lock );
+    ClockWriteUnlock( cl );
 }
 
 /*****************************************************************************
@@ -295,14 +329,15 @@ void input_clock_Update( input_clock_t *cl, vlc_object_t *p_log,
  *****************************************************************************/
 void input_clock_Reset( input_clock_t *cl )
 {
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
 
     cl->b_has_reference = false;
     cl->ref = clock_point_Create( VLC_TICK_INVALID, VLC_TICK_INVALID );
     cl->b_has_external_clock = false;
-    cl->i_ts_max = VLC_TICK_INVALID;
+    atomic_store_explicit( &cl->i_ts_max, VLC_TICK_INVALID,
+                           memory_order_relaxed );
 
-    vlc_mutex_unlock( &cl->lock );
+    ClockWriteUnlock( cl );
 }
 
 /*****************************************************************************
@@ -310,7 +345,7 @@ void input_clock_Reset( input_clock_t *cl )
  *****************************************************************************/
 void input_clock_ChangeRate( input_clock_t *cl, int i_rate )
 {
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
 
     if( cl->b_has_reference )
     {
@@ -320,7 +355,7 @@ void input_clock_ChangeRate( input_clock_t *cl, int i_rate )
     }
     cl->i_rate = i_rate;
 
-    vlc_mutex_unlock( &cl->lock );
+    ClockWriteUnlock( cl );
 }
 
 /*****************************************************************************
@@ -328,7 +363,7 @@ void input_clock_ChangeRate( input_clock_t *cl, int i_rate )
  *****************************************************************************/
 void input_clock_ChangePause( input_clock_t *cl, bool b_paused, vlc_tick_t i_date )
 {
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
     assert( (!cl->b_paused) != (!b_paused) );
 
     if( cl->b_paused )
@@ -344,7 +379,7 @@ void input_clock_ChangePause( input_clock_t *cl, bool b_paused, vlc_tick_t i_dat
     cl->i_pause_date = i_date;
     cl->b_paused = b_paused;
 
-    vlc_mutex_unlock( &cl->lock );
+    ClockWriteUnlock( cl );
 }
 
 /*****************************************************************************
@@ -373,14 +408,38 @@ int input_clock_ConvertTS( vlc_object_t *p_object, input_clock_t *cl,
                            vlc_tick_t i_ts_bound )
 {
     assert( pi_ts0 );
-    vlc_mutex_lock( &cl->lock );
+
+    /* Lock-free snapshot of the conversion parameters. This runs for every
+     * ES timestamp, so it must not serialize behind the PCR-update path:
+     * retry while a writer holds the sequence odd or moved it. */
+    bool b_has_reference;
+    int i_rate;
+    clock_point_t ref;
+    vlc_tick_t i_drift, i_buffering, i_pts_delay;
+    unsigned seq;
+
+    do
+    {
+        /* Writers only hold the sequence odd for a handful of stores. */
+        while( ( seq = atomic_load_explicit( &cl->seq,
+                                             memory_order_acquire ) ) & 1 );
+
+        b_has_reference = cl->b_has_reference;
+        i_rate = cl->i_rate;
+        ref = cl->ref;
+        i_drift = AvgGet( &cl->drift );
+        i_buffering = cl->i_buffering_duration;
+        i_pts_delay = cl->i_pts_delay;
+
+        atomic_thread_fence( memory_order_acquire );
+    }
+    while( atomic_load_explicit( &cl->seq, memory_order_relaxed ) != seq );
 
     if( pi_rate )
-        *pi_rate = cl->i_rate;
+        *pi_rate = i_rate;
 
-    if( !cl->b_has_reference )
+    if( !b_has_reference )
     {
-        vlc_mutex_unlock( &cl->lock );
         msg_Err(p_object, "Timestamp conversion failed for %"PRId64": "
                 "no reference clock", *pi_ts0);
         *pi_ts0 = VLC_TICK_INVALID;
@@ -390,27 +449,34 @@ int input_clock_ConvertTS( vlc_object_t *p_object, input_clock_t *cl,
     }
 
     /* */
-    const vlc_tick_t i_ts_buffering = cl->i_buffering_duration * cl->i_rate / INPUT_RATE_DEFAULT;
-    const vlc_tick_t i_ts_delay = cl->i_pts_delay + ClockGetTsOffset( cl );
+    const vlc_tick_t i_ts_buffering = i_buffering * i_rate / INPUT_RATE_DEFAULT;
+    const vlc_tick_t i_ts_delay = i_pts_delay
+        + i_pts_delay * ( i_rate - INPUT_RATE_DEFAULT ) / INPUT_RATE_DEFAULT;
 
     /* */
     if( *pi_ts0 != VLC_TICK_INVALID )
     {
-        *pi_ts0 = ClockStreamToSystem( cl, *pi_ts0 + AvgGet( &cl->drift ) );
-        if( *pi_ts0 > cl->i_ts_max )
-            cl->i_ts_max = *pi_ts0;
+        *pi_ts0 = ( *pi_ts0 + i_drift - ref.i_stream )
+                  * i_rate / INPUT_RATE_DEFAULT + ref.i_system;
+
+        /* Lock-free monotonic maximum */
+        vlc_tick_t i_ts_max = atomic_load_explicit( &cl->i_ts_max,
+                                                    memory_order_relaxed );
+        while( *pi_ts0 > i_ts_max
+            && !atomic_compare_exchange_weak_explicit( &cl->i_ts_max,
+                                                       &i_ts_max, *pi_ts0,
+                                                       memory_order_relaxed,
+                                                       memory_order_relaxed ) );
         *pi_ts0 += i_ts_delay;
     }
 
     /* XXX we do not update i_ts_max on purpose */
     if( pi_ts1 && *pi_ts1 != VLC_TICK_INVALID )
     {
-        *pi_ts1 = ClockStreamToSystem( cl, *pi_ts1 + AvgGet( &cl->drift ) ) +
-                  i_ts_delay;
+        *pi_ts1 = ( *pi_ts1 + i_drift - ref.i_stream )
+                  * i_rate / INPUT_RATE_DEFAULT + ref.i_system + i_ts_delay;
     }
 
-    vlc_mutex_unlock( &cl->lock );
-
     /* Check ts validity */
     if (i_ts_bound != INT64_MAX && *pi_ts0 != VLC_TICK_INVALID) {
         if (*pi_ts0 >= vlc_tick_now() + i_ts_delay + i_ts_buffering + i_ts_bound) {
@@ -442,7 +508,7 @@ int input_clock_GetState( input_clock_t *cl,
                           vlc_tick_t *pi_stream_start, vlc_tick_t *pi_system_start,
                           vlc_tick_t *pi_stream_duration, vlc_tick_t *pi_system_duration )
 {
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
 
     if( !cl->b_has_reference )
     {
@@ -463,7 +529,7 @@ int input_clock_GetState( input_clock_t *cl,
 
 void input_clock_ChangeSystemOrigin( input_clock_t *cl, bool b_absolute, vlc_tick_t i_system )
 {
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
 
     assert( cl->b_has_reference );
     vlc_tick_t i_offset;
@@ -484,7 +550,7 @@ void input_clock_ChangeSystemOrigin( input_clock_t *cl, bool b_absolute, vlc_tic
     cl->ref.i_system += i_offset;
     cl->last.i_system += i_offset;
 
-    vlc_mutex_unlock( &cl->lock );
+    ClockWriteUnlock( cl );
 }
 
 void input_clock_GetSystemOrigin( input_clock_t *cl, vlc_tick_t *pi_system, vlc_tick_t *pi_delay )
@@ -504,7 +570,7 @@ void input_clock_GetSystemOrigin( input_clock_t *cl, vlc_tick_t *pi_system, vlc_
 void input_clock_SetJitter( input_clock_t *cl,
                             vlc_tick_t i_pts_delay, int i_cr_average )
 {
-    vlc_mutex_lock( &cl->lock );
+    ClockWriteLock( cl );
 
     /* Update late observations */
     const vlc_tick_t i_delay_delta = i_pts_delay - cl->i_pts_delay;
@@ -537,7 +603,7 @@ void input_clock_SetJitter( input_clock_t *cl,
     if( cl->drift.i_divider != i_cr_average )
         AvgRescale( &cl->drift, i_cr_average );
 
-    vlc_mutex_unlock( &cl->lock );
+    ClockWriteUnlock( cl );
 }
 
 vlc_tick_t input_clock_GetJitter( input_clock_t *cl )
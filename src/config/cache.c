@@ -0,0 +1,366 @@
+/*****************************************************************************
+ * cache.c: configuration binary cache
+ *****************************************************************************
+ * Copyright (C) 2001-2007 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vlc_common.h>
+#include "../libvlc.h"
+#include <vlc_fs.h>
+#include <vlc_plugin.h>
+
+#include "configuration.h"
+#include "modules/modules.h"
+
+/*
+ * The configuration cache shortcuts the vlcrc text parse, much like the
+ * plugins cache (modules/cache.c) shortcuts plug-in descriptions. It stores
+ * the values of all settings that differ from their built-in defaults, keyed
+ * on the modification time and size of the vlcrc that produced them. It is
+ * (re)written after each successful text parse, and ignored whenever the key
+ * does not match the current vlcrc, the cache was produced by another VLC
+ * version, or it appears corrupt - the text parser is then used as before.
+ */
+
+/** Binary configuration cache file magic/version */
+#define CONFIG_CACHE_STRING "config "PACKAGE_NAME" "PACKAGE_VERSION
+/** Binary configuration cache format version */
+#define CONFIG_CACHE_SUBVERSION_NUM 1
+
+/** Sanity bounds for on-disk string lengths */
+#define CONFIG_CACHE_NAME_MAX  256
+#define CONFIG_CACHE_VALUE_MAX (1 << 20)
+/** On-disk marker for a NULL string value */
+#define CONFIG_CACHE_NULL UINT32_MAX
+
+typedef struct
+{
+    char magic[sizeof (CONFIG_CACHE_STRING)];
+    uint32_t subversion;
+    int64_t mtime; /**< vlcrc modification time */
+    uint64_t size; /**< vlcrc size in bytes */
+} config_cache_header_t;
+
+static char *config_GetCacheFile (void)
+{
+    char *psz_dir = config_GetUserDir (VLC_CACHE_DIR);
+    char *psz_file;
+
+    if (psz_dir == NULL)
+        return NULL;
+    if (asprintf (&psz_file, "%s" DIR_SEP "config.dat", psz_dir) == -1)
+        psz_file = NULL;
+    free (psz_dir);
+    return psz_file;
+}
+
+static int config_CacheRead (FILE *file, void *buf, size_t len)
+{
+    return (fread (buf, 1, len, file) == len) ? 0 : -1;
+}
+
+static int config_CacheWrite (FILE *file, const void *buf, size_t len)
+{
+    return (fwrite (buf, 1, len, file) == len) ? 0 : -1;
+}
+
+#define LOAD(var) \
+    if (config_CacheRead (file, &(var), sizeof (var))) \
+        goto corrupt
+#define SAVE(var) \
+    if (config_CacheWrite (file, &(var), sizeof (var))) \
+        goto error
+#define SAVE_LOCKED(var) \
+    if (config_CacheWrite (file, &(var), sizeof (var))) \
+        goto error_locked
+
+/**
+ * Loads the configuration from the binary cache.
+ *
+ * \param st status of the configuration file the cache must stem from
+ * \return 0 on success, -1 if the cache is missing, stale or invalid (the
+ * caller shall then parse the configuration file as usual).
+ */
+int config_LoadCacheFile (vlc_object_t *p_this, const struct stat *st)
+{
+    char *psz_file = config_GetCacheFile ();
+    if (psz_file == NULL)
+        return -1;
+
+    FILE *file = vlc_fopen (psz_file, "rb");
+    if (file == NULL)
+    {
+        free (psz_file);
+        return -1;
+    }
+
+    config_cache_header_t hdr;
+
+    if (config_CacheRead (file, &hdr, sizeof (hdr))
+     || memcmp (hdr.magic, CONFIG_CACHE_STRING, sizeof (hdr.magic))
+     || hdr.subversion != CONFIG_CACHE_SUBVERSION_NUM
+     || hdr.mtime != (int64_t)st->st_mtime
+     || hdr.size != (uint64_t)st->st_size)
+    {
+        msg_Dbg (p_this, "ignoring stale configuration cache %s", psz_file);
+        fclose (file);
+        free (psz_file);
+        return -1;
+    }
+
+    vlc_rwlock_wrlock (&config_lock);
+    for (;;)
+    {
+        uint32_t class;
+        uint16_t namelen;
+        char name[CONFIG_CACHE_NAME_MAX];
+
+        if (fread (&class, 1, sizeof (class), file) != sizeof (class))
+        {
+            if (feof (file))
+                break; /* done */
+            goto corrupt;
+        }
+        LOAD(namelen);
+        if (namelen == 0 || namelen >= sizeof (name))
+            goto corrupt;
+        if (config_CacheRead (file, name, namelen))
+            goto corrupt;
+        name[namelen] = '\0';
+
+        module_config_t *item = config_FindConfig (name);
+        bool apply = item != NULL && CONFIG_CLASS(item->i_type) == class
+                  && !item->b_unsaveable && !item->b_removed;
+
+        switch (class)
+        {
+            case CONFIG_ITEM_BOOL:
+            case CONFIG_ITEM_INTEGER:
+            {
+                int64_t l;
+
+                LOAD(l);
+                if (apply && l <= item->max.i && l >= item->min.i)
+                    item->value.i = l;
+                break;
+            }
+
+            case CONFIG_ITEM_FLOAT:
+            {
+                float f;
+
+                LOAD(f);
+                if (apply)
+                    item->value.f = f;
+                break;
+            }
+
+            case CONFIG_ITEM_STRING:
+            {
+                uint32_t len;
+                char *psz = NULL;
+
+                LOAD(len);
+                if (len != CONFIG_CACHE_NULL)
+                {
+                    if (len >= CONFIG_CACHE_VALUE_MAX)
+                        goto corrupt;
+                    psz = malloc (len + 1);
+                    if (unlikely(psz == NULL))
+                        goto corrupt;
+                    if (config_CacheRead (file, psz, len))
+                    {
+                        free (psz);
+                        goto corrupt;
+                    }
+                    psz[len] = '\0';
+                }
+                if (apply)
+                {
+                    config_ReleasePsz (item);
+                    item->value.psz = psz;
+                }
+                else
+                    free (psz);
+                break;
+            }
+
+            default:
+                goto corrupt;
+        }
+    }
+    vlc_rwlock_unlock (&config_lock);
+
+    msg_Dbg (p_this, "configuration loaded from cache %s", psz_file);
+    fclose (file);
+    free (psz_file);
+    return 0;
+
+corrupt:
+    /* Partially applied values all stem from a successful parse of the very
+     * same vlcrc, so falling back to the text parser is always safe. */
+    vlc_rwlock_unlock (&config_lock);
+    msg_Warn (p_this, "ignoring corrupt configuration cache %s", psz_file);
+    fclose (file);
+    free (psz_file);
+    return -1;
+}
+
+/**
+ * Saves the in-memory configuration into the binary cache.
+ *
+ * \param st status of the configuration file the values were parsed from
+ * \return 0 on success, -1 on error.
+ */
+int config_SaveCacheFile (vlc_object_t *p_this, const struct stat *st)
+{
+    char *psz_cachedir = config_GetUserDir (VLC_CACHE_DIR);
+    if (psz_cachedir == NULL)
+        return -1;
+    config_CreateDir (p_this, psz_cachedir);
+    free (psz_cachedir);
+
+    char *permanent = config_GetCacheFile ();
+    char *temporary = NULL;
+
+    if (permanent == NULL)
+        return -1;
+    if (asprintf (&temporary, "%s.%u", permanent, getpid ()) == -1)
+    {
+        free (permanent);
+        return -1;
+    }
+
+    FILE *file = vlc_fopen (temporary, "wb");
+    if (file == NULL)
+        goto error;
+
+    const config_cache_header_t hdr =
+    {
+        .magic = CONFIG_CACHE_STRING,
+        .subversion = CONFIG_CACHE_SUBVERSION_NUM,
+        .mtime = st->st_mtime,
+        .size = st->st_size,
+    };
+    SAVE(hdr);
+
+    vlc_rwlock_rdlock (&config_lock);
+    for (vlc_plugin_t *p = vlc_plugins; p != NULL; p = p->next)
+    {
+        module_config_t *item, *end;
+
+        for (item = p->conf.items, end = item + p->conf.size;
+             item < end;
+             item++)
+        {
+            if (!CONFIG_ITEM(item->i_type)
+             || item->b_removed
+             || item->b_unsaveable)
+                continue;
+
+            uint32_t class = CONFIG_CLASS(item->i_type);
+            uint16_t namelen = strlen (item->psz_name);
+
+            if (IsConfigIntegerType (item->i_type))
+            {
+                int64_t l = item->value.i;
+
+                if (l == item->orig.i)
+                    continue; /* default value need not be cached */
+                SAVE_LOCKED(class);
+                SAVE_LOCKED(namelen);
+                if (config_CacheWrite (file, item->psz_name, namelen))
+                    goto error_locked;
+                SAVE_LOCKED(l);
+            }
+            else if (IsConfigFloatType (item->i_type))
+            {
+                float f = item->value.f;
+
+                if (f == item->orig.f)
+                    continue;
+                SAVE_LOCKED(class);
+                SAVE_LOCKED(namelen);
+                if (config_CacheWrite (file, item->psz_name, namelen))
+                    goto error_locked;
+                SAVE_LOCKED(f);
+            }
+            else
+            {
+                const char *psz = item->value.psz;
+
+                assert (IsConfigStringType (item->i_type));
+                if (!strcmp (psz ? psz : "",
+                             item->orig.psz ? item->orig.psz : ""))
+                    continue;
+
+                uint32_t len = (psz != NULL) ? strlen (psz)
+                                             : CONFIG_CACHE_NULL;
+
+                SAVE_LOCKED(class);
+                SAVE_LOCKED(namelen);
+                if (config_CacheWrite (file, item->psz_name, namelen))
+                    goto error_locked;
+                SAVE_LOCKED(len);
+                if (psz != NULL && config_CacheWrite (file, psz, len))
+                    goto error_locked;
+            }
+        }
+    }
+    vlc_rwlock_unlock (&config_lock);
+
+    if (fflush (file) || ferror (file))
+        goto error;
+    fclose (file);
+    file = NULL;
+
+#if defined (_WIN32) || defined (__OS2__)
+    /* Windows cannot overwrite existing files with rename() */
+    vlc_unlink (permanent);
+#endif
+    if (vlc_rename (temporary, permanent))
+    {
+        msg_Warn (p_this, "cannot write configuration cache %s: %s",
+                  permanent, vlc_strerror_c(errno));
+        goto error;
+    }
+
+    msg_Dbg (p_this, "configuration cache saved to %s", permanent);
+    free (temporary);
+    free (permanent);
+    return 0;
+
+error_locked:
+    vlc_rwlock_unlock (&config_lock);
+error:
+    if (file != NULL)
+        fclose (file);
+    vlc_unlink (temporary);
+    free (temporary);
+    free (permanent);
+    return -1;
+}
@@ -34,6 +34,9 @@ void config_Free (module_config_t *, size_t);
 
 int config_LoadCmdLine   ( vlc_object_t *, int, const char *[], int * );
 int config_LoadConfigFile( vlc_object_t * );
+struct stat;
+int config_LoadCacheFile ( vlc_object_t *, const struct stat * );
+int config_SaveCacheFile ( vlc_object_t *, const struct stat * );
 #define config_LoadCmdLine(a,b,c,d) config_LoadCmdLine(VLC_OBJECT(a),b,c,d)
 #define config_LoadConfigFile(a) config_LoadConfigFile(VLC_OBJECT(a))
 bool config_PrintHelp (vlc_object_t *);
@@ -53,6 +56,19 @@ void config_UnsortConfig (void);
 extern vlc_rwlock_t config_lock;
 extern bool config_dirty;
 
+/**
+ * Releases the current value of a string configuration item.
+ *
+ * The value of a string item aliases its default (which lives in the
+ * plug-in descriptor or in the mapped plugins cache) until it is
+ * overridden; only an overridden value is on the heap.
+ */
+static inline void config_ReleasePsz (module_config_t *cfg)
+{
+    if (cfg->value.psz != cfg->orig.psz)
+        free (cfg->value.psz);
+}
+
 bool config_IsSafe (const char *);
 
 /**
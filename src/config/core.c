@@ -150,7 +150,8 @@ void config_PutPsz(const char *psz_name, const char *psz_value)
     config_dirty = true;
     vlc_rwlock_unlock (&config_lock);
 
-    free (oldstr);
+    if (oldstr != p_config->orig.psz)
+        free (oldstr);
 }
 
 void config_PutInt(const char *psz_name, int64_t i_value )
@@ -478,7 +479,7 @@ void config_Free (module_config_t *tab, size_t confsize)
 
         if (IsConfigStringType (p_item->i_type))
         {
-            free (p_item->value.psz);
+            config_ReleasePsz (p_item);
             if (p_item->list_count)
                 free (p_item->list.psz);
         }
@@ -506,9 +507,8 @@ void config_ResetAll(void)
             else
             if (IsConfigStringType (p_config->i_type))
             {
-                free ((char *)p_config->value.psz);
-                p_config->value.psz =
-                        strdupnull (p_config->orig.psz);
+                config_ReleasePsz (p_config);
+                p_config->value.psz = p_config->orig.psz;
             }
         }
     }
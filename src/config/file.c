@@ -173,6 +173,17 @@ int config_LoadConfigFile( vlc_object_t *p_this )
     if (file == NULL)
         return VLC_EGENERIC;
 
+    /* Try the binary cache first: it shortcuts the whole text parse below,
+     * provided it was written from this very revision of the file. */
+    struct stat st;
+    bool b_stat = fstat (fileno (file), &st) == 0;
+
+    if (b_stat && config_LoadCacheFile (p_this, &st) == 0)
+    {
+        fclose (file);
+        return 0;
+    }
+
     /* Skip UTF-8 Byte Order Mark if present */
     char bom[3];
     if (fread (bom, 1, 3, file) != 3 || memcmp (bom, "\xEF\xBB\xBF", 3))
@@ -242,7 +253,7 @@ int config_LoadConfigFile( vlc_object_t *p_this )
                 break;
 
             default:
-                free (item->value.psz);
+                config_ReleasePsz (item);
                 item->value.psz = strdupnull (psz_option_value);
                 break;
         }
@@ -250,7 +261,8 @@ int config_LoadConfigFile( vlc_object_t *p_this )
     vlc_rwlock_unlock (&config_lock);
     free (line);
 
-    if (ferror (file))
+    bool b_error = ferror (file);
+    if (b_error)
     {
         msg_Err (p_this, "error reading configuration: %s",
                  vlc_strerror_c(errno));
@@ -263,6 +275,10 @@ int config_LoadConfigFile( vlc_object_t *p_this )
         uselocale (baseloc);
         freelocale (loc);
     }
+
+    /* Cache the parsed values for the next start-up */
+    if (b_stat && !b_error)
+        config_SaveCacheFile (p_this, &st);
     return 0;
 }
 
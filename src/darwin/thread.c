@@ -42,6 +42,12 @@
 #include <mach/mach_time.h>
 #include <execinfo.h>
 
+/* The profiled lock wrappers redirect here: this file defines the plain
+ * primitives and must not call back into itself. */
+#undef vlc_mutex_lock
+#undef vlc_mutex_unlock
+#undef vlc_cond_wait
+
 static mach_timebase_info_data_t vlc_clock_conversion_factor;
 
 static void vlc_clock_setup_once (void)
@@ -411,6 +411,15 @@ int input_vaControl( input_thread_t *p_input, int i_query, va_list args )
                                    pp_decoder, pp_vout, pp_aout );
         }
 
+        case INPUT_GET_ES_STATS:
+        {
+            input_es_stats_t **pp_stats = va_arg( args, input_es_stats_t ** );
+            size_t *pi_count = va_arg( args, size_t * );
+
+            return es_out_Control( priv->p_es_out_display,
+                                   ES_OUT_GET_ES_STATS, pp_stats, pi_count );
+        }
+
         case INPUT_GET_PCR_SYSTEM:
         {
             vlc_tick_t *pi_system = va_arg( args, vlc_tick_t * );
@@ -42,6 +42,7 @@
 #include <vlc_meta.h>
 #include <vlc_dialog.h>
 #include <vlc_modules.h>
+#include <vlc_tracer.h>
 
 #include "audio_output/aout_internal.h"
 #include "stream_output/stream_output.h"
@@ -96,6 +97,10 @@ struct decoder_owner
     /* fifo */
     block_fifo_t *p_fifo;
 
+    /* Lookahead limits enforced on the paced (demux) side of the fifo */
+    size_t i_fifo_max_depth; /**< Maximum queued blocks before backpressure */
+    size_t i_fifo_max_size;  /**< Maximum queued bytes (unpaced inputs) */
+
     /* Lock for communication with decoder thread */
     vlc_mutex_t lock;
     vlc_cond_t  wait_request;
@@ -1125,6 +1130,8 @@ static void DecoderQueueVideo( decoder_t *p_dec, picture_t *p_pic )
     unsigned i_lost = 0;
     struct decoder_owner *p_owner = dec_get_owner( p_dec );
 
+    vlc_trace_point( "decoder", "out_video", p_pic->date );
+
     DecoderPlayVideo( p_dec, p_pic, &i_lost );
 
     p_owner->pf_update_stat( p_owner, 1, i_lost );
@@ -1249,6 +1256,8 @@ static void DecoderQueueAudio( decoder_t *p_dec, block_t *p_aout_buf )
     unsigned lost = 0;
     struct decoder_owner *p_owner = dec_get_owner( p_dec );
 
+    vlc_trace_point( "decoder", "out_audio", p_aout_buf->i_pts );
+
     DecoderPlayAudio( p_dec, p_aout_buf, &lost );
 
     p_owner->pf_update_stat( p_owner, 1, lost );
@@ -1326,7 +1335,12 @@ static void DecoderDecode( decoder_t *p_dec, block_t *p_block )
 {
     struct decoder_owner *p_owner = dec_get_owner( p_dec );
 
+    /* The decode duration is the timestamp delta between the two points;
+     * the end point carries the decoder return status. */
+    vlc_trace_point( "decoder", "decode_start",
+                     p_block != NULL ? p_block->i_dts : VLC_TICK_INVALID );
     int ret = p_dec->pf_decode( p_dec, p_block );
+    vlc_trace_point( "decoder", "decode_end", ret );
     switch( ret )
     {
         case VLCDEC_SUCCESS:
@@ -1661,6 +1675,9 @@ static void *DecoderThread( void *p_data )
 
         vlc_fifo_Unlock( p_owner->p_fifo );
 
+        if( p_block != NULL )
+            vlc_trace_point( "decoder", "dequeue", p_block->i_dts );
+
         int canc = vlc_savecancel();
         DecoderProcess( p_dec, p_block );
 
@@ -1679,6 +1696,12 @@ static void *DecoderThread( void *p_data )
         {
             p_owner->b_draining = false;
             p_owner->drained = true;
+
+            /* Wake the input thread up instead of letting it poll the ES
+             * output for emptiness. */
+            if( p_owner->p_input != NULL )
+                input_ControlPushHelper( p_owner->p_input,
+                                         INPUT_CONTROL_NOP, NULL );
         }
         vlc_cond_signal( &p_owner->wait_acknowledge );
         vlc_mutex_unlock( &p_owner->lock );
@@ -1784,6 +1807,15 @@ static decoder_t * CreateDecoder( vlc_object_t *p_parent,
         return NULL;
     }
 
+    /* Lookahead depth between the demux and this decoder. Deeper queues
+     * keep slow (e.g. software UHD) decoders from starving at the cost of
+     * latency and memory. */
+    int64_t i_depth = var_InheritInteger( p_dec, "decoder-fifo-blocks" );
+    p_owner->i_fifo_max_depth = (i_depth > 0) ? (size_t)i_depth : 10;
+    int64_t i_size = var_InheritInteger( p_dec, "decoder-fifo-size" );
+    p_owner->i_fifo_max_size = (i_size > 0) ? (size_t)i_size * 1024 * 1024
+                                            : 400 * (size_t)(1024 * 1024);
+
     vlc_mutex_init( &p_owner->lock );
     vlc_mutex_init( &p_owner->mouse_lock );
     vlc_cond_init( &p_owner->wait_request );
@@ -1957,6 +1989,119 @@ static void DeleteDecoder( decoder_t * p_dec )
     vlc_object_release( p_dec );
 }
 
+/**
+ * Checks whether a parked decoder can be revived for the given ES format.
+ *
+ * The codec state (and hardware context, if any) survives the park, so the
+ * match has to be strict: the extradata may carry SPS/PPS the codec relies
+ * upon.
+ */
+bool input_DecoderParkedMatch( decoder_t *p_dec, const es_format_t *p_fmt )
+{
+    struct decoder_owner *p_owner = dec_get_owner( p_dec );
+    const es_format_t *p_key = p_owner->p_packetizer != NULL ?
+        &p_owner->p_packetizer->fmt_in : &p_dec->fmt_in;
+
+    if( p_fmt->i_cat != VIDEO_ES || p_key->i_cat != VIDEO_ES )
+        return false;
+    if( p_fmt->i_codec != p_key->i_codec ||
+        p_fmt->i_profile != p_key->i_profile ||
+        p_fmt->i_level != p_key->i_level ||
+        p_fmt->video.i_width != p_key->video.i_width ||
+        p_fmt->video.i_height != p_key->video.i_height ||
+        !p_fmt->b_packetized != !p_key->b_packetized )
+        return false;
+    if( p_fmt->i_extra != p_key->i_extra ||
+        ( p_fmt->i_extra > 0 &&
+          memcmp( p_fmt->p_extra, p_key->p_extra, p_fmt->i_extra ) ) )
+        return false;
+    return true;
+}
+
+/**
+ * Destroys a decoder parked in the input resources.
+ */
+void input_DecoderParkedDelete( decoder_t *p_dec )
+{
+    DeleteDecoder( p_dec );
+}
+
+/**
+ * Parks an idle decoder into the input resources instead of destroying it,
+ * so that the next item using the same video format revives it with a flush
+ * rather than paying a full module (re)open.
+ *
+ * The decoder thread must already be joined. Returns false if the decoder
+ * cannot or could not be parked; the caller then keeps its ownership.
+ */
+static bool DecoderPark( decoder_t *p_dec )
+{
+    struct decoder_owner *p_owner = dec_get_owner( p_dec );
+
+    if( p_dec->fmt_in.i_cat != VIDEO_ES || p_dec->p_module == NULL ||
+        p_owner->p_sout != NULL || p_owner->error ||
+        atomic_load( &p_owner->reload ) != RELOAD_NO_REQUEST )
+        return false;
+
+    /* Hand the vout back like DeleteDecoder() would */
+    if( p_owner->p_vout != NULL )
+    {
+        /* Reset the cancel state that was set before joining the decoder
+         * thread */
+        vout_Cancel( p_owner->p_vout, false );
+
+        input_resource_RequestVout( p_owner->p_resource,
+            &(vout_configuration_t) { .vout = p_owner->p_vout }, true );
+        p_owner->p_vout = NULL;
+
+        if( p_owner->p_input != NULL )
+            input_SendEventVout( p_owner->p_input );
+    }
+
+    /* Flush instead of rebuilding: this is the whole point of parking */
+    block_FifoEmpty( p_owner->p_fifo );
+    if( p_owner->p_packetizer != NULL &&
+        p_owner->p_packetizer->pf_flush != NULL )
+        p_owner->p_packetizer->pf_flush( p_owner->p_packetizer );
+    if( p_dec->pf_flush != NULL )
+        p_dec->pf_flush( p_dec );
+
+    /* Detach from the dying input and reset the playback state, the same
+     * way CreateDecoder() initializes it */
+    p_owner->p_input = NULL;
+    p_owner->p_clock = NULL;
+    p_owner->i_last_rate = INPUT_RATE_DEFAULT;
+    p_owner->mouse_event = NULL;
+    p_owner->opaque = NULL;
+
+    p_owner->i_preroll_end = (vlc_tick_t)INT64_MIN;
+    p_owner->reset_out_state = false;
+    p_owner->pause_date = VLC_TICK_INVALID;
+    p_owner->rate = 1.f;
+    p_owner->frames_countdown = 0;
+    p_owner->paused = false;
+
+    p_owner->b_waiting = false;
+    p_owner->b_first = true;
+    p_owner->b_has_data = false;
+
+    p_owner->flushing = false;
+    p_owner->b_draining = false;
+    atomic_store( &p_owner->drained, false );
+    p_owner->b_idle = false;
+
+    p_owner->cc.desc.i_608_channels = 0;
+    p_owner->cc.desc.i_708_channels = 0;
+    p_owner->i_ts_delay = 0;
+
+    if( !input_resource_PutDecoder( p_owner->p_resource, p_dec ) )
+        return false;
+
+    msg_Dbg( p_dec, "parking decoder fourcc `%4.4s'",
+             (char*)&p_dec->fmt_in.i_codec );
+    return true;
+}
+
 /* */
 static void DecoderUnsupportedCodec( decoder_t *p_dec, const es_format_t *fmt, bool b_decoding )
 {
@@ -1985,14 +2130,31 @@ static decoder_t *decoder_New( vlc_object_t *p_parent, input_thread_t *p_input,
     const char *psz_type = p_sout ? N_("packetizer") : N_("decoder");
     int i_priority;
 
-    /* Create the decoder configuration structure */
-    p_dec = CreateDecoder( p_parent, p_input, fmt, p_resource, p_sout );
-    if( p_dec == NULL )
+    /* Revive a matching parked decoder instead of opening a new module */
+    if( p_sout == NULL )
+        p_dec = input_resource_GetDecoder( p_resource, fmt );
+
+    if( p_dec != NULL )
     {
-        msg_Err( p_parent, "could not create %s", psz_type );
-        vlc_dialog_display_error( p_parent, _("Streaming / Transcoding failed"),
-            _("VLC could not open the %s module."), vlc_gettext( psz_type ) );
-        return NULL;
+        struct decoder_owner *p_owner = dec_get_owner( p_dec );
+
+        msg_Dbg( p_parent, "reviving parked %4.4s decoder",
+                 (char *)&fmt->i_codec );
+        p_owner->p_input = p_input;
+        /* Let the owner republish the output format and description */
+        p_owner->b_fmt_description = true;
+    }
+    else
+    {
+        /* Create the decoder configuration structure */
+        p_dec = CreateDecoder( p_parent, p_input, fmt, p_resource, p_sout );
+        if( p_dec == NULL )
+        {
+            msg_Err( p_parent, "could not create %s", psz_type );
+            vlc_dialog_display_error( p_parent, _("Streaming / Transcoding failed"),
+                _("VLC could not open the %s module."), vlc_gettext( psz_type ) );
+            return NULL;
+        }
     }
 
     if( !p_dec->p_module )
@@ -2108,8 +2270,9 @@ void input_DecoderDelete( decoder_t *p_dec )
             input_DecoderSetCcState( p_dec, VLC_CODEC_CEA608, i, false );
     }
 
-    /* Delete decoder */
-    DeleteDecoder( p_dec );
+    /* Park the decoder for reuse by an upcoming item, or delete it */
+    if( !DecoderPark( p_dec ) )
+        DeleteDecoder( p_dec );
 }
 
 /**
@@ -2128,8 +2291,8 @@ void input_DecoderDecode( decoder_t *p_dec, block_t *p_block, bool b_do_pace )
     {
         /* FIXME: ideally we would check the time amount of data
          * in the FIFO instead of its size. */
-        /* 400 MiB, i.e. ~ 50mb/s for 60s */
-        if( vlc_fifo_GetBytes( p_owner->p_fifo ) > 400*1024*1024 )
+        /* Default: 400 MiB, i.e. ~ 50mb/s for 60s */
+        if( vlc_fifo_GetBytes( p_owner->p_fifo ) > p_owner->i_fifo_max_size )
         {
             msg_Warn( p_dec, "decoder/packetizer fifo full (data not "
                       "consumed quickly enough), resetting fifo!" );
@@ -2142,10 +2305,12 @@ void input_DecoderDecode( decoder_t *p_dec, block_t *p_block, bool b_do_pace )
     {   /* The FIFO is not consumed when waiting, so pacing would deadlock VLC.
          * Locking is not necessary as b_waiting is only read, not written by
          * the decoder thread. */
-        while( vlc_fifo_GetCount( p_owner->p_fifo ) >= 10 )
+        while( vlc_fifo_GetCount( p_owner->p_fifo )
+                                              >= p_owner->i_fifo_max_depth )
             vlc_fifo_WaitCond( p_owner->p_fifo, &p_owner->wait_fifo );
     }
 
+    vlc_trace_point( "decoder", "queue", p_block->i_dts );
     vlc_fifo_QueueUnlocked( p_owner->p_fifo, p_block );
     vlc_fifo_Unlock( p_owner->p_fifo );
 }
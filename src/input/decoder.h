@@ -32,6 +32,17 @@
 decoder_t *input_DecoderNew( input_thread_t *, es_format_t *, input_clock_t *,
                              sout_instance_t * ) VLC_USED;
 
+/**
+ * This function returns true if a decoder parked in the input resources can
+ * be revived to decode the given ES format.
+ */
+bool input_DecoderParkedMatch( decoder_t *, const es_format_t * );
+
+/**
+ * This function destroys a decoder parked in the input resources.
+ */
+void input_DecoderParkedDelete( decoder_t * );
+
 /**
  * This function changes the pause state.
  * The date parameter MUST hold the exact date at which the change has been
@@ -40,6 +40,7 @@
 #include <vlc_fourcc.h>
 #include <vlc_meta.h>
 #include <vlc_list.h>
+#include <vlc_tracer.h>
 
 #include "input_internal.h"
 #include "../clock/input_clock.h"
@@ -109,6 +110,13 @@ struct es_out_id_t
     /* ID for the meta data */
     int         i_meta_id;
 
+    /* Demux statistics (rates are computed lazily when read) */
+    struct
+    {
+        input_rate_t bitrate;
+        atomic_uintmax_t discontinuities;
+    } stats;
+
     struct vlc_list node;
 
     vlc_mouse_event mouse_event_cb;
@@ -368,6 +376,7 @@ static void EsOutTerminate( es_out_t *out )
         free(es->psz_language);
         free(es->psz_language_code);
         es_format_Clean(&es->fmt);
+        vlc_mutex_destroy(&es->stats.bitrate.lock);
         vlc_list_remove(&es->node);
         free(es);
     }
@@ -1615,6 +1624,8 @@ static es_out_id_t *EsOutAddSlaveLocked( es_out_t *out, const es_format_t *fmt,
     es->p_master = p_master;
     es->mouse_event_cb = NULL;
     es->mouse_event_userdata = NULL;
+    input_rate_Init( &es->stats.bitrate );
+    atomic_init( &es->stats.discontinuities, 0 );
 
     vlc_list_append(&es->node, es->p_master ? &p_sys->es_slaves : &p_sys->es);
 
@@ -2035,45 +2046,43 @@ static void EsOutCreateCCChannels( es_out_t *out, vlc_fourcc_t codec, uint64_t i
  * \param es the es_out_id
  * \param p_block the data block to send
  */
-static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
+static int EsOutSendBatch( es_out_t *out, es_out_id_t *es, block_t *p_chain )
 {
     es_out_sys_t *p_sys = container_of(out, es_out_sys_t, out);
     input_thread_t *p_input = p_sys->p_input;
 
-    assert( p_block->p_next == NULL );
-
     struct input_stats *stats = input_priv(p_input)->stats;
     if( stats != NULL )
     {
-        input_rate_Add( &stats->demux_bitrate, p_block->i_buffer );
+        size_t i_bytes = 0;
 
-        /* Update number of corrupted data packats */
-        if( p_block->i_flags & BLOCK_FLAG_CORRUPTED )
-            atomic_fetch_add_explicit(&stats->demux_corrupted, 1,
-                                      memory_order_relaxed);
+        for( block_t *b = p_chain; b != NULL; b = b->p_next )
+        {
+            i_bytes += b->i_buffer;
+
+            /* Update number of corrupted data packats */
+            if( b->i_flags & BLOCK_FLAG_CORRUPTED )
+                atomic_fetch_add_explicit(&stats->demux_corrupted, 1,
+                                          memory_order_relaxed);
 
-        /* Update number of discontinuities */
-        if( p_block->i_flags & BLOCK_FLAG_DISCONTINUITY )
-            atomic_fetch_add_explicit(&stats->demux_discontinuity, 1,
-                                      memory_order_relaxed);
+            /* Update number of discontinuities */
+            if( b->i_flags & BLOCK_FLAG_DISCONTINUITY )
+            {
+                atomic_fetch_add_explicit(&stats->demux_discontinuity, 1,
+                                          memory_order_relaxed);
+                atomic_fetch_add_explicit(&es->stats.discontinuities, 1,
+                                          memory_order_relaxed);
+            }
+        }
+        input_rate_Add( &stats->demux_bitrate, i_bytes );
+        input_rate_Add( &es->stats.bitrate, i_bytes );
     }
 
     vlc_mutex_lock( &p_sys->lock );
 
-    /* Mark preroll blocks */
-    if( p_sys->i_preroll_end >= 0 )
-    {
-        vlc_tick_t i_date = p_block->i_pts;
-        if( p_block->i_pts == VLC_TICK_INVALID )
-            i_date = p_block->i_dts;
-
-        if( i_date + p_block->i_length < p_sys->i_preroll_end )
-            p_block->i_flags |= BLOCK_FLAG_PREROLL;
-    }
-
     if( !es->p_dec )
     {
-        block_Release( p_block );
+        block_ChainRelease( p_chain );
         vlc_mutex_unlock( &p_sys->lock );
         return VLC_SUCCESS;
     }
@@ -2096,16 +2105,34 @@ static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
         }
     }
 
-    /* Decode */
-    if( es->p_dec_record )
+    for( block_t *p_block = p_chain, *p_next; p_block != NULL;
+         p_block = p_next )
     {
-        block_t *p_dup = block_Duplicate( p_block );
-        if( p_dup )
-            input_DecoderDecode( es->p_dec_record, p_dup,
-                                 input_priv(p_input)->b_out_pace_control );
+        p_next = p_block->p_next;
+        p_block->p_next = NULL;
+
+        /* Mark preroll blocks */
+        if( p_sys->i_preroll_end >= 0 )
+        {
+            vlc_tick_t i_date = p_block->i_pts;
+            if( p_block->i_pts == VLC_TICK_INVALID )
+                i_date = p_block->i_dts;
+
+            if( i_date + p_block->i_length < p_sys->i_preroll_end )
+                p_block->i_flags |= BLOCK_FLAG_PREROLL;
+        }
+
+        /* Decode */
+        if( es->p_dec_record )
+        {
+            block_t *p_dup = block_Duplicate( p_block );
+            if( p_dup )
+                input_DecoderDecode( es->p_dec_record, p_dup,
+                                     input_priv(p_input)->b_out_pace_control );
+        }
+        input_DecoderDecode( es->p_dec, p_block,
+                             input_priv(p_input)->b_out_pace_control );
     }
-    input_DecoderDecode( es->p_dec, p_block,
-                         input_priv(p_input)->b_out_pace_control );
 
     es_format_t fmt_dsc;
     vlc_meta_t  *p_meta_dsc;
@@ -2133,6 +2160,13 @@ static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
     return VLC_SUCCESS;
 }
 
+static int EsOutSend( es_out_t *out, es_out_id_t *es, block_t *p_block )
+{
+    assert( p_block->p_next == NULL );
+    vlc_trace_point( "es_out", "send", p_block->i_dts );
+    return EsOutSendBatch( out, es, p_block );
+}
+
 static void
 EsDrainDecoder( es_out_t *out, es_out_id_t *es )
 {
@@ -2221,6 +2255,8 @@ static void EsOutDelLocked( es_out_t *out, es_out_id_t *es )
 
     es_format_Clean( &es->fmt );
 
+    vlc_mutex_destroy( &es->stats.bitrate.lock );
+
     free( es );
 }
 
@@ -2763,6 +2799,43 @@ static int EsOutVaControlLocked( es_out_t *out, int i_query, va_list args )
         return VLC_SUCCESS;
     }
 
+    case ES_OUT_GET_ES_STATS:
+    {
+        input_es_stats_t **pp_stats = va_arg( args, input_es_stats_t ** );
+        size_t *pi_count = va_arg( args, size_t * );
+        es_out_id_t *es;
+        size_t i_count = 0;
+
+        foreach_es_then_es_slaves(es)
+            i_count++;
+
+        input_es_stats_t *p_stats = vlc_alloc( i_count, sizeof( *p_stats ) );
+        if( i_count > 0 && p_stats == NULL )
+            return VLC_ENOMEM;
+
+        size_t i = 0;
+        foreach_es_then_es_slaves(es)
+        {
+            input_es_stats_t *st = &p_stats[i++];
+            uintmax_t i_bytes;
+
+            st->i_id = es->i_meta_id;
+            st->i_cat = es->fmt.i_cat;
+            input_rate_Read( &es->stats.bitrate, &i_bytes,
+                             &st->f_demux_bitrate );
+            st->i_demux_bytes = i_bytes;
+            st->i_discontinuities =
+                atomic_load_explicit( &es->stats.discontinuities,
+                                      memory_order_relaxed );
+            st->i_fifo_bytes = es->p_dec != NULL ?
+                               input_DecoderGetFifoSize( es->p_dec ) : 0;
+        }
+
+        *pp_stats = p_stats;
+        *pi_count = i_count;
+        return VLC_SUCCESS;
+    }
+
     case ES_OUT_GET_BUFFERING:
     {
         bool *pb = va_arg( args, bool* );
@@ -2986,6 +3059,7 @@ static const struct es_out_callbacks es_out_cbs =
 {
     .add = EsOutAdd,
     .send = EsOutSend,
+    .send_batch = EsOutSendBatch,
     .del = EsOutDel,
     .control = EsOutControl,
     .destroy = EsOutDelete,
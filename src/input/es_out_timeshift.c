@@ -162,6 +162,18 @@ typedef struct attribute_packed
     } u;
 } ts_cmd_t;
 
+/* On-disk layout of a spilled block: only the fields replayed on pop, not
+ * the whole block_t with its live pointers. */
+typedef struct
+{
+    size_t     i_buffer;
+    uint32_t   i_flags;
+    unsigned   i_nb_samples;
+    vlc_tick_t i_dts;
+    vlc_tick_t i_pts;
+    vlc_tick_t i_length;
+} ts_storage_block_t;
+
 typedef struct ts_storage_t ts_storage_t;
 struct ts_storage_t
 {
@@ -175,6 +187,7 @@ struct ts_storage_t
     int64_t i_file_size;/* Current size in bytes */
     FILE    *p_filew;   /* FILE handle for data writing */
     FILE    *p_filer;   /* FILE handle for data reading */
+    long    i_read_offset; /* Current p_filer position (to elide seeks) */
 
     /* */
     int      i_cmd_r;
@@ -1141,6 +1154,12 @@ static ts_storage_t *TsStorageNew( const char *psz_tmp_path, int64_t i_tmp_size_
         goto error;
     }
 
+    /* Spilled blocks stream through at media bitrate; the default stdio
+     * buffers would cost a system call every few KiB. */
+    setvbuf( p_storage->p_filew, NULL, _IOFBF, 256 * 1024 );
+    setvbuf( p_storage->p_filer, NULL, _IOFBF, 256 * 1024 );
+    p_storage->i_read_offset = 0;
+
 #ifndef _WIN32
     vlc_unlink( psz_file );
     free( psz_file );
@@ -1209,7 +1228,7 @@ static bool TsStorageIsFull( ts_storage_t *p_storage, const ts_cmd_t *p_cmd )
 {
     if( p_cmd && p_cmd->i_type == C_SEND && p_storage->i_cmd_w > 0 )
     {
-        size_t i_size = sizeof(*p_cmd->u.send.p_block) + p_cmd->u.send.p_block->i_buffer;
+        size_t i_size = sizeof(ts_storage_block_t) + p_cmd->u.send.p_block->i_buffer;
 
         if( p_storage->i_file_size + i_size >= p_storage->i_file_max )
             return true;
@@ -1229,16 +1248,24 @@ static void TsStoragePushCmd( ts_storage_t *p_storage, const ts_cmd_t *p_cmd, bo
     if( cmd.i_type == C_SEND )
     {
         block_t *p_block = cmd.u.send.p_block;
+        ts_storage_block_t header = {
+            .i_buffer     = p_block->i_buffer,
+            .i_flags      = p_block->i_flags,
+            .i_nb_samples = p_block->i_nb_samples,
+            .i_dts        = p_block->i_dts,
+            .i_pts        = p_block->i_pts,
+            .i_length     = p_block->i_length,
+        };
 
         cmd.u.send.p_block = NULL;
         cmd.u.send.i_offset = ftell( p_storage->p_filew );
 
-        if( fwrite( p_block, sizeof(*p_block), 1, p_storage->p_filew ) != 1 )
+        if( fwrite( &header, sizeof(header), 1, p_storage->p_filew ) != 1 )
         {
             block_Release( p_block );
             return;
         }
-        p_storage->i_file_size += sizeof(*p_block);
+        p_storage->i_file_size += sizeof(header);
         if( p_block->i_buffer > 0 )
         {
             if( fwrite( p_block->p_buffer, p_block->i_buffer, 1, p_storage->p_filew ) != 1 )
@@ -1262,27 +1289,33 @@ static void TsStoragePopCmd( ts_storage_t *p_storage, ts_cmd_t *p_cmd, bool b_fl
     *p_cmd = p_storage->p_cmd[p_storage->i_cmd_r++];
     if( p_cmd->i_type == C_SEND )
     {
-        block_t block;
+        ts_storage_block_t header;
 
+        /* Replay is normally sequential: seeking would only discard the
+         * stdio read-ahead buffer. */
         if( !b_flush &&
-            !fseek( p_storage->p_filer, p_cmd->u.send.i_offset, SEEK_SET ) &&
-            fread( &block, sizeof(block), 1, p_storage->p_filer ) == 1 )
+            ( p_storage->i_read_offset == p_cmd->u.send.i_offset ||
+              !fseek( p_storage->p_filer, p_cmd->u.send.i_offset, SEEK_SET ) ) &&
+            fread( &header, sizeof(header), 1, p_storage->p_filer ) == 1 )
         {
-            block_t *p_block = block_Alloc( block.i_buffer );
+            block_t *p_block = block_Alloc( header.i_buffer );
             if( p_block )
             {
-                p_block->i_dts      = block.i_dts;
-                p_block->i_pts      = block.i_pts;
-                p_block->i_flags    = block.i_flags;
-                p_block->i_length   = block.i_length;
-                p_block->i_nb_samples = block.i_nb_samples;
-                p_block->i_buffer = fread( p_block->p_buffer, 1, block.i_buffer, p_storage->p_filer );
+                p_block->i_dts      = header.i_dts;
+                p_block->i_pts      = header.i_pts;
+                p_block->i_flags    = header.i_flags;
+                p_block->i_length   = header.i_length;
+                p_block->i_nb_samples = header.i_nb_samples;
+                p_block->i_buffer = fread( p_block->p_buffer, 1, header.i_buffer, p_storage->p_filer );
             }
+            p_storage->i_read_offset = ftell( p_storage->p_filer );
             p_cmd->u.send.p_block = p_block;
         }
         else
         {
             //perror( "TsStoragePopCmd" );
+            if( !b_flush )
+                p_storage->i_read_offset = -1; /* force a seek next time */
             p_cmd->u.send.p_block = block_Alloc( 1 );
         }
     }
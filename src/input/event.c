@@ -59,6 +59,17 @@ void input_SendEventCapabilities( input_thread_t *p_input, int i_capabilities )
 void input_SendEventPosition( input_thread_t *p_input, double f_position,
                               vlc_tick_t i_time )
 {
+    input_thread_private_t *priv = input_priv(p_input);
+
+    /* The demux is polled at a much higher rate than the values change
+     * (paused or still streams); only the latest value matters, so spare
+     * the interfaces a callback for duplicates */
+    if( f_position == priv->f_last_event_position &&
+        i_time == priv->i_last_event_time )
+        return;
+    priv->f_last_event_position = f_position;
+    priv->i_last_event_time = i_time;
+
     input_SendEvent( p_input, &(struct vlc_input_event) {
         .type = INPUT_EVENT_POSITION,
         .position = { f_position, i_time }
@@ -66,7 +77,14 @@ void input_SendEventPosition( input_thread_t *p_input, double f_position,
 }
 void input_SendEventLength( input_thread_t *p_input, vlc_tick_t i_length )
 {
-    input_item_SetDuration( input_priv(p_input)->p_item, i_length );
+    input_thread_private_t *priv = input_priv(p_input);
+
+    /* The length is reported on every time update but rarely changes */
+    if( i_length == priv->i_last_event_length )
+        return;
+    priv->i_last_event_length = i_length;
+
+    input_item_SetDuration( priv->p_item, i_length );
     input_SendEvent( p_input, &(struct vlc_input_event) {
         .type = INPUT_EVENT_LENGTH,
         .length = i_length,
@@ -145,6 +163,15 @@ void input_SendEventState( input_thread_t *p_input, int i_state )
 
 void input_SendEventCache( input_thread_t *p_input, double f_level )
 {
+    input_thread_private_t *priv = input_priv(p_input);
+
+    /* The buffering level is recomputed on every block sent while
+     * buffering; a 0.1% granularity is plenty for display purposes */
+    int i_level = (int)(f_level * 1000);
+    if( i_level == priv->i_last_event_cache )
+        return;
+    priv->i_last_event_cache = i_level;
+
     input_SendEvent( p_input, &(struct vlc_input_event) {
         .type = INPUT_EVENT_CACHE,
         .cache = f_level
@@ -76,23 +76,36 @@ static inline void info_category_ReplaceInfo(info_category_t *cat,
     vlc_list_append(&info->node, &cat->infos);
 }
 
-static inline info_t *info_category_VaAddInfo(info_category_t *cat,
-                                              const char *name,
-                                              const char *format, va_list args)
+/* Takes ownership of the (heap-allocated) value, so that callers can render
+   it before acquiring whatever lock protects the category. */
+static inline info_t *info_category_SetInfo(info_category_t *cat,
+                                            const char *name, char *value)
 {
     info_t *info = info_category_FindInfo(cat, name);
     if (!info) {
         info = info_New(name);
-        if (!info)
+        if (!info) {
+            free(value);
             return NULL;
+        }
         vlc_list_append(&info->node, &cat->infos);
     } else
         free(info->psz_value);
-    if (vasprintf(&info->psz_value, format, args) == -1)
-        info->psz_value = NULL;
+    info->psz_value = value;
     return info;
 }
 
+static inline info_t *info_category_VaAddInfo(info_category_t *cat,
+                                              const char *name,
+                                              const char *format, va_list args)
+{
+    char *value;
+
+    if (vasprintf(&value, format, args) == -1)
+        value = NULL;
+    return info_category_SetInfo(cat, name, value);
+}
+
 static inline info_t *info_category_AddInfo(info_category_t *cat,
                                             const char *name,
                                             const char *format, ...)
@@ -338,6 +338,10 @@ static input_thread_t *Create( vlc_object_t *p_parent,
     priv->b_can_pace_control = true;
     priv->i_start = 0;
     priv->i_time  = 0;
+    priv->f_last_event_position = -1.0;
+    priv->i_last_event_time = -1;
+    priv->i_last_event_length = -1;
+    priv->i_last_event_cache = -1;
     priv->i_stop  = 0;
     priv->i_title = 0;
     priv->title = NULL;
@@ -754,7 +758,10 @@ static void MainLoop( input_thread_t *p_input, bool b_interactive )
             else if( !es_out_GetEmpty( input_priv(p_input)->p_es_out ) )
             {
                 msg_Dbg( p_input, "waiting decoder fifos to empty" );
-                i_wakeup = vlc_tick_now() + INPUT_IDLE_SLEEP;
+                /* Decoders wake this thread up (INPUT_CONTROL_NOP) once they
+                 * have drained; the timed wakeup is only a safety net for
+                 * output buffers still queued past the decoders. */
+                i_wakeup = vlc_tick_now() + 4 * INPUT_IDLE_SLEEP;
             }
             /* Pause after eof only if the input is pausable.
              * This way we won't trigger timeshifting for nothing */
@@ -983,6 +990,74 @@ static bool SlaveExists( input_item_slave_t **pp_slaves, int i_slaves,
     return false;
 }
 
+struct slaves_detect_data
+{
+    input_thread_t *p_input;    /* held while the thread runs */
+    char           *psz_autopath;
+    char           *psz_uri;    /* media URI to base the search on */
+    char           *psz_forced_uri; /* already forced via sub-file, or NULL */
+    bool            b_spu_forced; /* a subtitle track was already forced */
+};
+
+/* Scan the directory of the played media for matching subtitle files. This
+ * stats every directory entry and can take seconds on network shares, hence
+ * it runs on its own (detached) thread and the discovered tracks are
+ * attached through the input control queue when ready. */
+static void *SlavesDetectThread( void *data )
+{
+    struct slaves_detect_data *p_sd = data;
+    input_thread_t *p_input = p_sd->p_input;
+    input_item_t *p_item = input_priv(p_input)->p_item;
+    input_item_slave_t **pp_slaves;
+    int i_slaves;
+    TAB_INIT( i_slaves, pp_slaves );
+
+    subtitles_Detect( p_input, p_sd->psz_autopath, p_sd->psz_uri,
+                      &pp_slaves, &i_slaves );
+
+    if( i_slaves > 0 )
+        qsort( pp_slaves, i_slaves, sizeof (input_item_slave_t*),
+               SlaveCompare );
+
+    bool b_forced = p_sd->b_spu_forced;
+    for( int i = 0; i < i_slaves && pp_slaves[i] != NULL; i++ )
+    {
+        input_item_slave_t *p_slave = pp_slaves[i];
+
+        /* Reject subtitles already added through sub-file or the item */
+        bool b_exists = p_sd->psz_forced_uri != NULL
+                     && !strcmp( p_sd->psz_forced_uri, p_slave->psz_uri );
+        if( !b_exists )
+        {
+            vlc_mutex_lock( &p_item->lock );
+            b_exists = SlaveExists( p_item->pp_slaves, p_item->i_slaves,
+                                    p_slave->psz_uri );
+            vlc_mutex_unlock( &p_item->lock );
+        }
+        if( b_exists )
+        {
+            input_item_slave_Delete( p_slave );
+            continue;
+        }
+
+        /* Select only the first (best) detected track, as the synchronous
+         * slave loading loop does */
+        p_slave->b_forced = !b_forced;
+        b_forced = true;
+
+        vlc_value_t val = { .p_address = p_slave };
+        input_ControlPushHelper( p_input, INPUT_CONTROL_ADD_SLAVE, &val );
+    }
+    TAB_CLEAN( i_slaves, pp_slaves );
+
+    vlc_object_release( p_input );
+    free( p_sd->psz_autopath );
+    free( p_sd->psz_uri );
+    free( p_sd->psz_forced_uri );
+    free( p_sd );
+    return NULL;
+}
+
 static void SetSubtitlesOptions( input_thread_t *p_input )
 {
     /* Get fps and set it if not already set */
@@ -1071,32 +1146,8 @@ static void LoadSlaves( input_thread_t *p_input )
         }
     }
 
-    if( var_GetBool( p_input, "sub-autodetect-file" ) )
-    {
-        /* Add local subtitles */
-        char *psz_autopath = var_GetNonEmptyString( p_input, "sub-autodetect-path" );
-
-        if( subtitles_Detect( p_input, psz_autopath, input_priv(p_input)->p_item->psz_uri,
-                              &pp_slaves, &i_slaves ) == VLC_SUCCESS )
-        {
-            /* check that we did not add the subtitle through sub-file */
-            if( psz_subtitle != NULL )
-            {
-                for( int i = 1; i < i_slaves; i++ )
-                {
-                    input_item_slave_t *p_curr = pp_slaves[i];
-                    if( p_curr != NULL
-                     && !strcmp( psz_subtitle, p_curr->psz_uri ) )
-                    {
-                        /* reject current sub */
-                        input_item_slave_Delete( p_curr );
-                        pp_slaves[i] = NULL;
-                    }
-                }
-            }
-        }
-        free( psz_autopath );
-    }
+    /* The local subtitle files scan is asynchronous, see below */
+    char *psz_forced_uri = psz_subtitle ? strdup( psz_subtitle ) : NULL;
 
     /* Add slaves found by the directory demuxer or via libvlc */
     input_item_t *p_item = input_priv(p_input)->p_item;
@@ -1155,6 +1206,29 @@ static void LoadSlaves( input_thread_t *p_input )
     }
     TAB_CLEAN( i_slaves, pp_slaves );
 
+    /* Look for local subtitle files off the open path: scanning the media
+     * directory stats every entry and must not delay the first frame */
+    if( var_GetBool( p_input, "sub-autodetect-file" ) )
+    {
+        struct slaves_detect_data *p_sd = malloc( sizeof (*p_sd) );
+        if( likely(p_sd != NULL) )
+        {
+            p_sd->p_input = vlc_object_hold( p_input );
+            p_sd->psz_autopath = var_GetNonEmptyString( p_input,
+                                                        "sub-autodetect-path" );
+            const char *psz_uri = input_priv(p_input)->p_item->psz_uri;
+            p_sd->psz_uri = psz_uri ? strdup( psz_uri ) : NULL;
+            p_sd->psz_forced_uri = psz_forced_uri;
+            p_sd->b_spu_forced = p_forced[SLAVE_TYPE_SPU];
+            psz_forced_uri = NULL;
+
+            if( vlc_clone_detach( NULL, SlavesDetectThread, p_sd,
+                                  VLC_THREAD_PRIORITY_LOW ) )
+                SlavesDetectThread( p_sd ); /* fall back to a blocking scan */
+        }
+    }
+    free( psz_forced_uri );
+
     /* Load subtitles from attachments */
     int i_attachment = 0;
     input_attachment_t **pp_attachment = NULL;
@@ -2302,6 +2376,9 @@ static bool Control( input_thread_t *p_input,
             ControlNav( p_input, i_type );
             break;
 
+        case INPUT_CONTROL_NOP:
+            break;
+
         default:
             msg_Err( p_input, "not yet implemented" );
             break;
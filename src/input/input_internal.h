@@ -124,6 +124,13 @@ typedef struct input_thread_private_t
     vlc_tick_t  i_stop;     /* :stop-time, 0 if none */
     vlc_tick_t  i_time;     /* Current time */
 
+    /* Latest values sent through events_cb, used to coalesce the
+     * high-rate position/length/cache events (see event.c) */
+    double      f_last_event_position;
+    vlc_tick_t  i_last_event_time;
+    vlc_tick_t  i_last_event_length;
+    int         i_last_event_cache;
+
     /* Output */
     bool            b_out_pace_control; /* XXX Move it ot es_sout ? */
     sout_instance_t *p_sout;            /* Idem ? */
@@ -192,6 +199,10 @@ static inline input_thread_private_t *input_priv(input_thread_t *input)
  ***************************************************************************/
 enum input_control_e
 {
+    /* No-op: only wakes up the input thread so that it re-evaluates its
+     * state (e.g. a decoder reporting that it finished draining). */
+    INPUT_CONTROL_NOP,
+
     INPUT_CONTROL_SET_STATE,
 
     INPUT_CONTROL_SET_RATE,
@@ -315,7 +326,10 @@ struct input_stats {
 
 struct input_stats *input_stats_Create(void);
 void input_stats_Destroy(struct input_stats *);
+void input_rate_Init(input_rate_t *);
 void input_rate_Add(input_rate_t *, uintmax_t);
+void input_rate_Read(input_rate_t *, uintmax_t *restrict total,
+                     float *restrict bitrate);
 void input_stats_Compute(struct input_stats *, input_stats_t*);
 
 #endif
@@ -261,9 +261,8 @@ char *input_item_GetMeta( input_item_t *p_i, vlc_meta_type_t meta_type )
         return NULL;
     }
 
-    char *psz = NULL;
-    if( vlc_meta_Get( p_i->p_meta, meta_type ) )
-        psz = strdup( vlc_meta_Get( p_i->p_meta, meta_type ) );
+    const char *psz_value = vlc_meta_Get( p_i->p_meta, meta_type );
+    char *psz = psz_value ? strdup( psz_value ) : NULL;
 
     vlc_mutex_unlock( &p_i->lock );
     return psz;
@@ -745,20 +744,33 @@ static int InputItemVaAddInfo( input_item_t *p_i,
                                const char *psz_name,
                                const char *psz_format, va_list args )
 {
-    vlc_assert_locked( &p_i->lock );
+    /* Render the value before taking the item lock: the formatting and its
+     * allocation are the expensive part of an info update, and keeping them
+     * outside shortens the window during which meta/info readers (the
+     * interfaces) are blocked. */
+    char *psz_value;
+    if( unlikely(vasprintf( &psz_value, psz_format, args ) == -1) )
+        return VLC_ENOMEM;
+
+    vlc_mutex_lock( &p_i->lock );
 
     info_category_t *p_cat = InputItemFindCat( p_i, NULL, psz_cat );
     if( !p_cat )
     {
         p_cat = info_category_New( psz_cat );
         if( !p_cat )
+        {
+            vlc_mutex_unlock( &p_i->lock );
+            free( psz_value );
             return VLC_ENOMEM;
+        }
         TAB_APPEND(p_i->i_categories, p_i->pp_categories, p_cat);
     }
-    info_t *p_info = info_category_VaAddInfo( p_cat, psz_name, psz_format, args );
-    if( !p_info || !p_info->psz_value )
-        return VLC_EGENERIC;
-    return VLC_SUCCESS;
+    info_t *p_info = info_category_SetInfo( p_cat, psz_name, psz_value );
+
+    vlc_mutex_unlock( &p_i->lock );
+
+    return p_info ? VLC_SUCCESS : VLC_EGENERIC;
 }
 
 int input_item_AddInfo( input_item_t *p_i,
@@ -768,14 +780,10 @@ int input_item_AddInfo( input_item_t *p_i,
 {
     va_list args;
 
-    vlc_mutex_lock( &p_i->lock );
-
     va_start( args, psz_format );
     const int i_ret = InputItemVaAddInfo( p_i, psz_cat, psz_name, psz_format, args );
     va_end( args );
 
-    vlc_mutex_unlock( &p_i->lock );
-
 
     if( !i_ret )
         vlc_event_send( &p_i->event_manager, &(vlc_event_t) {
@@ -913,34 +921,36 @@ static int InputItemAddInfo( input_item_t *p_i,
 
 void input_item_SetEpg( input_item_t *p_item, const vlc_epg_t *p_update, bool b_current_source )
 {
-    vlc_epg_t *p_epg = vlc_epg_Duplicate( p_update );
-    if( !p_epg )
-        return;
-
     vlc_mutex_lock( &p_item->lock );
 
     /* */
-    vlc_epg_t **pp_epg = NULL;
+    vlc_epg_t *p_epg = NULL;
     for( int i = 0; i < p_item->i_epg; i++ )
     {
         if( p_item->pp_epg[i]->i_source_id == p_update->i_source_id &&
             p_item->pp_epg[i]->i_id == p_update->i_id )
         {
-            pp_epg = &p_item->pp_epg[i];
+            p_epg = p_item->pp_epg[i];
             break;
         }
     }
 
-    /* replace with new version */
-    if( pp_epg )
+    if( p_epg )
     {
-        vlc_epg_Delete( *pp_epg );
-        if( *pp_epg == p_item->p_epg_table ) /* current table can have changed */
+        /* Merge in place: DVB tables are resent periodically with mostly
+         * identical content, so unchanged events are kept as is */
+        vlc_epg_Update( p_epg, p_update );
+        if( p_epg == p_item->p_epg_table ) /* current table can have changed */
             p_item->p_epg_table = NULL;
-        *pp_epg = p_epg;
     }
     else
     {
+        p_epg = vlc_epg_Duplicate( p_update );
+        if( !p_epg )
+        {
+            vlc_mutex_unlock( &p_item->lock );
+            return;
+        }
         TAB_APPEND( p_item->i_epg, p_item->pp_epg, p_epg );
     }
 
@@ -85,6 +85,114 @@ const char * vlc_meta_TypeToLocalizedString( vlc_meta_type_t meta_type )
 };
 
 
+/*****************************************************************************
+ * String interning: metas whose values repeat massively across a library
+ * (artist, album, genre...) are stored once in a process-wide refcounted
+ * table instead of one heap copy per item. The sharing is invisible outside
+ * this file since vlc_meta_t owns and hands out const strings only.
+ *****************************************************************************/
+
+#define META_INTERN_BUCKETS 256
+
+struct meta_intern_entry
+{
+    struct meta_intern_entry *next;
+    unsigned refs;
+    char str[];
+};
+
+static struct meta_intern_entry *meta_intern_buckets[META_INTERN_BUCKETS];
+static vlc_mutex_t meta_intern_lock = VLC_STATIC_MUTEX;
+
+/* Metas likely shared between many items; Title, URLs and the like are
+ * unique per item and would only bloat the table */
+static bool vlc_meta_IsShared( vlc_meta_type_t meta_type )
+{
+    switch( meta_type )
+    {
+        case vlc_meta_Artist:
+        case vlc_meta_Genre:
+        case vlc_meta_Copyright:
+        case vlc_meta_Album:
+        case vlc_meta_Date:
+        case vlc_meta_Language:
+        case vlc_meta_Publisher:
+        case vlc_meta_EncodedBy:
+        case vlc_meta_Director:
+        case vlc_meta_Season:
+        case vlc_meta_ShowName:
+        case vlc_meta_Actors:
+        case vlc_meta_AlbumArtist:
+        case vlc_meta_DiscNumber:
+        case vlc_meta_TrackTotal:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static unsigned vlc_meta_InternHash( const char *psz )
+{
+    unsigned hash = 5381;
+    for( const unsigned char *p = (const unsigned char *)psz; *p; p++ )
+        hash = hash * 33 + *p;
+    return hash % META_INTERN_BUCKETS;
+}
+
+static char *vlc_meta_InternString( const char *psz )
+{
+    unsigned bucket = vlc_meta_InternHash( psz );
+    struct meta_intern_entry *entry;
+
+    vlc_mutex_lock( &meta_intern_lock );
+    for( entry = meta_intern_buckets[bucket]; entry; entry = entry->next )
+    {
+        if( !strcmp( entry->str, psz ) )
+        {
+            entry->refs++;
+            vlc_mutex_unlock( &meta_intern_lock );
+            return entry->str;
+        }
+    }
+
+    entry = malloc( sizeof( *entry ) + strlen( psz ) + 1 );
+    if( likely(entry != NULL) )
+    {
+        entry->refs = 1;
+        strcpy( entry->str, psz );
+        entry->next = meta_intern_buckets[bucket];
+        meta_intern_buckets[bucket] = entry;
+    }
+    vlc_mutex_unlock( &meta_intern_lock );
+    return entry != NULL ? entry->str : NULL;
+}
+
+static void vlc_meta_InternRelease( char *psz )
+{
+    if( psz == NULL )
+        return;
+
+    unsigned bucket = vlc_meta_InternHash( psz );
+
+    vlc_mutex_lock( &meta_intern_lock );
+    for( struct meta_intern_entry **pp = &meta_intern_buckets[bucket];
+         *pp != NULL; pp = &(*pp)->next )
+    {
+        struct meta_intern_entry *entry = *pp;
+
+        if( entry->str == psz )
+        {
+            if( --entry->refs == 0 )
+            {
+                *pp = entry->next;
+                free( entry );
+            }
+            break;
+        }
+    }
+    vlc_mutex_unlock( &meta_intern_lock );
+}
+
 /**
  * vlc_meta contructor.
  * vlc_meta_Delete() will free the returned pointer.
@@ -110,7 +218,12 @@ static void vlc_meta_FreeExtraKey( void *p_data, void *p_obj )
 void vlc_meta_Delete( vlc_meta_t *m )
 {
     for( int i = 0; i < VLC_META_TYPE_COUNT ; i++ )
-        free( m->ppsz_meta[i] );
+    {
+        if( vlc_meta_IsShared( i ) )
+            vlc_meta_InternRelease( m->ppsz_meta[i] );
+        else
+            free( m->ppsz_meta[i] );
+    }
     vlc_dictionary_clear( &m->extra_tags, vlc_meta_FreeExtraKey, NULL );
     free( m );
 }
@@ -123,9 +236,18 @@ void vlc_meta_Delete( vlc_meta_t *m )
 
 void vlc_meta_Set( vlc_meta_t *p_meta, vlc_meta_type_t meta_type, const char *psz_val )
 {
-    free( p_meta->ppsz_meta[meta_type] );
     assert( psz_val == NULL || IsUTF8( psz_val ) );
-    p_meta->ppsz_meta[meta_type] = psz_val ? strdup( psz_val ) : NULL;
+    if( vlc_meta_IsShared( meta_type ) )
+    {
+        vlc_meta_InternRelease( p_meta->ppsz_meta[meta_type] );
+        p_meta->ppsz_meta[meta_type] =
+            psz_val ? vlc_meta_InternString( psz_val ) : NULL;
+    }
+    else
+    {
+        free( p_meta->ppsz_meta[meta_type] );
+        p_meta->ppsz_meta[meta_type] = psz_val ? strdup( psz_val ) : NULL;
+    }
 }
 
 const char *vlc_meta_Get( const vlc_meta_t *p_meta, vlc_meta_type_t meta_type )
@@ -183,8 +305,16 @@ void vlc_meta_Merge( vlc_meta_t *dst, const vlc_meta_t *src )
     {
         if( src->ppsz_meta[i] )
         {
-            free( dst->ppsz_meta[i] );
-            dst->ppsz_meta[i] = strdup( src->ppsz_meta[i] );
+            if( vlc_meta_IsShared( i ) )
+            {
+                vlc_meta_InternRelease( dst->ppsz_meta[i] );
+                dst->ppsz_meta[i] = vlc_meta_InternString( src->ppsz_meta[i] );
+            }
+            else
+            {
+                free( dst->ppsz_meta[i] );
+                dst->ppsz_meta[i] = strdup( src->ppsz_meta[i] );
+            }
         }
     }
 
@@ -41,6 +41,8 @@
 #include "../audio_output/aout_internal.h"
 #include "../video_output/vout_internal.h"
 #include "input_interface.h"
+#include "../clock/input_clock.h"
+#include "decoder.h"
 #include "resource.h"
 
 struct input_resource_t
@@ -58,6 +60,7 @@ struct input_resource_t
 
     sout_instance_t *p_sout;
     vout_thread_t   *p_vout_free;
+    decoder_t       *p_dec_free;
 
     /* This lock is used to protect vout resources access (for hold)
      * It is a special case because of embed video (possible deadlock
@@ -139,6 +142,49 @@ static sout_instance_t *RequestSout( input_resource_t *p_resource,
 #endif
 }
 
+/* */
+static void DestroyDecoder( input_resource_t *p_resource )
+{
+    if( p_resource->p_dec_free )
+        input_DecoderParkedDelete( p_resource->p_dec_free );
+
+    p_resource->p_dec_free = NULL;
+}
+
+bool input_resource_PutDecoder( input_resource_t *p_resource, decoder_t *p_dec )
+{
+    vlc_mutex_lock( &p_resource->lock );
+    if( p_resource->p_dec_free != NULL )
+    {
+        vlc_mutex_unlock( &p_resource->lock );
+        return false;
+    }
+
+    msg_Dbg( p_resource->p_parent, "saving a free decoder" );
+    p_resource->p_dec_free = p_dec;
+    vlc_mutex_unlock( &p_resource->lock );
+
+    return true;
+}
+
+decoder_t *input_resource_GetDecoder( input_resource_t *p_resource,
+                                      const es_format_t *p_fmt )
+{
+    decoder_t *p_dec = NULL;
+
+    vlc_mutex_lock( &p_resource->lock );
+    if( p_resource->p_dec_free != NULL &&
+        input_DecoderParkedMatch( p_resource->p_dec_free, p_fmt ) )
+    {
+        msg_Dbg( p_resource->p_parent, "reusing parked decoder" );
+        p_dec = p_resource->p_dec_free;
+        p_resource->p_dec_free = NULL;
+    }
+    vlc_mutex_unlock( &p_resource->lock );
+
+    return p_dec;
+}
+
 /* */
 static void DestroyVout( input_resource_t *p_resource )
 {
@@ -423,6 +469,7 @@ void input_resource_Release( input_resource_t *p_resource )
         return;
 
     DestroySout( p_resource );
+    DestroyDecoder( p_resource );
     DestroyVout( p_resource );
     if( p_resource->p_aout != NULL )
         aout_Destroy( p_resource->p_aout );
@@ -502,8 +549,20 @@ void input_resource_TerminateSout( input_resource_t *p_resource )
 
 void input_resource_Terminate( input_resource_t *p_resource )
 {
+    decoder_t *p_dec;
+
     input_resource_TerminateSout( p_resource );
     input_resource_ResetAout( p_resource );
+
+    /* The parked decoder holds (a reference on) its former input object:
+     * destroy it outside of our lock */
+    vlc_mutex_lock( &p_resource->lock );
+    p_dec = p_resource->p_dec_free;
+    p_resource->p_dec_free = NULL;
+    vlc_mutex_unlock( &p_resource->lock );
+    if( p_dec != NULL )
+        input_DecoderParkedDelete( p_dec );
+
     input_resource_TerminateVout( p_resource );
 }
 
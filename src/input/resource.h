@@ -38,6 +38,20 @@ void input_resource_SetInput( input_resource_t *, input_thread_t * );
  */
 sout_instance_t *input_resource_RequestSout( input_resource_t *, sout_instance_t *, const char *psz_sout );
 
+/**
+ * This function parks an idle decoder for reuse by an upcoming item.
+ *
+ * It returns false if the resources already hold a parked decoder; the
+ * caller then keeps the ownership of the decoder.
+ */
+bool input_resource_PutDecoder( input_resource_t *, decoder_t * );
+
+/**
+ * This function returns the parked decoder if it can be revived for the
+ * given ES format, and NULL otherwise.
+ */
+decoder_t *input_resource_GetDecoder( input_resource_t *, const es_format_t * );
+
 /**
  * This function handles vout request.
  */
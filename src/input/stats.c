@@ -34,7 +34,7 @@
 /**
  * Create a statistics counter
  */
-static void input_rate_Init(input_rate_t *rate)
+void input_rate_Init(input_rate_t *rate)
 {
     vlc_mutex_init(&rate->lock);
     rate->updates = 0;
@@ -52,6 +52,15 @@ static float stats_GetRate(const input_rate_t *rate)
         / (float)(rate->samples[0].date - rate->samples[1].date);
 }
 
+void input_rate_Read(input_rate_t *rate, uintmax_t *restrict total,
+                     float *restrict bitrate)
+{
+    vlc_mutex_lock(&rate->lock);
+    *total = rate->value;
+    *bitrate = stats_GetRate(rate);
+    vlc_mutex_unlock(&rate->lock);
+}
+
 struct input_stats *input_stats_Create(void)
 {
     struct input_stats *stats = malloc(sizeof (*stats));
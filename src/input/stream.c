@@ -545,6 +545,20 @@ ssize_t vlc_stream_Peek(stream_t *s, const uint8_t **restrict bufp, size_t len)
     return len;
 }
 
+const block_t *vlc_stream_PeekBlock(stream_t *s, size_t len)
+{
+    stream_priv_t *priv = (stream_priv_t *)s;
+    const uint8_t *buf;
+
+    if (vlc_stream_Peek(s, &buf, len) < 0)
+        return NULL;
+
+    /* The stream-owned peek buffer doubles as the zero-copy view. It may
+     * hold more than len bytes from an earlier, larger peek. */
+    assert(priv->peek != NULL);
+    return priv->peek;
+}
+
 block_t *vlc_stream_ReadBlock(stream_t *s)
 {
     stream_priv_t *priv = (stream_priv_t *)s;
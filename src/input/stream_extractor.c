@@ -274,6 +274,102 @@ se_AttachWrapper( struct stream_extractor_private* priv, stream_t* source )
     return VLC_SUCCESS;
 }
 
+/**
+ * \name Module hint cache
+ *
+ * Probing for a stream-extractor makes every candidate module open and
+ * parse the archive headers. Playing many entries out of one archive (an
+ * album in a zip) repeats that full probe per entry. Remembering which
+ * module handled a given source URL turns the repeats into a single-module
+ * load. A stale hint is harmless: if the hinted module refuses the stream,
+ * the regular probe runs as before, and the hint is replaced.
+ *
+ * @{
+ */
+
+#define SE_MODULE_CACHE_SIZE 8
+
+static struct
+{
+    vlc_mutex_t lock;
+    unsigned next; /*< Round-robin eviction cursor */
+    struct se_module_cache_entry
+    {
+        char *url;
+        char *module;
+        bool extractor;
+    } entry[SE_MODULE_CACHE_SIZE];
+} se_module_cache = { VLC_STATIC_MUTEX, 0, { { NULL, NULL, false } } };
+
+static char*
+se_CachedModuleGet( char const* url, bool extractor )
+{
+    char* name = NULL;
+
+    vlc_mutex_lock( &se_module_cache.lock );
+    for( unsigned i = 0; i < SE_MODULE_CACHE_SIZE; ++i )
+    {
+        struct se_module_cache_entry* entry = &se_module_cache.entry[i];
+
+        if( entry->url && entry->extractor == extractor
+         && !strcmp( entry->url, url ) )
+        {
+            name = strdup( entry->module );
+            break;
+        }
+    }
+    vlc_mutex_unlock( &se_module_cache.lock );
+
+    return name;
+}
+
+static void
+se_CachedModuleStore( char const* url, bool extractor, char const* module )
+{
+    char* url_dup = strdup( url );
+    char* module_dup = strdup( module );
+
+    if( unlikely( !url_dup || !module_dup ) )
+    {
+        free( url_dup );
+        free( module_dup );
+        return;
+    }
+
+    vlc_mutex_lock( &se_module_cache.lock );
+
+    unsigned i;
+    for( i = 0; i < SE_MODULE_CACHE_SIZE; ++i )
+    {
+        struct se_module_cache_entry* entry = &se_module_cache.entry[i];
+
+        if( entry->url && entry->extractor == extractor
+         && !strcmp( entry->url, url ) )
+            break;
+    }
+
+    if( i == SE_MODULE_CACHE_SIZE )
+    {
+        i = se_module_cache.next;
+        se_module_cache.next = ( se_module_cache.next + 1 )
+                             % SE_MODULE_CACHE_SIZE;
+    }
+
+    struct se_module_cache_entry* entry = &se_module_cache.entry[i];
+
+    free( entry->url );
+    free( entry->module );
+    entry->url = url_dup;
+    entry->module = module_dup;
+    entry->extractor = extractor;
+
+    vlc_mutex_unlock( &se_module_cache.lock );
+}
+
+/**
+ * @}
+ **/
+
 static int
 StreamExtractorAttach( stream_t** source, char const* identifier,
     char const* module_name )
@@ -311,7 +407,25 @@ StreamExtractorAttach( stream_t** source, char const* identifier,
         priv->directory.source = *source;
     }
 
-    priv->module = module_need( priv->object, capability, module_name, true );
+    if( module_name == NULL && (*source)->psz_url != NULL )
+    {
+        char* hint = se_CachedModuleGet( (*source)->psz_url, extractor );
+        if( hint )
+        {
+            priv->module = module_need( priv->object, capability, hint, true );
+            free( hint );
+        }
+    }
+
+    if( !priv->module )
+    {
+        priv->module = module_need( priv->object, capability, module_name,
+                                    true );
+        if( priv->module && module_name == NULL
+         && (*source)->psz_url != NULL )
+            se_CachedModuleStore( (*source)->psz_url, extractor,
+                                  module_get_object( priv->module ) );
+    }
 
     if( !priv->module || se_AttachWrapper( priv, *source ) )
         goto error;
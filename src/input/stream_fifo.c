@@ -36,6 +36,7 @@
 struct vlc_stream_fifo_private
 {
     vlc_fifo_t *fifo;
+    block_t *pending; /**< drained blocks, owned by the read side */
     bool eof;
 };
 
@@ -53,6 +54,7 @@ static void vlc_stream_fifo_Destroy(stream_t *s)
     vlc_fifo_Unlock(fifo);
 
     block_ChainRelease(block);
+    block_ChainRelease(sys->pending);
 
     if (closed) /* Destroy shared state if write end is already closed */
         block_FifoRelease(fifo);
@@ -62,21 +64,33 @@ static block_t *vlc_stream_fifo_Block(stream_t *s, bool *restrict eof)
 {
     struct vlc_stream_fifo_private *sys = vlc_stream_Private(s);
     vlc_fifo_t *fifo = sys->fifo;
-    block_t *block;
+    block_t *block = sys->pending;
 
-    vlc_fifo_Lock(fifo);
-    while (vlc_fifo_IsEmpty(fifo))
+    /* Drain the whole queue in one go and serve subsequent blocks without
+     * taking the lock again: only the read side touches the drained chain,
+     * so the writer is not held up once per block. */
+    if (block == NULL)
     {
-        if (sys->eof)
+        vlc_fifo_Lock(fifo);
+        while (vlc_fifo_IsEmpty(fifo))
         {
-            *eof = true;
-            break;
+            if (sys->eof)
+            {
+                *eof = true;
+                break;
+            }
+            vlc_fifo_Wait(fifo);
         }
-        vlc_fifo_Wait(fifo);
+
+        block = vlc_fifo_DequeueAllUnlocked(fifo);
+        vlc_fifo_Unlock(fifo);
+
+        if (block == NULL)
+            return NULL;
     }
 
-    block = vlc_fifo_DequeueUnlocked(fifo);
-    vlc_fifo_Unlock(fifo);
+    sys->pending = block->p_next;
+    block->p_next = NULL;
     return block;
 }
 
@@ -120,6 +134,7 @@ stream_t *vlc_stream_fifo_New(vlc_object_t *parent)
 
     sys = vlc_stream_Private(s);
     sys->fifo = fifo;
+    sys->pending = NULL;
     sys->eof = false;
     s->pf_block = vlc_stream_fifo_Block;
     s->pf_seek = NULL;
@@ -150,12 +150,14 @@ vlm_t *vlm_New( libvlc_int_t *libvlc, const char *psz_vlmconf )
     p_vlm->input_state_changed = false;
     p_vlm->i_id = 1;
     TAB_INIT( p_vlm->i_media, p_vlm->media );
+    vlc_dictionary_init( &p_vlm->media_by_name, 0 );
     TAB_INIT( p_vlm->i_schedule, p_vlm->schedule );
     p_vlm->p_vod = NULL;
     var_Create( p_vlm, "intf-event", VLC_VAR_ADDRESS );
 
     if( vlc_clone( &p_vlm->thread, Manage, p_vlm, VLC_THREAD_PRIORITY_LOW ) )
     {
+        vlc_dictionary_clear( &p_vlm->media_by_name, NULL, NULL );
         vlc_cond_destroy( &p_vlm->wait_manage );
         vlc_mutex_destroy( &p_vlm->lock );
         vlc_mutex_destroy( &p_vlm->lock_manage );
@@ -213,6 +215,7 @@ void vlm_Delete( vlm_t *p_vlm )
     vlc_mutex_lock( &p_vlm->lock );
     vlm_ControlInternal( p_vlm, VLM_CLEAR_MEDIAS );
     TAB_CLEAN( p_vlm->i_media, p_vlm->media );
+    vlc_dictionary_clear( &p_vlm->media_by_name, NULL, NULL );
 
     vlm_ControlInternal( p_vlm, VLM_CLEAR_SCHEDULES );
     TAB_CLEAN( p_vlm->i_schedule, p_vlm->schedule );
@@ -532,21 +535,26 @@ typedef struct
 /* */
 static vlm_media_sys_t *vlm_ControlMediaGetById( vlm_t *p_vlm, int64_t id )
 {
-    for( int i = 0; i < p_vlm->i_media; i++ )
+    /* Ids are allocated in increasing order and the table keeps insertion
+     * order, so it is sorted by id: bisect. */
+    int low = 0, high = p_vlm->i_media;
+
+    while( low < high )
     {
-        if( p_vlm->media[i]->cfg.id == id )
-            return p_vlm->media[i];
+        int mid = low + ( high - low ) / 2;
+
+        if( p_vlm->media[mid]->cfg.id < id )
+            low = mid + 1;
+        else
+            high = mid;
     }
+    if( low < p_vlm->i_media && p_vlm->media[low]->cfg.id == id )
+        return p_vlm->media[low];
     return NULL;
 }
 static vlm_media_sys_t *vlm_ControlMediaGetByName( vlm_t *p_vlm, const char *psz_name )
 {
-    for( int i = 0; i < p_vlm->i_media; i++ )
-    {
-        if( !strcmp( p_vlm->media[i]->cfg.psz_name, psz_name ) )
-            return p_vlm->media[i];
-    }
-    return NULL;
+    return vlc_dictionary_value_for_key( &p_vlm->media_by_name, psz_name );
 }
 static int vlm_MediaDescriptionCheck( vlm_t *p_vlm, vlm_media_t *p_cfg )
 {
@@ -717,6 +725,16 @@ static int vlm_ControlMediaChange( vlm_t *p_vlm, vlm_media_t *p_cfg )
         /* TODO check what are the changes being done (stop instance if needed) */
     }
 
+    /* Keep the name index in sync on rename */
+    if( strcmp( p_media->cfg.psz_name, p_cfg->psz_name ) )
+    {
+        vlc_dictionary_remove_value_for_key( &p_vlm->media_by_name,
+                                             p_media->cfg.psz_name,
+                                             NULL, NULL );
+        vlc_dictionary_insert( &p_vlm->media_by_name, p_cfg->psz_name,
+                               p_media );
+    }
+
     vlm_media_Clean( &p_media->cfg );
     vlm_media_Copy( &p_media->cfg, p_cfg );
 
@@ -765,6 +783,8 @@ static int vlm_ControlMediaAdd( vlm_t *p_vlm, vlm_media_t *p_cfg, int64_t *p_id
 
     /* */
     TAB_APPEND( p_vlm->i_media, p_vlm->media, p_media );
+    vlc_dictionary_insert( &p_vlm->media_by_name, p_media->cfg.psz_name,
+                           p_media );
 
     if( p_id )
         *p_id = p_media->cfg.id;
@@ -793,6 +813,8 @@ static int vlm_ControlMediaDel( vlm_t *p_vlm, int64_t id )
     /* */
     vlm_SendEventMediaRemoved( p_vlm, id, p_media->cfg.psz_name );
 
+    vlc_dictionary_remove_value_for_key( &p_vlm->media_by_name,
+                                         p_media->cfg.psz_name, NULL, NULL );
     vlm_media_Clean( &p_media->cfg );
 
     input_item_Release( p_media->vod.p_item );
@@ -25,6 +25,7 @@
 #define LIBVLC_VLM_INTERNAL_H 1
 
 #include <vlc_vlm.h>
+#include <vlc_arrays.h>
 #include "input_interface.h"
 
 /* Private */
@@ -102,6 +103,8 @@ struct vlm_t
     /* Media list */
     int                i_media;
     vlm_media_sys_t    **media;
+    /* Name index over the media list (vlm_media_sys_t, keyed by name) */
+    vlc_dictionary_t   media_by_name;
 
     /* Schedule list */
     int            i_schedule;
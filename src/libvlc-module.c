@@ -928,6 +928,18 @@ static const char *const ppsz_prefres[] = {
     "This allows you to select a list of encoders that VLC will use in " \
     "priority.")
 
+#define DEC_FIFO_BLOCKS_TEXT N_("Decoder lookahead depth (blocks)")
+#define DEC_FIFO_BLOCKS_LONGTEXT N_( \
+    "Number of demuxed blocks queued ahead of each decoder before the " \
+    "demuxer is paused. Larger values pipeline demuxing and decoding more " \
+    "deeply, which helps heavy codecs at the cost of latency and memory." )
+
+#define DEC_FIFO_SIZE_TEXT N_("Decoder FIFO limit (MiB)")
+#define DEC_FIFO_SIZE_LONGTEXT N_( \
+    "Maximum amount of data queued ahead of a decoder when pacing is not " \
+    "possible (e.g. streamed inputs). When the limit is hit, the FIFO is " \
+    "reset and playback resynchronizes." )
+
 /*****************************************************************************
  * Sout
  ****************************************************************************/
@@ -977,6 +989,17 @@ static const char *const ppsz_prefres[] = {
     "This allow you to configure the initial caching amount for stream output " \
     "muxer. This value should be set in milliseconds." )
 
+#define SOUT_THREADED_TEXT N_("Run stream output modules on separate threads")
+#define SOUT_THREADED_LONGTEXT N_( \
+    "Decouple each module of the stream output chain with a worker thread " \
+    "and a block queue, so that transcoding, muxing and network output can " \
+    "run concurrently." )
+
+#define SOUT_STATS_TEXT N_("Collect stream output statistics")
+#define SOUT_STATS_LONGTEXT N_( \
+    "Count blocks, bytes and processing time spent in each module of the " \
+    "stream output chain, and log them periodically." )
+
 #define PACKETIZER_TEXT N_("Preferred packetizer list")
 #define PACKETIZER_LONGTEXT N_( \
     "This allows you to select the order in which VLC will choose its " \
@@ -1106,6 +1129,13 @@ static const char *const ppsz_prefres[] = {
     "all the processor time and render the whole system unresponsive which " \
     "might require a reboot of your machine.")
 
+#define BLOCK_CACHE_TEXT N_("Per-thread block allocation cache")
+#define BLOCK_CACHE_LONGTEXT N_( \
+    "Recycle data blocks through per-thread freelists instead of calling " \
+    "the system memory allocator for every packet. This reduces allocator " \
+    "contention with many concurrent inputs, at the cost of a small amount " \
+    "of memory retained per thread.")
+
 #define PLAYLISTENQUEUE_TEXT N_( \
     "Enqueue items into playlist in one instance mode")
 #define PLAYLISTENQUEUE_LONGTEXT N_( \
@@ -1200,6 +1230,13 @@ static const char *const psz_recursive_list_text[] = {
 #define SP_LONGTEXT N_( \
     "Pause each item in the playlist on the first frame." )
 
+#define PREROLL_TEXT N_("Next item preroll threshold")
+#define PREROLL_LONGTEXT N_( \
+    "Once the position of the current playlist item passes this fraction " \
+    "(between 0.0 and 1.0), the next item is opened, buffered and prerolled " \
+    "in a paused state, then swapped in at the item boundary. 0 disables " \
+    "the preroll." )
+
 #define AUTOSTART_TEXT N_( "Auto start" )
 #define AUTOSTART_LONGTEXT N_( "Automatically start playing the playlist " \
                 "content once it's loaded." )
@@ -1962,6 +1999,10 @@ vlc_module_begin ()
                 CODEC_LONGTEXT, true )
     add_string( "encoder",  NULL, ENCODER_TEXT,
                 ENCODER_LONGTEXT, true )
+    add_integer( "decoder-fifo-blocks", 10, DEC_FIFO_BLOCKS_TEXT,
+                 DEC_FIFO_BLOCKS_LONGTEXT, true )
+    add_integer( "decoder-fifo-size", 400, DEC_FIFO_SIZE_TEXT,
+                 DEC_FIFO_SIZE_LONGTEXT, true )
 
     set_subcategory( SUBCAT_INPUT_ACCESS )
     add_category_hint(N_("Input"), INPUT_CAT_LONGTEXT)
@@ -1999,6 +2040,10 @@ vlc_module_begin ()
                                 SOUT_SPU_LONGTEXT, true )
     add_integer( "sout-mux-caching", 1500, SOUT_MUX_CACHING_TEXT,
                                 SOUT_MUX_CACHING_LONGTEXT, true )
+    add_bool( "sout-threaded", false, SOUT_THREADED_TEXT,
+                                SOUT_THREADED_LONGTEXT, true )
+    add_bool( "sout-stats", false, SOUT_STATS_TEXT,
+                                SOUT_STATS_LONGTEXT, true )
 
     set_section( N_("VLM"), NULL )
     add_loadfile("vlm-conf", NULL, VLM_CONF_TEXT, VLM_CONF_LONGTEXT)
@@ -2063,6 +2108,9 @@ vlc_module_begin ()
 
     set_section( N_("Performance options"), NULL )
 
+    add_bool( "block-cache", false, BLOCK_CACHE_TEXT,
+              BLOCK_CACHE_LONGTEXT, true )
+
 #if defined (LIBVLC_USE_PTHREAD) && !defined (__APPLE__)
     add_bool( "rt-priority", false, RT_PRIORITY_TEXT,
               RT_PRIORITY_LONGTEXT, true )
@@ -2104,6 +2152,8 @@ vlc_module_begin ()
     add_bool( "play-and-pause", 0, PAP_TEXT, PAP_LONGTEXT, true )
         change_safe()
     add_bool( "start-paused", 0, SP_TEXT, SP_LONGTEXT, false )
+    add_float_with_range( "preroll-threshold", 0., 0., 1.,
+                          PREROLL_TEXT, PREROLL_LONGTEXT, true )
     add_bool( "playlist-autostart", true,
               AUTOSTART_TEXT, AUTOSTART_LONGTEXT, false )
     add_bool( "playlist-cork", true, CORK_TEXT, CORK_LONGTEXT, false )
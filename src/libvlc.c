@@ -77,6 +77,56 @@
  *****************************************************************************/
 static void GetFilenames  ( libvlc_int_t *, unsigned, const char *const [] );
 
+/*****************************************************************************
+ * Startup phase timing
+ *****************************************************************************
+ * libvlc_InternalInit() runs its phases serially; record the end time of
+ * each one so slow startups can be attributed to a phase. The report goes
+ * to the debug log, and additionally to the standard error stream as a
+ * waterfall when the VLC_STARTUP_TIMES environment variable is set (the
+ * log may not be initialized yet when the early phases run).
+ *****************************************************************************/
+typedef struct
+{
+    vlc_tick_t origin;
+    unsigned   count;
+    struct
+    {
+        const char *name;
+        vlc_tick_t  end;
+    } phase[12];
+} startup_times_t;
+
+static void StartupPhase( startup_times_t *times, const char *name )
+{
+    if( times->count >= ARRAY_SIZE(times->phase) )
+        return;
+    times->phase[times->count].name = name;
+    times->phase[times->count].end = vlc_tick_now();
+    times->count++;
+}
+
+static void StartupReport( libvlc_int_t *p_libvlc,
+                           const startup_times_t *times )
+{
+    bool dump = getenv( "VLC_STARTUP_TIMES" ) != NULL;
+    vlc_tick_t prev = times->origin;
+
+    for( unsigned i = 0; i < times->count; i++ )
+    {
+        vlc_tick_t end = times->phase[i].end;
+
+        msg_Dbg( p_libvlc, "startup phase %s: %"PRId64" us (ends at %"PRId64
+                 " us)", times->phase[i].name, end - prev,
+                 end - times->origin );
+        if( dump )
+            fprintf( stderr, "startup: %-12s %8.1f ms (at %8.1f ms)\n",
+                     times->phase[i].name, (end - prev) / 1000.,
+                     (end - times->origin) / 1000. );
+        prev = end;
+    }
+}
+
 /**
  * Allocate a blank libvlc instance, also setting the exit handler.
  * Vlc's threading system must have been initialized first
@@ -117,12 +167,15 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     char *       psz_control = NULL;
     char        *psz_val;
     int          i_ret = VLC_EGENERIC;
+    startup_times_t times = { .origin = vlc_tick_now(), .count = 0 };
 
     /* System specific initialization code */
     system_Init();
 
     vlc_LogPreinit(p_libvlc);
 
+    vlc_tracer_Init();
+
     /* Initialize the module bank and load the configuration of the
      * core module. We need to do this at this stage to be able to display
      * a short help if required by the user. (short help == core module
@@ -136,6 +189,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
         return VLC_EGENERIC;
     }
 
+    StartupPhase( &times, "core-options" );
+
     vlc_threads_setup (p_libvlc);
 
     /* Load the builtins and plugins into the module_bank.
@@ -144,6 +199,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
      * default values. */
     module_LoadPlugins (p_libvlc);
 
+    StartupPhase( &times, "plugins" );
+
     /*
      * Override default configuration with config file settings
      */
@@ -164,6 +221,11 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
 
     vlc_LogInit(p_libvlc);
 
+    StartupPhase( &times, "config" );
+
+    if( var_InheritBool( p_libvlc, "block-cache" ) )
+        block_CacheEnable();
+
     /*
      * Support for gettext
      */
@@ -218,6 +280,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
 
     vlc_CPU_dump( VLC_OBJECT(p_libvlc) );
 
+    StartupPhase( &times, "dialogs" );
+
     if( var_InheritBool( p_libvlc, "media-library") )
     {
         priv->p_media_library = libvlc_MlCreate( p_libvlc );
@@ -238,6 +302,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     if( !priv->parser )
         goto error;
 
+    StartupPhase( &times, "preparser" );
+
     /* variables for signalling creation of new files */
     var_Create( p_libvlc, "snapshot-file", VLC_VAR_STRING );
     var_Create( p_libvlc, "record-file", VLC_VAR_STRING );
@@ -274,6 +340,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
             msg_Err( p_libvlc, "VLM initialization failed" );
         free( psz_parser );
     }
+
+    StartupPhase( &times, "vlm" );
 #endif
 
     /*
@@ -320,6 +388,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     if( var_InheritBool( p_libvlc, "network-synchronisation") )
         libvlc_InternalAddIntf( p_libvlc, "netsync,none" );
 
+    StartupPhase( &times, "interfaces" );
+
 #ifdef __APPLE__
     var_Create( p_libvlc, "drawable-view-top", VLC_VAR_INTEGER );
     var_Create( p_libvlc, "drawable-view-left", VLC_VAR_INTEGER );
@@ -349,6 +419,9 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
         free( psz_val );
     }
 
+    StartupPhase( &times, "items" );
+    StartupReport( p_libvlc, &times );
+
     return VLC_SUCCESS;
 
 error:
@@ -406,6 +479,12 @@ void libvlc_InternalCleanup( libvlc_int_t *p_libvlc )
     if( !var_InheritBool( p_libvlc, "ignore-config" ) )
         config_AutoSaveConfigFile( VLC_OBJECT(p_libvlc) );
 
+    vlc_tracer_Deinit();
+
+#ifdef ENABLE_LOCK_PROFILING
+    vlc_lock_profile_Dump();
+#endif
+
     /* Free module bank. It is refcounted, so we call this each time  */
     vlc_LogDeinit (p_libvlc);
     module_EndBank (true);
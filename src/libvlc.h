@@ -56,6 +56,11 @@ int vlc_set_priority( vlc_thread_t, int );
 void vlc_threads_setup (libvlc_int_t *);
 
 void vlc_trace (const char *fn, const char *file, unsigned line);
+
+/*
+ * Per-thread block allocation cache (src/misc/block.c)
+ */
+void block_CacheEnable (void);
 #define vlc_backtrace() vlc_trace(__func__, __FILE__, __LINE__)
 
 #if (defined (LIBVLC_USE_PTHREAD) || defined(__ANDROID__)) && !defined (NDEBUG)
@@ -64,6 +69,18 @@ void vlc_assert_locked (vlc_mutex_t *);
 # define vlc_assert_locked( m ) (void)m
 #endif
 
+/*
+ * Caching name resolver (src/network/getaddrinfo.c)
+ *
+ * Like vlc_getaddrinfo_i11e(), but with a process-wide cache of recent
+ * lookups. The result list must be released with vlc_freeaddrinfo_cached(),
+ * never with freeaddrinfo().
+ */
+struct addrinfo;
+int vlc_getaddrinfo_cached(const char *, unsigned, const struct addrinfo *,
+                           struct addrinfo **);
+void vlc_freeaddrinfo_cached(struct addrinfo *);
+
 /*
  * Logging
  */
@@ -73,6 +90,12 @@ int vlc_LogPreinit(libvlc_int_t *);
 int vlc_LogInit(libvlc_int_t *);
 void vlc_LogDeinit(libvlc_int_t *);
 
+/*
+ * Tracing (src/misc/tracer.c)
+ */
+void vlc_tracer_Init(void);
+void vlc_tracer_Deinit(void);
+
 /*
  * LibVLC exit event handling
  */
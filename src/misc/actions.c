@@ -594,6 +594,18 @@ vlc_actions_get_id (const char *name)
     return (act != NULL) ? act->id : ACTIONID_NONE;
 }
 
+#undef vlc_actions_do
+/**
+ * Triggers an action from its identifier, bypassing key and name lookups.
+ */
+void
+vlc_actions_do(vlc_object_t *p_obj, vlc_action_id_t id)
+{
+    if (id == ACTIONID_NONE)
+        return; /* spare the listeners a wakeup for no action at all */
+    var_SetInteger(p_obj->obj.libvlc, "key-action", id);
+}
+
 #undef vlc_actions_get_keycodes
 size_t
 vlc_actions_get_keycodes(vlc_object_t *p_obj, const char *psz_key_name,
@@ -34,6 +34,7 @@ struct task {
     void* id; /**< id associated with entity */
     void* entity; /**< the entity to process */
     int timeout; /**< timeout duration in milliseconds */
+    enum background_worker_priority priority; /**< scheduling lane */
 };
 
 struct background_worker;
@@ -57,15 +58,18 @@ struct background_worker {
     int nthreads; /**< number of threads in the threads list */
     struct vlc_list threads; /**< list of active background_thread instances */
 
-    struct vlc_list queue; /**< queue of tasks */
-    vlc_cond_t queue_wait; /**< wait for the queue to be non-empty */
+    struct vlc_list queue; /**< queue of normal-priority tasks */
+    struct vlc_list queue_high; /**< queue of high-priority tasks */
+    vlc_cond_t queue_wait; /**< wait for either queue to be non-empty */
 
+    vlc_cond_t done_wait; /**< wait for a task to be completed or removed */
     vlc_cond_t nothreads_wait; /**< wait for nthreads == 0 */
     bool closing; /**< true if background worker deletion is requested */
 };
 
 static struct task *task_Create(struct background_worker *worker, void *id,
-                                void *entity, int timeout)
+                                void *entity, int timeout,
+                                enum background_worker_priority priority)
 {
     struct task *task = malloc(sizeof(*task));
     if (unlikely(!task))
@@ -74,6 +78,7 @@ static struct task *task_Create(struct background_worker *worker, void *id,
     task->id = id;
     task->entity = entity;
     task->timeout = timeout < 0 ? worker->conf.default_timeout : timeout;
+    task->priority = priority;
     worker->conf.pf_hold(task->entity);
     return task;
 }
@@ -90,15 +95,20 @@ static struct task *QueueTake(struct background_worker *worker, int timeout_ms)
 
     vlc_tick_t deadline = vlc_tick_now() + VLC_TICK_FROM_MS(timeout_ms);
     bool timeout = false;
-    while (!timeout && !worker->closing && vlc_list_is_empty(&worker->queue))
+    while (!timeout && !worker->closing
+        && vlc_list_is_empty(&worker->queue_high)
+        && vlc_list_is_empty(&worker->queue))
         timeout = vlc_cond_timedwait(&worker->queue_wait,
                                      &worker->lock, deadline) != 0;
 
     if (worker->closing || timeout)
         return NULL;
 
-    struct task *task = vlc_list_first_entry_or_null(&worker->queue,
+    struct task *task = vlc_list_first_entry_or_null(&worker->queue_high,
                                                      struct task, node);
+    if (task == NULL)
+        task = vlc_list_first_entry_or_null(&worker->queue,
+                                            struct task, node);
     assert(task);
     vlc_list_remove(&task->node);
 
@@ -108,7 +118,10 @@ static struct task *QueueTake(struct background_worker *worker, int timeout_ms)
 static void QueuePush(struct background_worker *worker, struct task *task)
 {
     vlc_assert_locked(&worker->lock);
-    vlc_list_append(&task->node, &worker->queue);
+    if (task->priority == BACKGROUND_WORKER_PRIORITY_HIGH)
+        vlc_list_append(&task->node, &worker->queue_high);
+    else
+        vlc_list_append(&task->node, &worker->queue);
     vlc_cond_signal(&worker->queue_wait);
 }
 
@@ -116,6 +129,14 @@ static void QueueRemoveAll(struct background_worker *worker, void *id)
 {
     vlc_assert_locked(&worker->lock);
     struct task *task;
+    vlc_list_foreach(task, &worker->queue_high, node)
+    {
+        if (!id || task->id == id)
+        {
+            vlc_list_remove(&task->node);
+            task_Destroy(worker, task);
+        }
+    }
     vlc_list_foreach(task, &worker->queue, node)
     {
         if (!id || task->id == id)
@@ -124,6 +145,7 @@ static void QueueRemoveAll(struct background_worker *worker, void *id)
             task_Destroy(worker, task);
         }
     }
+    vlc_cond_broadcast(&worker->done_wait);
 }
 
 static struct background_thread *
@@ -162,7 +184,9 @@ static struct background_worker *background_worker_Create(void *owner,
     worker->nthreads = 0;
     vlc_list_init(&worker->threads);
     vlc_list_init(&worker->queue);
+    vlc_list_init(&worker->queue_high);
     vlc_cond_init(&worker->queue_wait);
+    vlc_cond_init(&worker->done_wait);
     vlc_cond_init(&worker->nothreads_wait);
     worker->closing = false;
     return worker;
@@ -170,6 +194,7 @@ static struct background_worker *background_worker_Create(void *owner,
 
 static void background_worker_Destroy(struct background_worker *worker)
 {
+    vlc_cond_destroy(&worker->done_wait);
     vlc_cond_destroy(&worker->queue_wait);
     vlc_mutex_destroy(&worker->lock);
     free(worker);
@@ -184,6 +209,7 @@ static void TerminateTask(struct background_thread *thread, struct task *task)
     thread->task = NULL;
     worker->uncompleted--;
     assert(worker->uncompleted >= 0);
+    vlc_cond_broadcast(&worker->done_wait);
     vlc_mutex_unlock(&worker->lock);
 }
 
@@ -294,7 +320,15 @@ struct background_worker* background_worker_New( void* owner,
 int background_worker_Push( struct background_worker* worker, void* entity,
                         void* id, int timeout )
 {
-    struct task *task = task_Create(worker, id, entity, timeout);
+    return background_worker_PushPriority(worker, entity, id, timeout,
+                                          BACKGROUND_WORKER_PRIORITY_NORMAL);
+}
+
+int background_worker_PushPriority( struct background_worker* worker,
+    void* entity, void* id, int timeout,
+    enum background_worker_priority priority )
+{
+    struct task *task = task_Create(worker, id, entity, timeout, priority);
     if (unlikely(!task))
         return VLC_ENOMEM;
 
@@ -333,6 +367,34 @@ void background_worker_Cancel( struct background_worker* worker, void* id )
     vlc_mutex_unlock(&worker->lock);
 }
 
+static bool WorkerHasMatch(struct background_worker *worker, void *id)
+{
+    vlc_assert_locked(&worker->lock);
+
+    struct task *task;
+    vlc_list_foreach(task, &worker->queue_high, node)
+        if (!id || task->id == id)
+            return true;
+    vlc_list_foreach(task, &worker->queue, node)
+        if (!id || task->id == id)
+            return true;
+
+    struct background_thread *thread;
+    vlc_list_foreach(thread, &worker->threads, node)
+        if (thread->task && (!id || thread->task->id == id))
+            return true;
+
+    return false;
+}
+
+void background_worker_Wait( struct background_worker* worker, void* id )
+{
+    vlc_mutex_lock(&worker->lock);
+    while (WorkerHasMatch(worker, id))
+        vlc_cond_wait(&worker->done_wait, &worker->lock);
+    vlc_mutex_unlock(&worker->lock);
+}
+
 void background_worker_RequestProbe( struct background_worker* worker )
 {
     vlc_mutex_lock(&worker->lock);
@@ -19,6 +19,17 @@
 #ifndef BACKGROUND_WORKER_H__
 #define BACKGROUND_WORKER_H__
 
+/**
+ * Scheduling priority of a queued entity
+ *
+ * High-priority entities are dequeued before any normal-priority one,
+ * regardless of the order in which they were pushed.
+ **/
+enum background_worker_priority {
+    BACKGROUND_WORKER_PRIORITY_NORMAL,
+    BACKGROUND_WORKER_PRIORITY_HIGH,
+};
+
 struct background_worker_config {
     /**
      * Default timeout for completing a task
@@ -171,6 +182,27 @@ void background_worker_RequestProbe( struct background_worker* worker );
 int background_worker_Push( struct background_worker* worker, void* entity,
     void* id, int timeout );
 
+/**
+ * Push an entity into the background-worker with a given priority
+ *
+ * Same as \ref background_worker_Push, except that the entity is queued in
+ * the lane denoted by `priority`. \ref background_worker_Push is equivalent
+ * to pushing with \ref BACKGROUND_WORKER_PRIORITY_NORMAL.
+ *
+ * \param worker the background-worker
+ * \param entity the entity which is to be queued
+ * \param id a value suitable for identifying the entity, or `NULL`
+ * \param timeout the timeout of the entity in milliseconds, `0` denotes no
+ *                timeout, a negative value will use the default timeout
+ *                associated with the background-worker.
+ * \param priority the scheduling priority of the entity
+ * \return VLC_SUCCESS if the entity was successfully queued, an error-code on
+ *         failure.
+ **/
+int background_worker_PushPriority( struct background_worker* worker,
+    void* entity, void* id, int timeout,
+    enum background_worker_priority priority );
+
 /**
  * Remove entities from the background-worker
  *
@@ -187,6 +219,22 @@ int background_worker_Push( struct background_worker* worker, void* entity,
  **/
 void background_worker_Cancel( struct background_worker* worker, void* id );
 
+/**
+ * Wait for entities to be completed or removed
+ *
+ * This function blocks until no entity associated with `id` remains, neither
+ * queued nor currently being processed. Combined with \ref
+ * background_worker_Cancel it allows a caller to synchronously tear down the
+ * processing of an entity; on its own it acts as a completion primitive, so
+ * that one subsystem can await work it handed to the shared worker without
+ * occupying one of the worker's threads.
+ *
+ * \param worker the background-worker
+ * \param id NULL to wait until the worker is completely idle, otherwise wait
+ *        only for entities pushed with the given id
+ **/
+void background_worker_Wait( struct background_worker* worker, void* id );
+
 /**
  * Delete a background-worker
  *
@@ -28,6 +28,8 @@
 #include <sys/stat.h>
 #include <assert.h>
 #include <errno.h>
+#include <stdatomic.h>
+#include <stdio.h>
 #include <unistd.h>
 #include <fcntl.h>
 
@@ -35,6 +37,8 @@
 #include <vlc_block.h>
 #include <vlc_fs.h>
 
+#include "../libvlc.h"
+
 #ifndef NDEBUG
 static void block_Check (block_t *block)
 {
@@ -57,9 +61,61 @@ static void block_Check (block_t *block)
 # define block_Check(b) ((void)(b))
 #endif
 
+/*** Live block accounting ***
+ *
+ * One relaxed counter update per block creation and release, cheap enough to
+ * stay always on. Snapshots are taken with block_AllocationStats() and the
+ * counters are dumped to the standard error stream when an allocation fails,
+ * so out-of-memory reports carry the block footprint. */
+
+static atomic_size_t block_live_count = ATOMIC_VAR_INIT(0);
+static atomic_size_t block_live_bytes = ATOMIC_VAR_INIT(0);
+static atomic_size_t block_peak_bytes = ATOMIC_VAR_INIT(0);
+
+static void block_AccountAlloc(size_t size)
+{
+    atomic_fetch_add_explicit(&block_live_count, 1, memory_order_relaxed);
+
+    size_t bytes = atomic_fetch_add_explicit(&block_live_bytes, size,
+                                             memory_order_relaxed) + size;
+    size_t peak = atomic_load_explicit(&block_peak_bytes,
+                                       memory_order_relaxed);
+    while (bytes > peak
+        && !atomic_compare_exchange_weak_explicit(&block_peak_bytes, &peak,
+                                                  bytes, memory_order_relaxed,
+                                                  memory_order_relaxed));
+}
+
+static void block_AccountFree(size_t size)
+{
+    atomic_fetch_sub_explicit(&block_live_count, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&block_live_bytes, size, memory_order_relaxed);
+}
+
+void block_AllocationStats(size_t *restrict count, size_t *restrict bytes,
+                           size_t *restrict peak_bytes)
+{
+    *count = atomic_load_explicit(&block_live_count, memory_order_relaxed);
+    *bytes = atomic_load_explicit(&block_live_bytes, memory_order_relaxed);
+    *peak_bytes = atomic_load_explicit(&block_peak_bytes,
+                                       memory_order_relaxed);
+}
+
+static void block_OutOfMemory(size_t size)
+{
+    size_t count, bytes, peak;
+
+    block_AllocationStats(&count, &bytes, &peak);
+    fprintf(stderr, "block allocation failure (%zu bytes): "
+            "%zu live blocks holding %zu bytes (peak %zu bytes)\n",
+            size, count, bytes, peak);
+}
+
 block_t *block_Init(block_t *restrict b, const struct vlc_block_callbacks *cbs,
                     void *buf, size_t size)
 {
+    block_AccountAlloc(size);
+
     /* Fill all fields to their default */
     b->p_next = NULL;
     b->p_buffer = buf;
@@ -105,6 +161,121 @@ static void BlockMetaCopy( block_t *restrict out, const block_t *in )
 /** Initial reserved header and footer size. */
 #define BLOCK_PADDING      32
 
+/*** Per-thread block cache ***/
+
+/* Size classes (payload bytes) for the per-thread freelists. The first two
+ * classes cover multiplexed TS/PES packet sizes (188/1316 bytes and typical
+ * PES reassembly), the larger ones cover compressed video access units. */
+static const size_t block_cache_sizes[] = { 2048, 16384, 65536, 262144 };
+#define BLOCK_CACHE_CLASSES \
+    (sizeof (block_cache_sizes) / sizeof (block_cache_sizes[0]))
+
+/** Maximum number of cached blocks per thread and per size class. */
+#define BLOCK_CACHE_DEPTH   32
+
+struct block_cache
+{
+    block_t *free[BLOCK_CACHE_CLASSES];
+    unsigned depth[BLOCK_CACHE_CLASSES];
+};
+
+static bool block_cache_enabled = false;
+static vlc_threadvar_t block_cache_key;
+static thread_local struct block_cache *block_cache = NULL;
+
+static void block_cache_Destroy (void *data)
+{
+    struct block_cache *cache = data;
+
+    for (size_t i = 0; i < BLOCK_CACHE_CLASSES; i++)
+        for (block_t *b = cache->free[i], *next; b != NULL; b = next)
+        {
+            next = b->p_next;
+            free (b);
+        }
+    free (cache);
+}
+
+void block_CacheEnable (void)
+{
+    if (block_cache_enabled)
+        return;
+    if (vlc_threadvar_create (&block_cache_key, block_cache_Destroy) == 0)
+        block_cache_enabled = true;
+}
+
+static struct block_cache *block_cache_Get (void)
+{
+    struct block_cache *cache = block_cache;
+
+    if (unlikely(cache == NULL))
+    {
+        cache = calloc (1, sizeof (*cache));
+        if (unlikely(cache == NULL))
+            return NULL;
+        /* Register for clean-up on thread exit. */
+        vlc_threadvar_set (block_cache_key, cache);
+        block_cache = cache;
+    }
+    return cache;
+}
+
+static void block_cache_Release (block_t *);
+
+/* One callback table per size class: the class of a cached block is inferred
+ * from its callbacks pointer, so no extra per-block field is needed. */
+static const struct vlc_block_callbacks block_cache_cbs[BLOCK_CACHE_CLASSES] =
+{
+    { block_cache_Release }, { block_cache_Release },
+    { block_cache_Release }, { block_cache_Release },
+};
+
+static void block_cache_Release (block_t *block)
+{
+    size_t cls = block->cbs - block_cache_cbs;
+    struct block_cache *cache = block_cache_enabled ? block_cache_Get () : NULL;
+
+    assert (cls < BLOCK_CACHE_CLASSES);
+    if (cache == NULL || cache->depth[cls] >= BLOCK_CACHE_DEPTH)
+    {
+        free (block);
+        return;
+    }
+    block->p_next = cache->free[cls];
+    cache->free[cls] = block;
+    cache->depth[cls]++;
+}
+
+static block_t *block_cache_Alloc (size_t size)
+{
+    size_t cls = 0;
+
+    while (block_cache_sizes[cls] < size)
+        if (++cls >= BLOCK_CACHE_CLASSES)
+            return NULL; /* too large: fall back to plain malloc() */
+
+    struct block_cache *cache = block_cache_Get ();
+    if (unlikely(cache == NULL))
+        return NULL;
+
+    block_t *b = cache->free[cls];
+    if (b != NULL)
+    {
+        cache->free[cls] = b->p_next;
+        cache->depth[cls]--;
+    }
+    else
+    {
+        b = malloc (sizeof (*b) + BLOCK_ALIGN + (2 * BLOCK_PADDING)
+                    + block_cache_sizes[cls]);
+        if (unlikely(b == NULL))
+            return NULL;
+    }
+    block_Init(b, &block_cache_cbs[cls], b + 1,
+               BLOCK_ALIGN + (2 * BLOCK_PADDING) + block_cache_sizes[cls]);
+    return b;
+}
+
 block_t *block_Alloc (size_t size)
 {
     if (unlikely(size >> 27))
@@ -113,17 +284,27 @@ block_t *block_Alloc (size_t size)
         return NULL;
     }
 
-    /* 2 * BLOCK_PADDING: pre + post padding */
-    const size_t alloc = sizeof (block_t) + BLOCK_ALIGN + (2 * BLOCK_PADDING)
-                       + size;
-    if (unlikely(alloc <= size))
-        return NULL;
+    block_t *b;
 
-    block_t *b = malloc (alloc);
-    if (unlikely(b == NULL))
-        return NULL;
+    if (block_cache_enabled && (b = block_cache_Alloc (size)) != NULL)
+        ;
+    else
+    {
+        /* 2 * BLOCK_PADDING: pre + post padding */
+        const size_t alloc = sizeof (block_t) + BLOCK_ALIGN
+                           + (2 * BLOCK_PADDING) + size;
+        if (unlikely(alloc <= size))
+            return NULL;
 
-    block_Init(b, &block_generic_cbs, b + 1, alloc - sizeof (*b));
+        b = malloc (alloc);
+        if (unlikely(b == NULL))
+        {
+            block_OutOfMemory(size);
+            return NULL;
+        }
+
+        block_Init(b, &block_generic_cbs, b + 1, alloc - sizeof (*b));
+    }
     static_assert ((BLOCK_PADDING % BLOCK_ALIGN) == 0,
                    "BLOCK_PADDING must be a multiple of BLOCK_ALIGN");
     b->p_buffer += BLOCK_PADDING + BLOCK_ALIGN - 1;
@@ -138,6 +319,7 @@ void block_Release(block_t *block)
     block->p_next = NULL;
     block_Check (block);
 #endif
+    block_AccountFree(block->i_size);
     block->cbs->free(block);
 }
 
@@ -403,7 +585,15 @@ block_t *block_File(int fd, bool write)
         void *addr = mmap(NULL, length, prot, flags, fd, 0);
 
         if (addr != MAP_FAILED)
+        {
+            /* The mapping is zero-copy and page-cache-backed; ask the kernel
+             * to start reading it in so that callers do not pay one major
+             * fault per page later (can be very slow on network mounts). */
+# ifdef POSIX_MADV_WILLNEED
+            posix_madvise (addr, length, POSIX_MADV_WILLNEED);
+# endif
             return block_mmap_Alloc (addr, length);
+        }
     }
 #endif
 
@@ -263,6 +263,37 @@ VLC_WEAK unsigned vlc_CPU(void)
     return cpu_flags;
 }
 
+/**
+ * Selects a CPU-optimized kernel variant from a dispatch table.
+ * The last entry whose capability requirements are all met wins, so tables
+ * are ordered from the plain C fallback up to the most specific variant.
+ */
+void (*vlc_CPU_kernel(const struct vlc_cpu_kernel *tab, size_t count))(void)
+{
+    unsigned flags = vlc_CPU();
+    const char *force = getenv("VLC_KERNEL");
+    void (*func)(void) = NULL;
+
+    if (force != NULL)
+        for (size_t i = 0; i < count; i++)
+            if (!strcmp(tab[i].name, force))
+            {
+                if ((flags & tab[i].cpu) == tab[i].cpu)
+                    return tab[i].func;
+
+                fprintf (stderr, "Warning: cannot force the %s kernel "
+                         "variant: unsupported by your CPU.\n", force);
+                break;
+            }
+
+    for (size_t i = 0; i < count; i++)
+        if ((flags & tab[i].cpu) == tab[i].cpu)
+            func = tab[i].func;
+
+    assert(func != NULL); /* first entry must be a plain C fallback */
+    return func;
+}
+
 void vlc_CPU_dump (vlc_object_t *obj)
 {
     struct vlc_memstream stream;
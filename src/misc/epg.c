@@ -219,6 +219,93 @@ void vlc_epg_SetCurrent( vlc_epg_t *p_epg, int64_t i_start )
     }
 }
 
+static bool vlc_epg_event_Equals( const vlc_epg_event_t *p_a,
+                                  const vlc_epg_event_t *p_b )
+{
+    if( p_a->i_id != p_b->i_id || p_a->i_start != p_b->i_start ||
+        p_a->i_duration != p_b->i_duration || p_a->i_rating != p_b->i_rating ||
+        p_a->i_description_items != p_b->i_description_items )
+        return false;
+
+    if( !!p_a->psz_name != !!p_b->psz_name ||
+        ( p_a->psz_name && strcmp( p_a->psz_name, p_b->psz_name ) ) )
+        return false;
+    if( !!p_a->psz_short_description != !!p_b->psz_short_description ||
+        ( p_a->psz_short_description &&
+          strcmp( p_a->psz_short_description, p_b->psz_short_description ) ) )
+        return false;
+    if( !!p_a->psz_description != !!p_b->psz_description ||
+        ( p_a->psz_description &&
+          strcmp( p_a->psz_description, p_b->psz_description ) ) )
+        return false;
+
+    for( int i = 0; i < p_a->i_description_items; i++ )
+    {
+        if( strcmp( p_a->description_items[i].psz_key,
+                    p_b->description_items[i].psz_key ) ||
+            strcmp( p_a->description_items[i].psz_value,
+                    p_b->description_items[i].psz_value ) )
+            return false;
+    }
+
+    return true;
+}
+
+void vlc_epg_Update( vlc_epg_t *p_dst, const vlc_epg_t *p_src )
+{
+    free( p_dst->psz_name );
+    p_dst->psz_name = ( p_src->psz_name ) ? strdup( p_src->psz_name ) : NULL;
+    p_dst->b_present = p_src->b_present;
+
+    /* Merge walk over both start-time ordered lists, keeping events which
+     * did not change instead of reallocating them */
+    size_t i = 0;
+    for( size_t j = 0; j < p_src->i_event; j++ )
+    {
+        const vlc_epg_event_t *p_new = p_src->pp_event[j];
+
+        /* Drop stored events no longer part of the update */
+        while( i < p_dst->i_event &&
+               p_dst->pp_event[i]->i_start < p_new->i_start )
+        {
+            vlc_epg_event_Delete( p_dst->pp_event[i] );
+            TAB_ERASE( p_dst->i_event, p_dst->pp_event, i );
+        }
+
+        if( i < p_dst->i_event &&
+            p_dst->pp_event[i]->i_start == p_new->i_start &&
+            vlc_epg_event_Equals( p_dst->pp_event[i], p_new ) )
+        {
+            i++; /* unchanged */
+            continue;
+        }
+
+        vlc_epg_event_t *p_dup = vlc_epg_event_Duplicate( p_new );
+        if( !p_dup )
+            continue;
+
+        if( i < p_dst->i_event &&
+            p_dst->pp_event[i]->i_start == p_new->i_start )
+        {
+            vlc_epg_event_Delete( p_dst->pp_event[i] );
+            p_dst->pp_event[i] = p_dup;
+        }
+        else
+            TAB_INSERT( p_dst->i_event, p_dst->pp_event, p_dup, i );
+        i++;
+    }
+
+    /* Drop trailing stale events */
+    while( p_dst->i_event > i )
+    {
+        vlc_epg_event_Delete( p_dst->pp_event[p_dst->i_event - 1] );
+        TAB_ERASE( p_dst->i_event, p_dst->pp_event, p_dst->i_event - 1 );
+    }
+
+    vlc_epg_SetCurrent( p_dst, p_src->p_current ? p_src->p_current->i_start
+                                                : -1 );
+}
+
 vlc_epg_t * vlc_epg_Duplicate( const vlc_epg_t *p_src )
 {
     vlc_epg_t *p_epg = vlc_epg_New( p_src->i_id, p_src->i_source_id );
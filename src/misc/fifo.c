@@ -26,12 +26,16 @@
 #endif
 
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 
 #include <vlc_common.h>
 #include <vlc_block.h>
 #include "libvlc.h"
 
+/** Single-producer/single-consumer ring size (must be a power of two). */
+#define BLOCK_FIFO_RING 256
+
 /**
  * Internal state for block queues
  */
@@ -44,6 +48,17 @@ struct block_fifo_t
     block_t             **pp_last;
     size_t              i_depth;
     size_t              i_size;
+
+    /* Lock-free single-producer/single-consumer mode (block_FifoNewSPSC()).
+     * The ring is the fast path; if it overflows, the producer degrades to
+     * the locked list above until the consumer has drained both. */
+    bool                spsc;
+    atomic_bool         degraded; /**< Ring overflowed into the list */
+    atomic_bool         sleeping; /**< Consumer is (about to be) waiting */
+    atomic_uint         head; /**< Consumer index */
+    atomic_uint         tail; /**< Producer index */
+    atomic_size_t       ring_size; /**< Bytes currently in the ring */
+    block_t            *ring[BLOCK_FIFO_RING];
 };
 
 void vlc_fifo_Lock(vlc_fifo_t *fifo)
@@ -152,30 +167,132 @@ block_fifo_t *block_FifoNew( void )
     p_fifo->p_first = NULL;
     p_fifo->pp_last = &p_fifo->p_first;
     p_fifo->i_depth = p_fifo->i_size = 0;
+    p_fifo->spsc = false;
+    atomic_init( &p_fifo->degraded, false );
+    atomic_init( &p_fifo->sleeping, false );
+    atomic_init( &p_fifo->head, 0 );
+    atomic_init( &p_fifo->tail, 0 );
+    atomic_init( &p_fifo->ring_size, 0 );
+
+    return p_fifo;
+}
 
+block_fifo_t *block_FifoNewSPSC( void )
+{
+    block_fifo_t *p_fifo = block_FifoNew();
+    if( p_fifo != NULL )
+        p_fifo->spsc = true;
     return p_fifo;
 }
 
 void block_FifoRelease( block_fifo_t *p_fifo )
 {
+    if( p_fifo->spsc )
+    {   /* No other thread may be using the FIFO at this point. */
+        unsigned head = atomic_load_explicit( &p_fifo->head,
+                                              memory_order_relaxed );
+        unsigned tail = atomic_load_explicit( &p_fifo->tail,
+                                              memory_order_relaxed );
+        while( head != tail )
+            block_Release( p_fifo->ring[head++ % BLOCK_FIFO_RING] );
+    }
     block_ChainRelease( p_fifo->p_first );
     vlc_cond_destroy( &p_fifo->wait );
     vlc_mutex_destroy( &p_fifo->lock );
     free( p_fifo );
 }
 
+/**
+ * Producer side of the lock-free ring. Slots are published by the release
+ * store to the tail index.
+ */
+static bool vlc_fifo_TryPushRing(block_fifo_t *fifo, block_t *block)
+{
+    unsigned tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+
+    if (tail - head >= BLOCK_FIFO_RING)
+        return false; /* full */
+
+    fifo->ring[tail % BLOCK_FIFO_RING] = block;
+    atomic_fetch_add_explicit(&fifo->ring_size, block->i_buffer,
+                              memory_order_relaxed);
+    atomic_store_explicit(&fifo->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Consumer side of the lock-free ring.
+ */
+static block_t *vlc_fifo_TryPopRing(block_fifo_t *fifo)
+{
+    unsigned head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+
+    if (head == tail)
+        return NULL; /* empty */
+
+    block_t *block = fifo->ring[head % BLOCK_FIFO_RING];
+    atomic_fetch_sub_explicit(&fifo->ring_size, block->i_buffer,
+                              memory_order_relaxed);
+    atomic_store_explicit(&fifo->head, head + 1, memory_order_release);
+    return block;
+}
+
 void block_FifoEmpty(block_fifo_t *fifo)
 {
     block_t *block;
 
     vlc_fifo_Lock(fifo);
+    if (fifo->spsc)
+        while ((block = vlc_fifo_TryPopRing(fifo)) != NULL)
+            block_Release(block);
     block = vlc_fifo_DequeueAllUnlocked(fifo);
+    atomic_store(&fifo->degraded, false);
     vlc_fifo_Unlock(fifo);
     block_ChainRelease(block);
 }
 
 void block_FifoPut(block_fifo_t *fifo, block_t *block)
 {
+    if (fifo->spsc)
+    {
+        block_t *next;
+        bool queued = false;
+
+        for (; block != NULL; block = next)
+        {
+            next = block->p_next;
+            block->p_next = NULL;
+
+            if (!atomic_load_explicit(&fifo->degraded, memory_order_relaxed)
+             && vlc_fifo_TryPushRing(fifo, block))
+            {
+                queued = true;
+                continue;
+            }
+
+            /* Ring full: degrade to the locked list. The producer stays on
+             * the list until the consumer has drained the ring and the list,
+             * so that delivery order is preserved. */
+            vlc_fifo_Lock(fifo);
+            atomic_store(&fifo->degraded, true);
+            vlc_fifo_QueueUnlocked(fifo, block);
+            vlc_fifo_Unlock(fifo);
+        }
+
+        /* Wake the consumer only if it is (about to go) asleep. The fence
+         * pairs with the one in block_FifoGet(). */
+        atomic_thread_fence(memory_order_seq_cst);
+        if (queued && atomic_load(&fifo->sleeping))
+        {
+            vlc_fifo_Lock(fifo);
+            vlc_cond_broadcast(&fifo->wait);
+            vlc_fifo_Unlock(fifo);
+        }
+        return;
+    }
+
     vlc_fifo_Lock(fifo);
     vlc_fifo_QueueUnlocked(fifo, block);
     vlc_fifo_Unlock(fifo);
@@ -187,6 +304,47 @@ block_t *block_FifoGet(block_fifo_t *fifo)
 
     vlc_testcancel();
 
+    if (fifo->spsc)
+    {
+        for (;;)
+        {
+            block = vlc_fifo_TryPopRing(fifo);
+            if (block != NULL)
+                return block;
+
+            vlc_fifo_Lock(fifo);
+            if (atomic_load(&fifo->degraded))
+            {   /* Drain any ring leftovers first to preserve ordering. */
+                block = vlc_fifo_TryPopRing(fifo);
+                if (block == NULL)
+                {
+                    block = vlc_fifo_DequeueUnlocked(fifo);
+                    if (block != NULL && fifo->p_first == NULL)
+                        atomic_store(&fifo->degraded, false);
+                }
+                if (block != NULL)
+                {
+                    vlc_fifo_Unlock(fifo);
+                    return block;
+                }
+            }
+
+            atomic_store(&fifo->sleeping, true);
+            atomic_thread_fence(memory_order_seq_cst);
+            block = vlc_fifo_TryPopRing(fifo);
+            if (block == NULL)
+            {
+                vlc_fifo_CleanupPush(fifo);
+                vlc_fifo_Wait(fifo);
+                vlc_cleanup_pop();
+            }
+            atomic_store(&fifo->sleeping, false);
+            vlc_fifo_Unlock(fifo);
+            if (block != NULL)
+                return block;
+        }
+    }
+
     vlc_fifo_Lock(fifo);
     while (vlc_fifo_IsEmpty(fifo))
     {
@@ -204,6 +362,16 @@ block_t *block_FifoShow( block_fifo_t *p_fifo )
 {
     block_t *b;
 
+    if( p_fifo->spsc )
+    {   /* Consumer thread only */
+        unsigned head = atomic_load_explicit( &p_fifo->head,
+                                              memory_order_relaxed );
+        unsigned tail = atomic_load_explicit( &p_fifo->tail,
+                                              memory_order_acquire );
+        if( head != tail )
+            return p_fifo->ring[head % BLOCK_FIFO_RING];
+    }
+
     vlc_mutex_lock( &p_fifo->lock );
     assert(p_fifo->p_first != NULL);
     b = p_fifo->p_first;
@@ -220,6 +388,8 @@ size_t block_FifoSize (block_fifo_t *fifo)
     vlc_mutex_lock (&fifo->lock);
     size = fifo->i_size;
     vlc_mutex_unlock (&fifo->lock);
+    if (fifo->spsc)
+        size += atomic_load_explicit (&fifo->ring_size, memory_order_relaxed);
     return size;
 }
 
@@ -231,5 +401,13 @@ size_t block_FifoCount (block_fifo_t *fifo)
     vlc_mutex_lock (&fifo->lock);
     depth = fifo->i_depth;
     vlc_mutex_unlock (&fifo->lock);
+    if (fifo->spsc)
+    {
+        unsigned head = atomic_load_explicit (&fifo->head,
+                                              memory_order_relaxed);
+        unsigned tail = atomic_load_explicit (&fifo->tail,
+                                              memory_order_acquire);
+        depth += tail - head;
+    }
     return depth;
 }
@@ -29,9 +29,18 @@
 #include <vlc_modules.h>
 #include <vlc_mouse.h>
 #include <vlc_spu.h>
+#include <vlc_picture_pool.h>
 #include <libvlc.h>
 #include <assert.h>
 
+#include "picture.h"
+
+/* Pictures drawn by a mid-chain filter live only until the next filter has
+ * consumed them: one being filtered, one in a pipeline mailbox, one being
+ * produced. The pool refills transparently from the heap if a filter ever
+ * holds more. */
+#define FILTER_POOL_SIZE 3
+
 typedef struct chained_filter_t
 {
     /* Public part of the filter structure */
@@ -40,8 +49,31 @@ typedef struct chained_filter_t
     struct chained_filter_t *prev, *next;
     vlc_mouse_t *mouse;
     picture_t *pending;
+    struct filter_worker *worker; /**< Pipelined execution stage, or NULL */
+    picture_pool_t *pool; /**< Mid-chain output picture pool, or NULL */
+    vlc_fourcc_t pool_chroma; /**< Format the pool was created for */
+    unsigned pool_width, pool_height;
+    picture_t *in_place; /**< Input of the running pf_video_filter, when
+                              eligible for in-place processing */
 } chained_filter_t;
 
+/**
+ * A worker thread running one filter stage in pipelined mode, fed through a
+ * one-picture mailbox (see filter_chain_PipelineStart()).
+ */
+struct filter_worker
+{
+    chained_filter_t *owner;
+    vlc_thread_t thread;
+    vlc_mutex_t lock;
+    vlc_cond_t wait_in;  /**< Signaled when the mailbox is filled */
+    vlc_cond_t wait_out; /**< Signaled when the mailbox empties or the stage
+                              goes idle */
+    picture_t *input;    /**< One-picture mailbox */
+    bool busy;           /**< The stage is filtering or delivering a picture */
+    bool dead;
+};
+
 /* Only use this with filter objects from _this_ C module */
 static inline chained_filter_t *chained(filter_t *filter)
 {
@@ -61,12 +93,24 @@ struct filter_chain_t
     bool b_allow_fmt_out_change; /**< Can the output format be changed? */
     const char *filter_cap; /**< Filter modules capability */
     const char *conv_cap; /**< Converter modules capability */
+
+    /* Pipelined execution (filter_chain_PipelineStart) */
+    struct
+    {
+        bool enabled;
+        bool flushing; /**< Discard stage output instead of queueing it */
+        vlc_mutex_t lock;
+        picture_t *first, **lastp; /**< Completed pictures, in order */
+        unsigned depth;
+        unsigned max_pending; /**< Bound on completed, unretrieved pictures */
+    } pipeline;
 };
 
 /**
  * Local prototypes
  */
 static void FilterDeletePictures( picture_t * );
+static picture_t *FilterSingleVideo( chained_filter_t *, picture_t * );
 
 static filter_chain_t *filter_chain_NewInner( const filter_owner_t *callbacks,
     const char *cap, const char *conv_cap, bool fmt_out_change,
@@ -89,6 +133,13 @@ static filter_chain_t *filter_chain_NewInner( const filter_owner_t *callbacks,
     chain->b_allow_fmt_out_change = fmt_out_change;
     chain->filter_cap = cap;
     chain->conv_cap = conv_cap;
+    chain->pipeline.enabled = false;
+    chain->pipeline.flushing = false;
+    vlc_mutex_init( &chain->pipeline.lock );
+    chain->pipeline.first = NULL;
+    chain->pipeline.lastp = &chain->pipeline.first;
+    chain->pipeline.depth = 0;
+    chain->pipeline.max_pending = 0;
     return chain;
 }
 
@@ -106,12 +157,57 @@ filter_chain_t *filter_chain_New( vlc_object_t *obj, const char *cap,
     return filter_chain_NewInner( &callbacks, cap, NULL, false, NULL, cat );
 }
 
+/** Mid-chain pooled picture allocation */
+static picture_t *FilterPoolPicture( chained_filter_t *f )
+{
+    const video_format_t *fmt = &f->filter.fmt_out.video;
+
+    if( f->pool != NULL && ( f->pool_chroma != fmt->i_chroma ||
+                             f->pool_width != fmt->i_width ||
+                             f->pool_height != fmt->i_height ) )
+    {
+        /* The output format was renegotiated */
+        picture_pool_Release( f->pool );
+        f->pool = NULL;
+    }
+
+    if( f->pool == NULL )
+    {
+        f->pool = picture_pool_NewFromFormat( fmt, FILTER_POOL_SIZE );
+        if( f->pool != NULL )
+        {
+            f->pool_chroma = fmt->i_chroma;
+            f->pool_width = fmt->i_width;
+            f->pool_height = fmt->i_height;
+        }
+    }
+
+    if( f->pool != NULL )
+    {
+        picture_t *pic = picture_pool_Get( f->pool );
+        if( pic != NULL )
+            return pic;
+    }
+    /* Pool exhausted (or unavailable): fall back to the heap */
+    return picture_NewFromFormat( fmt );
+}
+
 /** Chained filter picture allocator function */
 static picture_t *filter_chain_VideoBufferNew( filter_t *filter )
 {
-    if( chained(filter)->next != NULL )
+    chained_filter_t *f = chained(filter);
+
+    if( f->next != NULL )
     {
-        picture_t *pic = picture_NewFromFormat( &filter->fmt_out.video );
+        if( f->in_place != NULL )
+        {
+            /* The filter processes in place: hand its input back */
+            picture_t *pic = f->in_place;
+            f->in_place = NULL;
+            return picture_Hold( pic );
+        }
+
+        picture_t *pic = FilterPoolPicture( f );
         if( pic == NULL )
             msg_Err( filter, "Failed to allocate picture" );
         return pic;
@@ -151,9 +247,12 @@ filter_chain_t *filter_chain_NewVideo( vlc_object_t *obj, bool allow_change,
  */
 void filter_chain_Delete( filter_chain_t *p_chain )
 {
+    filter_chain_PipelineStop( p_chain );
+
     while( p_chain->first != NULL )
         filter_chain_DeleteFilter( p_chain, &p_chain->first->filter );
 
+    vlc_mutex_destroy( &p_chain->pipeline.lock );
     es_format_Clean( &p_chain->fmt_in );
     es_format_Clean( &p_chain->fmt_out );
 
@@ -165,6 +264,8 @@ void filter_chain_Delete( filter_chain_t *p_chain )
 void filter_chain_Reset( filter_chain_t *p_chain, const es_format_t *p_fmt_in,
                          const es_format_t *p_fmt_out )
 {
+    filter_chain_PipelineStop( p_chain );
+
     while( p_chain->first != NULL )
         filter_chain_DeleteFilter( p_chain, &p_chain->first->filter );
 
@@ -250,6 +351,9 @@ static filter_t *filter_chain_AppendInner( filter_chain_t *chain,
         vlc_mouse_Init( mouse );
     chained->mouse = mouse;
     chained->pending = NULL;
+    chained->worker = NULL;
+    chained->pool = NULL;
+    chained->in_place = NULL;
 
     msg_Dbg( parent, "Filter '%s' (%p) appended to chain",
              (name != NULL) ? name : module_get_name(filter->p_module, false),
@@ -287,6 +391,9 @@ void filter_chain_DeleteFilter( filter_chain_t *chain, filter_t *filter )
     vlc_object_t *obj = chain->callbacks.sys;
     chained_filter_t *chained = (chained_filter_t *)filter;
 
+    /* The chain must not be modified while pipelined execution runs */
+    assert( chained->worker == NULL );
+
     /* Remove it from the chain */
     if( chained->prev != NULL )
         chained->prev->next = chained->next;
@@ -309,6 +416,8 @@ void filter_chain_DeleteFilter( filter_chain_t *chain, filter_t *filter )
     msg_Dbg( obj, "Filter %p removed from chain", (void *)filter );
     FilterDeletePictures( chained->pending );
 
+    if( chained->pool != NULL )
+        picture_pool_Release( chained->pool );
     free( chained->mouse );
     es_format_Clean( &filter->fmt_out );
     es_format_Clean( &filter->fmt_in );
@@ -394,12 +503,220 @@ const es_format_t *filter_chain_GetFmtOut( filter_chain_t *p_chain )
     return &p_chain->fmt_out;
 }
 
+/**
+ * Appends a completed picture to the chain output queue. The queue may never
+ * block the stages (the caller could be blocked feeding the first stage), so
+ * when it overflows, the oldest picture is dropped, as the sequential path
+ * does with stale pending pictures.
+ */
+static void PipelineOutputPush( filter_chain_t *chain, picture_t *pic )
+{
+    vlc_object_t *obj = chain->callbacks.sys;
+
+    vlc_mutex_lock( &chain->pipeline.lock );
+    if( chain->pipeline.enabled && !chain->pipeline.flushing )
+    {
+        if( chain->pipeline.depth >= chain->pipeline.max_pending )
+        {
+            picture_t *drop = chain->pipeline.first;
+
+            msg_Warn( obj, "dropping pictures" );
+            chain->pipeline.first = drop->p_next;
+            if( chain->pipeline.first == NULL )
+                chain->pipeline.lastp = &chain->pipeline.first;
+            drop->p_next = NULL;
+            chain->pipeline.depth--;
+            picture_Release( drop );
+        }
+        *chain->pipeline.lastp = pic;
+        chain->pipeline.lastp = &pic->p_next;
+        chain->pipeline.depth++;
+    }
+    else
+        picture_Release( pic );
+    vlc_mutex_unlock( &chain->pipeline.lock );
+}
+
+static picture_t *PipelineOutputPop( filter_chain_t *chain )
+{
+    vlc_mutex_lock( &chain->pipeline.lock );
+    picture_t *pic = chain->pipeline.first;
+    if( pic != NULL )
+    {
+        chain->pipeline.first = pic->p_next;
+        if( chain->pipeline.first == NULL )
+            chain->pipeline.lastp = &chain->pipeline.first;
+        pic->p_next = NULL;
+        chain->pipeline.depth--;
+    }
+    vlc_mutex_unlock( &chain->pipeline.lock );
+    return pic;
+}
+
+/**
+ * Hands a picture to a stage, blocking while its mailbox is full. This is the
+ * back-pressure making the chain run at the pace of its slowest stage.
+ */
+static void PipelineStagePush( struct filter_worker *w, picture_t *pic )
+{
+    vlc_mutex_lock( &w->lock );
+    while( w->input != NULL && !w->dead )
+        vlc_cond_wait( &w->wait_out, &w->lock );
+    if( w->dead )
+        picture_Release( pic );
+    else
+    {
+        w->input = pic;
+        vlc_cond_signal( &w->wait_in );
+    }
+    vlc_mutex_unlock( &w->lock );
+}
+
+/** Waits until a stage has emptied its mailbox and delivered its output */
+static void PipelineStageWait( struct filter_worker *w )
+{
+    vlc_mutex_lock( &w->lock );
+    while( w->input != NULL || w->busy )
+        vlc_cond_wait( &w->wait_out, &w->lock );
+    vlc_mutex_unlock( &w->lock );
+}
+
+static void *PipelineStageThread( void *data )
+{
+    struct filter_worker *w = data;
+    chained_filter_t *f = w->owner;
+    filter_chain_t *chain = f->filter.owner.sys;
+
+    vlc_mutex_lock( &w->lock );
+    for( ;; )
+    {
+        while( w->input == NULL && !w->dead )
+            vlc_cond_wait( &w->wait_in, &w->lock );
+        if( w->input == NULL )
+            break;
+
+        picture_t *pic = w->input;
+        w->input = NULL;
+        w->busy = true;
+        vlc_cond_broadcast( &w->wait_out );
+        vlc_mutex_unlock( &w->lock );
+
+        pic = FilterSingleVideo( f, pic );
+        while( pic != NULL )
+        {
+            picture_t *next = pic->p_next;
+            pic->p_next = NULL;
+            if( f->next != NULL )
+                PipelineStagePush( f->next->worker, pic );
+            else
+                PipelineOutputPush( chain, pic );
+            pic = next;
+        }
+
+        vlc_mutex_lock( &w->lock );
+        w->busy = false;
+        vlc_cond_broadcast( &w->wait_out );
+    }
+    vlc_mutex_unlock( &w->lock );
+    return NULL;
+}
+
+int filter_chain_PipelineStart( filter_chain_t *chain )
+{
+    assert( !chain->pipeline.enabled );
+    assert( chain->fmt_in.i_cat == VIDEO_ES );
+    if( chain->first == NULL )
+        return VLC_EGENERIC;
+
+    unsigned stages = 0;
+    for( chained_filter_t *f = chain->first; f != NULL; f = f->next )
+        stages++;
+
+    chain->pipeline.flushing = false;
+    assert( chain->pipeline.first == NULL );
+    /* Bound the end-to-end latency to about one picture per stage */
+    chain->pipeline.max_pending = stages + 2;
+    chain->pipeline.enabled = true;
+
+    for( chained_filter_t *f = chain->first; f != NULL; f = f->next )
+    {
+        struct filter_worker *w = malloc( sizeof (*w) );
+        if( likely(w != NULL) )
+        {
+            w->owner = f;
+            vlc_mutex_init( &w->lock );
+            vlc_cond_init( &w->wait_in );
+            vlc_cond_init( &w->wait_out );
+            w->input = NULL;
+            w->busy = false;
+            w->dead = false;
+            f->worker = w;
+            if( vlc_clone( &w->thread, PipelineStageThread, w,
+                           VLC_THREAD_PRIORITY_VIDEO ) == 0 )
+                continue;
+
+            f->worker = NULL;
+            vlc_cond_destroy( &w->wait_out );
+            vlc_cond_destroy( &w->wait_in );
+            vlc_mutex_destroy( &w->lock );
+            free( w );
+        }
+        filter_chain_PipelineStop( chain );
+        return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+void filter_chain_PipelineStop( filter_chain_t *chain )
+{
+    if( !chain->pipeline.enabled )
+        return;
+
+    /* Discard further output instead of queueing it */
+    vlc_mutex_lock( &chain->pipeline.lock );
+    chain->pipeline.flushing = true;
+    vlc_mutex_unlock( &chain->pipeline.lock );
+
+    /* Stop front to back, so each stage has received its last picture by
+     * the time its thread is reaped */
+    for( chained_filter_t *f = chain->first; f != NULL; f = f->next )
+    {
+        struct filter_worker *w = f->worker;
+        if( w == NULL )
+            continue;
+
+        vlc_mutex_lock( &w->lock );
+        w->dead = true;
+        vlc_cond_broadcast( &w->wait_in );
+        vlc_cond_broadcast( &w->wait_out );
+        vlc_mutex_unlock( &w->lock );
+        vlc_join( w->thread, NULL );
+
+        assert( w->input == NULL );
+        vlc_cond_destroy( &w->wait_out );
+        vlc_cond_destroy( &w->wait_in );
+        vlc_mutex_destroy( &w->lock );
+        free( w );
+        f->worker = NULL;
+    }
+
+    vlc_mutex_lock( &chain->pipeline.lock );
+    chain->pipeline.enabled = false;
+    chain->pipeline.flushing = false;
+    picture_t *pending = chain->pipeline.first;
+    chain->pipeline.first = NULL;
+    chain->pipeline.lastp = &chain->pipeline.first;
+    chain->pipeline.depth = 0;
+    vlc_mutex_unlock( &chain->pipeline.lock );
+    FilterDeletePictures( pending );
+}
+
 static picture_t *FilterChainVideoFilter( chained_filter_t *f, picture_t *p_pic )
 {
     for( ; f != NULL; f = f->next )
     {
         filter_t *p_filter = &f->filter;
-        p_pic = p_filter->pf_video_filter( p_filter, p_pic );
+        p_pic = FilterSingleVideo( f, p_pic );
         if( !p_pic )
             break;
         if( f->pending )
@@ -415,6 +732,15 @@ static picture_t *FilterChainVideoFilter( chained_filter_t *f, picture_t *p_pic
 
 picture_t *filter_chain_VideoFilter( filter_chain_t *p_chain, picture_t *p_pic )
 {
+    if( p_chain->pipeline.enabled )
+    {
+        /* Feed the first stage and return the oldest completed picture, if
+         * any; the first few calls return NULL while the pipeline fills. */
+        if( p_pic != NULL )
+            PipelineStagePush( p_chain->first->worker, p_pic );
+        return PipelineOutputPop( p_chain );
+    }
+
     if( p_pic )
     {
         p_pic = FilterChainVideoFilter( p_chain->first, p_pic );
@@ -438,6 +764,27 @@ picture_t *filter_chain_VideoFilter( filter_chain_t *p_chain, picture_t *p_pic )
 
 void filter_chain_VideoFlush( filter_chain_t *p_chain )
 {
+    if( p_chain->pipeline.enabled )
+    {
+        /* Drain in-flight pictures into the (discarding) output queue, so
+         * all stages are idle when filter_Flush() runs below */
+        vlc_mutex_lock( &p_chain->pipeline.lock );
+        p_chain->pipeline.flushing = true;
+        vlc_mutex_unlock( &p_chain->pipeline.lock );
+
+        for( chained_filter_t *f = p_chain->first; f != NULL; f = f->next )
+            PipelineStageWait( f->worker );
+
+        vlc_mutex_lock( &p_chain->pipeline.lock );
+        picture_t *pending = p_chain->pipeline.first;
+        p_chain->pipeline.first = NULL;
+        p_chain->pipeline.lastp = &p_chain->pipeline.first;
+        p_chain->pipeline.depth = 0;
+        p_chain->pipeline.flushing = false;
+        vlc_mutex_unlock( &p_chain->pipeline.lock );
+        FilterDeletePictures( pending );
+    }
+
     for( chained_filter_t *f = p_chain->first; f != NULL; f = f->next )
     {
         filter_t *p_filter = &f->filter;
@@ -521,6 +868,32 @@ int filter_chain_MouseEvent( filter_chain_t *p_chain,
 }
 
 /* Helpers */
+
+/**
+ * Runs one filter on a picture, arming in-place processing when possible:
+ * the filter declared support (b_allow_in_place), keeps the video format
+ * unchanged, is not the last of the chain (the last one draws from the
+ * owner, e.g. directly from display buffers) and the input picture is not
+ * referenced anywhere else. filter_NewPicture() then returns the input
+ * picture itself and the filter writes straight into it.
+ */
+static picture_t *FilterSingleVideo( chained_filter_t *f, picture_t *pic )
+{
+    filter_t *filter = &f->filter;
+
+    if( filter->b_allow_in_place && f->next != NULL &&
+        filter->fmt_in.video.i_chroma == filter->fmt_out.video.i_chroma &&
+        filter->fmt_in.video.i_width == filter->fmt_out.video.i_width &&
+        filter->fmt_in.video.i_height == filter->fmt_out.video.i_height &&
+        atomic_load_explicit( &((picture_priv_t *)pic)->gc.refs,
+                              memory_order_relaxed ) == 1 )
+        f->in_place = pic;
+
+    pic = filter->pf_video_filter( filter, pic );
+    f->in_place = NULL;
+    return pic;
+}
+
 static void FilterDeletePictures( picture_t *picture )
 {
     while( picture )
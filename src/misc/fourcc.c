@@ -35,34 +35,55 @@
 
 #include "fourcc_tables.h"
 
-static int fourcc_cmp(const void *key, const void *ent)
+/* Endian-agnostic hash of a FourCC byte sequence. This MUST match
+ * hash_fourcc() in fourcc_gen.c, which builds the hash indices. */
+static uint32_t fourcc_hash(vlc_fourcc_t fourcc)
 {
-    return memcmp(key, ent, 4);
+    const unsigned char *b = (const unsigned char *)&fourcc;
+    uint32_t x = b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16)
+               | ((uint32_t)b[3] << 24);
+
+    x *= UINT32_C(0x9E3779B1);
+    return x ^ (x >> 16);
 }
 
-static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
-                           const struct fourcc_mapping *mapv, size_t mapc,
-                           const struct fourcc_desc *dscv, size_t dscc)
+/* Looks a FourCC up in a generated table through its open-addressing
+ * hash index (see emit_hash() in fourcc_gen.c). */
+static const void *fourcc_find(vlc_fourcc_t fourcc, const void *entv,
+                               size_t entsize, const uint16_t *hashv,
+                               uint32_t hashmask)
 {
-    const struct fourcc_mapping *mapping;
-    const struct fourcc_desc *desc;
+    for (uint32_t h = fourcc_hash(fourcc);; h++)
+    {
+        uint16_t slot = hashv[h & hashmask];
+
+        if (slot == 0xFFFF)
+            return NULL;
+
+        const void *ent = (const char *)entv + slot * entsize;
+        if (memcmp(&fourcc, ent, 4) == 0)
+            return ent;
+    }
+}
 
-    mapping = bsearch(&fourcc, mapv, mapc, sizeof (*mapv), fourcc_cmp);
+#define FOURCC_FIND(fourcc, table) \
+    fourcc_find(fourcc, table, sizeof (table[0]), \
+                table##_hash, table##_hash_mask)
+
+static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
+                           const struct fourcc_mapping *mapping,
+                           const struct fourcc_desc *desc)
+{
     if (mapping != NULL)
     {
-        if (dsc != NULL)
+        if (dsc != NULL && desc != NULL)
         {
-            desc = bsearch(&fourcc, dscv, dscc, sizeof (*dscv), fourcc_cmp);
-            if (desc != NULL)
-            {
-                *dsc = desc->desc;
-                return mapping->fourcc;
-            }
+            *dsc = desc->desc;
+            return mapping->fourcc;
         }
         fourcc = mapping->fourcc;
     }
 
-    desc = bsearch(&fourcc, dscv, dscc, sizeof (*dscv), fourcc_cmp);
     if (desc == NULL)
         return 0; /* Unknown FourCC */
     if (dsc != NULL)
@@ -72,23 +93,32 @@ static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
 
 static vlc_fourcc_t LookupVideo(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_video,
-                  sizeof (mapping_video) / sizeof (mapping_video[0]),
-                  desc_video, sizeof (desc_video) / sizeof (desc_video[0]));
+    const struct fourcc_mapping *mapping = FOURCC_FIND(fourcc, mapping_video);
+    const struct fourcc_desc *desc = FOURCC_FIND(fourcc, desc_video);
+
+    if (mapping != NULL && (dsc == NULL || desc == NULL))
+        desc = FOURCC_FIND(mapping->fourcc, desc_video);
+    return Lookup(fourcc, dsc, mapping, desc);
 }
 
 static vlc_fourcc_t LookupAudio(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_audio,
-                  sizeof (mapping_audio) / sizeof (mapping_audio[0]),
-                  desc_audio, sizeof (desc_audio) / sizeof (desc_audio[0]));
+    const struct fourcc_mapping *mapping = FOURCC_FIND(fourcc, mapping_audio);
+    const struct fourcc_desc *desc = FOURCC_FIND(fourcc, desc_audio);
+
+    if (mapping != NULL && (dsc == NULL || desc == NULL))
+        desc = FOURCC_FIND(mapping->fourcc, desc_audio);
+    return Lookup(fourcc, dsc, mapping, desc);
 }
 
 static vlc_fourcc_t LookupSpu(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_spu,
-                  sizeof (mapping_spu) / sizeof (mapping_spu[0]),
-                  desc_spu, sizeof (desc_spu) / sizeof (desc_spu[0]));
+    const struct fourcc_mapping *mapping = FOURCC_FIND(fourcc, mapping_spu);
+    const struct fourcc_desc *desc = FOURCC_FIND(fourcc, desc_spu);
+
+    if (mapping != NULL && (dsc == NULL || desc == NULL))
+        desc = FOURCC_FIND(mapping->fourcc, desc_spu);
+    return Lookup(fourcc, dsc, mapping, desc);
 }
 
 static vlc_fourcc_t LookupCat(vlc_fourcc_t fourcc, const char **restrict dsc,
@@ -21,6 +21,7 @@
 /* DO NOT include "config.h" here */
 
 #include <assert.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -64,6 +65,50 @@ static int cmp_entry(const void *a, const void *b)
     return d;
 }
 
+/* Endian-agnostic hash of a FourCC byte sequence. This MUST match
+ * fourcc_hash() in fourcc.c, which looks the tables up at run time. */
+static uint32_t hash_fourcc(const char b[4])
+{
+    uint32_t x = (uint8_t)b[0] | ((uint32_t)(uint8_t)b[1] << 8)
+               | ((uint32_t)(uint8_t)b[2] << 16)
+               | ((uint32_t)(uint8_t)b[3] << 24);
+
+    x *= UINT32_C(0x9E3779B1);
+    return x ^ (x >> 16);
+}
+
+/* Emits an open-addressing (linear probing) hash index over the FourCC
+ * keys of an already-emitted table, so that lookups are O(1). */
+static void emit_hash(const char *table, char (*keys)[4], size_t n)
+{
+    size_t size = 16;
+
+    while (size < 2 * n)
+        size *= 2;
+    assert(n < 0xFFFF);
+
+    uint16_t *slots = malloc(size * sizeof (*slots));
+    if (slots == NULL)
+        abort();
+    memset(slots, 0xFF, size * sizeof (*slots)); /* 0xFFFF = empty slot */
+
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t s = hash_fourcc(keys[i]) & (size - 1);
+
+        while (slots[s] != 0xFFFF)
+            s = (s + 1) & (size - 1);
+        slots[s] = i;
+    }
+
+    printf("#define %s_hash_mask 0x%zx\n", table, size - 1);
+    printf("static const uint16_t %s_hash[] = {\n", table);
+    for (size_t i = 0; i < size; i++)
+        printf("    0x%04"PRIx16",\n", slots[i]);
+    puts("};");
+    free(slots);
+}
+
 static void process_list(const char *name, const staticentry_t *list, size_t n)
 {
     struct entry *entries = malloc(sizeof (*entries) * n);
@@ -105,6 +150,13 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
     if (dups > 0)
         exit(1);
 
+    char (*keys)[4] = malloc(sizeof (*keys) * n);
+    if (keys == NULL)
+        abort();
+
+    size_t count = 0;
+    char table[16];
+
     printf("static const struct fourcc_mapping mapping_%s[] = {\n", name);
     for (size_t i = 0; i < n; i++)
     {
@@ -115,8 +167,13 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
                entries[i].alias[0], entries[i].alias[1], entries[i].alias[2],
                entries[i].alias[3], entries[i].fourcc[0], entries[i].fourcc[1],
                entries[i].fourcc[2], entries[i].fourcc[3]);
+        memcpy(keys[count++], entries[i].alias, 4);
     }
     puts("};");
+    snprintf(table, sizeof (table), "mapping_%s", name);
+    emit_hash(table, keys, count);
+
+    count = 0;
     printf("static const struct fourcc_desc desc_%s[] = {\n", name);
     for (size_t i = 0; i < n; i++)
     {
@@ -125,9 +182,13 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
         printf("    { { { 0x%02hhx, 0x%02hhx, 0x%02hhx, 0x%02hhx } }, "
                "\"%s\" },\n", entries[i].alias[0], entries[i].alias[1],
                entries[i].alias[2], entries[i].alias[3], entries[i].desc);
+        memcpy(keys[count++], entries[i].alias, 4);
     }
     puts("};");
+    snprintf(table, sizeof (table), "desc_%s", name);
+    emit_hash(table, keys, count);
 
+    free(keys);
     free(entries);
     fprintf(stderr, "%s: %zu entries\n", name, n);
 }
@@ -170,6 +170,20 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
         }
     }
 
+    /* Pass the requested size down as a hint, so that decoders supporting
+     * native downscaled decode (JPEG IDCT scaling) produce a picture close
+     * to it instead of the full resolution; the residual, if any, still goes
+     * through the scaling filter below */
+    if( p_fmt_out->i_width > 0 && p_fmt_out->i_height > 0 )
+    {
+        var_Create( p_image->p_dec, "image-hint-width", VLC_VAR_INTEGER );
+        var_Create( p_image->p_dec, "image-hint-height", VLC_VAR_INTEGER );
+        var_SetInteger( p_image->p_dec, "image-hint-width",
+                        p_fmt_out->i_width );
+        var_SetInteger( p_image->p_dec, "image-hint-height",
+                        p_fmt_out->i_height );
+    }
+
     p_block->i_pts = p_block->i_dts = vlc_tick_now();
     int ret = p_image->p_dec->pf_decode( p_image->p_dec, p_block );
     if( ret == VLCDEC_SUCCESS )
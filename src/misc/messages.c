@@ -32,6 +32,7 @@
 # include "config.h"
 #endif
 
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <stdarg.h>                                       /* va_list for BSD */
 #include <unistd.h>
@@ -50,6 +51,9 @@ struct vlc_logger_t
     vlc_log_cb log;
     void *sys;
     module_t *module;
+    /** Highest message type the consumer cares for: messages of a higher
+     * type are dropped before the logger lock and dispatch. */
+    atomic_int verbosity;
 };
 
 static void vlc_vaLogCallback(libvlc_int_t *vlc, int type,
@@ -137,7 +141,17 @@ void vlc_vaLog (vlc_object_t *obj, int type, const char *module,
 
     /* Pass message to the callback */
     if (obj != NULL)
+    {
+        vlc_logger_t *logger = libvlc_priv(obj->obj.libvlc)->logger;
+
+        /* Fast path: drop filtered messages without dispatching them */
+        if (logger != NULL
+         && type > atomic_load_explicit(&logger->verbosity,
+                                        memory_order_relaxed))
+            return;
+
         vlc_vaLogCallback(obj->obj.libvlc, type, &msg, format, args);
+    }
 }
 
 /**
@@ -294,12 +308,13 @@ static void vlc_vaLogDiscard(void *d, int type, const vlc_log_t *item,
 
 static int vlc_logger_load(void *func, va_list ap)
 {
-    vlc_log_cb (*activate)(vlc_object_t *, void **) = func;
+    vlc_log_cb (*activate)(vlc_object_t *, void **, int *) = func;
     vlc_logger_t *logger = va_arg(ap, vlc_logger_t *);
     vlc_log_cb *cb = va_arg(ap, vlc_log_cb *);
     void **sys = va_arg(ap, void **);
+    int *verbosity = va_arg(ap, int *);
 
-    *cb = activate(VLC_OBJECT(logger), sys);
+    *cb = activate(VLC_OBJECT(logger), sys, verbosity);
     return (*cb != NULL) ? VLC_SUCCESS : VLC_EGENERIC;
 }
 
@@ -330,10 +345,13 @@ int vlc_LogPreinit(libvlc_int_t *vlc)
         return -1;
 
     vlc_rwlock_init(&logger->lock);
+    atomic_init(&logger->verbosity, VLC_MSG_DBG);
 
     if (vlc_LogEarlyOpen(logger))
     {
         logger->log = vlc_vaLogDiscard;
+        atomic_store_explicit(&logger->verbosity, VLC_MSG_INFO - 1,
+                              memory_order_relaxed);
         return -1;
     }
 
@@ -359,12 +377,17 @@ int vlc_LogInit(libvlc_int_t *vlc)
 
     vlc_log_cb cb;
     void *sys, *early_sys = NULL;
+    int verbosity = VLC_MSG_DBG; /* modules lower this if they filter */
 
     /* TODO: module configuration item */
     module_t *module = vlc_module_load(logger, "logger", NULL, false,
-                                       vlc_logger_load, logger, &cb, &sys);
+                                       vlc_logger_load, logger, &cb, &sys,
+                                       &verbosity);
     if (module == NULL)
+    {
         cb = vlc_vaLogDiscard;
+        verbosity = VLC_MSG_INFO - 1;
+    }
 
     vlc_rwlock_wrlock(&logger->lock);
     if (logger->log == vlc_vaLogEarly)
@@ -374,6 +397,8 @@ int vlc_LogInit(libvlc_int_t *vlc)
     logger->sys = sys;
     assert(logger->module == NULL); /* Only one call to vlc_LogInit()! */
     logger->module = module;
+    atomic_store_explicit(&logger->verbosity, verbosity,
+                          memory_order_relaxed);
     vlc_rwlock_unlock(&logger->lock);
 
     if (early_sys != NULL)
@@ -396,9 +421,13 @@ void vlc_LogSet(libvlc_int_t *vlc, vlc_log_cb cb, void *opaque)
 
     module_t *module;
     void *sys;
+    int verbosity = VLC_MSG_DBG; /* unknown filter: dispatch everything */
 
     if (cb == NULL)
+    {
         cb = vlc_vaLogDiscard;
+        verbosity = VLC_MSG_INFO - 1;
+    }
 
     vlc_rwlock_wrlock(&logger->lock);
     sys = logger->sys;
@@ -407,6 +436,8 @@ void vlc_LogSet(libvlc_int_t *vlc, vlc_log_cb cb, void *opaque)
     logger->log = cb;
     logger->sys = opaque;
     logger->module = NULL;
+    atomic_store_explicit(&logger->verbosity, verbosity,
+                          memory_order_relaxed);
     vlc_rwlock_unlock(&logger->lock);
 
     if (module != NULL)
@@ -280,8 +280,9 @@ void vlc_object_set_destructor( vlc_object_t *p_this,
     p_priv->pf_destructor = pf_destructor;
 }
 
-static vlc_mutex_t name_lock = VLC_STATIC_MUTEX;
-
+/* The object name is protected by the object own variables lock, not by a
+ * process-global lock: looking up or copying the name of one object must not
+ * contend with unrelated objects (several interfaces poll names). */
 #undef vlc_object_set_name
 int vlc_object_set_name(vlc_object_t *obj, const char *name)
 {
@@ -289,13 +290,13 @@ int vlc_object_set_name(vlc_object_t *obj, const char *name)
     char *newname = name ? strdup (name) : NULL;
     char *oldname;
 
-    vlc_mutex_lock (&name_lock);
+    vlc_mutex_lock (&priv->var_lock);
     oldname = priv->psz_name;
     priv->psz_name = newname;
-    vlc_mutex_unlock (&name_lock);
+    vlc_mutex_unlock (&priv->var_lock);
 
     free (oldname);
-    return (priv->psz_name || !name) ? VLC_SUCCESS : VLC_ENOMEM;
+    return (newname || !name) ? VLC_SUCCESS : VLC_ENOMEM;
 }
 
 char *vlc_object_get_name(const vlc_object_t *obj)
@@ -303,9 +304,9 @@ char *vlc_object_get_name(const vlc_object_t *obj)
     vlc_object_internals_t *priv = vlc_internals(obj);
     char *name;
 
-    vlc_mutex_lock (&name_lock);
+    vlc_mutex_lock (&priv->var_lock);
     name = priv->psz_name ? strdup (priv->psz_name) : NULL;
-    vlc_mutex_unlock (&name_lock);
+    vlc_mutex_unlock (&priv->var_lock);
 
     return name;
 }
@@ -346,8 +347,12 @@ static void vlc_object_destroy( vlc_object_t *p_this )
 static vlc_object_t *FindName (vlc_object_t *obj, const char *name)
 {
     vlc_object_internals_t *priv = vlc_internals(obj);
+    bool match;
 
-    if (priv->psz_name != NULL && !strcmp (priv->psz_name, name))
+    vlc_mutex_lock (&priv->var_lock);
+    match = priv->psz_name != NULL && !strcmp (priv->psz_name, name);
+    vlc_mutex_unlock (&priv->var_lock);
+    if (match)
         return vlc_object_hold (obj);
 
     vlc_object_t *found = NULL;
@@ -402,9 +407,7 @@ vlc_object_t *vlc_object_find_name( vlc_object_t *p_this, const char *psz_name )
     msg_Err( p_this, "looking for object \"%s\"... FIXME XXX", psz_name );
 #endif
 
-    vlc_mutex_lock (&name_lock);
     p_found = FindName (p_this, psz_name);
-    vlc_mutex_unlock (&name_lock);
     return p_found;
 }
 
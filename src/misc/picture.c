@@ -38,6 +38,45 @@
 #include "picture.h"
 #include <vlc_image.h>
 #include <vlc_block.h>
+#include <vlc_cpu.h>
+
+/* Live picture accounting: same scheme as the block counters in block.c,
+ * relaxed atomics read with picture_AllocationStats() and dumped to the
+ * standard error stream when a plane buffer allocation fails. Only pictures
+ * owning their buffers (picture_NewFromFormat()) contribute bytes. */
+static atomic_size_t picture_live_count = ATOMIC_VAR_INIT(0);
+static atomic_size_t picture_live_bytes = ATOMIC_VAR_INIT(0);
+static atomic_size_t picture_peak_bytes = ATOMIC_VAR_INIT(0);
+
+static void picture_AccountAlloc( size_t size )
+{
+    atomic_fetch_add_explicit( &picture_live_count, 1, memory_order_relaxed );
+
+    size_t bytes = atomic_fetch_add_explicit( &picture_live_bytes, size,
+                                              memory_order_relaxed ) + size;
+    size_t peak = atomic_load_explicit( &picture_peak_bytes,
+                                        memory_order_relaxed );
+    while( bytes > peak
+        && !atomic_compare_exchange_weak_explicit( &picture_peak_bytes, &peak,
+                                                   bytes, memory_order_relaxed,
+                                                   memory_order_relaxed ) );
+}
+
+static void picture_AccountFree( size_t size )
+{
+    atomic_fetch_sub_explicit( &picture_live_count, 1, memory_order_relaxed );
+    atomic_fetch_sub_explicit( &picture_live_bytes, size,
+                               memory_order_relaxed );
+}
+
+void picture_AllocationStats( size_t *restrict count, size_t *restrict bytes,
+                              size_t *restrict peak_bytes )
+{
+    *count = atomic_load_explicit( &picture_live_count, memory_order_relaxed );
+    *bytes = atomic_load_explicit( &picture_live_bytes, memory_order_relaxed );
+    *peak_bytes = atomic_load_explicit( &picture_peak_bytes,
+                                        memory_order_relaxed );
+}
 
 static void PictureDestroyContext( picture_t *p_picture )
 {
@@ -114,9 +153,12 @@ int picture_Setup( picture_t *p_picture, const video_format_t *restrict fmt )
 
     /* We want V (width/height) to respect:
         (V * p_dsc->p[i].w.i_num) % p_dsc->p[i].w.i_den == 0
-        (V * p_dsc->p[i].w.i_num/p_dsc->p[i].w.i_den * p_dsc->i_pixel_size) % 16 == 0
+        (V * p_dsc->p[i].w.i_num/p_dsc->p[i].w.i_den * p_dsc->i_pixel_size) % 64 == 0
        Which is respected if you have
-       V % lcm( p_dsc->p[0..planes].w.i_den * 16) == 0
+       V % lcm( p_dsc->p[0..planes].w.i_den * 64) == 0
+       The 64-byte pitch multiple keeps each plane line on its own set of
+       cachelines, so SIMD copies and filters never split a line across
+       a cacheline pair.
     */
     unsigned i_modulo_w = 1;
     unsigned i_modulo_h = 1;
@@ -124,7 +166,7 @@ int picture_Setup( picture_t *p_picture, const video_format_t *restrict fmt )
 
     for( unsigned i = 0; i < p_dsc->plane_count; i++ )
     {
-        i_modulo_w = LCM( i_modulo_w, 16 * p_dsc->p[i].w.den );
+        i_modulo_w = LCM( i_modulo_w, 64 * p_dsc->p[i].w.den );
         i_modulo_h = LCM( i_modulo_h, 16 * p_dsc->p[i].h.den );
         if( i_ratio_h < p_dsc->p[i].h.den )
             i_ratio_h = p_dsc->p[i].h.den;
@@ -207,6 +249,7 @@ static picture_priv_t *picture_NewPrivate(const video_format_t *restrict p_fmt)
 
     atomic_init( &priv->gc.refs, 1 );
     priv->gc.opaque = NULL;
+    priv->alloc_bytes = 0;
 
     return priv;
 }
@@ -235,6 +278,7 @@ picture_t *picture_NewFromResource( const video_format_t *p_fmt, const picture_r
         p_picture->p[i].i_pitch  = p_resource->p[i].i_pitch;
     }
 
+    picture_AccountAlloc( 0 );
     return p_picture;
 }
 
@@ -250,7 +294,10 @@ picture_t *picture_NewFromFormat(const video_format_t *restrict fmt)
 
     picture_t *pic = &priv->picture;
     if (pic->i_planes == 0)
+    {
+        picture_AccountAlloc(0);
         return pic;
+    }
 
     /* Calculate how big the new image should be */
     size_t plane_sizes[PICTURE_PLANE_MAX];
@@ -268,9 +315,17 @@ picture_t *picture_NewFromFormat(const video_format_t *restrict fmt)
     if (unlikely(pic_size >= PICTURE_SW_SIZE_MAX))
         goto error;
 
-    uint8_t *buf = aligned_alloc(16, pic_size);
+    uint8_t *buf = aligned_alloc(64, pic_size);
     if (unlikely(buf == NULL))
+    {
+        size_t count, bytes, peak;
+
+        picture_AllocationStats(&count, &bytes, &peak);
+        fprintf(stderr, "picture allocation failure (%zu bytes): "
+                "%zu live pictures holding %zu bytes (peak %zu bytes)\n",
+                pic_size, count, bytes, peak);
         goto error;
+    }
 
     /* Fill the p_pixels field for each plane */
     for (int i = 0; i < pic->i_planes; i++)
@@ -279,6 +334,8 @@ picture_t *picture_NewFromFormat(const video_format_t *restrict fmt)
         buf += plane_sizes[i];
     }
 
+    priv->alloc_bytes = pic_size;
+    picture_AccountAlloc(pic_size);
     return pic;
 error:
     free(pic);
@@ -321,6 +378,7 @@ void picture_Release( picture_t *p_picture )
         return;
 
     PictureDestroyContext( p_picture );
+    picture_AccountFree( priv->alloc_bytes );
     assert( priv->gc.destroy != NULL );
     priv->gc.destroy( p_picture );
 }
@@ -328,8 +386,82 @@ void picture_Release( picture_t *p_picture )
 /*****************************************************************************
  *
  *****************************************************************************/
+static void CopyPixelsC( uint8_t *p_dst, const uint8_t *p_src, size_t n )
+{
+    memcpy( p_dst, p_src, n );
+}
+
+#ifdef CAN_COMPILE_SSE2
+/* Below this size, a plane comfortably fits in cache and regular (cached)
+ * stores win; above it, the copy would just evict everybody else's data
+ * (typically the decoder's reference pictures), so stream the stores past
+ * the cache instead. Whole planes take the large path, single lines the
+ * small one. */
+# define COPY_NONTEMPORAL_MIN (1 << 17)
+
+# define COPY64_NT(dstp, srcp) \
+    asm volatile (                       \
+        "movdqu   0(%[src]), %%xmm1\n"   \
+        "movdqu  16(%[src]), %%xmm2\n"   \
+        "movdqu  32(%[src]), %%xmm3\n"   \
+        "movdqu  48(%[src]), %%xmm4\n"   \
+        "movntdq %%xmm1,  0(%[dst])\n"   \
+        "movntdq %%xmm2, 16(%[dst])\n"   \
+        "movntdq %%xmm3, 32(%[dst])\n"   \
+        "movntdq %%xmm4, 48(%[dst])\n"   \
+        : : [dst]"r"(dstp), [src]"r"(srcp) \
+        : "memory", "xmm1", "xmm2", "xmm3", "xmm4")
+
+VLC_SSE
+static void CopyPixelsSSE2( uint8_t *p_dst, const uint8_t *p_src, size_t n )
+{
+    if( n < COPY_NONTEMPORAL_MIN )
+    {
+        memcpy( p_dst, p_src, n );
+        return;
+    }
+
+    /* Align the destination for the non-temporal stores */
+    size_t head = (-(uintptr_t)p_dst) & 0x0f;
+    if( head )
+    {
+        memcpy( p_dst, p_src, head );
+        p_dst += head;
+        p_src += head;
+        n -= head;
+    }
+
+    size_t x = 0;
+    for( ; x + 63 < n; x += 64 )
+        COPY64_NT( &p_dst[x], &p_src[x] );
+    asm volatile ("sfence" ::: "memory");
+
+    if( x < n )
+        memcpy( &p_dst[x], &p_src[x], n - x );
+}
+#endif
+
+static void (*pf_copy_pixels)( uint8_t *, const uint8_t *, size_t );
+
+static void plane_CopySetup( void )
+{
+    static const struct vlc_cpu_kernel kernels[] =
+    {
+        VLC_CPU_KERNEL( "c", 0, CopyPixelsC ),
+#ifdef CAN_COMPILE_SSE2
+        VLC_CPU_KERNEL( "sse2", VLC_CPU_SSE2, CopyPixelsSSE2 ),
+#endif
+    };
+
+    pf_copy_pixels = ( void (*)( uint8_t *, const uint8_t *, size_t ) )
+        vlc_CPU_kernel( kernels, sizeof (kernels) / sizeof (kernels[0]) );
+}
+
 void plane_CopyPixels( plane_t *p_dst, const plane_t *p_src )
 {
+    static vlc_once_t once = VLC_STATIC_ONCE;
+    vlc_once( &once, plane_CopySetup );
+
     const unsigned i_width  = __MIN( p_dst->i_visible_pitch,
                                      p_src->i_visible_pitch );
     const unsigned i_height = __MIN( p_dst->i_visible_lines,
@@ -343,8 +475,8 @@ void plane_CopyPixels( plane_t *p_dst, const plane_t *p_src )
         p_src->i_pitch < 2*p_src->i_visible_pitch )
     {
         /* There are margins, but with the same width : perfect ! */
-        memcpy( p_dst->p_pixels, p_src->p_pixels,
-                    p_src->i_pitch * i_height );
+        pf_copy_pixels( p_dst->p_pixels, p_src->p_pixels,
+                        p_src->i_pitch * i_height );
     }
     else
     {
@@ -357,7 +489,7 @@ void plane_CopyPixels( plane_t *p_dst, const plane_t *p_src )
 
         for( int i_line = i_height; i_line--; )
         {
-            memcpy( p_out, p_in, i_width );
+            pf_copy_pixels( p_out, p_in, i_width );
             p_in += p_src->i_pitch;
             p_out += p_dst->i_pitch;
         }
@@ -427,12 +559,12 @@ picture_t *picture_Clone(picture_t *picture)
 /*****************************************************************************
  *
  *****************************************************************************/
-int picture_Export( vlc_object_t *p_obj,
-                    block_t **pp_image,
-                    video_format_t *p_fmt,
-                    picture_t *p_picture,
-                    vlc_fourcc_t i_format,
-                    int i_override_width, int i_override_height )
+static void picture_ExportFormats( const picture_t *p_picture,
+                                   vlc_fourcc_t i_format,
+                                   int i_override_width,
+                                   int i_override_height,
+                                   video_format_t *p_fmt_in,
+                                   video_format_t *p_fmt_out )
 {
     /* */
     video_format_t fmt_in = p_picture->format;
@@ -490,6 +622,22 @@ int picture_Export( vlc_object_t *p_obj,
                          * fmt_in.i_sar_num / fmt_in.i_height / fmt_in.i_sar_den;
     }
 
+    *p_fmt_in = fmt_in;
+    *p_fmt_out = fmt_out;
+}
+
+int picture_Export( vlc_object_t *p_obj,
+                    block_t **pp_image,
+                    video_format_t *p_fmt,
+                    picture_t *p_picture,
+                    vlc_fourcc_t i_format,
+                    int i_override_width, int i_override_height )
+{
+    video_format_t fmt_in, fmt_out;
+    picture_ExportFormats( p_picture, i_format,
+                           i_override_width, i_override_height,
+                           &fmt_in, &fmt_out );
+
     image_handler_t *p_image = image_HandlerCreate( p_obj );
     if( !p_image )
         return VLC_ENOMEM;
@@ -510,3 +658,52 @@ int picture_Export( vlc_object_t *p_obj,
 
     return VLC_SUCCESS;
 }
+
+unsigned picture_ExportBatch( vlc_object_t *p_obj,
+                              block_t **pp_images,
+                              video_format_t *p_fmt,
+                              picture_t *const *pp_pictures,
+                              unsigned i_count,
+                              vlc_fourcc_t i_format,
+                              int i_override_width, int i_override_height )
+{
+    unsigned i_exported = 0;
+
+    for( unsigned i = 0; i < i_count; i++ )
+        pp_images[i] = NULL;
+
+    /* The image handler keeps its encoder and conversion filter chain as
+     * long as successive pictures share the same formats, so exporting a
+     * batch through one handler skips the per-picture module (re)probing
+     * that dominates picture_Export(). For hardware pictures, the chain
+     * includes the hardware-to-memory readback converter. */
+    image_handler_t *p_image = image_HandlerCreate( p_obj );
+    if( !p_image )
+        return 0;
+
+    for( unsigned i = 0; i < i_count; i++ )
+    {
+        picture_t *p_picture = pp_pictures[i];
+        video_format_t fmt_in, fmt_out;
+        picture_ExportFormats( p_picture, i_format,
+                               i_override_width, i_override_height,
+                               &fmt_in, &fmt_out );
+
+        block_t *p_block = image_Write( p_image, p_picture,
+                                        &fmt_in, &fmt_out );
+        if( !p_block )
+            continue;
+
+        p_block->i_pts =
+        p_block->i_dts = p_picture->date;
+
+        if( p_fmt && i_exported == 0 )
+            *p_fmt = fmt_out;
+        pp_images[i] = p_block;
+        i_exported++;
+    }
+
+    image_HandlerDelete( p_image );
+
+    return i_exported;
+}
@@ -31,4 +31,7 @@ typedef struct
         void (*destroy)(picture_t *);
         void *opaque;
     } gc;
+    /* Size of the plane buffer owned by the picture, zero if the buffer
+     * belongs to the caller (picture_NewFromResource()) */
+    size_t alloc_bytes;
 } picture_priv_t;
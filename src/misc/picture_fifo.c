@@ -30,6 +30,7 @@
 # include "config.h"
 #endif
 #include <assert.h>
+#include <stdatomic.h>
 
 #include <vlc_common.h>
 #include <vlc_picture_fifo.h>
@@ -37,24 +38,35 @@
 /*****************************************************************************
  *
  *****************************************************************************/
+
+/* Must be a power of two, and larger than any picture pool feeding a fifo:
+ * every queued picture is owned by a bounded pool, so the ring can only fill
+ * up if a pool outgrows it. */
+#define PICTURE_FIFO_SIZE 256
+
 struct picture_fifo_t {
-    vlc_mutex_t lock;
+    /* Single-producer/single-consumer ring. The producer owns writes to
+     * end and the slots it publishes with it, the consumer owns begin. */
+    atomic_uint begin;
+    atomic_uint end;
+    picture_t   *ring[PICTURE_FIFO_SIZE];
+
+    /* Consumer-private chain of pictures kept back by a date-filtered
+     * flush; served before the ring so ordering is preserved. The counter
+     * is only there for picture_fifo_IsEmpty() from other threads. */
     picture_t   *first;
     picture_t   **last_ptr;
+    atomic_uint kept;
 };
 
 static void PictureFifoReset(picture_fifo_t *fifo)
 {
     fifo->first    = NULL;
     fifo->last_ptr = &fifo->first;
+    atomic_store_explicit(&fifo->kept, 0, memory_order_relaxed);
 }
-static void PictureFifoPush(picture_fifo_t *fifo, picture_t *picture)
-{
-    assert(!picture->p_next);
-    *fifo->last_ptr = picture;
-    fifo->last_ptr  = &picture->p_next;
-}
-static picture_t *PictureFifoPop(picture_fifo_t *fifo)
+
+static picture_t *PictureFifoPopKept(picture_fifo_t *fifo)
 {
     picture_t *picture = fifo->first;
 
@@ -63,87 +75,125 @@ static picture_t *PictureFifoPop(picture_fifo_t *fifo)
         if (!fifo->first)
             fifo->last_ptr = &fifo->first;
         picture->p_next = NULL;
+        atomic_fetch_sub_explicit(&fifo->kept, 1, memory_order_relaxed);
     }
     return picture;
 }
 
+static picture_t *PictureFifoPopRing(picture_fifo_t *fifo)
+{
+    unsigned begin = atomic_load_explicit(&fifo->begin,
+                                          memory_order_relaxed);
+
+    if (begin == atomic_load_explicit(&fifo->end, memory_order_acquire))
+        return NULL;
+
+    picture_t *picture = fifo->ring[begin % PICTURE_FIFO_SIZE];
+    atomic_store_explicit(&fifo->begin, begin + 1, memory_order_release);
+    return picture;
+}
+
 picture_fifo_t *picture_fifo_New(void)
 {
     picture_fifo_t *fifo = malloc(sizeof(*fifo));
     if (!fifo)
         return NULL;
 
-    vlc_mutex_init(&fifo->lock);
+    atomic_init(&fifo->begin, 0);
+    atomic_init(&fifo->end, 0);
+    atomic_init(&fifo->kept, 0);
     PictureFifoReset(fifo);
     return fifo;
 }
 
 void picture_fifo_Push(picture_fifo_t *fifo, picture_t *picture)
 {
-    vlc_mutex_lock(&fifo->lock);
-    PictureFifoPush(fifo, picture);
-    vlc_mutex_unlock(&fifo->lock);
+    assert(!picture->p_next);
+
+    unsigned end = atomic_load_explicit(&fifo->end, memory_order_relaxed);
+
+    /* Only reachable if a picture pool outgrows the ring (see
+     * PICTURE_FIFO_SIZE); do not drop, wait for the consumer instead */
+    while (unlikely(end - atomic_load_explicit(&fifo->begin,
+                                               memory_order_acquire)
+                        >= PICTURE_FIFO_SIZE))
+        vlc_tick_sleep(VLC_TICK_FROM_MS(1));
+
+    fifo->ring[end % PICTURE_FIFO_SIZE] = picture;
+    atomic_store_explicit(&fifo->end, end + 1, memory_order_release);
 }
 picture_t *picture_fifo_Pop(picture_fifo_t *fifo)
 {
-    vlc_mutex_lock(&fifo->lock);
-    picture_t *picture = PictureFifoPop(fifo);
-    vlc_mutex_unlock(&fifo->lock);
+    picture_t *picture = PictureFifoPopKept(fifo);
 
+    if (!picture)
+        picture = PictureFifoPopRing(fifo);
     return picture;
 }
 picture_t *picture_fifo_Peek(picture_fifo_t *fifo)
 {
-    vlc_mutex_lock(&fifo->lock);
     picture_t *picture = fifo->first;
+
+    if (!picture) {
+        unsigned begin = atomic_load_explicit(&fifo->begin,
+                                              memory_order_relaxed);
+
+        if (begin != atomic_load_explicit(&fifo->end, memory_order_acquire))
+            picture = fifo->ring[begin % PICTURE_FIFO_SIZE];
+    }
     if (picture)
         picture_Hold(picture);
-    vlc_mutex_unlock(&fifo->lock);
-
     return picture;
 }
+bool picture_fifo_IsEmpty(picture_fifo_t *fifo)
+{
+    if (atomic_load_explicit(&fifo->kept, memory_order_relaxed) > 0)
+        return false;
+    return atomic_load_explicit(&fifo->begin, memory_order_relaxed) ==
+           atomic_load_explicit(&fifo->end, memory_order_acquire);
+}
 void picture_fifo_Flush(picture_fifo_t *fifo, vlc_tick_t date, bool flush_before)
 {
     picture_t *picture;
+    picture_t *kept_first = NULL;
+    picture_t **kept_last = &kept_first;
+    unsigned kept = 0;
 
-    vlc_mutex_lock(&fifo->lock);
-
-    picture = fifo->first;
-    PictureFifoReset(fifo);
-
-    picture_fifo_t tmp;
-    PictureFifoReset(&tmp);
-
-    while (picture) {
-        picture_t *next = picture->p_next;
-
-        picture->p_next = NULL;
+    /* Drain everything queued so far, releasing the pictures matching the
+     * date filter and keeping back the others, in order */
+    while ((picture = picture_fifo_Pop(fifo)) != NULL) {
         if ((date == VLC_TICK_INVALID) ||
             ( flush_before && picture->date <= date) ||
-            (!flush_before && picture->date >= date))
-            PictureFifoPush(&tmp, picture);
-        else
-            PictureFifoPush(fifo, picture);
-        picture = next;
+            (!flush_before && picture->date >= date)) {
+            picture_Release(picture);
+        } else {
+            *kept_last = picture;
+            kept_last = &picture->p_next;
+            kept++;
+        }
     }
-    vlc_mutex_unlock(&fifo->lock);
 
-    while ((picture = PictureFifoPop(&tmp)) != NULL)
-        picture_Release(picture);
+    fifo->first    = kept_first;
+    fifo->last_ptr = kept_last;
+    atomic_store_explicit(&fifo->kept, kept, memory_order_relaxed);
 }
 void picture_fifo_OffsetDate(picture_fifo_t *fifo, vlc_tick_t delta)
 {
-    vlc_mutex_lock(&fifo->lock);
-    for (picture_t *picture = fifo->first; picture != NULL;) {
+    for (picture_t *picture = fifo->first; picture != NULL;
+         picture = picture->p_next)
         picture->date += delta;
-        picture = picture->p_next;
-    }
-    vlc_mutex_unlock(&fifo->lock);
+
+    /* Pictures published in the ring are owned by the fifo: the producer
+     * does not touch them anymore, so the consumer may edit their date */
+    unsigned begin = atomic_load_explicit(&fifo->begin,
+                                          memory_order_relaxed);
+    unsigned end = atomic_load_explicit(&fifo->end, memory_order_acquire);
+
+    for (; begin != end; begin++)
+        fifo->ring[begin % PICTURE_FIFO_SIZE]->date += delta;
 }
 void picture_fifo_Delete(picture_fifo_t *fifo)
 {
     picture_fifo_Flush(fifo, VLC_TICK_INVALID, true);
-    vlc_mutex_destroy(&fifo->lock);
     free(fifo);
 }
-
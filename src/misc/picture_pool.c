@@ -45,9 +45,12 @@ struct picture_pool_t {
     vlc_cond_t  wait;
 
     bool               canceled;
+    bool               growable;
+    video_format_t     format; /**< Format of on-demand pictures (growable) */
     unsigned long long available;
     atomic_ushort      refs;
     unsigned short     picture_count;
+    unsigned short     max_count;
     picture_t  *picture[];
 };
 
@@ -57,6 +60,8 @@ static void picture_pool_Destroy(picture_pool_t *pool)
         return;
 
     atomic_thread_fence(memory_order_acquire);
+    if (pool->growable)
+        video_format_Clean(&pool->format);
     vlc_cond_destroy(&pool->wait);
     vlc_mutex_destroy(&pool->lock);
     aligned_free(pool);
@@ -116,13 +121,15 @@ static picture_t *picture_pool_ClonePicture(picture_pool_t *pool,
     return clone;
 }
 
-picture_pool_t *picture_pool_NewExtended(const picture_pool_configuration_t *cfg)
+static picture_pool_t *picture_pool_Alloc(const picture_pool_configuration_t *cfg,
+                                          unsigned max_count)
 {
-    if (unlikely(cfg->picture_count > POOL_MAX))
+    assert(cfg->picture_count <= max_count);
+    if (unlikely(max_count > POOL_MAX))
         return NULL;
 
     picture_pool_t *pool;
-    size_t size = sizeof (*pool) + cfg->picture_count * sizeof (picture_t *);
+    size_t size = sizeof (*pool) + max_count * sizeof (picture_t *);
 
     size += (-size) & (POOL_MAX - 1);
     pool = aligned_alloc(POOL_MAX, size);
@@ -139,12 +146,19 @@ picture_pool_t *picture_pool_NewExtended(const picture_pool_configuration_t *cfg
         pool->available = (1ULL << cfg->picture_count) - 1;
     atomic_init(&pool->refs,  1);
     pool->picture_count = cfg->picture_count;
+    pool->max_count = max_count;
     memcpy(pool->picture, cfg->picture,
            cfg->picture_count * sizeof (picture_t *));
     pool->canceled = false;
+    pool->growable = false;
     return pool;
 }
 
+picture_pool_t *picture_pool_NewExtended(const picture_pool_configuration_t *cfg)
+{
+    return picture_pool_Alloc(cfg, cfg->picture_count);
+}
+
 picture_pool_t *picture_pool_New(unsigned count, picture_t *const *tab)
 {
     picture_pool_configuration_t cfg = {
@@ -167,10 +181,27 @@ picture_pool_t *picture_pool_NewFromFormat(const video_format_t *fmt,
             goto error;
     }
 
-    picture_pool_t *pool = picture_pool_New(count, picture);
+    picture_pool_configuration_t cfg = {
+        .picture_count = count,
+        .picture = picture,
+    };
+
+    /* Leave headroom so that the pool can grow on demand when the decoder
+     * and the display fight over pictures, instead of stalling the decoder
+     * in picture_pool_Wait(). Extra pictures are allocated lazily by (and
+     * thus local to) the starved thread. */
+    unsigned max_count = count * 2;
+    if (max_count > POOL_MAX)
+        max_count = POOL_MAX;
+
+    picture_pool_t *pool = picture_pool_Alloc(&cfg, max_count);
     if (!pool)
         goto error;
 
+    if (max_count > count) {
+        video_format_Copy(&pool->format, fmt);
+        pool->growable = true;
+    }
     return pool;
 
 error:
@@ -202,6 +233,31 @@ error:
     return NULL;
 }
 
+/**
+ * Appends one lazily-allocated picture to a growable pool.
+ *
+ * The new slot is not marked available: it belongs to the caller.
+ * The pool must be locked.
+ *
+ * @return the new slot index, or -1 if the pool cannot grow.
+ */
+static int picture_pool_Grow(picture_pool_t *pool)
+{
+    if (!pool->growable || pool->picture_count >= pool->max_count)
+        return -1;
+
+    /* Allocated by the starved thread, so that (with first-touch policies)
+     * the plane memory ends up on that thread's NUMA node. */
+    picture_t *picture = picture_NewFromFormat(&pool->format);
+    if (unlikely(picture == NULL))
+        return -1;
+
+    int i = pool->picture_count;
+    pool->picture[i] = picture;
+    pool->picture_count++;
+    return i;
+}
+
 picture_t *picture_pool_Get(picture_pool_t *pool)
 {
     unsigned long long available;
@@ -237,6 +293,33 @@ picture_t *picture_pool_Get(picture_pool_t *pool)
         return clone;
     }
 
+    if (!pool->canceled)
+    {
+        int i = picture_pool_Grow(pool);
+        if (i >= 0)
+        {
+            vlc_mutex_unlock(&pool->lock);
+
+            picture_t *picture = pool->picture[i];
+
+            if (pool->pic_lock != NULL
+             && pool->pic_lock(picture) != VLC_SUCCESS) {
+                vlc_mutex_lock(&pool->lock);
+                pool->available |= 1ULL << i;
+                vlc_mutex_unlock(&pool->lock);
+                return NULL;
+            }
+
+            picture_t *clone = picture_pool_ClonePicture(pool, i);
+            if (clone != NULL) {
+                assert(clone->p_next == NULL);
+                atomic_fetch_add_explicit(&pool->refs, 1,
+                                          memory_order_relaxed);
+            }
+            return clone;
+        }
+    }
+
     vlc_mutex_unlock(&pool->lock);
     return NULL;
 }
@@ -253,6 +336,13 @@ picture_t *picture_pool_Wait(picture_pool_t *pool)
             vlc_mutex_unlock(&pool->lock);
             return NULL;
         }
+
+        int n = picture_pool_Grow(pool);
+        if (n >= 0)
+        {   /* Publish the new slot and claim it below. */
+            pool->available |= 1ULL << n;
+            break;
+        }
         vlc_cond_wait(&pool->wait, &pool->lock);
     }
 
@@ -303,6 +393,24 @@ bool picture_pool_OwnsPic(picture_pool_t *pool, picture_t *pic)
     return pool == picpool;
 }
 
+bool picture_pool_IsAligned(const picture_pool_t *pool, unsigned align)
+{
+    assert((align & (align - 1)) == 0);
+
+    for (unsigned i = 0; i < pool->picture_count; i++) {
+        const picture_t *picture = pool->picture[i];
+
+        for (int j = 0; j < picture->i_planes; j++) {
+            const plane_t *p = &picture->p[j];
+
+            if (((uintptr_t)p->p_pixels | (uintptr_t)p->i_pitch)
+                    & (align - 1))
+                return false;
+        }
+    }
+    return true;
+}
+
 unsigned picture_pool_GetSize(const picture_pool_t *pool)
 {
     return pool->picture_count;
@@ -311,8 +419,8 @@ unsigned picture_pool_GetSize(const picture_pool_t *pool)
 void picture_pool_Enum(picture_pool_t *pool, void (*cb)(void *, picture_t *),
                        void *opaque)
 {
-    /* NOTE: So far, the pictures table cannot change after the pool is created
-     * so there is no need to lock the pool mutex here. */
+    /* NOTE: The pictures table can only be appended to (growable pools), so
+     * enumerating the pictures present at call time needs no pool lock. */
     for (unsigned i = 0; i < pool->picture_count; i++)
         cb(opaque, pool->picture[i]);
 }
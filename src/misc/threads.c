@@ -24,9 +24,19 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <vlc_common.h>
 
+/* This file implements (among others) the profiled lock variants: all its
+ * own waiting must use the plain primitives. */
+#undef vlc_mutex_lock
+#undef vlc_mutex_unlock
+#undef vlc_cond_wait
+
 /*** Global locks ***/
 
 void vlc_global_mutex (unsigned n, bool acquire)
@@ -349,3 +359,279 @@ void vlc_sem_wait (vlc_sem_t *sem)
     vlc_mutex_unlock (&sem->lock);
 }
 #endif /* LIBVLC_NEED_SEMAPHORE */
+
+/*** Lock contention profiling ***/
+/* The hooks below are always compiled so that the exported symbols exist
+ * regardless of the build configuration; without ENABLE_LOCK_PROFILING the
+ * vlc_threads.h macros never redirect any call site to them. Samples are
+ * recorded in a per-thread call site table without any synchronisation, and
+ * merged into a global table when each thread terminates. */
+
+#define LOCK_PROFILE_SITES 509 /* prime, open addressing */
+#define LOCK_PROFILE_DEPTH 16  /* locks held simultaneously by one thread */
+
+struct lock_profile_site
+{
+    const char *file; /* NULL if the slot is free */
+    unsigned line;
+    uint64_t acquisitions;
+    uint64_t contentions;
+    vlc_tick_t wait_time;
+    vlc_tick_t hold_time;
+};
+
+struct lock_profile_held
+{
+    vlc_mutex_t *mutex;
+    struct lock_profile_site *site;
+    vlc_tick_t since;
+};
+
+struct lock_profile_thread
+{
+    struct lock_profile_site sites[LOCK_PROFILE_SITES];
+    struct lock_profile_held held[LOCK_PROFILE_DEPTH];
+    unsigned depth;
+};
+
+static struct
+{
+    vlc_mutex_t lock;
+    bool initialized;
+    vlc_threadvar_t key;
+    struct lock_profile_site sites[LOCK_PROFILE_SITES];
+    uint64_t lost_sites;
+} lock_profile = { .lock = VLC_STATIC_MUTEX };
+
+static struct lock_profile_site *
+lock_profile_FindSite(struct lock_profile_site *table,
+                      const char *file, unsigned line)
+{
+    /* Call sites are static, so within one thread hashing the __FILE__
+     * string pointer is both sufficient and cheap. */
+    size_t slot = ((uintptr_t)file ^ (line * 2654435761u))
+                % LOCK_PROFILE_SITES;
+
+    for (size_t i = 0; i < LOCK_PROFILE_SITES; i++)
+    {
+        struct lock_profile_site *site = table
+            + ((slot + i) % LOCK_PROFILE_SITES);
+
+        if (site->file == NULL)
+        {
+            site->file = file;
+            site->line = line;
+            return site;
+        }
+        if (site->file == file && site->line == line)
+            return site;
+    }
+    return NULL; /* table full, sample dropped */
+}
+
+static struct lock_profile_site *
+lock_profile_MergeSite(const char *file, unsigned line)
+{
+    /* The same header line yields distinct string literals across
+     * translation units, so the global table must compare contents.
+     * This only runs at thread exit: a linear scan is fine. */
+    struct lock_profile_site *spare = NULL;
+
+    for (size_t i = 0; i < LOCK_PROFILE_SITES; i++)
+    {
+        struct lock_profile_site *site = &lock_profile.sites[i];
+
+        if (site->file == NULL)
+        {
+            if (spare == NULL)
+                spare = site;
+            continue;
+        }
+        if (site->line == line && !strcmp(site->file, file))
+            return site;
+    }
+    if (spare != NULL)
+    {
+        spare->file = file;
+        spare->line = line;
+    }
+    return spare;
+}
+
+static void lock_profile_MergeThread(void *data)
+{
+    struct lock_profile_thread *thread = data;
+
+    vlc_mutex_lock(&lock_profile.lock);
+    for (size_t i = 0; i < LOCK_PROFILE_SITES; i++)
+    {
+        const struct lock_profile_site *site = &thread->sites[i];
+        if (site->file == NULL)
+            continue;
+
+        struct lock_profile_site *total =
+            lock_profile_MergeSite(site->file, site->line);
+        if (unlikely(total == NULL))
+        {
+            lock_profile.lost_sites++;
+            continue;
+        }
+        total->acquisitions += site->acquisitions;
+        total->contentions += site->contentions;
+        total->wait_time += site->wait_time;
+        total->hold_time += site->hold_time;
+    }
+    vlc_mutex_unlock(&lock_profile.lock);
+
+    free(thread);
+}
+
+static struct lock_profile_thread *lock_profile_Get(void)
+{
+    if (unlikely(!lock_profile.initialized))
+    {
+        vlc_mutex_lock(&lock_profile.lock);
+        if (!lock_profile.initialized)
+        {
+            if (vlc_threadvar_create(&lock_profile.key,
+                                     lock_profile_MergeThread))
+            {
+                vlc_mutex_unlock(&lock_profile.lock);
+                return NULL;
+            }
+            lock_profile.initialized = true;
+        }
+        vlc_mutex_unlock(&lock_profile.lock);
+    }
+
+    struct lock_profile_thread *thread = vlc_threadvar_get(lock_profile.key);
+    if (unlikely(thread == NULL))
+    {
+        thread = calloc(1, sizeof (*thread));
+        if (unlikely(thread == NULL))
+            return NULL;
+        if (vlc_threadvar_set(lock_profile.key, thread))
+        {
+            free(thread);
+            return NULL;
+        }
+    }
+    return thread;
+}
+
+static void lock_profile_Push(struct lock_profile_thread *thread,
+                              vlc_mutex_t *mutex,
+                              struct lock_profile_site *site)
+{
+    if (unlikely(thread->depth >= LOCK_PROFILE_DEPTH))
+        return; /* too deep, hold time not attributed */
+
+    struct lock_profile_held *held = &thread->held[thread->depth++];
+    held->mutex = mutex;
+    held->site = site;
+    held->since = vlc_tick_now();
+}
+
+void vlc_mutex_lock_profiled(vlc_mutex_t *mutex, const char *file,
+                             unsigned line)
+{
+    struct lock_profile_thread *thread = lock_profile_Get();
+    if (unlikely(thread == NULL))
+    {
+        vlc_mutex_lock(mutex);
+        return;
+    }
+
+    struct lock_profile_site *site =
+        lock_profile_FindSite(thread->sites, file, line);
+
+    if (vlc_mutex_trylock(mutex) == 0)
+    {   /* Uncontended fast path: no clock query for the wait */
+        if (likely(site != NULL))
+            site->acquisitions++;
+    }
+    else
+    {
+        vlc_tick_t before = vlc_tick_now();
+        vlc_mutex_lock(mutex);
+        if (likely(site != NULL))
+        {
+            site->acquisitions++;
+            site->contentions++;
+            site->wait_time += vlc_tick_now() - before;
+        }
+    }
+    lock_profile_Push(thread, mutex, site);
+}
+
+void vlc_mutex_unlock_profiled(vlc_mutex_t *mutex)
+{
+    struct lock_profile_thread *thread = lock_profile_Get();
+    if (likely(thread != NULL))
+    {   /* Unlock order may differ from lock order: scan top-down */
+        for (unsigned i = thread->depth; i > 0; i--)
+        {
+            struct lock_profile_held *held = &thread->held[i - 1];
+            if (held->mutex != mutex)
+                continue;
+            if (held->site != NULL)
+                held->site->hold_time += vlc_tick_now() - held->since;
+            memmove(held, held + 1,
+                    (--thread->depth - (i - 1)) * sizeof (*held));
+            break;
+        }
+    }
+    vlc_mutex_unlock(mutex);
+}
+
+void vlc_cond_wait_profiled(vlc_cond_t *cond, vlc_mutex_t *mutex,
+                            const char *file, unsigned line)
+{
+    struct lock_profile_thread *thread = lock_profile_Get();
+    if (unlikely(thread == NULL))
+    {
+        vlc_cond_wait(cond, mutex);
+        return;
+    }
+
+    struct lock_profile_site *site =
+        lock_profile_FindSite(thread->sites, file, line);
+    vlc_tick_t before = vlc_tick_now();
+
+    vlc_cond_wait(cond, mutex);
+
+    if (likely(site != NULL))
+    {
+        site->acquisitions++;
+        site->contentions++;
+        site->wait_time += vlc_tick_now() - before;
+    }
+}
+
+void vlc_lock_profile_Dump(void)
+{
+    vlc_mutex_lock(&lock_profile.lock);
+    if (!lock_profile.initialized)
+    {
+        vlc_mutex_unlock(&lock_profile.lock);
+        return;
+    }
+
+    fprintf(stderr, "lock profile: %43s %12s %12s %12s %12s\n",
+            "call site", "acquired", "contended", "wait (us)", "hold (us)");
+    for (size_t i = 0; i < LOCK_PROFILE_SITES; i++)
+    {
+        const struct lock_profile_site *site = &lock_profile.sites[i];
+        if (site->file == NULL)
+            continue;
+
+        fprintf(stderr, "lock profile: %38s:%-4u %12"PRIu64" %12"PRIu64
+                " %12"PRId64" %12"PRId64"\n", site->file, site->line,
+                site->acquisitions, site->contentions,
+                site->wait_time, site->hold_time);
+    }
+    if (lock_profile.lost_sites > 0)
+        fprintf(stderr, "lock profile: %"PRIu64" call site(s) dropped "
+                "(table full)\n", lock_profile.lost_sites);
+    vlc_mutex_unlock(&lock_profile.lock);
+}
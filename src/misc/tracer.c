@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * tracer.c: tracing interface
+ * This library records fixed-size trace point events into per-thread
+ * buffers flushed in batches to a run-time selected sink.
+ *****************************************************************************
+ * Copyright (C) 2018 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_fs.h>
+#include <vlc_tracer.h>
+
+#include "../libvlc.h"
+
+/**
+ * One recorded trace point event.
+ */
+struct vlc_trace_entry
+{
+    vlc_tick_t ts;        /**< Event time (vlc_tick_now()) */
+    unsigned long thread; /**< Emitting thread identifier */
+    const char *subsystem; /**< Static subsystem name */
+    const char *key;      /**< Static event name */
+    int64_t value;        /**< Event payload */
+};
+
+/** Events buffered per thread before the sink lock is taken */
+#define TRACE_BATCH_SIZE 256
+/** Events retained by the in-memory ring sink */
+#define TRACE_RING_SIZE  4096
+
+struct vlc_trace_buffer
+{
+    size_t count;
+    struct vlc_trace_entry entries[TRACE_BATCH_SIZE];
+};
+
+/* Fast no-sink check, outside the lock */
+static atomic_bool trace_enabled = ATOMIC_VAR_INIT(false);
+
+static struct
+{
+    vlc_mutex_t lock;
+    unsigned refs; /**< Running libvlc instances */
+    FILE *stream; /**< File or descriptor sink, or NULL */
+    bool stream_owned; /**< Whether stream is closed on deinitialization */
+    struct vlc_trace_entry *ring; /**< In-memory ring sink, or NULL */
+    size_t ring_pos;
+    bool ring_full;
+    vlc_threadvar_t buffer_key; /**< Per-thread event buffer */
+    bool buffer_key_created;
+} trace = { .lock = VLC_STATIC_MUTEX };
+
+static void vlc_trace_Print(FILE *stream, const struct vlc_trace_entry *entry)
+{
+    fprintf(stream, "%"PRId64"\t%lx\t%s\t%s\t%"PRId64"\n", entry->ts,
+            entry->thread, entry->subsystem, entry->key, entry->value);
+}
+
+static void vlc_trace_FlushLocked(const struct vlc_trace_entry *entries,
+                                  size_t count)
+{
+    if (trace.stream != NULL)
+    {
+        for (size_t i = 0; i < count; i++)
+            vlc_trace_Print(trace.stream, entries + i);
+    }
+    else if (trace.ring != NULL)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            trace.ring[trace.ring_pos] = entries[i];
+            if (++trace.ring_pos == TRACE_RING_SIZE)
+            {
+                trace.ring_pos = 0;
+                trace.ring_full = true;
+            }
+        }
+    }
+    /* Else the sinks are gone already: the events are dropped. */
+}
+
+static void vlc_trace_Flush(struct vlc_trace_buffer *buffer)
+{
+    vlc_mutex_lock(&trace.lock);
+    vlc_trace_FlushLocked(buffer->entries, buffer->count);
+    vlc_mutex_unlock(&trace.lock);
+    buffer->count = 0;
+}
+
+static void vlc_trace_ThreadExit(void *data)
+{
+    struct vlc_trace_buffer *buffer = data;
+
+    vlc_trace_Flush(buffer);
+    free(buffer);
+}
+
+void vlc_tracer_Trace(const char *subsystem, const char *key, int64_t value)
+{
+    if (!atomic_load_explicit(&trace_enabled, memory_order_acquire))
+        return;
+
+    struct vlc_trace_buffer *buffer = vlc_threadvar_get(trace.buffer_key);
+    if (unlikely(buffer == NULL))
+    {
+        buffer = malloc(sizeof (*buffer));
+        if (unlikely(buffer == NULL))
+            return; /* the event is lost */
+
+        buffer->count = 0;
+        if (unlikely(vlc_threadvar_set(trace.buffer_key, buffer) != 0))
+        {
+            free(buffer);
+            return;
+        }
+    }
+
+    struct vlc_trace_entry *entry = buffer->entries + buffer->count;
+    entry->ts = vlc_tick_now();
+    entry->thread = vlc_thread_id();
+    entry->subsystem = subsystem;
+    entry->key = key;
+    entry->value = value;
+
+    if (++buffer->count == TRACE_BATCH_SIZE)
+        vlc_trace_Flush(buffer);
+}
+
+static void vlc_trace_OpenSink(const char *conf)
+{
+    if (!strcmp(conf, "-"))
+        trace.stream = stderr;
+    else if (!strncmp(conf, "fd://", 5))
+    {
+        int fd = vlc_dup(atoi(conf + 5));
+        if (fd != -1)
+        {
+            trace.stream = fdopen(fd, "w");
+            if (trace.stream != NULL)
+                trace.stream_owned = true;
+            else
+                vlc_close(fd);
+        }
+    }
+    else if (!strcmp(conf, "ring"))
+        trace.ring = calloc(TRACE_RING_SIZE, sizeof (trace.ring[0]));
+    else
+    {
+        trace.stream = vlc_fopen(conf, "a");
+        trace.stream_owned = trace.stream != NULL;
+    }
+}
+
+static void vlc_trace_CloseSinksLocked(void)
+{
+    if (trace.ring != NULL)
+    {
+        /* Dump the retained events, oldest first */
+        size_t start = trace.ring_full ? trace.ring_pos : 0;
+        size_t count = trace.ring_full ? TRACE_RING_SIZE : trace.ring_pos;
+
+        for (size_t i = 0; i < count; i++)
+            vlc_trace_Print(stderr,
+                            trace.ring + ((start + i) % TRACE_RING_SIZE));
+        free(trace.ring);
+        trace.ring = NULL;
+        trace.ring_pos = 0;
+        trace.ring_full = false;
+    }
+
+    if (trace.stream != NULL)
+    {
+        if (trace.stream_owned)
+            fclose(trace.stream);
+        else
+            fflush(trace.stream);
+        trace.stream = NULL;
+        trace.stream_owned = false;
+    }
+}
+
+/**
+ * Initializes the tracing subsystem (once per libvlc instance).
+ *
+ * The sink is picked from the VLC_TRACE environment variable when the
+ * first instance comes up; without it, trace points stay disabled and
+ * cost a single atomic load each.
+ */
+void vlc_tracer_Init(void)
+{
+    vlc_mutex_lock(&trace.lock);
+    if (trace.refs++ == 0)
+    {
+        const char *conf = getenv("VLC_TRACE");
+
+        if (conf != NULL && *conf != '\0')
+        {
+            vlc_trace_OpenSink(conf);
+
+            /* The buffer key is created once and never deleted, as buffers
+             * of detached threads outlive the last libvlc instance. */
+            if ((trace.stream != NULL || trace.ring != NULL)
+             && !trace.buffer_key_created)
+                trace.buffer_key_created =
+                    vlc_threadvar_create(&trace.buffer_key,
+                                         vlc_trace_ThreadExit) == 0;
+
+            if (trace.buffer_key_created)
+                atomic_store_explicit(&trace_enabled, true,
+                                      memory_order_release);
+            else
+                vlc_trace_CloseSinksLocked();
+        }
+    }
+    vlc_mutex_unlock(&trace.lock);
+}
+
+/**
+ * Deinitializes the tracing subsystem.
+ *
+ * When the last libvlc instance goes away, the calling thread buffer is
+ * flushed and the sink is closed. Events still buffered in other live
+ * threads are dropped; their buffers are freed when those threads exit.
+ */
+void vlc_tracer_Deinit(void)
+{
+    struct vlc_trace_buffer *buffer = NULL;
+
+    vlc_mutex_lock(&trace.lock);
+    if (--trace.refs == 0
+     && atomic_exchange_explicit(&trace_enabled, false,
+                                 memory_order_acq_rel))
+    {
+        buffer = vlc_threadvar_get(trace.buffer_key);
+        if (buffer != NULL)
+        {
+            vlc_trace_FlushLocked(buffer->entries, buffer->count);
+            vlc_threadvar_set(trace.buffer_key, NULL);
+        }
+        vlc_trace_CloseSinksLocked();
+    }
+    vlc_mutex_unlock(&trace.lock);
+
+    free(buffer);
+}
@@ -69,6 +69,8 @@ typedef struct variable_ops_t
 struct variable_t
 {
     char *       psz_name; /**< The variable unique name (must be first) */
+    uint32_t     i_name_hash; /**< Precomputed hash of psz_name
+                                   (must follow psz_name, see varcmp()) */
 
     /** The variable's exported value */
     vlc_value_t  val;
@@ -137,22 +139,48 @@ int_ops    = { CmpInt,     DupDummy,  FreeDummy,  },
 string_ops = { CmpString,  DupString, FreeString, },
 coords_ops = { NULL,       DupDummy,  FreeDummy,  };
 
+/**
+ * Hashes a variable name (32-bit FNV-1a).
+ *
+ * Ordering the variable tree by hash first replaces most full string
+ * comparisons on the lookup hot path with a single integer comparison;
+ * the name itself only breaks hash ties.
+ */
+static uint32_t VarHash( const char *psz_name )
+{
+    uint32_t hash = 2166136261u;
+
+    for( const unsigned char *p = (const unsigned char *)psz_name; *p; p++ )
+        hash = (hash ^ *p) * 16777619u;
+    return hash;
+}
+
+/** Lookup key: layout-compatible with the head of variable_t */
+typedef struct
+{
+    const char *psz_name;
+    uint32_t    i_name_hash;
+} variable_key_t;
+
 static int varcmp( const void *a, const void *b )
 {
     const variable_t *va = a, *vb = b;
 
     /* psz_name must be first */
     assert( va == (const void *)&va->psz_name );
+    if( va->i_name_hash != vb->i_name_hash )
+        return va->i_name_hash < vb->i_name_hash ? -1 : 1;
     return strcmp( va->psz_name, vb->psz_name );
 }
 
 static variable_t *Lookup( vlc_object_t *obj, const char *psz_name )
 {
     vlc_object_internals_t *priv = vlc_internals( obj );
+    const variable_key_t key = { psz_name, VarHash( psz_name ) };
     variable_t **pp_var;
 
     vlc_mutex_lock(&priv->var_lock);
-    pp_var = tfind( &psz_name, &priv->var_root, varcmp );
+    pp_var = tfind( &key, &priv->var_root, varcmp );
     return (pp_var != NULL) ? *pp_var : NULL;
 }
 
@@ -296,6 +324,7 @@ int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
         return VLC_ENOMEM;
 
     p_var->psz_name = strdup( psz_name );
+    p_var->i_name_hash = VarHash( psz_name );
     p_var->psz_text = NULL;
 
     p_var->i_type = i_type & ~VLC_VAR_DOINHERIT;
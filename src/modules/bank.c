@@ -249,6 +249,17 @@ typedef enum
     CACHE_WRITE_FILE = 0x4,
 } cache_mode_t;
 
+/* Candidate plug-in file found while scanning. The expensive part of the
+ * scan - loading the shared object and running its description callback -
+ * is deferred so that it can be fanned out over several threads. */
+typedef struct vlc_plugin_probe
+{
+    char *abspath;
+    char *relpath;
+    struct stat st;
+    vlc_plugin_t *plugin;
+} vlc_plugin_probe_t;
+
 typedef struct module_bank
 {
     vlc_object_t *obj;
@@ -258,10 +269,18 @@ typedef struct module_bank
     size_t        size;
     vlc_plugin_t **plugins;
     vlc_plugin_t *cache;
+
+    vlc_mutex_t        probes_lock;
+    size_t             probes_count;
+    size_t             probes_next;
+    vlc_plugin_probe_t *probes;
 } module_bank_t;
 
 /**
  * Scans a plug-in from a file.
+ *
+ * If the plug-in is not in the cache, probing it is merely queued here;
+ * the bank is updated later by AllocatePluginProbes().
  */
 static int AllocatePluginFile (module_bank_t *bank, const char *abspath,
                                const char *relpath, const struct stat *st)
@@ -284,33 +303,115 @@ static int AllocatePluginFile (module_bank_t *bank, const char *abspath,
         }
     }
 
-    if (plugin == NULL)
+    bank->probes = xrealloc(bank->probes,
+                            (bank->probes_count + 1) * sizeof (*bank->probes));
+
+    vlc_plugin_probe_t *probe = bank->probes + bank->probes_count;
+
+    probe->abspath = (plugin == NULL) ? xstrdup(abspath) : NULL;
+    probe->relpath = xstrdup(relpath);
+    probe->st = *st;
+    probe->plugin = plugin;
+    bank->probes_count++;
+    return 0;
+}
+
+/**
+ * Probes queued plug-in candidates (worker thread).
+ *
+ * Only the job dispatch is synchronized: each candidate is probed by
+ * exactly one thread, and module_InitDynamic() only deals with the
+ * plug-in being loaded. The bank itself is not touched from here.
+ */
+static void *AllocatePluginProbeThread(void *data)
+{
+    module_bank_t *bank = data;
+
+    for (;;)
     {
-        plugin = module_InitDynamic(bank->obj, abspath, true);
+        vlc_mutex_lock(&bank->probes_lock);
+        if (bank->probes_next >= bank->probes_count)
+        {
+            vlc_mutex_unlock(&bank->probes_lock);
+            break;
+        }
+        vlc_plugin_probe_t *probe = bank->probes + bank->probes_next;
+        bank->probes_next++;
+        vlc_mutex_unlock(&bank->probes_lock);
 
+        if (probe->plugin != NULL)
+            continue; /* fresh cache hit, nothing to load */
+
+        vlc_plugin_t *plugin = module_InitDynamic(bank->obj, probe->abspath,
+                                                  true);
         if (plugin != NULL)
         {
-            plugin->path = xstrdup(relpath);
-            plugin->mtime = st->st_mtime;
-            plugin->size = st->st_size;
+            plugin->path = xstrdup(probe->relpath);
+            plugin->mtime = probe->st.st_mtime;
+            plugin->size = probe->st.st_size;
         }
+        probe->plugin = plugin;
     }
+    return NULL;
+}
 
-    if (plugin == NULL)
-        return -1;
+/**
+ * Probes all queued plug-in candidates and stores them in the bank.
+ *
+ * Loading and describing the shared objects dominates a cold scan, and is
+ * independent from one plug-in to the next, so it is spread over a small
+ * pool of threads. Insertion into the bank stays on the calling thread so
+ * that the plug-in list and the saved cache keep a deterministic order.
+ */
+static void AllocatePluginProbes(module_bank_t *bank)
+{
+    vlc_thread_t workers[4];
+    size_t n = 0;
+
+    if (bank->probes_count > 1)
+    {
+        size_t max = vlc_GetCPUCount();
+        if (max > sizeof (workers) / sizeof (workers[0]))
+            max = sizeof (workers) / sizeof (workers[0]);
+
+        for (n = 0; (n + 1) < max; n++)
+            if (vlc_clone(workers + n, AllocatePluginProbeThread, bank,
+                          VLC_THREAD_PRIORITY_LOW))
+                break;
+    }
+
+    /* The scanning thread doubles as the last worker. */
+    AllocatePluginProbeThread(bank);
 
-    vlc_plugin_store(plugin);
+    while (n > 0)
+        vlc_join(workers[--n], NULL);
 
-    if (bank->mode & CACHE_WRITE_FILE) /* Add entry to to-be-saved cache */
+    for (size_t i = 0; i < bank->probes_count; i++)
     {
-        bank->plugins = xrealloc(bank->plugins,
-                                 (bank->size + 1) * sizeof (vlc_plugin_t *));
-        bank->plugins[bank->size] = plugin;
-        bank->size++;
+        vlc_plugin_probe_t *probe = bank->probes + i;
+        vlc_plugin_t *plugin = probe->plugin;
+
+        if (plugin != NULL)
+        {
+            vlc_plugin_store(plugin);
+
+            if (bank->mode & CACHE_WRITE_FILE) /* Add to to-be-saved cache */
+            {
+                bank->plugins = xrealloc(bank->plugins,
+                                    (bank->size + 1) * sizeof (vlc_plugin_t *));
+                bank->plugins[bank->size] = plugin;
+                bank->size++;
+            }
+        }
+        /* TODO: deal with errors */
+
+        free(probe->abspath);
+        free(probe->relpath);
     }
 
-    /* TODO: deal with errors */
-    return  0;
+    free(bank->probes);
+    bank->probes = NULL;
+    bank->probes_count = bank->probes_next = 0;
 }
 
 /**
@@ -404,6 +505,8 @@ static void AllocatePluginPath(vlc_object_t *obj, const char *path,
         .mode = mode,
     };
 
+    vlc_mutex_init(&bank.probes_lock);
+
     if (mode & CACHE_READ_FILE)
         bank.cache = vlc_cache_load(obj, path, &modules.caches);
     else
@@ -417,6 +520,8 @@ static void AllocatePluginPath(vlc_object_t *obj, const char *path,
         AllocatePluginDir(&bank, 5, path, NULL);
     }
 
+    AllocatePluginProbes(&bank);
+
     /* Deal with unmatched cache entries from cache file */
     while (bank.cache != NULL)
     {
@@ -432,6 +537,7 @@ static void AllocatePluginPath(vlc_object_t *obj, const char *path,
     if (mode & CACHE_WRITE_FILE)
         CacheSave(obj, path, bank.plugins, bank.size);
 
+    vlc_mutex_destroy(&bank.probes_lock);
     free(bank.plugins);
 }
 
@@ -625,6 +731,7 @@ void module_EndBank (bool b_plugins)
     assert (modules.usage > 0);
     if (--modules.usage == 0)
     {
+        vlc_modcache_flush ();
         config_UnsortConfig ();
         libs = vlc_plugins;
         caches = modules.caches;
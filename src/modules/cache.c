@@ -57,13 +57,37 @@
 #ifdef HAVE_DYNAMIC_PLUGINS
 /* Sub-version number
  * (only used to avoid breakage in dev version when cache structure changes) */
-#define CACHE_SUBVERSION_NUM 35
+#define CACHE_SUBVERSION_NUM 36
 
 /* Cache filename */
 #define CACHE_NAME "plugins.dat"
 /* Magic for the cache filename */
 #define CACHE_STRING "cache "PACKAGE_NAME" "PACKAGE_VERSION
 
+/* The cache file is memory-mapped on load: strings and integer tables are
+ * referenced in place, not copied. The remaining fixed-width fields of each
+ * module and configuration item are grouped into the aligned records below,
+ * so that the loader reads them straight from the mapping in one go instead
+ * of parsing them one small field at a time. */
+typedef struct
+{
+    int32_t  score;
+    uint32_t shortcuts;
+} vlc_cache_module_record_t;
+
+#define CACHE_CONFIG_INTERNAL   0x1
+#define CACHE_CONFIG_UNSAVEABLE 0x2
+#define CACHE_CONFIG_SAFE       0x4
+#define CACHE_CONFIG_REMOVED    0x8
+
+typedef struct
+{
+    int32_t  type;
+    uint16_t list_count;
+    int8_t   short_name;
+    uint8_t  flags;
+} vlc_cache_config_record_t;
+
 
 static int vlc_cache_load_immediate(void *out, block_t *in, size_t size)
 {
@@ -181,24 +205,30 @@ static int vlc_cache_load_align(size_t align, block_t *file)
 
 static int vlc_cache_load_config(module_config_t *cfg, block_t *file)
 {
-    LOAD_IMMEDIATE (cfg->i_type);
-    LOAD_IMMEDIATE (cfg->i_short);
-    LOAD_FLAG (cfg->b_internal);
-    LOAD_FLAG (cfg->b_unsaveable);
-    LOAD_FLAG (cfg->b_safe);
-    LOAD_FLAG (cfg->b_removed);
+    const vlc_cache_config_record_t *rec;
+
+    LOAD_ALIGNOF (*rec);
+    LOAD_ARRAY (rec, 1);
+    cfg->i_type = rec->type;
+    cfg->i_short = rec->short_name;
+    cfg->b_internal = (rec->flags & CACHE_CONFIG_INTERNAL) != 0;
+    cfg->b_unsaveable = (rec->flags & CACHE_CONFIG_UNSAVEABLE) != 0;
+    cfg->b_safe = (rec->flags & CACHE_CONFIG_SAFE) != 0;
+    cfg->b_removed = (rec->flags & CACHE_CONFIG_REMOVED) != 0;
+    cfg->list_count = rec->list_count;
     LOAD_STRING (cfg->psz_type);
     LOAD_STRING (cfg->psz_name);
     LOAD_STRING (cfg->psz_text);
     LOAD_STRING (cfg->psz_longtext);
-    LOAD_IMMEDIATE (cfg->list_count);
 
     if (IsConfigStringType (cfg->i_type))
     {
         const char *psz;
         LOAD_STRING(psz);
         cfg->orig.psz = (char *)psz;
-        cfg->value.psz = (psz != NULL) ? strdup (cfg->orig.psz) : NULL;
+        /* The value aliases the mapped default until it is overridden
+         * (see config_ReleasePsz()). */
+        cfg->value.psz = (char *)psz;
 
         if (cfg->list_count)
             cfg->list.psz = xmalloc (cfg->list_count * sizeof (char *));
@@ -293,11 +323,17 @@ static int vlc_cache_load_module(vlc_plugin_t *plugin, block_t *file)
     if (unlikely(module == NULL))
         return -1;
 
+    const vlc_cache_module_record_t *rec;
+
+    LOAD_ALIGNOF(*rec);
+    LOAD_ARRAY(rec, 1);
+    module->i_score = rec->score;
+    module->i_shortcuts = rec->shortcuts;
+
     LOAD_STRING(module->psz_shortname);
     LOAD_STRING(module->psz_longname);
     LOAD_STRING(module->psz_help);
 
-    LOAD_IMMEDIATE(module->i_shortcuts);
     if (module->i_shortcuts > MODULE_SHORTCUT_MAX)
         goto error;
     else
@@ -311,7 +347,6 @@ static int vlc_cache_load_module(vlc_plugin_t *plugin, block_t *file)
     LOAD_STRING(module->activate_name);
     LOAD_STRING(module->deactivate_name);
     LOAD_STRING(module->psz_capability);
-    LOAD_IMMEDIATE(module->i_score);
     return 0;
 error:
     return -1;
@@ -513,17 +548,23 @@ static int CacheSaveAlign(FILE *file, size_t align)
 
 static int CacheSaveConfig (FILE *file, const module_config_t *cfg)
 {
-    SAVE_IMMEDIATE (cfg->i_type);
-    SAVE_IMMEDIATE (cfg->i_short);
-    SAVE_FLAG (cfg->b_internal);
-    SAVE_FLAG (cfg->b_unsaveable);
-    SAVE_FLAG (cfg->b_safe);
-    SAVE_FLAG (cfg->b_removed);
+    const vlc_cache_config_record_t rec =
+    {
+        .type = cfg->i_type,
+        .list_count = cfg->list_count,
+        .short_name = cfg->i_short,
+        .flags = (cfg->b_internal ? CACHE_CONFIG_INTERNAL : 0)
+               | (cfg->b_unsaveable ? CACHE_CONFIG_UNSAVEABLE : 0)
+               | (cfg->b_safe ? CACHE_CONFIG_SAFE : 0)
+               | (cfg->b_removed ? CACHE_CONFIG_REMOVED : 0),
+    };
+
+    SAVE_ALIGNOF (vlc_cache_config_record_t);
+    SAVE_IMMEDIATE (rec);
     SAVE_STRING (cfg->psz_type);
     SAVE_STRING (cfg->psz_name);
     SAVE_STRING (cfg->psz_text);
     SAVE_STRING (cfg->psz_longtext);
-    SAVE_IMMEDIATE (cfg->list_count);
 
     if (IsConfigStringType (cfg->i_type))
     {
@@ -575,10 +616,17 @@ error:
 
 static int CacheSaveModule(FILE *file, const module_t *module)
 {
+    const vlc_cache_module_record_t rec =
+    {
+        .score = module->i_score,
+        .shortcuts = module->i_shortcuts,
+    };
+
+    SAVE_ALIGNOF(vlc_cache_module_record_t);
+    SAVE_IMMEDIATE(rec);
     SAVE_STRING(module->psz_shortname);
     SAVE_STRING(module->psz_longname);
     SAVE_STRING(module->psz_help);
-    SAVE_IMMEDIATE(module->i_shortcuts);
 
     for (size_t j = 0; j < module->i_shortcuts; j++)
          SAVE_STRING(module->pp_shortcuts[j]);
@@ -586,7 +634,6 @@ static int CacheSaveModule(FILE *file, const module_t *module)
     SAVE_STRING(module->activate_name);
     SAVE_STRING(module->deactivate_name);
     SAVE_STRING(module->psz_capability);
-    SAVE_IMMEDIATE(module->i_score);
     return 0;
 error:
     return -1;
@@ -341,7 +341,9 @@ static int vlc_plugin_desc_cb(void *ctx, void *tgt, int propid, ...)
             if (IsConfigStringType (item->i_type))
             {
                 const char *value = va_arg (ap, const char *);
-                item->value.psz = value ? strdup (value) : NULL;
+                /* The value aliases the default until it is overridden
+                 * (see config_ReleasePsz()). */
+                item->value.psz = (char *)value;
                 item->orig.psz = (char *)value;
             }
             break;
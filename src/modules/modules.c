@@ -35,6 +35,9 @@
 # include <libintl.h>
 #endif
 #include <assert.h>
+#ifdef HAVE_SEARCH_H
+# include <search.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_modules.h>
@@ -175,6 +178,191 @@ static int module_load (vlc_object_t *obj, module_t *m,
     return ret;
 }
 
+/* The module bank is immutable between module_LoadPlugins() and the final
+ * module_EndBank(). The flattened probe order for a given (capability, name,
+ * strict) request is thus memoized, so that probing chains - e.g. stream
+ * filters re-probed on every open - stop re-matching shortcut names and
+ * re-copying the sorted candidate table each time. */
+typedef struct vlc_modcache
+{
+    char *capability;
+    char *name;
+    bool strict;
+
+    size_t modc;
+    module_t **modv;
+    bool *forcev; /**< obj.force value to probe the matching entry with */
+} vlc_modcache_t;
+
+static struct
+{
+    vlc_mutex_t lock;
+    void *tree;
+} modcache = { VLC_STATIC_MUTEX, NULL };
+
+static int vlc_modcache_cmp(const void *a, const void *b)
+{
+    const vlc_modcache_t *ca = a, *cb = b;
+    int d = strcmp(ca->capability, cb->capability);
+
+    if (d == 0)
+        d = strcmp(ca->name, cb->name);
+    if (d == 0)
+        d = (int)ca->strict - (int)cb->strict;
+    return d;
+}
+
+static void vlc_modcache_entry_free(void *data)
+{
+    vlc_modcache_t *entry = data;
+
+    free(entry->forcev);
+    free(entry->modv);
+    free(entry->name);
+    free(entry->capability);
+    free(entry);
+}
+
+/**
+ * Flushes the memoized candidate lists (bank about to be emptied).
+ */
+void vlc_modcache_flush(void)
+{
+    vlc_mutex_lock(&modcache.lock);
+    if (modcache.tree != NULL)
+    {
+        tdestroy(modcache.tree, vlc_modcache_entry_free);
+        modcache.tree = NULL;
+    }
+    vlc_mutex_unlock(&modcache.lock);
+}
+
+/**
+ * Computes the flattened probe order for a (capability, name, strict)
+ * request: modules matching each shortcut in turn, then - unless strict -
+ * the remaining modules by decreasing score.
+ */
+static vlc_modcache_t *vlc_modcache_build(const char *capability,
+                                          const char *name, bool strict)
+{
+    module_t **mods;
+    ssize_t total = module_list_cap(&mods, capability);
+    if (unlikely(total < 0))
+        return NULL;
+
+    vlc_modcache_t *entry = malloc(sizeof (*entry));
+    if (unlikely(entry == NULL))
+        goto error;
+
+    entry->capability = strdup(capability);
+    entry->name = strdup(name);
+    entry->strict = strict;
+    entry->modc = 0;
+    entry->modv = vlc_alloc(total ? total : 1, sizeof (*entry->modv));
+    entry->forcev = vlc_alloc(total ? total : 1, sizeof (*entry->forcev));
+    if (unlikely(entry->capability == NULL || entry->name == NULL
+              || entry->modv == NULL || entry->forcev == NULL))
+    {
+        vlc_modcache_entry_free(entry);
+        entry = NULL;
+        goto error;
+    }
+
+    bool none = false;
+
+    while (*name)
+    {
+        const char *shortcut = name;
+        size_t slen = strcspn (name, ",");
+
+        name += slen;
+        name += strspn (name, ",");
+
+        if (!strcasecmp ("none", shortcut))
+        {
+            none = true;
+            break;
+        }
+
+        bool force = strict && strcasecmp ("any", shortcut);
+        for (ssize_t i = 0; i < total; i++)
+        {
+            module_t *cand = mods[i];
+            if (cand == NULL)
+                continue; // module already matched a former shortcut
+            if (!module_match_name(cand, shortcut, slen))
+                continue;
+            mods[i] = NULL; // ...so that each module is probed once at most
+
+            entry->modv[entry->modc] = cand;
+            entry->forcev[entry->modc] = force;
+            entry->modc++;
+        }
+    }
+
+    /* None of the shortcuts matched, fall back to any module */
+    if (!strict && !none)
+        for (ssize_t i = 0; i < total; i++)
+        {
+            module_t *cand = mods[i];
+            if (cand == NULL || module_get_score (cand) <= 0)
+                continue;
+
+            entry->modv[entry->modc] = cand;
+            entry->forcev[entry->modc] = false;
+            entry->modc++;
+        }
+
+error:
+    module_list_free(mods);
+    return entry;
+}
+
+/**
+ * Gets (memoizing it on first use) the flattened probe order for a
+ * (capability, name, strict) request.
+ */
+static const vlc_modcache_t *vlc_modcache_get(const char *capability,
+                                              const char *name, bool strict)
+{
+    const vlc_modcache_t key =
+    {
+        .capability = (char *)capability,
+        .name = (char *)name,
+        .strict = strict,
+    };
+    vlc_modcache_t *entry = NULL;
+
+    vlc_mutex_lock(&modcache.lock);
+    vlc_modcache_t **pp = tfind(&key, &modcache.tree, vlc_modcache_cmp);
+    if (pp != NULL)
+        entry = *pp;
+    vlc_mutex_unlock(&modcache.lock);
+
+    if (entry != NULL)
+        return entry;
+
+    entry = vlc_modcache_build(capability, name, strict);
+    if (unlikely(entry == NULL))
+        return NULL;
+
+    vlc_mutex_lock(&modcache.lock);
+    pp = tsearch(entry, &modcache.tree, vlc_modcache_cmp);
+    if (unlikely(pp == NULL))
+    {
+        vlc_mutex_unlock(&modcache.lock);
+        vlc_modcache_entry_free(entry);
+        return NULL;
+    }
+    if (*pp != entry)
+    {   /* Another thread won the race to memoize this request */
+        vlc_modcache_entry_free(entry);
+        entry = *pp;
+    }
+    vlc_mutex_unlock(&modcache.lock);
+    return entry;
+}
+
 #undef vlc_module_load
 /**
  * Finds and instantiates the best module of a certain type.
@@ -204,14 +392,14 @@ module_t *vlc_module_load(vlc_object_t *obj, const char *capability,
         name = "any";
 
     /* Find matching modules */
-    module_t **mods;
-    ssize_t total = module_list_cap (&mods, capability);
+    const vlc_modcache_t *cache = vlc_modcache_get(capability, name, strict);
+    if (unlikely(cache == NULL))
+        return NULL;
 
-    msg_Dbg (obj, "looking for %s module matching \"%s\": %zd candidates",
-             capability, name, total);
-    if (total <= 0)
+    msg_Dbg (obj, "looking for %s module matching \"%s\": %zu candidates",
+             capability, name, cache->modc);
+    if (cache->modc == 0)
     {
-        module_list_free (mods);
         msg_Dbg (obj, "no %s modules", capability);
         return NULL;
     }
@@ -221,64 +409,25 @@ module_t *vlc_module_load(vlc_object_t *obj, const char *capability,
     va_list args;
 
     va_start(args, probe);
-    while (*name)
+    for (size_t i = 0; i < cache->modc; i++)
     {
-        const char *shortcut = name;
-        size_t slen = strcspn (name, ",");
+        module_t *cand = cache->modv[i];
 
-        name += slen;
-        name += strspn (name, ",");
+        obj->obj.force = cache->forcev[i];
 
-        if (!strcasecmp ("none", shortcut))
-            goto done;
-
-        obj->obj.force = strict && strcasecmp ("any", shortcut);
-        for (ssize_t i = 0; i < total; i++)
+        int ret = module_load (obj, cand, probe, args);
+        switch (ret)
         {
-            module_t *cand = mods[i];
-            if (cand == NULL)
-                continue; // module failed in previous iteration
-            if (!module_match_name(cand, shortcut, slen))
-                continue;
-            mods[i] = NULL; // only try each module once at most...
-
-            int ret = module_load (obj, cand, probe, args);
-            switch (ret)
-            {
-                case VLC_SUCCESS:
-                    module = cand;
-                    /* fall through */
-                case VLC_ETIMEOUT:
-                    goto done;
-            }
-        }
-    }
-
-    /* None of the shortcuts matched, fall back to any module */
-    if (!strict)
-    {
-        obj->obj.force = false;
-        for (ssize_t i = 0; i < total; i++)
-        {
-            module_t *cand = mods[i];
-            if (cand == NULL || module_get_score (cand) <= 0)
-                continue;
-
-            int ret = module_load (obj, cand, probe, args);
-            switch (ret)
-            {
-                case VLC_SUCCESS:
-                    module = cand;
-                    /* fall through */
-                case VLC_ETIMEOUT:
-                    goto done;
-            }
+            case VLC_SUCCESS:
+                module = cand;
+                /* fall through */
+            case VLC_ETIMEOUT:
+                goto done;
         }
     }
 done:
     va_end (args);
     obj->obj.force = b_force_backup;
-    module_list_free (mods);
 
     if (module != NULL)
     {
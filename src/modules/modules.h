@@ -114,6 +114,7 @@ void module_EndBank (bool);
 int module_Map(vlc_object_t *, vlc_plugin_t *);
 
 ssize_t module_list_cap (module_t ***, const char *);
+void vlc_modcache_flush (void);
 
 int vlc_bindtextdomain (const char *);
 
@@ -37,6 +37,8 @@
 #include <sys/types.h>
 #include <vlc_network.h>
 
+#include "libvlc.h"
+
 int vlc_getnameinfo( const struct sockaddr *sa, int salen,
                      char *host, int hostlen, int *portnum, int flags )
 {
@@ -130,3 +132,192 @@ int vlc_getaddrinfo_i11e(const char *node, unsigned port,
     return vlc_getaddrinfo(node, port, hints, res);
 }
 #endif
+
+/*** Resolver cache ***/
+
+/* getaddrinfo() does not expose the DNS time-to-live, so cached entries
+ * expire after a fixed delay instead. The delay is kept shorter than common
+ * CDN TTLs so failover is not unduly delayed. Opening many streams from the
+ * same few hosts (large playlists, HLS origin pulls) then pays the DNS
+ * round-trip once per host rather than once per connection. */
+#define VLC_GAI_CACHE_SIZE 16
+#define VLC_GAI_CACHE_TTL  VLC_TICK_FROM_SEC(60)
+
+static struct
+{
+    vlc_mutex_t lock;
+    unsigned next; /*< Round-robin eviction cursor */
+    struct vlc_gai_cache_entry
+    {
+        char *host;
+        unsigned port;
+        int family, socktype, protocol, flags;
+        struct addrinfo *list;
+        vlc_tick_t expiry;
+    } entry[VLC_GAI_CACHE_SIZE];
+} vlc_gai_cache = { VLC_STATIC_MUTEX, 0,
+                    { { NULL, 0, 0, 0, 0, 0, NULL, 0 } } };
+
+void vlc_freeaddrinfo_cached(struct addrinfo *info)
+{
+    while (info != NULL)
+    {
+        struct addrinfo *next = info->ai_next;
+
+        free(info->ai_canonname);
+        free(info);
+        info = next;
+    }
+}
+
+/* freeaddrinfo() cannot portably free a caller-built list (some C runtimes
+ * allocate the whole list as a single block), so both the cache and its
+ * callers only ever deal in copies released with vlc_freeaddrinfo_cached(). */
+static struct addrinfo *vlc_gai_copy(const struct addrinfo *info)
+{
+    struct addrinfo *head = NULL, **pp = &head;
+
+    for (; info != NULL; info = info->ai_next)
+    {
+        struct addrinfo *copy = malloc(sizeof (*copy) + info->ai_addrlen);
+        if (unlikely(copy == NULL))
+            goto error;
+
+        copy->ai_flags = info->ai_flags;
+        copy->ai_family = info->ai_family;
+        copy->ai_socktype = info->ai_socktype;
+        copy->ai_protocol = info->ai_protocol;
+        copy->ai_addrlen = info->ai_addrlen;
+        copy->ai_addr = (struct sockaddr *)(copy + 1);
+        memcpy(copy->ai_addr, info->ai_addr, info->ai_addrlen);
+        copy->ai_canonname = NULL;
+        copy->ai_next = NULL;
+
+        if (info->ai_canonname != NULL)
+        {
+            copy->ai_canonname = strdup(info->ai_canonname);
+            if (unlikely(copy->ai_canonname == NULL))
+            {
+                free(copy);
+                goto error;
+            }
+        }
+
+        *pp = copy;
+        pp = &copy->ai_next;
+    }
+    return head;
+
+error:
+    vlc_freeaddrinfo_cached(head);
+    return NULL;
+}
+
+static bool vlc_gai_entry_matches(const struct vlc_gai_cache_entry *entry,
+                                  const char *node, unsigned port,
+                                  const struct addrinfo *hints)
+{
+    return entry->host != NULL && !strcasecmp(entry->host, node)
+        && entry->port == port
+        && entry->family == (hints ? hints->ai_family : 0)
+        && entry->socktype == (hints ? hints->ai_socktype : 0)
+        && entry->protocol == (hints ? hints->ai_protocol : 0)
+        && entry->flags == (hints ? hints->ai_flags : 0);
+}
+
+static void vlc_gai_cache_store(const char *node, unsigned port,
+                                const struct addrinfo *hints,
+                                const struct addrinfo *info)
+{
+    struct addrinfo *list = vlc_gai_copy(info);
+    if (unlikely(list == NULL))
+        return;
+
+    vlc_mutex_lock(&vlc_gai_cache.lock);
+
+    unsigned i;
+    for (i = 0; i < VLC_GAI_CACHE_SIZE; i++)
+        if (vlc_gai_entry_matches(&vlc_gai_cache.entry[i], node, port, hints))
+            break;
+
+    if (i == VLC_GAI_CACHE_SIZE)
+    {   /* No entry for this key yet: evict the oldest one */
+        char *dup = strdup(node);
+        if (unlikely(dup == NULL))
+        {
+            vlc_mutex_unlock(&vlc_gai_cache.lock);
+            vlc_freeaddrinfo_cached(list);
+            return;
+        }
+
+        i = vlc_gai_cache.next;
+        vlc_gai_cache.next = (vlc_gai_cache.next + 1) % VLC_GAI_CACHE_SIZE;
+
+        struct vlc_gai_cache_entry *entry = &vlc_gai_cache.entry[i];
+
+        free(entry->host);
+        entry->host = dup;
+        entry->port = port;
+        entry->family = hints ? hints->ai_family : 0;
+        entry->socktype = hints ? hints->ai_socktype : 0;
+        entry->protocol = hints ? hints->ai_protocol : 0;
+        entry->flags = hints ? hints->ai_flags : 0;
+    }
+
+    vlc_freeaddrinfo_cached(vlc_gai_cache.entry[i].list);
+    vlc_gai_cache.entry[i].list = list;
+    vlc_gai_cache.entry[i].expiry = vlc_tick_now() + VLC_GAI_CACHE_TTL;
+    vlc_mutex_unlock(&vlc_gai_cache.lock);
+}
+
+int vlc_getaddrinfo_cached(const char *node, unsigned port,
+                           const struct addrinfo *hints,
+                           struct addrinfo **res)
+{
+    /* Wildcard and numeric lookups never hit the DNS: resolve them
+     * directly rather than waste cache entries. */
+    bool cacheable = node != NULL
+        && (hints == NULL
+         || !(hints->ai_flags & (AI_PASSIVE|AI_NUMERICHOST)));
+
+    if (cacheable)
+    {
+        struct addrinfo *list = NULL;
+        bool hit = false;
+
+        vlc_mutex_lock(&vlc_gai_cache.lock);
+        for (unsigned i = 0; i < VLC_GAI_CACHE_SIZE; i++)
+        {
+            struct vlc_gai_cache_entry *entry = &vlc_gai_cache.entry[i];
+
+            if (vlc_gai_entry_matches(entry, node, port, hints)
+             && vlc_tick_now() < entry->expiry)
+            {
+                list = vlc_gai_copy(entry->list);
+                hit = true;
+                break;
+            }
+        }
+        vlc_mutex_unlock(&vlc_gai_cache.lock);
+
+        if (hit)
+        {
+            if (unlikely(list == NULL))
+                return EAI_MEMORY;
+            *res = list;
+            return 0;
+        }
+    }
+
+    struct addrinfo *info;
+    int val = vlc_getaddrinfo_i11e(node, port, hints, &info);
+    if (val != 0)
+        return val;
+
+    if (cacheable)
+        vlc_gai_cache_store(node, port, hints, info);
+
+    *res = vlc_gai_copy(info);
+    freeaddrinfo(info);
+    return (*res != NULL) ? 0 : EAI_MEMORY;
+}
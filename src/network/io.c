@@ -34,11 +34,15 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <limits.h>
 #include <errno.h>
 #include <assert.h>
 
 #include <unistd.h>
+#ifdef HAVE_SYS_UIO_H
+# include <sys/uio.h>
+#endif
 #ifdef HAVE_LINUX_DCCP_H
 /* TODO: use glibc instead of linux-kernel headers */
 # include <linux/dccp.h>
@@ -278,19 +282,35 @@ ssize_t (net_Read)(vlc_object_t *restrict obj, int fd,
 }
 
 /**
- * Writes data to a socket.
+ * Writes data from a scatter-gather array to a socket.
  * This blocks until all data is written or an error occurs.
  *
+ * On a datagram socket, the whole array makes up a single datagram.
+ *
  * This function is a cancellation point.
  *
  * @return the total number of bytes written, or -1 if an error occurs
  * before any data is written.
  */
-ssize_t (net_Write)(vlc_object_t *obj, int fd, const void *buf, size_t len)
+ssize_t (net_Writev)(vlc_object_t *obj, int fd, const struct iovec *iov,
+                     unsigned count)
 {
     size_t written = 0;
 
-    do
+    if (unlikely(count == 0))
+        return 0;
+
+    /* The array is consumed as data is sent, so use a local copy. */
+    struct iovec iovecs[count];
+
+    memcpy(iovecs, iov, count * sizeof (*iov));
+
+    struct msghdr hdr = {
+        .msg_iov = iovecs,
+        .msg_iovlen = count,
+    };
+
+    while (hdr.msg_iovlen > 0)
     {
         if (vlc_killed())
         {
@@ -299,7 +319,7 @@ ssize_t (net_Write)(vlc_object_t *obj, int fd, const void *buf, size_t len)
             return -1;
         }
 
-        ssize_t val = vlc_send_i11e (fd, buf, len, MSG_NOSIGNAL);
+        ssize_t val = vlc_sendmsg_i11e(fd, &hdr, MSG_NOSIGNAL);
         if (val == -1)
         {
             if (errno == EINTR || errno == EAGAIN)
@@ -313,15 +333,43 @@ ssize_t (net_Write)(vlc_object_t *obj, int fd, const void *buf, size_t len)
             break;
 
         written += val;
-        assert(len >= (size_t)val);
-        len -= val;
-        buf = ((const char *)buf) + val;
+
+        while (hdr.msg_iovlen > 0 && (size_t)val >= hdr.msg_iov[0].iov_len)
+        {
+            val -= hdr.msg_iov[0].iov_len;
+            hdr.msg_iov++;
+            hdr.msg_iovlen--;
+        }
+
+        if (hdr.msg_iovlen > 0)
+        {
+            hdr.msg_iov[0].iov_base = (char *)hdr.msg_iov[0].iov_base + val;
+            hdr.msg_iov[0].iov_len -= val;
+        }
     }
-    while (len > 0);
 
     return written;
 }
 
+/**
+ * Writes data to a socket.
+ * This blocks until all data is written or an error occurs.
+ *
+ * This function is a cancellation point.
+ *
+ * @return the total number of bytes written, or -1 if an error occurs
+ * before any data is written.
+ */
+ssize_t (net_Write)(vlc_object_t *obj, int fd, const void *buf, size_t len)
+{
+    struct iovec iov = {
+        .iov_base = (void *)buf,
+        .iov_len = len,
+    };
+
+    return net_Writev(obj, fd, &iov, 1);
+}
+
 #undef net_Gets
 /**
  * Reads a line from a file descriptor.
@@ -51,6 +51,8 @@
 #include <vlc_tls.h>
 #include <vlc_interrupt.h>
 
+#include "libvlc.h"
+
 ssize_t vlc_tls_Read(vlc_tls_t *session, void *buf, size_t len, bool waitall)
 {
     struct pollfd ufd;
@@ -432,7 +434,7 @@ vlc_tls_t *vlc_tls_SocketOpenTCP(vlc_object_t *obj, const char *name,
     assert(name != NULL);
     msg_Dbg(obj, "resolving %s ...", name);
 
-    int val = vlc_getaddrinfo_i11e(name, port, &hints, &res);
+    int val = vlc_getaddrinfo_cached(name, port, &hints, &res);
     if (val != 0)
     {   /* TODO: C locale for gai_strerror() */
         msg_Err(obj, "cannot resolve %s port %u: %s", name, port,
@@ -452,10 +454,10 @@ vlc_tls_t *vlc_tls_SocketOpenTCP(vlc_object_t *obj, const char *name,
             continue;
         }
 
-        freeaddrinfo(res);
+        vlc_freeaddrinfo_cached(res);
         return tls;
     }
 
-    freeaddrinfo(res);
+    vlc_freeaddrinfo_cached(res);
     return NULL;
 }
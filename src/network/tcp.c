@@ -41,6 +41,7 @@
 #endif
 
 #include <vlc_network.h>
+#include "libvlc.h"
 #if defined (_WIN32)
 #   undef EINPROGRESS
 #   define EINPROGRESS WSAEWOULDBLOCK
@@ -126,7 +127,7 @@ int net_Connect( vlc_object_t *p_this, const char *psz_host, int i_port,
         .ai_flags = AI_NUMERICSERV | AI_IDN,
     }, *res;
 
-    int val = vlc_getaddrinfo_i11e(psz_realhost, i_realport, &hints, &res);
+    int val = vlc_getaddrinfo_cached(psz_realhost, i_realport, &hints, &res);
     if (val)
     {
         msg_Err (p_this, "cannot resolve %s port %d : %s", psz_realhost,
@@ -209,7 +210,7 @@ next_ai: /* failure */
         net_Close( fd );
     }
 
-    freeaddrinfo( res );
+    vlc_freeaddrinfo_cached( res );
 
     if( i_handle == -1 )
         return -1;
@@ -453,7 +454,7 @@ static int SocksHandshakeTCP( vlc_object_t *p_obj,
         };
         struct addrinfo *res;
 
-        if (vlc_getaddrinfo_i11e(psz_host, 0, &hints, &res))
+        if (vlc_getaddrinfo_cached(psz_host, 0, &hints, &res))
             return VLC_EGENERIC;
 
         buffer[0] = i_socks_version;
@@ -461,7 +462,7 @@ static int SocksHandshakeTCP( vlc_object_t *p_obj,
         SetWBE( &buffer[2], i_port );   /* Port */
         memcpy (&buffer[4],             /* Address */
                 &((struct sockaddr_in *)(res->ai_addr))->sin_addr, 4);
-        freeaddrinfo (res);
+        vlc_freeaddrinfo_cached (res);
 
         buffer[8] = 0;                  /* Empty user id */
 
@@ -226,7 +226,7 @@ vlc_tls_t *vlc_tls_SocketOpenTLS(vlc_tls_creds_t *creds, const char *name,
 
     msg_Dbg(creds, "resolving %s ...", name);
 
-    int val = vlc_getaddrinfo_i11e(name, port, &hints, &res);
+    int val = vlc_getaddrinfo_cached(name, port, &hints, &res);
     if (val != 0)
     {   /* TODO: C locale for gai_strerror() */
         msg_Err(creds, "cannot resolve %s port %u: %s", name, port,
@@ -247,7 +247,7 @@ vlc_tls_t *vlc_tls_SocketOpenTLS(vlc_tls_creds_t *creds, const char *name,
                                                      alpn, alp);
         if (tls != NULL)
         {   /* Success! */
-            freeaddrinfo(res);
+            vlc_freeaddrinfo_cached(res);
             return tls;
         }
 
@@ -256,6 +256,6 @@ vlc_tls_t *vlc_tls_SocketOpenTLS(vlc_tls_creds_t *creds, const char *name,
     }
 
     /* Failure! */
-    freeaddrinfo(res);
+    vlc_freeaddrinfo_cached(res);
     return NULL;
 }
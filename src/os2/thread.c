@@ -51,6 +51,12 @@
 
 #include <sys/stat.h>
 
+/* The profiled lock wrappers redirect here: this file defines the plain
+ * primitives and must not call back into itself. */
+#undef vlc_mutex_lock
+#undef vlc_mutex_unlock
+#undef vlc_cond_wait
+
 static vlc_threadvar_t thread_key;
 
 struct vlc_thread
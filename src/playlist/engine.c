@@ -225,6 +225,7 @@ playlist_t *playlist_Create( vlc_object_t *p_parent )
 
     p_playlist->i_current_index = 0;
     pl_priv(p_playlist)->b_reset_currently_playing = true;
+    pl_priv(p_playlist)->psz_live_search = NULL;
 
     pl_priv(p_playlist)->b_tree = var_InheritBool( p_parent, "playlist-tree" );
     pl_priv(p_playlist)->b_preparse = var_InheritBool( p_parent, "auto-preparse" );
@@ -232,6 +233,7 @@ playlist_t *playlist_Create( vlc_object_t *p_parent )
     p_playlist->root.p_input = NULL;
     p_playlist->root.pp_children = NULL;
     p_playlist->root.i_children = 0;
+    p_playlist->root.i_pindex = -1;
     p_playlist->root.i_nb_played = 0;
     p_playlist->root.i_id = 0;
     p_playlist->root.i_flags = 0;
@@ -334,6 +336,7 @@ void playlist_Destroy( playlist_t *p_playlist )
 
     vlc_cond_destroy( &p_sys->signal );
     vlc_mutex_destroy( &p_sys->lock );
+    free( p_sys->psz_live_search );
 
     vlc_http_cookie_jar_t *cookies = var_GetAddress( p_playlist, "http-cookies" );
     if ( cookies )
@@ -276,6 +276,7 @@ playlist_item_t *playlist_ItemNewFromInput( playlist_t *p_playlist,
     p_item->i_id = p->i_last_playlist_id;
     p_item->p_parent = NULL;
     p_item->i_children = (p_input->i_type == ITEM_TYPE_NODE) ? 0 : -1;
+    p_item->i_pindex = -1;
     p_item->pp_children = NULL;
     p_item->i_nb_played = 0;
     p_item->i_flags = 0;
@@ -608,13 +609,10 @@ int playlist_InsertInputItemTree (
 
 static int ItemIndex ( playlist_item_t *p_item )
 {
-    int idx;
-
-    TAB_FIND( p_item->p_parent->i_children,
-              p_item->p_parent->pp_children,
-              p_item,
-              idx );
+    int idx = p_item->i_pindex;
 
+    assert( idx >= 0 && idx < p_item->p_parent->i_children &&
+            p_item->p_parent->pp_children[idx] == p_item );
     return idx;
 }
 
@@ -640,11 +638,13 @@ int playlist_TreeMove( playlist_t * p_playlist, playlist_item_t *p_item,
     int i_index = ItemIndex( p_item );
 
     TAB_ERASE(p_detach->i_children, p_detach->pp_children, i_index);
+    playlist_NodeRenumber( p_detach, i_index );
 
     if( p_detach == p_node && i_index < i_newpos )
         i_newpos--;
 
     TAB_INSERT(p_node->i_children, p_node->pp_children, p_item, i_newpos);
+    playlist_NodeRenumber( p_node, i_newpos );
     p_item->p_parent = p_node;
 
     pl_priv( p_playlist )->b_reset_currently_playing = true;
@@ -678,6 +678,7 @@ int playlist_TreeMoveMany( playlist_t *p_playlist,
         int i_index = ItemIndex( p_item );
         playlist_item_t *p_parent = p_item->p_parent;
         TAB_ERASE(p_parent->i_children, p_parent->pp_children, i_index);
+        playlist_NodeRenumber( p_parent, i_index );
         if ( p_parent == p_node && i_index < i_newpos ) i_newpos--;
     }
     for( int i = i_items - 1; i >= 0; i-- )
@@ -686,6 +687,7 @@ int playlist_TreeMoveMany( playlist_t *p_playlist,
         TAB_INSERT(p_node->i_children, p_node->pp_children, p_item, i_newpos);
         p_item->p_parent = p_node;
     }
+    playlist_NodeRenumber( p_node, i_newpos );
 
     pl_priv( p_playlist )->b_reset_currently_playing = true;
     vlc_cond_signal( &pl_priv( p_playlist )->signal );
@@ -53,6 +53,12 @@ typedef struct playlist_private_t
     struct vlc_list       sds;
     input_thread_t *      p_input;  /**< the input thread associated
                                      * with the current item */
+    input_thread_t *      p_input_preroll; /**< the next item's input thread,
+                                     * buffering in a paused state */
+    input_item_t *        p_preroll_item; /**< item the preroll input thread
+                                     * was created for */
+    bool                  b_preroll_dead; /**< the preroll input thread died
+                                     * before being swapped in */
     input_resource_t *   p_input_resource; /**< input resources */
     vlc_renderer_item_t *p_renderer;
     struct {
@@ -73,6 +79,8 @@ typedef struct playlist_private_t
                                            The playlist sets it back to false
                                            when processing the request */
         bool input_dead; /**< Set when input has finished. */
+        bool b_preroll; /**< Set when the current item has passed the
+                             preroll threshold. */
     } request;
 
     vlc_thread_t thread; /**< engine thread */
@@ -83,6 +91,7 @@ typedef struct playlist_private_t
 
     int      i_last_playlist_id; /**< Last id to an item */
     bool     b_reset_currently_playing; /** Reset current item array */
+    char    *psz_live_search; /**< Last live search string, for refinement */
 
     bool     b_tree; /**< Display as a tree */
     bool     b_preparse; /**< Preparse items */
@@ -123,6 +132,19 @@ void playlist_AddSubtree(playlist_t *, input_item_t *, input_item_node_t *);
 /* Tree walking */
 int playlist_NodeInsert(playlist_item_t*, playlist_item_t *, int);
 
+/**
+ * Refresh the cached in-parent indices of a node's children from position
+ * i_first onward (entries before an insertion or removal point keep their
+ * index). The tree walking functions rely on these indices to step between
+ * siblings without rescanning the child array.
+ */
+static inline void playlist_NodeRenumber( playlist_item_t *p_node,
+                                          int i_first )
+{
+    for( int i = i_first; i < p_node->i_children; i++ )
+        p_node->pp_children[i]->i_pindex = i;
+}
+
 /**
  * Flags for playlist_NodeDeleteExplicit
  * \defgroup playlist_NodeDeleteExplicit_flags
@@ -61,7 +61,8 @@ static void playlist_LiveSearchClean( playlist_item_t *p_root )
  * @return true if an item match
  */
 static bool playlist_LiveSearchUpdateInternal( playlist_item_t *p_root,
-                                               const char *psz_string, bool b_recursive )
+                                               const char *psz_string, bool b_recursive,
+                                               bool b_refine )
 {
     int i;
     bool b_match = false;
@@ -69,9 +70,17 @@ static bool playlist_LiveSearchUpdateInternal( playlist_item_t *p_root,
     {
         bool b_enable = false;
         playlist_item_t *p_item = p_root->pp_children[i];
+
+        /* When refining a previous search, items already filtered out
+         * cannot match the more restrictive string: skip them (and their
+         * subtree, which was necessarily filtered out along with them) */
+        if( b_refine && ( p_item->i_flags & PLAYLIST_DBL_FLAG ) )
+            continue;
+
         // Go recurssively if their is some children
         if( b_recursive && p_item->i_children >= 0 &&
-            playlist_LiveSearchUpdateInternal( p_item, psz_string, true ) )
+            playlist_LiveSearchUpdateInternal( p_item, psz_string, true,
+                                               b_refine ) )
         {
             b_enable = true;
         }
@@ -120,12 +129,30 @@ int playlist_LiveSearchUpdate( playlist_t *p_playlist, playlist_item_t *p_root,
                                const char *psz_string, bool b_recursive )
 {
     PL_ASSERT_LOCKED;
-    pl_priv(p_playlist)->b_reset_currently_playing = true;
+    playlist_private_t *p_sys = pl_priv(p_playlist);
+
+    p_sys->b_reset_currently_playing = true;
     if( *psz_string )
-        playlist_LiveSearchUpdateInternal( p_root, psz_string, b_recursive );
+    {
+        /* Typing narrows the search: when the previous string still occurs
+         * in the new one, the new matches are a subset of the current ones,
+         * so only the items still enabled need to be re-checked. This keeps
+         * each keystroke proportional to the match set, not the playlist. */
+        bool b_refine = p_sys->psz_live_search != NULL
+                     && *p_sys->psz_live_search
+                     && vlc_strcasestr( psz_string,
+                                        p_sys->psz_live_search ) != NULL;
+
+        playlist_LiveSearchUpdateInternal( p_root, psz_string, b_recursive,
+                                           b_refine );
+    }
     else
         playlist_LiveSearchClean( p_root );
-    vlc_cond_signal( &pl_priv(p_playlist)->signal );
+
+    free( p_sys->psz_live_search );
+    p_sys->psz_live_search = *psz_string ? strdup( psz_string ) : NULL;
+
+    vlc_cond_signal( &p_sys->signal );
     return VLC_SUCCESS;
 }
 
@@ -32,10 +32,15 @@
 
 typedef struct vlc_sd_internal_t
 {
+    playlist_t           *playlist;
     /* the playlist items for category and onelevel */
     playlist_item_t      *node;
     services_discovery_t *sd; /**< Loaded service discovery modules */
     struct vlc_list       siblings;
+    bool                  b_creating; /**< the module is still being loaded
+                                           on the creation thread */
+    bool                  b_removed; /**< removed while still being loaded;
+                                          the remover waits and cleans up */
     char name[];
 } vlc_sd_internal_t;
 
@@ -116,39 +121,80 @@ static const struct services_discovery_callbacks playlist_sd_cbs = {
     .item_removed = playlist_sd_item_removed,
 };
 
-int playlist_ServicesDiscoveryAdd(playlist_t *playlist, const char *chain)
+/* Load the services discovery module. Modules probing the network can block
+ * here for a while, hence this runs on its own (detached) thread: items are
+ * delivered incrementally through the owner callbacks anyway. */
+static void *playlist_sd_CreateThread(void *data)
 {
-    vlc_sd_internal_t *sds = malloc(sizeof (*sds) + strlen(chain) + 1);
-    if (unlikely(sds == NULL))
-        return VLC_ENOMEM;
-
-    sds->node = NULL;
+    vlc_sd_internal_t *sds = data;
+    playlist_t *playlist = sds->playlist;
 
     struct services_discovery_owner_t owner = {
         &playlist_sd_cbs,
         sds,
     };
 
-    /* Perform the addition */
-    sds->sd = vlc_sd_Create(VLC_OBJECT(playlist), chain, &owner);
-    if (unlikely(sds->sd == NULL))
-    {
-        free(sds);
-        return VLC_ENOMEM;
-    }
+    services_discovery_t *sd = vlc_sd_Create(VLC_OBJECT(playlist), sds->name,
+                                             &owner);
+    if (sd == NULL)
+        msg_Err(playlist, "could not start discovery %s", sds->name);
 
-    strcpy(sds->name, chain);
+    bool release = false;
 
     playlist_Lock(playlist);
+    sds->sd = sd;
+    sds->b_creating = false;
+    if (sd == NULL)
+    {
+        if (!sds->b_removed)
+        {   /* nobody else references the entry anymore once unlisted */
+            vlc_list_remove(&sds->siblings);
+            release = true;
+        }
+    }
     /* Backward compatibility with Qt UI: create the node even if the SD
      * has not discovered any item. */
-    if (sds->node == NULL && sds->sd->description != NULL)
-        sds->node = playlist_NodeCreate(playlist, sds->sd->description,
+    else if (!sds->b_removed && sds->node == NULL && sd->description != NULL)
+        sds->node = playlist_NodeCreate(playlist, sd->description,
                                         &playlist->root, PLAYLIST_END,
                                         PLAYLIST_RO_FLAG);
+    /* Wake up any remover waiting for the creation to settle */
+    vlc_cond_broadcast(&pl_priv(playlist)->signal);
+    playlist_Unlock(playlist);
+
+    if (release)
+        free(sds);
+    return NULL;
+}
+
+int playlist_ServicesDiscoveryAdd(playlist_t *playlist, const char *chain)
+{
+    vlc_sd_internal_t *sds = malloc(sizeof (*sds) + strlen(chain) + 1);
+    if (unlikely(sds == NULL))
+        return VLC_ENOMEM;
 
+    sds->playlist = playlist;
+    sds->node = NULL;
+    sds->sd = NULL;
+    sds->b_creating = true;
+    sds->b_removed = false;
+    strcpy(sds->name, chain);
+
+    /* List the entry right away so that it can be found (and removed) while
+     * the module is still probing */
+    playlist_Lock(playlist);
     vlc_list_append(&sds->siblings, &pl_priv(playlist)->sds);
     playlist_Unlock(playlist);
+
+    if (vlc_clone_detach(NULL, playlist_sd_CreateThread, sds,
+                         VLC_THREAD_PRIORITY_LOW))
+    {
+        playlist_Lock(playlist);
+        vlc_list_remove(&sds->siblings);
+        playlist_Unlock(playlist);
+        free(sds);
+        return VLC_ENOMEM;
+    }
     return VLC_SUCCESS;
 }
 
@@ -180,6 +226,11 @@ int playlist_ServicesDiscoveryRemove(playlist_t *playlist, const char *name)
         {
             sds = entry;
             vlc_list_remove(&sds->siblings);
+            sds->b_removed = true;
+            /* The module may still be loading; wait for the creation thread
+             * to settle, it leaves the cleanup to us once b_removed is set */
+            while (sds->b_creating)
+                vlc_cond_wait(&priv->signal, &priv->lock);
             break;
         }
     playlist_Unlock(playlist);
@@ -190,6 +241,12 @@ int playlist_ServicesDiscoveryRemove(playlist_t *playlist, const char *name)
         return VLC_EGENERIC;
     }
 
+    if (sds->sd == NULL)
+    {   /* the module failed to load while we were waiting */
+        free(sds);
+        return VLC_SUCCESS;
+    }
+
     playlist_ServicesDiscoveryInternalRemove(playlist, sds);
     return VLC_SUCCESS;
 }
@@ -222,6 +279,8 @@ int playlist_ServicesDiscoveryControl( playlist_t *playlist, const char *psz_nam
     vlc_list_foreach(sds, &priv->sds, siblings)
         if (!strcmp(psz_name, sds->name))
         {
+            if (sds->sd == NULL) /* still being loaded */
+                break;
             va_list args;
             va_start( args, i_control );
             i_ret = vlc_sd_control(sds->sd, i_control, args );
@@ -236,8 +295,28 @@ int playlist_ServicesDiscoveryControl( playlist_t *playlist, const char *psz_nam
 void playlist_ServicesDiscoveryKillAll(playlist_t *playlist)
 {
     playlist_private_t *priv = pl_priv(playlist);
-    vlc_sd_internal_t *sds;
 
-    vlc_list_foreach(sds, &priv->sds, siblings)
-        playlist_ServicesDiscoveryInternalRemove(playlist, sds);
+    for (;;)
+    {
+        vlc_sd_internal_t *sds;
+
+        playlist_Lock(playlist);
+        sds = vlc_list_first_entry_or_null(&priv->sds, vlc_sd_internal_t,
+                                           siblings);
+        if (sds != NULL)
+        {
+            vlc_list_remove(&sds->siblings);
+            sds->b_removed = true;
+            while (sds->b_creating)
+                vlc_cond_wait(&priv->signal, &priv->lock);
+        }
+        playlist_Unlock(playlist);
+
+        if (sds == NULL)
+            break;
+        if (sds->sd != NULL)
+            playlist_ServicesDiscoveryInternalRemove(playlist, sds);
+        else
+            free(sds);
+    }
 }
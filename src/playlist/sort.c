@@ -33,19 +33,89 @@
 #include "playlist_internal.h"
 
 
+/* Sort keys.
+ *
+ * input_item_GetMeta() and input_item_GetTitleFbName() take the input item
+ * lock and return a fresh copy of the string; calling them from a qsort()
+ * comparator means O(n·log n) locks and allocations per sort, which freezes
+ * the interface for seconds on large libraries. Instead the comparators
+ * operate on a per-item key structure which fetches each field at most once
+ * and keeps it for the duration of the sort. */
+typedef struct
+{
+    playlist_item_t *p_item;
+    char *psz_title;                      /**< input_item_GetTitleFbName() */
+    char *psz_uri;                        /**< input_item_GetURI() */
+    char *ppsz_meta[VLC_META_TYPE_COUNT]; /**< input_item_GetMeta() */
+    vlc_tick_t i_duration;                /**< input_item_GetDuration() */
+    bool b_title;
+    bool b_uri;
+    bool b_duration;
+    bool pb_meta[VLC_META_TYPE_COUNT];
+} playlist_sort_key_t;
+
+static const char *key_title( playlist_sort_key_t *key )
+{
+    if( !key->b_title )
+    {
+        key->psz_title = input_item_GetTitleFbName( key->p_item->p_input );
+        key->b_title = true;
+    }
+    return key->psz_title;
+}
+
+static const char *key_uri( playlist_sort_key_t *key )
+{
+    if( !key->b_uri )
+    {
+        key->psz_uri = input_item_GetURI( key->p_item->p_input );
+        key->b_uri = true;
+    }
+    return key->psz_uri;
+}
+
+static const char *key_meta( playlist_sort_key_t *key, vlc_meta_type_t meta )
+{
+    if( !key->pb_meta[meta] )
+    {
+        key->ppsz_meta[meta] = input_item_GetMeta( key->p_item->p_input,
+                                                   meta );
+        key->pb_meta[meta] = true;
+    }
+    return key->ppsz_meta[meta];
+}
+
+static vlc_tick_t key_duration( playlist_sort_key_t *key )
+{
+    if( !key->b_duration )
+    {
+        key->i_duration = input_item_GetDuration( key->p_item->p_input );
+        key->b_duration = true;
+    }
+    return key->i_duration;
+}
+
+static void key_clean( playlist_sort_key_t *key )
+{
+    free( key->psz_title );
+    free( key->psz_uri );
+    for( int i = 0; i < VLC_META_TYPE_COUNT; i++ )
+        free( key->ppsz_meta[i] );
+}
+
 /* General comparison functions */
 /**
  * Compare two items using their title or name
- * @param first: the first item
- * @param second: the second item
+ * @param first: the first item key
+ * @param second: the second item key
  * @return -1, 0 or +1 like strcmp
  */
-static inline int meta_strcasecmp_title( const playlist_item_t *first,
-                              const playlist_item_t *second )
+static inline int meta_strcasecmp_title( playlist_sort_key_t *first,
+                                         playlist_sort_key_t *second )
 {
     int i_ret;
-    char *psz_first = input_item_GetTitleFbName( first->p_input );
-    char *psz_second = input_item_GetTitleFbName( second->p_input );
+    const char *psz_first = key_title( first );
+    const char *psz_second = key_title( second );
 
     if( psz_first && psz_second )
         i_ret = strcasecmp( psz_first, psz_second );
@@ -55,38 +125,40 @@ static inline int meta_strcasecmp_title( const playlist_item_t *first,
         i_ret = -1;
     else
         i_ret = 0;
-    free( psz_first );
-    free( psz_second );
 
     return i_ret;
 }
 
 /**
  * Compare two intems according to the given meta type
- * @param first: the first item
- * @param second: the second item
+ * @param first: the first item key
+ * @param second: the second item key
  * @param meta: the meta type to use to sort the items
  * @param b_integer: true if the meta are integers
  * @return -1, 0 or +1 like strcmp
  */
-static inline int meta_sort( const playlist_item_t *first,
-                             const playlist_item_t *second,
+static inline int meta_sort( playlist_sort_key_t *first,
+                             playlist_sort_key_t *second,
                              vlc_meta_type_t meta, bool b_integer )
 {
     int i_ret;
-    char *psz_first = input_item_GetMeta( first->p_input, meta );
-    char *psz_second = input_item_GetMeta( second->p_input, meta );
 
     /* Nodes go first */
-    if( first->i_children == -1 && second->i_children >= 0 )
-        i_ret = -1;
-    else if( first->i_children >= 0 && second->i_children == -1 )
-        i_ret = +1;
+    if( first->p_item->i_children == -1 && second->p_item->i_children >= 0 )
+        return -1;
+    else if( first->p_item->i_children >= 0 &&
+             second->p_item->i_children == -1 )
+        return +1;
     /* Both are nodes, sort by name */
-    else if( first->i_children >= 0 && second->i_children >= 0 )
-        i_ret = meta_strcasecmp_title( first, second );
+    else if( first->p_item->i_children >= 0 &&
+             second->p_item->i_children >= 0 )
+        return meta_strcasecmp_title( first, second );
+
     /* Both are items */
-    else if( !psz_first && !psz_second )
+    const char *psz_first = key_meta( first, meta );
+    const char *psz_second = key_meta( second, meta );
+
+    if( !psz_first && !psz_second )
         i_ret = 0;
     else if( !psz_first && psz_second )
         i_ret = +1;
@@ -100,8 +172,6 @@ static inline int meta_sort( const playlist_item_t *first,
             i_ret = strcasecmp( psz_first, psz_second );
     }
 
-    free( psz_first );
-    free( psz_second );
     return i_ret;
 }
 
@@ -136,7 +206,25 @@ void playlist_ItemArraySort( unsigned i_items, playlist_item_t **pp_items,
 {
     if( p_sortfn )
     {
-        qsort( pp_items, i_items, sizeof( pp_items[0] ), p_sortfn );
+        /* Decorate-sort-undecorate: the comparators run on key structures
+         * so that metadata is fetched (and the input item lock taken) at
+         * most once per item instead of once per comparison. */
+        playlist_sort_key_t *p_keys = calloc( i_items, sizeof( *p_keys ) );
+        if( unlikely(p_keys == NULL) )
+            return; /* leave the order unchanged */
+
+        for( unsigned i = 0; i < i_items; i++ )
+            p_keys[i].p_item = pp_items[i];
+
+        qsort( p_keys, i_items, sizeof( p_keys[0] ), p_sortfn );
+
+        for( unsigned i = 0; i < i_items; i++ )
+        {
+            pp_items[i] = p_keys[i].p_item;
+            pp_items[i]->i_pindex = i;
+            key_clean( &p_keys[i] );
+        }
+        free( p_keys );
     }
     else /* Randomise */
     {
@@ -151,6 +239,8 @@ void playlist_ItemArraySort( unsigned i_items, playlist_item_t **pp_items,
             pp_items[i_position] = pp_items[i_new];
             pp_items[i_new] = p_temp;
         }
+        for( i_position = 0; i_position < i_items; i_position++ )
+            pp_items[i_position]->i_pindex = i_position;
     }
 }
 
@@ -213,7 +303,7 @@ int playlist_RecursiveNodeSort( playlist_t *p_playlist, playlist_item_t *p_node,
  */
 
 #define SORTFN( SORT, first, second ) static inline int proto_##SORT \
-    ( const playlist_item_t *first, const playlist_item_t *second )
+    ( playlist_sort_key_t *first, playlist_sort_key_t *second )
 
 SORTFN( SORT_TRACK_NUMBER, first, second )
 {
@@ -267,8 +357,8 @@ SORTFN( SORT_DESCRIPTION, first, second )
 
 SORTFN( SORT_DURATION, first, second )
 {
-    vlc_tick_t time1 = input_item_GetDuration( first->p_input );
-    vlc_tick_t time2 = input_item_GetDuration( second->p_input );
+    vlc_tick_t time1 = key_duration( first );
+    vlc_tick_t time2 = key_duration( second );
     int i_ret = time1 > time2 ? +1 :
                     ( time1 == time2 ? 0 : -1 );
     return i_ret;
@@ -281,7 +371,7 @@ SORTFN( SORT_GENRE, first, second )
 
 SORTFN( SORT_ID, first, second )
 {
-    return first->i_id - second->i_id;
+    return first->p_item->i_id - second->p_item->i_id;
 }
 
 SORTFN( SORT_RATING, first, second )
@@ -297,10 +387,11 @@ SORTFN( SORT_TITLE, first, second )
 SORTFN( SORT_TITLE_NODES_FIRST, first, second )
 {
     /* If second is a node but not first */
-    if( first->i_children == -1 && second->i_children >= 0 )
+    if( first->p_item->i_children == -1 && second->p_item->i_children >= 0 )
         return -1;
     /* If first is a node but not second */
-    else if( first->i_children >= 0 && second->i_children == -1 )
+    else if( first->p_item->i_children >= 0 &&
+             second->p_item->i_children == -1 )
         return +1;
     /* Both are nodes or both are not nodes */
     else
@@ -310,8 +401,8 @@ SORTFN( SORT_TITLE_NODES_FIRST, first, second )
 SORTFN( SORT_TITLE_NUMERIC, first, second )
 {
     int i_ret;
-    char *psz_first = input_item_GetTitleFbName( first->p_input );
-    char *psz_second = input_item_GetTitleFbName( second->p_input );
+    const char *psz_first = key_title( first );
+    const char *psz_second = key_title( second );
 
     if( psz_first && psz_second )
         i_ret = atoi( psz_first ) - atoi( psz_second );
@@ -322,16 +413,14 @@ SORTFN( SORT_TITLE_NUMERIC, first, second )
     else
         i_ret = 0;
 
-    free( psz_first );
-    free( psz_second );
     return i_ret;
 }
 
 SORTFN( SORT_URI, first, second )
 {
     int i_ret;
-    char *psz_first = input_item_GetURI( first->p_input );
-    char *psz_second = input_item_GetURI( second->p_input );
+    const char *psz_first = key_uri( first );
+    const char *psz_second = key_uri( second );
 
     if( psz_first && psz_second )
         i_ret = strcasecmp( psz_first, psz_second );
@@ -342,8 +431,6 @@ SORTFN( SORT_URI, first, second )
     else
         i_ret = 0;
 
-    free( psz_first );
-    free( psz_second );
     return i_ret;
 }
 
@@ -351,6 +438,9 @@ SORTFN( SORT_URI, first, second )
 
 /* Generate stubs around the proto_## sorting functions, ascending and
  * descending both. Preprocessor magic up ahead. Brace yourself.
+ *
+ * The const qualifier is cast away because comparing lazily fetches
+ * fields into the key structures; this does not affect the ordering.
  */
 
 #ifndef VLC_DEFINE_SORT_FUNCTIONS
@@ -359,11 +449,11 @@ SORTFN( SORT_URI, first, second )
 
 #define DEF( s ) \
     static int cmp_a_##s(const void *l,const void *r) \
-    { return proto_##s(*(const playlist_item_t *const *)l, \
-                           *(const playlist_item_t *const *)r); } \
+    { return proto_##s((playlist_sort_key_t *)l, \
+                       (playlist_sort_key_t *)r); } \
     static int cmp_d_##s(const void *l,const void *r) \
-    { return -1*proto_##s(*(const playlist_item_t * const *)l, \
-                              *(const playlist_item_t * const *)r); }
+    { return -1*proto_##s((playlist_sort_key_t *)l, \
+                          (playlist_sort_key_t *)r); }
 
     VLC_DEFINE_SORT_FUNCTIONS
 
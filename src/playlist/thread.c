@@ -107,6 +107,23 @@ static int InputEvent( vlc_object_t *p_this, char const *psz_cmd,
         vlc_cond_signal( &sys->signal );
         PL_UNLOCK;
     }
+    else if( newval.i_int == INPUT_EVENT_POSITION )
+    {
+        playlist_private_t *sys = pl_priv(p_playlist);
+        float f_threshold = var_InheritFloat( p_playlist, "preroll-threshold" );
+
+        if( f_threshold > 0.f &&
+            var_GetFloat( p_this, "position" ) >= f_threshold )
+        {
+            PL_LOCK;
+            if( !sys->request.b_preroll && sys->p_input_preroll == NULL )
+            {
+                sys->request.b_preroll = true;
+                vlc_cond_signal( &sys->signal );
+            }
+            PL_UNLOCK;
+        }
+    }
     return VLC_SUCCESS;
 }
 
@@ -188,11 +205,23 @@ void ResetCurrentlyPlaying( playlist_t *p_playlist,
 static void on_input_event(input_thread_t *input,
                            const struct vlc_input_event *event, void *userdata)
 {
+    playlist_t *p_playlist = userdata;
+
     if (event->type == INPUT_EVENT_SUBITEMS)
     {
-        playlist_t *playlist = userdata;
         input_item_t *item = input_GetItem(input);
-        playlist_AddSubtree(playlist, item, event->subitems);
+        playlist_AddSubtree(p_playlist, item, event->subitems);
+    }
+    else if (event->type == INPUT_EVENT_DEAD)
+    {
+        /* The prerolled input has no "intf-event" callback until it is
+         * swapped in: catch its death here */
+        playlist_private_t *sys = pl_priv(p_playlist);
+
+        PL_LOCK;
+        if (input == sys->p_input_preroll)
+            sys->b_preroll_dead = true;
+        PL_UNLOCK;
     }
 
     input_LegacyEvents(input, event, userdata);
@@ -227,14 +256,54 @@ static bool PlayItem( playlist_t *p_playlist, playlist_item_t *p_item )
 
     libvlc_MetadataCancel( p_playlist->obj.libvlc, p_item );
 
-    input_thread_t *p_input_thread = input_Create( p_playlist,
-                                                   on_input_event, p_playlist,
-                                                   p_input, NULL,
-                                                   p_sys->p_input_resource,
-                                                   p_renderer );
+    input_thread_t *p_input_thread = NULL;
+    bool b_prerolled = false;
+
+    if( p_sys->p_input_preroll != NULL )
+    {
+        bool b_reuse = p_sys->p_preroll_item == p_input &&
+                       !p_sys->b_preroll_dead;
+
+        if( b_reuse )
+        {
+            msg_Dbg( p_playlist, "swapping in prerolled input thread" );
+            p_input_thread = p_sys->p_input_preroll;
+            var_AddCallback( p_input_thread, "intf-event",
+                             InputEvent, p_playlist );
+        }
+        else
+        {
+            msg_Dbg( p_playlist, "discarding unusable prerolled input" );
+            input_Stop( p_sys->p_input_preroll );
+            input_Close( p_sys->p_input_preroll );
+        }
+        input_item_Release( p_sys->p_preroll_item );
+
+        PL_LOCK;
+        p_sys->p_input_preroll = NULL;
+        p_sys->p_preroll_item = NULL;
+        if( b_reuse && p_sys->b_preroll_dead )
+            /* It died before the callback was in place */
+            p_sys->request.input_dead = true;
+        p_sys->b_preroll_dead = false;
+        PL_UNLOCK;
+
+        if( p_input_thread != NULL )
+        {
+            var_SetInteger( p_input_thread, "state", PLAYING_S );
+            b_prerolled = true;
+        }
+    }
+
+    if( p_input_thread == NULL )
+        p_input_thread = input_Create( p_playlist,
+                                       on_input_event, p_playlist,
+                                       p_input, NULL,
+                                       p_sys->p_input_resource,
+                                       p_renderer );
     if( p_renderer )
         vlc_renderer_item_release( p_renderer );
-    if( likely(p_input_thread != NULL) )
+    if( likely(p_input_thread != NULL) && !b_prerolled )
     {
         input_LegacyVarInit( p_input_thread );
         var_AddCallback( p_input_thread, "intf-event",
@@ -436,6 +505,117 @@ static playlist_item_t *NextItem( playlist_t *p_playlist )
     return p_new;
 }
 
+/**
+ * Guess the item that an "automatic" change (next) will pick, without
+ * touching the playlist course state.
+ *
+ * Returns NULL whenever the outcome is not certain (pending request,
+ * repeat, end-of-playlist reshuffle...): the preroll is best-effort only.
+ */
+static playlist_item_t *PeekNextItem( playlist_t *p_playlist )
+{
+    playlist_private_t *p_sys = pl_priv(p_playlist);
+
+    PL_ASSERT_LOCKED;
+
+    if( p_sys->request.b_request || p_sys->b_reset_currently_playing ||
+        p_sys->p_renderer != NULL )
+        return NULL;
+    if( var_GetBool( p_playlist, "repeat" ) ||
+        var_InheritBool( p_playlist, "play-and-stop" ) ||
+        var_InheritBool( p_playlist, "play-and-pause" ) )
+        return NULL;
+
+    int i = p_playlist->i_current_index + 1;
+    if( i >= p_playlist->current.i_size )
+    {
+        /* A reshuffle would invalidate the guess */
+        if( !var_GetBool( p_playlist, "loop" ) ||
+            var_GetBool( p_playlist, "random" ) ||
+            p_playlist->current.i_size == 0 )
+            return NULL;
+        i = 0;
+    }
+    return ARRAY_VAL( p_playlist->current, i );
+}
+
+/**
+ * Open and buffer the next item while the current one is still playing: the
+ * input is started with "start-paused" set, so it prerolls the decoders up
+ * to the first frame and then parks. PlayItem() swaps it in at the boundary.
+ */
+static void PrerollNext( playlist_t *p_playlist )
+{
+    playlist_private_t *p_sys = pl_priv(p_playlist);
+    playlist_item_t *p_item = PeekNextItem( p_playlist );
+
+    PL_ASSERT_LOCKED;
+    assert( p_sys->p_input_preroll == NULL );
+
+    if( p_item == NULL )
+        return;
+
+    input_item_t *p_input = p_item->p_input;
+    input_item_Hold( p_input );
+    PL_UNLOCK;
+
+    msg_Dbg( p_playlist, "prerolling next item" );
+    libvlc_MetadataCancel( p_playlist->obj.libvlc, p_item );
+
+    input_thread_t *p_input_thread = input_Create( p_playlist,
+                                                   on_input_event, p_playlist,
+                                                   p_input, NULL,
+                                                   p_sys->p_input_resource,
+                                                   NULL );
+    if( p_input_thread != NULL )
+    {
+        input_LegacyVarInit( p_input_thread );
+        var_Create( p_input_thread, "start-paused", VLC_VAR_BOOL );
+        var_SetBool( p_input_thread, "start-paused", true );
+        if( input_Start( p_input_thread ) )
+        {
+            vlc_object_release( p_input_thread );
+            p_input_thread = NULL;
+        }
+    }
+
+    PL_LOCK;
+    if( p_input_thread == NULL )
+    {
+        input_item_Release( p_input );
+        return;
+    }
+    p_sys->p_input_preroll = p_input_thread;
+    p_sys->p_preroll_item = p_input;
+    p_sys->b_preroll_dead = false;
+}
+
+/**
+ * Stops and destroys a prerolled input that will not be played.
+ */
+static void DiscardPreroll( playlist_t *p_playlist )
+{
+    playlist_private_t *p_sys = pl_priv(p_playlist);
+    input_thread_t *p_input_thread = p_sys->p_input_preroll;
+
+    PL_ASSERT_LOCKED;
+
+    if( p_input_thread == NULL )
+        return;
+
+    input_item_Release( p_sys->p_preroll_item );
+    p_sys->p_input_preroll = NULL;
+    p_sys->p_preroll_item = NULL;
+    p_sys->b_preroll_dead = false;
+    PL_UNLOCK;
+
+    /* WARNING: Input resource manipulation is incompatible with the
+     * playlist lock. */
+    input_Stop( p_input_thread );
+    input_Close( p_input_thread );
+    PL_LOCK;
+}
+
 static void LoopInput( playlist_t *p_playlist )
 {
     playlist_private_t *p_sys = pl_priv(p_playlist);
@@ -451,6 +631,15 @@ static void LoopInput( playlist_t *p_playlist )
             PL_DEBUG( "incoming request - stopping current input" );
             input_Stop( p_input );
         }
+        else if( p_sys->request.b_preroll )
+        {
+            p_sys->request.b_preroll = false;
+            if( p_sys->p_input_preroll == NULL )
+            {
+                PrerollNext( p_playlist );
+                continue; /* the lock was dropped: recheck everything */
+            }
+        }
         vlc_cond_wait( &p_sys->signal, &p_sys->lock );
     }
 
@@ -458,6 +647,7 @@ static void LoopInput( playlist_t *p_playlist )
     PL_DEBUG( "dead input" );
     p_sys->p_input = NULL;
     p_sys->request.input_dead = false;
+    p_sys->request.b_preroll = false;
     PL_UNLOCK;
 
     var_SetAddress( p_playlist, "input-current", NULL );
@@ -510,6 +700,9 @@ static void *Thread ( void *data )
             played = true;
         }
 
+        /* A prerolled input may be left over when playback stops */
+        DiscardPreroll( p_playlist );
+
         /* Playlist stopping */
         msg_Dbg( p_playlist, "nothing to play" );
         if( played && var_InheritBool( p_playlist, "play-and-exit" ) )
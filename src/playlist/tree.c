@@ -141,7 +141,12 @@ void playlist_NodeDeleteExplicit( playlist_t *p_playlist,
     /* Remove the item from its parent */
     playlist_item_t *p_parent = p_root->p_parent;
     if( p_parent != NULL )
-        TAB_REMOVE(p_parent->i_children, p_parent->pp_children, p_root);
+    {
+        assert( p_parent->pp_children[p_root->i_pindex] == p_root );
+        TAB_ERASE(p_parent->i_children, p_parent->pp_children,
+                  p_root->i_pindex);
+        playlist_NodeRenumber( p_parent, p_root->i_pindex );
+    }
 
     playlist_ItemRelease( p_playlist, p_root );
 }
@@ -155,6 +160,7 @@ int playlist_NodeInsert( playlist_item_t *p_parent, playlist_item_t *p_item,
 
     TAB_INSERT(p_parent->i_children, p_parent->pp_children,
                p_item, i_position);
+    playlist_NodeRenumber( p_parent, i_position );
     p_item->p_parent = p_parent;
 
     /* Inherit special flags from parent (sd cases) */
@@ -264,30 +270,22 @@ playlist_item_t *GetNextItem( playlist_t *p_playlist,
         return p_item->pp_children[0];
 
     playlist_item_t* p_parent = p_item->p_parent;
-    for( int i = 0 ; i < p_parent->i_children ; i++ )
+    int i = p_item->i_pindex;
+    assert( p_parent->pp_children[i] == p_item );
+
+    // Return the next children
+    if( i + 1 < p_parent->i_children )
+        return p_parent->pp_children[i+1];
+    // We are the least one, so try to have uncles
+    PL_DEBUG2( "Current item is the last of the node,"
+               "looking for uncle from %s",
+                p_parent->p_input->psz_name );
+    if( p_parent == p_root )
     {
-        if( p_parent->pp_children[i] == p_item )
-        {
-            // Return the next children
-            if( i + 1 < p_parent->i_children )
-                return p_parent->pp_children[i+1];
-            // We are the least one, so try to have uncles
-            else
-            {
-                PL_DEBUG2( "Current item is the last of the node,"
-                           "looking for uncle from %s",
-                            p_parent->p_input->psz_name );
-                if( p_parent == p_root )
-                {
-                    PL_DEBUG2( "already at root" );
-                    return NULL;
-                }
-                else
-                    return GetNextUncle( p_playlist, p_item, p_root );
-            }
-        }
+        PL_DEBUG2( "already at root" );
+        return NULL;
     }
-    return NULL;
+    return GetNextUncle( p_playlist, p_item, p_root );
 }
 
 playlist_item_t *GetNextUncle( playlist_t *p_playlist, playlist_item_t *p_item,
@@ -295,7 +293,6 @@ playlist_item_t *GetNextUncle( playlist_t *p_playlist, playlist_item_t *p_item,
 {
     playlist_item_t *p_parent = p_item->p_parent;
     playlist_item_t *p_grandparent;
-    bool b_found = false;
 
     (void)p_playlist;
 
@@ -304,19 +301,12 @@ playlist_item_t *GetNextUncle( playlist_t *p_playlist, playlist_item_t *p_item,
         p_grandparent = p_parent->p_parent;
         while( p_grandparent )
         {
-            int i;
-            for( i = 0 ; i< p_grandparent->i_children ; i++ )
-            {
-                if( p_parent == p_grandparent->pp_children[i] )
-                {
-                    PL_DEBUG2( "parent %s found as child %i of grandparent %s",
-                               p_parent->p_input->psz_name, i,
-                               p_grandparent->p_input->psz_name );
-                    b_found = true;
-                    break;
-                }
-            }
-            if( b_found && i + 1 < p_grandparent->i_children )
+            int i = p_parent->i_pindex;
+            assert( p_grandparent->pp_children[i] == p_parent );
+            PL_DEBUG2( "parent %s is child %i of grandparent %s",
+                       p_parent->p_input->psz_name, i,
+                       p_grandparent->p_input->psz_name );
+            if( i + 1 < p_grandparent->i_children )
             {
                     return p_grandparent->pp_children[i+1];
             }
@@ -341,7 +331,6 @@ playlist_item_t *GetPrevUncle( playlist_t *p_playlist, playlist_item_t *p_item,
 {
     playlist_item_t *p_parent = p_item->p_parent;
     playlist_item_t *p_grandparent;
-    bool b_found = false;
 
     (void)p_playlist;
 
@@ -350,16 +339,9 @@ playlist_item_t *GetPrevUncle( playlist_t *p_playlist, playlist_item_t *p_item,
         p_grandparent = p_parent->p_parent;
         while( 1 )
         {
-            int i;
-            for( i = p_grandparent->i_children -1 ; i >= 0; i-- )
-            {
-                if( p_parent == p_grandparent->pp_children[i] )
-                {
-                    b_found = true;
-                    break;
-                }
-            }
-            if( b_found && i - 1 > 0 )
+            int i = p_parent->i_pindex;
+            assert( p_grandparent->pp_children[i] == p_parent );
+            if( i - 1 > 0 )
             {
                 return p_grandparent->pp_children[i-1];
             }
@@ -401,28 +383,21 @@ playlist_item_t *GetPrevItem( playlist_t *p_playlist,
         abort();
     };
 
-    for( i = p_parent->i_children -1 ; i >= 0 ;  i-- )
+    i = p_item->i_pindex;
+    assert( p_parent->pp_children[i] == p_item );
+
+    if( i-1 < 0 )
     {
-        if( p_parent->pp_children[i] == p_item )
+       /* Was already the first sibling. Look for uncles */
+        PL_DEBUG2( "current item is the first of its node,"
+                   "looking for uncle from %s",
+                   p_parent->p_input->psz_name );
+        if( p_parent == p_root )
         {
-            if( i-1 < 0 )
-            {
-               /* Was already the first sibling. Look for uncles */
-                PL_DEBUG2( "current item is the first of its node,"
-                           "looking for uncle from %s",
-                           p_parent->p_input->psz_name );
-                if( p_parent == p_root )
-                {
-                    PL_DEBUG2( "already at root" );
-                    return NULL;
-                }
-                return GetPrevUncle( p_playlist, p_item, p_root );
-            }
-            else
-            {
-                return p_parent->pp_children[i-1];
-            }
+            PL_DEBUG2( "already at root" );
+            return NULL;
         }
+        return GetPrevUncle( p_playlist, p_item, p_root );
     }
-    return NULL;
+    return p_parent->pp_children[i-1];
 }
@@ -51,6 +51,12 @@
 # include <sys/pset.h>
 #endif
 
+/* The profiled lock wrappers redirect here: this file defines the plain
+ * primitives and must not call back into itself. */
+#undef vlc_mutex_lock
+#undef vlc_mutex_unlock
+#undef vlc_cond_wait
+
 static unsigned vlc_clock_prec;
 
 static void vlc_clock_setup_once (void)
@@ -109,7 +115,16 @@ void vlc_mutex_init( vlc_mutex_t *p_mutex )
     if (unlikely(pthread_mutexattr_init (&attr)))
         abort();
 #ifdef NDEBUG
+# ifdef PTHREAD_MUTEX_ADAPTIVE_NP
+    /* Most VLC critical sections (FIFOs, picture pools) last only a few
+     * instructions. On SMP, spinning briefly before sleeping in the kernel
+     * saves a round of futex system calls on short contention. */
+    pthread_mutexattr_settype (&attr, (vlc_GetCPUCount () > 1)
+                               ? PTHREAD_MUTEX_ADAPTIVE_NP
+                               : PTHREAD_MUTEX_DEFAULT);
+# else
     pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_DEFAULT);
+# endif
 #else
     pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_ERRORCHECK);
 #endif
@@ -23,6 +23,8 @@
 # include "config.h"
 #endif
 
+#include <sys/stat.h>
+
 #include <vlc_common.h>
 #include <vlc_atomic.h>
 #include <vlc_stream.h>
@@ -32,6 +34,8 @@
 #include <vlc_threads.h>
 #include <vlc_memstream.h>
 #include <vlc_meta_fetcher.h>
+#include <vlc_fs.h>
+#include <vlc_url.h>
 
 #include "art.h"
 #include "libvlc.h"
@@ -46,6 +50,7 @@ struct input_fetcher_t {
     struct background_worker* downloader;
 
     vlc_dictionary_t album_cache;
+    vlc_dictionary_t pending_fetches;
     vlc_object_t* owner;
     vlc_mutex_t lock;
 };
@@ -143,6 +148,138 @@ static void AddAlbumCache( input_fetcher_t* fetcher, input_item_t* item,
     free( key );
 }
 
+static void NotifyArtFetchEnded( struct fetcher_request* req, bool fetched )
+{
+    if (req->cbs && req->cbs->on_art_fetch_ended)
+        req->cbs->on_art_fetch_ended(req->item, fetched, req->userdata);
+}
+
+static void RequestRelease( void* req_ );
+static void RequestHold( void* req_ );
+
+/*****************************************************************************
+ * Request deduplication: when several items of the same album are fetched
+ * at once (typical of a library import), only the first one searches and
+ * downloads; the others are parked and completed from the album cache once
+ * the winner resolves.
+ *****************************************************************************/
+
+struct fetcher_waiter {
+    struct fetcher_request* req;
+    struct fetcher_waiter* next;
+};
+
+struct pending_fetch {
+    struct fetcher_request* owner; /**< the request doing the actual fetch */
+    struct fetcher_waiter* waiters;
+};
+
+/* Returns true if an equivalent fetch is already in flight and the request
+ * was parked behind it. Otherwise req becomes the fetching request. */
+static bool PendingFetchJoin( input_fetcher_t* fetcher,
+                              struct fetcher_request* req )
+{
+    char* key = CreateCacheKey( req->item );
+    bool joined = false;
+
+    if( key == NULL )
+        return false;
+
+    vlc_mutex_lock( &fetcher->lock );
+    struct pending_fetch* node =
+        vlc_dictionary_value_for_key( &fetcher->pending_fetches, key );
+    if( node != NULL )
+    {
+        if( node->owner != req )
+        {
+            struct fetcher_waiter* waiter = malloc( sizeof( *waiter ) );
+            if( waiter != NULL )
+            {
+                RequestHold( req );
+                waiter->req = req;
+                waiter->next = node->waiters;
+                node->waiters = waiter;
+                joined = true;
+            }
+        }
+        /* else: the fetching request entering its next stage */
+    }
+    else
+    {
+        node = malloc( sizeof( *node ) );
+        if( node != NULL )
+        {
+            node->owner = req;
+            node->waiters = NULL;
+            vlc_dictionary_insert( &fetcher->pending_fetches, key, node );
+        }
+    }
+    vlc_mutex_unlock( &fetcher->lock );
+
+    free( key );
+    return joined;
+}
+
+/* Completes the requests parked behind the fetch of item, successfully
+ * if the album cache resolves their art by now */
+static void PendingFetchResolve( input_fetcher_t* fetcher, input_item_t* item )
+{
+    char* key = CreateCacheKey( item );
+    if( key == NULL )
+        return;
+
+    vlc_mutex_lock( &fetcher->lock );
+    struct pending_fetch* node =
+        vlc_dictionary_value_for_key( &fetcher->pending_fetches, key );
+    if( node != NULL )
+        vlc_dictionary_remove_value_for_key( &fetcher->pending_fetches, key,
+                                             NULL, NULL );
+    vlc_mutex_unlock( &fetcher->lock );
+    free( key );
+
+    if( node == NULL )
+        return;
+
+    for( struct fetcher_waiter* waiter = node->waiters; waiter != NULL; )
+    {
+        struct fetcher_waiter* next = waiter->next;
+        struct fetcher_request* req = waiter->req;
+
+        if( ReadAlbumCache( fetcher, req->item ) == VLC_SUCCESS )
+        {
+            var_SetAddress( fetcher->owner, "item-change", req->item );
+            input_item_SetArtFetched( req->item, true );
+            NotifyArtFetchEnded( req, true );
+        }
+        else
+        {
+            input_item_SetArtNotFound( req->item, true );
+            NotifyArtFetchEnded( req, false );
+        }
+        RequestRelease( req );
+        free( waiter );
+        waiter = next;
+    }
+    free( node );
+}
+
+static void FreePendingFetch( void* data, void* obj )
+{
+    struct pending_fetch* node = data;
+    VLC_UNUSED( obj );
+
+    for( struct fetcher_waiter* waiter = node->waiters; waiter != NULL; )
+    {
+        struct fetcher_waiter* next = waiter->next;
+
+        NotifyArtFetchEnded( waiter->req, false );
+        RequestRelease( waiter->req );
+        free( waiter );
+        waiter = next;
+    }
+    free( node );
+}
+
 static int InvokeModule( input_fetcher_t* fetcher, input_item_t* item,
                          int scope, char const* type )
 {
@@ -215,15 +352,12 @@ static int SearchByScope( input_fetcher_t* fetcher,
     return VLC_EGENERIC;
 }
 
-static void NotifyArtFetchEnded( struct fetcher_request* req, bool fetched )
-{
-    if (req->cbs && req->cbs->on_art_fetch_ended)
-        req->cbs->on_art_fetch_ended(req->item, fetched, req->userdata);
-}
-
 static void Downloader( input_fetcher_t* fetcher,
     struct fetcher_request* req )
 {
+    if( PendingFetchJoin( fetcher, req ) )
+        return; /* another download of the same album is in flight */
+
     ReadAlbumCache( fetcher, req->item );
 
     char *psz_arturl = input_item_GetArtURL( req->item );
@@ -280,6 +414,7 @@ out:
 
     free( psz_arturl );
     NotifyArtFetchEnded(req, psz_arturl != NULL);
+    PendingFetchResolve( fetcher, req->item );
     return;
 
 error:
@@ -295,8 +430,14 @@ static void SearchLocal( input_fetcher_t* fetcher, struct fetcher_request* req )
     if( var_InheritBool( fetcher->owner, "metadata-network-access" ) ||
         req->options & META_REQUEST_OPTION_SCOPE_NETWORK )
     {
+        if( PendingFetchJoin( fetcher, req ) )
+            return; /* another request fetches this album */
+
         if( background_worker_Push( fetcher->network, req, NULL, 0 ) )
+        {
+            PendingFetchResolve( fetcher, req->item );
             NotifyArtFetchEnded(req, false);
+        }
     }
     else
     {
@@ -309,6 +450,7 @@ static void SearchNetwork( input_fetcher_t* fetcher, struct fetcher_request* req
 {
     if( SearchByScope( fetcher, req, FETCHER_SCOPE_NETWORK ) )
     {
+        PendingFetchResolve( fetcher, req->item );
         input_item_SetArtNotFound( req->item, true );
         NotifyArtFetchEnded(req, false);
     }
@@ -397,6 +539,102 @@ DEF_STARTER(  SearchLocal, fetcher->local )
 DEF_STARTER(SearchNetwork, fetcher->network )
 DEF_STARTER(   Downloader, fetcher->downloader )
 
+/*****************************************************************************
+ * Album cache persistence: the (artist,album) -> art file resolutions are
+ * kept across runs in a flat index next to the art files, one
+ * "key<TAB>file-url" line per album, so a restarted library scan does not
+ * re-probe the filesystem or the network for art it already has.
+ *****************************************************************************/
+
+static char* AlbumCacheIndexPath( void )
+{
+    char* cachedir = config_GetUserDir( VLC_CACHE_DIR );
+    char* path;
+
+    if( cachedir == NULL )
+        return NULL;
+    if( asprintf( &path, "%s" DIR_SEP "art" DIR_SEP "index.dat",
+                  cachedir ) == -1 )
+        path = NULL;
+    free( cachedir );
+    return path;
+}
+
+static void LoadAlbumCache( input_fetcher_t* fetcher )
+{
+    char* path = AlbumCacheIndexPath();
+    if( path == NULL )
+        return;
+
+    FILE* stream = vlc_fopen( path, "rt" );
+    free( path );
+    if( stream == NULL )
+        return;
+
+    char* line = NULL;
+    size_t size = 0;
+    ssize_t len;
+    while( ( len = getline( &line, &size, stream ) ) > 0 )
+    {
+        if( line[len - 1] == '\n' )
+            line[--len] = '\0';
+
+        char* url = strchr( line, '\t' );
+        if( url == NULL )
+            continue;
+        *(url++) = '\0';
+        if( strncasecmp( url, "file://", 7 ) )
+            continue;
+
+        /* Drop entries whose art file is gone */
+        char* artpath = vlc_uri2path( url );
+        if( artpath == NULL )
+            continue;
+        struct stat st;
+        int missing = vlc_stat( artpath, &st );
+        free( artpath );
+        if( missing )
+            continue;
+
+        char* value = strdup( url );
+        if( likely(value != NULL) )
+            vlc_dictionary_insert( &fetcher->album_cache, line, value );
+    }
+    free( line );
+    fclose( stream );
+}
+
+static void SaveAlbumCache( input_fetcher_t* fetcher )
+{
+    char* path = AlbumCacheIndexPath();
+    if( path == NULL )
+        return;
+
+    /* If the art directory does not exist, there is nothing worth saving */
+    FILE* stream = vlc_fopen( path, "wt" );
+    free( path );
+    if( stream == NULL )
+        return;
+
+    char** keys = vlc_dictionary_all_keys( &fetcher->album_cache );
+    if( keys != NULL )
+    {
+        for( int i = 0; keys[i] != NULL; i++ )
+        {
+            const char* url =
+                vlc_dictionary_value_for_key( &fetcher->album_cache, keys[i] );
+
+            if( url != NULL && !strncasecmp( url, "file://", 7 )
+             && strpbrk( keys[i], "\t\n" ) == NULL
+             && strpbrk( url, "\t\n" ) == NULL )
+                fprintf( stream, "%s\t%s\n", keys[i], url );
+            free( keys[i] );
+        }
+        free( keys );
+    }
+    fclose( stream );
+}
+
 static void WorkerInit( input_fetcher_t* fetcher,
     struct background_worker** worker, int( *starter )( void*, void*, void** ) )
 {
@@ -442,6 +680,8 @@ input_fetcher_t* input_fetcher_New( vlc_object_t* owner )
 
     vlc_mutex_init( &fetcher->lock );
     vlc_dictionary_init( &fetcher->album_cache, 0 );
+    vlc_dictionary_init( &fetcher->pending_fetches, 0 );
+    LoadAlbumCache( fetcher );
 
     return fetcher;
 }
@@ -476,7 +716,10 @@ void input_fetcher_Delete( input_fetcher_t* fetcher )
     background_worker_Delete( fetcher->network );
     background_worker_Delete( fetcher->downloader );
 
+    SaveAlbumCache( fetcher );
+
     vlc_dictionary_clear( &fetcher->album_cache, FreeCacheEntry, NULL );
+    vlc_dictionary_clear( &fetcher->pending_fetches, FreePendingFetch, NULL );
     vlc_mutex_destroy( &fetcher->lock );
 
     free( fetcher );
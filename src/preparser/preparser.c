@@ -292,7 +292,12 @@ void input_preparser_Push( input_preparser_t *preparser,
 
     struct input_preparser_req_t *req = ReqCreate(item, cbs, cbs_userdata);
 
-    if (background_worker_Push(preparser->worker, req, id, timeout))
+    enum background_worker_priority priority =
+        ( i_options & META_REQUEST_OPTION_PRIORITY ) ?
+        BACKGROUND_WORKER_PRIORITY_HIGH : BACKGROUND_WORKER_PRIORITY_NORMAL;
+
+    if (background_worker_PushPriority(preparser->worker, req, id, timeout,
+                                       priority))
         if (req->cbs && cbs->on_preparse_ended)
             cbs->on_preparse_ended(item, ITEM_PREPARSE_FAILED, cbs_userdata);
 
@@ -70,6 +70,7 @@ typedef struct sap_address_t
 
     unsigned                session_count;
     session_descriptor_t   *first;
+    session_descriptor_t   *cursor; /**< next session the thread will send */
 } sap_address_t;
 
 static sap_address_t *sap_addrs = NULL;
@@ -104,6 +105,7 @@ static sap_address_t *AddressCreate (vlc_object_t *obj, const char *group)
     vlc_cond_init (&addr->wait);
     addr->session_count = 0;
     addr->first = NULL;
+    addr->cursor = NULL;
 
     if (vlc_clone (&addr->thread, RunThread, addr, VLC_THREAD_PRIORITY_LOW))
     {
@@ -142,21 +144,38 @@ noreturn static void *RunThread (void *self)
     for (;;)
     {
         session_descriptor_t *p_session;
-        vlc_tick_t deadline;
+        vlc_tick_t sendtime;
 
         while (addr->first == NULL)
+        {
+            addr->cursor = NULL;
             vlc_cond_wait (&addr->wait, &addr->lock);
+        }
 
         assert (addr->session_count > 0);
 
-        deadline = vlc_tick_now ();
-        for (p_session = addr->first; p_session; p_session = p_session->next)
+        /* The cursor survives list changes (unregistration moves it off the
+         * removed session), so a burst of (un)registrations does not restart
+         * the cycle from the head and resend the same packets over and
+         * over. */
+        if (addr->cursor == NULL)
+            addr->cursor = addr->first;
+
+        p_session = addr->cursor;
+        addr->cursor = p_session->next;
+
+        sendtime = vlc_tick_now ();
+        send (addr->fd, p_session->data, p_session->length, 0);
+
+        while (addr->first != NULL)
         {
-            send (addr->fd, p_session->data, p_session->length, 0);
-            deadline += addr->interval * CLOCK_FREQ / addr->session_count;
+            /* Recompute the pace on every wake-up: the session count may
+             * have changed while waiting. */
+            vlc_tick_t deadline = sendtime
+                + addr->interval * CLOCK_FREQ / addr->session_count;
 
-            if (vlc_cond_timedwait (&addr->wait, &addr->lock, deadline) == 0)
-                break; /* list may have changed! */
+            if (vlc_cond_timedwait (&addr->wait, &addr->lock, deadline) != 0)
+                break; /* next session is due */
         }
     }
 
@@ -397,6 +416,8 @@ void sout_AnnounceUnRegister (vlc_object_t *obj, session_descriptor_t *session)
     }
 
 found:
+    if (addr->cursor == session)
+        addr->cursor = session->next;
     *psession = session->next;
 
     if (addr->first == NULL)
@@ -743,6 +743,439 @@ static void mrl_Clean( mrl_t *p_mrl )
  ****************************************************************************
  ****************************************************************************/
 
+/*****************************************************************************
+ * Threaded stream proxy (--sout-threaded): interposes a worker thread and a
+ * bounded block queue in front of each chain stage, so that e.g. muxing and
+ * network output overlap with transcoding instead of running serialized on
+ * the input thread. All entry points of the wrapped module stay serialized
+ * on one mutex, so modules need not be re-entrant.
+ *****************************************************************************/
+
+/* Maximum number of queued Send() calls per stage before backpressure */
+#define SOUT_THREAD_DEPTH_MAX 64
+
+typedef struct sout_stream_entry_t
+{
+    void        *id;
+    block_t     *block;
+    struct sout_stream_entry_t *next;
+} sout_stream_entry_t;
+
+typedef struct
+{
+    vlc_thread_t    thread;
+    vlc_mutex_t     lock;            /* protects the queue below */
+    vlc_cond_t      wait_data;
+    vlc_cond_t      wait_room;
+    vlc_cond_t      wait_idle;
+    sout_stream_entry_t *first;
+    sout_stream_entry_t **last;
+    size_t          depth;
+    bool            busy;            /* worker is inside the module */
+    bool            eof;
+    int             error;
+    vlc_mutex_t     lock_downstream; /* serializes calls into the module */
+} sout_stream_thread_t;
+
+static void *ThreadedStreamWorker( void *data )
+{
+    sout_stream_t *p_stream = data;
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+
+    for( ;; )
+    {
+        sout_stream_entry_t *entry;
+        int canc, err, ret = VLC_SUCCESS;
+
+        vlc_mutex_lock( &p_sys->lock );
+        mutex_cleanup_push( &p_sys->lock );
+        while( p_sys->first == NULL && !p_sys->eof )
+            vlc_cond_wait( &p_sys->wait_data, &p_sys->lock );
+        vlc_cleanup_pop();
+
+        entry = p_sys->first;
+        if( entry == NULL )
+        {   /* EOF with a drained queue */
+            vlc_mutex_unlock( &p_sys->lock );
+            break;
+        }
+        p_sys->first = entry->next;
+        if( p_sys->first == NULL )
+            p_sys->last = &p_sys->first;
+        p_sys->depth--;
+        p_sys->busy = true;
+        err = p_sys->error;
+        vlc_cond_signal( &p_sys->wait_room );
+        vlc_mutex_unlock( &p_sys->lock );
+
+        canc = vlc_savecancel();
+        if( err == VLC_SUCCESS )
+        {
+            vlc_mutex_lock( &p_sys->lock_downstream );
+            ret = sout_StreamIdSend( p_stream->p_next, entry->id,
+                                     entry->block );
+            vlc_mutex_unlock( &p_sys->lock_downstream );
+        }
+        else /* a previous Send() failed: drop until the caller notices */
+            block_Release( entry->block );
+        free( entry );
+        vlc_restorecancel( canc );
+
+        vlc_mutex_lock( &p_sys->lock );
+        if( ret != VLC_SUCCESS && p_sys->error == VLC_SUCCESS )
+            p_sys->error = ret;
+        p_sys->busy = false;
+        vlc_cond_signal( &p_sys->wait_idle );
+        vlc_mutex_unlock( &p_sys->lock );
+    }
+    return NULL;
+}
+
+/* Waits until the worker has forwarded all queued blocks, so that
+ * module entry points other than pf_send see a quiescent module. */
+static void ThreadedStreamDrain( sout_stream_thread_t *p_sys )
+{
+    vlc_mutex_lock( &p_sys->lock );
+    while( p_sys->depth > 0 || p_sys->busy )
+        vlc_cond_wait( &p_sys->wait_idle, &p_sys->lock );
+    vlc_mutex_unlock( &p_sys->lock );
+}
+
+static void *ThreadedStreamAdd( sout_stream_t *p_stream,
+                                const es_format_t *p_fmt )
+{
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+    void *id;
+
+    vlc_mutex_lock( &p_sys->lock_downstream );
+    id = sout_StreamIdAdd( p_stream->p_next, p_fmt );
+    vlc_mutex_unlock( &p_sys->lock_downstream );
+    return id;
+}
+
+static void ThreadedStreamDel( sout_stream_t *p_stream, void *id )
+{
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+
+    /* Queued blocks may reference this id */
+    ThreadedStreamDrain( p_sys );
+
+    vlc_mutex_lock( &p_sys->lock_downstream );
+    sout_StreamIdDel( p_stream->p_next, id );
+    vlc_mutex_unlock( &p_sys->lock_downstream );
+}
+
+static int ThreadedStreamSend( sout_stream_t *p_stream, void *id,
+                               block_t *p_block )
+{
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+    int error;
+
+    sout_stream_entry_t *entry = malloc( sizeof( *entry ) );
+    if( unlikely(entry == NULL) )
+    {
+        block_Release( p_block );
+        return VLC_ENOMEM;
+    }
+    entry->id = id;
+    entry->block = p_block;
+    entry->next = NULL;
+
+    vlc_mutex_lock( &p_sys->lock );
+    while( p_sys->depth >= SOUT_THREAD_DEPTH_MAX
+        && p_sys->error == VLC_SUCCESS )
+        vlc_cond_wait( &p_sys->wait_room, &p_sys->lock );
+
+    error = p_sys->error;
+    if( error == VLC_SUCCESS )
+    {
+        *p_sys->last = entry;
+        p_sys->last = &entry->next;
+        p_sys->depth++;
+        vlc_cond_signal( &p_sys->wait_data );
+    }
+    vlc_mutex_unlock( &p_sys->lock );
+
+    if( error != VLC_SUCCESS )
+    {
+        block_Release( p_block );
+        free( entry );
+    }
+    return error;
+}
+
+static void ThreadedStreamFlush( sout_stream_t *p_stream, void *id )
+{
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+
+    ThreadedStreamDrain( p_sys );
+
+    vlc_mutex_lock( &p_sys->lock_downstream );
+    sout_StreamFlush( p_stream->p_next, id );
+    vlc_mutex_unlock( &p_sys->lock_downstream );
+}
+
+static int ThreadedStreamControl( sout_stream_t *p_stream, int i_query,
+                                  va_list args )
+{
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+    sout_stream_stats_t *p_stats = NULL;
+    int i_ret;
+
+    if( i_query == SOUT_STREAM_GET_STATS )
+    {   /* Peek at the argument, the stage below consumes the list */
+        va_list ap;
+        va_copy( ap, args );
+        p_stats = va_arg( ap, sout_stream_stats_t * );
+        va_end( ap );
+    }
+
+    vlc_mutex_lock( &p_sys->lock_downstream );
+    i_ret = sout_StreamControlVa( p_stream->p_next, i_query, args );
+    vlc_mutex_unlock( &p_sys->lock_downstream );
+
+    if( p_stats != NULL && i_ret == VLC_SUCCESS )
+    {
+        vlc_mutex_lock( &p_sys->lock );
+        p_stats->i_queue_depth = p_sys->depth;
+        vlc_mutex_unlock( &p_sys->lock );
+    }
+    return i_ret;
+}
+
+static void sout_StreamThreadClose( sout_stream_t *p_stream )
+{
+    sout_stream_thread_t *p_sys = p_stream->p_sys;
+
+    vlc_mutex_lock( &p_sys->lock );
+    p_sys->eof = true;
+    vlc_cond_signal( &p_sys->wait_data );
+    vlc_mutex_unlock( &p_sys->lock );
+    vlc_join( p_sys->thread, NULL );
+
+    vlc_cond_destroy( &p_sys->wait_idle );
+    vlc_cond_destroy( &p_sys->wait_room );
+    vlc_cond_destroy( &p_sys->wait_data );
+    vlc_mutex_destroy( &p_sys->lock_downstream );
+    vlc_mutex_destroy( &p_sys->lock );
+    free( p_sys );
+}
+
+/*****************************************************************************
+ * Stats stream proxy (--sout-stats): counts blocks, bytes and time spent
+ * inside each chain stage, answers SOUT_STREAM_GET_STATS and periodically
+ * logs per-stage activity, so a lagging chain can be blamed on the right
+ * stage in production.
+ *****************************************************************************/
+
+/* Interval between two log emissions of the per-stage counters */
+#define SOUT_STATS_PERIOD VLC_TICK_FROM_SEC(5)
+
+typedef struct
+{
+    vlc_mutex_t lock;
+    uint64_t    blocks;
+    uint64_t    bytes;
+    vlc_tick_t  busy;
+    /* current emission period */
+    vlc_tick_t  period_start;
+    vlc_tick_t  period_busy;
+    uint64_t    period_blocks;
+    uint64_t    period_bytes;
+} sout_stream_stats_sys_t;
+
+static void *StatsStreamAdd( sout_stream_t *p_stream, const es_format_t *p_fmt )
+{
+    return sout_StreamIdAdd( p_stream->p_next, p_fmt );
+}
+
+static void StatsStreamDel( sout_stream_t *p_stream, void *id )
+{
+    sout_StreamIdDel( p_stream->p_next, id );
+}
+
+static int StatsStreamSend( sout_stream_t *p_stream, void *id,
+                            block_t *p_block )
+{
+    sout_stream_stats_sys_t *p_sys = p_stream->p_sys;
+    uint64_t i_blocks = 0, i_bytes = 0;
+
+    for( const block_t *b = p_block; b != NULL; b = b->p_next )
+    {
+        i_blocks++;
+        i_bytes += b->i_buffer;
+    }
+
+    vlc_tick_t start = vlc_tick_now();
+    int i_ret = sout_StreamIdSend( p_stream->p_next, id, p_block );
+    vlc_tick_t spent = vlc_tick_now() - start;
+
+    vlc_mutex_lock( &p_sys->lock );
+    p_sys->blocks += i_blocks;
+    p_sys->bytes += i_bytes;
+    p_sys->busy += spent;
+    p_sys->period_blocks += i_blocks;
+    p_sys->period_bytes += i_bytes;
+    p_sys->period_busy += spent;
+
+    vlc_tick_t elapsed = start - p_sys->period_start;
+    if( elapsed >= SOUT_STATS_PERIOD )
+    {
+        msg_Dbg( p_stream, "`%s' stats: %"PRIu64" blocks, %"PRIu64" bytes, "
+                 "busy %"PRId64"%% (total %"PRIu64" blocks, %"PRIu64" bytes)",
+                 p_stream->p_next->psz_name, p_sys->period_blocks,
+                 p_sys->period_bytes, p_sys->period_busy * 100 / elapsed,
+                 p_sys->blocks, p_sys->bytes );
+        p_sys->period_start = start;
+        p_sys->period_busy = 0;
+        p_sys->period_blocks = 0;
+        p_sys->period_bytes = 0;
+    }
+    vlc_mutex_unlock( &p_sys->lock );
+
+    return i_ret;
+}
+
+static void StatsStreamFlush( sout_stream_t *p_stream, void *id )
+{
+    sout_StreamFlush( p_stream->p_next, id );
+}
+
+static int StatsStreamControl( sout_stream_t *p_stream, int i_query,
+                               va_list args )
+{
+    sout_stream_stats_sys_t *p_sys = p_stream->p_sys;
+
+    if( i_query != SOUT_STREAM_GET_STATS )
+        return sout_StreamControlVa( p_stream->p_next, i_query, args );
+
+    sout_stream_stats_t *p_stats = va_arg( args, sout_stream_stats_t * );
+
+    vlc_mutex_lock( &p_sys->lock );
+    p_stats->i_sent_blocks = p_sys->blocks;
+    p_stats->i_sent_bytes = p_sys->bytes;
+    p_stats->i_busy_duration = p_sys->busy;
+    vlc_mutex_unlock( &p_sys->lock );
+    p_stats->i_queue_depth = 0;
+    return VLC_SUCCESS;
+}
+
+static void sout_StreamStatsClose( sout_stream_t *p_stream )
+{
+    sout_stream_stats_sys_t *p_sys = p_stream->p_sys;
+
+    vlc_mutex_destroy( &p_sys->lock );
+    free( p_sys );
+}
+
+/* Interposes the counting proxy in front of p_next.
+ * Returns p_next unchanged on failure. */
+static sout_stream_t *sout_StreamStatsWrap( sout_instance_t *p_sout,
+                                            sout_stream_t *p_next )
+{
+    sout_stream_t *p_stream =
+        vlc_custom_create( p_sout, sizeof( *p_stream ), "stream out" );
+    if( unlikely(p_stream == NULL) )
+        return p_next;
+
+    sout_stream_stats_sys_t *p_sys = malloc( sizeof( *p_sys ) );
+    char *psz_name = strdup( "stats" );
+    if( unlikely(p_sys == NULL || psz_name == NULL) )
+    {
+        free( psz_name );
+        free( p_sys );
+        vlc_object_release( p_stream );
+        return p_next;
+    }
+
+    vlc_mutex_init( &p_sys->lock );
+    p_sys->blocks = 0;
+    p_sys->bytes = 0;
+    p_sys->busy = 0;
+    p_sys->period_start = vlc_tick_now();
+    p_sys->period_busy = 0;
+    p_sys->period_blocks = 0;
+    p_sys->period_bytes = 0;
+
+    p_stream->p_sout = p_sout;
+    p_stream->p_module = NULL;
+    p_stream->psz_name = psz_name;
+    p_stream->p_cfg = NULL;
+    p_stream->p_next = p_next;
+    p_stream->pf_add = StatsStreamAdd;
+    p_stream->pf_del = StatsStreamDel;
+    p_stream->pf_send = StatsStreamSend;
+    p_stream->pf_flush = StatsStreamFlush;
+    p_stream->pf_control = StatsStreamControl;
+    p_stream->pace_nocontrol = false;
+    p_stream->p_sys = p_sys;
+
+    return p_stream;
+}
+
+/* Interposes a worker thread in front of p_next, decoupling its pf_send
+ * from the upstream caller. Returns p_next unchanged on failure. */
+static sout_stream_t *sout_StreamThreadWrap( sout_instance_t *p_sout,
+                                             sout_stream_t *p_next )
+{
+    sout_stream_t *p_stream =
+        vlc_custom_create( p_sout, sizeof( *p_stream ), "stream out" );
+    if( unlikely(p_stream == NULL) )
+        return p_next;
+
+    sout_stream_thread_t *p_sys = malloc( sizeof( *p_sys ) );
+    char *psz_name = strdup( "threaded" );
+    if( unlikely(p_sys == NULL || psz_name == NULL) )
+        goto error;
+
+    vlc_mutex_init( &p_sys->lock );
+    vlc_mutex_init( &p_sys->lock_downstream );
+    vlc_cond_init( &p_sys->wait_data );
+    vlc_cond_init( &p_sys->wait_room );
+    vlc_cond_init( &p_sys->wait_idle );
+    p_sys->first = NULL;
+    p_sys->last = &p_sys->first;
+    p_sys->depth = 0;
+    p_sys->busy = false;
+    p_sys->eof = false;
+    p_sys->error = VLC_SUCCESS;
+
+    p_stream->p_sout = p_sout;
+    p_stream->p_module = NULL;
+    p_stream->psz_name = psz_name;
+    p_stream->p_cfg = NULL;
+    p_stream->p_next = p_next;
+    p_stream->pf_add = ThreadedStreamAdd;
+    p_stream->pf_del = ThreadedStreamDel;
+    p_stream->pf_send = ThreadedStreamSend;
+    p_stream->pf_flush = ThreadedStreamFlush;
+    p_stream->pf_control = ThreadedStreamControl;
+    p_stream->pace_nocontrol = false;
+    p_stream->p_sys = p_sys;
+
+    if( vlc_clone( &p_sys->thread, ThreadedStreamWorker, p_stream,
+                   VLC_THREAD_PRIORITY_OUTPUT ) )
+    {
+        vlc_cond_destroy( &p_sys->wait_idle );
+        vlc_cond_destroy( &p_sys->wait_room );
+        vlc_cond_destroy( &p_sys->wait_data );
+        vlc_mutex_destroy( &p_sys->lock_downstream );
+        vlc_mutex_destroy( &p_sys->lock );
+        goto error;
+    }
+
+    msg_Dbg( p_sout, "stream=`%s' running on its own thread",
+             p_next->psz_name );
+    return p_stream;
+
+error:
+    msg_Warn( p_sout, "cannot thread sout stream `%s'", p_next->psz_name );
+    free( psz_name );
+    free( p_sys );
+    vlc_object_release( p_stream );
+    return p_next;
+}
+
 /* Destroy a "stream_out" module */
 static void sout_StreamDelete( sout_stream_t *p_stream )
 {
@@ -754,6 +1187,10 @@ static void sout_StreamDelete( sout_stream_t *p_stream )
 
     if( p_stream->p_module != NULL )
         module_unneed( p_stream, p_stream->p_module );
+    else if( p_stream->pf_send == ThreadedStreamSend )
+        sout_StreamThreadClose( p_stream );
+    else if( p_stream->pf_send == StatsStreamSend )
+        sout_StreamStatsClose( p_stream );
 
     FREENULL( p_stream->psz_name );
 
@@ -867,6 +1304,9 @@ sout_stream_t *sout_StreamChainNew(sout_instance_t *p_sout, const char *psz_chai
         vlc_array_append_or_abort(&name, psz_name);
     }
 
+    bool b_threaded = var_InheritBool( p_sout, "sout-threaded" );
+    bool b_stats = var_InheritBool( p_sout, "sout-stats" );
+
     size_t i = vlc_array_count(&name);
     vlc_array_t module;
     vlc_array_init(&module);
@@ -882,6 +1322,28 @@ sout_stream_t *sout_StreamChainNew(sout_instance_t *p_sout, const char *psz_chai
             *pp_last = p_next;   /* last module created in the chain */
 
         vlc_array_append_or_abort(&module, p_next);
+
+        if( b_stats )
+        {   /* Count right in front of the module, below any worker thread */
+            sout_stream_t *p_wrap = sout_StreamStatsWrap( p_sout, p_next );
+
+            if( p_wrap != p_next )
+            {
+                p_next = p_wrap;
+                vlc_array_append_or_abort(&module, p_next);
+            }
+        }
+
+        if( b_threaded )
+        {
+            sout_stream_t *p_wrap = sout_StreamThreadWrap( p_sout, p_next );
+
+            if( p_wrap != p_next )
+            {
+                p_next = p_wrap;
+                vlc_array_append_or_abort(&module, p_next);
+            }
+        }
     }
 
     vlc_array_clear(&name);
@@ -31,8 +31,10 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <vlc_common.h>
+#include <vlc_arrays.h>
 
 #include "vlc_iso_lang.h"
 
@@ -44,36 +46,95 @@
 static const iso639_lang_t unknown_language =
     { "Unknown", "??", "???", "???" };
 
-const iso639_lang_t * GetLang_1( const char * psz_code )
+/* Sorted indexes over p_languages, one per code flavour, so that lookups
+ * can binary-search instead of scanning the whole table. They are built
+ * once on first use; the table itself stays in its human-maintained order.
+ * The last table entry is the NULL-name terminator and is not indexed. */
+#define NB_LANGUAGES (ARRAY_SIZE(p_languages) - 1)
+
+static const iso639_lang_t *pp_langs_by_1[NB_LANGUAGES];
+static const iso639_lang_t *pp_langs_by_2T[NB_LANGUAGES];
+static const iso639_lang_t *pp_langs_by_2B[NB_LANGUAGES];
+static vlc_once_t langs_once = VLC_STATIC_ONCE;
+
+static int LangCmp_1( const void *a, const void *b )
 {
-    const iso639_lang_t *p_lang;
+    const iso639_lang_t *p_a = *(const iso639_lang_t *const *)a;
+    const iso639_lang_t *p_b = *(const iso639_lang_t *const *)b;
+    return strncasecmp( p_a->psz_iso639_1, p_b->psz_iso639_1, 2 );
+}
 
-    for( p_lang = p_languages; p_lang->psz_eng_name; p_lang++ )
-        if( !strncasecmp( p_lang->psz_iso639_1, psz_code, 2 ) )
-            return p_lang;
+static int LangCmp_2T( const void *a, const void *b )
+{
+    const iso639_lang_t *p_a = *(const iso639_lang_t *const *)a;
+    const iso639_lang_t *p_b = *(const iso639_lang_t *const *)b;
+    return strncasecmp( p_a->psz_iso639_2T, p_b->psz_iso639_2T, 3 );
+}
 
-    return &unknown_language;
+static int LangCmp_2B( const void *a, const void *b )
+{
+    const iso639_lang_t *p_a = *(const iso639_lang_t *const *)a;
+    const iso639_lang_t *p_b = *(const iso639_lang_t *const *)b;
+    return strncasecmp( p_a->psz_iso639_2B, p_b->psz_iso639_2B, 3 );
 }
 
-const iso639_lang_t * GetLang_2T( const char * psz_code )
+static void BuildLangIndexes( void )
 {
-    const iso639_lang_t *p_lang;
+    for( size_t i = 0; i < NB_LANGUAGES; i++ )
+        pp_langs_by_1[i] = pp_langs_by_2T[i] = pp_langs_by_2B[i] =
+            &p_languages[i];
+
+    qsort( pp_langs_by_1, NB_LANGUAGES, sizeof (pp_langs_by_1[0]),
+           LangCmp_1 );
+    qsort( pp_langs_by_2T, NB_LANGUAGES, sizeof (pp_langs_by_2T[0]),
+           LangCmp_2T );
+    qsort( pp_langs_by_2B, NB_LANGUAGES, sizeof (pp_langs_by_2B[0]),
+           LangCmp_2B );
+}
 
-    for( p_lang = p_languages; p_lang->psz_eng_name; p_lang++ )
-        if( !strncasecmp( p_lang->psz_iso639_2T, psz_code, 3 ) )
-            return p_lang;
+static int LangKeyCmp_1( const void *key, const void *entry )
+{
+    const iso639_lang_t *p_lang = *(const iso639_lang_t *const *)entry;
+    return strncasecmp( key, p_lang->psz_iso639_1, 2 );
+}
 
-    return &unknown_language;
+static int LangKeyCmp_2T( const void *key, const void *entry )
+{
+    const iso639_lang_t *p_lang = *(const iso639_lang_t *const *)entry;
+    return strncasecmp( key, p_lang->psz_iso639_2T, 3 );
 }
 
-const iso639_lang_t * GetLang_2B( const char * psz_code )
+static int LangKeyCmp_2B( const void *key, const void *entry )
 {
-    const iso639_lang_t *p_lang;
+    const iso639_lang_t *p_lang = *(const iso639_lang_t *const *)entry;
+    return strncasecmp( key, p_lang->psz_iso639_2B, 3 );
+}
 
-    for( p_lang = p_languages; p_lang->psz_eng_name; p_lang++ )
-        if( !strncasecmp( p_lang->psz_iso639_2B, psz_code, 3 ) )
-            return p_lang;
+static const iso639_lang_t *FindLang( const char *psz_code,
+                                      const iso639_lang_t **pp_index,
+                                      int (*keycmp)( const void *,
+                                                     const void * ) )
+{
+    vlc_once( &langs_once, BuildLangIndexes );
+
+    const iso639_lang_t **pp_lang =
+        bsearch( psz_code, pp_index, NB_LANGUAGES, sizeof (pp_index[0]),
+                 keycmp );
+    return (pp_lang != NULL) ? *pp_lang : &unknown_language;
+}
+
+const iso639_lang_t * GetLang_1( const char * psz_code )
+{
+    return FindLang( psz_code, pp_langs_by_1, LangKeyCmp_1 );
+}
 
-    return &unknown_language;
+const iso639_lang_t * GetLang_2T( const char * psz_code )
+{
+    return FindLang( psz_code, pp_langs_by_2T, LangKeyCmp_2T );
+}
+
+const iso639_lang_t * GetLang_2B( const char * psz_code )
+{
+    return FindLang( psz_code, pp_langs_by_2B, LangKeyCmp_2B );
 }
 
@@ -109,6 +109,7 @@ int vlc_memstream_open(struct vlc_memstream *ms)
     if (unlikely(ms->ptr == NULL))
         ms->error = EOF;
     ms->length = 0;
+    ms->capacity = 1;
     return ms->error;
 }
 
@@ -120,19 +121,58 @@ int vlc_memstream_flush(struct vlc_memstream *ms)
 int vlc_memstream_close(struct vlc_memstream *ms)
 {
     if (ms->error)
+    {
         free(ms->ptr);
-    return ms->error;
-} 
+        return ms->error;
+    }
+
+    /* Trim the overallocation from the doubling growth */
+    char *base = realloc(ms->ptr, ms->length + 1u);
+    if (likely(base != NULL))
+        ms->ptr = base;
+    return 0;
+}
+
+/* Ensure room for an extra len bytes plus the nul terminator. Grow the
+ * buffer geometrically rather than per write, so that building a string
+ * out of many small writes does not reallocate for each of them. */
+static char *vlc_memstream_grow(struct vlc_memstream *ms, size_t len)
+{
+    if (unlikely(len >= (SIZE_MAX - 1u) - ms->length))
+        return NULL;
+
+    size_t needed = ms->length + len + 1u;
+    if (needed <= ms->capacity)
+        return ms->ptr;
+
+    size_t capacity = ms->capacity;
+    while (capacity < needed)
+    {
+        if (unlikely(capacity > SIZE_MAX / 2))
+        {
+            capacity = needed;
+            break;
+        }
+        capacity = (capacity < 32) ? 32 : capacity * 2;
+    }
+
+    char *base = realloc(ms->ptr, capacity);
+    if (likely(base != NULL))
+    {
+        ms->ptr = base;
+        ms->capacity = capacity;
+    }
+    return base;
+}
 
 size_t vlc_memstream_write(struct vlc_memstream *ms, const void *ptr,
                            size_t len)
 {
-    char *base = realloc(ms->ptr, ms->length + len + 1u);
+    char *base = vlc_memstream_grow(ms, len);
     if (unlikely(base == NULL))
         goto error;
 
     memcpy(base + ms->length, ptr, len);
-    ms->ptr = base;
     ms->length += len;
     base[ms->length] = '\0';
     return len;
@@ -167,12 +207,11 @@ int vlc_memstream_vprintf(struct vlc_memstream *ms, const char *fmt,
     if (len < 0)
         goto error;
 
-    ptr = realloc(ms->ptr, ms->length + len + 1);
+    ptr = vlc_memstream_grow(ms, len);
     if (ptr == NULL)
         goto error;
 
     vsnprintf(ptr + ms->length, len + 1, fmt, args);
-    ms->ptr = ptr;
     ms->length += len;
     return len;
 
@@ -489,6 +489,9 @@ char *vlc_strftime( const char *tformat )
     if (strcmp (tformat, "") == 0)
         return strdup (""); /* corner case w.r.t. strftime() return value */
 
+    if (strchr (tformat, '%') == NULL)
+        return strdup (tformat); /* no conversion, save the strftime() dance */
+
     /* Get the current time.  */
     time( &curtime );
 
@@ -555,21 +558,25 @@ char *vlc_strfinput(input_thread_t *input, input_item_t *item, const char *s)
 
     while ((c = *s) != '\0')
     {
-        s++;
-
         if (!b_is_format)
         {
-            if (c == '$')
+            /* Copy the whole literal run up to the next '$' in one go,
+             * rather than growing the stream one character at a time. */
+            size_t len = strcspn(s, "$");
+            if (len > 0)
             {
-                b_is_format = true;
-                b_empty_if_na = false;
+                vlc_memstream_write(stream, s, len);
+                s += len;
                 continue;
             }
 
-            vlc_memstream_putc(stream, c);
+            s++;
+            b_is_format = true;
+            b_empty_if_na = false;
             continue;
         }
 
+        s++;
         b_is_format = false;
 
         switch (c)
@@ -228,6 +228,11 @@ char *vlc_strcasestr (const char *haystack, const char *needle)
     return NULL;
 }
 
+static bool IsCharsetUTF8(const char *charset)
+{
+    return !strcasecmp(charset, "UTF-8") || !strcasecmp(charset, "utf8");
+}
+
 /**
  * Converts a string from the given character encoding to utf-8.
  *
@@ -236,6 +241,23 @@ char *vlc_strcasestr (const char *haystack, const char *needle)
  */
 char *FromCharset(const char *charset, const void *data, size_t data_size)
 {
+    /* UTF-8 input needs no converter, only validation and a terminated
+     * copy. This is by far the common case for subtitles and meta data. */
+    if (IsCharsetUTF8(charset))
+    {
+        char *out = malloc(data_size + 1);
+        if (unlikely(out == NULL))
+            return NULL;
+
+        memcpy(out, data, data_size);
+        out[data_size] = '\0';
+        if (strlen(out) == data_size && IsUTF8(out) != NULL)
+            return out;
+
+        /* Embedded nul or invalid sequence: leave it to iconv */
+        free(out);
+    }
+
     vlc_iconv_t handle = vlc_iconv_open ("UTF-8", charset);
     if (handle == (vlc_iconv_t)(-1))
         return NULL;
@@ -278,6 +300,19 @@ char *FromCharset(const char *charset, const void *data, size_t data_size)
  */
 void *ToCharset(const char *charset, const char *in, size_t *outsize)
 {
+    /* Converting to UTF-8 is a validated copy of the (UTF-8) input */
+    if (IsCharsetUTF8(charset) && IsUTF8(in) != NULL)
+    {
+        size_t len = strlen(in);
+        char *res = malloc(len + 1);
+        if (unlikely(res == NULL))
+            return NULL;
+
+        memcpy(res, in, len + 1);
+        *outsize = len;
+        return res;
+    }
+
     vlc_iconv_t hd = vlc_iconv_open (charset, "UTF-8");
     if (hd == (vlc_iconv_t)(-1))
         return NULL;
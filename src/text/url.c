@@ -53,24 +53,31 @@ char *vlc_uri_decode_duplicate (const char *str)
 
 char *vlc_uri_decode (char *str)
 {
-    char *in = str, *out = str;
-    if (in == NULL)
+    if (str == NULL)
         return NULL;
 
-    char c;
-    while ((c = *(in++)) != '\0')
+    /* A string without any escape needs no rewriting at all. This is by far
+     * the common case when importing large play lists. */
+    char *in = strchr (str, '%');
+    if (in == NULL)
+        return str;
+
+    char *out = in;
+    while (*in == '%')
     {
-        if (c == '%')
-        {
-            char hex[3];
+        char hex[3];
 
-            if (!(hex[0] = *(in++)) || !(hex[1] = *(in++)))
-                return NULL;
-            hex[2] = '\0';
-            *(out++) = strtoul (hex, NULL, 0x10);
-        }
-        else
-            *(out++) = c;
+        if (!(hex[0] = in[1]) || !(hex[1] = in[2]))
+            return NULL;
+        hex[2] = '\0';
+        *(out++) = strtoul (hex, NULL, 0x10);
+        in += 3;
+
+        /* Move the whole run up to the next escape in one go */
+        size_t len = strcspn (in, "%");
+        memmove (out, in, len);
+        in += len;
+        out += len;
     }
     *out = '\0';
     return str;
@@ -85,13 +92,22 @@ static bool isurialnum(int c)
 
 static bool isurisafe(int c)
 {
-    /* These are the _unreserved_ URI characters (RFC3986 §2.3) */
-    return isurialnum(c) || (strchr ("-._~", c) != NULL);
+    /* These are the _unreserved_ URI characters (RFC3986 §2.3).
+     * Do not call strchr() here: these predicates run on every byte of
+     * every URI and must compile down to plain comparisons. */
+    return isurialnum(c) || c == '-' || c == '.' || c == '_' || c == '~';
 }
 
 static bool isurisubdelim(int c)
 {
-    return strchr("!$&'()*+,;=", c) != NULL;
+    switch (c)
+    {
+        case '!': case '$': case '&': case '\'': case '(': case ')':
+        case '*': case '+': case ',': case ';': case '=':
+            return true;
+        default:
+            return false;
+    }
 }
 
 static bool isurihex(int c)
@@ -105,12 +121,26 @@ static const char urihex[] = "0123456789ABCDEF";
 
 static char *encode_URI_bytes (const char *str, size_t *restrict lenp)
 {
-    char *buf = malloc (3 * *lenp + 1);
+    size_t len = *lenp, unsafe = 0;
+
+    /* Count the characters needing an escape first, so that the allocation
+     * is exact and the (common) all-safe case is a single plain copy. */
+    for (size_t i = 0; i < len; i++)
+        if (!isurisafe ((unsigned char)str[i]))
+            unsafe++;
+
+    char *buf = malloc (len + 2 * unsafe + 1);
     if (unlikely(buf == NULL))
         return NULL;
 
+    if (unsafe == 0)
+    {
+        memcpy (buf, str, len);
+        return buf; /* length unchanged, caller nul-terminates */
+    }
+
     char *out = buf;
-    for (size_t i = 0; i < *lenp; i++)
+    for (size_t i = 0; i < len; i++)
     {
         unsigned char c = str[i];
 
@@ -127,8 +157,7 @@ static char *encode_URI_bytes (const char *str, size_t *restrict lenp)
     }
 
     *lenp = out - buf;
-    out = realloc (buf, *lenp + 1);
-    return likely(out != NULL) ? out : buf;
+    return buf;
 }
 
 char *vlc_uri_encode (const char *str)
@@ -43,6 +43,7 @@
 
 #include "display.h"
 #include "window.h"
+#include "vsync.h"
 
 static void SplitterManage(vout_display_t *vd);
 static void SplitterClose(vout_display_t *vd);
@@ -371,6 +372,9 @@ typedef struct {
         vlc_tick_t last_pressed;
     } mouse;
 
+    /* vblank model, fed by VOUT_DISPLAY_EVENT_VSYNC */
+    vout_vsync_t vsync;
+
     atomic_bool reset_pictures;
 } vout_display_owner_sys_t;
 
@@ -586,6 +590,16 @@ static void VoutDisplayEvent(vout_display_t *vd, int event, va_list args)
         atomic_store(&osys->reset_pictures, true);
         break;
     }
+
+    case VOUT_DISPLAY_EVENT_VSYNC: {
+        /* Per frame event, so no logging here */
+        const vlc_tick_t date = va_arg(args, vlc_tick_t);
+        vlc_mutex_lock(&osys->lock);
+        vout_vsync_Update(&osys->vsync, date);
+        vlc_mutex_unlock(&osys->lock);
+        break;
+    }
+
     default:
         msg_Err(vd, "VoutDisplayEvent received event %d", event);
         /* TODO add an assert when all event are handled */
@@ -971,6 +985,7 @@ static vout_display_t *DisplayNew(vout_thread_t *vout,
     vlc_mutex_init(&osys->lock);
 
     vlc_mouse_Init(&osys->mouse.state);
+    vout_vsync_Init(&osys->vsync);
 
 #if defined(_WIN32) || defined(__OS2__)
     osys->is_fullscreen  = cfg->is_fullscreen;
@@ -1055,6 +1070,17 @@ void vout_DeleteDisplay(vout_display_t *vd, vout_display_state_t *state)
     free(osys);
 }
 
+vlc_tick_t vout_display_AlignVsync(vout_display_t *vd, vlc_tick_t date)
+{
+    vout_display_owner_sys_t *osys = vd->owner.sys;
+
+    vlc_mutex_lock(&osys->lock);
+    const vlc_tick_t vblank = vout_vsync_Align(&osys->vsync, date);
+    vlc_mutex_unlock(&osys->lock);
+
+    return vblank;
+}
+
 /*****************************************************************************
  *
  *****************************************************************************/
@@ -1096,6 +1122,7 @@ static void SplitterEvent(vout_display_t *vd, int event, va_list args)
 #endif
     case VOUT_DISPLAY_EVENT_MOUSE_DOUBLE_CLICK:
     case VOUT_DISPLAY_EVENT_PICTURES_INVALID:
+    case VOUT_DISPLAY_EVENT_VSYNC:
         VoutDisplayEvent(vd, event, args);
         break;
 
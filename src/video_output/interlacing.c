@@ -39,6 +39,15 @@
  * You can use the non vout filter if and only if the video properties stay the
  * same (width/height/chroma/fps), at least for now.
  */
+/* Probe one flagged picture out of this many while deinterlacing is on */
+#define COMBING_PROBE_PERIOD 16
+/* Probe more often while deinterlacing is bypassed, to re-engage quickly */
+#define COMBING_PROBE_PERIOD_BYPASS 4
+/* Number of luma row triples sampled per probed picture */
+#define COMBING_PROBE_ROWS 16
+/* Consecutive clean probes needed before bypassing deinterlacing */
+#define COMBING_SCORE_MAX 8
+
 static const char deinterlace_modes[][9]= {
     "auto",
     "discard",
@@ -165,14 +174,83 @@ void vout_InitInterlacingSupport(vout_thread_t *vout, bool is_interlaced)
     vout->p->interlacing.is_interlaced = is_interlaced;
     if (is_interlaced)
         vout->p->interlacing.date = vlc_tick_now();
+    vout->p->interlacing.probe_countdown = 0;
+    vout->p->interlacing.combing_score = COMBING_SCORE_MAX;
 }
 
 void vout_ReinitInterlacingSupport(vout_thread_t *vout)
 {
     vout->p->interlacing.is_interlaced = false;
+    vout->p->interlacing.probe_countdown = 0;
+    vout->p->interlacing.combing_score = COMBING_SCORE_MAX;
     var_SetBool(vout, "deinterlace-needed", false);
 }
 
+/**
+ * Cheap sampled comb metric.
+ *
+ * Uses the Gunnar Thalin combing metric also found in the IVTC deinterlacer
+ * (see CalculateInterlaceScore() in the deinterlace plugin), but only on a
+ * few evenly spread luma rows instead of the whole picture, so that it is
+ * cheap enough to run on the decoder path.
+ */
+static bool PictureIsCombed(const picture_t *pic)
+{
+    const plane_t *plane = &pic->p[Y_PLANE];
+    const int lasty = plane->i_visible_lines - 1;
+    const int w = plane->i_visible_pitch;
+    int step = (lasty - 1) / COMBING_PROBE_ROWS;
+    int_fast32_t score = 0;
+    int_fast32_t pixels = 0;
+
+    if (step < 1)
+        step = 1;
+
+    for (int y = 1; y < lasty; y += step) {
+        const uint8_t *p_p = &plane->p_pixels[(y - 1) * plane->i_pitch];
+        const uint8_t *p_c = &plane->p_pixels[ y      * plane->i_pitch];
+        const uint8_t *p_n = &plane->p_pixels[(y + 1) * plane->i_pitch];
+
+        for (int x = 0; x < w; x++) {
+            /* Both factors have the same sign on a combed pixel. The
+               threshold triggers on an average difference of 10. */
+            int_fast32_t comb = (p_p[x] - p_c[x]) * (p_n[x] - p_c[x]);
+            if (comb > 100)
+                score++;
+        }
+        pixels += w;
+    }
+
+    /* A progressive picture only triggers on noisy edges; 0.2% of the
+       sampled pixels is well above that yet far below actual combing. */
+    return score * 500 > pixels;
+}
+
+bool vout_InterlacingProbe(vout_thread_t *vout, const picture_t *pic)
+{
+    if (pic->b_progressive) {
+        /* The progressive flag has no false positives, trust it */
+        return false;
+    }
+
+    /* Flagged interlaced: probe for telecined or mislabeled progressive
+     * content, so that the deinterlacer cost can be bypassed on it. */
+    if (pic->i_planes == 0 || pic->p[Y_PLANE].i_pixel_pitch != 1)
+        return true; /* opaque or high bit depth luma: cannot probe */
+
+    if (vout->p->interlacing.probe_countdown-- == 0) {
+        if (PictureIsCombed(pic))
+            vout->p->interlacing.combing_score = COMBING_SCORE_MAX;
+        else if (vout->p->interlacing.combing_score > 0)
+            vout->p->interlacing.combing_score--;
+
+        vout->p->interlacing.probe_countdown =
+            (vout->p->interlacing.combing_score > 0)
+                ? COMBING_PROBE_PERIOD - 1 : COMBING_PROBE_PERIOD_BYPASS - 1;
+    }
+    return vout->p->interlacing.combing_score > 0;
+}
+
 void vout_SetInterlacingState(vout_thread_t *vout, bool is_interlaced)
 {
      /* Wait 30s before quiting interlacing mode */
@@ -27,5 +27,6 @@
 void vout_InitInterlacingSupport(vout_thread_t *, bool is_interlaced);
 void vout_ReinitInterlacingSupport(vout_thread_t *);
 void vout_SetInterlacingState(vout_thread_t *, bool is_interlaced);
+bool vout_InterlacingProbe(vout_thread_t *, const picture_t *);
 
 #endif
@@ -118,8 +118,27 @@ void vout_snapshot_Set(vout_snapshot_t *snap,
         fmt = &picture->format;
 
     vlc_mutex_lock(&snap->lock);
+    picture_t *copy = NULL;
     while (snap->request_count > 0) {
-        picture_t *dup = picture_Clone(picture);
+        picture_t *dup;
+        if (copy) {
+            /* Further pending requests share the same copy */
+            dup = picture_Clone(copy);
+        } else if (picture->i_planes > 0) {
+            /* Copy the planes instead of referencing the picture: the
+             * requesters convert and encode the snapshot at their own pace,
+             * which would pin a decoder/display pool picture for far longer
+             * than the copy takes. */
+            copy = picture_NewFromFormat(&picture->format);
+            if (copy != NULL) {
+                picture_Copy(copy, picture);
+                dup = copy;
+            } else
+                dup = picture_Clone(picture);
+        } else {
+            /* Opaque pictures cannot be copied in software */
+            dup = picture_Clone(picture);
+        }
         if (!dup)
             break;
 
@@ -53,7 +53,9 @@ bool vout_snapshot_IsRequested(vout_snapshot_t *);
 /**
  * It set the picture used to create the snapshots.
  *
- * The given picture is cloned.
+ * The given picture is copied (or cloned when it cannot be copied), so the
+ * caller does not need to keep it valid and no reference on it is retained
+ * once this function returns.
  * If p_fmt is non NULL it will override the format of the p_picture (mainly
  * used because of aspect/crop problems).
  */
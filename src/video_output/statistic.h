@@ -24,6 +24,7 @@
 #ifndef LIBVLC_VOUT_STATISTIC_H
 # define LIBVLC_VOUT_STATISTIC_H
 # include <stdatomic.h>
+# include <string.h>
 
 /* NOTE: Both statistics are atomic on their own, so one might be older than
  * the other one. Currently, only one of them is updated at a time, so this
@@ -65,4 +66,143 @@ static inline void vout_statistic_AddLost(vout_statistic_t *stat, int lost)
     atomic_fetch_add_explicit(&stat->lost, lost, memory_order_relaxed);
 }
 
+/** Why a picture was dropped */
+enum vout_drop_reason {
+    VOUT_DROP_DECODE_LATE = 0, /**< already late when it left the decoder */
+    VOUT_DROP_RENDER_LONG,     /**< rendering time ate the display deadline */
+    VOUT_DROP_DISPLAY_MISSED,  /**< display deadline passed while waiting */
+    VOUT_DROP_REASON_COUNT
+};
+
+/* Lateness histogram buckets: < 20 ms, < 40, < 80, < 160, < 320, more */
+#define VOUT_DROP_BUCKET_COUNT 6
+
+/* Drop accounting: reason counters and a lateness histogram. The vout
+ * thread is the only writer; any thread may read and reset the counters. */
+typedef struct {
+    atomic_uint reason[VOUT_DROP_REASON_COUNT];
+    atomic_uint lateness[VOUT_DROP_BUCKET_COUNT];
+} vout_drop_stats_t;
+
+static inline void vout_drop_stats_Init(vout_drop_stats_t *stats)
+{
+    for (unsigned i = 0; i < VOUT_DROP_REASON_COUNT; i++)
+        atomic_init(&stats->reason[i], 0);
+    for (unsigned i = 0; i < VOUT_DROP_BUCKET_COUNT; i++)
+        atomic_init(&stats->lateness[i], 0);
+}
+
+static inline void vout_drop_stats_Add(vout_drop_stats_t *stats,
+                                       enum vout_drop_reason reason,
+                                       vlc_tick_t late)
+{
+    unsigned bucket = 0;
+
+    for (vlc_tick_t limit = VLC_TICK_FROM_MS(20);
+         bucket < VOUT_DROP_BUCKET_COUNT - 1 && late >= limit; limit *= 2)
+        bucket++;
+    atomic_fetch_add_explicit(&stats->reason[reason], 1,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->lateness[bucket], 1,
+                              memory_order_relaxed);
+}
+
+static inline void
+vout_drop_stats_GetReset(vout_drop_stats_t *stats,
+                         unsigned reason[static VOUT_DROP_REASON_COUNT],
+                         unsigned lateness[static VOUT_DROP_BUCKET_COUNT])
+{
+    for (unsigned i = 0; i < VOUT_DROP_REASON_COUNT; i++)
+        reason[i] = atomic_exchange_explicit(&stats->reason[i], 0,
+                                             memory_order_relaxed);
+    for (unsigned i = 0; i < VOUT_DROP_BUCKET_COUNT; i++)
+        lateness[i] = atomic_exchange_explicit(&stats->lateness[i], 0,
+                                               memory_order_relaxed);
+}
+
+/* Number of records kept in the frame timeline ring (power of two) */
+#define VOUT_FRAME_TRACE_SIZE 512
+
+/** One frame timeline record, all times from vlc_tick_now() */
+typedef struct {
+    vlc_tick_t pts;            /**< picture date */
+    vlc_tick_t decoded;        /**< time the picture left the decoder fifo */
+    vlc_tick_t prepare_start;  /**< filtering/rendering start time */
+    vlc_tick_t prepare_end;    /**< display prepare completion time */
+    vlc_tick_t displayed;      /**< display (swap) time, 0 if lost */
+    vlc_tick_t deadline_delta; /**< displayed minus pts, positive if late */
+    bool       lost;           /**< the picture was dropped */
+} vout_frame_record_t;
+
+/* Lock-free frame timeline ring. The vout thread is the only writer; any
+ * thread may take a consistent snapshot of the most recent records with
+ * vout_frame_trace_Read(). */
+typedef struct {
+    atomic_uint_fast64_t head; /**< total number of records ever pushed */
+    vout_frame_record_t  record[VOUT_FRAME_TRACE_SIZE];
+} vout_frame_trace_t;
+
+static inline void vout_frame_trace_Init(vout_frame_trace_t *trace)
+{
+    atomic_init(&trace->head, 0);
+}
+
+/* Single writer: the vout thread */
+static inline void vout_frame_trace_Push(vout_frame_trace_t *trace,
+                                         const vout_frame_record_t *record)
+{
+    uint_fast64_t head = atomic_load_explicit(&trace->head,
+                                              memory_order_relaxed);
+
+    trace->record[head % VOUT_FRAME_TRACE_SIZE] = *record;
+    atomic_store_explicit(&trace->head, head + 1, memory_order_release);
+}
+
+static inline void vout_frame_trace_PushLost(vout_frame_trace_t *trace,
+                                             vlc_tick_t pts, vlc_tick_t date)
+{
+    vout_frame_record_t record = {
+        .pts = pts, .decoded = date, .lost = true,
+    };
+    vout_frame_trace_Push(trace, &record);
+}
+
+/**
+ * Copies the most recent records, oldest first, into a caller-supplied array
+ * of at least VOUT_FRAME_TRACE_SIZE entries.
+ *
+ * Records overwritten by the vout thread while the copy was in progress are
+ * discarded, so the returned window is always consistent.
+ *
+ * \return the number of records copied
+ */
+static inline size_t vout_frame_trace_Read(const vout_frame_trace_t *trace,
+                                           vout_frame_record_t *records)
+{
+    uint_fast64_t head = atomic_load_explicit(&trace->head,
+                                              memory_order_acquire);
+    uint_fast64_t first = head > VOUT_FRAME_TRACE_SIZE
+                        ? head - VOUT_FRAME_TRACE_SIZE : 0;
+
+    for (uint_fast64_t i = first; i != head; i++)
+        records[i - first] = trace->record[i % VOUT_FRAME_TRACE_SIZE];
+
+    /* Discard entries the writer may have overwritten meanwhile */
+    uint_fast64_t tail = atomic_load_explicit(&trace->head,
+                                              memory_order_acquire);
+    uint_fast64_t valid = tail > VOUT_FRAME_TRACE_SIZE
+                        ? tail - VOUT_FRAME_TRACE_SIZE : 0;
+    size_t count = head - first;
+
+    if (valid > first) {
+        size_t stale = valid - first;
+
+        if (stale > count)
+            stale = count;
+        memmove(records, records + stale, (count - stale) * sizeof (*records));
+        count -= stale;
+    }
+    return count;
+}
+
 #endif
@@ -46,6 +46,7 @@
 #include <vlc_spu.h>
 #include <vlc_vout_osd.h>
 #include <vlc_image.h>
+#include <vlc_tracer.h>
 #include <vlc_plugin.h>
 
 #include <libvlc.h>
@@ -66,6 +67,11 @@ static void VoutDestructor(vlc_object_t *);
  */
 #define VOUT_REDISPLAY_DELAY VLC_TICK_FROM_MS(80)
 
+/* While paused, redraw cycles whose output would be identical to what is
+ * already on screen are skipped; a full redraw is still issued at this
+ * slower rate so displays recover from expose/visibility changes. */
+#define VOUT_IDLE_REDISPLAY_DELAY VLC_TICK_FROM_MS(1000)
+
 /**
  * Late pictures having a delay higher than this value are thrashed.
  */
@@ -144,6 +150,10 @@ static vout_thread_t *VoutCreate(vlc_object_t *object,
 
     vout_control_Init(&vout->p->control);
     vout_statistic_Init(&vout->p->statistic);
+    vout_frame_trace_Init(&vout->p->frame_trace);
+    vout_drop_stats_Init(&vout->p->drop_stats);
+    memset(&vout->p->drop_summary, 0, sizeof (vout->p->drop_summary));
+    vout->p->drop_summary.date = VLC_TICK_INVALID;
     vout_snapshot_Init(&vout->p->snapshot);
     vout_chrono_Init(&vout->p->render, 5, VLC_TICK_FROM_MS(10)); /* Arbitrary initial time */
 
@@ -340,6 +350,13 @@ void vout_GetResetStatistic(vout_thread_t *vout, unsigned *restrict displayed,
     vout_statistic_GetReset( &vout->p->statistic, displayed, lost );
 }
 
+void vout_GetResetDropStatistic(vout_thread_t *vout,
+                                unsigned reason[static VOUT_DROP_REASON_COUNT],
+                                unsigned lateness[static VOUT_DROP_BUCKET_COUNT])
+{
+    vout_drop_stats_GetReset(&vout->p->drop_stats, reason, lateness);
+}
+
 void vout_Flush(vout_thread_t *vout, vlc_tick_t date)
 {
     vout_control_PushTime(&vout->p->control, VOUT_CONTROL_FLUSH, date);
@@ -348,11 +365,9 @@ void vout_Flush(vout_thread_t *vout, vlc_tick_t date)
 
 bool vout_IsEmpty(vout_thread_t *vout)
 {
-    picture_t *picture = picture_fifo_Peek(vout->p->decoder_fifo);
-    if (picture)
-        picture_Release(picture);
-
-    return !picture;
+    /* This is not called from the vout thread: the fifo consumer side
+     * (including Peek) is reserved to it, only the emptiness check is not */
+    return picture_fifo_IsEmpty(vout->p->decoder_fifo);
 }
 
 void vout_NextPicture(vout_thread_t *vout, vlc_tick_t *duration)
@@ -892,6 +907,51 @@ static void ThreadChangeFilters(vout_thread_t *vout,
 }
 
 
+/* Period between two dropped-pictures log summaries */
+#define VOUT_DROP_SUMMARY_PERIOD VLC_TICK_FROM_SEC(30)
+
+static void ThreadRecordDrop(vout_thread_t *vout,
+                             enum vout_drop_reason reason, vlc_tick_t late)
+{
+    vout_thread_sys_t *sys = vout->p;
+
+    vout_drop_stats_Add(&sys->drop_stats, reason, late);
+
+    if (sys->drop_summary.date == VLC_TICK_INVALID)
+        sys->drop_summary.date = vlc_tick_now();
+    sys->drop_summary.count++;
+    sys->drop_summary.reason[reason]++;
+    if (late > sys->drop_summary.worst)
+        sys->drop_summary.worst = late;
+}
+
+/* Log at most one aggregate line per summary period instead of one warning
+ * per dropped picture. */
+static void ThreadSummarizeDrops(vout_thread_t *vout)
+{
+    vout_thread_sys_t *sys = vout->p;
+
+    if (sys->drop_summary.date == VLC_TICK_INVALID)
+        return;
+
+    const vlc_tick_t now = vlc_tick_now();
+    if (now < sys->drop_summary.date + VOUT_DROP_SUMMARY_PERIOD)
+        return;
+
+    msg_Warn(vout, "dropped %u pictures in the last %"PRId64" s "
+             "(%u decode late, %u render long, %u display missed, "
+             "worst lateness %"PRId64" ms)",
+             sys->drop_summary.count,
+             SEC_FROM_VLC_TICK(now - sys->drop_summary.date),
+             sys->drop_summary.reason[VOUT_DROP_DECODE_LATE],
+             sys->drop_summary.reason[VOUT_DROP_RENDER_LONG],
+             sys->drop_summary.reason[VOUT_DROP_DISPLAY_MISSED],
+             MS_FROM_VLC_TICK(sys->drop_summary.worst));
+
+    memset(&sys->drop_summary, 0, sizeof (sys->drop_summary));
+    sys->drop_summary.date = VLC_TICK_INVALID;
+}
+
 /* */
 static int ThreadDisplayPreparePicture(vout_thread_t *vout, bool reuse, bool frame_by_frame)
 {
@@ -918,7 +978,10 @@ static int ThreadDisplayPreparePicture(vout_thread_t *vout, bool reuse, bool fra
                     const vlc_tick_t predicted = vlc_tick_now() + 0; /* TODO improve */
                     const vlc_tick_t late = predicted - decoded->date;
                     if (late > late_threshold) {
-                        msg_Warn(vout, "picture is too late to be displayed (missing %"PRId64" ms)", MS_FROM_VLC_TICK(late));
+                        msg_Dbg(vout, "picture is too late to be displayed (missing %"PRId64" ms)", MS_FROM_VLC_TICK(late));
+                        ThreadRecordDrop(vout, VOUT_DROP_DECODE_LATE, late);
+                        vout_frame_trace_PushLost(&vout->p->frame_trace,
+                                                  decoded->date, predicted);
                         picture_Release(decoded);
                         vout_statistic_AddLost(&vout->p->statistic, 1);
                         continue;
@@ -928,6 +991,7 @@ static int ThreadDisplayPreparePicture(vout_thread_t *vout, bool reuse, bool fra
                 }
                 if (!VideoFormatIsCropArEqual(&decoded->format, &vout->p->filter.format))
                     ThreadChangeFilters(vout, &decoded->format, vout->p->filter.configuration, -1, true);
+                vout->p->displayed.decoded_date = vlc_tick_now();
             }
         }
 
@@ -940,7 +1004,7 @@ static int ThreadDisplayPreparePicture(vout_thread_t *vout, bool reuse, bool fra
 
         vout->p->displayed.decoded       = picture_Hold(decoded);
         vout->p->displayed.timestamp     = decoded->date;
-        vout->p->displayed.is_interlaced = !decoded->b_progressive;
+        vout->p->displayed.is_interlaced = vout_InterlacingProbe(vout, decoded);
 
         picture = filter_chain_VideoFilter(vout->p->filter.chain_static, decoded);
     }
@@ -1013,6 +1077,62 @@ static picture_t *ConvertRGB32AndBlend(vout_thread_t *vout, picture_t *pic,
     return NULL;
 }
 
+static void FingerprintAdd(uint64_t *fp, const void *data, size_t size)
+{
+    const unsigned char *p = data;
+
+    while (size-- > 0) /* FNV-1a */
+        *fp = (*fp ^ *(p++)) * UINT64_C(0x100000001B3);
+}
+
+/**
+ * Summarizes everything the next redraw depends on: the filtered picture,
+ * the rendered subpicture regions (cached pictures, so unchanged regions
+ * keep their pointers) and the display configuration. Two cycles with the
+ * same fingerprint would put the exact same frame on screen.
+ */
+static uint64_t ThreadDisplayFingerprint(vout_thread_t *vout,
+                                         const picture_t *pic,
+                                         const subpicture_t *subpic)
+{
+    const vout_display_t *vd = vout->p->display.vd;
+    const vout_display_cfg_t *cfg = vd->cfg;
+    uint64_t fp = UINT64_C(0xCBF29CE484222325);
+
+    FingerprintAdd(&fp, &pic, sizeof(pic));
+
+    FingerprintAdd(&fp, &cfg->display, sizeof(cfg->display));
+    FingerprintAdd(&fp, &cfg->align, sizeof(cfg->align));
+    FingerprintAdd(&fp, &cfg->is_display_filled, sizeof(cfg->is_display_filled));
+    FingerprintAdd(&fp, &cfg->zoom, sizeof(cfg->zoom));
+    FingerprintAdd(&fp, &cfg->viewpoint, sizeof(cfg->viewpoint));
+
+    FingerprintAdd(&fp, &vd->source.i_x_offset, sizeof(vd->source.i_x_offset));
+    FingerprintAdd(&fp, &vd->source.i_y_offset, sizeof(vd->source.i_y_offset));
+    FingerprintAdd(&fp, &vd->source.i_visible_width,
+                   sizeof(vd->source.i_visible_width));
+    FingerprintAdd(&fp, &vd->source.i_visible_height,
+                   sizeof(vd->source.i_visible_height));
+    FingerprintAdd(&fp, &vd->source.i_sar_num, sizeof(vd->source.i_sar_num));
+    FingerprintAdd(&fp, &vd->source.i_sar_den, sizeof(vd->source.i_sar_den));
+
+    if (subpic != NULL) {
+        FingerprintAdd(&fp, &subpic->i_alpha, sizeof(subpic->i_alpha));
+        for (const subpicture_region_t *r = subpic->p_region;
+             r != NULL; r = r->p_next) {
+            FingerprintAdd(&fp, &r->p_picture, sizeof(r->p_picture));
+            FingerprintAdd(&fp, &r->i_x, sizeof(r->i_x));
+            FingerprintAdd(&fp, &r->i_y, sizeof(r->i_y));
+            FingerprintAdd(&fp, &r->i_alpha, sizeof(r->i_alpha));
+            FingerprintAdd(&fp, &r->fmt.i_visible_width,
+                           sizeof(r->fmt.i_visible_width));
+            FingerprintAdd(&fp, &r->fmt.i_visible_height,
+                           sizeof(r->fmt.i_visible_height));
+        }
+    }
+    return fp;
+}
+
 static int ThreadDisplayRenderPicture(vout_thread_t *vout, bool is_forced)
 {
     vout_thread_sys_t *sys = vout->p;
@@ -1020,6 +1140,7 @@ static int ThreadDisplayRenderPicture(vout_thread_t *vout, bool is_forced)
 
     picture_t *torender = picture_Hold(sys->displayed.current);
 
+    const vlc_tick_t trace_prepare_start = vlc_tick_now();
     vout_chrono_Start(&sys->render);
 
     vlc_mutex_lock(&sys->filter.lock);
@@ -1108,6 +1229,24 @@ static int ThreadDisplayRenderPicture(vout_thread_t *vout, bool is_forced)
                                       &vd->source,
                                       render_subtitle_date, render_osd_date,
                                       do_snapshot);
+
+    /* While paused, the vout keeps redrawing so the OSD stays live, but
+     * most cycles would reproduce the very frame already on screen. Skip
+     * those: only damaged output (picture, subpictures or display
+     * configuration changes) is worth waking the display for. A full
+     * redraw still goes through at a slow idle rate so displays recover
+     * from expose/visibility changes. */
+    const uint64_t render_fp = ThreadDisplayFingerprint(vout, filtered, subpic);
+    if (sys->pause.is_on && !do_snapshot &&
+        sys->display.rendered_fp_valid && render_fp == sys->display.rendered_fp &&
+        vlc_tick_now() - sys->display.last_displayed < VOUT_IDLE_REDISPLAY_DELAY) {
+        if (subpic != NULL)
+            subpicture_Delete(subpic);
+        picture_Release(filtered);
+        sys->displayed.date = vlc_tick_now();
+        return VLC_SUCCESS;
+    }
+
     /*
      * Perform rendering
      *
@@ -1205,6 +1344,7 @@ static int ThreadDisplayRenderPicture(vout_thread_t *vout, bool is_forced)
     }
 
     vout_chrono_Stop(&sys->render);
+    const vlc_tick_t trace_prepare_end = vlc_tick_now();
 #if 0
         {
         static int i = 0;
@@ -1220,15 +1360,45 @@ static int ThreadDisplayRenderPicture(vout_thread_t *vout, bool is_forced)
     if (delay < 1000)
         msg_Warn(vout, "picture is late (%lld ms)", delay / 1000);
 #endif
-    if (!is_forced)
-        vlc_tick_wait(todisplay->date);
+    if (!is_forced) {
+        /* When the display reports its vblank timing
+         * (VOUT_DISPLAY_EVENT_VSYNC), target the vblank nearest the
+         * picture date instead: sleeping straight to the date drifts
+         * against the refresh and shows up as periodic judder, typically
+         * with 23.976 fps content on a 60 Hz panel. */
+        const vlc_tick_t vblank = vout_display_AlignVsync(vd, todisplay->date);
+        if (vblank != VLC_TICK_INVALID) {
+            /* Swap slightly ahead so the picture catches that vblank */
+            vlc_tick_wait(vblank - VOUT_MWAIT_TOLERANCE);
+            if (vlc_tick_now() <= vblank)
+                sys->display.vsync_on_time++;
+            else
+                sys->display.vsync_missed++;
+        } else
+            vlc_tick_wait(todisplay->date);
+    }
 
     /* Display the direct buffer returned by vout_RenderPicture */
     sys->displayed.date = vlc_tick_now();
     vout_display_Display(vd, todisplay, subpic);
 
+    sys->display.rendered_fp       = render_fp;
+    sys->display.rendered_fp_valid = true;
+    sys->display.last_displayed    = sys->displayed.date;
+
     vout_statistic_AddDisplayed(&sys->statistic, 1);
 
+    const vout_frame_record_t record = {
+        .pts            = todisplay->date,
+        .decoded        = sys->displayed.decoded_date,
+        .prepare_start  = trace_prepare_start,
+        .prepare_end    = trace_prepare_end,
+        .displayed      = sys->displayed.date,
+        .deadline_delta = sys->displayed.date - todisplay->date,
+        .lost           = false,
+    };
+    vout_frame_trace_Push(&sys->frame_trace, &record);
+
     return VLC_SUCCESS;
 }
 
@@ -1287,6 +1457,15 @@ static int ThreadDisplayPicture(vout_thread_t *vout, vlc_tick_t *deadline)
     }
 
     if (drop_next_frame) {
+        if (!frame_by_frame) { /* when stepping, the current picture was shown */
+            vout_frame_trace_PushLost(&sys->frame_trace,
+                                      sys->displayed.current->date, date);
+            /* If the next picture would still be on time without the render
+             * delay, rendering time is what ate the deadline. */
+            ThreadRecordDrop(vout, sys->displayed.next->date > date
+                             ? VOUT_DROP_RENDER_LONG : VOUT_DROP_DISPLAY_MISSED,
+                             date - date_next);
+        }
         picture_Release(sys->displayed.current);
         sys->displayed.current = sys->displayed.next;
         sys->displayed.next    = NULL;
@@ -1297,6 +1476,7 @@ static int ThreadDisplayPicture(vout_thread_t *vout, vlc_tick_t *deadline)
 
     /* display the picture immediately */
     bool is_forced = frame_by_frame || force_refresh || sys->displayed.current->b_force;
+    vlc_trace_point("vout", "display", sys->displayed.current->date);
     int ret = ThreadDisplayRenderPicture(vout, is_forced);
     return force_refresh ? VLC_EGENERIC : ret;
 }
@@ -1474,6 +1654,7 @@ static void ThreadExecuteViewpoint(vout_thread_t *vout,
 static int ThreadStart(vout_thread_t *vout, vout_display_state_t *state)
 {
     vlc_mouse_Init(&vout->p->mouse);
+    vout->p->display.rendered_fp_valid = false;
     vout->p->decoder_fifo = picture_fifo_New();
     vout->p->decoder_pool = NULL;
     vout->p->display_pool = NULL;
@@ -1531,6 +1712,7 @@ static int ThreadStart(vout_thread_t *vout, vout_display_state_t *state)
     vout->p->displayed.decoded       = NULL;
     vout->p->displayed.date          = VLC_TICK_INVALID;
     vout->p->displayed.timestamp     = VLC_TICK_INVALID;
+    vout->p->displayed.decoded_date  = VLC_TICK_INVALID;
     vout->p->displayed.is_interlaced = false;
 
     vout->p->step.last               = VLC_TICK_INVALID;
@@ -1562,6 +1744,10 @@ static void ThreadStop(vout_thread_t *vout, vout_display_state_t *state)
 
     /* Destroy translation tables */
     if (vout->p->display.vd) {
+        if (vout->p->display.vsync_on_time + vout->p->display.vsync_missed > 0)
+            msg_Dbg(vout, "vsync: %u swaps on time, %u missed",
+                    vout->p->display.vsync_on_time,
+                    vout->p->display.vsync_missed);
         if (vout->p->decoder_pool) {
             ThreadFlush(vout, true, INT64_MAX);
             vout_EndWrapper(vout);
@@ -1775,6 +1961,7 @@ static void *Thread(void *object)
 
         vout_SetInterlacingState(vout, picture_interlaced);
         vout_ManageWrapper(vout);
+        ThreadSummarizeDrops(vout);
     }
 
 out:
@@ -110,6 +110,62 @@ static void DrawTriangle(subpicture_region_t *r, int fill, uint8_t color,
     }
 }
 
+/*
+ * Cache of the last rendered widget bitmaps, keyed by widget type, slider
+ * position and render size. Repeated widgets (typically a held volume key)
+ * reuse the rasterized picture through its reference count instead of
+ * drawing it again on the vout thread.
+ */
+#define OSD_WIDGET_CACHE_SIZE 4
+static struct
+{
+    vlc_mutex_t lock;
+    struct
+    {
+        int type;
+        int position;
+        int width;
+        int height;
+        picture_t *picture;
+    } entry[OSD_WIDGET_CACHE_SIZE];
+    unsigned next;
+} osd_widget_cache = { VLC_STATIC_MUTEX, { { 0, 0, 0, 0, NULL } }, 0 };
+
+static picture_t *OSDWidgetCacheGet(int type, int position,
+                                    int width, int height)
+{
+    picture_t *picture = NULL;
+
+    vlc_mutex_lock(&osd_widget_cache.lock);
+    for (unsigned i = 0; i < OSD_WIDGET_CACHE_SIZE; i++) {
+        if (osd_widget_cache.entry[i].picture != NULL &&
+            osd_widget_cache.entry[i].type     == type &&
+            osd_widget_cache.entry[i].position == position &&
+            osd_widget_cache.entry[i].width    == width &&
+            osd_widget_cache.entry[i].height   == height) {
+            picture = picture_Hold(osd_widget_cache.entry[i].picture);
+            break;
+        }
+    }
+    vlc_mutex_unlock(&osd_widget_cache.lock);
+    return picture;
+}
+
+static void OSDWidgetCachePut(int type, int position, picture_t *picture)
+{
+    vlc_mutex_lock(&osd_widget_cache.lock);
+    unsigned i = osd_widget_cache.next;
+    if (osd_widget_cache.entry[i].picture != NULL)
+        picture_Release(osd_widget_cache.entry[i].picture);
+    osd_widget_cache.entry[i].type     = type;
+    osd_widget_cache.entry[i].position = position;
+    osd_widget_cache.entry[i].width    = picture->format.i_visible_width;
+    osd_widget_cache.entry[i].height   = picture->format.i_visible_height;
+    osd_widget_cache.entry[i].picture  = picture_Hold(picture);
+    osd_widget_cache.next = (i + 1) % OSD_WIDGET_CACHE_SIZE;
+    vlc_mutex_unlock(&osd_widget_cache.lock);
+}
+
 /**
  * Create a region with a white transparent picture.
  */
@@ -178,6 +234,13 @@ static subpicture_region_t *OSDSlider(int type, int position,
     if( !r)
         return NULL;
 
+    picture_t *cached = OSDWidgetCacheGet(type, position, width, height);
+    if (cached != NULL) {
+        picture_Release(r->p_picture);
+        r->p_picture = cached;
+        return r;
+    }
+
     int pos_x = i_padding;
     int pos_y, pos_xend;
     int pos_yend = height - 1 - i_padding;
@@ -194,6 +257,7 @@ static subpicture_region_t *OSDSlider(int type, int position,
     DrawRect(r, STYLE_FILLED, COL_BLUE_SHADE, 0, 0, width - 1, height - 1);
     DrawRect(r, STYLE_FILLED, COL_BLUE, pos_x, pos_y, pos_xend, pos_yend);
 
+    OSDWidgetCachePut(type, position, r->p_picture);
     return r;
 }
 
@@ -221,6 +285,13 @@ static subpicture_region_t *OSDIcon(int type, const video_format_t *fmt)
     if (!r)
         return NULL;
 
+    picture_t *cached = OSDWidgetCacheGet(type, 0, width, height);
+    if (cached != NULL) {
+        picture_Release(r->p_picture);
+        r->p_picture = cached;
+        return r;
+    }
+
     DrawRect(r, STYLE_FILLED, COL_TRANSPARENT, 0, 0, width - 1, height - 1);
 
     if (type == OSD_PAUSE_ICON) {
@@ -243,6 +314,7 @@ static subpicture_region_t *OSDIcon(int type, const video_format_t *fmt)
                 DrawRect(r, STYLE_FILLED, COL_BLUE, y1, y1, __MIN(y1 + delta, width - 1), y1);
         }
     }
+    OSDWidgetCachePut(type, 0, r->p_picture);
     return r;
 }
 
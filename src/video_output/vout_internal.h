@@ -72,6 +72,18 @@ struct vout_thread_sys_t
     /* Statistics */
     vout_statistic_t statistic;
 
+    /* Frame timeline instrumentation */
+    vout_frame_trace_t frame_trace;
+
+    /* Drop accounting */
+    vout_drop_stats_t drop_stats;
+    struct {
+        vlc_tick_t date;  /* start of the current summary window */
+        unsigned   count; /* drops accumulated in the window */
+        unsigned   reason[VOUT_DROP_REASON_COUNT];
+        vlc_tick_t worst; /* worst lateness in the window */
+    } drop_summary;       /* (vout thread only) */
+
     /* Subpicture unit */
     vlc_mutex_t     spu_lock;
     spu_t           *spu;
@@ -91,11 +103,19 @@ struct vout_thread_sys_t
     struct {
         vout_display_t *vd;
         bool           use_dr;
+        /* vblank alignment bookkeeping, vout thread only */
+        unsigned       vsync_on_time;
+        unsigned       vsync_missed;
+        /* fingerprint of the last displayed render, vout thread only */
+        uint64_t       rendered_fp;
+        bool           rendered_fp_valid;
+        vlc_tick_t     last_displayed;
     } display;
 
     struct {
         vlc_tick_t  date;
         vlc_tick_t  timestamp;
+        vlc_tick_t  decoded_date;
         bool        is_interlaced;
         picture_t   *decoded;
         picture_t   *current;
@@ -122,6 +142,9 @@ struct vout_thread_sys_t
     struct {
         bool        is_interlaced;
         vlc_tick_t  date;
+        /* Sampled combing detector, see vout_InterlacingProbe() */
+        unsigned    probe_countdown;
+        int         combing_score;
     } interlacing;
 
     /* */
@@ -248,6 +271,14 @@ void spu_OffsetSubtitleDate( spu_t *p_spu, vlc_tick_t i_duration );
 void vout_GetResetStatistic( vout_thread_t *p_vout, unsigned *pi_displayed,
                              unsigned *pi_lost );
 
+/**
+ * This function will return and reset the picture drop accounting: one
+ * counter per \ref vout_drop_reason and a lateness histogram.
+ */
+void vout_GetResetDropStatistic( vout_thread_t *p_vout,
+                                 unsigned pi_reason[static VOUT_DROP_REASON_COUNT],
+                                 unsigned pi_lateness[static VOUT_DROP_BUCKET_COUNT] );
+
 /**
  * This function will ensure that all ready/displayed pictures have at most
  * the provided date.
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <stdlib.h>                                                /* free() */
 #include <assert.h>
+#include <errno.h>
 
 #include <vlc_block.h>
 #include <vlc_modules.h>
@@ -41,6 +42,7 @@
 #include <vlc_vout_osd.h>
 #include <vlc_strings.h>
 #include <vlc_charset.h>
+#include <vlc_fs.h>
 #include "vout_internal.h"
 
 /*****************************************************************************
@@ -427,6 +429,73 @@ exit:
     free( psz_path );
 }
 
+/**
+ * This function saves the frame timeline ring as Chrome trace-event JSON
+ * (see vout_SaveFrameTrace() in vlc_vout.h). Ticks are in microseconds,
+ * which is also the trace-event timestamp unit.
+ */
+int vout_SaveFrameTrace( vout_thread_t *p_vout, const char *psz_path )
+{
+    vout_frame_record_t *p_records =
+        vlc_alloc( VOUT_FRAME_TRACE_SIZE, sizeof (*p_records) );
+    if( unlikely(p_records == NULL) )
+        return VLC_ENOMEM;
+
+    size_t i_count = vout_frame_trace_Read( &p_vout->p->frame_trace,
+                                            p_records );
+
+    FILE *p_file = vlc_fopen( psz_path, "wt" );
+    if( p_file == NULL )
+    {
+        msg_Err( p_vout, "cannot write frame trace to %s: %s", psz_path,
+                 vlc_strerror_c(errno) );
+        free( p_records );
+        return VLC_EGENERIC;
+    }
+
+    const char *psz_sep = "";
+    fputs( "[\n", p_file );
+    for( size_t i = 0; i < i_count; i++ )
+    {
+        const vout_frame_record_t *r = &p_records[i];
+
+        if( r->lost )
+        {
+            fprintf( p_file, "%s{\"name\": \"lost frame\", \"cat\": \"vout\","
+                     " \"ph\": \"i\", \"s\": \"t\", \"pid\": 1, \"tid\": 1,"
+                     " \"ts\": %"PRId64", \"args\": {\"pts\": %"PRId64"}}",
+                     psz_sep, r->decoded, r->pts );
+            psz_sep = ",\n";
+            continue;
+        }
+
+        /* The decode time is unknown for the first displayed picture */
+        vlc_tick_t i_start = r->decoded != VLC_TICK_INVALID ? r->decoded
+                                                            : r->prepare_start;
+        fprintf( p_file, "%s{\"name\": \"frame\", \"cat\": \"vout\","
+                 " \"ph\": \"X\", \"pid\": 1, \"tid\": 2, \"ts\": %"PRId64","
+                 " \"dur\": %"PRId64", \"args\": {\"pts\": %"PRId64","
+                 " \"deadline_delta_us\": %"PRId64"}},\n",
+                 psz_sep, i_start, r->displayed - i_start, r->pts,
+                 r->deadline_delta );
+        fprintf( p_file, "{\"name\": \"prepare\", \"cat\": \"vout\","
+                 " \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %"PRId64","
+                 " \"dur\": %"PRId64"}",
+                 r->prepare_start, r->prepare_end - r->prepare_start );
+        psz_sep = ",\n";
+    }
+    fputs( "\n]\n", p_file );
+
+    int i_ret = ferror( p_file ) ? VLC_EGENERIC : VLC_SUCCESS;
+    fclose( p_file );
+    free( p_records );
+
+    if( i_ret == VLC_SUCCESS )
+        msg_Dbg( p_vout, "frame trace (%zu records) written to %s",
+                 i_count, psz_path );
+    return i_ret;
+}
+
 /*****************************************************************************
  * Object variables callbacks
  *****************************************************************************/
@@ -131,8 +131,21 @@ int vout_InitWrapper(vout_thread_t *vout)
                  display_pool_size, picture_pool_GetSize(display_pool));
 #endif
 
-    if (allow_dr &&
-        picture_pool_GetSize(display_pool) >= reserved_picture + decoder_picture) {
+    bool share_pool = allow_dr &&
+        picture_pool_GetSize(display_pool) >= reserved_picture + decoder_picture;
+
+    /* Decoders render directly into the decoder pool pictures and rely on
+     * the 64-byte plane alignment the core allocator guarantees. Sharing a
+     * display pool with weaker alignment would silently bring the copy back
+     * inside the decoder, on the decoding thread; better keep it at display
+     * time then. */
+    if (share_pool && !picture_pool_IsAligned(display_pool, 64)) {
+        msg_Warn(vout, "display pool not aligned for direct rendering, "
+                 "using system memory");
+        share_pool = false;
+    }
+
+    if (share_pool) {
         sys->dpb_size     = picture_pool_GetSize(display_pool) - reserved_picture;
         sys->decoder_pool = display_pool;
         sys->display_pool = display_pool;
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ * vsync.h: vout vertical blank predictor
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef LIBVLC_VOUT_VSYNC_H
+#define LIBVLC_VOUT_VSYNC_H
+
+/* Sanity bounds on a reported vblank interval: 20 Hz .. ~333 Hz */
+#define VOUT_VSYNC_PERIOD_MIN VLC_TICK_FROM_MS(3)
+#define VOUT_VSYNC_PERIOD_MAX VLC_TICK_FROM_MS(50)
+
+/**
+ * Display refresh model, fed with vblank timestamps reported by the
+ * display module (VOUT_DISPLAY_EVENT_VSYNC). It smooths the refresh
+ * period and extrapolates the phase so future vblanks can be predicted
+ * even when reports are sporadic.
+ */
+typedef struct {
+    vlc_tick_t period; /**< smoothed vblank interval */
+    vlc_tick_t phase;  /**< most recently reported vblank */
+    unsigned   count;  /**< intervals folded into the estimate */
+} vout_vsync_t;
+
+static inline void vout_vsync_Init(vout_vsync_t *vsync)
+{
+    vsync->period = VLC_TICK_INVALID;
+    vsync->phase  = VLC_TICK_INVALID;
+    vsync->count  = 0;
+}
+
+static inline void vout_vsync_Update(vout_vsync_t *vsync, vlc_tick_t vblank)
+{
+    if (vsync->phase != VLC_TICK_INVALID && vblank > vsync->phase) {
+        vlc_tick_t interval = vblank - vsync->phase;
+
+        /* Several vblanks may have elapsed between two reports */
+        if (vsync->period != VLC_TICK_INVALID) {
+            const vlc_tick_t elapsed =
+                (interval + vsync->period / 2) / vsync->period;
+            if (elapsed > 1)
+                interval /= elapsed;
+        }
+
+        if (interval >= VOUT_VSYNC_PERIOD_MIN &&
+            interval <= VOUT_VSYNC_PERIOD_MAX) {
+            if (vsync->period == VLC_TICK_INVALID)
+                vsync->period = interval;
+            else /* same first order filter as vout_chrono_t */
+                vsync->period = (7 * vsync->period + interval) / 8;
+            vsync->count++;
+        }
+    }
+    vsync->phase = vblank;
+}
+
+/**
+ * The model is usable once enough intervals have been measured and the
+ * reports have not gone stale (display paused, mode change, ...).
+ */
+static inline bool vout_vsync_IsValid(const vout_vsync_t *vsync,
+                                      vlc_tick_t now)
+{
+    return vsync->period != VLC_TICK_INVALID
+        && vsync->count >= 8
+        && now - vsync->phase < 16 * vsync->period;
+}
+
+/**
+ * It predicts the vblank nearest to the given date.
+ * \return the predicted vblank time, or VLC_TICK_INVALID if the model is
+ * not (or no longer) usable.
+ */
+static inline vlc_tick_t vout_vsync_Align(const vout_vsync_t *vsync,
+                                          vlc_tick_t date)
+{
+    if (!vout_vsync_IsValid(vsync, vlc_tick_now()))
+        return VLC_TICK_INVALID;
+    if (date <= vsync->phase)
+        return vsync->phase;
+
+    const vlc_tick_t n =
+        (date - vsync->phase + vsync->period / 2) / vsync->period;
+    return vsync->phase + n * vsync->period;
+}
+
+#endif
@@ -42,6 +42,12 @@
 #include <mmsystem.h>
 #endif
 
+/* The profiled lock wrappers redirect here: this file defines the plain
+ * primitives and must not call back into itself. */
+#undef vlc_mutex_lock
+#undef vlc_mutex_unlock
+#undef vlc_cond_wait
+
 /*** Static mutex and condition variable ***/
 static CRITICAL_SECTION super_mutex;
 static CONDITION_VARIABLE super_variable;
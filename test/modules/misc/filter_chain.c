@@ -0,0 +1,153 @@
+/*****************************************************************************
+ * filter_chain.c: pipelined video filter chain test
+ *****************************************************************************
+ * Copyright © 2026 VideoLAN and VLC Authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_es.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include <vlc_tick.h>
+#include "../../../lib/libvlc_internal.h"
+
+#include <vlc/vlc.h>
+
+#define WIDTH      64
+#define HEIGHT     48
+#define PICTURES   32
+#define LUMA       0x20
+#define DEADLINE   VLC_TICK_FROM_SEC(10)
+
+static picture_t *test_buffer_new(filter_t *filter)
+{
+    return picture_NewFromFormat(&filter->fmt_out.video);
+}
+
+static const struct filter_video_callbacks test_video_cbs =
+{
+    .buffer_new = test_buffer_new,
+};
+
+static picture_t *source_picture(const video_format_t *fmt, int num)
+{
+    picture_t *pic = picture_NewFromFormat(fmt);
+    assert(pic != NULL);
+    for (int i = 0; i < pic->i_planes; i++)
+        memset(pic->p[i].p_pixels, LUMA,
+               pic->p[i].i_pitch * pic->p[i].i_lines);
+    pic->date = num + 1;
+    return pic;
+}
+
+/* Checks one delivered picture: two inversions cancel out, so the payload
+ * must match the source, and dates must come back in feed order. */
+static void check_picture(picture_t *pic, int num)
+{
+    assert(pic->date == (vlc_tick_t)(num + 1));
+    assert(pic->p[0].p_pixels[0] == LUMA);
+    picture_Release(pic);
+}
+
+int main(void)
+{
+    libvlc_instance_t *vlc;
+    vlc_object_t *obj;
+
+    vlc = libvlc_new(0, NULL);
+    assert(vlc != NULL);
+    obj = VLC_OBJECT(vlc->p_libvlc_int);
+
+    filter_owner_t owner = {
+        .video = &test_video_cbs,
+    };
+    filter_chain_t *chain = filter_chain_NewVideo(obj, false, &owner);
+    assert(chain != NULL);
+
+    es_format_t fmt;
+    es_format_Init(&fmt, VIDEO_ES, VLC_CODEC_I420);
+    video_format_Setup(&fmt.video, VLC_CODEC_I420, WIDTH, HEIGHT,
+                       WIDTH, HEIGHT, 1, 1);
+    filter_chain_Reset(chain, &fmt, &fmt);
+
+    /* Two stages so the test actually crosses a thread boundary between
+     * filters, not just between the feeder and a single worker */
+    if (filter_chain_AppendFilter(chain, "invert", NULL, &fmt, &fmt) == NULL)
+    {
+        fprintf(stderr, "invert filter not available, skipping\n");
+        filter_chain_Delete(chain);
+        es_format_Clean(&fmt);
+        libvlc_release(vlc);
+        return 77;
+    }
+    assert(filter_chain_AppendFilter(chain, "invert", NULL, &fmt, &fmt)
+           != NULL);
+
+    assert(filter_chain_PipelineStart(chain) == VLC_SUCCESS);
+
+    /* The pipeline may return nothing while it fills up and delivers
+     * in-flight pictures on later calls, so count what comes back rather
+     * than pairing inputs with outputs. */
+    int delivered = 0;
+    for (int fed = 0; fed < PICTURES; fed++)
+    {
+        picture_t *pic = filter_chain_VideoFilter(chain,
+                                source_picture(&fmt.video, fed));
+        while (pic != NULL)
+        {
+            picture_t *next = pic->p_next;
+            pic->p_next = NULL;
+            check_picture(pic, delivered++);
+            pic = next;
+        }
+    }
+
+    vlc_tick_t deadline = vlc_tick_now() + DEADLINE;
+    while (delivered < PICTURES)
+    {
+        picture_t *pic = filter_chain_VideoFilter(chain, NULL);
+        if (pic != NULL)
+        {
+            check_picture(pic, delivered++);
+            continue;
+        }
+        assert(vlc_tick_now() < deadline);
+        vlc_tick_sleep(VLC_TICK_FROM_MS(1));
+    }
+
+    filter_chain_PipelineStop(chain);
+
+    /* Once stopped, the chain must filter sequentially again */
+    picture_t *pic = filter_chain_VideoFilter(chain,
+                            source_picture(&fmt.video, 0));
+    assert(pic != NULL);
+    check_picture(pic, 0);
+
+    filter_chain_Delete(chain);
+    es_format_Clean(&fmt);
+    libvlc_release(vlc);
+    return 0;
+}
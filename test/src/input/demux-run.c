@@ -53,6 +53,8 @@ struct test_es_out_t
 {
     struct es_out_t out;
     struct es_out_id_t *ids;
+    uintmax_t sent_blocks;
+    uintmax_t sent_bytes;
 #ifdef HAVE_DECODERS
     vlc_object_t *parent;
 #endif
@@ -106,6 +108,8 @@ static int EsOutSend(es_out_t *out, es_out_id_t *id, block_t *block)
 
     //debug("[%p] Sent    ES: %zu\n", (void *)idd, block->i_buffer);
     EsOutCheckId(ctx, id);
+    ctx->sent_blocks++;
+    ctx->sent_bytes += block->i_buffer;
 #ifdef HAVE_DECODERS
     if (id->decoder)
         test_decoder_process(id->decoder, block);
@@ -230,6 +234,8 @@ static es_out_t *test_es_out_create(vlc_object_t *parent)
     }
 
     ctx->ids = NULL;
+    ctx->sent_blocks = 0;
+    ctx->sent_bytes = 0;
 
     es_out_t *out = &ctx->out;
     out->cbs = &es_out_cbs;
@@ -363,6 +369,95 @@ int vlc_demux_process_path(const struct vlc_run_args *args, const char *path)
     return ret;
 }
 
+/* Replays one stream through a demux-only pipeline and reports throughput.
+ * The null ES output releases every block immediately, so the timing covers
+ * the access, the demuxer and the packetizers, but no decoding. */
+static int demux_bench_stream(const struct vlc_run_args *args, stream_t *s,
+                              const char *label, unsigned run, unsigned runs)
+{
+    const char *name = args->name;
+    if (name == NULL)
+        name = "any";
+
+    if (s == NULL)
+        return -1;
+
+    uint64_t stream_size;
+    if (vlc_stream_GetSize(s, &stream_size))
+        stream_size = 0;
+
+    es_out_t *out = test_es_out_create(VLC_OBJECT(s));
+    if (out == NULL)
+        return -1;
+
+    demux_t *demux = demux_New(VLC_OBJECT(s), name, s, out);
+    if (demux == NULL)
+    {
+        es_out_Delete(out);
+        vlc_stream_Delete(s);
+        fprintf(stderr, "Error: cannot create demultiplexer: %s\n", name);
+        return -1;
+    }
+
+    int val;
+    vlc_tick_t start = vlc_tick_now();
+
+    while ((val = demux_Demux(demux)) == VLC_DEMUXER_SUCCESS);
+
+    vlc_tick_t elapsed = vlc_tick_now() - start;
+    if (elapsed <= 0)
+        elapsed = 1;
+
+    demux_Delete(demux);
+
+    struct test_es_out_t *ctx = (struct test_es_out_t *)out;
+    /* CLOCK_FREQ is one tick per microsecond: bytes/tick is MB/s. */
+    printf("bench: %s run %u/%u: %"PRIu64" bytes in %"PRId64" us, "
+           "%.1f MB/s, %ju block(s) (%ju ES bytes)\n", label, run, runs,
+           stream_size, elapsed, (double)stream_size / elapsed,
+           ctx->sent_blocks, ctx->sent_bytes);
+    es_out_Delete(out);
+
+    return val == VLC_DEMUXER_EOF ? 0 : -1;
+}
+
+int vlc_demux_bench_path(const struct vlc_run_args *args, const char *path,
+                         unsigned runs)
+{
+    char *url = vlc_path2uri(path, NULL);
+    if (url == NULL)
+    {
+        fprintf(stderr, "Error: cannot convert path to URL: %s\n", path);
+        return -1;
+    }
+
+    libvlc_instance_t *vlc = libvlc_create(args);
+    if (vlc == NULL)
+    {
+        free(url);
+        return -1;
+    }
+
+    int ret = 0;
+
+    for (unsigned run = 1; run <= runs && ret == 0; run++)
+    {
+        stream_t *s = vlc_access_NewMRL(VLC_OBJECT(vlc->p_libvlc_int), url);
+        if (s == NULL)
+            fprintf(stderr, "Error: cannot create input stream: %s\n", url);
+
+        ret = demux_bench_stream(args, s, path, run, runs);
+    }
+
+    size_t blocks, bytes, peak;
+    block_AllocationStats(&blocks, &bytes, &peak);
+    printf("bench: %s: block allocation peak %zu bytes\n", path, peak);
+
+    libvlc_release(vlc);
+    free(url);
+    return ret;
+}
+
 int vlc_demux_process_memory(const struct vlc_run_args *args,
                              const unsigned char *buf, size_t length)
 {
@@ -30,3 +30,5 @@ int vlc_demux_process_url(const struct vlc_run_args *, const char *url);
 int vlc_demux_process_path(const struct vlc_run_args *, const char *path);
 int vlc_demux_process_memory(const struct vlc_run_args *,
                              const unsigned char *buf, size_t length);
+int vlc_demux_bench_path(const struct vlc_run_args *, const char *path,
+                         unsigned runs);
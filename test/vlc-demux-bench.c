@@ -0,0 +1,54 @@
+/**
+ * @file vlc-demux-bench.c
+ */
+/*****************************************************************************
+ * Copyright © 2018 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "src/input/demux-run.h"
+
+int main(int argc, char *argv[])
+{
+    struct vlc_run_args args;
+    vlc_run_args_init(&args);
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: [VLC_TARGET=demux] [VLC_BENCH_RUNS=n] "
+                "%s <filename>...\n", argv[0]);
+        return 1;
+    }
+
+    char *env = getenv("VLC_BENCH_RUNS");
+    unsigned runs = (env != NULL) ? strtoul(env, NULL, 10) : 0;
+    if (runs == 0)
+        runs = 3;
+
+    int ret = 0;
+
+    for (int i = 1; i < argc; i++)
+        if (vlc_demux_bench_path(&args, argv[i], runs))
+            ret = 1;
+
+    return ret;
+}